@@ -57,11 +57,9 @@ RESOURCES += \
 SOURCES += \
     main.cpp \
     mainwindow.cpp \
-    polygonsimplifier.cpp \
 
 HEADERS += \
     mainwindow.h \
-    polygonsimplifier.h \
 
 FORMS += \
     mainwindow.ui \
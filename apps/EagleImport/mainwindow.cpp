@@ -1,28 +1,16 @@
 #include "mainwindow.h"
 
-#include "polygonsimplifier.h"
 #include "ui_mainwindow.h"
 
 #include <librepcb/common/fileio/fileutils.h>
-#include <librepcb/common/fileio/transactionalfilesystem.h>
-#include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/eagleimport/converterdb.h>
-#include <librepcb/eagleimport/deviceconverter.h>
-#include <librepcb/eagleimport/devicesetconverter.h>
-#include <librepcb/eagleimport/packageconverter.h>
-#include <librepcb/eagleimport/symbolconverter.h>
-#include <librepcb/library/cmp/component.h>
-#include <librepcb/library/dev/device.h>
-#include <librepcb/library/pkg/footprint.h>
-#include <librepcb/library/pkg/package.h>
-#include <librepcb/library/sym/symbol.h>
 #include <parseagle/library.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
 namespace librepcb {
-using namespace library;
 
 MainWindow::MainWindow(QWidget* parent)
   : QMainWindow(parent), ui(new Ui::MainWindow) {
@@ -114,44 +102,16 @@ void MainWindow::convertFile(ConvertFileType_t         type,
 
     switch (type) {
       case ConvertFileType_t::Symbols_to_Symbols:
-        ui->pbarElements->setValue(0);
-        ui->pbarElements->setMaximum(library.getSymbols().count());
-        foreach (const parseagle::Symbol& symbol, library.getSymbols()) {
-          bool success = convertSymbol(db, symbol);
-          mReadedElementsCount++;
-          if (success) mConvertedElementsCount++;
-          ui->pbarElements->setValue(ui->pbarElements->value() + 1);
-          ui->lblConvertedElements->setText(QString("%1 of %2")
-                                                .arg(mConvertedElementsCount)
-                                                .arg(mReadedElementsCount));
-        }
+        convertElements(db, library.getSymbols(),
+                        &eagleimport::LibraryConverter::convertSymbol);
         break;
       case ConvertFileType_t::Packages_to_PackagesAndDevices:
-        ui->pbarElements->setValue(0);
-        ui->pbarElements->setMaximum(library.getPackages().count());
-        foreach (const parseagle::Package& package, library.getPackages()) {
-          bool success = convertPackage(db, package);
-          mReadedElementsCount++;
-          if (success) mConvertedElementsCount++;
-          ui->pbarElements->setValue(ui->pbarElements->value() + 1);
-          ui->lblConvertedElements->setText(QString("%1 of %2")
-                                                .arg(mConvertedElementsCount)
-                                                .arg(mReadedElementsCount));
-        }
+        convertElements(db, library.getPackages(),
+                        &eagleimport::LibraryConverter::convertPackage);
         break;
       case ConvertFileType_t::Devices_to_Components:
-        ui->pbarElements->setValue(0);
-        ui->pbarElements->setMaximum(library.getDeviceSets().count());
-        foreach (const parseagle::DeviceSet& deviceSet,
-                 library.getDeviceSets()) {
-          bool success = convertDevice(db, deviceSet);
-          mReadedElementsCount++;
-          if (success) mConvertedElementsCount++;
-          ui->pbarElements->setValue(ui->pbarElements->value() + 1);
-          ui->lblConvertedElements->setText(QString("%1 of %2")
-                                                .arg(mConvertedElementsCount)
-                                                .arg(mReadedElementsCount));
-        }
+        convertElements(db, library.getDeviceSets(),
+                        &eagleimport::LibraryConverter::convertDeviceSet);
         break;
       default:
         throw Exception(__FILE__, __LINE__);
@@ -162,94 +122,41 @@ void MainWindow::convertFile(ConvertFileType_t         type,
   }
 }
 
-bool MainWindow::convertSymbol(eagleimport::ConverterDb& db,
-                               const parseagle::Symbol&  symbol) {
-  try {
-    // create symbol
-    eagleimport::SymbolConverter converter(symbol, db);
-    std::unique_ptr<Symbol>      newSymbol = converter.generate();
-
-    // convert line rects to polygon rects
-    PolygonSimplifier<Symbol> polygonSimplifier(*newSymbol);
-    polygonSimplifier.convertLineRectsToPolygonRects(false, true);
-
-    // save symbol to file
-    std::shared_ptr<TransactionalFileSystem> fs =
-        TransactionalFileSystem::openRW(
-            FilePath(QString("%1/sym").arg(ui->output->text())));
-    TransactionalDirectory dir(fs);
-    newSymbol->moveIntoParentDirectory(dir);
-    fs->save();
-  } catch (const std::exception& e) {
-    addError(e.what());
-    return false;
+template <typename T>
+void MainWindow::convertElements(
+    eagleimport::ConverterDb& db, const T& elements,
+    eagleimport::LibraryConverter::Result (*convert)(
+        eagleimport::ConverterDb&, const typename T::value_type&)) {
+  ui->pbarElements->setValue(0);
+  ui->pbarElements->setMaximum(elements.count());
+
+  // The elements are independent of each other, so they are converted in
+  // parallel (ConverterDb is thread-safe). But the results are saved in the
+  // order of the input file to get deterministic output and error messages.
+  QList<QFuture<eagleimport::LibraryConverter::Result>> futures;
+  foreach (const typename T::value_type& element, elements) {
+    futures.append(QtConcurrent::run(
+        [&db, element, convert]() { return convert(db, element); }));
   }
-
-  return true;
-}
-
-bool MainWindow::convertPackage(eagleimport::ConverterDb& db,
-                                const parseagle::Package& package) {
-  try {
-    // create package
-    eagleimport::PackageConverter converter(package, db);
-    std::unique_ptr<Package>      newPackage = converter.generate();
-
-    // convert line rects to polygon rects
-    Q_ASSERT(newPackage->getFootprints().count() == 1);
-    PolygonSimplifier<Footprint> polygonSimplifier(
-        *newPackage->getFootprints().first());
-    polygonSimplifier.convertLineRectsToPolygonRects(false, true);
-
-    // save package to file
-    std::shared_ptr<TransactionalFileSystem> fs =
-        TransactionalFileSystem::openRW(
-            FilePath(QString("%1/pkg").arg(ui->output->text())));
-    TransactionalDirectory dir(fs);
-    newPackage->moveIntoParentDirectory(dir);
-    fs->save();
-  } catch (const std::exception& e) {
-    addError(e.what());
-    return false;
+  for (QFuture<eagleimport::LibraryConverter::Result>& future : futures) {
+    eagleimport::LibraryConverter::Result result = future.result();
+    if (!result.error.isNull()) {
+      addError(result.error);
+    }
+    bool success = result.success && saveElements(result);
+    mReadedElementsCount++;
+    if (success) mConvertedElementsCount++;
+    ui->pbarElements->setValue(ui->pbarElements->value() + 1);
+    ui->lblConvertedElements->setText(QString("%1 of %2")
+                                          .arg(mConvertedElementsCount)
+                                          .arg(mReadedElementsCount));
   }
-
-  return true;
 }
 
-bool MainWindow::convertDevice(eagleimport::ConverterDb&   db,
-                               const parseagle::DeviceSet& deviceSet) {
+bool MainWindow::saveElements(
+    const eagleimport::LibraryConverter::Result& result) {
   try {
-    // abort if device name ends with "-US" or "-US_"
-    if (deviceSet.getName().endsWith("-US")) return false;
-    if (deviceSet.getName().endsWith("-US_")) return false;
-
-    // create component
-    eagleimport::DeviceSetConverter converter(deviceSet, db);
-    std::unique_ptr<Component>      newComponent = converter.generate();
-
-    // create devices
-    foreach (const parseagle::Device& device, deviceSet.getDevices()) {
-      if (device.getPackage().isNull()) continue;
-
-      eagleimport::DeviceConverter devConverter(deviceSet, device, db);
-      std::unique_ptr<Device>      newDevice = devConverter.generate();
-
-      // save device
-      std::shared_ptr<TransactionalFileSystem> fs =
-          TransactionalFileSystem::openRW(
-              FilePath(QString("%1/dev").arg(ui->output->text())));
-      TransactionalDirectory dir(fs);
-      newDevice->moveIntoParentDirectory(dir);
-      fs->save();
-    }
-
-    // save component to file
-    std::shared_ptr<TransactionalFileSystem> fs =
-        TransactionalFileSystem::openRW(
-            FilePath(QString("%1/cmp").arg(ui->output->text())));
-    TransactionalDirectory dir(fs);
-    newComponent->moveIntoParentDirectory(dir);
-    fs->save();
+    eagleimport::LibraryConverter::save(result, FilePath(ui->output->text()));
   } catch (const std::exception& e) {
     addError(e.what());
     return false;
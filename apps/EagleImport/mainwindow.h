@@ -3,6 +3,7 @@
 
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/uuid.h>
+#include <librepcb/eagleimport/libraryconverter.h>
 
 #include <QtCore>
 #include <QtWidgets>
@@ -11,12 +12,6 @@ namespace Ui {
 class MainWindow;
 }
 
-namespace parseagle {
-class Symbol;
-class Package;
-class DeviceSet;
-}  // namespace parseagle
-
 namespace librepcb {
 
 namespace eagleimport {
@@ -58,12 +53,12 @@ private:
   void convertAllFiles(ConvertFileType_t type);
   void convertFile(ConvertFileType_t type, eagleimport::ConverterDb& db,
                    const librepcb::FilePath& filepath);
-  bool convertSymbol(eagleimport::ConverterDb& db,
-                     const parseagle::Symbol&  symbol);
-  bool convertPackage(eagleimport::ConverterDb& db,
-                      const parseagle::Package& package);
-  bool convertDevice(eagleimport::ConverterDb&   db,
-                     const parseagle::DeviceSet& deviceSet);
+  template <typename T>
+  void convertElements(eagleimport::ConverterDb& db, const T& elements,
+                       eagleimport::LibraryConverter::Result (*convert)(
+                           eagleimport::ConverterDb&,
+                           const typename T::value_type&));
+  bool saveElements(const eagleimport::LibraryConverter::Result& result);
 
   // Attributes
   Ui::MainWindow* ui;
@@ -22,6 +22,9 @@
  ******************************************************************************/
 #include "commandlineinterface.h"
 
+#include "commandlineprofiler.h"
+#include "imageexport.h"
+
 #include <librepcb/common/application.h>
 #include <librepcb/common/attributes/attributesubstitutor.h>
 #include <librepcb/common/bom/bom.h>
@@ -30,18 +33,36 @@
 #include <librepcb/common/fileio/csvfile.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/pnp/pickplacecsvwriter.h>
+#include <librepcb/common/pnp/pickplacedata.h>
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/eagleimport/converterdb.h>
+#include <librepcb/eagleimport/libraryconverter.h>
 #include <librepcb/library/elements.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/boardfabricationoutputsettings.h>
 #include <librepcb/project/boards/boardgerberexport.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/boardpickplacegenerator.h>
+#include <librepcb/project/boards/drc/boarddesignrulecheck.h>
+#include <librepcb/project/boards/items/bi_plane.h>
 #include <librepcb/project/bomgenerator.h>
 #include <librepcb/project/erc/ercmsg.h>
 #include <librepcb/project/erc/ercmsglist.h>
 #include <librepcb/project/project.h>
+#include <librepcb/project/projectmemoryreport.h>
+#include <librepcb/project/schematics/schematic.h>
+#include <parseagle/library.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 #include <algorithm>
+#include <functional>
+#include <memory>
+#include <vector>
 
 /*******************************************************************************
  *  Namespace
@@ -57,7 +78,10 @@ using namespace librepcb::project;
  ******************************************************************************/
 
 CommandLineInterface::CommandLineInterface(const Application& app) noexcept
-  : mApp(app) {
+  : mApp(app), mServing(false), mProjectCache(sMaxCachedProjects) {
+}
+
+CommandLineInterface::~CommandLineInterface() noexcept {
 }
 
 /*******************************************************************************
@@ -65,13 +89,30 @@ CommandLineInterface::CommandLineInterface(const Application& app) noexcept
  ******************************************************************************/
 
 int CommandLineInterface::execute() noexcept {
+  return execute(mApp.arguments());
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+int CommandLineInterface::execute(const QStringList& arguments) noexcept {
   QMap<QString, QPair<QString, QString>> commands = {
       {"open-project",
        {tr("Open a project to execute project-related tasks."),
-        tr("open-project [command_options]")}},
+        tr("open-project [command_options] project...")}},
       {"open-library",
        {tr("Open a library to execute library-related tasks."),
         tr("open-library [command_options]")}},
+      {"import-eagle",
+       {tr("Import Eagle libraries (*.lbr) into a LibrePCB library."),
+        tr("import-eagle [command_options] library input...")}},
+      {"generate-project",
+       {tr("Generate a synthetic project of a given size for benchmarks."),
+        tr("generate-project [command_options] project library")}},
+      {"serve",
+       {tr("Keep running and process commands read from stdin."),
+        tr("serve")}},
   };
 
   // Add global options
@@ -89,12 +130,35 @@ int CommandLineInterface::execute() noexcept {
       tr("Run the electrical rule check, print all non-approved "
          "warnings/errors and "
          "report failure (exit code = 1) if there are non-approved messages."));
+  QCommandLineOption drcOption(
+      "drc",
+      tr("Run the design rule check for each board, print all messages and "
+         "report failure (exit code = 1) if there are messages."));
+  QCommandLineOption drcSettingsOption(
+      "drc-settings",
+      tr("Override the default DRC settings by providing a *.lp file "
+         "containing custom settings."),
+      tr("file"));
+  QCommandLineOption drcReportOption(
+      "drc-report",
+      tr("Write the DRC messages and the duration of each check stage to "
+         "given file(s). Existing files will be overwritten. Supported file "
+         "extensions: %1")
+          .arg("json, csv"),
+      tr("file"));
   QCommandLineOption exportSchematicsOption(
       "export-schematics",
       tr("Export schematics to given file(s). Existing files will be "
          "overwritten. Supported file extensions: %1")
           .arg("pdf"),
       tr("file"));
+  QCommandLineOption exportSchematicImagesOption(
+      "export-schematic-images",
+      tr("Export each schematic page as an image to given file(s). Existing "
+         "files will be overwritten. Use the attribute %1 in the path to get "
+         "a separate file for each page. Supported file extensions: %2")
+          .arg("{{PAGE}}", "png, svg"),
+      tr("file"));
   QCommandLineOption exportBomOption(
       "export-bom",
       tr("Export generic BOM to given file(s). Existing files will be "
@@ -113,6 +177,12 @@ int CommandLineInterface::execute() noexcept {
          "to the BOM. Example: \"%1\"")
           .arg("MANUFACTURER, MPN"),
       tr("attributes"));
+  QCommandLineOption exportPnpOption(
+      "export-pnp",
+      tr("Export pick&place data of both board sides to given file(s). "
+         "Existing files will be overwritten. Supported file extensions: %1")
+          .arg("csv"),
+      tr("file"));
   QCommandLineOption exportPcbFabricationDataOption(
       "export-pcb-fabrication-data",
       tr("Export PCB fabrication data (Gerber/Excellon) according the "
@@ -124,6 +194,18 @@ int CommandLineInterface::execute() noexcept {
          "containing custom settings. If not set, the settings from the boards "
          "will be used instead."),
       tr("file"));
+  QCommandLineOption exportBoardImagesOption(
+      "export-board-images",
+      tr("Export images of boards to given file(s). Existing files will be "
+         "overwritten. If the path contains %1, a separate image is exported "
+         "for each visible layer, otherwise all layers are exported into one "
+         "image. Supported file extensions: %2")
+          .arg("{{LAYER}}", "png, svg"),
+      tr("file"));
+  QCommandLineOption imageDpiOption(
+      "image-dpi",
+      tr("Resolution of exported images in DPI [%1].").arg(sDefaultImageDpi),
+      tr("dpi"));
   QCommandLineOption boardOption("board",
                                  tr("The name of the board(s) to export. Can "
                                     "be given multiple times. If not set, "
@@ -136,6 +218,29 @@ int CommandLineInterface::execute() noexcept {
       "strict", tr("Fail if the project files are not strictly canonical, i.e. "
                    "there would be changes when saving the project. Note that "
                    "this option is not available for *.lppz files."));
+  QCommandLineOption profileOption(
+      "profile",
+      tr("Write the wall time, CPU time and peak memory usage of each "
+         "processing stage (e.g. opening the project or exporting files) to "
+         "the given JSON file. Existing files will be overwritten."),
+      tr("file"));
+  QCommandLineOption memoryReportOption(
+      "memory-report",
+      tr("Print the estimated memory usage of each subsystem (e.g. board "
+         "items, plane fragments or library elements) after processing the "
+         "project."));
+  QCommandLineOption projectsFileOption(
+      "projects-file",
+      tr("Process all projects listed in the given file (one path per line, "
+         "relative to the file) in addition to the projects given as "
+         "arguments."),
+      tr("file"));
+  QCommandLineOption jobsOption(
+      "jobs",
+      tr("Number of projects (or library elements with '--all', or Eagle "
+         "libraries) to process in parallel. If not set, the number of CPU "
+         "cores is used."),
+      tr("count"));
 
   // Define options for "open-library"
   QCommandLineOption libAllOption(
@@ -148,9 +253,63 @@ int CommandLineInterface::execute() noexcept {
       "strict", tr("Fail if the opened files are not strictly canonical, i.e. "
                    "there would be changes when saving the library elements."));
 
+  // Define options for "import-eagle"
+  QCommandLineOption uuidListOption(
+      "uuid-list",
+      tr("INI file to read and store the UUIDs of the converted elements, so "
+         "a repeated import updates the existing elements instead of creating "
+         "new ones. If not set, the file '%1' in the library directory is "
+         "used.")
+          .arg("eagle-import.ini"),
+      tr("file"));
+
+  // Define options for "generate-project"
+  QCommandLineOption genDeviceTypesOption(
+      "device-types",
+      tr("Maximum number of different devices to use from the library. "
+         "Default: %1")
+          .arg(ProjectGenerator::Options().deviceTypes),
+      tr("count"));
+  QCommandLineOption genComponentsOption(
+      "components",
+      tr("Number of components to add. Default: %1")
+          .arg(ProjectGenerator::Options().components),
+      tr("count"));
+  QCommandLineOption genNetsOption(
+      "nets",
+      tr("Number of nets to distribute the component signals over. "
+         "Default: %1")
+          .arg(ProjectGenerator::Options().nets),
+      tr("count"));
+  QCommandLineOption genSchematicsOption(
+      "schematics",
+      tr("Number of schematic pages. Default: %1")
+          .arg(ProjectGenerator::Options().schematics),
+      tr("count"));
+  QCommandLineOption genBoardsOption(
+      "boards",
+      tr("Number of boards. Default: %1")
+          .arg(ProjectGenerator::Options().boards),
+      tr("count"));
+  QCommandLineOption genInnerLayersOption(
+      "inner-layers",
+      tr("Number of inner copper layers of each board. Default: %1")
+          .arg(ProjectGenerator::Options().innerLayers),
+      tr("count"));
+  QCommandLineOption genTracesOption(
+      "traces", tr("Connect the pads of each net with traces."));
+  QCommandLineOption genViasOption(
+      "vias", tr("Add a via in the middle of each trace (requires '%1').")
+                  .arg("--traces"));
+  QCommandLineOption genPlanesOption(
+      "planes",
+      tr("Number of planes covering the whole board, per board. Default: %1")
+          .arg(ProjectGenerator::Options().planes),
+      tr("count"));
+
   // First parse to get the supplied command (ignoring errors because the parser
   // does not yet know the command-dependent options).
-  parser.parse(mApp.arguments());
+  parser.parse(arguments);
 
   // Add command-dependent options
   QStringList positionalArgs = parser.positionalArguments();
@@ -163,18 +322,32 @@ int CommandLineInterface::execute() noexcept {
     parser.clearPositionalArguments();
     parser.addPositionalArgument(command, commands[command].first,
                                  commands[command].second);
-    parser.addPositionalArgument("project",
-                                 tr("Path to project file (*.lpp[z])."));
+    parser.addPositionalArgument(
+        "project",
+        tr("Path to project file (*.lpp[z]). Can be given multiple times to "
+           "process several projects, each in a separate process."),
+        "project...");
     parser.addOption(ercOption);
+    parser.addOption(drcOption);
+    parser.addOption(drcSettingsOption);
+    parser.addOption(drcReportOption);
     parser.addOption(exportSchematicsOption);
+    parser.addOption(exportSchematicImagesOption);
     parser.addOption(exportBomOption);
     parser.addOption(exportBoardBomOption);
     parser.addOption(bomAttributesOption);
+    parser.addOption(exportPnpOption);
     parser.addOption(exportPcbFabricationDataOption);
     parser.addOption(pcbFabricationSettingsOption);
+    parser.addOption(exportBoardImagesOption);
+    parser.addOption(imageDpiOption);
     parser.addOption(boardOption);
     parser.addOption(saveOption);
     parser.addOption(prjStrictOption);
+    parser.addOption(profileOption);
+    parser.addOption(memoryReportOption);
+    parser.addOption(projectsFileOption);
+    parser.addOption(jobsOption);
   } else if (command == "open-library") {
     parser.clearPositionalArguments();
     parser.addPositionalArgument(command, commands[command].first,
@@ -184,6 +357,47 @@ int CommandLineInterface::execute() noexcept {
     parser.addOption(libAllOption);
     parser.addOption(libSaveOption);
     parser.addOption(libStrictOption);
+    parser.addOption(jobsOption);
+  } else if (command == "import-eagle") {
+    parser.clearPositionalArguments();
+    parser.addPositionalArgument(command, commands[command].first,
+                                 commands[command].second);
+    parser.addPositionalArgument(
+        "library",
+        tr("Path to the library directory (*.lplib) to import into. It is "
+           "created if it does not exist yet."));
+    parser.addPositionalArgument(
+        "input",
+        tr("Path to an Eagle library file (*.lbr) or to a directory containing "
+           "such files. Can be given multiple times."),
+        "input...");
+    parser.addOption(uuidListOption);
+    parser.addOption(jobsOption);
+  } else if (command == "generate-project") {
+    parser.clearPositionalArguments();
+    parser.addPositionalArgument(command, commands[command].first,
+                                 commands[command].second);
+    parser.addPositionalArgument(
+        "project",
+        tr("Path to the project file (*.lpp) to create. Its directory must not "
+           "contain a project yet."));
+    parser.addPositionalArgument(
+        "library",
+        tr("Path to the library directory (*.lplib) to take the devices "
+           "from."));
+    parser.addOption(genDeviceTypesOption);
+    parser.addOption(genComponentsOption);
+    parser.addOption(genNetsOption);
+    parser.addOption(genSchematicsOption);
+    parser.addOption(genBoardsOption);
+    parser.addOption(genInnerLayersOption);
+    parser.addOption(genTracesOption);
+    parser.addOption(genViasOption);
+    parser.addOption(genPlanesOption);
+  } else if (command == "serve") {
+    parser.clearPositionalArguments();
+    parser.addPositionalArgument(command, commands[command].first,
+                                 commands[command].second);
   } else if (!command.isEmpty()) {
     printErr(tr("Unknown command '%1'.").arg(command), 2);
     print(parser.helpText(), 0);
@@ -191,7 +405,7 @@ int CommandLineInterface::execute() noexcept {
   }
 
   // Parse the actual command line arguments given by the user
-  if (!parser.parse(mApp.arguments())) {
+  if (!parser.parse(arguments)) {
     printErr(parser.errorText(), 2);
     print(parser.helpText(), 0);
     return 1;
@@ -213,7 +427,7 @@ int CommandLineInterface::execute() noexcept {
     if (command.isEmpty()) {
       print("\n" % tr("Commands:"));
       for (auto it = commands.constBegin(); it != commands.constEnd(); ++it) {
-        print("  " % it.key().leftJustified(15) % it.value().first);
+        print("  " % it.key().leftJustified(18) % it.value().first);
       }
     }
     return 0;
@@ -224,38 +438,189 @@ int CommandLineInterface::execute() noexcept {
     Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::All);
   }
 
+  // --jobs
+  int jobs = QThread::idealThreadCount();
+  if (((command == "open-project") || (command == "open-library") ||
+       (command == "import-eagle")) &&
+      parser.isSet(jobsOption)) {
+    bool ok = false;
+    jobs    = parser.value(jobsOption).toInt(&ok);
+    if ((!ok) || (jobs < 1)) {
+      printErr(tr("Invalid job count: %1").arg(parser.value(jobsOption)), 2);
+      print(parser.helpText(), 0);
+      return 1;
+    }
+  }
+
   // Execute command
   bool cmdSuccess = false;
   if (command == "open-project") {
-    if (positionalArgs.count() != 1) {
+    QStringList projectFiles = positionalArgs;
+    if (parser.isSet(projectsFileOption)) {
+      try {
+        projectFiles += readProjectsFile(parser.value(projectsFileOption));
+      } catch (const Exception& e) {
+        printErr(tr("ERROR: Failed to read projects file: %1").arg(e.getMsg()));
+        return 1;
+      }
+    }
+    if (projectFiles.isEmpty()) {
       printErr(tr("Wrong argument count."), 2);
       print(parser.helpText(), 0);
       return 1;
     }
-    cmdSuccess = openProject(
-        positionalArgs.value(0),                       // project filepath
-        parser.isSet(ercOption),                       // run ERC
-        parser.values(exportSchematicsOption),         // export schematics
-        parser.values(exportBomOption),                // export generic BOM
-        parser.values(exportBoardBomOption),           // export board BOM
-        parser.value(bomAttributesOption),             // BOM attributes
-        parser.isSet(exportPcbFabricationDataOption),  // export PCB fab. data
-        parser.value(pcbFabricationSettingsOption),    // PCB fab. settings
-        parser.values(boardOption),                    // boards
-        parser.isSet(saveOption),                      // save project
-        parser.isSet(prjStrictOption)                  // strict mode
-    );
+    int imageDpi = sDefaultImageDpi;
+    if (parser.isSet(imageDpiOption)) {
+      bool ok  = false;
+      imageDpi = parser.value(imageDpiOption).toInt(&ok);
+      if ((!ok) || (imageDpi < 1)) {
+        printErr(tr("Invalid image resolution: %1")
+                     .arg(parser.value(imageDpiOption)),
+                 2);
+        print(parser.helpText(), 0);
+        return 1;
+      }
+    }
+    if (projectFiles.count() > 1) {
+      // Forward all options (except the batch options) to the child processes
+      QStringList args = {command};
+      if (parser.isSet(verboseOption)) {
+        args.append("--" % verboseOption.names().first());
+      }
+      QList<const QCommandLineOption*> projectOptions = {
+          &ercOption,
+          &drcOption,
+          &drcSettingsOption,
+          &drcReportOption,
+          &exportSchematicsOption,
+          &exportSchematicImagesOption,
+          &exportBomOption,
+          &exportBoardBomOption,
+          &bomAttributesOption,
+          &exportPnpOption,
+          &exportPcbFabricationDataOption,
+          &pcbFabricationSettingsOption,
+          &exportBoardImagesOption,
+          &imageDpiOption,
+          &boardOption,
+          &saveOption,
+          &prjStrictOption,
+          &profileOption,
+          &memoryReportOption,
+      };
+      foreach (const QCommandLineOption* option, projectOptions) {
+        QString name = "--" % option->names().first();
+        if (option->valueName().isEmpty()) {
+          if (parser.isSet(*option)) {
+            args.append(name);
+          }
+        } else {
+          foreach (const QString& value, parser.values(*option)) {
+            args.append(name % "=" % value);
+          }
+        }
+      }
+      cmdSuccess = openProjects(projectFiles, args, jobs);
+    } else {
+      cmdSuccess = openProject(
+          projectFiles.first(),                          // project filepath
+          parser.isSet(ercOption),                       // run ERC
+          parser.isSet(drcOption),                       // run DRC
+          parser.value(drcSettingsOption),               // DRC settings
+          parser.values(drcReportOption),                // DRC report files
+          parser.values(exportSchematicsOption),         // export schematics
+          parser.values(exportSchematicImagesOption),    // schematic images
+          parser.values(exportBomOption),                // export generic BOM
+          parser.values(exportBoardBomOption),           // export board BOM
+          parser.value(bomAttributesOption),             // BOM attributes
+          parser.values(exportPnpOption),                // export pick&place
+          parser.isSet(exportPcbFabricationDataOption),  // export PCB fab. data
+          parser.value(pcbFabricationSettingsOption),    // PCB fab. settings
+          parser.values(exportBoardImagesOption),        // board images
+          imageDpi,                                      // image resolution
+          parser.values(boardOption),                    // boards
+          parser.isSet(saveOption),                      // save project
+          parser.isSet(prjStrictOption),                 // strict mode
+          parser.value(profileOption),                   // profile file
+          parser.isSet(memoryReportOption)               // memory report
+      );
+    }
   } else if (command == "open-library") {
     if (positionalArgs.count() != 1) {
       printErr(tr("Wrong argument count."), 2);
       print(parser.helpText(), 0);
       return 1;
     }
-    cmdSuccess = openLibrary(positionalArgs.value(0),       // library directory
-                             parser.isSet(libAllOption),    // all elements
-                             parser.isSet(libSaveOption),   // save
-                             parser.isSet(libStrictOption)  // strict mode
+    cmdSuccess = openLibrary(positionalArgs.value(0),        // library directory
+                             parser.isSet(libAllOption),     // all elements
+                             parser.isSet(libSaveOption),    // save
+                             parser.isSet(libStrictOption),  // strict mode
+                             jobs                            // parallel jobs
+    );
+  } else if (command == "import-eagle") {
+    if (positionalArgs.count() < 2) {
+      printErr(tr("Wrong argument count."), 2);
+      print(parser.helpText(), 0);
+      return 1;
+    }
+    cmdSuccess = importEagleLibraries(
+        positionalArgs.first(),        // library directory
+        positionalArgs.mid(1),         // input files/directories
+        parser.value(uuidListOption),  // UUID list file
+        jobs                           // parallel jobs
+    );
+  } else if (command == "generate-project") {
+    if (positionalArgs.count() != 2) {
+      printErr(tr("Wrong argument count."), 2);
+      print(parser.helpText(), 0);
+      return 1;
+    }
+    ProjectGenerator::Options options;
+    QList<QPair<const QCommandLineOption*, int*>> counts = {
+        {&genDeviceTypesOption, &options.deviceTypes},
+        {&genComponentsOption, &options.components},
+        {&genNetsOption, &options.nets},
+        {&genSchematicsOption, &options.schematics},
+        {&genBoardsOption, &options.boards},
+        {&genInnerLayersOption, &options.innerLayers},
+        {&genPlanesOption, &options.planes},
+    };
+    for (const auto& pair : counts) {
+      if (parser.isSet(*pair.first)) {
+        bool ok      = false;
+        *pair.second = parser.value(*pair.first).toInt(&ok);
+        if ((!ok) || (*pair.second < 0)) {
+          printErr(tr("Invalid value for option '%1': %2")
+                       .arg("--" % pair.first->names().first())
+                       .arg(parser.value(*pair.first)),
+                   2);
+          print(parser.helpText(), 0);
+          return 1;
+        }
+      }
+    }
+    if (options.innerLayers > GraphicsLayer::getInnerLayerCount()) {
+      printErr(tr("The maximum number of inner layers is %1.")
+                   .arg(GraphicsLayer::getInnerLayerCount()));
+      return 1;
+    }
+    options.traces = parser.isSet(genTracesOption);
+    options.vias   = parser.isSet(genViasOption);
+    cmdSuccess = generateProject(positionalArgs.value(0),  // project file
+                                 positionalArgs.value(1),  // library directory
+                                 options                   // options
     );
+  } else if (command == "serve") {
+    if (!positionalArgs.isEmpty()) {
+      printErr(tr("Wrong argument count."), 2);
+      print(parser.helpText(), 0);
+      return 1;
+    }
+    if (mServing) {
+      printErr(tr("ERROR: Already running in server mode."));
+      return 1;
+    }
+    return serve();
   } else {
     printErr(tr("Internal failure."));
   }
@@ -268,45 +633,144 @@ int CommandLineInterface::execute() noexcept {
   }
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
+int CommandLineInterface::serve() noexcept {
+  // Requests and responses are JSON objects, each on a single line:
+  //   -> {"id": 1, "cwd": "/path", "args": ["open-project", "--erc", "x.lpp"]}
+  //   <- {"id": 1, "exit_code": 0, "stdout": "...", "stderr": "..."}
+  // The process keeps running until stdin is closed, so the application
+  // (e.g. the stroke fonts) and unmodified projects are loaded only once.
+  QFile input;
+  QFile output;
+  if ((!input.open(stdin, QIODevice::ReadOnly)) ||
+      (!output.open(stdout, QIODevice::WriteOnly))) {
+    printErr(tr("ERROR: Failed to open stdin/stdout."));
+    return 1;
+  }
+  const QString initialDir = QDir::currentPath();
+  mServing                 = true;
+  while (true) {
+    QByteArray line = input.readLine();
+    if (line.isEmpty()) {
+      break;  // end of input
+    }
+    line = line.trimmed();
+    if (line.isEmpty()) {
+      continue;
+    }
+    QJsonParseError error;
+    QJsonObject     request  = QJsonDocument::fromJson(line, &error).object();
+    QJsonObject     response = {{"id", request.value("id")}};
+    QString         capturedStdout;
+    QString         capturedStderr;
+    sCapturedStdout = &capturedStdout;
+    sCapturedStderr = &capturedStderr;
+    if (error.error != QJsonParseError::NoError) {
+      printErr(tr("ERROR: Invalid request: %1").arg(error.errorString()));
+      response.insert("exit_code", 1);
+    } else {
+      QStringList args = {mApp.arguments().value(0)};
+      foreach (const QJsonValue& arg, request.value("args").toArray()) {
+        args.append(arg.toString());
+      }
+      QDir::setCurrent(initialDir);
+      QDir::setCurrent(request.value("cwd").toString(initialDir));
+      response.insert("exit_code", execute(args));
+      Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::Nothing);
+    }
+    sCapturedStdout = nullptr;
+    sCapturedStderr = nullptr;
+    response.insert("stdout", capturedStdout);
+    response.insert("stderr", capturedStderr);
+    output.write(QJsonDocument(response).toJson(QJsonDocument::Compact));
+    output.write("\n");
+    output.flush();
+  }
+  mServing = false;
+  mProjectCache.clear();
+  return 0;
+}
 
 bool CommandLineInterface::openProject(
-    const QString& projectFile, bool runErc,
-    const QStringList& exportSchematicsFiles, const QStringList& exportBomFiles,
-    const QStringList& exportBoardBomFiles, const QString& bomAttributes,
+    const QString& projectFile, bool runErc, bool runDrc,
+    const QString& drcSettingsPath, const QStringList& drcReportFiles,
+    const QStringList& exportSchematicsFiles,
+    const QStringList& exportSchematicImageFiles,
+    const QStringList& exportBomFiles, const QStringList& exportBoardBomFiles,
+    const QString& bomAttributes, const QStringList& exportPnpFiles,
     bool exportPcbFabricationData, const QString& pcbFabricationSettingsPath,
-    const QStringList& boards, bool save, bool strict) const noexcept {
+    const QStringList& exportBoardImageFiles, int imageDpi,
+    const QStringList& boards, bool save, bool strict,
+    const QString& profileFile, bool memoryReport) const noexcept {
   try {
     bool                success = true;
     QMap<FilePath, int> writtenFilesCounter;
+    CommandLineProfiler profiler;
 
     // Open project
     FilePath projectFp(QFileInfo(projectFile).absoluteFilePath());
     print(tr("Open project '%1'...").arg(prettyPath(projectFp, projectFile)));
+    profiler.startStage("open_project", projectFp.toNative());
     std::shared_ptr<TransactionalFileSystem> projectFs;
+    std::shared_ptr<Project>                 projectPtr;
     QString                                  projectFileName;
-    if (projectFp.getSuffix() == "lppz") {
-      projectFs = TransactionalFileSystem::openRO(projectFp.getParentDir());
-      projectFs->removeDirRecursively();  // 1) get a clean initial state
-      projectFs->loadFromZip(projectFp);  // 2) load files from ZIP
-      foreach (const QString& fn, projectFs->getFiles()) {
-        if (fn.endsWith(".lpp")) {
-          projectFileName = fn;
-        }
+    // In server mode, reuse unmodified projects from previous requests. Only
+    // read-only requests are served from the cache since saving (or the strict
+    // mode) must operate on a freshly loaded project.
+    const bool useCache = mServing && (!save) && (!strict) &&
+                          (projectFp.getSuffix() == "lpp");
+    QByteArray fingerprint;
+    if (useCache) {
+      fingerprint = getProjectFingerprint(projectFp);
+      const CachedProject* cached = mProjectCache.object(projectFp.toStr());
+      if (cached && (cached->fingerprint == fingerprint)) {
+        qDebug() << "Reuse cached project:" << projectFp.toNative();
+        projectFs  = cached->fileSystem;
+        projectPtr = cached->project;
       }
     } else {
-      projectFs = TransactionalFileSystem::open(projectFp.getParentDir(), save);
-      projectFileName = projectFp.getFilename();
+      mProjectCache.remove(projectFp.toStr());  // will be outdated
+    }
+    if (!projectPtr) {
+      if (projectFp.getSuffix() == "lppz") {
+        projectFs = TransactionalFileSystem::openRO(projectFp.getParentDir());
+        projectFs->removeDirRecursively();  // 1) get a clean initial state
+        projectFs->loadFromZip(projectFp);  // 2) load files from ZIP
+        foreach (const QString& fn, projectFs->getFiles()) {
+          if (fn.endsWith(".lpp")) {
+            projectFileName = fn;
+          }
+        }
+      } else {
+        // Only lock the project if it gets modified. Read-only runs (e.g.
+        // exports) neither create a lock file nor look for autosave backups,
+        // so any number of them may process the same project concurrently.
+        projectFs =
+            TransactionalFileSystem::open(projectFp.getParentDir(), save);
+        projectFileName = projectFp.getFilename();
+      }
+      projectPtr = std::make_shared<Project>(
+          std::unique_ptr<TransactionalDirectory>(
+              new TransactionalDirectory(projectFs)),
+          projectFileName, true);  // headless, can throw
+      if (useCache) {
+        mProjectCache.insert(
+            projectFp.toStr(),
+            new CachedProject{fingerprint, projectFs, projectPtr});
+      }
+    }
+    Project& project = *projectPtr;
+
+    // Boards are loaded lazily, but saving must also write rebuilt planes
+    if (strict || save) {
+      foreach (Board* board, project.getBoards()) {
+        board->finishLoading();
+      }
     }
-    Project project(std::unique_ptr<TransactionalDirectory>(
-                        new TransactionalDirectory(projectFs)),
-                    projectFileName);  // can throw
 
     // Check for non-canonical files (strict mode)
     if (strict) {
       print(tr("Check for non-canonical files..."));
+      profiler.startStage("check_canonical_files");
       if (projectFp.getSuffix() == "lppz") {
         printErr("  " % tr("ERROR: The option '--strict' is not available for "
                            "*.lppz files!"));
@@ -332,6 +796,7 @@ bool CommandLineInterface::openProject(
     // ERC
     if (runErc) {
       print(tr("Run ERC..."));
+      profiler.startStage("erc");
       QStringList messages;
       int         approvedMsgCount = 0;
       foreach (const ErcMsg* msg, project.getErcMsgList().getItems()) {
@@ -367,6 +832,7 @@ bool CommandLineInterface::openProject(
     // Export schematics
     foreach (const QString& destStr, exportSchematicsFiles) {
       print(tr("Export schematics to '%1'...").arg(destStr));
+      profiler.startStage("export_schematics", destStr);
       QString suffix = destStr.split('.').last().toLower();
       if (suffix == "pdf") {
         QString destPathStr = AttributeSubstitutor::substitute(
@@ -384,6 +850,38 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    // Export schematic images
+    foreach (const QString& destStr, exportSchematicImageFiles) {
+      print(tr("Export schematic images to '%1'...").arg(destStr));
+      profiler.startStage("export_schematic_images", destStr);
+      QString suffix = destStr.split('.').last().toLower();
+      if (!ImageExport::isSupportedFormat(suffix)) {
+        printErr("  " % tr("ERROR: Unknown extension '%1'.").arg(suffix));
+        success = false;
+        continue;
+      }
+      // Each page has its own graphics scene, so all pages are rendered in
+      // parallel. Modifying the scenes is only allowed in the main thread,
+      // thus it's done before.
+      ImageExport imageExport(imageDpi);
+      foreach (Schematic* schematic, project.getSchematics()) {
+        QString destPathStr = AttributeSubstitutor::substitute(
+            destStr, schematic, [&](const QString& str) {
+              return FilePath::cleanFileName(
+                  str, FilePath::ReplaceSpaces | FilePath::KeepCase);
+            });
+        FilePath fp(QFileInfo(destPathStr).absoluteFilePath());
+        print(QString("  - '%1' => '%2'")
+                  .arg(*schematic->getName(), prettyPath(fp, destPathStr)));
+        schematic->clearSelection();
+        GraphicsScene& scene = schematic->getGraphicsScene();
+        QRectF         rect  = scene.itemsBoundingRect();  // updates the index
+        imageExport.startExport(scene, rect, Qt::white, fp);
+        writtenFilesCounter[fp]++;
+      }
+      imageExport.waitForFinished();  // can throw
+    }
+
     // Parse list of boards
     QList<Board*> boardList;
     if (boards.isEmpty()) {
@@ -403,6 +901,75 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    // DRC
+    if (runDrc || (!drcReportFiles.isEmpty())) {
+      print(tr("Run DRC..."));
+      BoardDesignRuleCheck::Options drcOptions;
+      bool                          drcOptionsValid = true;
+      if (!drcSettingsPath.isEmpty()) {
+        try {
+          qDebug() << "Load custom DRC settings:" << drcSettingsPath;
+          FilePath fp(QFileInfo(drcSettingsPath).absoluteFilePath());
+          drcOptions = BoardDesignRuleCheck::Options(
+              SExpression::parse(FileUtils::readFile(fp), fp));  // can throw
+        } catch (const Exception& e) {
+          printErr(
+              tr("ERROR: Failed to load DRC settings: %1").arg(e.getMsg()));
+          success         = false;
+          drcOptionsValid = false;  // avoid checking any boards
+        }
+      }
+      foreach (Board* board, drcOptionsValid ? boardList : QList<Board*>()) {
+        profiler.startStage("drc", *board->getName());
+        BoardDesignRuleCheck drc(*board, drcOptions);
+        drc.execute();  // can throw
+        foreach (const auto& stage, drc.getStageDurations()) {
+          profiler.addDetail(stage.first, stage.second);  // incl. planes
+        }
+        qint64 totalDuration = 0;
+        foreach (const auto& stage, drc.getStageDurations()) {
+          totalDuration += stage.second;
+        }
+        print("  " % tr("Board '%1': %2 message(s) (%3 ms)")
+                         .arg(*board->getName())
+                         .arg(drc.getMessages().count())
+                         .arg(totalDuration));
+        foreach (const auto& stage, drc.getStageDurations()) {
+          print(QString("    - %1: %2 ms").arg(stage.first).arg(stage.second));
+        }
+        QStringList messages;
+        foreach (const BoardDesignRuleCheckMessage& msg, drc.getMessages()) {
+          messages.append(QString("    - %1").arg(msg.getMessage()));
+        }
+        // sort messages to increases readability of console output
+        std::sort(messages.begin(), messages.end());
+        foreach (const QString& msg, messages) { printErr(msg); }
+        if ((runDrc) && (messages.count() > 0)) {
+          success = false;
+        }
+        foreach (const QString& destStr, drcReportFiles) {
+          QString destPathStr = AttributeSubstitutor::substitute(
+              destStr, board, [&](const QString& str) {
+                return FilePath::cleanFileName(
+                    str, FilePath::ReplaceSpaces | FilePath::KeepCase);
+              });
+          FilePath fp(QFileInfo(destPathStr).absoluteFilePath());
+          QString  suffix = destStr.split('.').last().toLower();
+          if (suffix == "json") {
+            writeDrcReportJson(*board, drc, fp);  // can throw
+          } else if (suffix == "csv") {
+            writeDrcReportCsv(*board, drc, fp);  // can throw
+          } else {
+            printErr("    " % tr("ERROR: Unknown extension '%1'.").arg(suffix));
+            success = false;
+            continue;
+          }
+          print(QString("    => '%1'").arg(prettyPath(fp, destPathStr)));
+          writtenFilesCounter[fp]++;
+        }
+      }
+    }
+
     // Export BOM
     if (exportBomFiles.count() + exportBoardBomFiles.count() > 0) {
       QList<QPair<QString, bool>> jobs;  // <OutputPath, BoardSpecific>
@@ -428,6 +995,8 @@ bool CommandLineInterface::openProject(
         QList<Board*> boards =
             boardSpecific ? boardList : QList<Board*>{nullptr};
         foreach (const Board* board, boards) {
+          profiler.startStage(boardSpecific ? "export_board_bom" : "export_bom",
+                              board ? *board->getName() : destStr);
           const AttributeProvider* attrProvider = board;
           if (!board) {
             attrProvider = &project;
@@ -449,9 +1018,10 @@ bool CommandLineInterface::openProject(
           }
           QString suffix = destStr.split('.').last().toLower();
           if (suffix == "csv") {
-            BomCsvWriter             writer(*bom);
-            std::shared_ptr<CsvFile> csv = writer.generateCsv();  // can throw
-            csv->saveToFile(fp);                                  // can throw
+            BomCsvWriter writer(*bom);
+            FileUtils::writeFile(fp, [&writer](QIODevice& device) {
+              writer.writeCsv(device);  // can throw
+            });                         // can throw
             writtenFilesCounter[fp]++;
           } else {
             printErr("  " % tr("ERROR: Unknown extension '%1'.").arg(suffix));
@@ -461,6 +1031,35 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    // Export pick&place data
+    foreach (const QString& destStr, exportPnpFiles) {
+      print(tr("Export pick&place data to '%1'...").arg(destStr));
+      foreach (const Board* board, boardList) {
+        profiler.startStage("export_pnp", *board->getName());
+        QString destPathStr = AttributeSubstitutor::substitute(
+            destStr, board, [&](const QString& str) {
+              return FilePath::cleanFileName(
+                  str, FilePath::ReplaceSpaces | FilePath::KeepCase);
+            });
+        FilePath fp(QFileInfo(destPathStr).absoluteFilePath());
+        print(QString("  - '%1' => '%2'")
+                  .arg(*board->getName(), prettyPath(fp, destPathStr)));
+        QString suffix = destStr.split('.').last().toLower();
+        if (suffix == "csv") {
+          BoardPickPlaceGenerator        gen(*board);
+          std::shared_ptr<PickPlaceData> data = gen.generate();
+          PickPlaceCsvWriter             writer(*data);
+          FileUtils::writeFile(fp, [&writer](QIODevice& device) {
+            writer.writeCsv(device);  // can throw
+          });                         // can throw
+          writtenFilesCounter[fp]++;
+        } else {
+          printErr("  " % tr("ERROR: Unknown extension '%1'.").arg(suffix));
+          success = false;
+        }
+      }
+    }
+
     // Export PCB fabrication data
     if (exportPcbFabricationData) {
       print(tr("Export PCB fabrication data..."));
@@ -479,22 +1078,106 @@ bool CommandLineInterface::openProject(
           boardList.clear();  // avoid exporting any boards
         }
       }
-      foreach (const Board* board, boardList) {
+      foreach (Board* board, boardList) {
         print("  " % tr("Board '%1':").arg(*board->getName()));
+        profiler.startStage("export_pcb_fabrication_data", *board->getName());
+        board->finishLoading();  // planes are needed for the export
+        foreach (const BI_Plane* plane, board->getPlanes()) {
+          const BI_Plane::RebuildStatistics& stats =
+              plane->getRebuildStatistics();
+          if (stats.durationMs >= 0) {  // rebuilt since opening the project
+            qDebug().nospace() << "Rebuilt plane " << plane->getUuid().toStr()
+                               << " in " << stats.durationMs << " ms ("
+                               << stats.obstacleCount << " obstacles, "
+                               << stats.vertexCount << " vertices).";
+            profiler.addDetail("plane_" % plane->getUuid().toStr(),
+                               stats.durationMs);
+          }
+        }
         BoardGerberExport grbExport(
             *board, customSettings ? *customSettings
                                    : board->getFabricationOutputSettings());
+        // Note: Emitted from worker threads, thus a direct connection.
+        QObject::connect(
+            &grbExport, &BoardGerberExport::fileExported,
+            [&](const FilePath& fp, bool reused, qint64 durationMs) {
+              Q_UNUSED(reused);
+              profiler.addDetail(fp.getFilename(), durationMs);
+            });
         grbExport.exportAllLayers();  // can throw
         foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
-          print(QString("    => '%1'").arg(prettyPath(fp, projectFile)));
+          if (grbExport.getReusedFiles().contains(fp)) {
+            print(QString("    => '%1' (%2)")
+                      .arg(prettyPath(fp, projectFile), tr("unchanged")));
+          } else {
+            print(QString("    => '%1'").arg(prettyPath(fp, projectFile)));
+          }
+          writtenFilesCounter[fp]++;
+        }
+      }
+    }
+
+    // Export board images
+    foreach (const QString& destStr, exportBoardImageFiles) {
+      print(tr("Export board images to '%1'...").arg(destStr));
+      QString suffix = destStr.split('.').last().toLower();
+      if (!ImageExport::isSupportedFormat(suffix)) {
+        printErr("  " % tr("ERROR: Unknown extension '%1'.").arg(suffix));
+        success = false;
+        continue;
+      }
+      foreach (Board* board, boardList) {
+        print("  " % tr("Board '%1':").arg(*board->getName()));
+        profiler.startStage("export_board_images", *board->getName());
+        board->finishLoading();  // planes are needed for the export
+        board->ensureGraphicsItems();
+        board->clearSelection();
+        GraphicsScene& scene = board->getGraphicsScene();
+        // All images cover the same area, thus they can be overlaid.
+        const QRectF          rect = scene.itemsBoundingRect();
+        QList<GraphicsLayer*> layers;
+        foreach (GraphicsLayer* layer, board->getLayerStack().getAllLayers()) {
+          if (layer->isVisible()) {
+            layers.append(layer);
+          }
+        }
+        QList<GraphicsLayer*> imageLayers = {nullptr};  // all layers
+        if (destStr.contains("{{LAYER}}")) {
+          imageLayers = layers;
+        }
+        // The layers are shown one by one in the same scene, thus rendering
+        // is done sequentially. Only encoding and writing the files is done
+        // in parallel.
+        auto sg = scopeGuard([&layers]() {
+          foreach (GraphicsLayer* layer, layers) { layer->setVisible(true); }
+        });
+        ImageExport imageExport(imageDpi);
+        foreach (const GraphicsLayer* imageLayer, imageLayers) {
+          QString layerDestStr = destStr;
+          if (imageLayer) {
+            layerDestStr.replace("{{LAYER}}", imageLayer->getName());
+            foreach (GraphicsLayer* layer, layers) {
+              layer->setVisible(layer == imageLayer);
+            }
+          }
+          QString destPathStr = AttributeSubstitutor::substitute(
+              layerDestStr, board, [&](const QString& str) {
+                return FilePath::cleanFileName(
+                    str, FilePath::ReplaceSpaces | FilePath::KeepCase);
+              });
+          FilePath fp(QFileInfo(destPathStr).absoluteFilePath());
+          imageExport.exportNow(scene, rect, Qt::black, fp);  // can throw
+          print(QString("    => '%1'").arg(prettyPath(fp, destPathStr)));
           writtenFilesCounter[fp]++;
         }
+        imageExport.waitForFinished();  // can throw
       }
     }
 
     // Save project
     if (save) {
       print(tr("Save project..."));
+      profiler.startStage("save_project");
       if (failIfFileFormatUnstable()) {
         success = false;
       } else {
@@ -507,6 +1190,28 @@ bool CommandLineInterface::openProject(
       }
     }
 
+    profiler.finishStage();
+
+    // Print memory report
+    if (memoryReport) {
+      print(tr("Memory report:"));
+      ProjectMemoryReport report(project);
+      print(report.toString().trimmed());
+    }
+
+    // Write profile
+    if (!profileFile.isEmpty()) {
+      QString destPathStr = AttributeSubstitutor::substitute(
+          profileFile, &project, [&](const QString& str) {
+            return FilePath::cleanFileName(
+                str, FilePath::ReplaceSpaces | FilePath::KeepCase);
+          });
+      FilePath fp(QFileInfo(destPathStr).absoluteFilePath());
+      print(tr("Write profile to '%1'...").arg(prettyPath(fp, destPathStr)));
+      profiler.writeJson(fp);  // can throw
+      writtenFilesCounter[fp]++;
+    }
+
     // Fail if some files were written multiple times
     bool                        filesOverwritten = false;
     QMapIterator<FilePath, int> writtenFilesIterator(writtenFilesCounter);
@@ -535,11 +1240,139 @@ bool CommandLineInterface::openProject(
   }
 }
 
+bool CommandLineInterface::openProjects(const QStringList& projectFiles,
+                                        const QStringList& args,
+                                        int jobs) const noexcept {
+  // Each project is processed in a separate process, which avoids any issues
+  // with thread-safety and keeps the projects isolated from each other (e.g.
+  // in case of crashes). The output of each process is printed at once when
+  // it has finished to not mix up the output of different projects.
+  print(tr("Process %1 projects with %2 parallel job(s)...")
+            .arg(projectFiles.count())
+            .arg(jobs));
+  std::vector<std::unique_ptr<QProcess>> processes(projectFiles.count());
+  QVector<bool>                          results(projectFiles.count(), false);
+  int                                    started  = 0;
+  int                                    finished = 0;
+  QEventLoop                             loop;
+  std::function<void()>                  startNext;
+  auto onFinished = [&](int index, bool success) {
+    QProcess& process = *processes.at(index);
+    print(QString("==> %1").arg(projectFiles.at(index)));
+    print(QString::fromLocal8Bit(process.readAllStandardOutput()), 0);
+    printErr(QString::fromLocal8Bit(process.readAllStandardError()), 0);
+    if ((!success) && (process.error() == QProcess::FailedToStart)) {
+      printErr(tr("ERROR: Failed to start process: %1")
+                   .arg(process.errorString()));
+    }
+    results[index] = success;
+    ++finished;
+    if (finished < projectFiles.count()) {
+      startNext();
+    } else {
+      loop.quit();
+    }
+  };
+  startNext = [&]() {
+    while ((started < projectFiles.count()) && (started - finished < jobs)) {
+      int       index   = started++;
+      QProcess* process = new QProcess();
+      processes[index].reset(process);
+      QObject::connect(
+          process,
+          static_cast<void (QProcess::*)(int, QProcess::ExitStatus)>(
+              &QProcess::finished),
+          [&, index](int exitCode, QProcess::ExitStatus exitStatus) {
+            onFinished(index, (exitStatus == QProcess::NormalExit) &&
+                                  (exitCode == 0));
+          });
+      auto onError = [&, index](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+          onFinished(index, false);
+        }
+      };
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 6, 0))
+      QObject::connect(process, &QProcess::errorOccurred, onError);
+#else
+      QObject::connect(
+          process,
+          static_cast<void (QProcess::*)(QProcess::ProcessError)>(
+              &QProcess::error),
+          onError);
+#endif
+      process->start(qApp->applicationFilePath(),
+                     QStringList(args) << projectFiles.at(index));
+    }
+  };
+  startNext();
+  if (finished < projectFiles.count()) {
+    loop.exec();
+  }
+
+  // Print summary
+  QStringList failedProjects;
+  for (int i = 0; i < projectFiles.count(); ++i) {
+    if (!results.at(i)) {
+      failedProjects.append(projectFiles.at(i));
+    }
+  }
+  print(tr("Processed %1 projects, %2 failed.")
+            .arg(projectFiles.count())
+            .arg(failedProjects.count()));
+  foreach (const QString& project, failedProjects) {
+    printErr(QString("  - %1").arg(project));
+  }
+  return failedProjects.isEmpty();
+}
+
+QByteArray CommandLineInterface::getProjectFingerprint(
+    const FilePath& projectFp) noexcept {
+  // Size and modification time of all files in the project directory. The
+  // "output" directory is skipped since exports write into it, which would
+  // otherwise invalidate the cached project on every request.
+  const FilePath dir = projectFp.getParentDir();
+  QStringList    entries;
+  QDirIterator   it(dir.toStr(), QDir::Files | QDir::Hidden,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    QFileInfo info(it.next());
+    QString   path = FilePath(info.absoluteFilePath()).toRelative(dir);
+    if (!path.startsWith("output/")) {
+      entries.append(QString("%1:%2:%3").arg(
+          path, QString::number(info.size()),
+          QString::number(info.lastModified().toMSecsSinceEpoch())));
+    }
+  }
+  std::sort(entries.begin(), entries.end());
+  return QCryptographicHash::hash(entries.join('\n').toUtf8(),
+                                  QCryptographicHash::Md5);
+}
+
+QStringList CommandLineInterface::readProjectsFile(const QString& filePath) {
+  FilePath    fp(QFileInfo(filePath).absoluteFilePath());
+  QString     content = FileUtils::readFile(fp);  // can throw
+  QStringList projects;
+  foreach (const QString& line, content.split('\n')) {
+    QString path = line.trimmed();
+    if ((!path.isEmpty()) && (!path.startsWith('#'))) {
+      projects.append(QDir(fp.getParentDir().toStr()).absoluteFilePath(path));
+    }
+  }
+  return projects;
+}
+
 bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
-                                       bool save, bool strict) const noexcept {
+                                       bool save, bool strict, int jobs) const
+    noexcept {
   try {
     bool success = true;
 
+    // Check only once whether saving is allowed, not for every element
+    if (save && failIfFileFormatUnstable()) {
+      success = false;
+      save    = false;
+    }
+
     // Open library
     FilePath libFp(QFileInfo(libDir).absoluteFilePath());
     print(tr("Open library '%1'...").arg(prettyPath(libFp, libDir)));
@@ -548,103 +1381,41 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
         TransactionalFileSystem::open(libFp, save);  // can throw
     Library lib(std::unique_ptr<TransactionalDirectory>(
         new TransactionalDirectory(libFs)));  // can throw
-    processLibraryElement(libDir, *libFs, lib, save, strict,
-                          success);  // can throw
+    QStringList messages = processLibraryElement(libDir, *libFs, lib, save,
+                                                 strict, success);  // can throw
+    foreach (const QString& msg, messages) { printErr(msg); }
 
-    // Open all component categories
+    // Open all elements
     if (all) {
       QStringList elements = lib.searchForElements<ComponentCategory>();
       print(tr("Process %1 component categories...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        ComponentCategory element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, element, save, strict,
-                              success);  // can throw
-      }
-    }
+      processLibraryElements<ComponentCategory>(libDir, libFp, elements, save,
+                                                strict, jobs, success);
 
-    // Open all package categories
-    if (all) {
-      QStringList elements = lib.searchForElements<PackageCategory>();
+      elements = lib.searchForElements<PackageCategory>();
       print(tr("Process %1 package categories...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        PackageCategory element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, element, save, strict,
-                              success);  // can throw
-      }
-    }
+      processLibraryElements<PackageCategory>(libDir, libFp, elements, save,
+                                              strict, jobs, success);
 
-    // Open all symbols
-    if (all) {
-      QStringList elements = lib.searchForElements<Symbol>();
+      elements = lib.searchForElements<Symbol>();
       print(tr("Process %1 symbols...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        Symbol element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, element, save, strict,
-                              success);  // can throw
-      }
-    }
+      processLibraryElements<Symbol>(libDir, libFp, elements, save, strict,
+                                     jobs, success);
 
-    // Open all packages
-    if (all) {
-      QStringList elements = lib.searchForElements<Package>();
+      elements = lib.searchForElements<Package>();
       print(tr("Process %1 packages...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        Package element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, element, save, strict,
-                              success);  // can throw
-      }
-    }
+      processLibraryElements<Package>(libDir, libFp, elements, save, strict,
+                                      jobs, success);
 
-    // Open all components
-    if (all) {
-      QStringList elements = lib.searchForElements<Component>();
+      elements = lib.searchForElements<Component>();
       print(tr("Process %1 components...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        Component element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, element, save, strict,
-                              success);  // can throw
-      }
-    }
+      processLibraryElements<Component>(libDir, libFp, elements, save, strict,
+                                        jobs, success);
 
-    // Open all devices
-    if (all) {
-      QStringList elements = lib.searchForElements<Device>();
+      elements = lib.searchForElements<Device>();
       print(tr("Process %1 devices...").arg(elements.count()));
-      foreach (const QString& dir, elements) {
-        FilePath fp = libFp.getPathTo(dir);
-        qInfo() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
-        std::shared_ptr<TransactionalFileSystem> fs =
-            TransactionalFileSystem::open(fp, save);  // can throw
-        Device element(std::unique_ptr<TransactionalDirectory>(
-            new TransactionalDirectory(fs)));  // can throw
-        processLibraryElement(libDir, *fs, element, save, strict,
-                              success);  // can throw
-      }
+      processLibraryElements<Device>(libDir, libFp, elements, save, strict,
+                                     jobs, success);
     }
 
     return success;
@@ -654,11 +1425,64 @@ bool CommandLineInterface::openLibrary(const QString& libDir, bool all,
   }
 }
 
-void CommandLineInterface::processLibraryElement(const QString& libDir,
-                                                 TransactionalFileSystem& fs,
-                                                 LibraryBaseElement& element,
-                                                 bool save, bool strict,
-                                                 bool& success) const {
+template <typename ElementType>
+void CommandLineInterface::processLibraryElements(const QString&     libDir,
+                                                  const FilePath&    libFp,
+                                                  const QStringList& elements,
+                                                  bool save, bool strict,
+                                                  int   jobs,
+                                                  bool& success) const {
+  // Each element is opened and checked in a worker thread, with at most
+  // "jobs" elements in flight. Each element has its own file system, so the
+  // jobs are independent of each other. The messages are printed in the
+  // original order of the elements to get deterministic output.
+  struct Result {
+    QStringList messages;
+    bool        success;
+  };
+  auto process = [this, libDir, libFp, save, strict](const QString& dir) {
+    FilePath fp = libFp.getPathTo(dir);
+    qInfo() << tr("Open '%1'...").arg(prettyPath(fp, libDir));
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::open(fp, save);  // can throw
+    ElementType element(std::unique_ptr<TransactionalDirectory>(
+        new TransactionalDirectory(fs)));  // can throw
+    Result result{QStringList(), true};
+    result.messages = processLibraryElement(libDir, *fs, element, save, strict,
+                                            result.success);  // can throw
+    return result;
+  };
+  QList<QFuture<Result>> futures;
+  auto sg = scopeGuard([&futures]() {
+    // Wait for all jobs in case of an exception since they access this scope
+    for (QFuture<Result>& future : futures) {
+      try {
+        future.waitForFinished();
+      } catch (...) {
+      }
+    }
+  });
+  int started = 0;
+  for (int i = 0; i < elements.count(); ++i) {
+    while ((started < elements.count()) && (started - i < jobs)) {
+      const QString dir = elements.at(started++);
+      futures.append(QtConcurrent::run([process, dir]() {
+        return process(dir);  // can throw
+      }));
+    }
+    const Result result = futures.at(i).result();  // can throw
+    foreach (const QString& msg, result.messages) { printErr(msg); }
+    if (!result.success) {
+      success = false;
+    }
+  }
+}
+
+QStringList CommandLineInterface::processLibraryElement(
+    const QString& libDir, TransactionalFileSystem& fs,
+    LibraryBaseElement& element, bool save, bool strict, bool& success) const {
+  QStringList messages;
+
   // Save element to transactional file system, if needed
   if (strict || save) {
     element.save();  // can throw
@@ -673,8 +1497,8 @@ void CommandLineInterface::processLibraryElement(const QString& libDir,
     // sort file paths to increases readability of console output
     std::sort(paths.begin(), paths.end());
     foreach (const QString& path, paths) {
-      printErr(QString("    - Non-canonical file: %1")
-                   .arg(prettyPath(fs.getAbsPath(path), libDir)));
+      messages.append(QString("    - Non-canonical file: %1")
+                          .arg(prettyPath(fs.getAbsPath(path), libDir)));
     }
     if (paths.count() > 0) {
       success = false;
@@ -684,16 +1508,236 @@ void CommandLineInterface::processLibraryElement(const QString& libDir,
   // Save element to file system, if needed
   if (save) {
     qInfo() << tr("Save '%1'...").arg(prettyPath(fs.getPath(), libDir));
-    if (failIfFileFormatUnstable()) {
-      success = false;
-    } else {
-      fs.save();  // can throw
-    }
+    fs.save();  // can throw
   }
 
   // Do not propagate changes in the transactional file system to the
   // following checks
   fs.discardChanges();
+  return messages;
+}
+
+bool CommandLineInterface::importEagleLibraries(const QString&     libDir,
+                                                const QStringList& inputs,
+                                                const QString& uuidListFile,
+                                                int jobs) const noexcept {
+  try {
+    bool success = true;
+
+    // Collect input files, directories are searched for *.lbr files
+    QList<QPair<FilePath, QString>> files;  // <FilePath, Input>
+    foreach (const QString& input, inputs) {
+      FilePath fp(QFileInfo(input).absoluteFilePath());
+      if (fp.isExistingDir()) {
+        QDir dir(fp.toStr());
+        foreach (const QString& name,
+                 dir.entryList(QStringList("*.lbr"), QDir::Files, QDir::Name)) {
+          files.append(qMakePair(fp.getPathTo(name), input));
+        }
+      } else if (fp.isExistingFile()) {
+        files.append(qMakePair(fp, input));
+      } else {
+        printErr(tr("ERROR: File not found: %1").arg(prettyPath(fp, input)));
+        success = false;
+      }
+    }
+
+    // Create library if it does not exist yet
+    FilePath libFp(QFileInfo(libDir).absoluteFilePath());
+    print(tr("Import %1 Eagle libraries into '%2'...")
+              .arg(files.count())
+              .arg(prettyPath(libFp, libDir)));
+    if (!libFp.getPathTo("library.lp").isExistingFile()) {
+      qInfo() << tr("Create library '%1'...").arg(prettyPath(libFp, libDir));
+      std::shared_ptr<TransactionalFileSystem> fs =
+          TransactionalFileSystem::openRW(libFp);  // can throw
+      TransactionalDirectory dir(fs);
+      Library lib(Uuid::createRandom(), Version::fromString("0.1"),
+                  "LibrePCB CLI",
+                  ElementName(cleanElementName(libFp.getCompleteBasename())),
+                  "Imported from Eagle libraries.", QString());  // can throw
+      lib.moveTo(dir);  // can throw
+      fs->save();       // can throw
+    }
+
+    // Parse the Eagle libraries in worker threads, ahead of the conversion
+    // of the previous library. Exceptions are transported as strings since
+    // parseagle does not throw QException.
+    struct ParsedLibrary {
+      std::shared_ptr<parseagle::Library> library;
+      QString                             error;
+    };
+    auto parse = [](const FilePath& fp) {
+      ParsedLibrary result;
+      try {
+        result.library = std::make_shared<parseagle::Library>(fp.toStr());
+      } catch (const std::exception& e) {
+        result.error = e.what();
+      }
+      return result;
+    };
+
+    // Convert all elements. The UUID list is shared by all libraries, so
+    // Eagle elements are always mapped to the same LibrePCB elements.
+    FilePath uuidListFp = uuidListFile.isEmpty()
+        ? libFp.getPathTo("eagle-import.ini")
+        : FilePath(QFileInfo(uuidListFile).absoluteFilePath());
+    eagleimport::ConverterDb      db(uuidListFp);
+    QList<QFuture<ParsedLibrary>> futures;
+    int                           started   = 0;
+    int                           count     = 0;
+    int                           converted = 0;
+    for (int i = 0; i < files.count(); ++i) {
+      while ((started < files.count()) && (started - i < jobs)) {
+        const FilePath fp = files.at(started++).first;
+        futures.append(QtConcurrent::run([parse, fp]() { return parse(fp); }));
+      }
+      const FilePath& fp = files.at(i).first;
+      print(tr("Convert '%1'...").arg(prettyPath(fp, files.at(i).second)));
+      const ParsedLibrary parsed = futures.at(i).result();
+      futures[i] = QFuture<ParsedLibrary>();  // free memory of the result
+      if (!parsed.library) {
+        printErr(tr("ERROR: %1").arg(parsed.error));
+        success = false;
+        continue;
+      }
+      db.setCurrentLibraryFilePath(fp);
+      importEagleElements(db, parsed.library->getSymbols(),
+                          &eagleimport::LibraryConverter::convertSymbol, libFp,
+                          jobs, count, converted, success);
+      importEagleElements(db, parsed.library->getPackages(),
+                          &eagleimport::LibraryConverter::convertPackage,
+                          libFp, jobs, count, converted, success);
+      importEagleElements(db, parsed.library->getDeviceSets(),
+                          &eagleimport::LibraryConverter::convertDeviceSet,
+                          libFp, jobs, count, converted, success);
+    }
+    db.save();
+    print(tr("Converted %1 of %2 elements.").arg(converted).arg(count));
+    return success;
+  } catch (const Exception& e) {
+    printErr(tr("ERROR: %1").arg(e.getMsg()));
+    return false;
+  }
+}
+
+template <typename ElementListType, typename ConvertFunctionType>
+void CommandLineInterface::importEagleElements(
+    eagleimport::ConverterDb& db, const ElementListType& elements,
+    ConvertFunctionType convert, const FilePath& libFp, int jobs, int& count,
+    int& converted, bool& success) const {
+  // Same scheduling as in processLibraryElements(): The elements are
+  // converted in worker threads, but saved and printed in the original order
+  // to get deterministic output. The conversion functions do not throw, so
+  // all futures are finished when leaving this method.
+  typedef typename ElementListType::value_type Element;
+  typedef eagleimport::LibraryConverter::Result Result;
+  QList<QFuture<Result>> futures;
+  int                    started = 0;
+  for (int i = 0; i < elements.count(); ++i) {
+    while ((started < elements.count()) && (started - i < jobs)) {
+      const Element* element = &elements.at(started++);
+      futures.append(QtConcurrent::run(
+          [&db, element, convert]() { return convert(db, *element); }));
+    }
+    const Result result = futures.at(i).result();
+    ++count;
+    if (!result.error.isNull()) {
+      printErr(QString("    - %1").arg(result.error));
+      success = false;
+    }
+    if (result.success) {
+      try {
+        eagleimport::LibraryConverter::save(result, libFp);  // can throw
+        ++converted;
+      } catch (const Exception& e) {
+        printErr(QString("    - %1").arg(e.getMsg()));
+        success = false;
+      }
+    }
+  }
+}
+
+bool CommandLineInterface::generateProject(
+    const QString& projectFile, const QString& libDir,
+    const ProjectGenerator::Options& options) const noexcept {
+  try {
+    FilePath projectFp(QFileInfo(projectFile).absoluteFilePath());
+    FilePath libFp(QFileInfo(libDir).absoluteFilePath());
+    print(tr("Generate project '%1' with devices from '%2'...")
+              .arg(prettyPath(projectFp, projectFile),
+                   prettyPath(libFp, libDir)));
+    QElapsedTimer timer;
+    timer.start();
+    ProjectGenerator generator(libFp, options);
+    generator.generate(projectFp);  // can throw
+    print(tr("Generated in %1 ms.").arg(timer.elapsed()));
+    return true;
+  } catch (const Exception& e) {
+    printErr(tr("ERROR: %1").arg(e.getMsg()));
+    return false;
+  }
+}
+
+void CommandLineInterface::writeDrcReportJson(const Board&                board,
+                                              const BoardDesignRuleCheck& drc,
+                                              const FilePath& fp) {
+  QJsonArray messages;
+  foreach (const BoardDesignRuleCheckMessage& msg, drc.getMessages()) {
+    Point      pos = getDrcMessagePosition(msg);
+    QJsonArray items;
+    foreach (const Uuid& uuid, msg.getItems()) {
+      items.append(uuid.toStr());
+    }
+    messages.append(QJsonObject{
+        {"message", msg.getMessage()},
+        {"x", pos.getX().toMmString()},
+        {"y", pos.getY().toMmString()},
+        {"items", items},
+    });
+  }
+  QJsonArray stages;
+  foreach (const auto& stage, drc.getStageDurations()) {
+    stages.append(QJsonObject{
+        {"stage", stage.first},
+        {"duration_ms", stage.second},
+    });
+  }
+  QJsonObject root{
+      {"board", *board.getName()},
+      {"messages", messages},
+      {"stages", stages},
+  };
+  FileUtils::writeFile(fp, QJsonDocument(root).toJson());  // can throw
+}
+
+void CommandLineInterface::writeDrcReportCsv(const Board&                board,
+                                             const BoardDesignRuleCheck& drc,
+                                             const FilePath&             fp) {
+  QStringList comment;
+  comment.append(tr("DRC report of board '%1'").arg(*board.getName()));
+  foreach (const auto& stage, drc.getStageDurations()) {
+    comment.append(QString("%1: %2 ms").arg(stage.first).arg(stage.second));
+  }
+  CsvFile csv;
+  csv.setComment(comment.join("\n"));
+  csv.setHeader({"Message", "X", "Y"});
+  foreach (const BoardDesignRuleCheckMessage& msg, drc.getMessages()) {
+    Point pos = getDrcMessagePosition(msg);
+    csv.addValue({msg.getMessage(), pos.getX().toMmString(),
+                  pos.getY().toMmString()});  // can throw
+  }
+  csv.saveToFile(fp);  // can throw
+}
+
+Point CommandLineInterface::getDrcMessagePosition(
+    const BoardDesignRuleCheckMessage& msg) noexcept {
+  // use the center of the bounding rect of all locations
+  QRectF rect;
+  foreach (const Path& path, msg.getLocations()) {
+    rect |= path.toQPainterPathPx().boundingRect();
+  }
+  return Point::fromPx(rect.center());
 }
 
 QString CommandLineInterface::prettyPath(const FilePath& path,
@@ -724,6 +1768,10 @@ bool CommandLineInterface::failIfFileFormatUnstable() noexcept {
 }
 
 void CommandLineInterface::print(const QString& str, int newlines) noexcept {
+  if (sCapturedStdout) {
+    *sCapturedStdout += str % QString(newlines, '\n');
+    return;
+  }
   QTextStream s(stdout);
   s << str;
   for (int i = 0; i < newlines; ++i) {
@@ -732,6 +1780,10 @@ void CommandLineInterface::print(const QString& str, int newlines) noexcept {
 }
 
 void CommandLineInterface::printErr(const QString& str, int newlines) noexcept {
+  if (sCapturedStderr) {
+    *sCapturedStderr += str % QString(newlines, '\n');
+    return;
+  }
   QTextStream s(stderr);
   s << str;
   for (int i = 0; i < newlines; ++i) {
@@ -739,6 +1791,13 @@ void CommandLineInterface::printErr(const QString& str, int newlines) noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Static Members
+ ******************************************************************************/
+
+QString* CommandLineInterface::sCapturedStdout = nullptr;
+QString* CommandLineInterface::sCapturedStderr = nullptr;
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -23,8 +23,12 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "projectgenerator.h"
+
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -32,12 +36,24 @@ namespace librepcb {
 
 class Application;
 class FilePath;
+class Point;
 class TransactionalFileSystem;
 
+namespace eagleimport {
+class ConverterDb;
+}
+
 namespace library {
 class LibraryBaseElement;
 }
 
+namespace project {
+class Board;
+class BoardDesignRuleCheck;
+class BoardDesignRuleCheckMessage;
+class Project;
+}  // namespace project
+
 namespace cli {
 
 /*******************************************************************************
@@ -54,25 +70,76 @@ public:
   // Constructors / Destructor
   CommandLineInterface() = delete;
   explicit CommandLineInterface(const Application& app) noexcept;
-  ~CommandLineInterface() noexcept = default;
+  ~CommandLineInterface() noexcept;
 
   // General Methods
   int execute() noexcept;
 
+private:  // Types
+  /// A project kept open in server mode to speed up subsequent requests
+  struct CachedProject {
+    QByteArray fingerprint;  ///< see #getProjectFingerprint()
+    std::shared_ptr<TransactionalFileSystem> fileSystem;
+    std::shared_ptr<project::Project>        project;
+  };
+
 private:  // Methods
-  bool openProject(const QString& projectFile, bool runErc,
+  int  execute(const QStringList& arguments) noexcept;
+  int  serve() noexcept;
+  bool openProject(const QString& projectFile, bool runErc, bool runDrc,
+                   const QString&     drcSettingsPath,
+                   const QStringList& drcReportFiles,
                    const QStringList& exportSchematicsFiles,
+                   const QStringList& exportSchematicImageFiles,
                    const QStringList& exportBomFiles,
                    const QStringList& exportBoardBomFiles,
-                   const QString& bomAttributes, bool exportPcbFabricationData,
+                   const QString&     bomAttributes,
+                   const QStringList& exportPnpFiles,
+                   bool               exportPcbFabricationData,
                    const QString&     pcbFabricationSettingsPath,
-                   const QStringList& boards, bool save, bool strict) const
+                   const QStringList& exportBoardImageFiles, int imageDpi,
+                   const QStringList& boards, bool save, bool strict,
+                   const QString& profileFile,
+                   bool           memoryReport) const noexcept;
+  bool openProjects(const QStringList& projectFiles, const QStringList& args,
+                    int jobs) const noexcept;
+  bool openLibrary(const QString& libDir, bool all, bool save, bool strict,
+                   int jobs) const noexcept;
+  template <typename ElementType>
+  void        processLibraryElements(const QString&     libDir,
+                                     const FilePath&    libFp,
+                                     const QStringList& elements, bool save,
+                                     bool strict, int jobs, bool& success) const;
+  QStringList processLibraryElement(const QString&               libDir,
+                                    TransactionalFileSystem&     fs,
+                                    library::LibraryBaseElement& element,
+                                    bool save, bool strict,
+                                    bool& success) const;
+  bool        importEagleLibraries(const QString&     libDir,
+                                   const QStringList& inputs,
+                                   const QString&     uuidListFile,
+                                   int                jobs) const noexcept;
+  bool        generateProject(const QString& projectFile, const QString& libDir,
+                              const ProjectGenerator::Options& options) const
       noexcept;
-  bool openLibrary(const QString& libDir, bool all, bool save,
-                   bool strict) const noexcept;
-  void processLibraryElement(const QString& libDir, TransactionalFileSystem& fs,
-                             library::LibraryBaseElement& element, bool save,
-                             bool strict, bool& success) const;
+  template <typename ElementListType, typename ConvertFunctionType>
+  void        importEagleElements(eagleimport::ConverterDb& db,
+                                  const ElementListType&    elements,
+                                  ConvertFunctionType       convert,
+                                  const FilePath& libFp, int jobs, int& count,
+                                  int& converted, bool& success) const;
+
+  static QByteArray  getProjectFingerprint(const FilePath& projectFp) noexcept;
+  static QStringList readProjectsFile(const QString& filePath);
+
+  static void    writeDrcReportJson(const project::Board&                board,
+                                    const project::BoardDesignRuleCheck& drc,
+                                    const FilePath&                      fp);
+  static void    writeDrcReportCsv(const project::Board&                board,
+                                   const project::BoardDesignRuleCheck& drc,
+                                   const FilePath&                      fp);
+  static Point   getDrcMessagePosition(
+        const project::BoardDesignRuleCheckMessage& msg) noexcept;
   static QString prettyPath(const FilePath& path,
                             const QString&  style) noexcept;
   static bool    failIfFileFormatUnstable() noexcept;
@@ -81,6 +148,20 @@ private:  // Methods
 
 private:  // Data
   const Application& mApp;
+  bool               mServing;  ///< whether #serve() is running
+
+  /// Unmodified projects opened in server mode, key: project file path
+  mutable QCache<QString, CachedProject> mProjectCache;
+
+  /// If set, #print() and #printErr() append to these strings (server mode)
+  static QString* sCapturedStdout;
+  static QString* sCapturedStderr;
+
+  // Constants
+  static const int sMaxCachedProjects = 5;
+
+  /// Default resolution of exported images
+  static const int sDefaultImageDpi = 300;
 };
 
 /*******************************************************************************
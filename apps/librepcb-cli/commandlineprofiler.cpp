@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "commandlineprofiler.h"
+
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/systeminfo.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace cli {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+CommandLineProfiler::CommandLineProfiler() noexcept
+  : mTotalCpuTimeStart(SystemInfo::getProcessCpuTime()),
+    mStageCpuTimeStart(-1),
+    mStageRunning(false) {
+  mTotalTimer.start();
+}
+
+CommandLineProfiler::~CommandLineProfiler() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void CommandLineProfiler::startStage(const QString& name,
+                                     const QString& target) noexcept {
+  finishStage();
+  QMutexLocker lock(&mMutex);
+  mStages.append(Stage{name, target, -1, -1, -1, {}});
+  mStageRunning      = true;
+  mStageCpuTimeStart = SystemInfo::getProcessCpuTime();
+  mStageTimer.start();
+}
+
+void CommandLineProfiler::finishStage() noexcept {
+  QMutexLocker lock(&mMutex);
+  if (mStageRunning) {
+    Stage&       stage = mStages.last();
+    const qint64 cpu   = SystemInfo::getProcessCpuTime();
+    stage.wallTimeMs   = mStageTimer.elapsed();
+    stage.cpuTimeMs    = ((cpu >= 0) && (mStageCpuTimeStart >= 0))
+        ? (cpu - mStageCpuTimeStart)
+        : -1;
+    stage.peakMemoryBytes = SystemInfo::getPeakMemoryUsage();
+    mStageRunning         = false;
+  }
+}
+
+void CommandLineProfiler::addDetail(const QString& name,
+                                    qint64         durationMs) noexcept {
+  QMutexLocker lock(&mMutex);
+  if (mStageRunning) {
+    mStages.last().details.append(qMakePair(name, durationMs));
+  }
+}
+
+QJsonDocument CommandLineProfiler::toJson() const noexcept {
+  QMutexLocker lock(&mMutex);
+  QJsonArray   stages;
+  foreach (const Stage& stage, mStages) {
+    if (mStageRunning && (&stage == &mStages.last())) {
+      break;  // not finished yet
+    }
+    QJsonArray details;
+    foreach (const auto& detail, stage.details) {
+      details.append(QJsonObject{
+          {"name", detail.first},
+          {"duration_ms", detail.second},
+      });
+    }
+    stages.append(QJsonObject{
+        {"stage", stage.name},
+        {"target", stage.target},
+        {"wall_time_ms", stage.wallTimeMs},
+        {"cpu_time_ms", stage.cpuTimeMs},
+        {"peak_rss_bytes", stage.peakMemoryBytes},
+        {"details", details},
+    });
+  }
+  const qint64 cpu = SystemInfo::getProcessCpuTime();
+  QJsonObject  root{
+      {"wall_time_ms", mTotalTimer.elapsed()},
+      {"cpu_time_ms", ((cpu >= 0) && (mTotalCpuTimeStart >= 0))
+                          ? (cpu - mTotalCpuTimeStart)
+                          : -1},
+      {"peak_rss_bytes", SystemInfo::getPeakMemoryUsage()},
+      {"stages", stages},
+  };
+  return QJsonDocument(root);
+}
+
+void CommandLineProfiler::writeJson(const FilePath& fp) const {
+  FileUtils::writeFile(fp, toJson().toJson());  // can throw
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace cli
+}  // namespace librepcb
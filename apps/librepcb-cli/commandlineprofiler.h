@@ -0,0 +1,131 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CLI_COMMANDLINEPROFILER_H
+#define LIBREPCB_CLI_COMMANDLINEPROFILER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class FilePath;
+
+namespace cli {
+
+/*******************************************************************************
+ *  Class CommandLineProfiler
+ ******************************************************************************/
+
+/**
+ * @brief Records the resource usage of the stages of a CLI command
+ *
+ * For each stage, the wall time, the CPU time (of the whole process, i.e. all
+ * threads) and the peak memory usage at the end of the stage is recorded.
+ * Stages may additionally contain details (e.g. the duration of each exported
+ * Gerber file) which only have a wall time since they run concurrently.
+ *
+ * Used for the option `--profile` of the command `open-project`.
+ */
+class CommandLineProfiler final {
+public:
+  // Constructors / Destructor
+  CommandLineProfiler() noexcept;
+  CommandLineProfiler(const CommandLineProfiler& other) = delete;
+  ~CommandLineProfiler() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Start a new stage (the currently running stage gets finished)
+   *
+   * @param name    Identifier of the stage (e.g. "open_project")
+   * @param target  The object the stage works on (e.g. a board name or an
+   *                output file), may be empty
+   */
+  void startStage(const QString& name,
+                  const QString& target = QString()) noexcept;
+
+  /**
+   * @brief Finish the currently running stage (if any)
+   */
+  void finishStage() noexcept;
+
+  /**
+   * @brief Add a detail entry to the currently running stage
+   *
+   * @note  This method is thread-safe.
+   *
+   * @param name        Name of the detail
+   * @param durationMs  Wall time of the detail in milliseconds
+   */
+  void addDetail(const QString& name, qint64 durationMs) noexcept;
+
+  /**
+   * @brief Serialize all finished stages to JSON
+   *
+   * @return The JSON document
+   */
+  QJsonDocument toJson() const noexcept;
+
+  /**
+   * @brief Write all finished stages to a JSON file
+   *
+   * @param fp    The file to write (will be overwritten if it exists)
+   *
+   * @throw Exception in case of an error
+   */
+  void writeJson(const FilePath& fp) const;
+
+  // Operator Overloadings
+  CommandLineProfiler& operator=(const CommandLineProfiler& rhs) = delete;
+
+private:  // Types
+  struct Stage {
+    QString                       name;
+    QString                       target;
+    qint64                        wallTimeMs;
+    qint64                        cpuTimeMs;
+    qint64                        peakMemoryBytes;
+    QList<QPair<QString, qint64>> details;
+  };
+
+private:  // Data
+  QElapsedTimer  mTotalTimer;
+  qint64         mTotalCpuTimeStart;
+  QElapsedTimer  mStageTimer;
+  qint64         mStageCpuTimeStart;
+  bool           mStageRunning;
+  QList<Stage>   mStages;
+  mutable QMutex mMutex;  ///< protects #mStages (details come from any thread)
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace cli
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CLI_COMMANDLINEPROFILER_H
@@ -0,0 +1,179 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "imageexport.h"
+
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/units/length.h>
+#include <librepcb/common/utils/taskscheduler.h>
+
+#include <QSvgGenerator>
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+#include <exception>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace cli {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ImageExport::ImageExport(int dpi) noexcept : mDpi(dpi), mJobs() {
+}
+
+ImageExport::~ImageExport() noexcept {
+  // The jobs access the scenes, so never leave while they are running.
+  try {
+    waitForFinished();
+  } catch (...) {
+  }
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool ImageExport::isSupportedFormat(const QString& suffix) noexcept {
+  return (suffix == "png") || (suffix == "svg");
+}
+
+void ImageExport::exportNow(QGraphicsScene& scene, const QRectF& sceneRect,
+                            const QColor& background, const FilePath& fp) {
+  if (fp.getSuffix().toLower() == "svg") {
+    // The SVG is generated while rendering, writing it is cheap.
+    writeSvg(scene, sceneRect, background, fp, mDpi);  // can throw
+  } else {
+    QImage image =
+        renderImage(scene, sceneRect, background, mDpi);  // can throw
+    mJobs.append(TaskScheduler::run(TaskScheduler::Priority::Normal,
+                                    [image, fp]() { writePng(image, fp); }));
+  }
+}
+
+void ImageExport::startExport(QGraphicsScene& scene, const QRectF& sceneRect,
+                              const QColor&   background,
+                              const FilePath& fp) noexcept {
+  QGraphicsScene* s   = &scene;
+  const int       dpi = mDpi;
+  mJobs.append(TaskScheduler::run(
+      TaskScheduler::Priority::Normal, [s, sceneRect, background, fp, dpi]() {
+        if (fp.getSuffix().toLower() == "svg") {
+          writeSvg(*s, sceneRect, background, fp, dpi);  // can throw
+        } else {
+          QImage image =
+              renderImage(*s, sceneRect, background, dpi);  // can throw
+          writePng(image, fp);                              // can throw
+        }
+      }));
+}
+
+void ImageExport::waitForFinished() {
+  // Errors are only rethrown after *all* jobs are finished since the jobs are
+  // accessing the scenes.
+  std::exception_ptr error;
+  foreach (QFuture<void> job, mJobs) {
+    try {
+      job.waitForFinished();  // can throw
+    } catch (...) {
+      if (!error) error = std::current_exception();
+    }
+  }
+  mJobs.clear();
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QImage ImageExport::renderImage(QGraphicsScene& scene, const QRectF& sceneRect,
+                                const QColor& background, int dpi) {
+  QSize  size = getImageSize(sceneRect, dpi).toSize();  // can throw
+  QImage image(size, QImage::Format_ARGB32_Premultiplied);
+  if (image.isNull()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Could not create an image of %1x%2 pixels, try a "
+                          "lower resolution.")
+                           .arg(size.width())
+                           .arg(size.height()));
+  }
+  image.fill(background);
+  QPainter painter(&image);
+  painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing |
+                         QPainter::SmoothPixmapTransform);
+  scene.render(&painter, QRectF(QPointF(0, 0), size), sceneRect,
+               Qt::IgnoreAspectRatio);
+  return image;
+}
+
+void ImageExport::writePng(const QImage& image, const FilePath& fp) {
+  FileUtils::writeFile(fp, [&image, &fp](QIODevice& device) {
+    if (!image.save(&device, "png")) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          tr("Could not write to file \"%1\".").arg(fp.toNative()));
+    }
+  });  // can throw
+}
+
+void ImageExport::writeSvg(QGraphicsScene& scene, const QRectF& sceneRect,
+                           const QColor& background, const FilePath& fp,
+                           int dpi) {
+  QRectF  viewBox(QPointF(0, 0), getImageSize(sceneRect, dpi));  // can throw
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  {
+    QSvgGenerator generator;
+    generator.setTitle(fp.getFilename());
+    generator.setOutputDevice(&buffer);
+    generator.setSize(viewBox.toAlignedRect().size());
+    generator.setViewBox(viewBox);
+    generator.setResolution(dpi);
+    QPainter painter(&generator);
+    painter.fillRect(viewBox, background);
+    scene.render(&painter, viewBox, sceneRect, Qt::IgnoreAspectRatio);
+  }  // the SVG is completed when the painter is destroyed
+  FileUtils::writeFile(fp, buffer.data());  // can throw
+}
+
+QSizeF ImageExport::getImageSize(const QRectF& sceneRect, int dpi) {
+  // At least one pixel to get a valid (empty) image of empty scenes.
+  return QSizeF(
+      qMax(Length::fromPx(sceneRect.width()).toInch() * dpi, qreal(1)),
+      qMax(Length::fromPx(sceneRect.height()).toInch() * dpi, qreal(1)));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace cli
+}  // namespace librepcb
@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CLI_IMAGEEXPORT_H
+#define LIBREPCB_CLI_IMAGEEXPORT_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/fileio/filepath.h>
+
+#include <QtCore>
+#include <QtGui>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace cli {
+
+/*******************************************************************************
+ *  Class ImageExport
+ ******************************************************************************/
+
+/**
+ * @brief Renders graphics scenes (boards, schematics) to PNG or SVG files
+ *
+ * A scene is rendered through QGraphicsScene::render(), thus the graphics
+ * items use the same level of detail and cached shapes as when drawn in the
+ * editors.
+ *
+ * QGraphicsScene does not allow to render one scene from several threads at
+ * the same time, but different scenes can be rendered concurrently:
+ *
+ * - #startExport() renders and writes the image in a worker thread. The scene
+ *   must not be modified until #waitForFinished() returned. Used to render
+ *   all schematic pages in parallel.
+ * - #exportNow() renders the image immediately, only encoding and writing
+ *   the file is done in a worker thread. Thus the scene may be modified right
+ *   afterwards, e.g. to render the next layer of a board.
+ *
+ * Used for the options `--export-schematic-images` and
+ * `--export-board-images` of the command `open-project`.
+ */
+class ImageExport final {
+  Q_DECLARE_TR_FUNCTIONS(ImageExport)
+
+public:
+  // Constructors / Destructor
+  ImageExport()                         = delete;
+  ImageExport(const ImageExport& other) = delete;
+  explicit ImageExport(int dpi) noexcept;
+  ~ImageExport() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Check whether a file extension is supported
+   *
+   * @param suffix  The lowercase file extension, e.g. "png".
+   *
+   * @return Whether files with this extension can be exported.
+   */
+  static bool isSupportedFormat(const QString& suffix) noexcept;
+
+  /**
+   * @brief Render a scene immediately and write it in a worker thread
+   *
+   * @param scene       The scene to render.
+   * @param sceneRect   The area of the scene to render.
+   * @param background  Background color of the image.
+   * @param fp          Output file, its extension defines the format.
+   *
+   * @throw Exception   If rendering failed. Errors while writing the file are
+   *                    thrown by #waitForFinished().
+   */
+  void exportNow(QGraphicsScene& scene, const QRectF& sceneRect,
+                 const QColor& background, const FilePath& fp);
+
+  /**
+   * @brief Render and write a scene in a worker thread
+   *
+   * @note  The scene must not be modified or destroyed until
+   *        #waitForFinished() returned.
+   *
+   * @param scene       The scene to render.
+   * @param sceneRect   The area of the scene to render.
+   * @param background  Background color of the image.
+   * @param fp          Output file, its extension defines the format.
+   */
+  void startExport(QGraphicsScene& scene, const QRectF& sceneRect,
+                   const QColor& background, const FilePath& fp) noexcept;
+
+  /**
+   * @brief Wait until all images are written
+   *
+   * @throw Exception   The first error of all exports, if any failed.
+   */
+  void waitForFinished();
+
+  // Operator Overloadings
+  ImageExport& operator=(const ImageExport& rhs) = delete;
+
+private:  // Methods
+  static QImage renderImage(QGraphicsScene& scene, const QRectF& sceneRect,
+                            const QColor& background, int dpi);
+  static void   writePng(const QImage& image, const FilePath& fp);
+  static void   writeSvg(QGraphicsScene& scene, const QRectF& sceneRect,
+                         const QColor& background, const FilePath& fp,
+                         int dpi);
+  static QSizeF getImageSize(const QRectF& sceneRect, int dpi);
+
+private:  // Data
+  int                  mDpi;
+  QList<QFuture<void>> mJobs;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace cli
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CLI_IMAGEEXPORT_H
@@ -8,7 +8,7 @@ TARGET = librepcb-cli
 # Use common project definitions
 include(../../common.pri)
 
-QT += core widgets opengl network xml printsupport sql
+QT += core widgets opengl network xml printsupport sql svg
 
 CONFIG += console
 
@@ -24,10 +24,12 @@ LIBS += \
     -llibrepcblibrarymanager \
     -llibrepcblibraryeditor \
     -llibrepcbprojecteditor \
+    -llibrepcbeagleimport \
     -llibrepcbworkspace \
     -llibrepcbproject \
     -llibrepcblibrary \
     -llibrepcbcommon \
+    -lparseagle \
     -lhoedown \
     -lmuparser \
     -lsexpresso \
@@ -37,6 +39,7 @@ solaris:LIBS += -lproc
 
 INCLUDEPATH += \
     ../../libs \
+    ../../libs/parseagle \
     ../../libs/type_safe/include \
     ../../libs/type_safe/external/debug_assert \
 
@@ -45,15 +48,18 @@ DEPENDPATH += \
     ../../libs/librepcb/librarymanager \
     ../../libs/librepcb/projecteditor \
     ../../libs/librepcb/libraryeditor \
+    ../../libs/librepcb/eagleimport \
     ../../libs/librepcb/workspace \
     ../../libs/librepcb/project \
     ../../libs/librepcb/library \
     ../../libs/librepcb/common \
+    ../../libs/parseagle \
     ../../libs/sexpresso \
     ../../libs/muparser \
 
 PRE_TARGETDEPS += \
     $${DESTDIR}/libhoedown.a \
+    $${DESTDIR}/libparseagle.a \
     $${DESTDIR}/libsexpresso.a \
     $${DESTDIR}/libmuparser.a \
 
@@ -63,6 +69,7 @@ isEmpty(UNBUNDLE) {
         $${DESTDIR}/liblibrepcblibrarymanager.a \
         $${DESTDIR}/liblibrepcbprojecteditor.a \
         $${DESTDIR}/liblibrepcblibraryeditor.a \
+        $${DESTDIR}/liblibrepcbeagleimport.a \
         $${DESTDIR}/liblibrepcbworkspace.a \
         $${DESTDIR}/liblibrepcbproject.a \
         $${DESTDIR}/liblibrepcblibrary.a \
@@ -76,10 +83,16 @@ RESOURCES += \
 
 SOURCES += \
     commandlineinterface.cpp \
+    commandlineprofiler.cpp \
+    imageexport.cpp \
     main.cpp \
+    projectgenerator.cpp \
 
 HEADERS += \
     commandlineinterface.h \
+    commandlineprofiler.h \
+    imageexport.h \
+    projectgenerator.h \
 
 # QuaZIP
 !contains(UNBUNDLE, quazip) {
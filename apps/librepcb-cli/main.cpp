@@ -44,6 +44,17 @@ int main(int argc, char* argv[]) {
   // Silence debug output, it's a command line tool
   Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::Nothing);
 
+  // Without a display server (e.g. in containers or on CI servers), use the
+  // offscreen platform plugin instead of failing to connect to the display.
+  // Nothing is shown anyway, it's a command line tool.
+#if defined(Q_OS_UNIX) && (!defined(Q_OS_OSX))
+  if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM") &&
+      qEnvironmentVariableIsEmpty("DISPLAY") &&
+      qEnvironmentVariableIsEmpty("WAYLAND_DISPLAY")) {
+    qputenv("QT_QPA_PLATFORM", "offscreen");
+  }
+#endif
+
   // Create Application instance
   Application app(argc, argv);
 
@@ -0,0 +1,467 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "projectgenerator.h"
+
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/geometry/cmd/cmdpolygonedit.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/undostack.h>
+#include <librepcb/library/elements.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/cmd/cmdboardadd.h>
+#include <librepcb/project/boards/cmd/cmdboardlayerstackedit.h>
+#include <librepcb/project/boards/cmd/cmdboardnetsegmentadd.h>
+#include <librepcb/project/boards/cmd/cmdboardnetsegmentaddelements.h>
+#include <librepcb/project/boards/cmd/cmdboardplaneadd.h>
+#include <librepcb/project/boards/cmd/cmddeviceinstanceadd.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/cmd/cmdcomponentinstanceadd.h>
+#include <librepcb/project/circuit/cmd/cmdcompsiginstsetnetsignal.h>
+#include <librepcb/project/circuit/cmd/cmdnetsignaladd.h>
+#include <librepcb/project/circuit/componentinstance.h>
+#include <librepcb/project/library/cmd/cmdprojectlibraryaddelement.h>
+#include <librepcb/project/library/projectlibrary.h>
+#include <librepcb/project/metadata/projectmetadata.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/schematics/cmd/cmdschematicadd.h>
+#include <librepcb/project/schematics/cmd/cmdsymbolinstanceadd.h>
+#include <librepcb/project/schematics/items/si_symbol.h>
+#include <librepcb/project/schematics/schematic.h>
+
+#include <QtCore>
+
+#include <memory>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace cli {
+
+using namespace librepcb::library;
+using namespace librepcb::project;
+
+/*******************************************************************************
+ *  Static Helpers
+ ******************************************************************************/
+
+template <typename ElementType>
+static std::unique_ptr<ElementType> openLibraryElement(const FilePath& libDir,
+                                                       const Uuid&     uuid) {
+  FilePath fp =
+      libDir.getPathTo(ElementType::getShortElementName() % "/" % uuid.toStr());
+  return std::unique_ptr<ElementType>(
+      new ElementType(std::unique_ptr<TransactionalDirectory>(
+          new TransactionalDirectory(TransactionalFileSystem::openRO(fp)))));
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ProjectGenerator::ProjectGenerator(const FilePath& libDir,
+                                   const Options&  options) noexcept
+  : mLibDir(libDir), mOptions(options) {
+}
+
+ProjectGenerator::~ProjectGenerator() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void ProjectGenerator::generate(const FilePath& projectFp) {
+  if (Project::isProjectDirectory(projectFp.getParentDir())) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("The directory '%1' already contains a project.")
+                           .arg(projectFp.getParentDir().toNative()));
+  }
+
+  // create the project
+  std::shared_ptr<TransactionalFileSystem> fs =
+      TransactionalFileSystem::openRW(projectFp.getParentDir());  // can throw
+  QScopedPointer<Project> project(Project::create(
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(fs)),
+      projectFp.getFilename()));  // can throw
+  QString name = cleanElementName(projectFp.getCompleteBasename());
+  if (!name.isEmpty()) {
+    project->getMetadata().setName(ElementName(name));  // can throw
+  }
+
+  // Add all the content with undo commands, just like the editors do. This
+  // ensures the project is always in a consistent state.
+  {
+    UndoStack stack;
+    addLibraryElements(*project, stack);  // can throw
+    QList<ComponentInstance*> components =
+        addComponents(*project, stack);  // can throw
+    QList<NetSignal*> nets =
+        addNets(*project, stack, components);      // can throw
+    addSchematics(*project, stack, components);    // can throw
+    addBoards(*project, stack, components, nets);  // can throw
+  }
+
+  // save project to disk
+  project->save();  // can throw
+  fs->save();       // can throw
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ProjectGenerator::addLibraryElements(Project& project, UndoStack& stack) {
+  Library lib(std::unique_ptr<TransactionalDirectory>(
+      new TransactionalDirectory(TransactionalFileSystem::openRO(
+          mLibDir))));  // can throw
+  QStringList devDirs = lib.searchForElements<Device>();
+  devDirs.sort();  // to get deterministic results
+
+  ProjectLibrary& prjLib = project.getLibrary();
+  foreach (const QString& dir, devDirs) {
+    if (mDeviceTypes.count() >= mOptions.deviceTypes) {
+      break;
+    }
+
+    // Load all elements required by the device (if not loaded yet for a
+    // previous device), but add them only if the device is usable.
+    std::unique_ptr<Device>              dev;
+    std::unique_ptr<Package>             pkg;
+    std::unique_ptr<Component>           cmp;
+    std::vector<std::unique_ptr<Symbol>> symbols;
+    DeviceType                           type;
+    try {
+      dev.reset(new Device(std::unique_ptr<TransactionalDirectory>(
+          new TransactionalDirectory(TransactionalFileSystem::openRO(
+              mLibDir.getPathTo(dir))))));  // can throw
+      const Package* pkgPtr = prjLib.getPackage(dev->getPackageUuid());
+      if (!pkgPtr) {
+        pkg    = openLibraryElement<Package>(mLibDir, dev->getPackageUuid());
+        pkgPtr = pkg.get();
+      }
+      const Component* cmpPtr = prjLib.getComponent(dev->getComponentUuid());
+      if (!cmpPtr) {
+        cmp = openLibraryElement<Component>(mLibDir, dev->getComponentUuid());
+        cmpPtr = cmp.get();
+      }
+      if (pkgPtr->getFootprints().isEmpty() ||
+          cmpPtr->getSymbolVariants().isEmpty()) {
+        qWarning() << "Skip device without footprint or symbol variant:"
+                   << dir;
+        continue;
+      }
+      std::shared_ptr<const ComponentSymbolVariant> symbVar =
+          cmpPtr->getSymbolVariants().first();
+      std::shared_ptr<const Footprint> footprint =
+          pkgPtr->getFootprints().first();
+      QSet<Uuid> loadedSymbols;
+      for (const ComponentSymbolVariantItem& item :
+           symbVar->getSymbolItems()) {
+        type.symbolItems.append(item.getUuid());
+        if ((!prjLib.getSymbol(item.getSymbolUuid())) &&
+            (!loadedSymbols.contains(item.getSymbolUuid()))) {
+          symbols.push_back(
+              openLibraryElement<Symbol>(mLibDir, item.getSymbolUuid()));
+          loadedSymbols.insert(item.getSymbolUuid());
+        }
+      }
+      Length size(0);
+      for (const FootprintPad& pad : footprint->getPads()) {
+        Length radius = qMax(*pad.getWidth(), *pad.getHeight()) / 2;
+        Length offset = qMax(pad.getPosition().getX().abs(),
+                             pad.getPosition().getY().abs());
+        size          = qMax(size, offset + radius);
+      }
+      type.component     = cmpPtr->getUuid();
+      type.symbolVariant = symbVar->getUuid();
+      type.device        = dev->getUuid();
+      type.footprint     = footprint->getUuid();
+      type.footprintSize = UnsignedLength(size);
+    } catch (const Exception& e) {
+      // e.g. elements from other libraries are not supported
+      qWarning() << "Skip device" << dir << "because of error:" << e.getMsg();
+      continue;
+    }
+
+    // Add the elements to the project library. The library takes ownership.
+    for (std::unique_ptr<Symbol>& symbol : symbols) {
+      stack.execCmd(new CmdProjectLibraryAddElement<Symbol>(
+          prjLib, *symbol));  // can throw
+      symbol.release();
+    }
+    if (pkg) {
+      stack.execCmd(new CmdProjectLibraryAddElement<Package>(
+          prjLib, *pkg));  // can throw
+      pkg.release();
+    }
+    if (cmp) {
+      stack.execCmd(new CmdProjectLibraryAddElement<Component>(
+          prjLib, *cmp));  // can throw
+      cmp.release();
+    }
+    stack.execCmd(
+        new CmdProjectLibraryAddElement<Device>(prjLib, *dev));  // can throw
+    dev.release();
+    mDeviceTypes.append(type);
+  }
+
+  if (mDeviceTypes.isEmpty()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        tr("The library '%1' does not contain any usable device.")
+            .arg(mLibDir.toNative()));
+  }
+}
+
+QList<ComponentInstance*> ProjectGenerator::addComponents(Project&   project,
+                                                          UndoStack& stack) {
+  QList<ComponentInstance*> components;
+  for (int i = 0; i < mOptions.components; ++i) {
+    const DeviceType&        type = mDeviceTypes.at(i % mDeviceTypes.count());
+    CmdComponentInstanceAdd* cmd  = new CmdComponentInstanceAdd(
+        project.getCircuit(), type.component, type.symbolVariant, type.device);
+    stack.execCmd(cmd);  // can throw
+    components.append(cmd->getComponentInstance());
+  }
+  return components;
+}
+
+QList<NetSignal*> ProjectGenerator::addNets(
+    Project& project, UndoStack& stack,
+    const QList<ComponentInstance*>& components) {
+  QList<NetSignal*> nets;
+  if (mOptions.nets < 1) {
+    return nets;
+  }
+
+  Circuit&  circuit  = project.getCircuit();
+  NetClass* netclass = circuit.getNetClasses().first();
+  for (int i = 0; i < mOptions.nets; ++i) {
+    CmdNetSignalAdd* cmd = new CmdNetSignalAdd(circuit, *netclass);
+    stack.execCmd(cmd);  // can throw
+    nets.append(cmd->getNetSignal());
+  }
+
+  // distribute all component signals round robin over the nets
+  int index = 0;
+  foreach (ComponentInstance* component, components) {
+    for (const ComponentSignal& signal :
+         component->getLibComponent().getSignals()) {
+      ComponentSignalInstance* sigInst =
+          component->getSignalInstance(signal.getUuid());
+      Q_ASSERT(sigInst);
+      stack.execCmd(new CmdCompSigInstSetNetSignal(
+          *sigInst, nets.at(index++ % nets.count())));  // can throw
+    }
+  }
+  return nets;
+}
+
+void ProjectGenerator::addSchematics(
+    Project& project, UndoStack& stack,
+    const QList<ComponentInstance*>& components) {
+  QList<Schematic*> schematics;
+  for (int i = 0; i < mOptions.schematics; ++i) {
+    CmdSchematicAdd* cmd = new CmdSchematicAdd(
+        project, ElementName(QString("Page %1").arg(i + 1)));  // can throw
+    stack.execCmd(cmd);                                        // can throw
+    schematics.append(cmd->getSchematic());
+  }
+  if (schematics.isEmpty()) {
+    return;
+  }
+
+  // Place the symbols in a grid with 10 columns. Gates of the same
+  // component are placed side by side, thus each cell must be wide enough
+  // for the component with the most gates.
+  int maxGates = 1;
+  foreach (const DeviceType& type, mDeviceTypes) {
+    maxGates = qMax(maxGates, type.symbolItems.count());
+  }
+  const Length pitch(30480000);  // keeps symbols on the 2.54mm grid
+  for (int i = 0; i < components.count(); ++i) {
+    Schematic&        schematic = *schematics.at(i % schematics.count());
+    const DeviceType& type      = mDeviceTypes.at(i % mDeviceTypes.count());
+    int               cell      = i / schematics.count();
+    Point pos(pitch * maxGates * (cell % 10), pitch * (-(cell / 10)));
+    for (int k = 0; k < type.symbolItems.count(); ++k) {
+      SI_Symbol* symbol =
+          new SI_Symbol(schematic, *components.at(i), type.symbolItems.at(k),
+                        pos + Point(pitch * k, Length(0)));  // can throw
+      stack.execCmd(new CmdSymbolInstanceAdd(*symbol));  // can throw
+    }
+  }
+}
+
+void ProjectGenerator::addBoards(Project& project, UndoStack& stack,
+                                 const QList<ComponentInstance*>& components,
+                                 const QList<NetSignal*>&         nets) {
+  // Place the devices in a square grid, with a pitch large enough to avoid
+  // overlapping pads. The board outline is resized to contain all devices.
+  Length maxSize(0);
+  foreach (const DeviceType& type, mDeviceTypes) {
+    maxSize = qMax(maxSize, *type.footprintSize);
+  }
+  Length pitch = maxSize * 2 + Length(2000000);
+  pitch        = Length(((pitch.toNm() + 999999) / 1000000) * 1000000);
+  int  columns = qMax(qCeil(qSqrt(components.count())), 1);
+  int  rows    = qMax((components.count() + columns - 1) / columns, 1);
+  Path outline = Path::rect(Point(0, 0), Point(pitch * columns, pitch * rows));
+
+  for (int i = 0; i < mOptions.boards; ++i) {
+    CmdBoardAdd* cmd = new CmdBoardAdd(
+        project, ElementName(QString("Board %1").arg(i + 1)));  // can throw
+    stack.execCmd(cmd);                                         // can throw
+    Board& board = *cmd->getBoard();
+
+    foreach (BI_Polygon* polygon, board.getPolygons()) {
+      if (*polygon->getPolygon().getLayerName() ==
+          GraphicsLayer::sBoardOutlines) {
+        QScopedPointer<CmdPolygonEdit> cmdEdit(
+            new CmdPolygonEdit(polygon->getPolygon()));
+        cmdEdit->setPath(outline, false);
+        stack.execCmd(cmdEdit.take());  // can throw
+      }
+    }
+
+    if (mOptions.innerLayers > 0) {
+      QScopedPointer<CmdBoardLayerStackEdit> cmdLayers(
+          new CmdBoardLayerStackEdit(board.getLayerStack()));
+      cmdLayers->setInnerLayerCount(mOptions.innerLayers);
+      stack.execCmd(cmdLayers.take());  // can throw
+    }
+
+    for (int k = 0; k < components.count(); ++k) {
+      const DeviceType& type = mDeviceTypes.at(k % mDeviceTypes.count());
+      Point pos = Point(pitch * (k % columns), pitch * (k / columns)) +
+          Point(pitch / 2, pitch / 2);
+      BI_Device* device =
+          new BI_Device(board, *components.at(k), type.device, type.footprint,
+                        pos, Angle::deg0(), false);      // can throw
+      stack.execCmd(new CmdDeviceInstanceAdd(*device));  // can throw
+    }
+
+    if (mOptions.traces) {
+      addTraces(board, stack, components, nets);  // can throw
+    }
+    addPlanes(board, stack, nets, outline);  // can throw
+  }
+}
+
+void ProjectGenerator::addTraces(Board& board, UndoStack& stack,
+                                 const QList<ComponentInstance*>& components,
+                                 const QList<NetSignal*>&         nets) {
+  BoardLayerStack& layerStack = board.getLayerStack();
+  GraphicsLayer*   top        = layerStack.getLayer(GraphicsLayer::sTopCopper);
+  GraphicsLayer*   bot        = layerStack.getLayer(GraphicsLayer::sBotCopper);
+  Q_ASSERT(top && bot);
+  const PositiveLength width(250000);
+  const PositiveLength viaSize(700000);
+  const PositiveLength viaDrill(300000);
+
+  // All devices are placed on the top side, so only SMT pads on the top side
+  // and THT pads can be connected with traces on the top layer.
+  QHash<NetSignal*, QList<BI_FootprintPad*>> pads;
+  foreach (ComponentInstance* component, components) {
+    BI_Device* device =
+        board.getDeviceInstanceByComponentUuid(component->getUuid());
+    Q_ASSERT(device);
+    foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+      NetSignal* net = pad->getCompSigInstNetSignal();
+      bool       tht =
+          (pad->getLibPad().getBoardSide() == FootprintPad::BoardSide::THT);
+      if (net && (tht || (pad->getLayerName() == GraphicsLayer::sTopCopper))) {
+        pads[net].append(pad);
+      }
+    }
+  }
+
+  // Chain the pads of each net in the order of the components. With vias,
+  // the second half of each trace is on the bottom layer if possible.
+  foreach (NetSignal* net, nets) {
+    QList<BI_FootprintPad*> netPads = pads.value(net);
+    if (netPads.count() < 2) {
+      continue;
+    }
+    CmdBoardNetSegmentAdd* cmdAdd = new CmdBoardNetSegmentAdd(board, *net);
+    stack.execCmd(cmdAdd);  // can throw
+    QScopedPointer<CmdBoardNetSegmentAddElements> cmdElements(
+        new CmdBoardNetSegmentAddElements(*cmdAdd->getNetSegment()));
+    for (int i = 1; i < netPads.count(); ++i) {
+      BI_FootprintPad* from = netPads.at(i - 1);
+      BI_FootprintPad* to   = netPads.at(i);
+      if (mOptions.vias) {
+        Point   middle = (from->getPosition() + to->getPosition()) / 2;
+        BI_Via* via    = cmdElements->addVia(middle, BI_Via::Shape::Round,
+                                          viaSize, viaDrill);  // can throw
+        bool    tht =
+            (to->getLibPad().getBoardSide() == FootprintPad::BoardSide::THT);
+        cmdElements->addNetLine(*from, *via, *top, width);  // can throw
+        cmdElements->addNetLine(*via, *to, tht ? *bot : *top,
+                                width);  // can throw
+      } else {
+        cmdElements->addNetLine(*from, *to, *top, width);  // can throw
+      }
+    }
+    stack.execCmd(cmdElements.take());  // can throw
+  }
+}
+
+void ProjectGenerator::addPlanes(Board& board, UndoStack& stack,
+                                 const QList<NetSignal*>& nets,
+                                 const Path&              outline) {
+  if (nets.isEmpty()) {
+    return;
+  }
+
+  // distribute the planes over all copper layers, from top to bottom
+  QStringList layers = {GraphicsLayer::sTopCopper};
+  for (int i = 1; i <= mOptions.innerLayers; ++i) {
+    layers.append(GraphicsLayer::getInnerLayerName(i));
+  }
+  layers.append(GraphicsLayer::sBotCopper);
+  for (int i = 0; i < mOptions.planes; ++i) {
+    BI_Plane* plane = new BI_Plane(
+        board, Uuid::createRandom(),
+        GraphicsLayerName(layers.at(i % layers.count())),
+        *nets.at(i % nets.count()), outline);     // can throw
+    stack.execCmd(new CmdBoardPlaneAdd(*plane));  // can throw
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace cli
+}  // namespace librepcb
@@ -0,0 +1,160 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CLI_PROJECTGENERATOR_H
+#define LIBREPCB_CLI_PROJECTGENERATOR_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/uuid.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Path;
+class UndoStack;
+
+namespace project {
+class Board;
+class ComponentInstance;
+class NetSignal;
+class Project;
+}  // namespace project
+
+namespace cli {
+
+/*******************************************************************************
+ *  Class ProjectGenerator
+ ******************************************************************************/
+
+/**
+ * @brief Generates synthetic projects of a given size for benchmarking
+ *
+ * The devices of an existing library are copied into the project library and
+ * instantiated round robin until the requested number of components exists.
+ * All component signals are distributed round robin over the requested number
+ * of nets. Each board contains a device for every component, arranged in a
+ * grid. Optionally, the pads of each net are chained with straight traces
+ * (with a via in the middle of each trace) and planes covering the whole
+ * board are added.
+ *
+ * The generated projects are electrically meaningless (e.g. traces crossing
+ * other pads), but they are valid and deterministic in their size, which is
+ * what matters to measure how the application scales.
+ *
+ * Used for the command `generate-project`.
+ */
+class ProjectGenerator final {
+  Q_DECLARE_TR_FUNCTIONS(ProjectGenerator)
+
+public:
+  // Types
+  struct Options {
+    int  deviceTypes;  ///< Max. number of different devices to use
+    int  components;   ///< Number of component instances
+    int  nets;         ///< Number of net signals
+    int  schematics;   ///< Number of schematic pages
+    int  boards;       ///< Number of boards
+    int  innerLayers;  ///< Number of inner copper layers of each board
+    bool traces;       ///< Whether to connect the pads with traces
+    bool vias;         ///< Whether to add a via to each trace
+    int  planes;       ///< Number of planes per board
+
+    Options() noexcept
+      : deviceTypes(10),
+        components(100),
+        nets(50),
+        schematics(1),
+        boards(1),
+        innerLayers(0),
+        traces(false),
+        vias(false),
+        planes(0) {}
+  };
+
+  // Constructors / Destructor
+  ProjectGenerator()                              = delete;
+  ProjectGenerator(const ProjectGenerator& other) = delete;
+  ProjectGenerator(const FilePath& libDir, const Options& options) noexcept;
+  ~ProjectGenerator() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Generate the project and save it to disk
+   *
+   * @param projectFp   The project file (*.lpp) to create. Its directory must
+   *                    not contain a project yet.
+   *
+   * @throw Exception in case of an error
+   */
+  void generate(const FilePath& projectFp);
+
+  // Operator Overloadings
+  ProjectGenerator& operator=(const ProjectGenerator& rhs) = delete;
+
+private:  // Types
+  struct DeviceType {
+    Uuid           component;
+    Uuid           symbolVariant;
+    QList<Uuid>    symbolItems;
+    Uuid           device;
+    Uuid           footprint;
+    UnsignedLength footprintSize;  ///< Max. extent of the pads from origin
+  };
+
+private:  // Methods
+  void addLibraryElements(project::Project& project, UndoStack& stack);
+  QList<project::ComponentInstance*> addComponents(project::Project& project,
+                                                   UndoStack&        stack);
+  QList<project::NetSignal*>         addNets(
+              project::Project& project, UndoStack& stack,
+              const QList<project::ComponentInstance*>& components);
+  void addSchematics(project::Project& project, UndoStack& stack,
+                     const QList<project::ComponentInstance*>& components);
+  void addBoards(project::Project& project, UndoStack& stack,
+                 const QList<project::ComponentInstance*>& components,
+                 const QList<project::NetSignal*>&         nets);
+  void addTraces(project::Board& board, UndoStack& stack,
+                 const QList<project::ComponentInstance*>& components,
+                 const QList<project::NetSignal*>&         nets);
+  void addPlanes(project::Board& board, UndoStack& stack,
+                 const QList<project::NetSignal*>& nets, const Path& outline);
+
+private:  // Data
+  FilePath          mLibDir;
+  Options           mOptions;
+  QList<DeviceType> mDeviceTypes;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace cli
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CLI_PROJECTGENERATOR_H
@@ -32,6 +32,7 @@
 #include <librepcb/common/dialogs/filedialog.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/utils/taskscheduler.h>
 #include <librepcb/library/library.h>
 #include <librepcb/libraryeditor/libraryeditor.h>
 #include <librepcb/librarymanager/librarymanager.h>
@@ -102,6 +103,10 @@ ControlPanel::ControlPanel(Workspace& workspace)
           &WorkspaceLibraryDb::scanLibraryListUpdated, this,
           &ControlPanel::updateNoLibrariesWarningVisibility);
 
+  // show project README files as soon as they are rendered
+  connect(&mReadmeWatcher, &QFutureWatcher<ReadmeContent>::finished, this,
+          &ControlPanel::projectReadmeLoaded);
+
   // connect some actions which are created with the Qt Designer
   connect(mUi->actionQuit, &QAction::triggered, this, &ControlPanel::close);
   connect(mUi->actionOpenWebsite, &QAction::triggered,
@@ -208,6 +213,9 @@ void ControlPanel::saveSettings() {
             FilePath(model->filePath(index)).toRelative(mWorkspace.getPath()));
       }
     }
+    foreach (const FilePath& fp, mPendingExpandedProjectTreeItems) {
+      list.append(fp.toRelative(mWorkspace.getPath()));  // not loaded yet
+    }
     clientSettings.setValue("expanded_projecttreeview_items",
                             QVariant::fromValue(list));
   }
@@ -228,16 +236,18 @@ void ControlPanel::loadSettings() {
       clientSettings.value("splitter_v_state").toByteArray());
 
   // projects treeview (expanded items)
-  if (ProjectTreeModel* model =
-          dynamic_cast<ProjectTreeModel*>(mUi->projectTreeView->model())) {
-    QStringList list =
-        clientSettings.value("expanded_projecttreeview_items").toStringList();
-    foreach (QString item, list) {
-      FilePath    filepath = FilePath::fromRelative(mWorkspace.getPath(), item);
-      QModelIndex index    = model->index(filepath.toStr());
-      mUi->projectTreeView->setExpanded(index, true);
-    }
+  // Getting the index of a path which is not loaded yet would access the file
+  // system synchronously, which blocks the UI on network drives. So the items
+  // are expanded as soon as their parent directory was loaded by the model.
+  QStringList list =
+      clientSettings.value("expanded_projecttreeview_items").toStringList();
+  foreach (QString item, list) {
+    mPendingExpandedProjectTreeItems.insert(
+        FilePath::fromRelative(mWorkspace.getPath(), item));
   }
+  connect(&mWorkspace.getProjectTreeModel(),
+          &QFileSystemModel::directoryLoaded, this,
+          &ControlPanel::projectTreeDirectoryLoaded);
 
   clientSettings.endGroup();
 }
@@ -255,15 +265,95 @@ void ControlPanel::updateNoLibrariesWarningVisibility() noexcept {
 void ControlPanel::showProjectReadmeInBrowser(
     const FilePath& projectFilePath) noexcept {
   if (projectFilePath.isValid()) {
-    FilePath readmeFilePath = projectFilePath.getPathTo("README.md");
-    mUi->textBrowser->setSearchPaths(QStringList(projectFilePath.toStr()));
-    mUi->textBrowser->setHtml(
-        MarkdownConverter::convertMarkdownToHtml(readmeFilePath));
+    FilePath  readmeFilePath = projectFilePath.getPathTo("README.md");
+    QDateTime cachedLastModified;
+    auto      it = mReadmeCache.constFind(readmeFilePath);
+    if (it != mReadmeCache.constEnd()) {
+      setProjectReadmeContent(*it);
+      cachedLastModified = it->lastModified;
+    } else {
+      mUi->textBrowser->clear();
+    }
+    // Even accessing the file may be slow (e.g. on network shares), so the
+    // cache is validated and the file is rendered in the background. A result
+    // of a previously selected project is discarded by the watcher.
+    mReadmeFilePath = readmeFilePath;
+    mReadmeWatcher.setFuture(TaskScheduler::run(
+        TaskScheduler::Priority::Interactive,
+        [readmeFilePath, cachedLastModified]() {
+          return loadProjectReadme(readmeFilePath, cachedLastModified);
+        }));
   } else {
+    mReadmeFilePath = FilePath();
     mUi->textBrowser->clear();
   }
 }
 
+void ControlPanel::projectReadmeLoaded() noexcept {
+  ReadmeContent content = mReadmeWatcher.result();
+  if ((content.filePath != mReadmeFilePath) || content.upToDate) {
+    return;  // project was deselected in the meantime, or nothing has changed
+  }
+  if (mReadmeCache.count() >= sMaxCachedReadmeCount) {
+    mReadmeCache.clear();
+  }
+  mReadmeCache.insert(content.filePath, content);
+  setProjectReadmeContent(content);
+}
+
+void ControlPanel::setProjectReadmeContent(
+    const ReadmeContent& content) noexcept {
+  // No search paths are set since QTextBrowser would then load the images
+  // synchronously. Instead, all images are already loaded in the background.
+  QTextDocument* document = mUi->textBrowser->document();
+  mUi->textBrowser->setSearchPaths(QStringList());
+  mUi->textBrowser->setHtml(content.html);
+  for (auto it = content.images.constBegin(); it != content.images.constEnd();
+       ++it) {
+    document->addResource(QTextDocument::ImageResource, QUrl(it.key()),
+                          it.value());
+  }
+  document->markContentsDirty(0, document->characterCount());
+}
+
+ControlPanel::ReadmeContent ControlPanel::loadProjectReadme(
+    const FilePath&  readmeFilePath,
+    const QDateTime& cachedLastModified) noexcept {
+  ReadmeContent content{readmeFilePath, QDateTime(), false, QString(),
+                        QHash<QString, QImage>()};
+  QFileInfo     info(readmeFilePath.toStr());
+  if (info.exists()) {
+    content.lastModified = info.lastModified();
+  }
+  content.upToDate = (content.lastModified == cachedLastModified);
+  if (content.upToDate || (!content.lastModified.isValid())) {
+    return content;
+  }
+
+  content.html = MarkdownConverter::convertMarkdownToHtml(readmeFilePath);
+
+  // load local images referenced by the README
+  QRegularExpression              re("<img\\s[^>]*src=\"([^\"]*)\"");
+  QRegularExpressionMatchIterator matches = re.globalMatch(content.html);
+  while (matches.hasNext()) {
+    QString url = matches.next().captured(1).replace("&amp;", "&");
+    QUrl    qurl(url);
+    if (content.images.contains(url) ||
+        ((!qurl.isRelative()) && (!qurl.isLocalFile()))) {
+      continue;
+    }
+    FilePath dir = readmeFilePath.getParentDir();
+    FilePath fp  = qurl.isLocalFile()
+        ? FilePath(qurl.toLocalFile())
+        : FilePath::fromRelative(dir, qurl.path());
+    QImage image(fp.toStr());
+    if (!image.isNull()) {
+      content.images.insert(url, image);
+    }
+  }
+  return content;
+}
+
 /*******************************************************************************
  *  Project Management
  ******************************************************************************/
@@ -474,6 +564,17 @@ void ControlPanel::projectEditorClosed() noexcept {
   delete project;
 }
 
+void ControlPanel::projectTreeDirectoryLoaded(const QString& path) noexcept {
+  const FilePath    dir(path);
+  ProjectTreeModel& model = mWorkspace.getProjectTreeModel();
+  foreach (const FilePath& fp, mPendingExpandedProjectTreeItems) {
+    if (fp.getParentDir() == dir) {
+      mPendingExpandedProjectTreeItems.remove(fp);
+      mUi->projectTreeView->setExpanded(model.index(fp.toStr()), true);
+    }
+  }
+}
+
 /*******************************************************************************
  *  Actions
  ******************************************************************************/
@@ -548,7 +649,7 @@ void ControlPanel::on_projectTreeView_clicked(const QModelIndex& index) {
 
 void ControlPanel::on_projectTreeView_doubleClicked(const QModelIndex& index) {
   FilePath fp(mWorkspace.getProjectTreeModel().filePath(index));
-  if (fp.isExistingDir()) {
+  if (mWorkspace.getProjectTreeModel().isDir(index)) {  // cached by the model
     mUi->projectTreeView->setExpanded(index,
                                       !mUi->projectTreeView->isExpanded(index));
   } else if (fp.getSuffix() == "lpp") {
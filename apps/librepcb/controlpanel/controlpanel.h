@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
 
 #include <QtCore>
 #include <QtWidgets>
@@ -33,8 +34,6 @@
  ******************************************************************************/
 namespace librepcb {
 
-class FilePath;
-
 namespace library {
 class Library;
 
@@ -99,6 +98,7 @@ private slots:
   // private slots
   void openProjectsPassedByCommandLine() noexcept;
   void projectEditorClosed() noexcept;
+  void projectTreeDirectoryLoaded(const QString& path) noexcept;
 
   // Actions
   void on_actionNew_Project_triggered();
@@ -120,6 +120,17 @@ private slots:
   void on_actionRescanLibraries_triggered();
 
 private:
+  // Types
+
+  /// Rendered README file of a project (see #showProjectReadmeInBrowser())
+  struct ReadmeContent {
+    FilePath               filePath;
+    QDateTime              lastModified;  ///< Invalid if not existing
+    bool                   upToDate;      ///< Whether the cache is still valid
+    QString                html;
+    QHash<QString, QImage> images;  ///< Referenced images, by URL
+  };
+
   // make some methods inaccessible...
   ControlPanel();
   ControlPanel(const ControlPanel& other);
@@ -130,6 +141,11 @@ private:
   void loadSettings();
   void updateNoLibrariesWarningVisibility() noexcept;
   void showProjectReadmeInBrowser(const FilePath& projectFilePath) noexcept;
+  void projectReadmeLoaded() noexcept;
+  void setProjectReadmeContent(const ReadmeContent& content) noexcept;
+  static ReadmeContent loadProjectReadme(
+      const FilePath&  readmeFilePath,
+      const QDateTime& cachedLastModified) noexcept;
 
   // Project Management
 
@@ -237,6 +253,17 @@ private:
   QHash<QString, project::editor::ProjectEditor*>  mOpenProjectEditors;
   QHash<FilePath, library::editor::LibraryEditor*> mOpenLibraryEditors;
   QScopedPointer<ProjectLibraryUpdater>            mProjectLibraryUpdater;
+
+  /// Project tree items to expand once their parent directory is loaded
+  QSet<FilePath> mPendingExpandedProjectTreeItems;
+
+  // Project README
+  FilePath                       mReadmeFilePath;  ///< Currently shown file
+  QFutureWatcher<ReadmeContent>  mReadmeWatcher;
+  QHash<FilePath, ReadmeContent> mReadmeCache;
+
+  /// Upper limit of cached README files
+  static constexpr int sMaxCachedReadmeCount = 20;
 };
 
 /*******************************************************************************
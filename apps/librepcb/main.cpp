@@ -246,7 +246,10 @@ static int openWorkspace(const FilePath& path) noexcept {
       }
     }
 
+    QElapsedTimer timer;
+    timer.start();
     Workspace ws(path);  // can throw
+    qInfo() << "Opened workspace in" << timer.elapsed() << "ms.";
 
     // Now since workspace settings are loaded, switch to the locale defined
     // there (until now, the system locale was used).
@@ -259,6 +262,15 @@ static int openWorkspace(const FilePath& path) noexcept {
     ControlPanel p(ws);
     p.show();
 
+    // Log the time until the control panel is shown and the event loop is
+    // running, i.e. the user is able to interact with the application. Slow
+    // tasks like scanning the libraries continue in the background.
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 4, 0))
+    QTimer::singleShot(0, [timer]() {
+      qInfo() << "Workspace is interactive after" << timer.elapsed() << "ms.";
+    });
+#endif
+
     return appExec();
   } catch (UserCanceled& e) {
     return 0;
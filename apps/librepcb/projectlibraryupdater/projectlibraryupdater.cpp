@@ -37,6 +37,7 @@
 #include <librepcb/workspace/library/workspacelibrarydb.h>
 #include <librepcb/workspace/workspace.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -163,24 +164,68 @@ QString ProjectLibraryUpdater::prettyPath(const FilePath& fp) const noexcept {
 void ProjectLibraryUpdater::updateElements(
     std::shared_ptr<TransactionalFileSystem> fs, const QString& type,
     FilePath (workspace::WorkspaceLibraryDb::*getter)(const Uuid&) const) {
-  QString dirpath = "library/" % type;
+  // The workspace elements are read concurrently since this is the slowest
+  // part. The project file system is not thread-safe, so it is only accessed
+  // from this thread.
+  QString                                    dirpath = "library/" % type;
+  QList<QPair<QString, QFuture<ReadResult>>> jobs;
   foreach (const QString& dirname, fs->getDirs(dirpath)) {
     tl::optional<Uuid> uuid = Uuid::tryFromString(dirname);
     FilePath           src =
         uuid ? (mWorkspace.getLibraryDb().*getter)(*uuid) : FilePath();
-    QString                dst = dirpath % "/" % dirname;
-    TransactionalDirectory dstDir(fs, dst);
-    if (src.isValid() && (!dstDir.getFiles().isEmpty())) {
-      log(tr("Update %1...").arg(dst));
-      std::shared_ptr<TransactionalFileSystem> srcFs =
-          TransactionalFileSystem::openRO(src);
-      TransactionalDirectory srcDir(srcFs);
-      fs->removeDirRecursively(dst);
-      srcDir.saveTo(dstDir);
+    QString dst = dirpath % "/" % dirname;
+    if (src.isValid() && (!fs->getFiles(dst).isEmpty())) {
+      jobs.append(qMakePair(dst, QtConcurrent::run([src]() {
+                              ReadResult result;
+                              try {
+                                result.content = readContent(
+                                    *TransactionalFileSystem::openRO(src),
+                                    QString());
+                              } catch (const Exception& e) {
+                                result.error = e.getMsg();
+                              }
+                              return result;
+                            })));
     } else {
       log(tr("Skip %1...").arg(dst));
     }
   }
+
+  // Elements which are identical to the workspace elements are not touched.
+  for (int i = 0; i < jobs.count(); ++i) {
+    const QString& dst    = jobs.at(i).first;
+    ReadResult     result = jobs.at(i).second.result();
+    if (!result.error.isEmpty()) {
+      throw RuntimeError(__FILE__, __LINE__, result.error);
+    }
+    const Content& content = result.content;
+    if (content == readContent(*fs, dst)) {  // can throw
+      log(tr("Skip %1 (unchanged)...").arg(dst));
+    } else {
+      log(tr("Update %1...").arg(dst));
+      fs->removeDirRecursively(dst);
+      for (auto it = content.constBegin(); it != content.constEnd(); ++it) {
+        fs->write(dst % "/" % it.key(), it.value());
+      }
+    }
+  }
+}
+
+ProjectLibraryUpdater::Content ProjectLibraryUpdater::readContent(
+    const FileSystem& fs, const QString& dir) {
+  Content content;
+  QString prefix = dir.isEmpty() ? dir : dir % "/";
+  foreach (const QString& file, fs.getFiles(dir)) {
+    content.insert(file, fs.read(prefix % file));  // can throw
+  }
+  foreach (const QString& subdir, fs.getDirs(dir)) {
+    Content subContent = readContent(fs, prefix % subdir);  // can throw
+    for (auto it = subContent.constBegin(); it != subContent.constEnd();
+         ++it) {
+      content.insert(subdir % "/" % it.key(), it.value());
+    }
+  }
+  return content;
 }
 
 /*******************************************************************************
@@ -36,6 +36,7 @@
  ******************************************************************************/
 namespace librepcb {
 
+class FileSystem;
 class TransactionalFileSystem;
 
 namespace workspace {
@@ -74,12 +75,20 @@ public:
 private slots:
   void btnUpdateClicked();
 
+private:  // Types
+  typedef QMap<QString, QByteArray> Content;  ///< File path -> content
+  struct ReadResult {
+    Content content;
+    QString error;  ///< Empty on success
+  };
+
 private:
   void    log(const QString& msg) noexcept;
   QString prettyPath(const FilePath& fp) const noexcept;
   void    updateElements(
          std::shared_ptr<TransactionalFileSystem> fs, const QString& type,
          FilePath (workspace::WorkspaceLibraryDb::*getter)(const Uuid&) const);
+  static Content readContent(const FileSystem& fs, const QString& dir);
 
 private:
   workspace::Workspace&                     mWorkspace;
@@ -22,6 +22,13 @@
  ******************************************************************************/
 #include "airwiresbuilder.h"
 
+#include "unionfind.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <tuple>
 #include <unordered_map>
 
 #include <QtCore>
@@ -35,7 +42,7 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-AirWiresBuilder::AirWiresBuilder() noexcept {
+AirWiresBuilder::AirWiresBuilder(Engine engine) noexcept : mEngine(engine) {
 }
 
 AirWiresBuilder::~AirWiresBuilder() noexcept {
@@ -68,17 +75,12 @@ AirWiresBuilder::AirWires AirWiresBuilder::buildAirWires() noexcept {
     mEdges.emplace_back(mPoints[0], mPoints[1], -1);
     mEdges.emplace_back(mPoints[1], mPoints[2], -1);
     mEdges.emplace_back(mPoints[2], mPoints[0], -1);
-  } else if (mPoints.size() >= 3) {
-    // since delaunay-triangulation sometimes doesn't work well, add fallback
-    // edges to make sure at least all points are connected somehow
-    for (std::size_t i = 1; i < mPoints.size(); ++i) {
-      mEdges.emplace_back(mPoints[i - 1], mPoints[i], -1);
+  } else if (mPoints.size() > 3) {
+    if (mEngine == Engine::NearestNeighbors) {
+      addNearestNeighborEdges();
+    } else {
+      addDelaunayEdges();
     }
-
-    // now run delaunay triangulation to add additional edges
-    delaunay::Delaunay<qreal> del;
-    del.triangulate(mPoints);
-    mEdges.insert(mEdges.end(), del.getEdges().begin(), del.getEdges().end());
   }
 
   // determine weights of these new edges
@@ -94,100 +96,162 @@ AirWiresBuilder::AirWires AirWiresBuilder::buildAirWires() noexcept {
  *  Private Methods
  ******************************************************************************/
 
-// adapted from horizon/kicad
-AirWiresBuilder::AirWires AirWiresBuilder::kruskalMst() noexcept {
-  unsigned int nodeNumber      = mPoints.size();
-  unsigned int mstExpectedSize = nodeNumber - 1;
-  unsigned int mstSize         = 0;
-  bool         ratsnestLines   = false;
-
-  // printf("mst nodes : %d edges : %d\n", mPoints.size(), mEdges.size () );
-  // The output
-  AirWires mst;
+void AirWiresBuilder::addDelaunayEdges() noexcept {
+  // since delaunay-triangulation sometimes doesn't work well, add fallback
+  // edges to make sure at least all points are connected somehow
+  for (std::size_t i = 1; i < mPoints.size(); ++i) {
+    mEdges.emplace_back(mPoints[i - 1], mPoints[i], -1);
+  }
 
-  // Set tags for marking cycles
-  std::unordered_map<int, int> tags;
-  unsigned int                 tag = 0;
+  // now run delaunay triangulation to add additional edges
+  delaunay::Delaunay<qreal> del;
+  del.triangulate(mPoints);
+  mEdges.insert(mEdges.end(), del.getEdges().begin(), del.getEdges().end());
+}
 
-  for (auto& node : mPoints) {
-    node.tag      = tag;
-    tags[node.id] = tag++;
+void AirWiresBuilder::addNearestNeighborEdges() noexcept {
+  // Number of nearest neighbors to connect each point with. The minimum
+  // spanning tree almost only consists of edges to one of the nearest few
+  // neighbors, a higher number just increases the runtime.
+  static const std::size_t neighborCount = 8;
+
+  // Sort the points along the axis with the larger extent, so searching
+  // points near to a given point can be stopped as soon as the distance along
+  // this axis exceeds the distance of the already found points.
+  qreal minX = mPoints.front().x, maxX = minX;
+  qreal minY = mPoints.front().y, maxY = minY;
+  for (const auto& p : mPoints) {
+    minX = std::min(minX, p.x);
+    maxX = std::max(maxX, p.x);
+    minY = std::min(minY, p.y);
+    maxY = std::max(maxY, p.y);
+  }
+  const bool sortByX = (maxX - minX) >= (maxY - minY);
+  auto       axis    = [this, sortByX](int id) {
+    return sortByX ? mPoints[id].x : mPoints[id].y;
+  };
+  std::vector<int> order(mPoints.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(),
+            [&axis](int a, int b) { return axis(a) < axis(b); });
+
+  // Visits the points around the point at a given position in the sorted
+  // list. The callback gets the ID and squared distance of each visited point
+  // and returns the squared distance from which on no more points are needed.
+  typedef std::function<qreal(int, qreal)> Visitor;
+  auto visitNeighbors = [this, &order, &axis](std::size_t    pos,
+                                              const Visitor& visitor) {
+    const int id    = order[pos];
+    qreal     limit = std::numeric_limits<qreal>::infinity();
+    for (int dir = -1; dir <= 1; dir += 2) {
+      for (int i = static_cast<int>(pos) + dir;
+           (i >= 0) && (i < static_cast<int>(order.size())); i += dir) {
+        qreal delta = axis(order[i]) - axis(id);
+        if ((delta * delta) >= limit) break;
+        limit = visitor(order[i], mPoints[id].dist2(mPoints[order[i]]));
+      }
+    }
+  };
+
+  // connect each point with its nearest neighbors
+  mEdges.reserve(mEdges.size() + (mPoints.size() * neighborCount));
+  for (std::size_t pos = 0; pos < order.size(); ++pos) {
+    std::vector<std::pair<qreal, int>> nearest;  // max-heap
+    visitNeighbors(pos, [&nearest](int id, qreal dist2) {
+      if (nearest.size() < neighborCount) {
+        nearest.emplace_back(dist2, id);
+        std::push_heap(nearest.begin(), nearest.end());
+      } else if (dist2 < nearest.front().first) {
+        std::pop_heap(nearest.begin(), nearest.end());
+        nearest.back() = std::make_pair(dist2, id);
+        std::push_heap(nearest.begin(), nearest.end());
+      }
+      return (nearest.size() < neighborCount)
+          ? std::numeric_limits<qreal>::infinity()
+          : nearest.front().first;
+    });
+    for (const auto& neighbor : nearest) {
+      mEdges.emplace_back(mPoints[order[pos]], mPoints[neighbor.second], -1);
+    }
   }
 
-  // Lists of nodes connected together (subtrees) to detect cycles in the
-  // graph
-  std::vector<std::list<int>> cycles(nodeNumber);
+  // Groups of points (e.g. two distant BGAs) might still not be connected
+  // with each other. So, like the Boruvka algorithm, repeatedly add the
+  // shortest edge from each group to any other group until all points are
+  // connected. The largest group is skipped since the edges of all other
+  // groups are sufficient to make progress, and searching from small groups
+  // is much faster.
+  UnionFind groups(mPoints.size());
+  for (const auto& edge : mEdges) {
+    groups.unite(edge.p1.id, edge.p2.id);
+  }
+  while (groups.getGroupCount() > 1) {
+    std::unordered_map<int, std::size_t> groupSizes;
+    for (const auto& p : mPoints) {
+      ++groupSizes[groups.find(p.id)];
+    }
+    auto largestGroup = std::max_element(
+        groupSizes.begin(), groupSizes.end(),
+        [](const std::pair<const int, std::size_t>& a,
+           const std::pair<const int, std::size_t>& b) {
+          return a.second < b.second;
+        });
+
+    // shortest edge of each group: squared length, first ID, second ID
+    typedef std::tuple<qreal, int, int> GroupEdge;
+    std::unordered_map<int, GroupEdge> shortestEdges;
+    for (std::size_t pos = 0; pos < order.size(); ++pos) {
+      const int id    = order[pos];
+      const int group = groups.find(id);
+      if (group == largestGroup->first) continue;
+      auto it = shortestEdges.find(group);
+      if (it == shortestEdges.end()) {
+        GroupEdge edge(std::numeric_limits<qreal>::infinity(), id, id);
+        it = shortestEdges.insert(std::make_pair(group, edge)).first;
+      }
+      GroupEdge& shortest = it->second;
+      visitNeighbors(pos, [&](int other, qreal dist2) {
+        if ((dist2 < std::get<0>(shortest)) && (groups.find(other) != group)) {
+          shortest = GroupEdge(dist2, id, other);
+        }
+        return std::get<0>(shortest);
+      });
+    }
+    for (const auto& item : shortestEdges) {
+      int p1 = std::get<1>(item.second);
+      int p2 = std::get<2>(item.second);
+      mEdges.emplace_back(mPoints[p1], mPoints[p2], -1);
+      groups.unite(p1, p2);
+    }
+  }
+}
 
-  for (unsigned int i = 0; i < nodeNumber; ++i) cycles[i].push_back(i);
+AirWiresBuilder::AirWires AirWiresBuilder::kruskalMst() noexcept {
+  // Union-find structure to keep track of the points which are already
+  // connected together (either by copper or by air wires).
+  UnionFind groups(mPoints.size());
 
-  // Kruskal algorithm requires edges to be sorted by their weight
+  // Kruskal algorithm requires edges to be sorted by their weight. Edges of
+  // existing connections have a negative weight, so they are processed first
+  // and never result in an air wire.
   std::sort(mEdges.begin(), mEdges.end(),
             [](const delaunay::Edge<qreal>& a, const delaunay::Edge<qreal>& b) {
-              return a.weight > b.weight;
+              return a.weight < b.weight;
             });
 
-  while (mstSize < mstExpectedSize && !mEdges.empty()) {
-    auto& dt = mEdges.back();
-
-    int srcTag = tags[dt.p1.id];
-    int trgTag = tags[dt.p2.id];
-    // printf("mstSize %d %d %f %d<>%d\n", mstSize, mstExpectedSize,
-    // dt.weight, srcTag, trgTag);
-
-    // Check if by adding this edge we are going to join two different
-    // forests
-    if (srcTag != trgTag) {
-      // Because edges are sorted by their weight, first we always process
-      // connected
-      // items (weight == 0). Once we stumble upon an edge with non-zero
-      // weight,
-      // it means that the rest of the lines are ratsnest.
-      if (!ratsnestLines && dt.weight >= 0) ratsnestLines = true;
-
-      // Update tags
-      if (ratsnestLines) {
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[mPoints[*it].id] = srcTag;
-        }
-
-        // Do a copy of edge, but make it RN_EDGE_MST. In contrary to
-        // RN_EDGE,
-        // RN_EDGE_MST saves both source and target node and does not
-        // require any other
-        // edges to exist for getting source/target nodes
-        // CN_EDGE newEdge ( dt.GetSourceNode(), dt.GetTargetNode(),
-        // dt.GetWeight() );
-
-        // assert( newEdge.GetSourceNode()->GetTag() !=
-        // newEdge.GetTargetNode()->GetTag() );
-        // assert(dt.p1.tag != dt.p2.tag);
-        mst.append(qMakePair(Point(dt.p1.x, dt.p1.y), Point(dt.p2.x, dt.p2.y)));
-        ++mstSize;
-      } else {
-        // for( it = cycles[trgTag].begin(), itEnd =
-        // cycles[trgTag].end(); it != itEnd; ++it )
-        // for( auto it : cycles[trgTag] )
-        for (auto it = cycles[trgTag].begin(); it != cycles[trgTag].end();
-             ++it) {
-          tags[mPoints[*it].id] = srcTag;
-          mPoints[*it].tag      = srcTag;
-        }
-
-        // Processing a connection, decrease the expected size of the
-        // ratsnest MST
-        --mstExpectedSize;
-      }
-
-      // Move nodes that were marked with old tag to the list marked with
-      // the new tag
-      cycles[srcTag].splice(cycles[srcTag].end(), cycles[trgTag]);
+  AirWires mst;
+  for (const delaunay::Edge<qreal>& edge : mEdges) {
+    if (groups.getGroupCount() <= 1) {
+      break;  // all points are connected
+    }
+    if (!groups.unite(edge.p1.id, edge.p2.id)) {
+      continue;  // would create a cycle
+    }
+    if (edge.weight >= 0) {
+      mst.append(
+          qMakePair(Point(edge.p1.x, edge.p1.y), Point(edge.p2.x, edge.p2.y)));
     }
-
-    // Remove the edge that was just processed
-    mEdges.pop_back();
   }
-
   return mst;
 }
 
@@ -49,12 +49,30 @@ public:
   typedef QPair<Point, Point> AirWire;
   typedef QVector<AirWire>    AirWires;
 
+  /**
+   * @brief Algorithm used to determine the candidate edges for air wires
+   */
+  enum class Engine {
+    /// Delaunay triangulation (always contains the minimum spanning tree,
+    /// but slow for large point counts)
+    Delaunay,
+    /// Edges to the nearest neighbors of each point, plus the shortest edges
+    /// between otherwise unconnected groups of points. Much faster for large
+    /// point counts, but only approximate: if groups of points are already
+    /// connected through longer edges, the shortest edge between them might
+    /// be missed and the air wires are longer than necessary.
+    NearestNeighbors,
+  };
+
   // Constructors / Destructor
 
   /**
    * @brief Default constructor
+   *
+   * @param engine    The algorithm to use. Only #Engine::Delaunay is
+   *                  guaranteed to find the shortest air wires.
    */
-  AirWiresBuilder() noexcept;
+  explicit AirWiresBuilder(Engine engine = Engine::Delaunay) noexcept;
 
   /**
    * @brief Copy constructor
@@ -96,9 +114,12 @@ public:
   AirWiresBuilder& operator=(const AirWiresBuilder& rhs) = delete;
 
 private:  // Methods
+  void     addDelaunayEdges() noexcept;
+  void     addNearestNeighborEdges() noexcept;
   AirWires kruskalMst() noexcept;
 
 private:  // Data
+  Engine                                mEngine;
   std::vector<delaunay::Vector2<qreal>> mPoints;
   std::vector<delaunay::Edge<qreal>>    mEdges;
 };
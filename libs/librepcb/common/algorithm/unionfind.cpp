@@ -0,0 +1,104 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "unionfind.h"
+
+#include <numeric>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+UnionFind::UnionFind(int count) noexcept
+  : mParents(count), mSizes(count, 1), mGroupCount(count) {
+  std::iota(mParents.begin(), mParents.end(), 0);
+}
+
+UnionFind::UnionFind(const UnionFind& other) noexcept
+  : mParents(other.mParents),
+    mSizes(other.mSizes),
+    mGroupCount(other.mGroupCount) {
+}
+
+UnionFind::~UnionFind() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+int UnionFind::addElement() noexcept {
+  int id = mParents.size();
+  mParents.push_back(id);
+  mSizes.push_back(1);
+  ++mGroupCount;
+  return id;
+}
+
+int UnionFind::find(int id) noexcept {
+  Q_ASSERT((id >= 0) && (id < static_cast<int>(mParents.size())));
+  while (mParents[id] != id) {
+    mParents[id] = mParents[mParents[id]];  // path halving
+    id           = mParents[id];
+  }
+  return id;
+}
+
+bool UnionFind::unite(int id1, int id2) noexcept {
+  int root1 = find(id1);
+  int root2 = find(id2);
+  if (root1 == root2) {
+    return false;
+  }
+  if (mSizes[root1] < mSizes[root2]) {
+    std::swap(root1, root2);
+  }
+  mParents[root2] = root1;
+  mSizes[root1] += mSizes[root2];
+  --mGroupCount;
+  return true;
+}
+
+/*******************************************************************************
+ *  Operator Overloadings
+ ******************************************************************************/
+
+UnionFind& UnionFind::operator=(const UnionFind& rhs) noexcept {
+  mParents    = rhs.mParents;
+  mSizes      = rhs.mSizes;
+  mGroupCount = rhs.mGroupCount;
+  return *this;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
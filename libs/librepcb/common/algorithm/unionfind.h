@@ -0,0 +1,124 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_UNIONFIND_H
+#define LIBREPCB_UNIONFIND_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class UnionFind
+ ******************************************************************************/
+
+/**
+ * @brief Disjoint-set data structure to keep track of connected elements
+ *
+ * Elements are identified by consecutive IDs starting at zero. With path
+ * halving and union by size, each operation takes nearly constant time, so
+ * connectivity of a large number of elements (e.g. all anchors of a net
+ * signal) can be determined in a single linear pass over their connections.
+ */
+class UnionFind final {
+public:
+  // Constructors / Destructor
+
+  /**
+   * @brief Constructor
+   *
+   * @param count   Number of elements to create, each in its own group.
+   */
+  explicit UnionFind(int count = 0) noexcept;
+  UnionFind(const UnionFind& other) noexcept;
+  ~UnionFind() noexcept;
+
+  // Getters
+  int getElementCount() const noexcept {
+    return static_cast<int>(mParents.size());
+  }
+  int getGroupCount() const noexcept { return mGroupCount; }
+
+  // General Methods
+
+  /**
+   * @brief Add a new element in its own group
+   *
+   * @return The ID of the added element
+   */
+  int addElement() noexcept;
+
+  /**
+   * @brief Get the representative element of the group of an element
+   *
+   * @param id  ID of the element.
+   *
+   * @return ID of the representative element (equal for all elements of a
+   *         group, but it may change when groups are united)
+   */
+  int find(int id) noexcept;
+
+  /**
+   * @brief Unite the groups of two elements
+   *
+   * @param id1   ID of the first element.
+   * @param id2   ID of the second element.
+   *
+   * @retval true   If two different groups were united.
+   * @retval false  If both elements were already in the same group.
+   */
+  bool unite(int id1, int id2) noexcept;
+
+  /**
+   * @brief Check whether two elements are in the same group
+   *
+   * @param id1   ID of the first element.
+   * @param id2   ID of the second element.
+   *
+   * @return Whether the elements are connected (directly or indirectly)
+   */
+  bool isConnected(int id1, int id2) noexcept {
+    return find(id1) == find(id2);
+  }
+
+  // Operator Overloadings
+  UnionFind& operator=(const UnionFind& rhs) noexcept;
+
+private:  // Data
+  std::vector<int> mParents;
+  std::vector<int> mSizes;
+  int              mGroupCount;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_UNIONFIND_H
@@ -32,66 +32,108 @@
 namespace librepcb {
 
 /*******************************************************************************
- *  Public Methods
+ *  Class Template
  ******************************************************************************/
 
-QString AttributeSubstitutor::substitute(QString                  str,
-                                         const AttributeProvider* ap,
-                                         FilterFunction filter) noexcept {
-  int           startPos           = 0;
-  int           length             = 0;
-  int           outerVariableStart = -1;
-  int           outerVariableEnd   = -1;  // counted from end of string
-  QString       value;
-  QStringList   keys;
-  QSet<QString> keyBacktrace;  // avoid endless recursion
-  while (searchVariablesInText(str, startPos, startPos, length, keys)) {
-    if (filter && (startPos + length > str.length() - outerVariableEnd)) {
-      applyFilter(str, outerVariableStart, outerVariableEnd, filter);
-    }
-    if (filter && (outerVariableStart < 0)) {
-      outerVariableStart = startPos;
-      outerVariableEnd   = str.length() - length - startPos;
+AttributeSubstitutor::Template::Template(const QString& text) noexcept
+  : mText(text), mChunks(), mKeys() {
+  int         chunkStart = 0;
+  int         pos        = 0;
+  int         length     = 0;
+  QStringList keys;
+  while (searchVariablesInText(mText, chunkStart, pos, length, keys)) {
+    if (pos > chunkStart) {
+      mChunks.append(Chunk{mText.mid(chunkStart, pos - chunkStart), {}});
     }
-    bool keyFound = false;
+    mChunks.append(Chunk{QString(), keys});
     foreach (const QString& key, keys) {
-      if (key.startsWith('\'') && key.endsWith('\'')) {
-        // replace "{{'VALUE'}}" with "VALUE"
-        str.replace(startPos, length, key.mid(1, key.length() - 2));
-        startPos +=
-            key.length() - 2;  // do not search for variables in the value
-        keyFound = true;
-        break;
-      } else if ((getValueOfKey(key, value, ap)) &&
-                 (!keyBacktrace.contains(key))) {
-        // replace "{{KEY}}" with the value of KEY
-        str.replace(startPos, length, value);
-        keyBacktrace.insert(key);
-        keyFound = true;
-        break;
+      if (!(key.startsWith('\'') && key.endsWith('\''))) {
+        mKeys.insert(key);
       }
     }
-    if (!keyFound) {
-      // attribute not found, remove "{{KEY}}" from str
-      str.remove(startPos, length);
-    }
+    chunkStart = pos + length;
   }
-  if (filter && (outerVariableStart >= 0)) {
-    applyFilter(str, outerVariableStart, outerVariableEnd, filter);
+  if (chunkStart < mText.length()) {
+    mChunks.append(Chunk{mText.mid(chunkStart), {}});
   }
-  return str;
+}
+
+/*******************************************************************************
+ *  Public Methods
+ ******************************************************************************/
+
+QString AttributeSubstitutor::substitute(QString                  str,
+                                         const AttributeProvider* ap,
+                                         FilterFunction filter) noexcept {
+  return substitute(Template(str), ap, filter);
+}
+
+QString AttributeSubstitutor::substitute(const Template&          tpl,
+                                         const AttributeProvider* ap,
+                                         FilterFunction           filter,
+                                         QSet<QString>* usedKeys) noexcept {
+  QStringList backtrace;  // avoid endless recursion
+  return substituteChunks(tpl, ap, filter, backtrace, usedKeys);
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+QString AttributeSubstitutor::substituteChunks(
+    const Template& tpl, const AttributeProvider* ap, FilterFunction filter,
+    QStringList& backtrace, QSet<QString>* usedKeys) noexcept {
+  QString str;
+  foreach (const Template::Chunk& chunk, tpl.mChunks) {
+    if (chunk.keys.isEmpty()) {
+      str += chunk.literal;
+    } else if (filter) {
+      str += filter(substituteKeys(chunk.keys, ap, backtrace, usedKeys));
+    } else {
+      str += substituteKeys(chunk.keys, ap, backtrace, usedKeys);
+    }
+  }
+  return str;
+}
+
+QString AttributeSubstitutor::substituteKeys(const QStringList&       keys,
+                                             const AttributeProvider* ap,
+                                             QStringList&             backtrace,
+                                             QSet<QString>* usedKeys) noexcept {
+  QString value;
+  foreach (const QString& key, keys) {
+    if (key.startsWith('\'') && key.endsWith('\'')) {
+      // replace "{{'VALUE'}}" with "VALUE" (without substituting the value)
+      return key.mid(1, key.length() - 2);
+    }
+    if (usedKeys) {
+      usedKeys->insert(key);
+    }
+    if ((!backtrace.contains(key)) && (getValueOfKey(key, value, ap))) {
+      // replace "{{KEY}}" with the value of KEY, which may contain variables
+      // as well (but not KEY itself, to avoid endless recursion)
+      backtrace.append(key);
+      value = substituteChunks(Template(value), ap, nullptr, backtrace,
+                               usedKeys);
+      backtrace.removeLast();
+      if (!value.isEmpty()) {
+        return value;
+      }
+    }
+  }
+  return QString();  // attribute not found, remove "{{KEY}}"
+}
+
 bool AttributeSubstitutor::searchVariablesInText(const QString& text,
                                                  int startPos, int& pos,
                                                  int&         length,
                                                  QStringList& keys) noexcept {
-  QRegularExpression      re("\\{\\{(.*?)\\}\\}");
-  QRegularExpressionMatch match = re.match(text, startPos);
+  if (text.indexOf(QLatin1String("{{"), startPos) < 0) {
+    return false;  // fast path for the most common case (no variables at all)
+  }
+  // compile the regex only once, it's used extremely often (e.g. BOM export)
+  static const QRegularExpression re("\\{\\{(.*?)\\}\\}");
+  QRegularExpressionMatch         match = re.match(text, startPos);
   if (match.hasMatch() && match.capturedLength() > 0) {
     pos = match.capturedStart();
     if (text.midRef(pos).startsWith("{{ '}}' }}")) {
@@ -111,14 +153,6 @@ bool AttributeSubstitutor::searchVariablesInText(const QString& text,
   }
 }
 
-void AttributeSubstitutor::applyFilter(QString& str, int& start, int& end,
-                                       FilterFunction filter) noexcept {
-  int length = str.length() - end - start;
-  str.replace(start, length, filter(str.mid(start, length)));
-  start = -1;
-  end   = -1;
-}
-
 bool AttributeSubstitutor::getValueOfKey(const QString& key, QString& value,
                                          const AttributeProvider* ap) noexcept {
   if (ap) {
@@ -48,18 +48,65 @@ class AttributeProvider;
  *
  * @see librepcb::AttributeProvider
  * @see @ref doc_attributes_system
- *
- * @todo Fix side-effect of the endless loop detection ("{{FOO}} {{FOO}}" is
- * currently substituted by "{{FOO}} " because of the endless loop detection,
- * even if there is actually no endless loop).
- * @todo Properly implement multiple key substitution ("{{FOO or BAR}}" is
- * currently substituted by "{{FOO}}", even if the attribute {{FOO}} indirectly
- * evaluates to an empty string).
  */
 class AttributeSubstitutor final {
 public:
   using FilterFunction = std::function<QString(const QString&)>;
 
+  /**
+   * @brief A text which is parsed only once, to substitute it repeatedly
+   *
+   * Searching the variables in a text is much more expensive than looking up
+   * their values, so texts which are substituted again on every attribute
+   * change (e.g. texts of symbols and footprints) should keep a template
+   * instead of passing the plain string to #substitute() every time.
+   */
+  class Template final {
+  public:
+    // Constructors / Destructor / Operator Overloadings
+    Template() noexcept : Template(QString()) {}
+    Template(const Template& other) = default;
+    explicit Template(const QString& text) noexcept;
+    ~Template() noexcept {}
+    Template& operator=(const Template& rhs) = default;
+
+    // Getters
+    const QString& getText() const noexcept { return mText; }
+
+    /**
+     * @brief Get the keys of all variables in the text
+     *
+     * @note Keys looked up indirectly, i.e. through the values of these
+     *       attributes, are not known before substituting the text. See the
+     *       parameter "usedKeys" of #substitute() to get them.
+     *
+     * @return All attribute keys (without literals like "{{'VALUE'}}")
+     */
+    const QSet<QString>& getKeys() const noexcept { return mKeys; }
+
+    /**
+     * @brief Check whether the substituted text depends on attribute values
+     *
+     * @return False if the substituted text is always the same, no matter
+     *         which attribute provider is used
+     */
+    bool dependsOnAttributes() const noexcept { return !mKeys.isEmpty(); }
+
+  private:  // Data
+    friend class AttributeSubstitutor;
+
+    /// Either a literal part of the text (if the keys are empty) or a variable
+    /// (e.g. the keys {"FOO", "'literal'"} for "{{FOO or 'literal'}}")
+    struct Chunk {
+      QString     literal;
+      QStringList keys;
+    };
+
+    QString        mText;
+    QVector<Chunk> mChunks;
+    QSet<QString>  mKeys;
+  };
+
   // Constructors / Destructor / Operator Overloadings
   AttributeSubstitutor()                                  = delete;
   AttributeSubstitutor(const AttributeSubstitutor& other) = delete;
@@ -85,6 +132,25 @@ public:
   static QString substitute(QString str, const AttributeProvider* ap = nullptr,
                             FilterFunction filter = nullptr) noexcept;
 
+  /**
+   * @brief Substitute all attribute keys of a pre-parsed text with their
+   * attribute values
+   *
+   * @param tpl       The parsed text.
+   * @param ap        The attribute provider for attribute lookup.
+   * @param filter    See #substitute(QString, const AttributeProvider*,
+   *                  FilterFunction).
+   * @param usedKeys  If not nullptr, the keys of all looked up attributes will
+   *                  be added to this set, including the keys of variables
+   *                  which were contained in attribute values. The result
+   *                  only changes if the value of one of these keys changes.
+   *
+   * @return The substituted text
+   */
+  static QString substitute(const Template& tpl, const AttributeProvider* ap,
+                            FilterFunction filter   = nullptr,
+                            QSet<QString>* usedKeys = nullptr) noexcept;
+
 private:  // Methods
   /**
    * @brief Search the next variables (e.g. "{{KEY or FALLBACK}}") in a given
@@ -105,8 +171,16 @@ private:  // Methods
   static bool searchVariablesInText(const QString& text, int startPos, int& pos,
                                     int& length, QStringList& keys) noexcept;
 
-  static void applyFilter(QString& str, int& start, int& end,
-                          FilterFunction filter) noexcept;
+  static QString substituteChunks(const Template&          tpl,
+                                  const AttributeProvider* ap,
+                                  FilterFunction           filter,
+                                  QStringList&             backtrace,
+                                  QSet<QString>*           usedKeys) noexcept;
+
+  static QString substituteKeys(const QStringList&       keys,
+                                const AttributeProvider* ap,
+                                QStringList&             backtrace,
+                                QSet<QString>*           usedKeys) noexcept;
 
   static bool getValueOfKey(const QString& key, QString& value,
                             const AttributeProvider* ap) noexcept;
@@ -33,12 +33,43 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-Bom::Bom(const QStringList& columns) noexcept : mColumns(columns), mItems() {
+Bom::Bom(const QStringList& columns) noexcept
+  : mColumns(columns), mItems(), mItemsSorted(true), mItemIndices() {
 }
 
 Bom::~Bom() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+const QList<BomItem>& Bom::getItems() const noexcept {
+  if (!mItemsSorted) {
+    // Sort designators and items by designator to improve readability of the
+    // BOM. This is done only once after adding all the items, because sorting
+    // on every insertion gets very slow for large projects.
+    QCollator collator;
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    collator.setIgnorePunctuation(false);
+    collator.setNumericMode(true);
+    for (BomItem& item : mItems) {
+      item.sortDesignators(collator);
+    }
+    std::sort(mItems.begin(), mItems.end(),
+              [&collator](const BomItem& lhs, const BomItem& rhs) {
+                return collator(lhs.getDesignators().first(),
+                                rhs.getDesignators().first());
+              });
+    mItemIndices.clear();
+    for (int i = 0; i < mItems.count(); ++i) {
+      mItemIndices.insert(mItems.at(i).getAttributes(), i);
+    }
+    mItemsSorted = true;
+  }
+  return mItems;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -47,28 +78,14 @@ void Bom::addItem(const QString&     designator,
                   const QStringList& attributes) noexcept {
   Q_ASSERT(attributes.count() == mColumns.count());
 
-  bool itemAdded = false;
-  for (BomItem& item : mItems) {
-    if (item.getAttributes() == attributes) {
-      item.addDesignator(designator);
-      itemAdded = true;
-    }
-  }
-
-  if (!itemAdded) {
+  auto it = mItemIndices.constFind(attributes);
+  if (it != mItemIndices.constEnd()) {
+    mItems[*it].addDesignator(designator);
+  } else {
+    mItemIndices.insert(attributes, mItems.count());
     mItems.append(BomItem(designator, attributes));
   }
-
-  // Sort items by designator to improve readability of the BOM
-  QCollator collator;
-  collator.setCaseSensitivity(Qt::CaseInsensitive);
-  collator.setIgnorePunctuation(false);
-  collator.setNumericMode(true);
-  std::sort(mItems.begin(), mItems.end(),
-            [&collator](const BomItem& lhs, const BomItem& rhs) {
-              return collator(lhs.getDesignators().first(),
-                              rhs.getDesignators().first());
-            });
+  mItemsSorted = false;
 }
 
 /*******************************************************************************
@@ -56,12 +56,8 @@ public:
   // General Methods
   void addDesignator(const QString& designator) noexcept {
     mDesignators.append(designator);
-
-    // sort designators to improve readability of the BOM
-    QCollator collator;
-    collator.setCaseSensitivity(Qt::CaseInsensitive);
-    collator.setIgnorePunctuation(false);
-    collator.setNumericMode(true);
+  }
+  void sortDesignators(const QCollator& collator) noexcept {
     std::sort(mDesignators.begin(), mDesignators.end(),
               [&collator](const QString& lhs, const QString& rhs) {
                 return collator(lhs, rhs);
@@ -99,7 +95,7 @@ public:
 
   // Getters
   const QStringList&    getColumns() const noexcept { return mColumns; }
-  const QList<BomItem>& getItems() const noexcept { return mItems; }
+  const QList<BomItem>& getItems() const noexcept;
 
   // General Methods
   void addItem(const QString&     designator,
@@ -109,8 +105,14 @@ public:
   Bom& operator=(const Bom& rhs) noexcept = delete;
 
 private:
-  QStringList    mColumns;
-  QList<BomItem> mItems;
+  QStringList mColumns;
+
+  /// Items (and their designators) are sorted lazily in #getItems()
+  mutable QList<BomItem> mItems;
+  mutable bool           mItemsSorted;
+
+  /// Index in #mItems for each attribute tuple, used for grouping
+  mutable QHash<QStringList, int> mItemIndices;
 };
 
 /*******************************************************************************
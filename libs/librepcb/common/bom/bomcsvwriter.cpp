@@ -23,6 +23,7 @@
 #include "bomcsvwriter.h"
 
 #include "../fileio/csvfile.h"
+#include "../fileio/csvstreamwriter.h"
 #include "bom.h"
 
 #include <QtCore>
@@ -48,22 +49,39 @@ BomCsvWriter::~BomCsvWriter() noexcept {
 
 std::shared_ptr<CsvFile> BomCsvWriter::generateCsv() const {
   std::shared_ptr<CsvFile> file(new CsvFile());
+  file->setHeader(getHeader());
+  foreach (const BomItem& item, mBom.getItems()) {
+    file->addValue(itemToRow(item));  // can throw
+  }
+  return file;
+}
+
+void BomCsvWriter::writeCsv(QIODevice& device) const {
+  CsvStreamWriter writer(device);
+  writer.writeHeader(getHeader());  // can throw
+  foreach (const BomItem& item, mBom.getItems()) {
+    writer.writeRow(itemToRow(item));  // can throw
+  }
+}
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QStringList BomCsvWriter::getHeader() const noexcept {
   // Don't translate the CSV header to make BOM files independent of the
   // user's language.
-  file->setHeader(QStringList{"Quantity", "Designators"} + mBom.getColumns());
+  return QStringList{"Quantity", "Designators"} + mBom.getColumns();
+}
 
-  foreach (const BomItem& item, mBom.getItems()) {
-    QStringList values;
-    values += QString::number(item.getDesignators().count());
-    values += item.getDesignators().join(", ");
-    foreach (const QString& attribute, item.getAttributes()) {
-      values += attribute;
-    }
-    file->addValue(values);  // can throw
+QStringList BomCsvWriter::itemToRow(const BomItem& item) noexcept {
+  QStringList values;
+  values += QString::number(item.getDesignators().count());
+  values += item.getDesignators().join(", ");
+  foreach (const QString& attribute, item.getAttributes()) {
+    values += attribute;
   }
-
-  return file;
+  return values;
 }
 
 /*******************************************************************************
@@ -33,6 +33,7 @@
 namespace librepcb {
 
 class Bom;
+class BomItem;
 class CsvFile;
 
 /*******************************************************************************
@@ -55,10 +56,23 @@ public:
   // General Methods
   std::shared_ptr<CsvFile> generateCsv() const;
 
+  /**
+   * @brief Write the CSV directly to a device, without building a CsvFile
+   *
+   * @param device  The device to write to (must be opened for writing).
+   *
+   * @throw ::librepcb::Exception if writing to the device failed.
+   */
+  void writeCsv(QIODevice& device) const;
+
   // Operator Overloadings
   BomCsvWriter& operator=(const BomCsvWriter& rhs) = delete;
 
-private:
+private:  // Methods
+  QStringList        getHeader() const noexcept;
+  static QStringList itemToRow(const BomItem& item) noexcept;
+
+private:  // Data
   const Bom& mBom;
 };
 
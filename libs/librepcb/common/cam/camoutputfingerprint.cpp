@@ -0,0 +1,135 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "camoutputfingerprint.h"
+
+#include <QtCore>
+
+#include <algorithm>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+CamOutputFingerprint::CamOutputFingerprint() noexcept
+  : QIODevice(), mHash(QCryptographicHash::Md5), mCurrentLine() {
+  open(QIODevice::WriteOnly);
+}
+
+CamOutputFingerprint::~CamOutputFingerprint() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QByteArray CamOutputFingerprint::getResult() noexcept {
+  if (!mCurrentLine.isEmpty()) {
+    addLine(mCurrentLine);
+    mCurrentLine.clear();
+  }
+  return mHash.result();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QByteArray CamOutputFingerprint::fromFile(const FilePath& fp) {
+  QFile file(fp.toStr());
+  if (!file.open(QIODevice::ReadOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Could not open file \"%1\": %2")
+                           .arg(fp.toNative(), file.errorString()));
+  }
+  CamOutputFingerprint fingerprint;
+  while (!file.atEnd()) {
+    QByteArray chunk = file.read(1024 * 1024);
+    if (chunk.isEmpty()) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("Could not read file \"%1\": %2")
+                             .arg(fp.toNative(), file.errorString()));
+    }
+    fingerprint.write(chunk);
+  }
+  return fingerprint.getResult();
+}
+
+/*******************************************************************************
+ *  Inherited from QIODevice
+ ******************************************************************************/
+
+qint64 CamOutputFingerprint::readData(char* data, qint64 maxSize) noexcept {
+  Q_UNUSED(data);
+  Q_UNUSED(maxSize);
+  return -1;  // write-only device
+}
+
+qint64 CamOutputFingerprint::writeData(const char* data,
+                                       qint64      maxSize) noexcept {
+  const char* end = data + maxSize;
+  while (data < end) {
+    const char* newline = std::find(data, end, '\n');
+    mCurrentLine.append(data, newline - data);
+    if (newline != end) {
+      addLine(mCurrentLine);
+      mCurrentLine.clear();
+      data = newline + 1;
+    } else {
+      data = end;
+    }
+  }
+  return maxSize;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CamOutputFingerprint::addLine(const QByteArray& line) noexcept {
+  // lines which differ between exports of the same data
+  static const QList<QByteArray> volatileLines = {
+      "%TF.GenerationSoftware,",  // Gerber: application version
+      "%TF.CreationDate,",        // Gerber: creation date
+      "%TF.MD5,",                 // Gerber: checksum (contains creation date)
+      ";Generated by LibrePCB",   // Excellon: application version
+      ";Creation Date:",          // Excellon: creation date
+  };
+  foreach (const QByteArray& prefix, volatileLines) {
+    if (line.startsWith(prefix)) {
+      return;
+    }
+  }
+  mHash.addData(line);
+  mHash.addData("\n", 1);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
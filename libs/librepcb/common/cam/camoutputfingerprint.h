@@ -0,0 +1,85 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CAMOUTPUTFINGERPRINT_H
+#define LIBREPCB_CAMOUTPUTFINGERPRINT_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../exceptions.h"
+#include "../fileio/filepath.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class CamOutputFingerprint
+ ******************************************************************************/
+
+/**
+ * @brief Write-only device to calculate the fingerprint of CAM output files
+ *
+ * The fingerprint is an MD5 hash over all lines written to this device except
+ * the lines containing volatile data (creation date, application version and
+ * checksum). So it only changes if the actual content of a Gerber or Excellon
+ * file changes, which allows to detect whether an existing output file is
+ * still up to date.
+ */
+class CamOutputFingerprint final : public QIODevice {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  CamOutputFingerprint(const CamOutputFingerprint& other) = delete;
+  CamOutputFingerprint() noexcept;
+  ~CamOutputFingerprint() noexcept;
+
+  // General Methods
+  QByteArray getResult() noexcept;
+
+  // Static Methods
+  static QByteArray fromFile(const FilePath& fp);
+
+  // Operator Overloadings
+  CamOutputFingerprint& operator=(const CamOutputFingerprint& rhs) = delete;
+
+protected:
+  // Inherited from QIODevice
+  qint64 readData(char* data, qint64 maxSize) noexcept override;
+  qint64 writeData(const char* data, qint64 maxSize) noexcept override;
+
+private:
+  void addLine(const QByteArray& line) noexcept;
+
+  QCryptographicHash mHash;
+  QByteArray         mCurrentLine;  ///< not yet terminated line
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CAMOUTPUTFINGERPRINT_H
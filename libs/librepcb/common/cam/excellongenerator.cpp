@@ -35,83 +35,120 @@ namespace librepcb {
  *  Constructors / Destructor
  ******************************************************************************/
 
-ExcellonGenerator::ExcellonGenerator() noexcept : mOutput() {
+ExcellonGenerator::ExcellonGenerator() noexcept
+  : mCreationDate(QDateTime::currentDateTime()), mDrills() {
 }
 
 ExcellonGenerator::~ExcellonGenerator() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QString ExcellonGenerator::toStr() const {
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  writeTo(buffer);  // can throw
+  return QString::fromLatin1(buffer.data());
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
 void ExcellonGenerator::drill(const Point&          pos,
                               const PositiveLength& dia) noexcept {
-  mDrillList.insert(*dia, pos);
+  mDrills[*dia].append(pos);
 }
 
 void ExcellonGenerator::generate() {
-  mOutput.clear();
-  printHeader();
-  printDrills();
-  printFooter();
+  // The output is created while writing it, so only the creation date needs
+  // to be fixed to get the same output from every #writeTo() call.
+  mCreationDate = QDateTime::currentDateTime();
 }
 
 void ExcellonGenerator::saveToFile(const FilePath& filepath) const {
-  FileUtils::writeFile(filepath, mOutput.toLatin1());  // can throw
+  FileUtils::writeFile(filepath, [this](QIODevice& device) {
+    writeTo(device);  // can throw
+  });  // can throw
+}
+
+void ExcellonGenerator::writeTo(QIODevice& device) const {
+  QByteArray chunk;
+  auto       flush = [&]() {
+    if (device.write(chunk) != chunk.size()) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          tr("Failed to write excellon data: %1").arg(device.errorString()));
+    }
+    chunk.clear();
+  };
+
+  QList<Length> diameters = getSortedDiameters();
+  chunk.reserve(sChunkSize + 64);
+  chunk.append(generateHeader(diameters));
+  for (int i = 0; i < diameters.count(); ++i) {
+    chunk.append(QString("T%1\n").arg(i + 1).toLatin1());  // Select Tool
+    const QVector<Point>& positions = mDrills.value(diameters.at(i));
+    // Write the latest drill first, as it was done before the drills got
+    // stored in vectors. This keeps the output stable across versions.
+    for (int k = positions.count() - 1; k >= 0; --k) {
+      const Point& pos = positions.at(k);
+      chunk.append('X');
+      chunk.append(pos.getX().toMmString().toLatin1());
+      chunk.append('Y');
+      chunk.append(pos.getY().toMmString().toLatin1());
+      chunk.append('\n');
+      if (chunk.size() >= sChunkSize) {
+        flush();  // can throw
+      }
+    }
+  }
+  chunk.append("T0\n");
+  chunk.append("M30\n");  // End of Program Rewind
+  flush();                // can throw
 }
 
 void ExcellonGenerator::reset() noexcept {
-  mOutput.clear();
-  mDrillList.clear();
+  mDrills.clear();
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void ExcellonGenerator::printHeader() noexcept {
-  mOutput.append("M48\n");  // Beginning of Part Program Header
+QByteArray ExcellonGenerator::generateHeader(
+    const QList<Length>& diameters) const noexcept {
+  QString header;
+  header.append("M48\n");  // Beginning of Part Program Header
 
   // Comments
-  mOutput.append(";DRILL FILE\n");
-  mOutput.append(
+  header.append(";DRILL FILE\n");
+  header.append(
       QString(";Generated by LibrePCB %1\n").arg(qApp->applicationVersion()));
-  mOutput.append(QString(";Creation Date: %1\n")
-                     .arg(QDateTime::currentDateTime().toString(Qt::ISODate)));
-  mOutput.append("FMAT,2\n");     // Use Format 2 commands
-  mOutput.append("METRIC,TZ\n");  // Metric Format, Trailing Zeros Mode
-
-  printToolList();
-
-  mOutput.append("%\n");    // Beginning of Pattern
-  mOutput.append("G90\n");  // Absolute Mode
-  mOutput.append("G05\n");  // Drill Mode
-  mOutput.append("M71\n");  // Metric Measuring Mode
-}
-
-void ExcellonGenerator::printToolList() noexcept {
-  for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-    Length dia = mDrillList.uniqueKeys().value(i);
-    mOutput.append(QString("T%1C%2\n").arg(i + 1).arg(dia.toMmString()));
+  header.append(QString(";Creation Date: %1\n")
+                    .arg(mCreationDate.toString(Qt::ISODate)));
+  header.append("FMAT,2\n");     // Use Format 2 commands
+  header.append("METRIC,TZ\n");  // Metric Format, Trailing Zeros Mode
+
+  // Tool List
+  for (int i = 0; i < diameters.count(); ++i) {
+    header.append(
+        QString("T%1C%2\n").arg(i + 1).arg(diameters.at(i).toMmString()));
   }
-}
 
-void ExcellonGenerator::printDrills() noexcept {
-  for (int i = 0; i < mDrillList.uniqueKeys().count(); ++i) {
-    mOutput.append(QString("T%1\n").arg(i + 1));  // Select Tool
-    Length dia = mDrillList.uniqueKeys().value(i);
-    foreach (const Point& pos, mDrillList.values(dia)) {
-      mOutput.append(
-          QString("X%1Y%2\n")
-              .arg(pos.getX().toMmString(), pos.getY().toMmString()));
-    }
-  }
+  header.append("%\n");    // Beginning of Pattern
+  header.append("G90\n");  // Absolute Mode
+  header.append("G05\n");  // Drill Mode
+  header.append("M71\n");  // Metric Measuring Mode
+  return header.toLatin1();
 }
 
-void ExcellonGenerator::printFooter() noexcept {
-  mOutput.append("T0\n");
-  mOutput.append("M30\n");  // End of Program Rewind
+QList<Length> ExcellonGenerator::getSortedDiameters() const noexcept {
+  QList<Length> diameters = mDrills.keys();
+  std::sort(diameters.begin(), diameters.end());
+  return diameters;
 }
 
 /*******************************************************************************
@@ -40,6 +40,11 @@ namespace librepcb {
 
 /**
  * @brief The ExcellonGenerator class
+ *
+ * The drills are collected in one contiguous list per diameter, and the
+ * output is written directly to a device by #writeTo() instead of being
+ * assembled in memory first. This keeps the memory usage low even for boards
+ * with a huge number of holes.
  */
 class ExcellonGenerator final {
   Q_DECLARE_TR_FUNCTIONS(ExcellonGenerator)
@@ -52,26 +57,28 @@ public:
   ~ExcellonGenerator() noexcept;
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  QString toStr() const;
 
   // General Methods
   void drill(const Point& pos, const PositiveLength& dia) noexcept;
   void generate();
   void saveToFile(const FilePath& filepath) const;
+  void writeTo(QIODevice& device) const;
   void reset() noexcept;
 
   // Operator Overloadings
   ExcellonGenerator& operator=(const ExcellonGenerator& rhs) = delete;
 
 private:
-  void printHeader() noexcept;
-  void printToolList() noexcept;
-  void printDrills() noexcept;
-  void printFooter() noexcept;
+  QByteArray    generateHeader(const QList<Length>& diameters) const noexcept;
+  QList<Length> getSortedDiameters() const noexcept;
+
+  /// Size of the output chunks written to the device
+  static constexpr int sChunkSize = 64 * 1024;
 
   // Excellon Data
-  QString                  mOutput;
-  QMultiMap<Length, Point> mDrillList;
+  QDateTime                     mCreationDate;
+  QHash<Length, QVector<Point>> mDrills;  ///< Drill positions per diameter
 };
 
 /*******************************************************************************
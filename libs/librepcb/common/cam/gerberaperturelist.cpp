@@ -63,16 +63,19 @@ QString GerberApertureList::generateString() const noexcept {
 
 int GerberApertureList::setCircle(const UnsignedLength& dia,
                                   const UnsignedLength& hole) {
-  return setCurrentAperture(generateCircle(dia, hole));
+  return setCurrentAperture({Shape::Circle, *dia, 0, 0, Angle(0), *hole},
+                            [&]() { return generateCircle(dia, hole); });
 }
 
 int GerberApertureList::setRect(const UnsignedLength& w,
                                 const UnsignedLength& h, const Angle& rot,
                                 const UnsignedLength& hole) noexcept {
   if (rot % Angle::deg180() == 0) {
-    return setCurrentAperture(generateRect(w, h, hole));
+    return setCurrentAperture({Shape::Rect, *w, *h, 0, Angle(0), *hole},
+                              [&]() { return generateRect(w, h, hole); });
   } else if (rot % Angle::deg90() == 0) {
-    return setCurrentAperture(generateRect(h, w, hole));
+    return setCurrentAperture({Shape::Rect, *h, *w, 0, Angle(0), *hole},
+                              [&]() { return generateRect(h, w, hole); });
   } else {
     // Rotation is not a multiple of 90 degrees --> we need to use an aperture
     // macro
@@ -81,7 +84,9 @@ int GerberApertureList::setRect(const UnsignedLength& w,
     } else {
       addMacro(generateRotatedRectMacro());
     }
-    return setCurrentAperture(generateRotatedRect(w, h, rot, hole));
+    return setCurrentAperture(
+        {Shape::RotatedRect, *w, *h, 0, rot, *hole},
+        [&]() { return generateRotatedRect(w, h, rot, hole); });
   }
 }
 
@@ -89,9 +94,11 @@ int GerberApertureList::setObround(const UnsignedLength& w,
                                    const UnsignedLength& h, const Angle& rot,
                                    const UnsignedLength& hole) noexcept {
   if (rot % Angle::deg180() == 0) {
-    return setCurrentAperture(generateObround(w, h, hole));
+    return setCurrentAperture({Shape::Obround, *w, *h, 0, Angle(0), *hole},
+                              [&]() { return generateObround(w, h, hole); });
   } else if (rot % Angle::deg90() == 0) {
-    return setCurrentAperture(generateObround(h, w, hole));
+    return setCurrentAperture({Shape::Obround, *h, *w, 0, Angle(0), *hole},
+                              [&]() { return generateObround(h, w, hole); });
   } else {
     // Rotation is not a multiple of 90 degrees --> we need to use an aperture
     // macro
@@ -100,7 +107,9 @@ int GerberApertureList::setObround(const UnsignedLength& w,
     } else {
       addMacro(generateRotatedObroundMacro());
     }
-    return setCurrentAperture(generateRotatedObround(w, h, rot, hole));
+    return setCurrentAperture(
+        {Shape::RotatedObround, *w, *h, 0, rot, *hole},
+        [&]() { return generateRotatedObround(w, h, rot, hole); });
   }
 }
 
@@ -115,7 +124,9 @@ int GerberApertureList::setRegularPolygon(const UnsignedLength& dia, int n,
   // Adjust rotation as its interpretation differs between LibrePCB and Gerber
   // specs
   Angle grbRot = rot + (Angle::deg180() / (n > 0 ? n : 1));
-  return setCurrentAperture(generateRegularPolygon(dia, n, grbRot, hole));
+  return setCurrentAperture(
+      {Shape::RegularPolygon, *dia, n, 0, grbRot, *hole},
+      [&]() { return generateRegularPolygon(dia, n, grbRot, hole); });
 }
 
 int GerberApertureList::setOctagon(const UnsignedLength& w,
@@ -127,24 +138,30 @@ int GerberApertureList::setOctagon(const UnsignedLength& w,
   } else {
     addMacro(generateRotatedOctagonMacro());
   }
-  return setCurrentAperture(generateRotatedOctagon(w, h, edge, rot, hole));
+  return setCurrentAperture(
+      {Shape::RotatedOctagon, *w, *h, *edge, rot, *hole},
+      [&]() { return generateRotatedOctagon(w, h, edge, rot, hole); });
 }
 
 void GerberApertureList::reset() noexcept {
   // mApertureMacros.clear();
   mApertures.clear();
+  mApertureNumbers.clear();
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-int GerberApertureList::setCurrentAperture(const QString& aperture) noexcept {
-  int number = mApertures.key(aperture, -1);
+int GerberApertureList::setCurrentAperture(
+    const ApertureKey&              key,
+    const std::function<QString()>& generator) noexcept {
+  int number = mApertureNumbers.value(key, -1);
   if (number < 0) {
     number = mApertures.count() + 10;  // 10 is the number of the first aperture
     Q_ASSERT(!mApertures.contains(number));
-    mApertures.insert(number, aperture);
+    mApertures.insert(number, generator());
+    mApertureNumbers.insert(key, number);
   }
   return number;
 }
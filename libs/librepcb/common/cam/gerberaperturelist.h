@@ -30,6 +30,8 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -72,8 +74,43 @@ public:
   GerberApertureList& operator=(const GerberApertureList& rhs) = delete;
 
 private:
+  // Types
+  enum class Shape {
+    Circle,
+    Rect,
+    Obround,
+    RegularPolygon,
+    RotatedRect,
+    RotatedObround,
+    RotatedOctagon,
+  };
+
+  /**
+   * @brief Compact identifier of an aperture
+   *
+   * Used to look up existing apertures without generating (and comparing)
+   * their definition strings, which is much faster since apertures are
+   * looked up for every flash and line. Two apertures with the same key
+   * always have the same definition string.
+   */
+  struct ApertureKey {
+    Shape  shape;
+    Length a;  ///< diameter or width
+    Length b;  ///< height or number of vertices
+    Length c;  ///< edge
+    Angle  rot;
+    Length hole;
+
+    bool operator==(const ApertureKey& rhs) const noexcept {
+      return (shape == rhs.shape) && (a == rhs.a) && (b == rhs.b) &&
+          (c == rhs.c) && (rot == rhs.rot) && (hole == rhs.hole);
+    }
+  };
+  friend uint qHash(const ApertureKey& key, uint seed) noexcept;
+
   // Private Methods
-  int  setCurrentAperture(const QString& aperture) noexcept;
+  int  setCurrentAperture(const ApertureKey&             key,
+                          const std::function<QString()>& generator) noexcept;
   void addMacro(const QString& macro) noexcept;
 
   // Aperture Generator Methods
@@ -109,8 +146,27 @@ private:
   QList<QString> mApertureMacros;
   QMap<int, QString>
       mApertures;  ///< key: aperture number (>= 10); value: aperture definition
+  QHash<ApertureKey, int> mApertureNumbers;  ///< reverse lookup of #mApertures
 };
 
+/*******************************************************************************
+ *  Non-Member Functions
+ ******************************************************************************/
+
+inline uint qHash(const GerberApertureList::ApertureKey& key,
+                  uint                                   seed) noexcept {
+  auto combine = [&seed](uint hash) {
+    seed ^= hash + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+  };
+  combine(::qHash(static_cast<int>(key.shape)));
+  combine(qHash(key.a));
+  combine(qHash(key.b));
+  combine(qHash(key.c));
+  combine(qHash(key.rot));
+  combine(qHash(key.hole));
+  return seed;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
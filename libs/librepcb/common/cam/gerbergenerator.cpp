@@ -44,8 +44,7 @@ GerberGenerator::GerberGenerator(const QString& projName, const Uuid& projUuid,
   : mProjectId(escapeString(projName)),
     mProjectUuid(projUuid),
     mProjectRevision(escapeString(projRevision)),
-    mOutput(),
-    mContent(),
+    mContent(createContentDevice()),
     mApertureList(new GerberApertureList()),
     mCurrentApertureNumber(-1),
     mMultiQuadrantArcModeOn(false) {
@@ -61,10 +60,10 @@ GerberGenerator::~GerberGenerator() noexcept {
 void GerberGenerator::setLayerPolarity(LayerPolarity p) noexcept {
   switch (p) {
     case LayerPolarity::Positive:
-      mContent.append("%LPD*%\n");
+      appendContent("%LPD*%\n");
       break;
     case LayerPolarity::Negative:
-      mContent.append("%LPC*%\n");
+      appendContent("%LPC*%\n");
       break;
     default:
       qCritical() << "Invalid Layer Polarity:" << static_cast<int>(p);
@@ -164,78 +163,142 @@ void GerberGenerator::flashOctagon(const Point& pos, const UnsignedLength& w,
  *  General Methods
  ******************************************************************************/
 
+QString GerberGenerator::toStr() const {
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  writeTo(buffer);  // can throw
+  return QString::fromLatin1(buffer.data());
+}
+
 void GerberGenerator::reset() noexcept {
-  mOutput.clear();
-  mContent.clear();
+  mContent.reset(createContentDevice());
   mApertureList->reset();
   mCurrentApertureNumber = -1;
 }
 
 void GerberGenerator::generate() {
-  mOutput.clear();
-  printHeader();
-  printApertureList();
-  printContent();
-  printFooter();
+  // The output is assembled while writing it, so just make sure all content
+  // has been written to the temporary file.
+  QFileDevice* file = qobject_cast<QFileDevice*>(mContent.data());
+  if ((!mContent->isOpen()) || (file && (!file->flush()))) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to write gerber content: %1")
+                           .arg(mContent->errorString()));
+  }
 }
 
 void GerberGenerator::saveToFile(const FilePath& filepath) const {
-  FileUtils::writeFile(filepath, mOutput.toLatin1());  // can throw
+  FileUtils::makePath(filepath.getParentDir());  // can throw
+  QSaveFile file(filepath.toStr());
+  if (!file.open(QIODevice::WriteOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Could not open file \"%1\": %2")
+                           .arg(filepath.toNative(), file.errorString()));
+  }
+  writeTo(file);  // can throw
+  if (!file.commit()) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Could not write file \"%1\": %2")
+                           .arg(filepath.toNative(), file.errorString()));
+  }
+}
+
+void GerberGenerator::writeTo(QIODevice& device) const {
+  // According to the RS-274C standard, linebreaks are not included in the
+  // checksum. It is calculated on the fly to avoid keeping the whole output
+  // in memory.
+  QCryptographicHash md5(QCryptographicHash::Md5);
+  auto               write = [&](const QByteArray& data, bool checksum) {
+    if (device.write(data) != data.size()) {
+      throw RuntimeError(
+          __FILE__, __LINE__,
+          tr("Failed to write gerber data: %1").arg(device.errorString()));
+    }
+    if (checksum) {
+      md5.addData(QByteArray(data).replace('\n', QByteArray()));
+    }
+  };
+
+  write(generateHeader().toLatin1(), true);
+  write(mApertureList->generateString().toLatin1(), true);
+  write("G04 --- BOARD BEGIN --- *\n", true);
+  if (!mContent->seek(0)) {
+    throw LogicError(__FILE__, __LINE__);
+  }
+  while (!mContent->atEnd()) {
+    QByteArray chunk = mContent->read(sCopyChunkSize);
+    if (chunk.isEmpty()) {
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("Failed to read gerber content: %1")
+                             .arg(mContent->errorString()));
+    }
+    write(chunk, true);
+  }
+  write("G04 --- BOARD END --- *\n", true);
+
+  // footer with MD5 checksum over content
+  QString checksum = QString(md5.result().toHex());
+  write(QString("%TF.MD5,%1*%\n").arg(checksum).toLatin1(), false);
+  write("M02*\n", false);  // end of file
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+void GerberGenerator::appendContent(const QString& str) noexcept {
+  mContent->write(str.toLatin1());
+}
+
 void GerberGenerator::setCurrentAperture(int number) noexcept {
   if (number != mCurrentApertureNumber) {
-    mContent.append(QString("D%1*\n").arg(number));
+    appendContent(QString("D%1*\n").arg(number));
     mCurrentApertureNumber = number;
   }
 }
 
 void GerberGenerator::setRegionModeOn() noexcept {
-  mContent.append("G36*\n");
+  appendContent("G36*\n");
 }
 
 void GerberGenerator::setRegionModeOff() noexcept {
-  mContent.append("G37*\n");
+  appendContent("G37*\n");
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOn() noexcept {
   if (!mMultiQuadrantArcModeOn) {
-    mContent.append("G75*\n");
+    appendContent("G75*\n");
     mMultiQuadrantArcModeOn = true;
   }
 }
 
 void GerberGenerator::setMultiQuadrantArcModeOff() noexcept {
   if (mMultiQuadrantArcModeOn) {
-    mContent.append("G74*\n");
+    appendContent("G74*\n");
     mMultiQuadrantArcModeOn = false;
   }
 }
 
 void GerberGenerator::switchToLinearInterpolationModeG01() noexcept {
-  mContent.append("G01*\n");
+  appendContent("G01*\n");
 }
 
 void GerberGenerator::switchToCircularCwInterpolationModeG02() noexcept {
-  mContent.append("G02*\n");
+  appendContent("G02*\n");
 }
 
 void GerberGenerator::switchToCircularCcwInterpolationModeG03() noexcept {
-  mContent.append("G03*\n");
+  appendContent("G03*\n");
 }
 
 void GerberGenerator::moveToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D02*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D02*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
 void GerberGenerator::linearInterpolateToPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D01*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D01*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
 void GerberGenerator::circularInterpolateToPosition(const Point& start,
@@ -245,8 +308,8 @@ void GerberGenerator::circularInterpolateToPosition(const Point& start,
   if (!mMultiQuadrantArcModeOn) {
     diff.makeAbs();  // no sign allowed in single quadrant mode!
   }
-  mContent.append(QString("X%1Y%2I%3J%4D01*\n")
-                      .arg(end.getX().toNmString(), end.getY().toNmString(),
+  appendContent(QString("X%1Y%2I%3J%4D01*\n")
+                    .arg(end.getX().toNmString(), end.getY().toNmString(),
                            diff.getX().toNmString(), diff.getY().toNmString()));
 }
 
@@ -274,76 +337,65 @@ void GerberGenerator::interpolateBetween(const Vertex& from,
 }
 
 void GerberGenerator::flashAtPosition(const Point& pos) noexcept {
-  mContent.append(QString("X%1Y%2D03*\n")
-                      .arg(pos.getX().toNmString(), pos.getY().toNmString()));
+  appendContent(QString("X%1Y%2D03*\n")
+                    .arg(pos.getX().toNmString(), pos.getY().toNmString()));
 }
 
-void GerberGenerator::printHeader() noexcept {
-  mOutput.append("G04 --- HEADER BEGIN --- *\n");
+QString GerberGenerator::generateHeader() const noexcept {
+  QString output = "G04 --- HEADER BEGIN --- *\n";
 
   // add some X2 attributes
   QString appVersion   = qApp->applicationVersion();
   QString creationDate = QDateTime::currentDateTime().toString(Qt::ISODate);
-  QString projId       = mProjectId.remove(',');
+  QString projId       = QString(mProjectId).remove(',');
   QString projUuid     = mProjectUuid.toStr();
-  QString projRevision = mProjectRevision.remove(',');
-  mOutput.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
-                     .arg(appVersion));
-  mOutput.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
-  mOutput.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
-                     .arg(projId, projUuid, projRevision));
-  mOutput.append("%TF.Part,Single*%\n");  // "Single" means "this is a PCB"
-  // mOutput.append("%TF.FilePolarity,Positive*%\n");
+  QString projRevision = QString(mProjectRevision).remove(',');
+  output.append(QString("%TF.GenerationSoftware,LibrePCB,LibrePCB,%1*%\n")
+                    .arg(appVersion));
+  output.append(QString("%TF.CreationDate,%1*%\n").arg(creationDate));
+  output.append(QString("%TF.ProjectId,%1,%2,%3*%\n")
+                    .arg(projId, projUuid, projRevision));
+  output.append("%TF.Part,Single*%\n");  // "Single" means "this is a PCB"
+  // output.append("%TF.FilePolarity,Positive*%\n");
 
   // coordinate format specification:
   //  - leading zeros omitted
   //  - absolute coordinates
   //  - coordiante format "6.6" --> allows us to directly use LengthBase_t
   //  (nanometers)!
-  mOutput.append("%FSLAX66Y66*%\n");
+  output.append("%FSLAX66Y66*%\n");
 
   // set unit to millimeters
-  mOutput.append("%MOMM*%\n");
+  output.append("%MOMM*%\n");
 
   // start linear interpolation mode
-  mOutput.append("G01*\n");
+  output.append("G01*\n");
 
   // use single quadrant arc mode
-  mOutput.append("G74*\n");
-
-  mOutput.append("G04 --- HEADER END --- *\n");
-}
-
-void GerberGenerator::printApertureList() noexcept {
-  mOutput.append(mApertureList->generateString());
-}
-
-void GerberGenerator::printContent() noexcept {
-  mOutput.append("G04 --- BOARD BEGIN --- *\n");
-  mOutput.append(mContent);
-  mOutput.append("G04 --- BOARD END --- *\n");
-}
-
-void GerberGenerator::printFooter() noexcept {
-  // MD5 checksum over content
-  mOutput.append(QString("%TF.MD5,%1*%\n").arg(calcOutputMd5Checksum()));
-
-  // end of file
-  mOutput.append("M02*\n");
-}
+  output.append("G74*\n");
 
-QString GerberGenerator::calcOutputMd5Checksum() const noexcept {
-  // according to the RS-274C standard, linebreaks are not included in the
-  // checksum
-  QString data = QString(mOutput).remove(QChar('\n'));
-  return QString(
-      QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Md5).toHex());
+  output.append("G04 --- HEADER END --- *\n");
+  return output;
 }
 
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
 
+QIODevice* GerberGenerator::createContentDevice() noexcept {
+  // Prefer a temporary file to keep memory usage low, but fall back to an
+  // in-memory buffer if no temporary file can be created.
+  QScopedPointer<QTemporaryFile> file(new QTemporaryFile());
+  if (file->open()) {
+    return file.take();
+  }
+  qWarning() << "Failed to create temporary file for gerber content:"
+             << file->errorString();
+  QBuffer* buffer = new QBuffer();
+  buffer->open(QIODevice::ReadWrite);
+  return buffer;
+}
+
 QString GerberGenerator::escapeString(const QString& str) noexcept {
   // perform compatibility decomposition (NFKD)
   QString ret = str.normalized(QString::NormalizationForm_KD);
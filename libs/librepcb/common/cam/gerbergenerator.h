@@ -51,6 +51,12 @@ class Vertex;
  *       ::librepcb::GerberGenerator::mProjectId and
  *       ::librepcb::GerberGenerator::mProjectRevision!
  * @todo Use file/aperture attributes
+ *
+ * To keep the memory usage low even for huge layers (e.g. with many planes),
+ * the drawn content is not kept in memory but written to a temporary file
+ * as Latin-1 bytes. Since the aperture list needs to be written before the
+ * content, the output file is assembled by #saveToFile() by writing the
+ * header and aperture list first and then copying the content in chunks.
  */
 class GerberGenerator final {
   Q_DECLARE_TR_FUNCTIONS(GerberGenerator)
@@ -69,7 +75,7 @@ public:
   ~GerberGenerator() noexcept;
 
   // Getters
-  const QString& toStr() const noexcept { return mOutput; }
+  QString toStr() const;
 
   // Plot Methods
   void setLayerPolarity(LayerPolarity p) noexcept;
@@ -99,12 +105,14 @@ public:
   void reset() noexcept;
   void generate();
   void saveToFile(const FilePath& filepath) const;
+  void writeTo(QIODevice& device) const;
 
   // Operator Overloadings
   GerberGenerator& operator=(const GerberGenerator& rhs) = delete;
 
 private:
   // Private Methods
+  void    appendContent(const QString& str) noexcept;
   void    setCurrentAperture(int number) noexcept;
   void    setRegionModeOn() noexcept;
   void    setRegionModeOff() noexcept;
@@ -119,14 +127,14 @@ private:
                                         const Point& end) noexcept;
   void    interpolateBetween(const Vertex& from, const Vertex& to) noexcept;
   void    flashAtPosition(const Point& pos) noexcept;
-  void    printHeader() noexcept;
-  void    printApertureList() noexcept;
-  void    printContent() noexcept;
-  void    printFooter() noexcept;
-  QString calcOutputMd5Checksum() const noexcept;
+  QString generateHeader() const noexcept;
 
   // Static Methods
-  static QString escapeString(const QString& str) noexcept;
+  static QIODevice* createContentDevice() noexcept;
+  static QString    escapeString(const QString& str) noexcept;
+
+  /// Chunk size used to copy the content into the output file
+  static constexpr qint64 sCopyChunkSize = 1024 * 1024;
 
   // Metadata
   QString mProjectId;
@@ -134,8 +142,7 @@ private:
   QString mProjectRevision;
 
   // Gerber Data
-  QString                            mOutput;
-  QString                            mContent;
+  QScopedPointer<QIODevice>          mContent;  ///< temporary file or buffer
   QScopedPointer<GerberApertureList> mApertureList;
   int                                mCurrentApertureNumber;
   bool                               mMultiQuadrantArcModeOn;
@@ -34,6 +34,7 @@ RESOURCES += \
 
 SOURCES += \
     algorithm/airwiresbuilder.cpp \
+    algorithm/unionfind.cpp \
     alignment.cpp \
     application.cpp \
     attributes/attribute.cpp \
@@ -54,6 +55,7 @@ SOURCES += \
     boarddesignrules.cpp \
     bom/bom.cpp \
     bom/bomcsvwriter.cpp \
+    cam/camoutputfingerprint.cpp \
     cam/excellongenerator.cpp \
     cam/gerberaperturelist.cpp \
     cam/gerbergenerator.cpp \
@@ -70,6 +72,7 @@ SOURCES += \
     exceptions.cpp \
     fileio/asynccopyoperation.cpp \
     fileio/csvfile.cpp \
+    fileio/csvstreamwriter.cpp \
     fileio/directorylock.cpp \
     fileio/filepath.cpp \
     fileio/fileutils.cpp \
@@ -122,6 +125,7 @@ SOURCES += \
     sqlitedatabase.cpp \
     systeminfo.cpp \
     toolbox.cpp \
+    tracer.cpp \
     undocommand.cpp \
     undocommandgroup.cpp \
     undostack.cpp \
@@ -130,11 +134,16 @@ SOURCES += \
     units/lengthunit.cpp \
     units/point.cpp \
     units/ratio.cpp \
+    utils/clipperareacache.cpp \
     utils/clipperhelpers.cpp \
+    utils/clipperoutlinecache.cpp \
+    utils/clippershapecache.cpp \
     utils/exclusiveactiongroup.cpp \
     utils/graphicslayerstackappearancesettings.cpp \
     utils/mathparser.cpp \
+    utils/memorypool.cpp \
     utils/toolbarproxy.cpp \
+    utils/transform.cpp \
     utils/undostackactiongroup.cpp \
     uuid.cpp \
     version.cpp \
@@ -164,6 +173,7 @@ SOURCES += \
 
 HEADERS += \
     algorithm/airwiresbuilder.h \
+    algorithm/unionfind.h \
     alignment.h \
     application.h \
     attributes/attribute.h \
@@ -185,6 +195,7 @@ HEADERS += \
     boarddesignrules.h \
     bom/bom.h \
     bom/bomcsvwriter.h \
+    cam/camoutputfingerprint.h \
     cam/excellongenerator.h \
     cam/gerberaperturelist.h \
     cam/gerbergenerator.h \
@@ -206,6 +217,7 @@ HEADERS += \
     fileio/cmd/cmdlistelementremove.h \
     fileio/cmd/cmdlistelementsswap.h \
     fileio/csvfile.h \
+    fileio/csvstreamwriter.h \
     fileio/directorylock.h \
     fileio/filepath.h \
     fileio/filesystem.h \
@@ -269,6 +281,7 @@ HEADERS += \
     sqlitedatabase.h \
     systeminfo.h \
     toolbox.h \
+    tracer.h \
     undocommand.h \
     undocommandgroup.h \
     undostack.h \
@@ -278,11 +291,18 @@ HEADERS += \
     units/lengthunit.h \
     units/point.h \
     units/ratio.h \
+    utils/boundedqueue.h \
+    utils/clipperareacache.h \
     utils/clipperhelpers.h \
+    utils/clipperoutlinecache.h \
+    utils/clippershapecache.h \
     utils/exclusiveactiongroup.h \
     utils/graphicslayerstackappearancesettings.h \
     utils/mathparser.h \
+    utils/memorypool.h \
+    utils/taskscheduler.h \
     utils/toolbarproxy.h \
+    utils/transform.h \
     utils/undostackactiongroup.h \
     uuid.h \
     version.h \
@@ -26,11 +26,32 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Class DebugWriterThread
+ ******************************************************************************/
+
+/**
+ * @brief Thread which just calls a given function
+ */
+class DebugWriterThread final : public QThread {
+public:
+  explicit DebugWriterThread(const std::function<void()>& func) noexcept
+    : QThread(nullptr), mFunc(func) {}
+
+protected:
+  void run() noexcept override { mFunc(); }
+
+private:
+  std::function<void()> mFunc;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -40,7 +61,15 @@ Debug::Debug()
     mDebugLevelLogFile(DebugLevel_t::Nothing),
     mStderrStream(new QTextStream(stderr)),
     mLogFilepath(),
-    mLogFile(0) {
+    mLogFile(0),
+    mQueue(sQueueCapacity),
+    mQueueSemaphore(0),
+    mWriterThread(new DebugWriterThread([this]() { writerLoop(); })),
+    mWriterRunning(false),
+    mStopWriter(false),
+    mEnqueuedCount(0),
+    mWrittenCount(0),
+    mDroppedCount(0) {
   // determine the filename of the log file which will be used if logging is
   // enabled
   QString datetime =
@@ -50,11 +79,22 @@ Debug::Debug()
   if (!dataDir.isEmpty())
     mLogFilepath.setPath(dataDir % "/logs/" % datetime % ".log");
 
+  // start the thread which writes the messages
+  mWriterThread->start(QThread::LowPriority);
+  mWriterRunning = true;
+
   // install the message handler for Qt's debug functions (qDebug(), ...)
   qInstallMessageHandler(messageHandler);
 }
 
 Debug::~Debug() {
+  // stop the writer thread after it has written all queued messages
+  mStopWriter = true;
+  mQueueSemaphore.release();
+  mWriterThread->wait();
+  mWriterRunning = false;  // from now on, messages are written synchronously
+  mWriterThread.reset();
+
   delete mStderrStream;
   mStderrStream = 0;
 
@@ -80,20 +120,26 @@ void Debug::setDebugLevelLogFile(DebugLevel_t level) {
       (level != DebugLevel_t::Nothing)) {
     // enable logging to file
     QDir().mkpath(mLogFilepath.getParentDir().toStr());
-    mLogFile     = new QFile(mLogFilepath.toStr());
-    bool success = mLogFile->open(QFile::WriteOnly);
+    QFile* logFile = new QFile(mLogFilepath.toStr());
+    bool   success = logFile->open(QFile::WriteOnly);
     if (success) {
+      {
+        QMutexLocker locker(&mMutex);
+        mLogFile = logFile;
+      }
       mDebugLevelLogFile = level;  // activate logging to file immediately!
       qDebug() << "Enabled logging to file:" << mLogFilepath.toNative();
     } else {
       qWarning() << "Cannot enable logging to file" << mLogFilepath.toNative();
-      qWarning() << "Error message:" << mLogFile->errorString();
-      delete mLogFile;
-      mLogFile = 0;
+      qWarning() << "Error message:" << logFile->errorString();
+      delete logFile;
     }
   } else if ((mDebugLevelLogFile != DebugLevel_t::Nothing) &&
              (level == DebugLevel_t::Nothing) && (mLogFile)) {
-    // disable logging to file
+    // disable logging to file, but write all queued messages before
+    mDebugLevelLogFile = level;
+    flush();
+    QMutexLocker locker(&mMutex);
     mLogFile->close();
     delete mLogFile;
     mLogFile = 0;
@@ -116,13 +162,128 @@ const FilePath& Debug::getLogFilepath() const {
 
 void Debug::print(DebugLevel_t level, const QString& msg, const char* file,
                   int line) {
-  QMutexLocker locker(&mMutex);
-
-  if ((mDebugLevelStderr < level) &&
-      ((mDebugLevelLogFile < level) || (!mLogFile)))
+  const bool toStderr  = (mDebugLevelStderr >= level);
+  const bool toLogFile = (mDebugLevelLogFile >= level);
+  if ((!toStderr) && (!toLogFile))
     return;  // if there is nothing to print, we will return immediately from
              // this function
 
+  Message message{level, formatMessage(level, msg, file, line), toStderr,
+                  toLogFile};
+  if ((level == DebugLevel_t::Fatal) || (!mWriterRunning)) {
+    // the application might be aborted, so write the message immediately
+    flush();
+    write(message);
+    flushStreams();
+  } else if (mQueue.tryPush(std::move(message))) {
+    ++mEnqueuedCount;
+    mQueueSemaphore.release();
+  } else {
+    ++mDroppedCount;  // will be reported by the writer thread
+  }
+}
+
+void Debug::flush() noexcept {
+  const qint64 count = mEnqueuedCount.load();
+  QMutexLocker locker(&mFlushMutex);
+  while (mWriterRunning && (QThread::currentThread() != mWriterThread.get()) &&
+         (mWrittenCount.load() < count)) {
+    mFlushCondition.wait(&mFlushMutex, 10);
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void Debug::writerLoop() noexcept {
+  Message last{DebugLevel_t::Nothing, QString(), false, false};
+  int     repetitions = 0;
+  auto    writeRepetitions = [this, &last, &repetitions]() {
+    if (repetitions > 0) {
+      write(Message{last.level,
+                    formatMessage(last.level,
+                                  QString("Last message repeated %1 times.")
+                                      .arg(repetitions),
+                                  __FILE__, __LINE__),
+                    last.toStderr, last.toLogFile});
+      repetitions = 0;
+    }
+  };
+
+  while (true) {
+    const bool gotMessage =
+        mQueueSemaphore.tryAcquire(1, sIdleFlushTimeMs);  // wait for message
+    Message message;
+    if (mQueue.tryPop(message)) {
+      // Rate limiting: Write repeated messages only once (e.g. the same
+      // warning for every element in a library).
+      if ((message.text == last.text) &&
+          (message.toStderr == last.toStderr) &&
+          (message.toLogFile == last.toLogFile)) {
+        ++repetitions;
+      } else {
+        writeRepetitions();
+        write(message);
+        last = message;
+      }
+      ++mWrittenCount;
+    } else if (gotMessage && mStopWriter) {
+      writeRepetitions();
+      flushStreams();
+      break;
+    } else if (!gotMessage) {
+      writeRepetitions();  // idle
+    }
+
+    // report dropped messages
+    const int dropped = mDroppedCount.exchange(0);
+    if (dropped > 0) {
+      write(Message{DebugLevel_t::Warning,
+                    formatMessage(DebugLevel_t::Warning,
+                                  QString("%1 log messages dropped since the "
+                                          "queue was full.")
+                                      .arg(dropped),
+                                  __FILE__, __LINE__),
+                    true, true});
+    }
+
+    // flush streams and wake up waiting threads if all messages are written
+    if (mQueueSemaphore.available() == 0) {
+      flushStreams();
+      QMutexLocker locker(&mFlushMutex);
+      mFlushCondition.wakeAll();
+    }
+  }
+}
+
+void Debug::write(const Message& message) noexcept {
+  QMutexLocker locker(&mMutex);
+
+  if (message.toStderr && mStderrStream) {
+    // write to stderr
+    *mStderrStream << message.text << '\n';
+  }
+
+  if (message.toLogFile && mLogFile) {
+    // write to the log file
+    QTextStream logFileStream(mLogFile);
+    logFileStream << message.text << '\n';
+  }
+}
+
+void Debug::flushStreams() noexcept {
+  QMutexLocker locker(&mMutex);
+  if (mStderrStream) {
+    mStderrStream->flush();
+  }
+  if (mLogFile) {
+    mLogFile->flush();
+  }
+}
+
+QString Debug::formatMessage(DebugLevel_t level, const QString& msg,
+                             const char* file, int line) noexcept {
   const char* levelStr =
       "---------";  // the debug level string has always 9 characters
   switch (level) {
@@ -148,20 +309,9 @@ void Debug::print(DebugLevel_t level, const QString& msg, const char* file,
       break;
   }
 
-  QString logMsg = QString("[%1] %2 (%3:%4)")
-                       .arg(levelStr, msg.toLocal8Bit().constData(), file)
-                       .arg(line);
-
-  if (mDebugLevelStderr >= level) {
-    // write to stderr
-    *mStderrStream << logMsg << endl;
-  }
-
-  if ((mDebugLevelLogFile >= level) && (mLogFile)) {
-    // write to the log file
-    QTextStream logFileStream(mLogFile);
-    logFileStream << logMsg << endl;
-  }
+  return QString("[%1] %2 (%3:%4)")
+      .arg(levelStr, msg.toLocal8Bit().constData(), file)
+      .arg(line);
 }
 
 /*******************************************************************************
@@ -24,9 +24,13 @@
  *  Includes
  ******************************************************************************/
 #include "fileio/filepath.h"
+#include "utils/boundedqueue.h"
 
 #include <QtCore>
 
+#include <atomic>
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -54,6 +58,15 @@ namespace librepcb {
  * This class can write messages to the stderr output and to a log file. You can
  * set separate debug levels for both. By default, logging to a file is
  * disabled.
+ *
+ * Messages are written asynchronously by a background thread, so logging
+ * does not slow down the calling thread (e.g. a library scan or an export).
+ * The messages are passed to that thread through a bounded lock-free queue.
+ * If the queue is full, further messages are dropped and their count is
+ * reported later. Consecutive identical messages are written only once,
+ * followed by the number of repetitions. Fatal messages are written
+ * synchronously after all queued messages, since the application is aborted
+ * afterwards.
  */
 class Debug final {
 public:
@@ -135,6 +148,11 @@ public:
   void print(DebugLevel_t level, const QString& msg, const char* file,
              int line);
 
+  /**
+   * @brief Wait until all previously printed messages are written
+   */
+  void flush() noexcept;
+
   // Static methods
 
   /**
@@ -169,6 +187,21 @@ private:
   static void messageHandler(QtMsgType type, const QMessageLogContext& context,
                              const QString& msg);
 
+  // Types
+  struct Message {
+    DebugLevel_t level;
+    QString      text;
+    bool         toStderr;
+    bool         toLogFile;
+  };
+
+  // Private Methods
+  void           writerLoop() noexcept;
+  void           write(const Message& message) noexcept;
+  void           flushStreams() noexcept;
+  static QString formatMessage(DebugLevel_t level, const QString& msg,
+                               const char* file, int line) noexcept;
+
   // General Attributes
   DebugLevel_t
       mDebugLevelStderr;  ///< the current debug level for the stderr output
@@ -177,7 +210,23 @@ private:
   QTextStream* mStderrStream;       ///< the stream to stderr
   FilePath     mLogFilepath;        ///< the filepath for the log file
   QFile*       mLogFile;            ///< NULL if file logging is disabled
-  QMutex       mMutex;              ///< for thread safety
+  QMutex       mMutex;              ///< protects the streams and the log file
+
+  // Asynchronous Writer
+  BoundedQueue<Message>    mQueue;           ///< messages to be written
+  QSemaphore               mQueueSemaphore;  ///< one resource per message
+  std::unique_ptr<QThread> mWriterThread;
+  std::atomic<bool>        mWriterRunning;  ///< false = write synchronously
+  std::atomic<bool>        mStopWriter;
+  std::atomic<qint64>      mEnqueuedCount;  ///< total number of queued
+  std::atomic<qint64>      mWrittenCount;   ///< total number of processed
+  std::atomic<int>         mDroppedCount;   ///< not yet reported drops
+  QMutex                   mFlushMutex;
+  QWaitCondition           mFlushCondition;  ///< woken if queue got empty
+
+  // Constants
+  static const int sQueueCapacity   = 8192;  ///< maximum queued messages
+  static const int sIdleFlushTimeMs = 1000;  ///< to report repetitions
 };
 
 /*******************************************************************************
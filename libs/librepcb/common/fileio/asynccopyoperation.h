@@ -66,6 +66,12 @@ signals:
   void failed(const QString& error);
   void finished();
 
+private:  // Types
+  struct CopyResult {
+    qint64  bytes;  ///< Total size of the copied files
+    QString error;  ///< Empty on success
+  };
+
 private:  // Methods
   void run() noexcept override;
 
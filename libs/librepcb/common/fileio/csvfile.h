@@ -53,6 +53,8 @@ class FilePath;
  *       #addValue()! This is needed to make sure all value rows have the same
  *       value count as the header.
  *
+ * @see ::librepcb::CsvStreamWriter to write large files without keeping all
+ *      rows in memory.
  * @see https://en.wikipedia.org/wiki/Comma-separated_values
  */
 class CsvFile final {
@@ -118,6 +120,15 @@ public:
    */
   QString toString() const noexcept;
 
+  /**
+   * @brief Write CSV file content to a QIODevice
+   *
+   * @param device  The device to write to (must be opened for writing).
+   *
+   * @throw ::librepcb::Exception if writing to the device failed.
+   */
+  void writeTo(QIODevice& device) const;
+
   /**
    * @brief Write CSV file content to a file
    *
@@ -130,11 +141,6 @@ public:
   // Operator Overloadings
   CsvFile& operator=(const CsvFile& rhs) = delete;
 
-private:  // Methods
-  QString        getCommentLines() const noexcept;
-  QString        lineToString(const QStringList& line) const noexcept;
-  static QString escapeValue(const QString& value) noexcept;
-
 private:  // Data
   QString            mComment;
   QStringList        mHeader;
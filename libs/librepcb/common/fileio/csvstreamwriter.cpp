@@ -0,0 +1,131 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "csvstreamwriter.h"
+
+#include "../exceptions.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+CsvStreamWriter::CsvStreamWriter(QIODevice& device) noexcept
+  : mDevice(device), mColumnCount(-1) {
+}
+
+CsvStreamWriter::~CsvStreamWriter() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void CsvStreamWriter::writeComment(const QString& comment) {
+  write(commentToString(comment));  // can throw
+}
+
+void CsvStreamWriter::writeHeader(const QStringList& header) {
+  mColumnCount = header.count();
+  write(lineToString(header, mColumnCount));  // can throw
+}
+
+void CsvStreamWriter::writeRow(const QStringList& row) {
+  if (row.count() != mColumnCount) {
+    throw LogicError(__FILE__, __LINE__,
+                     "CSV value count is different to header item count.");
+  }
+  write(lineToString(row, mColumnCount));  // can throw
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QString CsvStreamWriter::commentToString(const QString& comment) noexcept {
+  QString str;
+  if (!comment.isEmpty()) {
+    foreach (QString line, comment.split("\n", QString::KeepEmptyParts)) {
+      str += "# " % line;
+      while (str[str.count() - 1].isSpace()) {
+        str.chop(1);
+      }
+      str += "\n";
+    }
+    str += "\n";  // separate comment and CSV data with an empty line
+  }
+  return str;
+}
+
+QString CsvStreamWriter::lineToString(const QStringList& line,
+                                      int                count) noexcept {
+  QString str;
+  // Note: To guarantee equal value count on each line, we always use the
+  //       header to determine the value count. If a line contains more values,
+  //       they are ignored. If a line contains less values, empty strings will
+  //       be used instead.
+  for (int i = 0; i < count; ++i) {
+    str += escapeValue(line.value(i));
+    if (i < count - 1) {
+      str += ",";
+    } else {
+      str += "\n";
+    }
+  }
+  return str;
+}
+
+QString CsvStreamWriter::escapeValue(const QString& value) noexcept {
+  QString escaped = value;
+  escaped.remove("\r");        // remove DOS line endings, if any
+  escaped.replace("\n", " ");  // replace linebreaks by spaces
+  if (escaped.contains(",") || escaped.contains("\"")) {
+    escaped.replace("\"", "\"\"");    // escape quotes
+    escaped = "\"" + escaped + "\"";  // add quotes around value
+  }
+  return escaped;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CsvStreamWriter::write(const QString& str) {
+  QByteArray data = str.toUtf8();
+  if (mDevice.write(data) != data.size()) {
+    throw RuntimeError(
+        __FILE__, __LINE__,
+        tr("Failed to write CSV data: %1").arg(mDevice.errorString()));
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
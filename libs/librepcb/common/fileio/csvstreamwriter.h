@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CSVSTREAMWRITER_H
+#define LIBREPCB_CSVSTREAMWRITER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class CsvStreamWriter
+ ******************************************************************************/
+
+/**
+ * @brief Writes comma-separated values (CSV) row by row to a QIODevice
+ *
+ * In contrast to ::librepcb::CsvFile, no rows are kept in memory, i.e. each
+ * row is written to the device immediately. The output is exactly the same
+ * as produced by ::librepcb::CsvFile, with the same guarantees regarding
+ * escaping and value count.
+ *
+ * @note #writeComment() (optional) and #writeHeader() must be called before
+ *       writing any rows with #writeRow().
+ */
+class CsvStreamWriter final {
+  Q_DECLARE_TR_FUNCTIONS(CsvStreamWriter)
+
+public:
+  // Constructors / Destructor
+  CsvStreamWriter()                             = delete;
+  CsvStreamWriter(const CsvStreamWriter& other) = delete;
+  explicit CsvStreamWriter(QIODevice& device) noexcept;
+  ~CsvStreamWriter() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Write a file comment
+   *
+   * @param comment   The comment to write. May contain linebreaks. If empty,
+   *                  nothing is written.
+   *
+   * @throw ::librepcb::Exception if writing to the device failed.
+   */
+  void writeComment(const QString& comment);
+
+  /**
+   * @brief Write the header items
+   *
+   * @param header  The header items. Determines the value count of all rows.
+   *
+   * @throw ::librepcb::Exception if writing to the device failed.
+   */
+  void writeHeader(const QStringList& header);
+
+  /**
+   * @brief Write a row of values
+   *
+   * @param row   The value row items.
+   *
+   * @throw ::librepcb::Exception if the value item count is different to the
+   *        header item count, or if writing to the device failed.
+   */
+  void writeRow(const QStringList& row);
+
+  // Static Methods
+  static QString commentToString(const QString& comment) noexcept;
+  static QString lineToString(const QStringList& line, int count) noexcept;
+  static QString escapeValue(const QString& value) noexcept;
+
+  // Operator Overloadings
+  CsvStreamWriter& operator=(const CsvStreamWriter& rhs) = delete;
+
+private:  // Methods
+  void write(const QString& str);
+
+private:  // Data
+  QIODevice& mDevice;
+  int        mColumnCount;  ///< -1 as long as no header was written
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CSVSTREAMWRITER_H
@@ -27,6 +27,8 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -76,6 +78,22 @@ public:
    */
   static void writeFile(const FilePath& filepath, const QByteArray& content);
 
+  /**
+   * @brief Write a file by streaming its content into it
+   *
+   * Same as #writeFile(const FilePath&, const QByteArray&), but the content
+   * is written by a callback instead of being passed as a whole. This allows
+   * writing large files without keeping their whole content in memory. The
+   * file is replaced atomically only if the callback did not throw.
+   *
+   * @param filepath      The file to (over)write
+   * @param writer        Callback writing the content into the passed device
+   *
+   * @throws Exception    If an error occurs (incl. exceptions of the writer).
+   */
+  static void writeFile(const FilePath&                        filepath,
+                        const std::function<void(QIODevice&)>& writer);
+
   /**
    * @brief Copy a single file
    *
@@ -53,7 +53,7 @@ namespace librepcb {
  *   librepcb::SExpression.
  * - Iterators (for example to use in C++11 range based for loops).
  * - Methods to find elements by UUID and/or name (if supported by template type
- *   `T`).
+ *   `T`). For larger lists, these lookups use a lazily built hash index.
  * - Method #sortedByUuid() to create a copy of the list with elements sorted by
  *   UUID.
  * - Signals to get notified about added, removed and modified elements.
@@ -201,28 +201,15 @@ public:
 
   // Element Query
   int indexOf(const T* obj) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i].get() == obj) {
-        return i;
-      }
-    }
-    return -1;
+    return lookup(mPointerIndex, obj, [](const T& obj) { return &obj; });
   }
   int indexOf(const Uuid& key) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i]->getUuid() == key) {
-        return i;
-      }
-    }
-    return -1;
+    return lookup(mUuidIndex, key,
+                  [](const T& obj) { return obj.getUuid(); });
   }
   int indexOf(const QString& name) const noexcept {
-    for (int i = 0; i < count(); ++i) {
-      if (mObjects[i]->getName() == name) {
-        return i;
-      }
-    }
-    return -1;
+    return lookup(mNameIndex, name,
+                  [](const T& obj) { return nameToString(obj.getName()); });
   }
   bool contains(int index) const noexcept {
     return index >= 0 && index < mObjects.count();
@@ -412,19 +399,41 @@ public:
     return *this;
   }
 
+protected:  // Types
+  template <typename K>
+  struct KeyIndex {
+    QHash<K, int> hash;
+    int           indexedCount = 0;  ///< Number of elements contained in hash
+
+    void clear() noexcept {
+      if (indexedCount > 0) {
+        hash.clear();
+        indexedCount = 0;
+      }
+    }
+  };
+
 protected:  // Methods
   void insertElement(int index, const std::shared_ptr<T>& obj) noexcept {
+    if (index < mObjects.count()) {
+      invalidateIndices();  // appended elements are indexed lazily
+    }
     mObjects.insert(index, obj);
     obj->onEdited.attach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementAdded);
   }
   std::shared_ptr<T> takeElement(int index) noexcept {
+    invalidateIndices();
     std::shared_ptr<T> obj = mObjects.takeAt(index);
     obj->onEdited.detach(mOnEditedSlot);
     onEdited.notify(index, obj, Event::ElementRemoved);
     return obj;
   }
   void elementEditedHandler(const T& obj, OnEditedArgs... args) noexcept {
+    // The UUID or name might have been changed, but not the pointer. So
+    // bulk modifications of many elements (e.g. moving thousands of pads)
+    // don't need to scan the whole list for each element.
+    invalidateKeyIndices();
     int index = indexOf(&obj);
     if (contains(index)) {
       onElementEdited.notify(index, at(index), args...);
@@ -434,6 +443,62 @@ protected:  // Methods
                      "unknown element!";
     }
   }
+
+  /**
+   * @brief Get the index of the first element with a given key
+   *
+   * Small lists are scanned linearly. For larger lists, a hash index is
+   * built on the first lookup and extended by elements appended later. Any
+   * other modification of the list (or of its elements, except for
+   * #mPointerIndex) invalidates it.
+   *
+   * @param index   The index to use (#mPointerIndex, #mUuidIndex or
+   *                #mNameIndex)
+   * @param key     The key to look for
+   * @param getKey  Functor returning the key of an element
+   *
+   * @return Index of the element or -1 if not found
+   */
+  template <typename K, typename F>
+  int lookup(KeyIndex<K>& index, const K& key, F getKey) const noexcept {
+    if (mObjects.count() < sMinIndexedCount) {
+      for (int i = 0; i < mObjects.count(); ++i) {
+        if (getKey(*mObjects[i]) == key) {
+          return i;
+        }
+      }
+      return -1;
+    }
+    QMutexLocker lock(&mIndexMutex);  // const lookups may run in parallel
+    if (index.indexedCount == 0) {
+      index.hash.reserve(mObjects.count());
+    }
+    for (; index.indexedCount < mObjects.count(); ++index.indexedCount) {
+      const K k = getKey(*mObjects[index.indexedCount]);
+      if (!index.hash.contains(k)) {  // the first element wins
+        index.hash.insert(k, index.indexedCount);
+      }
+    }
+    return index.hash.value(key, -1);
+  }
+  void invalidateIndices() noexcept {
+    QMutexLocker lock(&mIndexMutex);
+    mPointerIndex.clear();
+    mUuidIndex.clear();
+    mNameIndex.clear();
+  }
+  void invalidateKeyIndices() noexcept {
+    QMutexLocker lock(&mIndexMutex);
+    mUuidIndex.clear();
+    mNameIndex.clear();
+  }
+  static const QString& nameToString(const QString& name) noexcept {
+    return name;
+  }
+  template <typename N>
+  static const QString& nameToString(const N& name) noexcept {
+    return *name;  // constrained string types like librepcb::ElementName
+  }
   void throwKeyNotFoundException(const Uuid& key) const {
     throw RuntimeError(
         __FILE__, __LINE__,
@@ -456,6 +521,13 @@ protected:  // Methods
 protected:  // Data
   QVector<std::shared_ptr<T>> mObjects;
   Slot<T, OnEditedArgs...>    mOnEditedSlot;
+
+  // Lookup indices, see lookup()
+  mutable KeyIndex<const T*> mPointerIndex;
+  mutable KeyIndex<Uuid>     mUuidIndex;
+  mutable KeyIndex<QString>  mNameIndex;
+  mutable QMutex             mIndexMutex;
+  static const int           sMinIndexedCount = 16;  ///< Scan smaller lists
 };
 
 }  // namespace librepcb
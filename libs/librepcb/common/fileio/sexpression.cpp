@@ -22,15 +22,60 @@
  ******************************************************************************/
 #include "sexpression.h"
 
+#include "../tracer.h"
+
 #include <sexpresso/sexpresso.hpp>
 
 #include <QtCore>
 
+#include <atomic>
+#include <mutex>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 
+/*******************************************************************************
+ *  Struct LazyChildren
+ ******************************************************************************/
+
+/**
+ * @brief Not yet parsed children of a list, shared by all copies of the list
+ *
+ * Refers to a byte range of the whole (implicitly shared) file content, whose
+ * syntax was already validated by SExpression::parse(). The children are
+ * parsed only once, even if several threads access them at the same time.
+ */
+struct SExpression::LazyChildren {
+  QByteArray           content;  ///< whole file, released after parsing
+  int                  begin;    ///< index of the first child
+  FilePath             filePath;
+  std::once_flag       onceFlag;
+  std::atomic<bool>    parsed;
+  QVector<SExpression> children;
+
+  LazyChildren(const QByteArray& c, int b, const FilePath& fp) noexcept
+    : content(c), begin(b), filePath(fp), parsed(false) {}
+
+  const QVector<SExpression>& get() noexcept {
+    std::call_once(onceFlag, [this]() {
+      try {
+        QHash<QByteArray, QString> strings;
+        int                        index = begin;
+        parseChildren(content, index, begin, filePath, strings, children,
+                      false);
+      } catch (const Exception& e) {
+        // cannot happen since the content was already validated in parse()
+        qCritical() << "Failed to parse S-Expression:" << e.getMsg();
+      }
+      content = QByteArray();  // not needed anymore
+      parsed  = true;
+    });
+    return children;
+  }
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -46,33 +91,10 @@ SExpression::SExpression(const SExpression& other) noexcept
   : mType(other.mType),
     mValue(other.mValue),
     mChildren(other.mChildren),
+    mLazyChildren(other.mLazyChildren),
     mFilePath(other.mFilePath) {
 }
 
-SExpression::SExpression(sexpresso::Sexp& sexp, const FilePath& filePath)
-  : mType(Type::List), mValue(), mFilePath(filePath) {
-  if (sexp.childCount() < 1) {
-    throw RuntimeError(__FILE__, __LINE__);
-  }
-
-  if (sexp.isSexp()) {
-    sexpresso::Sexp& first = sexp.getChild(0);
-    if (!first.isString()) {
-      throw RuntimeError(__FILE__, __LINE__);
-    }
-    mValue = QString::fromStdString(first.getString());
-    for (auto&& arg : sexp.arguments()) {
-      mChildren.append(SExpression(arg, filePath));
-    }
-  } else if (sexp.isString()) {
-    mValue = QString::fromStdString(sexp.getString());
-    mType  = Type::String;
-  } else {
-    throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
-                         tr("Unknown node type."));
-  }
-}
-
 SExpression::~SExpression() noexcept {
 }
 
@@ -81,7 +103,7 @@ SExpression::~SExpression() noexcept {
  ******************************************************************************/
 
 bool SExpression::isMultiLineList() const noexcept {
-  foreach (const SExpression& child, mChildren) {
+  foreach (const SExpression& child, getChildren()) {
     if (child.isLineBreak() || (child.isMultiLineList())) {
       return true;
     }
@@ -110,10 +132,10 @@ const QString& SExpression::getStringOrToken(bool throwIfEmpty) const {
   return mValue;
 }
 
-QList<SExpression> SExpression::getChildren(const QString& name) const
+QVector<SExpression> SExpression::getChildren(const QString& name) const
     noexcept {
-  QList<SExpression> children;
-  foreach (const SExpression& child, mChildren) {
+  QVector<SExpression> children;
+  foreach (const SExpression& child, getChildren()) {
     if (child.isList() && (child.mValue == name)) {
       children.append(child);
     }
@@ -122,11 +144,11 @@ QList<SExpression> SExpression::getChildren(const QString& name) const
 }
 
 const SExpression& SExpression::getChildByIndex(int index) const {
-  if ((index < 0) || index >= mChildren.count()) {
+  if ((index < 0) || index >= getChildren().count()) {
     throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
                          tr("Child not found: %1").arg(index));
   }
-  return mChildren.at(index);
+  return getChildren().at(index);
 }
 
 const SExpression* SExpression::tryGetChildByPath(const QString& path) const
@@ -134,7 +156,7 @@ const SExpression* SExpression::tryGetChildByPath(const QString& path) const
   const SExpression* child = this;
   foreach (const QString& name, path.split('/')) {
     bool found = false;
-    foreach (const SExpression& childchild, child->mChildren) {
+    foreach (const SExpression& childchild, child->getChildren()) {
       if (childchild.isList() && (childchild.mValue == name)) {
         child = &childchild;
         found = true;
@@ -162,6 +184,7 @@ const SExpression& SExpression::getChildByPath(const QString& path) const {
  ******************************************************************************/
 
 SExpression& SExpression::appendLineBreak() {
+  detachLazyChildren();
   mChildren.append(createLineBreak());
   return *this;
 }
@@ -174,6 +197,7 @@ SExpression& SExpression::appendChild(const SExpression& child,
                                       bool               linebreak) {
   if (mType == Type::List) {
     if (linebreak) appendLineBreak();
+    detachLazyChildren();
     mChildren.append(child);
     return mChildren.last();
   } else {
@@ -182,6 +206,7 @@ SExpression& SExpression::appendChild(const SExpression& child,
 }
 
 void SExpression::removeLineBreaks() noexcept {
+  detachLazyChildren();
   for (int i = mChildren.count() - 1; i >= 0; --i) {
     if (mChildren.at(i).isLineBreak()) {
       mChildren.removeAt(i);
@@ -190,9 +215,24 @@ void SExpression::removeLineBreaks() noexcept {
 }
 
 QByteArray SExpression::toByteArray() const {
-  QString str = toString(0);  // can throw
-  str += '\n';                // newline at end of file
-  return str.toUtf8();
+  QByteArray output;
+  output.reserve(4096);
+  serialize(output, 0);  // can throw
+  output.append('\n');   // newline at end of file
+  return output;
+}
+
+qint64 SExpression::getMemoryUsage() const noexcept {
+  qint64 size = sizeof(SExpression) + mValue.capacity() * sizeof(QChar);
+  if (mLazyChildren && (!mLazyChildren->parsed)) {
+    return size;  // the file content is not owned by this node
+  }
+  const QVector<SExpression>& children = getChildren();
+  size += (children.capacity() - children.count()) * sizeof(SExpression);
+  foreach (const SExpression& child, children) {
+    size += child.getMemoryUsage();
+  }
+  return size;
 }
 
 /*******************************************************************************
@@ -200,10 +240,11 @@ QByteArray SExpression::toByteArray() const {
  ******************************************************************************/
 
 SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
-  mType     = rhs.mType;
-  mValue    = rhs.mValue;
-  mChildren = rhs.mChildren;
-  mFilePath = rhs.mFilePath;
+  mType         = rhs.mType;
+  mValue        = rhs.mValue;
+  mChildren     = rhs.mChildren;
+  mLazyChildren = rhs.mLazyChildren;
+  mFilePath     = rhs.mFilePath;
   return *this;
 }
 
@@ -211,62 +252,396 @@ SExpression& SExpression::operator=(const SExpression& rhs) noexcept {
  *  Private Methods
  ******************************************************************************/
 
-QString SExpression::escapeString(const QString& string) const noexcept {
-  return QString::fromStdString(sexpresso::escape(string.toStdString()));
+void SExpression::escapeString(const QString& string,
+                               QByteArray&    output) const noexcept {
+  const QByteArray utf8 = string.toUtf8();
+  // Most strings do not contain any characters which need to be escaped, so
+  // append them directly without the detour over std::string.
+  bool needsEscaping = false;
+  foreach (char c, utf8) {
+    if ((uchar(c) < 0x20) || (c == 0x7F) || (c == '"') || (c == '\\') ||
+        (c == '\'') || (c == '?')) {
+      needsEscaping = true;
+      break;
+    }
+  }
+  if (needsEscaping) {
+    std::string escaped =
+        sexpresso::escape(std::string(utf8.constData(), utf8.size()));
+    output.append(escaped.data(), int(escaped.size()));
+  } else {
+    output.append(utf8);
+  }
 }
 
 bool SExpression::isValidListName(const QString& name) const noexcept {
-  return QRegExp("[a-z][a-z0-9_]*").exactMatch(name);
+  // same as the regex "[a-z][a-z0-9_]*", but much faster
+  if (name.isEmpty() || (name.at(0) < 'a') || (name.at(0) > 'z')) {
+    return false;
+  }
+  foreach (const QChar& c, name) {
+    if (!(((c >= 'a') && (c <= 'z')) || ((c >= '0') && (c <= '9')) ||
+          (c == '_'))) {
+      return false;
+    }
+  }
+  return true;
 }
 
 bool SExpression::isValidToken(const QString& token) const noexcept {
-  return QRegExp("[a-zA-Z0-9\\.:_-]+").exactMatch(token);
+  // same as the regex "[a-zA-Z0-9\\.:_-]+", but much faster
+  if (token.isEmpty()) {
+    return false;
+  }
+  foreach (const QChar& c, token) {
+    if (!(((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')) ||
+          ((c >= '0') && (c <= '9')) || (c == '.') || (c == ':') ||
+          (c == '_') || (c == '-'))) {
+      return false;
+    }
+  }
+  return true;
 }
 
-QString SExpression::toString(int indent) const {
+bool SExpression::serialize(QByteArray& output, int indent) const {
+  // Note: Returns whether the node spans multiple lines, which is needed to
+  // determine the indentation of the closing parenthesis of parent lists.
   if (mType == Type::List) {
     if (!isValidListName(mValue)) {
       throw LogicError(__FILE__, __LINE__,
                        tr("Invalid S-Expression list name: %1").arg(mValue));
     }
-    QString str = '(' + mValue;
-    for (int i = 0; i < mChildren.count(); ++i) {
-      const SExpression& child = mChildren.at(i);
-      if ((!str.at(str.length() - 1).isSpace()) && (!child.isLineBreak())) {
-        str += ' ';
+    const QVector<SExpression>& children    = getChildren();
+    bool                        isMultiLine = false;
+    output.append('(');
+    output.append(mValue.toUtf8());
+    for (int i = 0; i < children.count(); ++i) {
+      const SExpression& child = children.at(i);
+      const char         last  = output.at(output.size() - 1);
+      if ((last != ' ') && (last != '\n') && (!child.isLineBreak())) {
+        output.append(' ');
       }
-      bool nextChildIsLineBreak = (i < mChildren.count() - 1)
-                                      ? mChildren.at(i + 1).isLineBreak()
+      bool nextChildIsLineBreak = (i < children.count() - 1)
+                                      ? children.at(i + 1).isLineBreak()
                                       : true;
+      if (child.isLineBreak()) {
+        isMultiLine = true;
+      }
       if (child.isLineBreak() && nextChildIsLineBreak) {
-        if ((i > 0) && mChildren.at(i - 1).isLineBreak()) {
+        if ((i > 0) && children.at(i - 1).isLineBreak()) {
           // too many line breaks ;)
         } else {
-          str += '\n';
+          output.append('\n');
         }
-      } else {
-        str += child.toString(indent + 1);
+      } else if (child.serialize(output, indent + 1)) {
+        isMultiLine = true;
       }
     }
-    if (isMultiLineList()) {
-      str += '\n' + QString(' ').repeated(indent);
+    if (isMultiLine) {
+      output.append('\n');
+      output.append(QByteArray(indent, ' '));
     }
-    return str + ')';
+    output.append(')');
+    return isMultiLine;
   } else if (mType == Type::Token) {
     if (!isValidToken(mValue)) {
       throw LogicError(__FILE__, __LINE__,
                        tr("Invalid S-Expression token: %1").arg(mValue));
     }
-    return mValue;
+    output.append(mValue.toUtf8());
+    return false;
   } else if (mType == Type::String) {
-    return '"' + escapeString(mValue) + '"';
+    output.append('"');
+    escapeString(mValue, output);
+    output.append('"');
+    return false;
   } else if (mType == Type::LineBreak) {
-    return '\n' + QString(' ').repeated(indent);
+    output.append('\n');
+    output.append(QByteArray(indent, ' '));
+    return false;
   } else {
     throw LogicError(__FILE__, __LINE__);
   }
 }
 
+const QVector<SExpression>& SExpression::getLazyChildren() const noexcept {
+  return mLazyChildren->get();
+}
+
+void SExpression::detachLazyChildren() noexcept {
+  if (mLazyChildren) {
+    mChildren = mLazyChildren->get();
+    mLazyChildren.reset();
+  }
+}
+
+SExpression SExpression::parseNode(const QByteArray& content, int& index,
+                                   const FilePath&             filePath,
+                                   QHash<QByteArray, QString>& strings) {
+  switch (content.at(index)) {
+    case '(':
+      return parseList(content, index, filePath, strings, false);
+    case ')':
+      throw parseError(__FILE__, __LINE__, content, index, filePath,
+                       tr("Unexpected closing parenthesis."));
+    case '"':
+      return parseString(content, index, filePath);
+    default:
+      return parseToken(content, index, filePath, strings);
+  }
+}
+
+SExpression SExpression::parseList(const QByteArray& content, int& index,
+                                   const FilePath&             filePath,
+                                   QHash<QByteArray, QString>& strings,
+                                   bool                        lazy) {
+  const int   start = index;
+  SExpression list  = parseListName(content, index, filePath, strings);
+  parseChildren(content, index, start, filePath, strings, list.mChildren,
+                lazy);
+  return list;
+}
+
+SExpression SExpression::parseListName(const QByteArray& content, int& index,
+                                       const FilePath&             filePath,
+                                       QHash<QByteArray, QString>& strings) {
+  const int start = index;
+  ++index;  // skip '('
+  skipWhitespaceAndComments(content, index);
+  if ((index >= content.size()) || (content.at(index) == '(') ||
+      (content.at(index) == ')') || (content.at(index) == '"')) {
+    throw parseError(__FILE__, __LINE__, content, start, filePath,
+                     tr("List does not have a name."));
+  }
+  SExpression list = parseToken(content, index, filePath, strings);
+  list.mType       = Type::List;
+  return list;
+}
+
+void SExpression::parseChildren(const QByteArray& content, int& index,
+                                int start, const FilePath& filePath,
+                                QHash<QByteArray, QString>& strings,
+                                QVector<SExpression>& children, bool lazy) {
+  while (true) {
+    skipWhitespaceAndComments(content, index);
+    if (index >= content.size()) {
+      throw parseError(__FILE__, __LINE__, content, start, filePath,
+                       tr("List is not closed."));
+    } else if (content.at(index) == ')') {
+      ++index;  // skip ')'
+      return;
+    } else if (lazy && (content.at(index) == '(')) {
+      // Only validate the syntax of the child list for now, and parse its
+      // children when they are accessed the first time. They refer to the
+      // content instead of copying it, and the validation does not allocate
+      // any nodes, so this is faster than parsing the list immediately.
+      const int   childStart = index;
+      SExpression child      = parseListName(content, index, filePath, strings);
+      child.mLazyChildren =
+          std::make_shared<LazyChildren>(content, index, filePath);
+      skipChildren(content, index, childStart, filePath);
+      children.append(child);
+    } else {
+      children.append(parseNode(content, index, filePath, strings));
+    }
+  }
+}
+
+void SExpression::skipList(const QByteArray& content, int& index,
+                           const FilePath& filePath) {
+  // Note: Must perform exactly the same checks as parseList(), so that
+  // parsing the skipped content later cannot fail.
+  const int start = index;
+  ++index;  // skip '('
+  skipWhitespaceAndComments(content, index);
+  if ((index >= content.size()) || (content.at(index) == '(') ||
+      (content.at(index) == ')') || (content.at(index) == '"')) {
+    throw parseError(__FILE__, __LINE__, content, start, filePath,
+                     tr("List does not have a name."));
+  }
+  skipToken(content, index);
+  skipChildren(content, index, start, filePath);
+}
+
+void SExpression::skipChildren(const QByteArray& content, int& index,
+                               int start, const FilePath& filePath) {
+  while (true) {
+    skipWhitespaceAndComments(content, index);
+    if (index >= content.size()) {
+      throw parseError(__FILE__, __LINE__, content, start, filePath,
+                       tr("List is not closed."));
+    } else if (content.at(index) == ')') {
+      ++index;  // skip ')'
+      return;
+    } else if (content.at(index) == '(') {
+      skipList(content, index, filePath);
+    } else if (content.at(index) == '"') {
+      skipString(content, index, filePath);
+    } else {
+      skipToken(content, index);
+    }
+  }
+}
+
+void SExpression::skipString(const QByteArray& content, int& index,
+                             const FilePath& filePath) {
+  // Note: Must perform exactly the same checks as parseString().
+  static const QByteArray escapeChars("'\"?\\abfnrtv");
+  const int               start = index;
+  ++index;  // skip '"'
+  while (true) {
+    if (index >= content.size()) {
+      throw parseError(__FILE__, __LINE__, content, start, filePath,
+                       tr("String is not terminated."));
+    }
+    const char c = content.at(index);
+    if (c == '"') {
+      break;
+    } else if (c == '\\') {
+      ++index;  // skip '\'
+      if (index >= content.size()) {
+        throw parseError(__FILE__, __LINE__, content, start, filePath,
+                         tr("String is not terminated."));
+      }
+      if (!escapeChars.contains(content.at(index))) {
+        throw parseError(__FILE__, __LINE__, content, index, filePath,
+                         tr("Invalid escape sequence."));
+      }
+    }
+    ++index;
+  }
+  ++index;  // skip '"'
+}
+
+void SExpression::skipToken(const QByteArray& content, int& index) noexcept {
+  while ((index < content.size()) && (!isWhitespace(content.at(index))) &&
+         (content.at(index) != '(') && (content.at(index) != ')')) {
+    ++index;
+  }
+}
+
+SExpression SExpression::parseToken(const QByteArray& content, int& index,
+                                    const FilePath&             filePath,
+                                    QHash<QByteArray, QString>& strings) {
+  const int start = index;
+  skipToken(content, index);
+  const char* data   = content.constData() + start;
+  const int   length = index - start;
+  SExpression token(Type::Token, QString());
+  token.mFilePath = filePath;
+  if (length <= sMaxInternedTokenLength) {
+    // List names and short tokens (e.g. layer names or numbers) are repeated
+    // very often, so all nodes share the same implicitly shared string
+    // instead of allocating their own copy. Long tokens (like UUIDs) are
+    // mostly unique, so interning them would not save any memory.
+    const QByteArray key = QByteArray::fromRawData(data, length);
+    auto             it  = strings.constFind(key);
+    if (it == strings.constEnd()) {
+      it = strings.insert(QByteArray(data, length),
+                          QString::fromUtf8(data, length));
+    }
+    token.mValue = it.value();
+  } else {
+    token.mValue = QString::fromUtf8(data, length);
+  }
+  return token;
+}
+
+SExpression SExpression::parseString(const QByteArray& content, int& index,
+                                     const FilePath& filePath) {
+  const int start = index;
+  ++index;  // skip '"'
+  // Most strings do not contain escape sequences, so they are converted
+  // directly from the content. Only otherwise a temporary buffer is needed.
+  QByteArray unescaped;
+  bool       hasEscapeSequences = false;
+  int        chunkStart         = index;
+  while (true) {
+    if (index >= content.size()) {
+      throw parseError(__FILE__, __LINE__, content, start, filePath,
+                       tr("String is not terminated."));
+    }
+    const char c = content.at(index);
+    if (c == '"') {
+      break;
+    } else if (c == '\\') {
+      unescaped.append(content.constData() + chunkStart, index - chunkStart);
+      hasEscapeSequences = true;
+      ++index;  // skip '\'
+      if (index >= content.size()) {
+        throw parseError(__FILE__, __LINE__, content, start, filePath,
+                         tr("String is not terminated."));
+      }
+      static const QByteArray escapeChars("'\"?\\abfnrtv");
+      static const QByteArray escapeValues("'\"?\\\a\b\f\n\r\t\v");
+      const int escapeIndex = escapeChars.indexOf(content.at(index));
+      if (escapeIndex < 0) {
+        throw parseError(__FILE__, __LINE__, content, index, filePath,
+                         tr("Invalid escape sequence."));
+      }
+      unescaped.append(escapeValues.at(escapeIndex));
+      chunkStart = index + 1;
+    }
+    ++index;
+  }
+  QString value;
+  if (hasEscapeSequences) {
+    unescaped.append(content.constData() + chunkStart, index - chunkStart);
+    value = QString::fromUtf8(unescaped);
+  } else {
+    value = QString::fromUtf8(content.constData() + chunkStart,
+                              index - chunkStart);
+  }
+  ++index;  // skip '"'
+  SExpression string(Type::String, value);
+  string.mFilePath = filePath;
+  return string;
+}
+
+void SExpression::skipWhitespaceAndComments(const QByteArray& content,
+                                            int&              index) noexcept {
+  while (index < content.size()) {
+    const char c = content.at(index);
+    if (isWhitespace(c)) {
+      ++index;
+    } else if (c == ';') {
+      // comment until the end of the line
+      while ((index < content.size()) && (content.at(index) != '\n')) {
+        ++index;
+      }
+    } else {
+      break;
+    }
+  }
+}
+
+bool SExpression::isWhitespace(char c) noexcept {
+  return (c == ' ') || (c == '\n') || (c == '\r') || (c == '\t') ||
+         (c == '\v') || (c == '\f');
+}
+
+FileParseError SExpression::parseError(const char* file, int line,
+                                       const QByteArray& content, int index,
+                                       const FilePath& filePath,
+                                       const QString&  msg) noexcept {
+  // Determine the position only in case of an error to keep parsing fast.
+  int fileLine   = 1;
+  int fileColumn = 1;
+  for (int i = 0; i < qMin(index, content.size()); ++i) {
+    if (content.at(i) == '\n') {
+      ++fileLine;
+      fileColumn = 1;
+    } else {
+      ++fileColumn;
+    }
+  }
+  int end = content.indexOf('\n', index);
+  if (end < 0) end = content.size();
+  QString invalidContent = QString::fromUtf8(content.mid(index, end - index));
+  return FileParseError(file, line, filePath, fileLine, fileColumn,
+                        invalidContent.left(100), msg);
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -289,20 +664,26 @@ SExpression SExpression::createLineBreak() {
 
 SExpression SExpression::parse(const QByteArray& content,
                                const FilePath&   filePath) {
-  std::string     error;
-  QString         str  = QString::fromUtf8(content);
-  sexpresso::Sexp tree = sexpresso::parse(str.toStdString(), error);
-  if (error.empty()) {
-    if (tree.childCount() == 1) {
-      return SExpression(tree.getChild(0), filePath);
-    } else {
-      throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                           tr("File does not have exactly one root node."));
-    }
+  LIBREPCB_TRACE_SCOPE("fileio", "SExpression::parse");
+  QHash<QByteArray, QString> strings;  // interned strings, see parseToken()
+  int                        index = 0;
+  skipWhitespaceAndComments(content, index);
+  if (index >= content.size()) {
+    throw parseError(__FILE__, __LINE__, content, index, filePath,
+                     tr("File does not have exactly one root node."));
+  }
+  SExpression root;
+  if (content.at(index) == '(') {
+    root = parseList(content, index, filePath, strings, true);  // lazy
   } else {
-    throw FileParseError(__FILE__, __LINE__, filePath, -1, -1, QString(),
-                         QString::fromStdString(error));
+    root = parseNode(content, index, filePath, strings);
+  }
+  skipWhitespaceAndComments(content, index);
+  if (index < content.size()) {
+    throw parseError(__FILE__, __LINE__, content, index, filePath,
+                     tr("File does not have exactly one root node."));
   }
+  return root;
 }
 
 /*******************************************************************************
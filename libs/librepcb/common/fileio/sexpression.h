@@ -29,13 +29,11 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
-namespace sexpresso {
-struct Sexp;
-}
-
 namespace librepcb {
 
 class SExpression;
@@ -53,6 +51,12 @@ T deserializeFromSExpression(const SExpression& sexpr,
 
 /**
  * @brief The SExpression class
+ *
+ * @note When parsing a file with #parse(), the children of lists in the root
+ *       node are parsed lazily: Their syntax is validated immediately, but the
+ *       nodes are only created when they are accessed the first time. They
+ *       are parsed only once and shared by all copies of the list, also if
+ *       they are accessed from multiple threads at the same time.
  */
 class SExpression final {
   Q_DECLARE_TR_FUNCTIONS(SExpression)
@@ -79,11 +83,13 @@ public:
   bool            isString() const noexcept { return mType == Type::String; }
   bool isLineBreak() const noexcept { return mType == Type::LineBreak; }
   bool isMultiLineList() const noexcept;
-  const QString&            getName() const;
-  const QString&            getStringOrToken(bool throwIfEmpty = false) const;
-  const QList<SExpression>& getChildren() const { return mChildren; }
-  QList<SExpression>        getChildren(const QString& name) const noexcept;
-  const SExpression&        getChildByIndex(int index) const;
+  const QString&              getName() const;
+  const QString&              getStringOrToken(bool throwIfEmpty = false) const;
+  const QVector<SExpression>& getChildren() const {
+    return mLazyChildren ? getLazyChildren() : mChildren;
+  }
+  QVector<SExpression>        getChildren(const QString& name) const noexcept;
+  const SExpression&          getChildByIndex(int index) const;
   const SExpression* tryGetChildByPath(const QString& path) const noexcept;
   const SExpression& getChildByPath(const QString& path) const;
 
@@ -105,11 +111,11 @@ public:
 
   template <typename T>
   T getValueOfFirstChild(bool throwIfEmpty = false) const {
-    if (mChildren.count() < 1) {
+    if (getChildren().count() < 1) {
       throw FileParseError(__FILE__, __LINE__, mFilePath, -1, -1, QString(),
                            tr("Node does not have children."));
     }
-    return mChildren.at(0).getValue<T>(throwIfEmpty);
+    return getChildren().at(0).getValue<T>(throwIfEmpty);
   }
 
   // General Methods
@@ -128,6 +134,17 @@ public:
   void       removeLineBreaks() noexcept;
   QByteArray toByteArray() const;
 
+  /**
+   * @brief Estimate the heap memory occupied by this node and its children
+   *
+   * Children which are not parsed yet are not parsed by this method, their
+   * unparsed source is counted instead. Implicitly shared data is counted
+   * for each node, so the estimation may be a bit too high.
+   *
+   * @return Estimated size in bytes (including `sizeof(SExpression)`)
+   */
+  qint64 getMemoryUsage() const noexcept;
+
   // Operator Overloadings
   SExpression& operator=(const SExpression& rhs) noexcept;
 
@@ -140,18 +157,61 @@ public:
 
 private:  // Methods
   SExpression(Type type, const QString& value);
-  SExpression(sexpresso::Sexp& sexp, const FilePath& filePath);
 
-  QString escapeString(const QString& string) const noexcept;
-  bool    isValidListName(const QString& name) const noexcept;
-  bool    isValidToken(const QString& token) const noexcept;
-  QString toString(int indent) const;
+  void escapeString(const QString& string, QByteArray& output) const noexcept;
+  bool isValidListName(const QString& name) const noexcept;
+  bool isValidToken(const QString& token) const noexcept;
+  bool serialize(QByteArray& output, int indent) const;
+  const QVector<SExpression>& getLazyChildren() const noexcept;
+  void                        detachLazyChildren() noexcept;
+
+  // Parser Methods (all operating directly on the UTF-8 encoded content)
+  static SExpression parseNode(const QByteArray& content, int& index,
+                               const FilePath&             filePath,
+                               QHash<QByteArray, QString>& strings);
+  static SExpression parseList(const QByteArray& content, int& index,
+                               const FilePath&             filePath,
+                               QHash<QByteArray, QString>& strings,
+                               bool                        lazy);
+  static SExpression parseListName(const QByteArray& content, int& index,
+                                   const FilePath&             filePath,
+                                   QHash<QByteArray, QString>& strings);
+  static void        parseChildren(const QByteArray& content, int& index,
+                                   int start, const FilePath& filePath,
+                                   QHash<QByteArray, QString>& strings,
+                                   QVector<SExpression>& children, bool lazy);
+  static SExpression parseToken(const QByteArray& content, int& index,
+                                const FilePath&             filePath,
+                                QHash<QByteArray, QString>& strings);
+  static SExpression parseString(const QByteArray& content, int& index,
+                                 const FilePath& filePath);
+  static void        skipList(const QByteArray& content, int& index,
+                              const FilePath& filePath);
+  static void        skipChildren(const QByteArray& content, int& index,
+                                  int start, const FilePath& filePath);
+  static void        skipString(const QByteArray& content, int& index,
+                                const FilePath& filePath);
+  static void skipToken(const QByteArray& content, int& index) noexcept;
+  static void skipWhitespaceAndComments(const QByteArray& content,
+                                        int&              index) noexcept;
+  static bool isWhitespace(char c) noexcept;
+  static FileParseError parseError(const char* file, int line,
+                                   const QByteArray& content, int index,
+                                   const FilePath& filePath,
+                                   const QString&  msg) noexcept;
+
+private:  // Types
+  struct LazyChildren;
 
 private:  // Data
-  Type               mType;
-  QString            mValue;  ///< either a list name, a token or a string
-  QList<SExpression> mChildren;
-  FilePath           mFilePath;
+  Type                          mType;
+  QString                       mValue;  ///< list name, token or string
+  QVector<SExpression>          mChildren;  ///< unused if #mLazyChildren set
+  std::shared_ptr<LazyChildren> mLazyChildren;  ///< not yet parsed children
+  FilePath                      mFilePath;
+
+  // Static Variables
+  static constexpr int sMaxInternedTokenLength = 24;
 };
 
 /*******************************************************************************
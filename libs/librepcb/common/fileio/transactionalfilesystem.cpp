@@ -36,6 +36,9 @@
 #include <quazip/quazipfile.h>
 #endif
 
+#include <QtConcurrent/QtConcurrent>
+#include <zlib.h>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -68,8 +71,8 @@ TransactionalFileSystem::TransactionalFileSystem(
 
   // If there is an autosave backup, load it according the restore mode.
   FilePath autosaveFile = mFilePath.getPathTo(".autosave/autosave.lp");
-  if (autosaveFile.isExistingFile()) {
-    if (restoreCallback && restoreCallback(mFilePath)) {  // can throw
+  if (restoreCallback && autosaveFile.isExistingFile()) {
+    if (restoreCallback(mFilePath)) {  // can throw
       qDebug() << "Restoring file system from autosave backup:"
                << autosaveFile.toNative();
       loadDiff(autosaveFile);  // can throw
@@ -118,7 +121,7 @@ QStringList TransactionalFileSystem::getDirs(const QString& path) const
   }
 
   // add directories of new files
-  foreach (const QString& filepath, mModifiedFiles.keys()) {
+  foreach (const QString& filepath, mModifiedFiles.keys() + mZipFiles.keys()) {
     if (filepath.startsWith(dirpath)) {
       QStringList relpath = filepath.mid(dirpath.length()).split('/');
       if (relpath.count() > 1) {
@@ -145,7 +148,7 @@ QStringList TransactionalFileSystem::getFiles(const QString& path) const
   }
 
   // add new files
-  foreach (const QString& filepath, mModifiedFiles.keys()) {
+  foreach (const QString& filepath, mModifiedFiles.keys() + mZipFiles.keys()) {
     if (filepath.startsWith(dirpath)) {
       QStringList relpath = filepath.mid(dirpath.length()).split('/');
       if (relpath.count() == 1) {
@@ -159,7 +162,7 @@ QStringList TransactionalFileSystem::getFiles(const QString& path) const
 
 bool TransactionalFileSystem::fileExists(const QString& path) const noexcept {
   QString cleanedPath = cleanPath(path);
-  if (mModifiedFiles.contains(cleanedPath)) {
+  if (mModifiedFiles.contains(cleanedPath) || mZipFiles.contains(cleanedPath)) {
     return true;
   } else if (isRemoved(cleanedPath)) {
     return false;
@@ -172,8 +175,13 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
   QString cleanedPath = cleanPath(path);
   if (mModifiedFiles.contains(cleanedPath)) {
     return mModifiedFiles.value(cleanedPath);
+  } else if (mZipFiles.contains(cleanedPath)) {
+    return readFromZip(cleanedPath);  // can throw
   } else if (!isRemoved(cleanedPath)) {
-    return FileUtils::readFile(mFilePath.getPathTo(cleanedPath));  // can throw
+    QByteArray content =
+        FileUtils::readFile(mFilePath.getPathTo(cleanedPath));  // can throw
+    mFileHashes.insert(cleanedPath, calcHash(content));
+    return content;
   } else {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("File '%1' does not exist.")
@@ -183,14 +191,30 @@ QByteArray TransactionalFileSystem::read(const QString& path) const {
 
 void TransactionalFileSystem::write(const QString&    path,
                                     const QByteArray& content) {
-  QString cleanedPath         = cleanPath(path);
+  QString cleanedPath = cleanPath(path);
+  if ((!isRemoved(cleanedPath)) &&
+      (mFileHashes.value(cleanedPath) == calcHash(content))) {
+    // The content is identical to the file on disk, so there is no need to
+    // write it. This avoids rewriting all files if only a few have changed.
+    mModifiedFiles.remove(cleanedPath);
+    mAutosavedFiles.remove(cleanedPath);
+    mZipFiles.remove(cleanedPath);
+    return;
+  }
+  auto it = mModifiedFiles.constFind(cleanedPath);
+  if ((it == mModifiedFiles.constEnd()) || (it.value() != content)) {
+    mAutosavedFiles.remove(cleanedPath);  // needs to be autosaved again
+  }
   mModifiedFiles[cleanedPath] = content;
   mRemovedFiles.remove(cleanedPath);
+  mZipFiles.remove(cleanedPath);
 }
 
 void TransactionalFileSystem::removeFile(const QString& path) {
   QString cleanedPath = cleanPath(path);
   mModifiedFiles.remove(cleanedPath);
+  mAutosavedFiles.remove(cleanedPath);
+  mZipFiles.remove(cleanedPath);
   mRemovedFiles.insert(cleanedPath);
 }
 
@@ -200,6 +224,7 @@ void TransactionalFileSystem::removeDirRecursively(const QString& path) {
   foreach (const QString& fp, mModifiedFiles.keys()) {
     if (dirpath.isEmpty() || fp.startsWith(dirpath)) {
       mModifiedFiles.remove(fp);
+      mAutosavedFiles.remove(fp);
     }
   }
   foreach (const QString& fp, mRemovedFiles) {
@@ -207,6 +232,11 @@ void TransactionalFileSystem::removeDirRecursively(const QString& path) {
       mRemovedFiles.remove(fp);
     }
   }
+  foreach (const QString& fp, mZipFiles.keys()) {
+    if (dirpath.isEmpty() || fp.startsWith(dirpath)) {
+      mZipFiles.remove(fp);
+    }
+  }
   mRemovedDirs.insert(dirpath);
 }
 
@@ -230,19 +260,27 @@ void TransactionalFileSystem::loadFromZip(QByteArray content) {
 }
 
 void TransactionalFileSystem::loadFromZip(const FilePath& fp) {
-  QuaZip zip(fp.toStr());
-  if (!zip.open(QuaZip::mdUnzip)) {
+  // Only one ZIP file can be kept open, so decompress all pending files of a
+  // previously loaded ZIP file before opening the new one.
+  loadPendingZipFiles();  // can throw
+
+  std::unique_ptr<QuaZip> zip(new QuaZip(fp.toStr()));
+  if (!zip->open(QuaZip::mdUnzip)) {
     throw RuntimeError(
         __FILE__, __LINE__,
         tr("Failed to open the ZIP file '%1'.").arg(fp.toNative()));
   }
-  QuaZipFile file(&zip);
-  for (bool f = zip.goToFirstFile(); f; f = zip.goToNextFile()) {
-    file.open(QIODevice::ReadOnly);
-    write(file.getActualFileName(), file.readAll());
-    file.close();
+
+  // Only register the contained files, they are decompressed on demand. This
+  // avoids holding the content of the whole ZIP file in memory.
+  foreach (const QString& filename, zip->getFileNameList()) {
+    QString cleanedPath = cleanPath(filename);
+    mModifiedFiles.remove(cleanedPath);
+    mAutosavedFiles.remove(cleanedPath);
+    mRemovedFiles.remove(cleanedPath);
+    mZipFiles.insert(cleanedPath, filename);
   }
-  zip.close();
+  mZip = std::move(zip);
 }
 
 QByteArray TransactionalFileSystem::exportToZip() const {
@@ -254,7 +292,7 @@ QByteArray TransactionalFileSystem::exportToZip() const {
   }
   try {
     QuaZipFile file(&zip);
-    exportDirToZip(file, fp, "");
+    exportFilesToZip(file, fp, getFilesForZip(fp, ""));  // can throw
     zip.close();
   } catch (const Exception& e) {
     // Remove ZIP file because it is not complete
@@ -274,7 +312,7 @@ void TransactionalFileSystem::exportToZip(const FilePath& fp) const {
   }
   try {
     QuaZipFile file(&zip);
-    exportDirToZip(file, fp, "");
+    exportFilesToZip(file, fp, getFilesForZip(fp, ""));  // can throw
     zip.close();
   } catch (const Exception& e) {
     // Remove ZIP file because it is not complete
@@ -288,6 +326,8 @@ void TransactionalFileSystem::discardChanges() noexcept {
   mModifiedFiles.clear();
   mRemovedFiles.clear();
   mRemovedDirs.clear();
+  mAutosavedFiles.clear();
+  mZipFiles.clear();
 }
 
 QStringList TransactionalFileSystem::checkForModifications() const {
@@ -310,9 +350,9 @@ QStringList TransactionalFileSystem::checkForModifications() const {
   }
 
   // new or modified files
-  foreach (const QString& filepath, mModifiedFiles.keys()) {
+  foreach (const QString& filepath, mModifiedFiles.keys() + mZipFiles.keys()) {
     FilePath   fp      = mFilePath.getPathTo(filepath);
-    QByteArray content = mModifiedFiles.value(filepath);
+    QByteArray content = read(filepath);  // can throw
     if ((!fp.isExistingFile()) ||
         (FileUtils::readFile(fp) != content)) {  // can throw
       modifications.append(filepath);
@@ -323,10 +363,32 @@ QStringList TransactionalFileSystem::checkForModifications() const {
 }
 
 void TransactionalFileSystem::autosave() {
-  saveDiff("autosave");  // can throw
+  loadPendingZipFiles();  // can throw
+
+  // Only write files which were modified since the last autosave. The
+  // content of all other files is still available in the directories of
+  // previous autosaves, so the new autosave just references them.
+  mAutosavedFiles = saveDiff("autosave", mAutosavedFiles);  // can throw
+
+  // remove directories of previous autosaves which are no longer referenced
+  FilePath      dir      = mFilePath.getPathTo(".autosave");
+  QSet<QString> usedDirs = mAutosavedFiles.values().toSet();
+  foreach (const QString& dirName,
+           QDir(dir.toStr()).entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+    if (!usedDirs.contains(dirName)) {
+      try {
+        FileUtils::removeDirRecursively(dir.getPathTo(dirName));  // can throw
+      } catch (const Exception& e) {
+        qWarning() << "Could not remove outdated autosave directory:"
+                   << e.getMsg();
+      }
+    }
+  }
 }
 
 void TransactionalFileSystem::save() {
+  loadPendingZipFiles();  // can throw
+
   // save to backup directory
   saveDiff("backup");  // can throw
 
@@ -355,14 +417,26 @@ void TransactionalFileSystem::save() {
   }
 
   // save new or modified files
-  foreach (const QString& filepath, mModifiedFiles.keys()) {
-    FileUtils::writeFile(mFilePath.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+  QList<QPair<FilePath, QByteArray>> files;
+  for (auto it = mModifiedFiles.constBegin(); it != mModifiedFiles.constEnd();
+       ++it) {
+    files.append(qMakePair(mFilePath.getPathTo(it.key()), it.value()));
   }
+  writeFiles(files);  // can throw
 
   // remove backup
   removeDiff("backup");  // can throw
 
+  // update hashes of the files on disk
+  foreach (const QString& fp, mFileHashes.keys()) {
+    if (isRemoved(fp)) {
+      mFileHashes.remove(fp);
+    }
+  }
+  foreach (const QString& filepath, mModifiedFiles.keys()) {
+    mFileHashes.insert(filepath, calcHash(mModifiedFiles.value(filepath)));
+  }
+
   // clear state
   discardChanges();
 }
@@ -397,19 +471,19 @@ bool TransactionalFileSystem::isRemoved(const QString& path) const noexcept {
   return false;
 }
 
-void TransactionalFileSystem::exportDirToZip(QuaZipFile&     file,
-                                             const FilePath& zipFp,
-                                             const QString&  dir) const {
-  QString path = dir.isEmpty() ? dir : dir % "/";
+QStringList TransactionalFileSystem::getFilesForZip(const FilePath& zipFp,
+                                                   const QString&  dir) const {
+  QString     path = dir.isEmpty() ? dir : dir % "/";
+  QStringList files;
 
-  // export directories
+  // files of subdirectories
   foreach (const QString& dirname, getDirs(dir)) {
     // skip dotdirs, e.g. ".git", ".svn", ".autosave", ".backup"
     if (dirname.startsWith('.')) continue;
-    exportDirToZip(file, zipFp, path % dirname);
+    files += getFilesForZip(zipFp, path % dirname);
   }
 
-  // export files
+  // files of this directory
   foreach (const QString& filename, getFiles(dir)) {
     QString filepath = path % filename;
     if (filepath == zipFp.toRelative(mFilePath)) {
@@ -419,26 +493,59 @@ void TransactionalFileSystem::exportDirToZip(QuaZipFile&     file,
     }
     // skip lock file
     if (filename == ".lock") continue;
-    // read file content and add it to the ZIP archive
-    const QByteArray& content = read(filepath);  // can throw
-    QuaZipNewInfo     newFileInfo(filepath);
-    newFileInfo.setPermissions(QFileDevice::ReadOwner | QFileDevice::ReadGroup |
-                               QFileDevice::ReadOther |
-                               QFileDevice::WriteOwner);
-    if (!file.open(QIODevice::WriteOnly, newFileInfo)) {
-      throw RuntimeError(__FILE__, __LINE__);
+    files.append(filepath);
+  }
+
+  return files;
+}
+
+void TransactionalFileSystem::exportFilesToZip(QuaZipFile&        file,
+                                               const FilePath&    zipFp,
+                                               const QStringList& files) const {
+  // Files are compressed in parallel, but in chunks of limited size to avoid
+  // holding the content of the whole ZIP file in memory. Reading files and
+  // writing the compressed data is done in this thread and in the original
+  // order since the file system and the ZIP file are not thread-safe.
+  for (int i = 0; i < files.count();) {
+    QList<QPair<QString, QByteArray>> chunk;
+    QList<QFuture<QByteArray>>        futures;
+    qint64                            chunkSize = 0;
+    while ((i < files.count()) && (chunkSize < sMaxZipChunkSize)) {
+      QByteArray content = read(files.at(i));  // can throw
+      chunk.append(qMakePair(files.at(i), content));
+      futures.append(QtConcurrent::run(&compressForZip, content));
+      chunkSize += content.size();
+      ++i;
     }
-    qint64 bytesWritten = file.write(content);
-    file.close();
-    if (bytesWritten != content.length()) {
-      throw RuntimeError(__FILE__, __LINE__,
-                         tr("Failed to write file '%1' to '%2'.")
-                             .arg(filepath, zipFp.toNative()));
+    for (int k = 0; k < chunk.count(); ++k) {
+      const QString&    filepath   = chunk.at(k).first;
+      const QByteArray& content    = chunk.at(k).second;
+      QByteArray        compressed = futures[k].result();  // can throw
+      QuaZipNewInfo     newFileInfo(filepath);
+      newFileInfo.setPermissions(
+          QFileDevice::ReadOwner | QFileDevice::ReadGroup |
+          QFileDevice::ReadOther | QFileDevice::WriteOwner);
+      newFileInfo.uncompressedSize = content.size();
+      const Bytef* data = reinterpret_cast<const Bytef*>(content.constData());
+      quint32      crc  = crc32(0, data, content.size());
+      if (!file.open(QIODevice::WriteOnly, newFileInfo, nullptr, crc,
+                     Z_DEFLATED, Z_DEFAULT_COMPRESSION, true)) {
+        throw RuntimeError(__FILE__, __LINE__);
+      }
+      qint64 bytesWritten = file.write(compressed);
+      file.close();
+      if ((bytesWritten != compressed.length()) ||
+          (file.getZipError() != ZIP_OK)) {
+        throw RuntimeError(__FILE__, __LINE__,
+                           tr("Failed to write file '%1' to '%2'.")
+                               .arg(filepath, zipFp.toNative()));
+      }
     }
   }
 }
 
-void TransactionalFileSystem::saveDiff(const QString& type) const {
+QHash<QString, QString> TransactionalFileSystem::saveDiff(
+    const QString& type, const QHash<QString, QString>& savedFiles) const {
   QDateTime dt       = QDateTime::currentDateTime();
   FilePath  dir      = mFilePath.getPathTo("." % type);
   FilePath  filesDir = dir.getPathTo(dt.toString("yyyy-MM-dd_hh-mm-ss-zzz"));
@@ -450,10 +557,25 @@ void TransactionalFileSystem::saveDiff(const QString& type) const {
   SExpression root = SExpression::createList("librepcb_" % type);
   root.appendChild("created", dt, true);
   root.appendChild("modified_files_directory", filesDir.getFilename(), true);
+  QHash<QString, QString> fileDirs;  // relative file path -> files directory
+
+  QList<QPair<FilePath, QByteArray>> files;  // written concurrently
   foreach (const QString& filepath, Toolbox::sorted(mModifiedFiles.keys())) {
-    root.appendChild("modified_file", filepath, true);
-    FileUtils::writeFile(filesDir.getPathTo(filepath),
-                         mModifiedFiles.value(filepath));  // can throw
+    // Files listed in savedFiles are already contained in older diffs, so
+    // just reference them (if they still exist) instead of writing them again.
+    QString oldFilesDir = savedFiles.value(filepath);
+    if ((!oldFilesDir.isEmpty()) &&
+        dir.getPathTo(oldFilesDir).getPathTo(filepath).isExistingFile()) {
+      root.appendList("modified_file", true)
+          .appendChild(filepath)
+          .appendChild(oldFilesDir);
+      fileDirs.insert(filepath, oldFilesDir);
+    } else {
+      root.appendChild("modified_file", filepath, true);
+      files.append(qMakePair(filesDir.getPathTo(filepath),
+                             mModifiedFiles.value(filepath)));
+      fileDirs.insert(filepath, filesDir.getFilename());
+    }
   }
   foreach (const QString& filepath, Toolbox::sorted(mRemovedFiles.values())) {
     root.appendChild("removed_file", filepath, true);
@@ -461,11 +583,54 @@ void TransactionalFileSystem::saveDiff(const QString& type) const {
   foreach (const QString& filepath, Toolbox::sorted(mRemovedDirs.values())) {
     root.appendChild("removed_directory", filepath, true);
   }
+  writeFiles(files);  // can throw
 
   // Writing the main file must be the last operation to "mark" this diff as
   // complete!
   FileUtils::writeFile(dir.getPathTo(type % ".lp"),
                        root.toByteArray());  // can throw
+  return fileDirs;
+}
+
+void TransactionalFileSystem::writeFiles(
+    const QList<QPair<FilePath, QByteArray>>& files) {
+  // Each file is written to a temporary file which is synced to disk and then
+  // renamed (see FileUtils::writeFile()), so every single file is either
+  // written completely or not at all. Since the files are independent of each
+  // other, they are written concurrently to overlap the latency of the sync
+  // steps, which is very high on network shares. The directories are created
+  // in advance to avoid races between the jobs.
+  QSet<QString> dirs;
+  for (const auto& file : files) {
+    if (!dirs.contains(file.first.getParentDir().toStr())) {
+      FileUtils::makePath(file.first.getParentDir());  // can throw
+      dirs.insert(file.first.getParentDir().toStr());
+    }
+  }
+  QList<QFuture<QString>> futures;
+  for (const auto& file : files) {
+    futures.append(QtConcurrent::run([file]() -> QString {
+      try {
+        FileUtils::writeFile(file.first, file.second);  // can throw
+        return QString();
+      } catch (const Exception& e) {
+        return e.getMsg();
+      }
+    }));
+  }
+
+  // Wait for all jobs before reporting errors, so no file is written after
+  // this method has returned.
+  QString error;
+  for (QFuture<QString>& future : futures) {
+    QString msg = future.result();
+    if (error.isEmpty()) {
+      error = msg;
+    }
+  }
+  if (!error.isEmpty()) {
+    throw RuntimeError(__FILE__, __LINE__, error);
+  }
 }
 
 void TransactionalFileSystem::loadDiff(const FilePath& fp) {
@@ -479,6 +644,11 @@ void TransactionalFileSystem::loadDiff(const FilePath& fp) {
   foreach (const SExpression& node, root.getChildren("modified_file")) {
     QString  relPath = node.getValueOfFirstChild<QString>(true);
     FilePath absPath = modifiedFilesDir.getPathTo(relPath);
+    if (node.getChildren().count() > 1) {
+      // file is contained in the directory of an older diff
+      QString dirName = node.getChildByIndex(1).getValue<QString>(true);
+      absPath = fp.getParentDir().getPathTo(dirName).getPathTo(relPath);
+    }
     mModifiedFiles.insert(relPath, FileUtils::readFile(absPath));  // can throw
   }
   foreach (const SExpression& node, root.getChildren("removed_file")) {
@@ -504,6 +674,66 @@ void TransactionalFileSystem::removeDiff(const QString& type) {
   FileUtils::removeDirRecursively(dir);  // can throw
 }
 
+QByteArray TransactionalFileSystem::readFromZip(const QString& path) const {
+  QString filename = mZipFiles.value(path);
+  if ((!mZip) || (!mZip->setCurrentFile(filename))) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("File '%1' not found in ZIP file '%2'.")
+                           .arg(filename, mZip ? mZip->getZipName() : ""));
+  }
+  QuaZipFile file(mZip.get());
+  if (!file.open(QIODevice::ReadOnly)) {
+    throw RuntimeError(__FILE__, __LINE__,
+                       tr("Failed to read file '%1' from ZIP file '%2'.")
+                           .arg(filename, mZip->getZipName()));
+  }
+  QByteArray content = file.readAll();
+  file.close();
+  return content;
+}
+
+void TransactionalFileSystem::loadPendingZipFiles() {
+  foreach (const QString& filepath, mZipFiles.keys()) {
+    mModifiedFiles.insert(filepath, readFromZip(filepath));  // can throw
+    mZipFiles.remove(filepath);
+  }
+  if (mZip) {
+    mZip->close();
+    mZip.reset();
+  }
+}
+
+QByteArray TransactionalFileSystem::compressForZip(const QByteArray& content) {
+  // raw deflate stream (without zlib header) as stored in ZIP files, with the
+  // same settings as used by QuaZip
+  z_stream stream;
+  stream.zalloc = Z_NULL;
+  stream.zfree  = Z_NULL;
+  stream.opaque = Z_NULL;
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw RuntimeError(__FILE__, __LINE__, tr("Failed to compress data."));
+  }
+  QByteArray output(deflateBound(&stream, content.size()), Qt::Uninitialized);
+  stream.next_in =
+      reinterpret_cast<Bytef*>(const_cast<char*>(content.constData()));
+  stream.avail_in  = content.size();
+  stream.next_out  = reinterpret_cast<Bytef*>(output.data());
+  stream.avail_out = output.size();
+  int result       = deflate(&stream, Z_FINISH);
+  output.resize(stream.total_out);
+  deflateEnd(&stream);
+  if (result != Z_STREAM_END) {
+    throw RuntimeError(__FILE__, __LINE__, tr("Failed to compress data."));
+  }
+  return output;
+}
+
+QByteArray TransactionalFileSystem::calcHash(
+    const QByteArray& content) noexcept {
+  return QCryptographicHash::hash(content, QCryptographicHash::Sha1);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -34,6 +34,7 @@
  *  Namespace / Forward Declarations
  ******************************************************************************/
 
+class QuaZip;
 class QuaZipFile;
 
 namespace librepcb {
@@ -74,6 +75,10 @@ public:
    * @retval false  Do not restore backup.
    *
    * @throw ::librepcb::Exception to abort opening the directory.
+   *
+   * @note If no callback is passed, the directory is not even checked for
+   *       an autosave backup. Together with the read-only mode (which doesn't
+   *       create a lock file), this allows any number of concurrent readers.
    */
   typedef std::function<bool(const FilePath& dir)> RestoreCallback;
 
@@ -162,20 +167,20 @@ public:
   // Static Methods
   static std::shared_ptr<TransactionalFileSystem> open(
       const FilePath& filepath, bool writable,
-      RestoreCallback restoreCallback = &RestoreMode::no,
+      RestoreCallback restoreCallback = RestoreCallback(),
       QObject*        parent          = nullptr) {
     return std::make_shared<TransactionalFileSystem>(filepath, writable,
                                                      restoreCallback, parent);
   }
   static std::shared_ptr<TransactionalFileSystem> openRO(
       const FilePath& filepath,
-      RestoreCallback restoreCallback = &RestoreMode::no,
+      RestoreCallback restoreCallback = RestoreCallback(),
       QObject*        parent          = nullptr) {
     return open(filepath, false, restoreCallback, parent);
   }
   static std::shared_ptr<TransactionalFileSystem> openRW(
       const FilePath& filepath,
-      RestoreCallback restoreCallback = &RestoreMode::no,
+      RestoreCallback restoreCallback = RestoreCallback(),
       QObject*        parent          = nullptr) {
     return open(filepath, true, restoreCallback, parent);
   }
@@ -183,11 +188,19 @@ public:
 
 private:  // Methods
   bool isRemoved(const QString& path) const noexcept;
-  void exportDirToZip(QuaZipFile& file, const FilePath& zipFp,
-                      const QString& dir) const;
-  void saveDiff(const QString& type) const;
+  QStringList getFilesForZip(const FilePath& zipFp, const QString& dir) const;
+  void exportFilesToZip(QuaZipFile& file, const FilePath& zipFp,
+                        const QStringList& files) const;
+  static QByteArray compressForZip(const QByteArray& content);
+  QHash<QString, QString> saveDiff(
+      const QString&                 type,
+      const QHash<QString, QString>& savedFiles = {}) const;
+  static void writeFiles(const QList<QPair<FilePath, QByteArray>>& files);
   void loadDiff(const FilePath& fp);
   void removeDiff(const QString& type);
+  QByteArray        readFromZip(const QString& path) const;
+  void              loadPendingZipFiles();
+  static QByteArray calcHash(const QByteArray& content) noexcept;
 
 private:  // Data
   FilePath      mFilePath;
@@ -199,6 +212,24 @@ private:  // Data
   QHash<QString, QByteArray> mModifiedFiles;
   QSet<QString>              mRemovedFiles;
   QSet<QString>              mRemovedDirs;
+
+  /// Modified files which are unchanged since the last autosave, with the
+  /// autosave directory containing their content
+  QHash<QString, QString> mAutosavedFiles;
+
+  /// Hashes of the file contents on disk (only for files read or written)
+  mutable QHash<QString, QByteArray> mFileHashes;
+
+  /// The ZIP file loaded with #loadFromZip(const FilePath&), kept open to
+  /// decompress its files on demand
+  std::unique_ptr<QuaZip> mZip;
+
+  /// Files of #mZip which are not decompressed yet, with their name in the ZIP
+  /// file (they are handled like modified files)
+  QHash<QString, QString> mZipFiles;
+
+  /// Maximum size of files compressed in parallel while exporting to ZIP
+  static constexpr int sMaxZipChunkSize = 32 * 1024 * 1024;  ///< Bytes
 };
 
 /*******************************************************************************
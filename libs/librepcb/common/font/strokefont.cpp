@@ -22,10 +22,11 @@
  ******************************************************************************/
 #include "strokefont.h"
 
+#include "../utils/taskscheduler.h"
+
 #include <fontobene-qt5/font.h>
 #include <fontobene-qt5/glyphlistaccessor.h>
 
-#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -41,13 +42,18 @@ namespace fb = fontobene;
 
 StrokeFont::StrokeFont(const FilePath&   fontFilePath,
                        const QByteArray& content) noexcept
-  : QObject(nullptr), mFilePath(fontFilePath) {
-  // load the font in another thread because it takes some time to load it
+  : QObject(nullptr),
+    mFilePath(fontFilePath),
+    mTextCache(5000),  // max. number of texts
+    mGlyphCache(2000) {  // max. number of glyphs
+  // Load the font in another thread because it takes some time to load it.
+  // Texts can't be rendered until it is loaded, so load it with priority.
   qDebug() << "Start loading font" << mFilePath.toNative();
-  mFuture = QtConcurrent::run([content]() {
-    QTextStream s(content);
-    return fb::Font(s);
-  });
+  mFuture =
+      TaskScheduler::run(TaskScheduler::Priority::Interactive, [content]() {
+        QTextStream s(content);
+        return fb::Font(s);
+      });
   connect(&mWatcher, &QFutureWatcher<fb::Font>::finished, this,
           &StrokeFont::fontLoaded);
   mWatcher.setFuture(mFuture);
@@ -82,6 +88,25 @@ QVector<Path> StrokeFont::stroke(const QString&        text,
                                  Point& topRight) const noexcept {
   accessor();  // block until the font is loaded. TODO: abort instead of
                // waiting?
+
+  // Boards often contain many identical texts (e.g. "{{NAME}}" attributes
+  // with the same size), so it's worth to cache the stroked texts.
+  const QString key =
+      QString("%1|%2|%3|%4|%5")
+          .arg(height->toNm())
+          .arg(letterSpacing.toNm())
+          .arg(lineSpacing.toNm())
+          .arg(align.getH().toQtAlignFlag() | align.getV().toQtAlignFlag())
+          .arg(text);
+  {
+    QMutexLocker lock(&mCacheMutex);
+    if (const StrokedText* cached = mTextCache.object(key)) {
+      bottomLeft = cached->bottomLeft;
+      topRight   = cached->topRight;
+      return cached->paths;
+    }
+  }
+
   QVector<Path>                         paths;
   Length                                totalWidth;
   QVector<QPair<QVector<Path>, Length>> lines =
@@ -130,6 +155,8 @@ QVector<Path> StrokeFont::stroke(const QString&        text,
     topRight.setY(totalHeight / 2);
   }
 
+  QMutexLocker lock(&mCacheMutex);
+  mTextCache.insert(key, new StrokedText{paths, bottomLeft, topRight});
   return paths;
 }
 
@@ -179,13 +206,25 @@ QVector<Path> StrokeFont::strokeLine(const QString&        text,
 QVector<Path> StrokeFont::strokeGlyph(const QChar&          glyph,
                                       const PositiveLength& height,
                                       Length& spacing) const noexcept {
+  const QString key = QString("%1|%2").arg(height->toNm()).arg(glyph);
+  {
+    QMutexLocker lock(&mCacheMutex);
+    if (const StrokedGlyph* cached = mGlyphCache.object(key)) {
+      spacing = cached->spacing;
+      return cached->paths;
+    }
+  }
   try {
     qreal                 glyphSpacing = 0;
     QVector<fb::Polyline> polylines =
         accessor().getAllPolylinesOfGlyph(glyph.unicode(),
                                           &glyphSpacing);  // can throw
-    spacing = convertLength(height, glyphSpacing);
-    return polylines2paths(polylines, height);
+    spacing             = convertLength(height, glyphSpacing);
+    QVector<Path> paths = polylines2paths(polylines, height);
+
+    QMutexLocker lock(&mCacheMutex);
+    mGlyphCache.insert(key, new StrokedGlyph{paths, spacing});
+    return paths;
   } catch (const fb::Exception& e) {
     qWarning() << "Failed to load stroke font glyph" << glyph;
     spacing = 0;
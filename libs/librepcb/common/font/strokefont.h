@@ -80,6 +80,19 @@ public:
   StrokeFont& operator=(const StrokeFont& rhs) = delete;
 
 private:
+  /// A stroked text, cached for later calls to #stroke()
+  struct StrokedText {
+    QVector<Path> paths;
+    Point         bottomLeft;
+    Point         topRight;
+  };
+
+  /// A stroked glyph, cached for later calls to #strokeGlyph()
+  struct StrokedGlyph {
+    QVector<Path> paths;
+    Length        spacing;
+  };
+
   void                                fontLoaded() noexcept;
   const fontobene::GlyphListAccessor& accessor() const noexcept;
   static QVector<Path>                polylines2paths(
@@ -101,6 +114,12 @@ private:  // Data
   mutable QScopedPointer<fontobene::Font>              mFont;
   mutable QScopedPointer<fontobene::GlyphListCache>    mGlyphListCache;
   mutable QScopedPointer<fontobene::GlyphListAccessor> mGlyphListAccessor;
+
+  /// Caches for stroked texts and glyphs (least recently used entries are
+  /// evicted when exceeding the limit)
+  mutable QCache<QString, StrokedText>  mTextCache;
+  mutable QCache<QString, StrokedGlyph> mGlyphCache;
+  mutable QMutex                        mCacheMutex;  ///< Guards the caches
 };
 
 /*******************************************************************************
@@ -41,9 +41,8 @@ StrokeFontPool::StrokeFontPool(const FileSystem& directory) noexcept {
     if (fp.getSuffix() != "bene") continue;
     try {
       qDebug() << "Load stroke font:" << filename;
-      mFonts.insert(filename, std::make_shared<StrokeFont>(
-                                  fp,
-                                  directory.read(filename)));  // can throw
+      mFonts.insert(filename, getSharedFont(
+                                  fp, directory.read(filename)));  // can throw
     } catch (const Exception& e) {
       qCritical() << "Failed to load stroke font" << fp.toNative() << ":"
                   << e.getMsg();
@@ -68,6 +67,32 @@ const StrokeFont& StrokeFontPool::getFont(const QString& filename) const {
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+std::shared_ptr<StrokeFont> StrokeFontPool::getSharedFont(
+    const FilePath& fp, const QByteArray& content) noexcept {
+  const QByteArray key =
+      QCryptographicHash::hash(content, QCryptographicHash::Sha256);
+  QMutexLocker                lock(&sSharedFontsMutex);
+  std::shared_ptr<StrokeFont> font = sSharedFonts.value(key).lock();
+  if (font) {
+    qDebug() << "Reuse already loaded stroke font for" << fp.toNative();
+  } else {
+    font = std::make_shared<StrokeFont>(fp, content);
+    sSharedFonts.insert(key, font);
+  }
+  return font;
+}
+
+/*******************************************************************************
+ *  Static Members
+ ******************************************************************************/
+
+QHash<QByteArray, std::weak_ptr<StrokeFont>> StrokeFontPool::sSharedFonts;
+QMutex                                       StrokeFontPool::sSharedFontsMutex;
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
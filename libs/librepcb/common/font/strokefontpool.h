@@ -42,6 +42,11 @@ class FileSystem;
 
 /**
  * @brief The StrokeFontPool class
+ *
+ * Fonts with identical file content are shared between all pools of the
+ * application (e.g. the pool of librepcb::Application and the pools of all
+ * opened projects), so each font is parsed only once and its stroke caches
+ * are shared as well.
  */
 class StrokeFontPool final {
   Q_DECLARE_TR_FUNCTIONS(StrokeFontPool)
@@ -58,8 +63,18 @@ public:
   // Operator Overloadings
   StrokeFontPool& operator=(const StrokeFontPool& rhs) noexcept;
 
+private:  // Methods
+  static std::shared_ptr<StrokeFont> getSharedFont(
+      const FilePath& fp, const QByteArray& content) noexcept;
+
 private:  // Data
   QHash<QString, std::shared_ptr<StrokeFont>> mFonts;
+
+  /// Fonts of all pools, key: hash of the file content
+  static QHash<QByteArray, std::weak_ptr<StrokeFont>> sSharedFonts;
+
+  /// Guards #sSharedFonts
+  static QMutex sSharedFontsMutex;
 };
 
 /*******************************************************************************
@@ -36,10 +36,11 @@ namespace librepcb {
  ******************************************************************************/
 
 Path::Path(const Path& other) noexcept
-  : mVertices(other.mVertices), mPainterPathPx(other.mPainterPathPx) {
+  : mVertices(other.mVertices),
+    mPainterPathPx(std::atomic_load(&other.mPainterPathPx)) {
 }
 
-Path::Path(const SExpression& node) {
+Path::Path(const SExpression& node) : mPainterPathPx() {
   foreach (const SExpression& child, node.getChildren("vertex")) {
     mVertices.append(Vertex(child));
   }
@@ -80,34 +81,51 @@ QVector<Path> Path::toOutlineStrokes(const PositiveLength& width) const
 }
 
 const QPainterPath& Path::toQPainterPathPx() const noexcept {
-  if (mPainterPathPx.isEmpty()) {
-    for (int i = 0; i < mVertices.count(); ++i) {
-      const Vertex& v = mVertices.at(i);
-      if (i == 0) {
-        mPainterPathPx.moveTo(v.getPos().toPxQPointF());
-        continue;
-      }
-      const Vertex& v0 = mVertices.at(i - 1);
-      if (v0.getAngle() == 0) {
-        mPainterPathPx.lineTo(v.getPos().toPxQPointF());
-      } else {
-        QPointF centerPx =
-            Toolbox::arcCenter(v0.getPos(), v.getPos(), v0.getAngle())
-                .toPxQPointF();
-        qreal radiusPx =
-            Toolbox::arcRadius(v0.getPos(), v.getPos(), v0.getAngle())
-                .abs()
-                .toPx();
-        QPointF diffPx = v0.getPos().toPxQPointF() - centerPx;
-        qreal   startAngleDeg =
-            -qRadiansToDegrees(qAtan2(diffPx.y(), diffPx.x()));
-        mPainterPathPx.arcTo(centerPx.x() - radiusPx, centerPx.y() - radiusPx,
-                             radiusPx * 2, radiusPx * 2, startAngleDeg,
-                             v0.getAngle().toDeg());
-      }
+  std::shared_ptr<const QPainterPath> cached =
+      std::atomic_load(&mPainterPathPx);
+  if (cached) {
+    return *cached;
+  }
+
+  // Not cached yet, so build it. If other threads do the same concurrently,
+  // only the first result is published and the others are discarded.
+  std::shared_ptr<QPainterPath> p = std::make_shared<QPainterPath>();
+  for (int i = 0; i < mVertices.count(); ++i) {
+    const Vertex& v = mVertices.at(i);
+    if (i == 0) {
+      p->moveTo(v.getPos().toPxQPointF());
+      continue;
+    }
+    const Vertex& v0 = mVertices.at(i - 1);
+    if (v0.getAngle() == 0) {
+      p->lineTo(v.getPos().toPxQPointF());
+    } else {
+      QPointF centerPx =
+          Toolbox::arcCenter(v0.getPos(), v.getPos(), v0.getAngle())
+              .toPxQPointF();
+      qreal radiusPx =
+          Toolbox::arcRadius(v0.getPos(), v.getPos(), v0.getAngle())
+              .abs()
+              .toPx();
+      QPointF diffPx = v0.getPos().toPxQPointF() - centerPx;
+      qreal   startAngleDeg =
+          -qRadiansToDegrees(qAtan2(diffPx.y(), diffPx.x()));
+      p->arcTo(centerPx.x() - radiusPx, centerPx.y() - radiusPx, radiusPx * 2,
+               radiusPx * 2, startAngleDeg, v0.getAngle().toDeg());
     }
   }
-  return mPainterPathPx;
+
+  // QPainterPath calculates its bounding rects lazily as well, so do it now
+  // to make the const methods of the published object free of side effects.
+  p->boundingRect();
+  p->controlPointRect();
+
+  std::shared_ptr<const QPainterPath> result = p;
+  if (std::atomic_compare_exchange_strong(&mPainterPathPx, &cached, result)) {
+    return *result;
+  } else {
+    return *cached;  // another thread was faster
+  }
 }
 
 /*******************************************************************************
@@ -194,8 +212,10 @@ void Path::serialize(SExpression& root) const {
  ******************************************************************************/
 
 Path& Path::operator=(const Path& rhs) noexcept {
-  mVertices      = rhs.mVertices;
-  mPainterPathPx = rhs.mPainterPathPx;
+  if (&rhs != this) {
+    mVertices = rhs.mVertices;
+    std::atomic_store(&mPainterPathPx, std::atomic_load(&rhs.mPainterPathPx));
+  }
   return *this;
 }
 
@@ -320,21 +340,13 @@ Path Path::octagon(const PositiveLength& width,
 
 Path Path::flatArc(const Point& p1, const Point& p2, const Angle& angle,
                    const PositiveLength& maxTolerance) noexcept {
-  // return straight line if radius is smaller than half of the allowed
-  // tolerance
-  Length radiusAbs = Toolbox::arcRadius(p1, p2, angle).abs();
-  if (radiusAbs <= maxTolerance / 2) {
+  // return straight line if the arc is small enough (see
+  // flatArcSegmentCount())
+  int steps = flatArcSegmentCount(p1, p2, angle, maxTolerance);
+  if (steps <= 1) {
     return line(p1, p2);
   }
 
-  // calculate how many lines we need to create
-  qreal radiusAbsNm = static_cast<qreal>(radiusAbs.toNm());
-  qreal y = qBound(qreal(0.0), static_cast<qreal>(maxTolerance->toNm()),
-                   radiusAbsNm / qreal(4));
-  qreal stepsPerRad =
-      qMin(qreal(0.5) / qAcos(1 - y / radiusAbsNm), radiusAbsNm / qreal(2));
-  int steps = qCeil(stepsPerRad * angle.abs().toRad());
-
   // some other very complex calculations...
   qreal angleDelta = angle.toMicroDeg() / (qreal)steps;
   Point center     = Toolbox::arcCenter(p1, p2, angle);
@@ -349,6 +361,24 @@ Path Path::flatArc(const Point& p1, const Point& p2, const Angle& angle,
   return p;
 }
 
+int Path::flatArcSegmentCount(const Point& p1, const Point& p2,
+                              const Angle&          angle,
+                              const PositiveLength& maxTolerance) noexcept {
+  // straight line if radius is smaller than half of the allowed tolerance
+  Length radiusAbs = Toolbox::arcRadius(p1, p2, angle).abs();
+  if (radiusAbs <= maxTolerance / 2) {
+    return 1;
+  }
+
+  // calculate how many lines we need to create
+  qreal radiusAbsNm = static_cast<qreal>(radiusAbs.toNm());
+  qreal y = qBound(qreal(0.0), static_cast<qreal>(maxTolerance->toNm()),
+                   radiusAbsNm / qreal(4));
+  qreal stepsPerRad =
+      qMin(qreal(0.5) / qAcos(1 - y / radiusAbsNm), radiusAbsNm / qreal(2));
+  return qMax(qCeil(stepsPerRad * angle.abs().toRad()), 1);
+}
+
 QPainterPath Path::toQPainterPathPx(const QVector<Path>& paths,
                                     bool                 area) noexcept {
   QPainterPath p;
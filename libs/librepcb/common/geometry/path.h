@@ -27,6 +27,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -56,7 +58,7 @@ public:
   Path() noexcept : mVertices(), mPainterPathPx() {}
   Path(const Path& other) noexcept;
   explicit Path(const QVector<Vertex>& vertices) noexcept
-    : mVertices(vertices) {}
+    : mVertices(vertices), mPainterPathPx() {}
   explicit Path(const SExpression& node);
   ~Path() noexcept {}
 
@@ -69,6 +71,18 @@ public:
   const QVector<Vertex>& getVertices() const noexcept { return mVertices; }
   Path                   toClosedPath() const noexcept;
   QVector<Path> toOutlineStrokes(const PositiveLength& width) const noexcept;
+
+  /**
+   * @brief Get the path as a QPainterPath (in pixels)
+   *
+   * The QPainterPath is created on the first call and then cached until the
+   * path gets modified. Copies of the path share the cached object. This
+   * method may be called from several threads at the same time, as long as
+   * the path is not modified concurrently.
+   *
+   * @return Reference to the cached QPainterPath (valid until the path gets
+   *         modified or destroyed)
+   */
   const QPainterPath& toQPainterPathPx() const noexcept;
 
   // Transformations
@@ -118,6 +132,22 @@ public:
   static Path flatArc(const Point& p1, const Point& p2, const Angle& angle,
                       const PositiveLength& maxTolerance) noexcept;
 
+  /**
+   * @brief Get the number of line segments created by #flatArc()
+   *
+   * Allows to allocate memory for flattened arcs in advance.
+   *
+   * @param p1            Start point of the arc.
+   * @param p2            End point of the arc.
+   * @param angle         Angle of the arc.
+   * @param maxTolerance  Maximum allowed deviation from the exact arc.
+   *
+   * @return Number of line segments (at least 1)
+   */
+  static int flatArcSegmentCount(const Point& p1, const Point& p2,
+                                 const Angle&          angle,
+                                 const PositiveLength& maxTolerance) noexcept;
+
   /**
    * @brief Convert multiple ::librepcb::Path objects to a QPainterPath
    *
@@ -132,13 +162,19 @@ public:
                                        bool                 area) noexcept;
 
 private:  // Methods
-  void invalidatePainterPath() const noexcept {
-    mPainterPathPx = QPainterPath();
+  void invalidatePainterPath() noexcept {
+    std::atomic_store(&mPainterPathPx, std::shared_ptr<const QPainterPath>());
   }
 
 private:  // Data
-  QVector<Vertex>      mVertices;
-  mutable QPainterPath mPainterPathPx;  // cached path for #toQPainterPathPx()
+  QVector<Vertex> mVertices;
+
+  /// Cached path for #toQPainterPathPx() (nullptr if not created yet). It is
+  /// immutable and shared between copies of the path. Since it is created
+  /// lazily within a const method, which might be called from worker threads
+  /// (e.g. DRC or plane builder), it must only be accessed with the atomic
+  /// std::shared_ptr functions.
+  mutable std::shared_ptr<const QPainterPath> mPainterPathPx;
 };
 
 /*******************************************************************************
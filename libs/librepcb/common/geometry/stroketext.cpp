@@ -50,6 +50,7 @@ StrokeText::StrokeText(const StrokeText& other) noexcept
     mAlign(other.mAlign),
     mMirrored(other.mMirrored),
     mAutoRotate(other.mAutoRotate),
+    mTextTemplate(other.mTextTemplate),
     mAttributeProvider(nullptr),
     mFont(nullptr) {
 }
@@ -80,6 +81,7 @@ StrokeText::StrokeText(const Uuid& uuid, const GraphicsLayerName& layerName,
     mAlign(align),
     mMirrored(mirrored),
     mAutoRotate(autoRotate),
+    mTextTemplate(mText),
     mAttributeProvider(nullptr),
     mFont(nullptr) {
 }
@@ -98,6 +100,7 @@ StrokeText::StrokeText(const SExpression& node)
     mAlign(node.getChildByPath("align")),
     mMirrored(node.getValueByPath<bool>("mirror")),
     mAutoRotate(node.getValueByPath<bool>("auto_rotate")),
+    mTextTemplate(mText),
     mAttributeProvider(nullptr),
     mFont(nullptr) {
 }
@@ -167,7 +170,8 @@ bool StrokeText::setText(const QString& text) noexcept {
     return false;
   }
 
-  mText = text;
+  mText         = text;
+  mTextTemplate = AttributeSubstitutor::Template(mText);
   updatePaths();  // because text has changed
   onEdited.notify(Event::TextChanged);
   return true;
@@ -297,17 +301,21 @@ void StrokeText::setFont(const StrokeFont* font) noexcept {
   updatePaths();
 }
 
+void StrokeText::updatePathsIfTextChanged() noexcept {
+  if (mFont && mTextTemplate.dependsOnAttributes() &&
+      (getDisplayedText() != mDisplayedText)) {
+    updatePaths();
+  }
+}
+
 void StrokeText::updatePaths() noexcept {
   QVector<Path> paths;
   Point         center;
   if (mFont) {
-    QString str = mText;
-    if (mAttributeProvider) {
-      str = AttributeSubstitutor::substitute(str, mAttributeProvider);
-    }
+    mDisplayedText = getDisplayedText();
     Point bottomLeft, topRight;
-    paths  = mFont->stroke(str, mHeight, calcLetterSpacing(), calcLineSpacing(),
-                          mAlign, bottomLeft, topRight);
+    paths  = mFont->stroke(mDisplayedText, mHeight, calcLetterSpacing(),
+                          calcLineSpacing(), mAlign, bottomLeft, topRight);
     center = (bottomLeft + topRight) / 2;
   }
   if (paths == mPaths) return;
@@ -376,6 +384,18 @@ StrokeText& StrokeText::operator=(const StrokeText& rhs) noexcept {
   return *this;
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QString StrokeText::getDisplayedText() const noexcept {
+  if (mAttributeProvider) {
+    return AttributeSubstitutor::substitute(mTextTemplate, mAttributeProvider);
+  } else {
+    return mText;
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
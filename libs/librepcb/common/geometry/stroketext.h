@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include "../alignment.h"
+#include "../attributes/attributesubstitutor.h"
 #include "../fileio/cmd/cmdlistelementinsert.h"
 #include "../fileio/cmd/cmdlistelementremove.h"
 #include "../fileio/cmd/cmdlistelementsswap.h"
@@ -193,6 +194,14 @@ public:
   const StrokeFont* getCurrentFont() const noexcept { return mFont; }
   void              updatePaths() noexcept;
 
+  /**
+   * @brief Update the paths only if the displayed text has changed
+   *
+   * Much cheaper than #updatePaths() if the substituted attributes still
+   * have the same values, thus to be called when attributes have changed.
+   */
+  void updatePathsIfTextChanged() noexcept;
+
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
 
@@ -203,6 +212,9 @@ public:
   }
   StrokeText& operator=(const StrokeText& rhs) noexcept;
 
+private:  // Methods
+  QString getDisplayedText() const noexcept;
+
 private:  // Data
   Uuid              mUuid;
   GraphicsLayerName mLayerName;
@@ -217,6 +229,10 @@ private:  // Data
   bool              mMirrored;
   bool              mAutoRotate;
 
+  // Cached Attributes
+  AttributeSubstitutor::Template mTextTemplate;   ///< parsed #mText
+  QString                        mDisplayedText;  ///< text of #mPaths
+
   // Misc
   const AttributeProvider*
                     mAttributeProvider;  ///< for substituting placeholders in text
@@ -102,6 +102,7 @@ DefaultGraphicsLayerProvider::DefaultGraphicsLayerProvider() noexcept {
 }
 
 DefaultGraphicsLayerProvider::~DefaultGraphicsLayerProvider() noexcept {
+  mLayersByName.clear();
   qDeleteAll(mLayers);
   mLayers.clear();
 }
@@ -112,12 +113,7 @@ DefaultGraphicsLayerProvider::~DefaultGraphicsLayerProvider() noexcept {
 
 GraphicsLayer* DefaultGraphicsLayerProvider::getLayer(const QString& name) const
     noexcept {
-  foreach (GraphicsLayer* layer, mLayers) {
-    if (layer->getName() == name) {
-      return layer;
-    }
-  }
-  return nullptr;
+  return mLayersByName.value(name, nullptr);
 }
 
 /*******************************************************************************
@@ -126,7 +122,9 @@ GraphicsLayer* DefaultGraphicsLayerProvider::getLayer(const QString& name) const
 
 void DefaultGraphicsLayerProvider::addLayer(const QString& name) noexcept {
   if (!getLayer(name)) {
-    mLayers.append(new GraphicsLayer(name));
+    GraphicsLayer* layer = new GraphicsLayer(name);
+    mLayers.append(layer);
+    mLayersByName.insert(name, layer);
   }
 }
 
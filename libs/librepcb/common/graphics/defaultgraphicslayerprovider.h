@@ -54,7 +54,8 @@ public:
 private:
   void addLayer(const QString& name) noexcept;
 
-  QList<GraphicsLayer*> mLayers;
+  QList<GraphicsLayer*>          mLayers;
+  QHash<QString, GraphicsLayer*> mLayersByName;  ///< Same as #mLayers
 };
 
 /*******************************************************************************
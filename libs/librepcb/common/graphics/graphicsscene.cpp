@@ -24,6 +24,7 @@
 
 #include "../units/point.h"
 
+#include <QPrinter>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -37,7 +38,7 @@ namespace librepcb {
  ******************************************************************************/
 
 GraphicsScene::GraphicsScene() noexcept
-  : QGraphicsScene(nullptr), mSelectionRectItem(nullptr) {
+  : QGraphicsScene(nullptr), mSelectionRectItem(nullptr), mPrintMode(false) {
   /*QBrush selectBrush = QGuiApplication::palette().highlight();
   QColor selectColor = selectBrush.color();
   selectColor.setAlpha(50);
@@ -93,6 +94,59 @@ QPixmap GraphicsScene::toPixmap(const QSize&  size,
   return pixmap;
 }
 
+QImage GraphicsScene::toImage(const QSize&  size,
+                              const QColor& background) noexcept {
+  // In contrast to QPixmap, QImage can also be used outside the GUI thread.
+  QRectF rect = itemsBoundingRect();
+  QImage image(size, QImage::Format_ARGB32_Premultiplied);
+  image.fill(background);
+  QPainter painter(&image);
+  painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing |
+                         QPainter::SmoothPixmapTransform);
+  render(&painter, QRectF(), rect, Qt::KeepAspectRatio);
+  return image;
+}
+
+void GraphicsScene::scheduleUpdate(const QRectF& rect) noexcept {
+  if (rect.isEmpty()) {
+    return;
+  }
+  if (mScheduledUpdateRect.isEmpty()) {
+    QTimer::singleShot(0, this, &GraphicsScene::flushScheduledUpdate);
+  }
+  mScheduledUpdateRect |= rect;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+bool GraphicsScene::isPrinting(const QPainter&      painter,
+                               const QGraphicsItem& item) noexcept {
+  if (dynamic_cast<QPrinter*>(painter.device())) {
+    return true;
+  }
+  const GraphicsScene* scene = qobject_cast<GraphicsScene*>(item.scene());
+  return scene && scene->mPrintMode;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void GraphicsScene::flushScheduledUpdate() noexcept {
+  QRectF rect = mScheduledUpdateRect;
+  mScheduledUpdateRect = QRectF();
+  foreach (const QGraphicsView* view, views()) {
+    QRectF visibleRect =
+        view->mapToScene(view->viewport()->rect()).boundingRect();
+    if (view->isVisible() && visibleRect.intersects(rect)) {
+      update(rect);
+      return;
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
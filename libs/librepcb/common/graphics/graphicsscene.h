@@ -56,9 +56,60 @@ public:
                    const QColor& background = Qt::transparent) noexcept;
   QPixmap toPixmap(const QSize&  size,
                    const QColor& background = Qt::transparent) noexcept;
+  QImage  toImage(const QSize&  size,
+                  const QColor& background = Qt::transparent) noexcept;
 
-private:
+  /**
+   * @brief Schedule a repaint of an area of the scene
+   *
+   * All areas scheduled until control returns to the event loop are merged
+   * into a single rect which is invalidated at once, and nothing is repainted
+   * if that rect is not visible in any view. This is much cheaper than calling
+   * QGraphicsItem::update() on many items at once, e.g. when highlighting a
+   * net signal.
+   *
+   * @param rect    The area to repaint, in scene coordinates
+   */
+  void scheduleUpdate(const QRectF& rect) noexcept;
+
+  /**
+   * @brief Enable or disable the print mode
+   *
+   * While enabled, all items are painted as if the scene was rendered into a
+   * QPrinter (see #isPrinting()). This is needed when rendering into another
+   * paint device which is printed later, e.g. a QPicture.
+   *
+   * @warning The scene must not be visible in any view while the print mode
+   *          is enabled.
+   *
+   * @param enabled   Whether the print mode is enabled or not.
+   */
+  void setPrintMode(bool enabled) noexcept { mPrintMode = enabled; }
+
+  // Static Methods
+
+  /**
+   * @brief Check whether a graphics item is painted for printing
+   *
+   * Graphics items use this to hide things only useful on screen (e.g. origin
+   * crosses), and to paint all details independent of the level of detail.
+   *
+   * @param painter   The painter passed to QGraphicsItem::paint().
+   * @param item      The painted item.
+   *
+   * @return True if painting into a QPrinter, or if the print mode of the
+   *         item's scene is enabled (see #setPrintMode()).
+   */
+  static bool isPrinting(const QPainter&      painter,
+                         const QGraphicsItem& item) noexcept;
+
+private:  // Methods
+  void flushScheduledUpdate() noexcept;
+
+private:  // Data
   QGraphicsRectItem* mSelectionRectItem;
+  bool               mPrintMode;
+  QRectF             mScheduledUpdateRect;  ///< Empty if nothing scheduled
 };
 
 /*******************************************************************************
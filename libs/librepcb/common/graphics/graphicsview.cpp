@@ -49,6 +49,20 @@ GraphicsView::GraphicsView(QWidget*                     parent,
     mSceneRectMarker(),
     mOriginCrossVisible(true),
     mUseOpenGl(false),
+    mUseTileCache(false),
+    mTileCache(512),
+    mTileCacheScale(0),
+    mTileCacheDevicePixelRatio(0),
+    mGridTileCache(512),
+    mGridTileCacheScale(0),
+    mGridTileCacheDevicePixelRatio(0),
+    mGridTileCacheBackground(),
+    mPerformanceOverlayVisible(false),
+    mFrameStatisticsTimer(),
+    mFrameStatistics(),
+    mLastFrameTimeMs(0),
+    mPendingSceneUpdates(0),
+    mPendingIndexRebuilds(0),
     mPanningActive(false) {
   setRenderHints(QPainter::Antialiasing | QPainter::SmoothPixmapTransform);
   setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
@@ -95,12 +109,28 @@ void GraphicsView::setUseOpenGl(bool useOpenGl) noexcept {
       format.setSamples(8);
       format.setStencilBufferSize(8);
       format.setSwapBehavior(QSurfaceFormat::DoubleBuffer);
-      QOpenGLWidget* viewport = new QOpenGLWidget();
-      viewport->setFormat(format);
-      setViewport(viewport);
+      // QOpenGLWidget does not report errors before it gets shown, so check
+      // in advance whether an OpenGL context can be created at all.
+      QOpenGLContext context;
+      context.setFormat(format);
+      if (context.create()) {
+        QOpenGLWidget* viewport = new QOpenGLWidget();
+        viewport->setFormat(format);
+        setViewport(viewport);
+      } else {
+        qWarning() << "Failed to create OpenGL context, falling back to the "
+                      "raster viewport.";
+        useOpenGl = false;
+      }
 #else
-      setViewport(new QGLWidget(QGLFormat(
-          QGL::DoubleBuffer | QGL::AlphaChannel | QGL::SampleBuffers)));
+      if (QGLFormat::hasOpenGL()) {
+        setViewport(new QGLWidget(QGLFormat(
+            QGL::DoubleBuffer | QGL::AlphaChannel | QGL::SampleBuffers)));
+      } else {
+        qWarning() << "OpenGL is not supported, falling back to the raster "
+                      "viewport.";
+        useOpenGl = false;
+      }
 #endif
     } else {
       setViewport(nullptr);
@@ -110,17 +140,49 @@ void GraphicsView::setUseOpenGl(bool useOpenGl) noexcept {
   viewport()->grabGesture(Qt::PinchGesture);
 }
 
+void GraphicsView::setUseTileCache(bool useTileCache) noexcept {
+  mUseTileCache = useTileCache;
+  mTileCache.clear();
+  viewport()->update();
+}
+
 void GraphicsView::setGridProperties(
     const GridProperties& properties) noexcept {
   *mGridProperties = properties;
+  mGridTileCache.clear();
   setBackgroundBrush(backgroundBrush());  // this will repaint the background
 }
 
+void GraphicsView::setPerformanceOverlayVisible(bool visible) noexcept {
+  if (visible && (!mPerformanceOverlayVisible)) {
+    // start a new recording
+    mFrameStatistics.clear();
+    mFrameStatisticsTimer.start();
+    mPendingSceneUpdates  = 0;
+    mPendingIndexRebuilds = 0;
+  }
+  mPerformanceOverlayVisible = visible;
+  setForegroundBrush(foregroundBrush());  // this will repaint the foreground
+}
+
 void GraphicsView::setScene(GraphicsScene* scene) noexcept {
   mSceneRectMarker = QRectF();  // clear marker
-  if (mScene) mScene->removeEventFilter(this);
+  if (mScene) {
+    mScene->removeEventFilter(this);
+    disconnect(mScene, &GraphicsScene::changed, this,
+               &GraphicsView::sceneChanged);
+    disconnect(mScene, &GraphicsScene::sceneRectChanged, this,
+               &GraphicsView::sceneRectChanged);
+  }
   mScene = scene;
-  if (mScene) mScene->installEventFilter(this);
+  mTileCache.clear();
+  if (mScene) {
+    mScene->installEventFilter(this);
+    connect(mScene, &GraphicsScene::changed, this,
+            &GraphicsView::sceneChanged);
+    connect(mScene, &GraphicsScene::sceneRectChanged, this,
+            &GraphicsView::sceneRectChanged);
+  }
   QGraphicsView::setScene(mScene);
 }
 
@@ -186,6 +248,37 @@ void GraphicsView::handleMouseWheelEvent(
   event->setAccepted(true);
 }
 
+qreal GraphicsView::measureFrameTime(int frames) noexcept {
+  QElapsedTimer timer;
+  timer.start();
+  for (int i = 0; i < frames; ++i) {
+    viewport()->repaint();
+  }
+  if (mUseOpenGl) {
+    // rendering is asynchronous, so wait until the GPU has finished
+#if QT_VERSION >= QT_VERSION_CHECK(5, 4, 0)
+    if (QOpenGLWidget* widget = dynamic_cast<QOpenGLWidget*>(viewport())) {
+      widget->grabFramebuffer();
+    }
+#endif
+  }
+  return qreal(timer.nsecsElapsed()) / (1000000 * qMax(frames, 1));
+}
+
+QString GraphicsView::getFrameStatisticsCsv() const noexcept {
+  QString csv =
+      "timestamp_ms,frame_time_ms,painted_items,scene_updates,index_rebuilds\n";
+  foreach (const FrameStatistics& frame, mFrameStatistics) {
+    csv += QString("%1,%2,%3,%4,%5\n")
+               .arg(frame.timestampMs)
+               .arg(frame.frameTimeMs, 0, 'f', 3)
+               .arg(frame.paintedItems)
+               .arg(frame.sceneUpdates)
+               .arg(frame.indexRebuilds);
+  }
+  return csv;
+}
+
 /*******************************************************************************
  *  Public Slots
  ******************************************************************************/
@@ -227,6 +320,27 @@ void GraphicsView::zoomAnimationValueChanged(const QVariant& value) noexcept {
     fitInView(value.toRectF(), Qt::KeepAspectRatio);  // zoom smoothly
 }
 
+void GraphicsView::sceneChanged(const QList<QRectF>& region) noexcept {
+  // Invalidate only the tiles affected by the changes, all other tiles can
+  // still be used.
+  foreach (quint64 key, mTileCache.keys()) {
+    QRectF tileRect = getTileSceneRect(key, mTileCacheScale);
+    foreach (const QRectF& rect, region) {
+      if (rect.intersects(tileRect)) {
+        mTileCache.remove(key);
+        break;
+      }
+    }
+  }
+  mPendingSceneUpdates += region.count();
+}
+
+void GraphicsView::sceneRectChanged() noexcept {
+  // The BSP index of the scene gets rebuilt when the scene rect changes, so
+  // this is used as an approximation of the index rebuilds.
+  ++mPendingIndexRebuilds;
+}
+
 /*******************************************************************************
  *  Inherited from QGraphicsView
  ******************************************************************************/
@@ -329,21 +443,199 @@ bool GraphicsView::eventFilter(QObject* obj, QEvent* event) {
 }
 
 void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect) {
+  // Only the viewport can be drawn from the cached grid tiles, and only if it
+  // is neither rotated nor sheared (other devices are used for printing).
+  const QTransform t = painter->worldTransform();
+  if ((painter->device() != viewport()) || (t.type() > QTransform::TxScale) ||
+      (t.m11() <= 0) || (t.m11() != t.m22())) {
+    painter->save();
+    renderBackground(*painter, rect);
+    painter->restore();
+    return;
+  }
+
+  // Rendering the grid is expensive (especially the dots of a fine grid), so
+  // it is rendered into tiles which are reused as long as the zoom level,
+  // the background and the grid don't change (e.g. while panning).
+  const int dpr = viewport()->devicePixelRatio();
+  if ((t.m11() != mGridTileCacheScale) ||
+      (dpr != mGridTileCacheDevicePixelRatio) ||
+      (backgroundBrush() != mGridTileCacheBackground)) {
+    mGridTileCache.clear();
+    mGridTileCacheScale            = t.m11();
+    mGridTileCacheDevicePixelRatio = dpr;
+    mGridTileCacheBackground       = backgroundBrush();
+  }
+
+  // draw tiles aligned to device pixels, like the tiles of the items
+  painter->save();
+  painter->resetTransform();
+  const QPoint offset(qRound(t.dx()), qRound(t.dy()));
+  const QRect  deviceRect = t.mapRect(rect).toAlignedRect().translated(-offset);
+  const int    left       = qFloor(qreal(deviceRect.left()) / sTileSizePx);
+  const int    right      = qFloor(qreal(deviceRect.right()) / sTileSizePx);
+  const int    top        = qFloor(qreal(deviceRect.top()) / sTileSizePx);
+  const int    bottom     = qFloor(qreal(deviceRect.bottom()) / sTileSizePx);
+  for (int column = left; column <= right; ++column) {
+    for (int row = top; row <= bottom; ++row) {
+      quint64 key = (quint64(quint32(column)) << 32) | quint32(row);
+      painter->drawPixmap(QPoint(column, row) * sTileSizePx + offset,
+                          getGridTile(key));
+    }
+  }
+  painter->restore();
+}
+
+void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect) {
+  Q_UNUSED(rect);
+
+  QPen originPen(foregroundBrush().color());
+  originPen.setWidth(0);
+  painter->setPen(originPen);
+  painter->setBrush(Qt::NoBrush);
+
+  if (mOriginCrossVisible) {
+    // draw origin cross
+    qreal len = Length::fromMm(2.54).toPx();
+    painter->drawLine(QLineF(-len, 0.0, len, 0.0));
+    painter->drawLine(QLineF(0.0, -len, 0.0, len));
+  }
+
+  if ((!mSceneRectMarker.isEmpty()) && (mScene)) {
+    // draw scene rect marker
+    painter->drawRect(mSceneRectMarker);
+    painter->drawLine(mapToScene(0, 0), mSceneRectMarker.topLeft());
+  }
+
+  if (mPerformanceOverlayVisible) {
+    drawPerformanceOverlay(*painter);
+  }
+}
+
+void GraphicsView::paintEvent(QPaintEvent* event) {
+  if (!mPerformanceOverlayVisible) {
+    QElapsedTimer timer;
+    timer.start();
+    paintViewport(event);
+    mLastFrameTimeMs = qreal(timer.nsecsElapsed()) / 1000000;
+    return;
+  }
+
+  FrameStatistics frame;
+  frame.timestampMs   = mFrameStatisticsTimer.elapsed();
+  frame.paintedItems  = 0;
+  frame.sceneUpdates  = mPendingSceneUpdates;
+  frame.indexRebuilds = mPendingIndexRebuilds;
+  if (mScene) {
+    QRectF exposedSceneRect = mapToScene(event->rect()).boundingRect();
+    foreach (const QGraphicsItem* item,
+             mScene->items(exposedSceneRect, Qt::IntersectsItemBoundingRect)) {
+      if (item->isVisible()) {
+        ++frame.paintedItems;
+      }
+    }
+  }
+
+  QElapsedTimer timer;
+  timer.start();
+  paintViewport(event);
+  frame.frameTimeMs = qreal(timer.nsecsElapsed()) / 1000000;
+  mLastFrameTimeMs  = frame.frameTimeMs;
+
+  mFrameStatistics.append(frame);
+  while (mFrameStatistics.count() > sMaxFrameStatistics) {
+    mFrameStatistics.removeFirst();
+  }
+  mPendingSceneUpdates  = 0;
+  mPendingIndexRebuilds = 0;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool GraphicsView::isTileCacheApplicable() const noexcept {
+  // Tiles can only be blitted if the view is neither rotated nor sheared.
+  const QTransform& t = transform();
+  return mScene && (t.type() <= QTransform::TxScale) && (t.m11() > 0) &&
+         (t.m11() == t.m22());
+}
+
+QRectF GraphicsView::getTileSceneRect(quint64 key, qreal scale) const
+    noexcept {
+  qreal column = qint32(key >> 32);
+  qreal row    = qint32(key & 0xFFFFFFFF);
+  qreal size   = sTileSizePx / scale;
+  return QRectF(column * size, row * size, size, size);
+}
+
+const QPixmap& GraphicsView::getTile(quint64 key) noexcept {
+  if (QPixmap* tile = mTileCache.object(key)) {
+    return *tile;
+  }
+  const int dpr  = mTileCacheDevicePixelRatio;
+  QPixmap*  tile = new QPixmap(sTileSizePx * dpr, sTileSizePx * dpr);
+  tile->setDevicePixelRatio(dpr);
+  tile->fill(Qt::transparent);
+  {
+    QPainter painter(tile);
+    painter.setRenderHints(renderHints());
+    mScene->render(&painter, QRectF(0, 0, sTileSizePx, sTileSizePx),
+                   getTileSceneRect(key, mTileCacheScale),
+                   Qt::IgnoreAspectRatio);
+  }
+  // Note: The cache takes ownership of the tile. Since its cost is much
+  // lower than the maximum cost, the tile is not deleted before the next
+  // tile gets inserted.
+  mTileCache.insert(key, tile, dpr * dpr);
+  return *tile;
+}
+
+const QPixmap& GraphicsView::getGridTile(quint64 key) noexcept {
+  if (QPixmap* tile = mGridTileCache.object(key)) {
+    return *tile;
+  }
+  const int   dpr    = mGridTileCacheDevicePixelRatio;
+  const qreal scale  = mGridTileCacheScale;
+  const qreal column = qint32(key >> 32);
+  const qreal row    = qint32(key & 0xFFFFFFFF);
+  QPixmap*    tile   = new QPixmap(sTileSizePx * dpr, sTileSizePx * dpr);
+  tile->setDevicePixelRatio(dpr);
+  {
+    QPainter painter(tile);
+    painter.setRenderHints(renderHints());
+    painter.setWorldTransform(QTransform(scale, 0, 0, scale,
+                                         -column * sTileSizePx,
+                                         -row * sTileSizePx));
+    // Add a small margin to also get the parts of dots and lines which are
+    // located on the neighbour tiles.
+    qreal margin = 2 / scale;
+    renderBackground(painter, getTileSceneRect(key, scale)
+                                  .adjusted(-margin, -margin, margin, margin));
+  }
+  mGridTileCache.insert(key, tile, dpr * dpr);
+  return *tile;
+}
+
+void GraphicsView::renderBackground(QPainter&     painter,
+                                    const QRectF& rect) noexcept {
   QPen gridPen(Qt::gray);
   gridPen.setCosmetic(true);
 
   // draw background color
-  painter->setPen(Qt::NoPen);
-  painter->setBrush(backgroundBrush());
-  painter->fillRect(rect, backgroundBrush());
+  painter.setPen(Qt::NoPen);
+  painter.setBrush(backgroundBrush());
+  painter.fillRect(rect, backgroundBrush());
 
   // draw background grid lines
   gridPen.setWidth(
       (mGridProperties->getType() == GridProperties::Type_t::Dots) ? 2 : 1);
-  painter->setPen(gridPen);
-  painter->setBrush(Qt::NoBrush);
+  painter.setPen(gridPen);
+  painter.setBrush(Qt::NoBrush);
   qreal gridIntervalPixels = mGridProperties->getInterval()->toPx();
-  qreal scaleFactor        = width() / rect.width();
+  // Note: The rect is not necessarily the whole viewport (e.g. with partial
+  // updates or tiles), so take the scale factor from the transform.
+  qreal scaleFactor = transform().m11();
   if (gridIntervalPixels * scaleFactor >= (qreal)5) {
     qreal left, right, top, bottom;
     left   = qFloor(rect.left() / gridIntervalPixels) * gridIntervalPixels;
@@ -357,8 +649,8 @@ void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect) {
           lines.append(QLineF(x, rect.top(), x, rect.bottom()));
         for (qreal y = bottom; y > top; y -= gridIntervalPixels)
           lines.append(QLineF(rect.left(), y, rect.right(), y));
-        painter->setOpacity(0.5);
-        painter->drawLines(lines.data(), lines.size());
+        painter.setOpacity(0.5);
+        painter.drawLines(lines.data(), lines.size());
         break;
       }
 
@@ -367,7 +659,7 @@ void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect) {
         for (qreal x = left; x < right; x += gridIntervalPixels)
           for (qreal y = bottom; y > top; y -= gridIntervalPixels)
             dots.append(QPointF(x, y));
-        painter->drawPoints(dots.data(), dots.size());
+        painter.drawPoints(dots.data(), dots.size());
         break;
       }
 
@@ -377,26 +669,78 @@ void GraphicsView::drawBackground(QPainter* painter, const QRectF& rect) {
   }
 }
 
-void GraphicsView::drawForeground(QPainter* painter, const QRectF& rect) {
-  Q_UNUSED(rect);
-
-  QPen originPen(foregroundBrush().color());
-  originPen.setWidth(0);
-  painter->setPen(originPen);
-  painter->setBrush(Qt::NoBrush);
+void GraphicsView::paintViewport(QPaintEvent* event) noexcept {
+  if ((!mUseTileCache) || (!isTileCacheApplicable())) {
+    QGraphicsView::paintEvent(event);
+    return;
+  }
 
-  if (mOriginCrossVisible) {
-    // draw origin cross
-    qreal len = Length::fromMm(2.54).toPx();
-    painter->drawLine(QLineF(-len, 0.0, len, 0.0));
-    painter->drawLine(QLineF(0.0, -len, 0.0, len));
+  // When zooming, all cached tiles become invalid.
+  const QTransform transform = viewportTransform();
+  const int        dpr       = viewport()->devicePixelRatio();
+  if ((transform.m11() != mTileCacheScale) ||
+      (dpr != mTileCacheDevicePixelRatio)) {
+    mTileCache.clear();
+    mTileCacheScale            = transform.m11();
+    mTileCacheDevicePixelRatio = dpr;
   }
 
-  if ((!mSceneRectMarker.isEmpty()) && (mScene)) {
-    // draw scene rect marker
-    painter->drawRect(mSceneRectMarker);
-    painter->drawLine(mapToScene(0, 0), mSceneRectMarker.topLeft());
+  QPainter painter(viewport());
+  painter.setRenderHints(renderHints());
+  QRectF exposedSceneRect = transform.inverted()
+                                .mapRect(QRectF(event->rect()))
+                                .adjusted(-1, -1, 1, 1);
+
+  // draw background
+  painter.setWorldTransform(transform);
+  drawBackground(&painter, exposedSceneRect);
+
+  // draw items by blitting the tiles, aligned to device pixels
+  painter.resetTransform();
+  const QPoint offset(qRound(transform.dx()), qRound(transform.dy()));
+  const QRect  exposedRect = event->rect().translated(-offset);
+  const int    left        = qFloor(qreal(exposedRect.left()) / sTileSizePx);
+  const int    right       = qFloor(qreal(exposedRect.right()) / sTileSizePx);
+  const int    top         = qFloor(qreal(exposedRect.top()) / sTileSizePx);
+  const int    bottom      = qFloor(qreal(exposedRect.bottom()) / sTileSizePx);
+  for (int column = left; column <= right; ++column) {
+    for (int row = top; row <= bottom; ++row) {
+      quint64 key = (quint64(quint32(column)) << 32) | quint32(row);
+      painter.drawPixmap(QPoint(column, row) * sTileSizePx + offset,
+                         getTile(key));
+    }
   }
+
+  // draw foreground
+  painter.setWorldTransform(transform);
+  drawForeground(&painter, exposedSceneRect);
+}
+
+void GraphicsView::drawPerformanceOverlay(QPainter& painter) noexcept {
+  if (mFrameStatistics.isEmpty()) return;
+  const FrameStatistics& frame = mFrameStatistics.last();
+  QStringList            lines;
+  lines << QString("Frame time:     %1 ms").arg(frame.frameTimeMs, 0, 'f', 2);
+  lines << QString("Painted items:  %1").arg(frame.paintedItems);
+  lines << QString("Scene updates:  %1").arg(frame.sceneUpdates);
+  lines << QString("Index rebuilds: %1").arg(frame.indexRebuilds);
+  const QString text = lines.join("\n");
+
+  // draw in device coordinates to get the same size at any zoom level
+  painter.save();
+  painter.resetTransform();
+  QFont font("Monospace");
+  font.setStyleHint(QFont::TypeWriter);
+  painter.setFont(font);
+  QRect textRect = painter.fontMetrics().boundingRect(
+      QRect(0, 0, width(), height()), Qt::AlignLeft | Qt::AlignTop, text);
+  textRect.moveTopLeft(QPoint(10, 10));
+  painter.setPen(Qt::NoPen);
+  painter.setBrush(QColor(0, 0, 0, 160));
+  painter.drawRect(textRect.adjusted(-5, -5, 5, 5));
+  painter.setPen(Qt::white);
+  painter.drawText(textRect, Qt::AlignLeft | Qt::AlignTop, text);
+  painter.restore();
 }
 
 /*******************************************************************************
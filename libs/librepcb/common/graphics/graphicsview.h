@@ -58,13 +58,45 @@ public:
   GraphicsScene*        getScene() const noexcept { return mScene; }
   QRectF                getVisibleSceneRect() const noexcept;
   bool                  getUseOpenGl() const noexcept { return mUseOpenGl; }
+  bool                  getUseTileCache() const noexcept {
+    return mUseTileCache;
+  }
+  bool                  getPerformanceOverlayVisible() const noexcept {
+    return mPerformanceOverlayVisible;
+  }
+  qreal                 getLastFrameTimeMs() const noexcept {
+    return mLastFrameTimeMs;
+  }
   const GridProperties& getGridProperties() const noexcept {
     return *mGridProperties;
   }
 
   // Setters
   void setUseOpenGl(bool useOpenGl) noexcept;
+
+  /**
+   * @brief Enable or disable the tile based render cache
+   *
+   * If enabled, the scene items are rendered into pixmap tiles at the current
+   * zoom level and the view is painted by only blitting these tiles. Tiles are
+   * invalidated when the scene reports changes in their area, or when the
+   * zoom level changes. This makes panning over large scenes much faster.
+   *
+   * @param useTileCache  Whether the tile cache should be used or not.
+   */
+  void setUseTileCache(bool useTileCache) noexcept;
   void setGridProperties(const GridProperties& properties) noexcept;
+
+  /**
+   * @brief Show or hide the performance overlay
+   *
+   * If visible, statistics about every painted frame are recorded and the
+   * values of the last frame are shown in the top left corner of the view.
+   * The recorded statistics can be exported with #getFrameStatisticsCsv().
+   *
+   * @param visible   Whether the overlay should be shown or not.
+   */
+  void setPerformanceOverlayVisible(bool visible) noexcept;
   void setScene(GraphicsScene* scene) noexcept;
   void setVisibleSceneRect(const QRectF& rect) noexcept;
 
@@ -87,6 +119,31 @@ public:
                                bool mapToGrid) const noexcept;
   void  handleMouseWheelEvent(QGraphicsSceneWheelEvent* event) noexcept;
 
+  /**
+   * @brief Measure the time needed to paint the viewport
+   *
+   * Repaints the viewport synchronously several times with the current zoom
+   * level and scene content. This allows to compare the performance of the
+   * raster and OpenGL viewports (see #setUseOpenGl()) and of the tile cache
+   * (see #setUseTileCache()).
+   *
+   * @param frames  Number of frames to paint.
+   *
+   * @return Average frame time in milliseconds.
+   */
+  qreal measureFrameTime(int frames = 10) noexcept;
+
+  /**
+   * @brief Get the recorded frame statistics as CSV
+   *
+   * Frames are only recorded while the performance overlay is visible (see
+   * #setPerformanceOverlayVisible()), and only the most recent frames are
+   * kept.
+   *
+   * @return CSV with a header row and one row per frame
+   */
+  QString getFrameStatisticsCsv() const noexcept;
+
 public slots:
 
   // Public Slots
@@ -107,8 +164,19 @@ private slots:
 
   // Private Slots
   void zoomAnimationValueChanged(const QVariant& value) noexcept;
+  void sceneChanged(const QList<QRectF>& region) noexcept;
+  void sceneRectChanged() noexcept;
 
 private:
+  // Types
+  struct FrameStatistics {
+    qint64 timestampMs;    ///< Time since the recording was started
+    qreal  frameTimeMs;    ///< Duration of the paint event
+    int    paintedItems;   ///< Visible items within the exposed area
+    int    sceneUpdates;   ///< Areas updated in the scene since last frame
+    int    indexRebuilds;  ///< Scene rect changes since last frame
+  };
+
   // make some methods inaccessible...
   GraphicsView(const GraphicsView& other) = delete;
   GraphicsView& operator=(const GraphicsView& rhs) = delete;
@@ -118,6 +186,17 @@ private:
   bool eventFilter(QObject* obj, QEvent* event);
   void drawBackground(QPainter* painter, const QRectF& rect);
   void drawForeground(QPainter* painter, const QRectF& rect);
+  void paintEvent(QPaintEvent* event);
+
+  // Private Methods
+  bool           isTileCacheApplicable() const noexcept;
+  QRectF         getTileSceneRect(quint64 key, qreal scale) const noexcept;
+  const QPixmap& getTile(quint64 key) noexcept;
+  const QPixmap& getGridTile(quint64 key) noexcept;
+  void           renderBackground(QPainter&     painter,
+                                  const QRectF& rect) noexcept;
+  void           paintViewport(QPaintEvent* event) noexcept;
+  void           drawPerformanceOverlay(QPainter& painter) noexcept;
 
   // General Attributes
   IF_GraphicsViewEventHandler* mEventHandlerObject;
@@ -127,11 +206,27 @@ private:
   QRectF                       mSceneRectMarker;
   bool                         mOriginCrossVisible;
   bool                         mUseOpenGl;
+  bool                         mUseTileCache;
+  QCache<quint64, QPixmap>     mTileCache;  ///< Key: Tile column and row
+  qreal                        mTileCacheScale;  ///< Zoom of cached tiles
+  int                          mTileCacheDevicePixelRatio;
+  QCache<quint64, QPixmap>     mGridTileCache;  ///< Key: Tile column and row
+  qreal                        mGridTileCacheScale;  ///< Zoom of cached tiles
+  int                          mGridTileCacheDevicePixelRatio;
+  QBrush                       mGridTileCacheBackground;
+  bool                         mPerformanceOverlayVisible;
+  QElapsedTimer                mFrameStatisticsTimer;
+  QList<FrameStatistics>       mFrameStatistics;  ///< Most recent last
+  qreal                        mLastFrameTimeMs;  ///< Always recorded
+  int                          mPendingSceneUpdates;
+  int                          mPendingIndexRebuilds;
   volatile bool                mPanningActive;
   QCursor                      mCursorBeforePanning;
 
   // Static Variables
-  static constexpr qreal sZoomStepFactor = 1.3;
+  static constexpr qreal sZoomStepFactor     = 1.3;
+  static constexpr int   sTileSizePx         = 256;  ///< Tile size (px)
+  static constexpr int   sMaxFrameStatistics = 1000;  ///< Recorded frames
 };
 
 /*******************************************************************************
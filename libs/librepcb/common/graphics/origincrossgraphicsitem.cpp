@@ -22,7 +22,8 @@
  ******************************************************************************/
 #include "origincrossgraphicsitem.h"
 
-#include <QPrinter>
+#include "graphicsscene.h"
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -101,8 +102,7 @@ void OriginCrossGraphicsItem::paint(QPainter*                       painter,
   Q_UNUSED(widget);
 
   const bool isSelected = option->state.testFlag(QStyle::State_Selected);
-  const bool deviceIsPrinter =
-      (dynamic_cast<QPrinter*>(painter->device()) != nullptr);
+  const bool deviceIsPrinter = GraphicsScene::isPrinting(*painter, *this);
 
   if (deviceIsPrinter && (!mVisibleInPrintOutput)) {
     return;
@@ -23,8 +23,8 @@
 #include "primitivecirclegraphicsitem.h"
 
 #include "../toolbox.h"
+#include "graphicsscene.h"
 
-#include <QPrinter>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -112,8 +112,7 @@ void PrimitiveCircleGraphicsItem::paint(QPainter*                       painter,
   Q_UNUSED(widget);
 
   const bool isSelected = option->state.testFlag(QStyle::State_Selected);
-  const bool deviceIsPrinter =
-      (dynamic_cast<QPrinter*>(painter->device()) != nullptr);
+  const bool deviceIsPrinter = GraphicsScene::isPrinting(*painter, *this);
 
   QPen   pen   = isSelected ? mPenHighlighted : mPen;
   QBrush brush = isSelected ? mBrushHighlighted : mBrush;
@@ -23,8 +23,8 @@
 #include "primitivepathgraphicsitem.h"
 
 #include "../toolbox.h"
+#include "graphicsscene.h"
 
-#include <QPrinter>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -119,8 +119,7 @@ void PrimitivePathGraphicsItem::paint(QPainter*                       painter,
   Q_UNUSED(widget);
 
   const bool isSelected = option->state.testFlag(QStyle::State_Selected);
-  const bool deviceIsPrinter =
-      (dynamic_cast<QPrinter*>(painter->device()) != nullptr);
+  const bool deviceIsPrinter = GraphicsScene::isPrinting(*painter, *this);
 
   QPen   pen   = isSelected ? mPenHighlighted : mPen;
   QBrush brush = isSelected ? mBrushHighlighted : mBrush;
@@ -46,7 +46,12 @@ FileDownload::FileDownload(const QUrl& url, const FilePath& dest) noexcept
     mDestination(dest),
     mHashAlgorithm(QCryptographicHash::Md5),
     mExpectedChecksum(),
-    mExtractZipToDir() {
+    mExtractZipToDir(),
+    mResumeOffset(0),
+    mResumeChecked(false) {
+  // Downloaded files are written to disk anyway and might be large, so don't
+  // pollute the HTTP cache with them.
+  mRequest.setAttribute(QNetworkRequest::CacheSaveControlAttribute, false);
 }
 
 FileDownload::~FileDownload() noexcept {
@@ -89,12 +94,32 @@ void FileDownload::prepareRequest() {
     }
   }
 
-  // open temporary destination file
-  mFile.reset(new QSaveFile(mDestination.toStr(), this));
-  if (!mFile->open(QIODevice::WriteOnly)) {
+  // Open the partial destination file. It is kept on errors, so a later
+  // download of the same file can continue where the previous one stopped.
+  FilePath partialFile = getPartialFilePath();
+  mResumeOffset =
+      isResumable() ? QFileInfo(partialFile.toStr()).size() : qint64(0);
+  if ((mExpectedContentSize > 0) && (mResumeOffset >= mExpectedContentSize)) {
+    mResumeOffset = 0;  // can't be the right file, start from scratch
+  }
+  mResumeChecked = false;
+  mFile.reset(new QFile(partialFile.toStr(), this));
+  QIODevice::OpenMode mode = QIODevice::WriteOnly |
+      ((mResumeOffset > 0) ? QIODevice::Append : QIODevice::Truncate);
+  if (!mFile->open(mode)) {
     throw RuntimeError(__FILE__, __LINE__,
                        QString("Could not open file \"%1\": %2")
-                           .arg(mDestination.toNative(), mFile->errorString()));
+                           .arg(partialFile.toNative(), mFile->errorString()));
+  }
+
+  // request only the missing part of the file
+  if (mResumeOffset > 0) {
+    qDebug() << "Resume download at byte" << mResumeOffset;
+    emit progressState(tr("Resume download..."));
+    mRequest.setRawHeader("Range",
+                          QString("bytes=%1-").arg(mResumeOffset).toUtf8());
+  } else {
+    mRequest.setRawHeader("Range", QByteArray());  // removes the header
   }
 }
 
@@ -106,8 +131,10 @@ void FileDownload::finalizeRequest() {
                            .arg(mDestination.toNative()));
   }
 
-  // save to destination file
-  if (!mFile->commit()) {
+  // move the completely downloaded file to its destination
+  mFile->close();
+  if ((mFile->error() != QFileDevice::NoError) ||
+      (!mFile->rename(mDestination.toStr()))) {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("Error while writing file \"%1\": %2")
                            .arg(mDestination.toNative(), mFile->errorString()));
@@ -163,9 +190,36 @@ void FileDownload::emitSuccessfullyFinishedSignals() noexcept {
 }
 
 void FileDownload::fetchNewData() noexcept {
+  if (mReply->attribute(QNetworkRequest::RedirectionTargetAttribute)
+          .isValid()) {
+    mReply->readAll();  // discard content of redirection replies
+    return;
+  }
+  if ((mResumeOffset > 0) && (!mResumeChecked)) {
+    // If the server doesn't support range requests, it sends the whole file.
+    mResumeChecked = true;
+    int status =
+        mReply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (status != 206) {  // 206 = Partial Content
+      qDebug() << "Server doesn't support resuming, restart download.";
+      mFile->resize(0);
+      mResumeOffset = 0;
+    }
+  }
   mFile->write(mReply->readAll());
 }
 
+FilePath FileDownload::getPartialFilePath() const noexcept {
+  return FilePath(mDestination.toStr() % ".part");
+}
+
+bool FileDownload::isResumable() const noexcept {
+  // Without checksum, an outdated partial file would lead to a broken file.
+  const QString scheme = mUrl.scheme().toLower();
+  return (!mExpectedChecksum.isEmpty()) &&
+      ((scheme == "http") || (scheme == "https"));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
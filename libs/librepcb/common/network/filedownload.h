@@ -70,6 +70,10 @@ public:
    * checksum. If they differ, the file gets removed and an error will be
    * reported.
    *
+   * @note Interrupted HTTP downloads are only resumed if a checksum is set,
+   *       since it is the only way to detect if the partially downloaded file
+   *       doesn't match the file on the server anymore.
+   *
    * @param algorithm     The checksum algorithm to be used
    * @param checksum      The expected checksum of the file to download
    */
@@ -118,13 +122,17 @@ private:  // Methods
   void finalizeRequest() override;
   void emitSuccessfullyFinishedSignals() noexcept override;
   void fetchNewData() noexcept override;
+  FilePath getPartialFilePath() const noexcept;
+  bool     isResumable() const noexcept;
 
 private:  // Data
   FilePath                      mDestination;
-  QScopedPointer<QSaveFile>     mFile;
+  QScopedPointer<QFile>         mFile;  ///< The partially downloaded file
   QCryptographicHash::Algorithm mHashAlgorithm;
   QByteArray                    mExpectedChecksum;
   FilePath                      mExtractZipToDir;
+  qint64                        mResumeOffset;   ///< Size of partial file
+  bool                          mResumeChecked;  ///< Reply status checked
 };
 
 /*******************************************************************************
@@ -23,6 +23,7 @@
 #include "networkaccessmanager.h"
 
 #include "../exceptions.h"
+#include "networkrequestbase.h"
 
 #include <QtCore>
 #include <QtNetwork>
@@ -42,7 +43,10 @@ NetworkAccessManager* NetworkAccessManager::sInstance = nullptr;
  ******************************************************************************/
 
 NetworkAccessManager::NetworkAccessManager() noexcept
-  : QThread(nullptr), mThreadStartSemaphore(0), mManager(nullptr) {
+  : QThread(nullptr),
+    mThreadStartSemaphore(0),
+    mManager(nullptr),
+    mMaxConcurrentRequests(4) {
   // This thread must only be started once, and from within the main application
   // thread!
   Q_ASSERT(QThread::currentThread() == qApp->thread());
@@ -64,6 +68,14 @@ NetworkAccessManager::~NetworkAccessManager() noexcept {
   sInstance = nullptr;
 }
 
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void NetworkAccessManager::setMaxConcurrentRequests(int count) noexcept {
+  mMaxConcurrentRequests.store(qMax(count, 1));
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -80,6 +92,32 @@ QNetworkReply* NetworkAccessManager::get(
   }
 }
 
+void NetworkAccessManager::enqueueRequest(
+    NetworkRequestBase& request) noexcept {
+  Q_ASSERT(QThread::currentThread() == this);
+  Q_ASSERT(!mQueuedRequests.contains(&request));
+  Q_ASSERT(!mRunningRequests.contains(&request));
+
+  // Insert behind all requests with the same or a higher priority (lower
+  // value) to process requests of the same priority in FIFO order.
+  int index = 0;
+  while ((index < mQueuedRequests.count()) &&
+         (mQueuedRequests.at(index)->getPriority() <= request.getPriority())) {
+    ++index;
+  }
+  mQueuedRequests.insert(index, &request);
+  startQueuedRequests();
+}
+
+void NetworkAccessManager::releaseRequest(
+    NetworkRequestBase& request) noexcept {
+  Q_ASSERT(QThread::currentThread() == this);
+  mQueuedRequests.removeOne(&request);
+  if (mRunningRequests.remove(&request)) {
+    startQueuedRequests();
+  }
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -96,6 +134,20 @@ void NetworkAccessManager::run() noexcept {
   Q_ASSERT(QThread::currentThread() == this);
   qDebug() << "Started network access manager thread.";
   mManager = new QNetworkAccessManager();
+
+  // Use an on-disk HTTP cache, so unchanged resources (e.g. the library list
+  // of a repository or library icons) are revalidated with conditional
+  // requests (ETag resp. Last-Modified) instead of downloading them again.
+  QString cacheDir =
+      QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+  if (!cacheDir.isEmpty()) {
+    QNetworkDiskCache* cache = new QNetworkDiskCache(mManager);
+    cache->setCacheDirectory(cacheDir % "/network");
+    mManager->setCache(cache);  // takes ownership
+  } else {
+    qWarning() << "No cache location available, HTTP caching disabled.";
+  }
+
   mThreadStartSemaphore.release();
   try {
     exec();  // event loop (blocking)
@@ -112,6 +164,16 @@ void NetworkAccessManager::run() noexcept {
   qDebug() << "Stopped network access manager thread.";
 }
 
+void NetworkAccessManager::startQueuedRequests() noexcept {
+  Q_ASSERT(QThread::currentThread() == this);
+  while ((!mQueuedRequests.isEmpty()) &&
+         (mRunningRequests.count() < mMaxConcurrentRequests.load())) {
+    NetworkRequestBase* request = mQueuedRequests.takeFirst();
+    mRunningRequests.insert(request);
+    request->sendRequest();  // might release the request immediately
+  }
+}
+
 void NetworkAccessManager::stop() noexcept {
   Q_ASSERT(QThread::currentThread() != this);
   quit();
@@ -33,6 +33,8 @@
  ******************************************************************************/
 namespace librepcb {
 
+class NetworkRequestBase;
+
 /*******************************************************************************
  *  Class NetworkAccessManager
  ******************************************************************************/
@@ -68,9 +70,47 @@ public:
   NetworkAccessManager(const NetworkAccessManager& other) = delete;
   ~NetworkAccessManager() noexcept;
 
+  // Setters
+
+  /**
+   * @brief Set the maximum number of concurrently running requests
+   *
+   * Requests started while this limit is reached are queued and processed
+   * in the order of their priority (see
+   * librepcb::NetworkRequestBase::setPriority()).
+   *
+   * @note The new limit takes effect when the next request is enqueued or
+   *       finished.
+   *
+   * @param count   Maximum number of requests (at least 1)
+   */
+  void setMaxConcurrentRequests(int count) noexcept;
+
   // General Methods
   QNetworkReply* get(const QNetworkRequest& request) noexcept;
 
+  /**
+   * @brief Enqueue a request to be sent as soon as a slot is available
+   *
+   * @note Must only be called from the network thread.
+   *
+   * @param request   The request to enqueue
+   */
+  void enqueueRequest(NetworkRequestBase& request) noexcept;
+
+  /**
+   * @brief Release the slot (or queue entry) of a request
+   *
+   * Must be called when a request has completed its transfer or was aborted,
+   * so the next queued request gets started. Calling it multiple times is
+   * allowed.
+   *
+   * @note Must only be called from the network thread.
+   *
+   * @param request   The request to release
+   */
+  void releaseRequest(NetworkRequestBase& request) noexcept;
+
   // Operator Overloadings
   NetworkAccessManager& operator=(const NetworkAccessManager& rhs) = delete;
 
@@ -80,11 +120,18 @@ public:
 private:  // Methods
   void run() noexcept override;
   void stop() noexcept;
+  void startQueuedRequests() noexcept;
 
 private:  // Data
   QSemaphore                   mThreadStartSemaphore;
   QNetworkAccessManager*       mManager;
   static NetworkAccessManager* sInstance;
+
+  // Request Scheduling (only accessed from the network thread, except the
+  // thread-safe limit)
+  QAtomicInt                 mMaxConcurrentRequests;
+  QList<NetworkRequestBase*> mQueuedRequests;  ///< Sorted by priority
+  QSet<NetworkRequestBase*>  mRunningRequests;
 };
 
 }  // namespace librepcb
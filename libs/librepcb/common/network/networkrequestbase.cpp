@@ -25,6 +25,7 @@
 #include "../application.h"
 #include "networkaccessmanager.h"
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 /*******************************************************************************
@@ -84,6 +85,20 @@ void NetworkRequestBase::setExpectedReplyContentSize(qint64 bytes) noexcept {
   mExpectedContentSize = bytes;
 }
 
+void NetworkRequestBase::setPriority(
+    QNetworkRequest::Priority priority) noexcept {
+  Q_ASSERT(QThread::currentThread() != NetworkAccessManager::instance());
+  Q_ASSERT(!mStarted);
+  mRequest.setPriority(priority);
+}
+
+void NetworkRequestBase::setCacheLoadControl(
+    QNetworkRequest::CacheLoadControl control) noexcept {
+  Q_ASSERT(QThread::currentThread() != NetworkAccessManager::instance());
+  Q_ASSERT(!mStarted);
+  mRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, control);
+}
+
 void NetworkRequestBase::start() noexcept {
   Q_ASSERT(QThread::currentThread() != NetworkAccessManager::instance());
 
@@ -105,6 +120,10 @@ void NetworkRequestBase::abort() noexcept {
     emit progressState(tr("Abort request..."));
     mAborted = true;
     mReply->abort();
+  } else if (mStarted && (!mFinished)) {
+    // still waiting in the queue of the network access manager
+    mAborted = true;
+    finalize(tr("Network request aborted."));
   }
 }
 
@@ -115,6 +134,21 @@ void NetworkRequestBase::abort() noexcept {
 void NetworkRequestBase::executeRequest() noexcept {
   Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
 
+  // get network access manager object
+  NetworkAccessManager* nam = NetworkAccessManager::instance();
+  if (!nam) {
+    finalize(tr("Network access manager is not running."));
+    return;
+  }
+
+  // wait until the network access manager has a free slot for this request
+  emit progressState(tr("Waiting in queue..."));
+  nam->enqueueRequest(*this);  // calls sendRequest()
+}
+
+void NetworkRequestBase::sendRequest() noexcept {
+  Q_ASSERT(QThread::currentThread() == NetworkAccessManager::instance());
+
   emit progressState(tr("Request started..."));
 
   // get network access manager object
@@ -228,7 +262,7 @@ void NetworkRequestBase::replyFinishedSlot() noexcept {
       mReply.take()->deleteLater();
       mRedirectedUrls.append(mUrl);
       mUrl = redirectUrl;
-      executeRequest();  // restart download with new url
+      sendRequest();  // restart download with new url
       return;
     }
   }
@@ -239,16 +273,27 @@ void NetworkRequestBase::replyFinishedSlot() noexcept {
     return;
   }
 
-  // finalize download
-  try {
-    finalizeRequest();  // can throw
-  } catch (const Exception& e) {
-    finalize(e.getMsg());
-    return;
-  }
-
-  // download successfully finished!
-  finalize();
+  // The transfer is completed, so let the next queued request start already.
+  NetworkAccessManager* nam = NetworkAccessManager::instance();
+  if (nam) nam->releaseRequest(*this);
+
+  // Finalize the download in a worker thread since it might take a while
+  // (e.g. verifying and extracting a downloaded ZIP file), which would block
+  // all other requests processed in the network thread.
+  QFutureWatcher<QString>* watcher = new QFutureWatcher<QString>(this);
+  connect(watcher, &QFutureWatcher<QString>::finished, this,
+          [this, watcher]() {
+            // null string means the download successfully finished
+            finalize(watcher->result());
+          });
+  watcher->setFuture(QtConcurrent::run([this]() -> QString {
+    try {
+      finalizeRequest();  // can throw
+      return QString();
+    } catch (const Exception& e) {
+      return e.getMsg();
+    }
+  }));
 }
 
 void NetworkRequestBase::finalize(const QString& errorMsg) noexcept {
@@ -273,6 +318,9 @@ void NetworkRequestBase::finalize(const QString& errorMsg) noexcept {
     emit finished(false);
   }
   mFinished = true;
+  if (NetworkAccessManager* nam = NetworkAccessManager::instance()) {
+    nam->releaseRequest(*this);
+  }
   deleteLater();
 }
 
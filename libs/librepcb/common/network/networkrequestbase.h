@@ -85,6 +85,35 @@ public:
    */
   void setExpectedReplyContentSize(qint64 bytes) noexcept;
 
+  /**
+   * @brief Set the priority of the request
+   *
+   * If the maximum number of concurrent requests is reached (see
+   * librepcb::NetworkAccessManager::setMaxConcurrentRequests()), queued
+   * requests with a higher priority are started first. Requests of interactive
+   * features (e.g. loading a list to display) should use the default priority
+   * while bulk downloads should use QNetworkRequest::LowPriority.
+   *
+   * @param priority      Priority of the request
+   */
+  void setPriority(QNetworkRequest::Priority priority) noexcept;
+
+  /**
+   * @brief Set whether the content may be loaded from the HTTP cache
+   *
+   * By default, cached content is revalidated with the server. For resources
+   * which (almost) never change, like library icons, it makes sense to use
+   * QNetworkRequest::PreferCache to avoid any network access for them.
+   *
+   * @param control       Cache load control of the request
+   */
+  void setCacheLoadControl(QNetworkRequest::CacheLoadControl control) noexcept;
+
+  // Getters
+  QNetworkRequest::Priority getPriority() const noexcept {
+    return mRequest.priority();
+  }
+
   // Operator Overloadings
   NetworkRequestBase& operator=(const NetworkRequestBase& rhs) = delete;
 
@@ -179,6 +208,7 @@ public:  // Methods
 
 private:  // Methods
   void           executeRequest() noexcept;
+  void           sendRequest() noexcept;
   void           replyReadyReadSlot() noexcept;
   void           replyErrorSlot(QNetworkReply::NetworkError code) noexcept;
   void           replySslErrorsSlot(const QList<QSslError>& errors) noexcept;
@@ -202,6 +232,8 @@ protected:  // Data
   bool                          mAborted;
   bool                          mErrored;
   bool                          mFinished;
+
+  friend class NetworkAccessManager;  // to call #sendRequest()
 };
 
 /*******************************************************************************
@@ -23,6 +23,7 @@
 #include "pickplacecsvwriter.h"
 
 #include "../fileio/csvfile.h"
+#include "../fileio/csvstreamwriter.h"
 #include "pickplacedata.h"
 
 #include <QtCore>
@@ -49,59 +50,78 @@ PickPlaceCsvWriter::~PickPlaceCsvWriter() noexcept {
 
 std::shared_ptr<CsvFile> PickPlaceCsvWriter::generateCsv() const {
   std::shared_ptr<CsvFile> file(new CsvFile());
-
-  // Optionally add some metadata to to the CSV as a help for readers.
-  if (mIncludeMetadataComment) {
-    QString comment =
-        QString(
-            "Pick&Place Position Data File\n"
-            "\n"
-            "Project Name:        %1\n"
-            "Project Version:     %2\n"
-            "Board Name:          %3\n"
-            "Generation Software: LibrePCB %4\n"
-            "Generation Date:     %5\n"
-            "Unit:                mm\n"
-            "Rotation:            Degrees CCW\n"
-            "Board Side:          %6")
-            .arg(mData.getProjectName())
-            .arg(mData.getProjectVersion())
-            .arg(mData.getBoardName())
-            .arg(qApp->applicationVersion())
-            .arg(QDateTime::currentDateTime().toString(Qt::ISODate))
-            .arg(boardSideToString(mBoardSide));
-    file->setComment(comment);
+  file->setComment(getComment());
+  file->setHeader(getHeader());
+  foreach (const PickPlaceDataItem& item, mData.getItems()) {
+    if (isOnBoardSide(item, mBoardSide)) {
+      file->addValue(itemToRow(item));  // can throw
+    }
   }
+  return file;
+}
 
-  // Don't translate the CSV header to make pick&place files independent of the
-  // user's language.
-  file->setHeader({"Designator", "Value", "Device", "Package", "Position X",
-                   "Position Y", "Rotation", "Side"});
-
+void PickPlaceCsvWriter::writeCsv(QIODevice& device) const {
+  CsvStreamWriter writer(device);
+  writer.writeComment(getComment());  // can throw
+  writer.writeHeader(getHeader());    // can throw
   foreach (const PickPlaceDataItem& item, mData.getItems()) {
     if (isOnBoardSide(item, mBoardSide)) {
-      QStringList values;
-      values += item.getDesignator();
-      values += item.getValue();
-      values += item.getDeviceName();
-      values += item.getPackageName();
-      values += item.getPosition().getX().toMmString();
-      values += item.getPosition().getY().toMmString();
-      values += item.getRotation().mappedTo0_360deg().toDegString();
-      values += item.getBoardSide() == PickPlaceDataItem::BoardSide::TOP
-                    ? "Top"
-                    : "Bottom";
-      file->addValue(values);  // can throw
+      writer.writeRow(itemToRow(item));  // can throw
     }
   }
-
-  return file;
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+QString PickPlaceCsvWriter::getComment() const noexcept {
+  // Optionally add some metadata to to the CSV as a help for readers.
+  if (!mIncludeMetadataComment) {
+    return QString();
+  }
+  return QString(
+             "Pick&Place Position Data File\n"
+             "\n"
+             "Project Name:        %1\n"
+             "Project Version:     %2\n"
+             "Board Name:          %3\n"
+             "Generation Software: LibrePCB %4\n"
+             "Generation Date:     %5\n"
+             "Unit:                mm\n"
+             "Rotation:            Degrees CCW\n"
+             "Board Side:          %6")
+      .arg(mData.getProjectName())
+      .arg(mData.getProjectVersion())
+      .arg(mData.getBoardName())
+      .arg(qApp->applicationVersion())
+      .arg(QDateTime::currentDateTime().toString(Qt::ISODate))
+      .arg(boardSideToString(mBoardSide));
+}
+
+QStringList PickPlaceCsvWriter::getHeader() noexcept {
+  // Don't translate the CSV header to make pick&place files independent of the
+  // user's language.
+  return {"Designator", "Value",      "Device",   "Package",
+          "Position X", "Position Y", "Rotation", "Side"};
+}
+
+QStringList PickPlaceCsvWriter::itemToRow(
+    const PickPlaceDataItem& item) noexcept {
+  QStringList values;
+  values += item.getDesignator();
+  values += item.getValue();
+  values += item.getDeviceName();
+  values += item.getPackageName();
+  values += item.getPosition().getX().toMmString();
+  values += item.getPosition().getY().toMmString();
+  values += item.getRotation().mappedTo0_360deg().toDegString();
+  values += item.getBoardSide() == PickPlaceDataItem::BoardSide::TOP
+                ? "Top"
+                : "Bottom";
+  return values;
+}
+
 bool PickPlaceCsvWriter::isOnBoardSide(const PickPlaceDataItem& item,
                                        BoardSide                side) noexcept {
   switch (side) {
@@ -64,13 +64,25 @@ public:
   // General Methods
   std::shared_ptr<CsvFile> generateCsv() const;
 
+  /**
+   * @brief Write the CSV directly to a device, without building a CsvFile
+   *
+   * @param device  The device to write to (must be opened for writing).
+   *
+   * @throw ::librepcb::Exception if writing to the device failed.
+   */
+  void writeCsv(QIODevice& device) const;
+
   // Operator Overloadings
   PickPlaceCsvWriter& operator=(const PickPlaceCsvWriter& rhs) = delete;
 
 private:  // Methods
-  static bool    isOnBoardSide(const PickPlaceDataItem& item,
-                               BoardSide                side) noexcept;
-  static QString boardSideToString(BoardSide side) noexcept;
+  QString            getComment() const noexcept;
+  static QStringList getHeader() noexcept;
+  static QStringList itemToRow(const PickPlaceDataItem& item) noexcept;
+  static bool        isOnBoardSide(const PickPlaceDataItem& item,
+                                   BoardSide                side) noexcept;
+  static QString     boardSideToString(BoardSide side) noexcept;
 
 private:  // Data
   const PickPlaceData& mData;
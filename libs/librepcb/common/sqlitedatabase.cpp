@@ -60,8 +60,15 @@ SQLiteDatabase::TransactionScopeGuard::~TransactionScopeGuard() noexcept {
  ******************************************************************************/
 
 SQLiteDatabase::SQLiteDatabase(const FilePath& filepath)
-  : QObject(nullptr)  //, mNestedTransactionCount(0)
+  : QObject(nullptr),
+    mSlowQueryThresholdMs(-1)  //, mNestedTransactionCount(0)
 {
+  bool ok   = false;
+  int  msec = qgetenv("LIBREPCB_SQL_SLOW_QUERY_MS").toInt(&ok);
+  if (ok && (msec >= 0)) {
+    mSlowQueryThresholdMs = msec;
+  }
+
   // create database (use random UUID as connection name)
   mDb = QSqlDatabase::addDatabase("QSQLITE", Uuid::createRandom().toStr());
   mDb.setDatabaseName(filepath.toStr());
@@ -92,6 +99,7 @@ SQLiteDatabase::SQLiteDatabase(const FilePath& filepath)
 }
 
 SQLiteDatabase::~SQLiteDatabase() noexcept {
+  mCachedQueries.clear();  // queries must be released before closing
   mDb.close();
 }
 
@@ -158,6 +166,22 @@ QSqlQuery SQLiteDatabase::prepareQuery(const QString& query) const {
   return q;
 }
 
+bool SQLiteDatabase::tableExists(const QString& table) {
+  QSqlQuery query = prepareQuery(
+      "SELECT COUNT(*) FROM sqlite_master "
+      "WHERE type = 'table' AND name = :name");  // can throw
+  query.bindValue(":name", table);
+  return count(query) > 0;  // can throw
+}
+
+QSqlQuery& SQLiteDatabase::prepareCachedQuery(const QString& query) {
+  auto it = mCachedQueries.find(query);
+  if (it == mCachedQueries.end()) {
+    it = mCachedQueries.insert(query, prepareQuery(query));  // can throw
+  }
+  return it.value();
+}
+
 int SQLiteDatabase::count(QSqlQuery& query) {
   exec(query);  // can throw
 
@@ -188,6 +212,8 @@ int SQLiteDatabase::insert(QSqlQuery& query) {
 }
 
 void SQLiteDatabase::exec(QSqlQuery& query) {
+  QElapsedTimer timer;
+  if (mSlowQueryThresholdMs >= 0) timer.start();
   if (!query.exec()) {
     qDebug() << query.lastError().databaseText();
     qDebug() << query.lastError().driverText();
@@ -195,6 +221,10 @@ void SQLiteDatabase::exec(QSqlQuery& query) {
         __FILE__, __LINE__,
         tr("Error while executing SQL query: %1").arg(query.lastQuery()));
   }
+  if ((mSlowQueryThresholdMs >= 0) &&
+      (timer.elapsed() >= mSlowQueryThresholdMs)) {
+    logSlowQuery(query, timer.elapsed());
+  }
 }
 
 void SQLiteDatabase::exec(const QString& query) {
@@ -231,6 +261,31 @@ QHash<QString, QString> SQLiteDatabase::getSqliteCompileOptions() {
   return options;
 }
 
+void SQLiteDatabase::logSlowQuery(const QSqlQuery& query,
+                                  qint64           elapsedMs) noexcept {
+  qDebug().nospace() << "Slow SQL query (" << elapsedMs
+                     << "ms): " << query.lastQuery();
+
+  // Only SELECT statements are explained, to be sure nothing gets modified.
+  if (!query.lastQuery().trimmed().startsWith("SELECT", Qt::CaseInsensitive)) {
+    return;
+  }
+  QSqlQuery plan(mDb);
+  if (!plan.prepare("EXPLAIN QUERY PLAN " % query.lastQuery())) {
+    return;
+  }
+  QMapIterator<QString, QVariant> it(query.boundValues());
+  while (it.hasNext()) {
+    it.next();
+    plan.bindValue(it.key(), it.value());
+  }
+  if (plan.exec()) {
+    while (plan.next()) {
+      qDebug() << "  Query plan:" << plan.value("detail").toString();
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
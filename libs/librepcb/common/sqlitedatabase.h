@@ -78,6 +78,21 @@ public:
   int       insert(QSqlQuery& query);
   void      exec(QSqlQuery& query);
   void      exec(const QString& query);
+  bool      tableExists(const QString& table);
+
+  /**
+   * @brief Get a prepared query which is reused for all calls with the same
+   *        SQL string
+   *
+   * Use this for queries executed many times (e.g. inserts in loops) to avoid
+   * compiling the same SQL statement again and again. Only the bound values
+   * need to be set before executing the returned query.
+   *
+   * @param query   The SQL query string
+   *
+   * @return The prepared query (valid as long as this object exists)
+   */
+  QSqlQuery& prepareCachedQuery(const QString& query);
 
   // Operator Overloadings
   SQLiteDatabase& operator=(const SQLiteDatabase& rhs) = delete;
@@ -103,8 +118,21 @@ private:  // Methods
    */
   QHash<QString, QString> getSqliteCompileOptions();
 
+  /**
+   * @brief Print the query plan of a slow query to the debug output
+   *
+   * Only used if the environment variable `LIBREPCB_SQL_SLOW_QUERY_MS` is set
+   * to the threshold (in milliseconds) above which a query is considered slow.
+   *
+   * @param query     The (already executed) query
+   * @param elapsedMs Execution time of the query
+   */
+  void logSlowQuery(const QSqlQuery& query, qint64 elapsedMs) noexcept;
+
 private:  // Data
-  QSqlDatabase mDb;
+  QSqlDatabase              mDb;
+  QHash<QString, QSqlQuery> mCachedQueries;  ///< see #prepareCachedQuery()
+  int                       mSlowQueryThresholdMs;  ///< -1 = no logging
   // int mNestedTransactionCount;
 };
 
@@ -28,13 +28,16 @@
 #include <QtCore>
 
 #if defined(Q_OS_OSX)  // Mac OS X
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <system_error>
 
 #include <cerrno>
 #include <libproc.h>
+#include <mach/mach.h>
 #include <signal.h>
 #elif defined(Q_OS_UNIX)  // UNIX/Linux
+#include <sys/resource.h>
 #include <sys/types.h>
 #include <system_error>
 
@@ -54,7 +57,10 @@
 #endif
 #define WINVER 0x0600
 #define _WIN32_WINNT 0x0600
+#define PSAPI_VERSION 2  // use K32GetProcessMemoryInfo() from kernel32.dll
 #include <windows.h>
+
+#include <psapi.h>
 #else
 #error "Unknown operating system!"
 #endif
@@ -309,6 +315,88 @@ QString SystemInfo::getProcessNameByPid(qint64 pid) {
   return processName;
 }
 
+qint64 SystemInfo::getProcessCpuTime() noexcept {
+#if defined(Q_OS_UNIX)  // Mac OS X / Linux / UNIX
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+  return (qint64(usage.ru_utime.tv_sec) + qint64(usage.ru_stime.tv_sec)) *
+      1000 +
+      (qint64(usage.ru_utime.tv_usec) + qint64(usage.ru_stime.tv_usec)) / 1000;
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64)  // Windows
+  FILETIME creationTime, exitTime, kernelTime, userTime;
+  if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime,
+                       &kernelTime, &userTime)) {
+    return -1;
+  }
+  auto toInt = [](const FILETIME& ft) {
+    return (qint64(ft.dwHighDateTime) << 32) | qint64(ft.dwLowDateTime);
+  };
+  return (toInt(kernelTime) + toInt(userTime)) / 10000;  // 100ns -> ms
+#else
+#error "Unknown operating system!"
+#endif
+}
+
+qint64 SystemInfo::getPeakMemoryUsage() noexcept {
+#if defined(Q_OS_UNIX)  // Mac OS X / Linux / UNIX
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+#if defined(Q_OS_OSX)
+  return qint64(usage.ru_maxrss);  // bytes on Mac OS X
+#else
+  return qint64(usage.ru_maxrss) * 1024;  // kilobytes on Linux/BSD
+#endif
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64)  // Windows
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                            sizeof(counters))) {
+    return -1;
+  }
+  return qint64(counters.PeakWorkingSetSize);
+#else
+#error "Unknown operating system!"
+#endif
+}
+
+qint64 SystemInfo::getCurrentMemoryUsage() noexcept {
+#if defined(Q_OS_OSX)  // Mac OS X
+  mach_task_basic_info_data_t info;
+  mach_msg_type_number_t      count = MACH_TASK_BASIC_INFO_COUNT;
+  if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+                reinterpret_cast<task_info_t>(&info), &count) != KERN_SUCCESS) {
+    return -1;
+  }
+  return qint64(info.resident_size);
+#elif defined(Q_OS_UNIX)  // UNIX/Linux
+  // the second field of /proc/self/statm is the resident set size in pages
+  QFile file("/proc/self/statm");
+  if (!file.open(QIODevice::ReadOnly)) {
+    return -1;  // no procfs available (e.g. on BSD)
+  }
+  QList<QByteArray> fields = file.readAll().simplified().split(' ');
+  bool              ok     = false;
+  qint64            pages  = fields.value(1).toLongLong(&ok);
+  long              size   = sysconf(_SC_PAGESIZE);
+  if ((!ok) || (size <= 0)) {
+    return -1;
+  }
+  return pages * qint64(size);
+#elif defined(Q_OS_WIN32) || defined(Q_OS_WIN64)  // Windows
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters,
+                            sizeof(counters))) {
+    return -1;
+  }
+  return qint64(counters.WorkingSetSize);
+#else
+#error "Unknown operating system!"
+#endif
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -99,6 +99,30 @@ public:
    */
   static QString getProcessNameByPid(qint64 pid);
 
+  /**
+   * @brief Get the CPU time consumed by this process so far
+   *
+   * @return  User + system time of all threads in milliseconds, or -1 if it
+   *          could not be determined.
+   */
+  static qint64 getProcessCpuTime() noexcept;
+
+  /**
+   * @brief Get the peak resident set size (physical memory) of this process
+   *
+   * @return  The maximum resident set size in bytes since the process was
+   *          started, or -1 if it could not be determined.
+   */
+  static qint64 getPeakMemoryUsage() noexcept;
+
+  /**
+   * @brief Get the current resident set size (physical memory) of this process
+   *
+   * @return  The resident set size in bytes, or -1 if it could not be
+   *          determined.
+   */
+  static qint64 getCurrentMemoryUsage() noexcept;
+
 private:
   // Cached Data
   static QString sUsername;
@@ -0,0 +1,251 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "tracer.h"
+
+#include "exceptions.h"
+#include "fileio/fileutils.h"
+
+#include <QtCore>
+
+#include <new>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Struct ThreadBuffer
+ ******************************************************************************/
+
+/**
+ * Events of one thread, stored in a linked list of fixed size chunks. Only the
+ * owning thread appends events, other threads may read them concurrently
+ * (without lock) thanks to the atomic counters and pointers.
+ */
+struct Tracer::ThreadBuffer {
+  struct Chunk {
+    Event               events[sChunkSize];
+    std::atomic<int>    count;  ///< number of valid events
+    std::atomic<Chunk*> next;   ///< nullptr if this is the last chunk
+
+    Chunk() noexcept : count(0), next(nullptr) {}
+  };
+
+  int     threadId;
+  QString threadName;
+  Chunk   first;
+  Chunk*  last;        ///< accessed only by the owning thread
+  int     eventCount;  ///< accessed only by the owning thread
+
+  ThreadBuffer() noexcept : threadId(0), last(&first), eventCount(0) {}
+  ~ThreadBuffer() noexcept {
+    Chunk* chunk = first.next.load();
+    while (chunk) {
+      Chunk* next = chunk->next.load();
+      delete chunk;
+      chunk = next;
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Static Variables
+ ******************************************************************************/
+
+std::atomic<quint64> Tracer::sNextId(1);
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+Tracer::Tracer(bool enabled, const FilePath& filePath) noexcept
+  : mId(sNextId++),
+    mEnabled(enabled),
+    mFilePath(filePath),
+    mTimer(),
+    mProcessId(QCoreApplication::applicationPid()),
+    mBuffers(),
+    mBuffersMutex() {
+  mTimer.start();
+}
+
+Tracer::~Tracer() noexcept {
+  if (isEnabled() && mFilePath.isValid()) {
+    mEnabled = false;
+    try {
+      writeJson(mFilePath);  // can throw
+      qInfo() << "Trace written to" << mFilePath.toNative();
+    } catch (const Exception& e) {
+      qCritical() << "Failed to write trace:" << e.getMsg();
+    }
+  }
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+int Tracer::getEventCount() const noexcept {
+  int          count = 0;
+  QMutexLocker lock(&mBuffersMutex);
+  for (const std::unique_ptr<ThreadBuffer>& buffer : mBuffers) {
+    const ThreadBuffer::Chunk* chunk = &buffer->first;
+    while (chunk) {
+      count += chunk->count.load(std::memory_order_acquire);
+      chunk = chunk->next.load(std::memory_order_acquire);
+    }
+  }
+  return count;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void Tracer::addEvent(const char* category, const char* name, qint64 beginUs,
+                      qint64 endUs) noexcept {
+  if (!isEnabled()) {
+    return;
+  }
+  ThreadBuffer* buffer = getThreadBuffer();
+  if ((!buffer) || (buffer->eventCount >= sMaxEventsPerThread)) {
+    return;
+  }
+  ThreadBuffer::Chunk* chunk = buffer->last;
+  int                  index = chunk->count.load(std::memory_order_relaxed);
+  if (index >= sChunkSize) {
+    ThreadBuffer::Chunk* newChunk = new (std::nothrow) ThreadBuffer::Chunk();
+    if (!newChunk) {
+      return;
+    }
+    chunk->next.store(newChunk, std::memory_order_release);
+    buffer->last = chunk = newChunk;
+    index                = 0;
+  }
+  chunk->events[index] = Event{category, name, beginUs, endUs - beginUs};
+  chunk->count.store(index + 1, std::memory_order_release);  // publish
+  ++buffer->eventCount;
+}
+
+QByteArray Tracer::toJson() const noexcept {
+  auto quoted = [](const QByteArray& str) {
+    QByteArray result = "\"";
+    foreach (char c, str) {
+      if ((c == '"') || (c == '\\')) {
+        result += '\\';
+        result += c;
+      } else if (static_cast<uchar>(c) < 0x20) {
+        result += ' ';
+      } else {
+        result += c;
+      }
+    }
+    return result + "\"";
+  };
+  const QByteArray pid = QByteArray::number(mProcessId);
+
+  QByteArray json  = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  bool       first = true;
+
+  auto append = [&json, &first](const QByteArray& event) {
+    json += first ? "\n" : ",\n";
+    json += event;
+    first = false;
+  };
+  QMutexLocker lock(&mBuffersMutex);
+  for (const std::unique_ptr<ThreadBuffer>& buffer : mBuffers) {
+    const QByteArray tid = QByteArray::number(buffer->threadId);
+    append("{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":" + pid +
+           ",\"tid\":" + tid + ",\"args\":{\"name\":" +
+           quoted(buffer->threadName.toUtf8()) + "}}");
+    const ThreadBuffer::Chunk* chunk = &buffer->first;
+    while (chunk) {
+      const int count = chunk->count.load(std::memory_order_acquire);
+      for (int i = 0; i < count; ++i) {
+        const Event& event = chunk->events[i];
+        append("{\"ph\":\"X\",\"cat\":" + quoted(event.category) +
+               ",\"name\":" + quoted(event.name) + ",\"pid\":" + pid +
+               ",\"tid\":" + tid +
+               ",\"ts\":" + QByteArray::number(event.beginUs) +
+               ",\"dur\":" + QByteArray::number(event.durationUs) + "}");
+      }
+      chunk = chunk->next.load(std::memory_order_acquire);
+    }
+  }
+  json += "\n]}\n";
+  return json;
+}
+
+void Tracer::writeJson(const FilePath& fp) const {
+  FileUtils::writeFile(fp, toJson());  // can throw
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+Tracer* Tracer::instance() noexcept {
+  static const QString filePath =
+      QString::fromLocal8Bit(qgetenv("LIBREPCB_TRACE_FILE"));
+  static Tracer tracer(!filePath.isEmpty(),
+                       FilePath(QFileInfo(filePath).absoluteFilePath()));
+  return &tracer;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+Tracer::ThreadBuffer* Tracer::getThreadBuffer() noexcept {
+  // Remember the buffer of the last used tracer, which is the global tracer
+  // in practice. Its ID is used instead of its address since a destroyed
+  // tracer might be replaced by a new one at the same address.
+  static thread_local quint64       cachedId     = 0;
+  static thread_local ThreadBuffer* cachedBuffer = nullptr;
+  if (cachedId != mId) {
+    ThreadBuffer* buffer = new (std::nothrow) ThreadBuffer();
+    if (!buffer) {
+      return nullptr;
+    }
+    QThread*          thread = QThread::currentThread();
+    QCoreApplication* app    = QCoreApplication::instance();
+    QMutexLocker      lock(&mBuffersMutex);
+    buffer->threadId = static_cast<int>(mBuffers.size()) + 1;
+    if (app && (thread == app->thread())) {
+      buffer->threadName = "Main Thread";
+    } else {
+      buffer->threadName = QString("Thread %1").arg(buffer->threadId);
+    }
+    mBuffers.push_back(std::unique_ptr<ThreadBuffer>(buffer));
+    cachedId     = mId;
+    cachedBuffer = buffer;
+  }
+  return cachedBuffer;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,238 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_TRACER_H
+#define LIBREPCB_TRACER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "fileio/filepath.h"
+
+#include <QtCore>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class Tracer
+ ******************************************************************************/
+
+/**
+ * @brief Records time spans as Chrome trace events
+ *
+ * Time spans are usually recorded with the ::LIBREPCB_TRACE_SCOPE() macro and
+ * written in the "Trace Event Format" which can be loaded into
+ * chrome://tracing or https://ui.perfetto.dev/.
+ *
+ * The global tracer returned by #instance() is only enabled if the
+ * environment variable `LIBREPCB_TRACE_FILE` is set. Its events are then
+ * written to that file when the application exits. If the tracer is
+ * disabled, a trace point costs only a single (relaxed) atomic load.
+ *
+ * Each thread records its events into its own buffer which is only written
+ * by that thread, so recording an event does not need any lock. Only the
+ * very first event of a thread registers its buffer with a mutex.
+ *
+ * To remove all trace points at compile time, define `LIBREPCB_NO_TRACING`
+ * (e.g. `qmake DEFINES+=LIBREPCB_NO_TRACING`).
+ */
+class Tracer final {
+public:
+  // Constructors / Destructor
+  Tracer()                    = delete;
+  Tracer(const Tracer& other) = delete;
+
+  /**
+   * @brief Constructor
+   *
+   * @param enabled   Whether events shall be recorded or not
+   * @param filePath  If valid, the events are written to this file by the
+   *                  destructor.
+   */
+  explicit Tracer(bool            enabled,
+                  const FilePath& filePath = FilePath()) noexcept;
+  ~Tracer() noexcept;
+
+  // Getters
+  bool isEnabled() const noexcept {
+    return mEnabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Get the time elapsed since the tracer was created
+   *
+   * @return Timestamp in microseconds
+   */
+  qint64 getTimestampUs() const noexcept {
+    return mTimer.nsecsElapsed() / 1000;
+  }
+
+  /**
+   * @brief Get the number of recorded events of all threads
+   *
+   * @return Event count (excluding dropped events)
+   */
+  int getEventCount() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Record a complete event (only if the tracer is enabled)
+   *
+   * @param category  Event category (e.g. "project"), must be a string
+   *                  literal since only the pointer is stored
+   * @param name      Event name, must be a string literal as well
+   * @param beginUs   Timestamp from #getTimestampUs() at the begin of the span
+   * @param endUs     Timestamp from #getTimestampUs() at the end of the span
+   */
+  void addEvent(const char* category, const char* name, qint64 beginUs,
+                qint64 endUs) noexcept;
+
+  /**
+   * @brief Serialize all recorded events to Chrome trace event JSON
+   *
+   * @note Events which are recorded concurrently may or may not be contained.
+   *
+   * @return JSON document (UTF-8)
+   */
+  QByteArray toJson() const noexcept;
+
+  /**
+   * @brief Write all recorded events to a file
+   *
+   * @param fp  Output file path
+   *
+   * @throw Exception If the file could not be written.
+   */
+  void writeJson(const FilePath& fp) const;
+
+  // Operator Overloadings
+  Tracer& operator=(const Tracer& rhs) = delete;
+
+  // Static Methods
+
+  /**
+   * @brief Get the global tracer, configured by environment variables
+   *
+   * @return A pointer to the singleton object
+   */
+  static Tracer* instance() noexcept;
+
+private:  // Types
+  struct Event {
+    const char* category;
+    const char* name;
+    qint64      beginUs;
+    qint64      durationUs;
+  };
+  struct ThreadBuffer;
+
+private:  // Methods
+  ThreadBuffer* getThreadBuffer() noexcept;
+
+private:  // Data
+  const quint64     mId;  ///< to identify the tracer in thread local storage
+  std::atomic<bool> mEnabled;
+  FilePath          mFilePath;
+  QElapsedTimer     mTimer;
+  const qint64      mProcessId;
+
+  /// Buffers of all threads which have recorded events, protected by
+  /// #mBuffersMutex (but not their content, it is only ever appended)
+  std::vector<std::unique_ptr<ThreadBuffer>> mBuffers;
+  mutable QMutex                             mBuffersMutex;
+
+  static std::atomic<quint64> sNextId;
+  static const int            sChunkSize          = 4096;  ///< events/alloc
+  static const int            sMaxEventsPerThread = 1000000;  ///< then drop
+};
+
+/*******************************************************************************
+ *  Class TraceScope
+ ******************************************************************************/
+
+/**
+ * @brief Records the lifetime of a scope to the global Tracer
+ *
+ * Use the ::LIBREPCB_TRACE_SCOPE() macro instead of this class directly, so
+ * the trace points can be removed at compile time.
+ */
+class TraceScope final {
+public:
+  // Constructors / Destructor
+  TraceScope()                        = delete;
+  TraceScope(const TraceScope& other) = delete;
+  TraceScope(const char* category, const char* name) noexcept
+    : mCategory(category), mName(name), mBeginUs(-1) {
+    const Tracer* tracer = Tracer::instance();
+    if (tracer->isEnabled()) {
+      mBeginUs = tracer->getTimestampUs();
+    }
+  }
+  ~TraceScope() noexcept {
+    if (mBeginUs >= 0) {
+      Tracer* tracer = Tracer::instance();
+      tracer->addEvent(mCategory, mName, mBeginUs, tracer->getTimestampUs());
+    }
+  }
+
+  // Operator Overloadings
+  TraceScope& operator=(const TraceScope& rhs) = delete;
+
+private:
+  const char* mCategory;
+  const char* mName;
+  qint64      mBeginUs;  ///< -1 if the tracer was disabled
+};
+
+/*******************************************************************************
+ *  Macros
+ ******************************************************************************/
+
+#define LIBREPCB_TRACE_CONCAT_IMPL(a, b) a##b
+#define LIBREPCB_TRACE_CONCAT(a, b) LIBREPCB_TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Record the time span until the end of the current scope
+ *
+ * @param category  Event category as string literal (e.g. "project")
+ * @param name      Event name as string literal (e.g. "Project::save")
+ */
+#if defined(LIBREPCB_NO_TRACING)
+#define LIBREPCB_TRACE_SCOPE(category, name) ((void)0)
+#else
+#define LIBREPCB_TRACE_SCOPE(category, name)                             \
+  const ::librepcb::TraceScope LIBREPCB_TRACE_CONCAT(librepcbTraceScope, \
+                                                     __LINE__)(category, name)
+#endif
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_TRACER_H
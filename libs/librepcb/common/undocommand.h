@@ -96,6 +96,30 @@ public:
    */
   virtual void redo() final;
 
+  /**
+   * @brief Try to merge another command into this one
+   *
+   * This is used by librepcb::UndoStack to combine consecutive commands which
+   * modify the same object (e.g. repeated moves of the same item) into a
+   * single undo step. Both commands are already executed when this method is
+   * called. If the merge succeeds, this command must afterwards behave as if
+   * it had done the changes of both commands, and the other command gets
+   * deleted by the caller.
+   *
+   * @note The default implementation never merges. Only override this method
+   * if undoing this command restores a state which does not depend on the
+   * changes of the other command.
+   *
+   * @param other     The command executed right after this one
+   *
+   * @retval true     If the other command was merged into this one
+   * @retval false    If the commands can't be merged
+   */
+  virtual bool mergeWith(const UndoCommand& other) noexcept {
+    Q_UNUSED(other);
+    return false;
+  }
+
   // Operator Overloadings
   UndoCommand& operator=(const UndoCommand& rhs) = delete;
 
@@ -69,6 +69,18 @@ void UndoStackTransaction::commit() {
   mCmdActive = false;
 }
 
+/*******************************************************************************
+ *  Class UndoStackBatch
+ ******************************************************************************/
+
+UndoStackBatch::UndoStackBatch(UndoStack& stack) noexcept : mStack(stack) {
+  mStack.beginBatch();
+}
+
+UndoStackBatch::~UndoStackBatch() noexcept {
+  mStack.endBatch();
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -77,7 +89,10 @@ UndoStack::UndoStack() noexcept
   : QObject(nullptr),
     mCurrentIndex(0),
     mCleanIndex(0),
-    mActiveCommandGroup(nullptr) {
+    mCommandLimit(0),
+    mActiveCommandGroup(nullptr),
+    mBatchDepth(0),
+    mStateChangePending(false) {
 }
 
 UndoStack::~UndoStack() noexcept {
@@ -130,10 +145,29 @@ void UndoStack::setClean() noexcept {
   emit cleanChanged(true);
 }
 
+void UndoStack::setCommandLimit(int limit) noexcept {
+  mCommandLimit = qMax(limit, 0);
+  if (trimToCommandLimit()) {
+    notifyStateChanged();
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
+void UndoStack::beginBatch() noexcept {
+  ++mBatchDepth;
+}
+
+void UndoStack::endBatch() noexcept {
+  Q_ASSERT(mBatchDepth > 0);
+  if ((--mBatchDepth == 0) && mStateChangePending) {
+    mStateChangePending = false;
+    notifyStateChanged();
+  }
+}
+
 bool UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) {
   // make sure "cmd" is deleted when going out of scope (e.g. because of an
   // exception)
@@ -146,7 +180,12 @@ bool UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) {
            "at the moment. Please finish that command to continue."));
   }
 
+  UndoStackBatch batch(*this);
+
+  QElapsedTimer timer;
+  timer.start();
   bool commandHasDoneSomething = cmd->execute();  // can throw
+  logCommand("exec", cmd->getText(), timer.nsecsElapsed());
 
   if (commandHasDoneSomething || forceKeepCmd) {
     // the clean state will no longer exist -> make the index invalid
@@ -162,18 +201,23 @@ bool UndoStack::execCmd(UndoCommand* cmd, bool forceKeepCmd) {
     }
     Q_ASSERT(mCurrentIndex == mCommands.count());
 
-    // add command to the command stack
-    mCommands.append(
-        cmdScopeGuard.take());  // move ownership of "cmd" to "mCommands"
-    mCurrentIndex++;
+    // try to merge the command into the previous one, but never across the
+    // clean state since this would make it impossible to get back to it
+    bool merged = (!forceKeepCmd) && (mCurrentIndex > 0) &&
+        (mCleanIndex != mCurrentIndex) && mCommands.last()->mergeWith(*cmd);
+    if (merged) {
+      cmd = mCommands.last();
+      cmdScopeGuard.reset();  // the merged command is no longer needed
+    } else {
+      // add command to the command stack
+      mCommands.append(
+          cmdScopeGuard.take());  // move ownership of "cmd" to "mCommands"
+      mCurrentIndex++;
+      trimToCommandLimit();
+    }
 
     // emit signals
-    emit undoTextChanged(tr("Undo: %1").arg(cmd->getText()));
-    emit redoTextChanged(tr("Redo"));
-    emit canUndoChanged(true);
-    emit canRedoChanged(false);
-    emit cleanChanged(false);
-    emit stateModified();
+    notifyStateChanged();
   } else {
     // the command has done nothing, so we will just discard it
     cmd->undo();  // only to be sure the command has executed nothing...
@@ -189,13 +233,15 @@ void UndoStack::beginCmdGroup(const QString& text) {
            "at the moment. Please finish that command to continue."));
   }
 
+  UndoStackBatch batch(*this);
+
   UndoCommandGroup* cmd = new UndoCommandGroup(text);
   execCmd(cmd, true);  // throws an exception on error; emits all signals
   Q_ASSERT(mCommands.last() == cmd);
   mActiveCommandGroup = cmd;
 
   // emit signals
-  emit canUndoChanged(false);
+  notifyStateChanged();
 }
 
 bool UndoStack::appendToCmdGroup(UndoCommand* cmd) {
@@ -209,13 +255,19 @@ bool UndoStack::appendToCmdGroup(UndoCommand* cmd) {
   Q_ASSERT(mCurrentIndex == mCommands.count());
   Q_ASSERT(mActiveCommandGroup);
 
+  UndoStackBatch batch(*this);
+
   // append new command as a child of active command group
   // note: this will also execute the new command!
-  bool commandHasDoneSomething =
+  QElapsedTimer timer;
+  timer.start();
+  QString text = cmd->getText();
+  bool    commandHasDoneSomething =
       mActiveCommandGroup->appendChild(cmdScopeGuard.take());  // can throw
+  logCommand("append", text, timer.nsecsElapsed());
 
   // emit signals
-  emit stateModified();
+  notifyStateChanged();
   return commandHasDoneSomething;
 }
 
@@ -237,7 +289,7 @@ bool UndoStack::commitCmdGroup() {
   mActiveCommandGroup = nullptr;
 
   // emit signals
-  emit canUndoChanged(canUndo());
+  notifyStateChanged();
   emit commandGroupEnded();
   return true;
 }
@@ -250,25 +302,24 @@ void UndoStack::abortCmdGroup() {
   Q_ASSERT(mActiveCommandGroup);
   Q_ASSERT(mCommands.last() == mActiveCommandGroup);
 
-  try {
-    mActiveCommandGroup->undo();  // can throw (but should usually not)
-    mActiveCommandGroup = nullptr;
-    mCurrentIndex--;
-    delete mCommands.takeLast();  // delete and remove the aborted command group
-                                  // from the stack
-  } catch (Exception& e) {
-    qCritical() << "UndoCommand::undo() has thrown an exception:" << e.getMsg();
-    throw;
-  }
+  {
+    UndoStackBatch batch(*this);
+    try {
+      mActiveCommandGroup->undo();  // can throw (but should usually not)
+      mActiveCommandGroup = nullptr;
+      mCurrentIndex--;
+      delete mCommands.takeLast();  // delete and remove the aborted command
+                                    // group from the stack
+    } catch (Exception& e) {
+      qCritical() << "UndoCommand::undo() has thrown an exception:"
+                  << e.getMsg();
+      throw;
+    }
+    notifyStateChanged();
+  }  // emits the state signals (if no other batch is active)
 
   // emit signals
-  emit undoTextChanged(getUndoText());
-  emit redoTextChanged(tr("Redo"));
-  emit canUndoChanged(canUndo());
-  emit canRedoChanged(false);
-  emit cleanChanged(isClean());
   emit commandGroupAborted();  // this is important!
-  emit stateModified();
 }
 
 void UndoStack::undo() {
@@ -276,8 +327,14 @@ void UndoStack::undo() {
     return;  // if a command group is active, undo() is not allowed
   }
 
+  UndoStackBatch batch(*this);
+
   try {
+    QElapsedTimer timer;
+    timer.start();
     mCommands[mCurrentIndex - 1]->undo();  // can throw (but should usually not)
+    logCommand("undo", mCommands[mCurrentIndex - 1]->getText(),
+               timer.nsecsElapsed());
     mCurrentIndex--;
   } catch (Exception& e) {
     qCritical() << "UndoCommand::undo() has thrown an exception:" << e.getMsg();
@@ -285,12 +342,7 @@ void UndoStack::undo() {
   }
 
   // emit signals
-  emit undoTextChanged(getUndoText());
-  emit redoTextChanged(getRedoText());
-  emit canUndoChanged(canUndo());
-  emit canRedoChanged(canRedo());
-  emit cleanChanged(isClean());
-  emit stateModified();
+  notifyStateChanged();
 }
 
 void UndoStack::redo() {
@@ -298,8 +350,14 @@ void UndoStack::redo() {
     return;
   }
 
+  UndoStackBatch batch(*this);
+
   try {
+    QElapsedTimer timer;
+    timer.start();
     mCommands[mCurrentIndex]->redo();  // can throw (but should usually not)
+    logCommand("redo", mCommands[mCurrentIndex]->getText(),
+               timer.nsecsElapsed());
     mCurrentIndex++;
   } catch (Exception& e) {
     qCritical() << "UndoCommand::redo() has thrown an exception:" << e.getMsg();
@@ -307,12 +365,7 @@ void UndoStack::redo() {
   }
 
   // emit signals
-  emit undoTextChanged(getUndoText());
-  emit redoTextChanged(getRedoText());
-  emit canUndoChanged(canUndo());
-  emit canRedoChanged(canRedo());
-  emit cleanChanged(isClean());
-  emit stateModified();
+  notifyStateChanged();
 }
 
 void UndoStack::clear() noexcept {
@@ -346,6 +399,83 @@ void UndoStack::clear() noexcept {
   emit cleanChanged(true);
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void UndoStack::notifyStateChanged() noexcept {
+  if (mBatchDepth > 0) {
+    // emit the signals only once when leaving the outermost batch
+    mStateChangePending = true;
+    return;
+  }
+
+  emit undoTextChanged(getUndoText());
+  emit redoTextChanged(getRedoText());
+  emit canUndoChanged(canUndo() && (!isCommandGroupActive()));
+  emit canRedoChanged(canRedo());
+  emit cleanChanged(isClean());
+  emit stateModified();
+}
+
+bool UndoStack::trimToCommandLimit() noexcept {
+  bool trimmed = false;
+  while ((mCommandLimit > 0) && (mCommands.count() > mCommandLimit) &&
+         (mCurrentIndex > 0) && (mCommands.first() != mActiveCommandGroup)) {
+    // the command is currently executed, so deleting it doesn't revert
+    // anything (it just can't be undone anymore)
+    delete mCommands.takeFirst();
+    mCurrentIndex--;
+    // if the clean state was the deleted one, it can't be reached anymore
+    mCleanIndex = (mCleanIndex > 0) ? (mCleanIndex - 1) : -1;
+    trimmed     = true;
+  }
+  return trimmed;
+}
+
+void UndoStack::logCommand(const char* action, const QString& text,
+                           qint64 nsecs) const noexcept {
+  QFile* file = getCommandLogFile();
+  if (!file) {
+    return;
+  }
+
+  // One tab separated line per action, so the log can be analyzed easily
+  // with a spreadsheet or command line tools. The stack address allows to
+  // distinguish between multiple open documents.
+  QDateTime now  = QDateTime::currentDateTime();
+  QString   line = QString("%1\t%2\t%3\t%4\t%5\n")
+                     .arg(now.toString("yyyy-MM-ddTHH:mm:ss.zzz"))
+                     .arg(reinterpret_cast<quintptr>(this), 0, 16)
+                     .arg(QString(action))
+                     .arg(nsecs / 1000000.0, 0, 'f', 3)
+                     .arg(QString(text).replace('\t', ' ').replace('\n', ' '));
+  file->write(line.toUtf8());
+  file->flush();
+}
+
+/*******************************************************************************
+ *  Private Static Methods
+ ******************************************************************************/
+
+QFile* UndoStack::getCommandLogFile() noexcept {
+  static QFile* file = []() -> QFile* {
+    QString fp = QString::fromLocal8Bit(qgetenv("LIBREPCB_UNDO_LOG"));
+    if (fp.isEmpty()) {
+      return nullptr;
+    }
+    QFile* f = new QFile(fp);  // intentionally never deleted
+    if (!f->open(QIODevice::WriteOnly | QIODevice::Append)) {
+      qWarning() << "Could not open undo log file:" << fp;
+      delete f;
+      return nullptr;
+    }
+    qDebug() << "Logging executed commands to" << fp;
+    return f;
+  }();
+  return file;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
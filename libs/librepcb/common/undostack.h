@@ -75,6 +75,33 @@ private:
   bool       mCmdActive;
 };
 
+/*******************************************************************************
+ *  Class UndoStackBatch
+ ******************************************************************************/
+
+/**
+ * @brief The UndoStackBatch class is a RAII helper for
+ * librepcb::UndoStack::beginBatch() and librepcb::UndoStack::endBatch()
+ *
+ * All signals of the stack are emitted only once, when the last batch object
+ * goes out of scope. This is useful to execute many commands in a row without
+ * triggering listeners many times.
+ */
+class UndoStackBatch final {
+public:
+  // Constructors / Destructor
+  UndoStackBatch()                            = delete;
+  UndoStackBatch(const UndoStackBatch& other) = delete;
+  explicit UndoStackBatch(UndoStack& stack) noexcept;
+  ~UndoStackBatch() noexcept;
+
+  // Operator Overloadings
+  UndoStackBatch& operator=(const UndoStackBatch& rhs) = delete;
+
+private:
+  UndoStack& mStack;
+};
+
 /*******************************************************************************
  *  Class UndoStack
  ******************************************************************************/
@@ -102,6 +129,11 @@ private:
  * similar mechanism, see next line)...
  *  - <b>Added support for exclusive macro command creation:</b>
  *
+ * If the environment variable `LIBREPCB_UNDO_LOG` is set to a file path, the
+ * text and execution time of every executed, undone and redone command is
+ * appended to that file. This allows to record editing sessions of real
+ * projects to find out which operations are slow.
+ *
  * @see ::librepcb::UndoCommand, ::librepcb::UndoCommandGroup
  */
 class UndoStack final : public QObject {
@@ -148,6 +180,20 @@ public:
    */
   bool canRedo() const noexcept;
 
+  /**
+   * @brief Get the number of commands on the stack (both undo and redo)
+   *
+   * @return Number of top-level commands (command groups count as one)
+   */
+  int getCommandCount() const noexcept { return mCommands.count(); }
+
+  /**
+   * @brief Get the maximum number of commands kept on the stack
+   *
+   * @return Maximum number of top-level commands (0 means unlimited)
+   */
+  int getCommandLimit() const noexcept { return mCommandLimit; }
+
   /**
    * @brief Check if the stack is in a clean state (the state of the last
    * #setClean())
@@ -167,6 +213,18 @@ public:
    */
   bool isCommandGroupActive() const noexcept;
 
+  /**
+   * @brief Check if a batch is active at the moment (see #beginBatch())
+   *
+   * While commands are executed, undone or redone by the stack, a batch is
+   * always active. Listeners of fine-grained change notifications (e.g. "item
+   * added") can use this to postpone expensive updates until #stateModified()
+   * is emitted.
+   *
+   * @return True if a batch is currently active
+   */
+  bool isBatchActive() const noexcept { return mBatchDepth > 0; }
+
   // Setters
 
   /**
@@ -174,8 +232,33 @@ public:
    */
   void setClean() noexcept;
 
+  /**
+   * @brief Set the maximum number of commands kept on the stack
+   *
+   * If more commands get pushed, the oldest ones are deleted (they can no
+   * longer be undone). This bounds the memory used by long editing sessions.
+   *
+   * @param limit     Maximum number of top-level commands (0 means unlimited)
+   */
+  void setCommandLimit(int limit) noexcept;
+
   // General Methods
 
+  /**
+   * @brief Begin a batch of modifications
+   *
+   * Until the corresponding #endBatch() call, the signals of this stack are
+   * not emitted. Instead, they are emitted only once with the final state when
+   * the outermost batch ends. Batches can be nested. Use UndoStackBatch to
+   * ensure #endBatch() is always called.
+   */
+  void beginBatch() noexcept;
+
+  /**
+   * @brief End a batch of modifications started with #beginBatch()
+   */
+  void endBatch() noexcept;
+
   /**
    * @brief Execute a command and push it to the stack (similar to
    * QUndoStack#push())
@@ -188,6 +271,9 @@ public:
    * method.
    * @param forceKeepCmd  Only for internal use!
    *
+   * @note If the command could be merged into the command on top of the stack
+   * (see UndoCommand#mergeWith()), it is deleted instead of being pushed.
+   *
    * @retval true     If the command has done some changes
    * @retval false    If the command has done nothing
    *
@@ -290,7 +376,40 @@ signals:
   void commandGroupAborted();
   void stateModified();
 
-private:
+private:  // Methods
+  /**
+   * @brief Emit all state signals, or defer them if a batch is active
+   */
+  void notifyStateChanged() noexcept;
+
+  /**
+   * @brief Delete the oldest commands until #mCommandLimit is respected
+   *
+   * Only commands below #mCurrentIndex are deleted, i.e. redoable commands
+   * and the currently active command group are always kept.
+   *
+   * @return Whether at least one command was deleted
+   */
+  bool trimToCommandLimit() noexcept;
+
+  /**
+   * @brief Append a command to the log file specified by `LIBREPCB_UNDO_LOG`
+   *
+   * @param action    The performed action ("exec", "undo", ...)
+   * @param text      Text of the command
+   * @param nsecs     Time it took to perform the action [ns]
+   */
+  void logCommand(const char* action, const QString& text, qint64 nsecs) const
+      noexcept;
+
+  /**
+   * @brief Get the file to log commands to
+   *
+   * @return The opened log file, or nullptr if logging is disabled
+   */
+  static QFile* getCommandLogFile() noexcept;
+
+private:  // Data
   /**
    * @brief This list holds all commands of the undo stack
    *
@@ -315,6 +434,11 @@ private:
    */
   int mCleanIndex;
 
+  /**
+   * @brief Maximum number of commands in #mCommands (0 means unlimited)
+   */
+  int mCommandLimit;
+
   /**
    * @brief If a command group is active at the moment, this is the pointer to
    * it
@@ -324,6 +448,16 @@ private:
    * nullptr.
    */
   UndoCommandGroup* mActiveCommandGroup;
+
+  /**
+   * @brief Nesting depth of #beginBatch() calls (0 = no batch active)
+   */
+  int mBatchDepth;
+
+  /**
+   * @brief Whether state signals need to be emitted at the end of the batch
+   */
+  bool mStateChangePending;
 };
 
 /*******************************************************************************
@@ -40,7 +40,42 @@ namespace librepcb {
  ******************************************************************************/
 
 QString Length::toMmString() const noexcept {
-  return Toolbox::decimalFixedPointToString<LengthBase_t>(toNm(), 6);
+  // Same result as Toolbox::decimalFixedPointToString<LengthBase_t>(toNm(), 6),
+  // but formatted into a stack buffer without any temporary strings since
+  // this is called for every single coordinate when saving files.
+  if (mNanometers == 0) {
+    return QStringLiteral("0.0");  // special case
+  }
+  using UnsignedT    = std::make_unsigned<LengthBase_t>::type;
+  UnsignedT valueAbs = (mNanometers < 0)
+      ? -static_cast<UnsignedT>(mNanometers)
+      : static_cast<UnsignedT>(mNanometers);
+
+  // fill the buffer from its end, omitting trailing zeros of the decimals
+  char  buffer[32];
+  char* end         = buffer + sizeof(buffer);
+  char* p           = end;
+  bool  significant = false;
+  for (int i = 0; i < 6; ++i) {
+    char digit = static_cast<char>('0' + (valueAbs % 10));
+    valueAbs /= 10;
+    if (significant || (digit != '0')) {
+      *--p        = digit;
+      significant = true;
+    }
+  }
+  if (!significant) {
+    *--p = '0';  // keep at least one decimal, e.g. "1.0"
+  }
+  *--p = '.';
+  do {
+    *--p = static_cast<char>('0' + (valueAbs % 10));
+    valueAbs /= 10;
+  } while (valueAbs > 0);
+  if (mNanometers < 0) {
+    *--p = '-';
+  }
+  return QString::fromLatin1(p, static_cast<int>(end - p));
 }
 
 /*******************************************************************************
@@ -184,7 +219,73 @@ LengthBase_t Length::mapNmToGrid(LengthBase_t  nanometers,
 }
 
 LengthBase_t Length::mmStringToNm(const QString& millimeters) {
-  return Toolbox::decimalFixedPointFromString<LengthBase_t>(millimeters, 6);
+  LengthBase_t nm;
+  if (tryParsePlainMmString(millimeters, nm)) {
+    return nm;
+  }
+  return Toolbox::decimalFixedPointFromString<LengthBase_t>(millimeters,
+                                                            6);  // can throw
+}
+
+bool Length::tryParsePlainMmString(const QString& millimeters,
+                                   LengthBase_t&  nanometers) noexcept {
+  const QChar* c   = millimeters.constData();
+  const QChar* end = c + millimeters.size();
+  auto isDigit     = [](const QChar* ch) {
+    return (ch->unicode() >= '0') && (ch->unicode() <= '9');
+  };
+
+  bool negative = (c != end) && (*c == '-');
+  if (negative) {
+    ++c;
+  }
+
+  // integer part (limited to 12 digits to avoid overflows)
+  quint64      value    = 0;
+  const QChar* intBegin = c;
+  while ((c != end) && isDigit(c)) {
+    if ((c - intBegin) >= 12) {
+      return false;
+    }
+    value = (value * 10) + (c->unicode() - '0');
+    ++c;
+  }
+  if (c == intBegin) {
+    return false;  // e.g. ".1" or empty string
+  }
+
+  // decimal part (at least one, at most six digits)
+  int decimals = 0;
+  if ((c != end) && (*c == '.')) {
+    ++c;
+    while ((c != end) && isDigit(c)) {
+      if (decimals >= 6) {
+        return false;
+      }
+      value = (value * 10) + (c->unicode() - '0');
+      ++decimals;
+      ++c;
+    }
+    if (decimals == 0) {
+      return false;  // e.g. "1."
+    }
+  }
+  if (c != end) {
+    return false;  // e.g. an exponent or an invalid character
+  }
+  for (; decimals < 6; ++decimals) {
+    value *= 10;
+  }
+
+  // range check
+  const quint64 max =
+      static_cast<quint64>(std::numeric_limits<LengthBase_t>::max());
+  if (value > (negative ? (max + 1) : max)) {
+    return false;
+  }
+  nanometers = negative ? static_cast<LengthBase_t>(0 - value)
+                        : static_cast<LengthBase_t>(value);
+  return true;
 }
 
 /*******************************************************************************
@@ -600,6 +600,23 @@ private:
    */
   static LengthBase_t mmStringToNm(const QString& millimeters);
 
+  /**
+   * @brief Fast path of #mmStringToNm() for plain decimal numbers
+   *
+   * Handles only the format written by #toMmString() (e.g. "-12.345"),
+   * which makes up almost all numbers in files, without any unicode or
+   * exponent handling.
+   *
+   * @param millimeters   The string to parse.
+   * @param nanometers    The parsed value (only set on success).
+   *
+   * @retval true   If the string was parsed successfully.
+   * @retval false  If the string has to be parsed by the generic parser
+   *                (which also reports errors).
+   */
+  static bool tryParsePlainMmString(const QString& millimeters,
+                                    LengthBase_t&  nanometers) noexcept;
+
   // Private Member Variables
   LengthBase_t mNanometers;  ///< the length in nanometers
 
@@ -0,0 +1,181 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_BOUNDEDQUEUE_H
+#define LIBREPCB_BOUNDEDQUEUE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class BoundedQueue
+ ******************************************************************************/
+
+/**
+ * @brief Lock-free FIFO queue with a fixed capacity
+ *
+ * Any number of threads may push and pop elements concurrently without
+ * taking a lock. Instead of blocking, #tryPush() fails if the queue is full
+ * and #tryPop() fails if the queue is empty.
+ *
+ * Implementation of the bounded MPMC queue by Dmitry Vyukov, see
+ * http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+ *
+ * @tparam T  Element type, must be default constructible and movable.
+ */
+template <typename T>
+class BoundedQueue final {
+public:
+  // Constructors / Destructor
+  BoundedQueue()                          = delete;
+  BoundedQueue(const BoundedQueue& other) = delete;
+
+  /**
+   * @brief Constructor
+   *
+   * @param capacity  Minimum capacity of the queue, will be rounded up to the
+   *                  next power of two.
+   */
+  explicit BoundedQueue(std::size_t capacity) noexcept
+    : mMask(roundUpToPowerOfTwo(capacity) - 1),
+      mCells(new Cell[mMask + 1]),
+      mEnqueuePos(0),
+      mDequeuePos(0) {
+    for (std::size_t i = 0; i <= mMask; ++i) {
+      mCells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+  ~BoundedQueue() noexcept {}
+
+  // Getters
+  std::size_t getCapacity() const noexcept { return mMask + 1; }
+
+  // General Methods
+
+  /**
+   * @brief Append an element to the end of the queue
+   *
+   * @param value   The element to append
+   *
+   * @retval true   If the element was appended.
+   * @retval false  If the queue is full, thus the element was not appended.
+   */
+  bool tryPush(T value) noexcept {
+    Cell*       cell = nullptr;
+    std::size_t pos  = mEnqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &mCells[pos & mMask];
+      const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t diff =
+          static_cast<std::ptrdiff_t>(seq) -
+          static_cast<std::ptrdiff_t>(pos);
+      if (diff == 0) {
+        if (mEnqueuePos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = mEnqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+    cell->data = std::move(value);
+    cell->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * @brief Remove the first element from the queue
+   *
+   * @param value   The removed element is moved into this object.
+   *
+   * @retval true   If an element was removed.
+   * @retval false  If the queue is empty, thus \p value was not modified.
+   */
+  bool tryPop(T& value) noexcept {
+    Cell*       cell = nullptr;
+    std::size_t pos  = mDequeuePos.load(std::memory_order_relaxed);
+    while (true) {
+      cell = &mCells[pos & mMask];
+      const std::size_t seq = cell->sequence.load(std::memory_order_acquire);
+      const std::ptrdiff_t diff =
+          static_cast<std::ptrdiff_t>(seq) -
+          static_cast<std::ptrdiff_t>(pos + 1);
+      if (diff == 0) {
+        if (mDequeuePos.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // empty
+      } else {
+        pos = mDequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+    value      = std::move(cell->data);
+    cell->data = T();  // release resources immediately
+    cell->sequence.store(pos + mMask + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Operator Overloadings
+  BoundedQueue& operator=(const BoundedQueue& rhs) = delete;
+
+private:  // Types
+  struct Cell {
+    std::atomic<std::size_t> sequence;
+    T                        data;
+  };
+
+private:  // Methods
+  static std::size_t roundUpToPowerOfTwo(std::size_t value) noexcept {
+    std::size_t result = 2;
+    while (result < value) {
+      result *= 2;
+    }
+    return result;
+  }
+
+private:  // Data
+  const std::size_t        mMask;  ///< capacity - 1
+  std::unique_ptr<Cell[]>  mCells;
+  std::atomic<std::size_t> mEnqueuePos;
+  std::atomic<std::size_t> mDequeuePos;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_BOUNDEDQUEUE_H
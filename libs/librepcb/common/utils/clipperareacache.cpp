@@ -0,0 +1,116 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "clipperareacache.h"
+
+#include "clipperhelpers.h"
+#include "transform.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+uint qHash(const ClipperAreaCache::Key& key, uint seed) noexcept {
+  foreach (const Path& path, key.paths) {
+    seed = qHash(path, seed);
+  }
+  seed = qHash(key.offset, seed);
+  return qHash(key.maxArcTolerance, seed);
+}
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ClipperAreaCache::ClipperAreaCache() noexcept : mMutex(), mAreas() {
+}
+
+ClipperAreaCache::~ClipperAreaCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+ClipperLib::Paths ClipperAreaCache::get(const QVector<Path>&  paths,
+                                        const Length&         offset,
+                                        const PositiveLength& maxArcTolerance,
+                                        const Transform&      transform) {
+  Key               key{paths, offset, *maxArcTolerance};
+  ClipperLib::Paths area;
+  bool              found = false;
+  {
+    QMutexLocker lock(&mMutex);
+    auto         it = mAreas.constFind(key);
+    if (it != mAreas.constEnd()) {
+      area  = *it;
+      found = true;
+    }
+  }
+  if (!found) {
+    // calculate without holding the lock, this is the expensive part
+    foreach (const Path& path, paths) {
+      ClipperHelpers::unite(
+          area, ClipperHelpers::convert(path, maxArcTolerance));  // can throw
+    }
+    ClipperHelpers::offset(area, offset, maxArcTolerance);  // can throw
+    QMutexLocker lock(&mMutex);
+    if (mAreas.count() >= sMaxCount) {
+      mAreas.clear();
+    }
+    mAreas.insert(key, area);
+  }
+  for (ClipperLib::Path& path : area) {
+    for (ClipperLib::IntPoint& p : path) {
+      p = ClipperHelpers::convert(transform.map(ClipperHelpers::convert(p)));
+    }
+  }
+  return area;
+}
+
+int ClipperAreaCache::getCount() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mAreas.count();
+}
+
+void ClipperAreaCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mAreas.clear();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+ClipperAreaCache& ClipperAreaCache::instance() noexcept {
+  static ClipperAreaCache cache;
+  return cache;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
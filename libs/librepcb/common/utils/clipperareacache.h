@@ -0,0 +1,136 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CLIPPERAREACACHE_H
+#define LIBREPCB_CLIPPERAREACACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../geometry/path.h"
+#include "../units/all_length_units.h"
+
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class Transform;
+
+/*******************************************************************************
+ *  Class ClipperAreaCache
+ ******************************************************************************/
+
+/**
+ * @brief Shared cache of united and offset areas converted to Clipper paths
+ *
+ * Some areas are derived from library elements which are placed many times,
+ * for example the courtyard of a footprint which is used by lots of devices
+ * on several boards. Uniting and offsetting the paths of such an area is
+ * expensive, but the result only depends on the paths in the coordinate
+ * system of the library element. So this cache stores the result of every
+ * distinct area once, and only the placement transformation is applied for
+ * every instance.
+ *
+ * The cache is shared across the whole application and access to it is
+ * thread-safe, so it can be used from worker threads (e.g. the design rule
+ * check) as well.
+ *
+ * @see ::librepcb::ClipperShapeCache
+ */
+class ClipperAreaCache final {
+public:
+  // Constructors / Destructor
+  ClipperAreaCache(const ClipperAreaCache& other) = delete;
+  ~ClipperAreaCache() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Get an area converted to Clipper paths
+   *
+   * @param paths           The paths of the area, in local coordinates. They
+   *                        get united, so they may overlap.
+   * @param offset          Offset to apply to the united area (may be
+   *                        negative or zero).
+   * @param maxArcTolerance Maximum allowed tolerance when flattening arcs.
+   * @param transform       The transformation to apply to the result.
+   *
+   * @return The united and offset area, transformed by the given transform.
+   *         The result is equivalent to uniting and offsetting the
+   *         transformed paths (possibly except for rounding differences).
+   *
+   * @throw Exception   If uniting or offsetting the paths failed.
+   */
+  ClipperLib::Paths get(const QVector<Path>& paths, const Length& offset,
+                        const PositiveLength& maxArcTolerance,
+                        const Transform&      transform);
+
+  /**
+   * @brief Get the number of cached areas
+   *
+   * @return Count of areas currently held by the cache.
+   */
+  int getCount() const noexcept;
+
+  /**
+   * @brief Remove all areas from the cache
+   */
+  void clear() noexcept;
+
+  // Operator Overloadings
+  ClipperAreaCache& operator=(const ClipperAreaCache& rhs) = delete;
+
+  // Static Methods
+  static ClipperAreaCache& instance() noexcept;
+
+private:  // Methods
+  ClipperAreaCache() noexcept;
+
+private:  // Data
+  struct Key {
+    QVector<Path> paths;
+    Length        offset;
+    Length        maxArcTolerance;
+
+    bool operator==(const Key& rhs) const noexcept {
+      return (paths == rhs.paths) && (offset == rhs.offset) &&
+             (maxArcTolerance == rhs.maxArcTolerance);
+    }
+  };
+  friend uint qHash(const Key& key, uint seed) noexcept;
+
+  /// Upper limit of cached areas to avoid unbounded memory usage
+  static constexpr int sMaxCount = 1000;
+
+  mutable QMutex                mMutex;
+  QHash<Key, ClipperLib::Paths> mAreas;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CLIPPERAREACACHE_H
@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "clipperhelpers.h"
 
+#include "../toolbox.h"
+
 #include <QtCore>
 
 /*******************************************************************************
@@ -73,6 +75,22 @@ void ClipperHelpers::unite(ClipperLib::Paths&       subject,
   }
 }
 
+std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::uniteToTree(
+    const ClipperLib::Paths& paths) {
+  try {
+    // see comment in intersect()
+    std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
+    ClipperLib::Clipper                   c;
+    c.AddPaths(paths, ClipperLib::ptSubject, true);
+    c.Execute(ClipperLib::ctUnion, *result, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    return result;
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     tr("Failed to unite paths: %1").arg(e.what()));
+  }
+}
+
 std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::intersect(
     const ClipperLib::Paths& subject, const ClipperLib::Paths& clip) {
   try {
@@ -105,6 +123,23 @@ void ClipperHelpers::subtract(ClipperLib::Paths&       subject,
   }
 }
 
+std::unique_ptr<ClipperLib::PolyTree> ClipperHelpers::subtractToTree(
+    const ClipperLib::Paths& subject, const ClipperLib::Paths& clip) {
+  try {
+    // see comment in intersect()
+    std::unique_ptr<ClipperLib::PolyTree> result(new ClipperLib::PolyTree());
+    ClipperLib::Clipper                   c;
+    c.AddPaths(subject, ClipperLib::ptSubject, true);
+    c.AddPaths(clip, ClipperLib::ptClip, true);
+    c.Execute(ClipperLib::ctDifference, *result, ClipperLib::pftNonZero,
+              ClipperLib::pftNonZero);
+    return result;
+  } catch (const std::exception& e) {
+    throw LogicError(__FILE__, __LINE__,
+                     tr("Failed to subtract paths: %1").arg(e.what()));
+  }
+}
+
 void ClipperHelpers::offset(ClipperLib::Paths& paths, const Length& offset,
                             const PositiveLength& maxArcTolerance) {
   try {
@@ -137,6 +172,50 @@ ClipperLib::Paths ClipperHelpers::flattenTree(
   return paths;
 }
 
+ClipperLib::IntRect ClipperHelpers::getBoundingRect(
+    const ClipperLib::Paths& paths) noexcept {
+  ClipperLib::IntRect rect = {1, 1, 0, 0};  // inverted -> empty
+  for (const ClipperLib::Path& path : paths) {
+    ClipperLib::IntRect r = getBoundingRect(path);
+    if (r.left > r.right) {
+      continue;  // empty path
+    } else if (rect.left > rect.right) {
+      rect = r;
+    } else {
+      rect.left   = qMin(rect.left, r.left);
+      rect.top    = qMin(rect.top, r.top);
+      rect.right  = qMax(rect.right, r.right);
+      rect.bottom = qMax(rect.bottom, r.bottom);
+    }
+  }
+  return rect;
+}
+
+ClipperLib::IntRect ClipperHelpers::getBoundingRect(
+    const ClipperLib::Path& path) noexcept {
+  if (path.empty()) {
+    return {1, 1, 0, 0};  // inverted -> empty
+  }
+  ClipperLib::IntRect rect = {path.front().X, path.front().Y, path.front().X,
+                              path.front().Y};
+  for (const ClipperLib::IntPoint& p : path) {
+    rect.left   = qMin(rect.left, p.X);
+    rect.top    = qMin(rect.top, p.Y);
+    rect.right  = qMax(rect.right, p.X);
+    rect.bottom = qMax(rect.bottom, p.Y);
+  }
+  return rect;
+}
+
+bool ClipperHelpers::intersects(const ClipperLib::IntRect& r1,
+                                const ClipperLib::IntRect& r2) noexcept {
+  if ((r1.left > r1.right) || (r2.left > r2.right)) {
+    return false;  // at least one of the rectangles is empty
+  }
+  return (r1.left <= r2.right) && (r2.left <= r1.right) &&
+         (r1.top <= r2.bottom) && (r2.top <= r1.bottom);
+}
+
 /*******************************************************************************
  *  Conversion Methods
  ******************************************************************************/
@@ -176,20 +255,32 @@ ClipperLib::Paths ClipperHelpers::convert(
 
 ClipperLib::Path ClipperHelpers::convert(
     const Path& path, const PositiveLength& maxArcTolerance) noexcept {
+  const QVector<Vertex>& vertices = path.getVertices();
+
+  // determine the number of segments first to allocate the memory only once
+  QVarLengthArray<int, 64> segments(vertices.count());
+  std::size_t              count = 0;
+  for (int i = 0; i < vertices.count(); ++i) {
+    const Vertex& v0 = vertices.at(qMax(i - 1, 0));
+    if ((i == 0) || (v0.getAngle() == 0)) {
+      segments[i] = 1;
+    } else {
+      segments[i] = Path::flatArcSegmentCount(
+          v0.getPos(), vertices.at(i).getPos(), v0.getAngle(), maxArcTolerance);
+    }
+    count += segments[i];
+  }
+
   ClipperLib::Path p;
-  for (int i = 0; i < path.getVertices().count(); ++i) {
-    const Vertex& v  = path.getVertices().at(i);
-    const Vertex& v0 = path.getVertices().at(qMax(i - 1, 0));
+  p.reserve(count);
+  for (int i = 0; i < vertices.count(); ++i) {
+    const Vertex& v  = vertices.at(i);
+    const Vertex& v0 = vertices.at(qMax(i - 1, 0));
     if ((i == 0) || (v0.getAngle() == 0)) {
       p.push_back(convert(v.getPos()));
     } else {
       // approximate arcs by many short straight line segments
-      Path arc = Path::flatArc(v0.getPos(), v.getPos(), v0.getAngle(),
-                               maxArcTolerance);
-      // skip first point as it is would be a duplicate
-      for (int k = 1; k < arc.getVertices().count(); ++k) {
-        p.push_back(convert(arc.getVertices().at(k).getPos()));
-      }
+      appendFlatArc(p, v0.getPos(), v.getPos(), v0.getAngle(), segments[i]);
     }
   }
   // make sure all paths have the same orientation, otherwise we get strange
@@ -208,6 +299,22 @@ ClipperLib::IntPoint ClipperHelpers::convert(const Point& point) noexcept {
  *  Internal Helper Methods
  ******************************************************************************/
 
+void ClipperHelpers::appendFlatArc(ClipperLib::Path& path, const Point& p1,
+                                   const Point& p2, const Angle& angle,
+                                   int segments) noexcept {
+  // Same points as Path::flatArc(), but without the temporary path. Not using
+  // a cheaper rotation recurrence since plane fingerprints and exported files
+  // must not change. The start point is skipped as it is already added.
+  if (segments > 1) {
+    qreal angleDelta = angle.toMicroDeg() / (qreal)segments;
+    Point center     = Toolbox::arcCenter(p1, p2, angle);
+    for (int k = 1; k < segments; ++k) {
+      path.push_back(convert(p1.rotated(Angle(angleDelta * k), center)));
+    }
+  }
+  path.push_back(convert(p2));
+}
+
 ClipperLib::Path ClipperHelpers::convertHolesToCutIns(
     const ClipperLib::Path& outline, const ClipperLib::Paths& holes) {
   ClipperLib::Path  path          = outline;
@@ -55,14 +55,50 @@ public:
   static void unite(ClipperLib::Paths& paths);
   static void unite(ClipperLib::Paths& subject, const ClipperLib::Path& clip);
   static void unite(ClipperLib::Paths& subject, const ClipperLib::Paths& clip);
+
+  /**
+   * @brief Unite (possibly overlapping) areas into a tree of outlines and holes
+   *
+   * In contrast to #unite(), the non-zero fill rule is used so overlapping
+   * areas do not cancel out each other. Thus all paths must have the same
+   * orientation.
+   *
+   * @param paths   The areas to unite.
+   *
+   * @return The united areas.
+   */
+  static std::unique_ptr<ClipperLib::PolyTree> uniteToTree(
+      const ClipperLib::Paths& paths);
   static std::unique_ptr<ClipperLib::PolyTree> intersect(
       const ClipperLib::Paths& subject, const ClipperLib::Paths& clip);
   static void subtract(ClipperLib::Paths&       subject,
                        const ClipperLib::Paths& clip);
+  static std::unique_ptr<ClipperLib::PolyTree> subtractToTree(
+      const ClipperLib::Paths& subject, const ClipperLib::Paths& clip);
   static void offset(ClipperLib::Paths& paths, const Length& offset,
                      const PositiveLength& maxArcTolerance);
   static ClipperLib::Paths flattenTree(const ClipperLib::PolyNode& node);
 
+  /**
+   * @brief Calculate the axis-aligned bounding rectangle of some paths
+   *
+   * @param paths     The paths to get the bounding rectangle from.
+   *
+   * @return The bounding rectangle. If there are no vertices at all, an
+   *         inverted (left > right) rectangle is returned which never
+   *         intersects with any other rectangle.
+   */
+  static ClipperLib::IntRect getBoundingRect(
+      const ClipperLib::Paths& paths) noexcept;
+  static ClipperLib::IntRect getBoundingRect(
+      const ClipperLib::Path& path) noexcept;
+
+  /**
+   * @brief Check whether two bounding rectangles overlap (or touch)
+   */
+  static bool intersects(const ClipperLib::IntRect& r1,
+                         const ClipperLib::IntRect& r2) noexcept;
+
   // Type Conversions
   static QVector<Path>     convert(const ClipperLib::Paths& paths) noexcept;
   static Path              convert(const ClipperLib::Path& path) noexcept;
@@ -75,6 +111,9 @@ public:
   static ClipperLib::IntPoint convert(const Point& point) noexcept;
 
 private:  // Internal Helper Methods
+  static void appendFlatArc(ClipperLib::Path& path, const Point& p1,
+                            const Point& p2, const Angle& angle,
+                            int segments) noexcept;
   static ClipperLib::Path  convertHolesToCutIns(const ClipperLib::Path&  outline,
                                                 const ClipperLib::Paths& holes);
   static ClipperLib::Paths prepareHoles(
@@ -0,0 +1,130 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "clipperoutlinecache.h"
+
+#include "clipperhelpers.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ClipperOutlineCache::ClipperOutlineCache() noexcept
+  : mMutex(), mRevision(0), mOutlines(), mEntries() {
+}
+
+ClipperOutlineCache::~ClipperOutlineCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+Path ClipperOutlineCache::getOutline(
+    quint64 revision, const Length& expansion,
+    const OutlineGenerator& generator) const noexcept {
+  {
+    QMutexLocker lock(&mMutex);
+    setRevision(revision);
+    foreach (const auto& outline, mOutlines) {
+      if (outline.first == expansion) {
+        return outline.second;
+      }
+    }
+  }
+
+  Path         outline = generator(expansion);
+  QMutexLocker lock(&mMutex);
+  if (revision == mRevision) {  // don't store outdated outlines
+    if (mOutlines.count() >= sMaxCount) {
+      mOutlines.removeFirst();
+    }
+    mOutlines.append(qMakePair(expansion, outline));
+  }
+  return outline;
+}
+
+ClipperLib::Path ClipperOutlineCache::get(
+    quint64 revision, const Length& expansion,
+    const PositiveLength&   maxArcTolerance,
+    const OutlineGenerator& generator) const noexcept {
+  {
+    QMutexLocker lock(&mMutex);
+    setRevision(revision);
+    foreach (const Entry& entry, mEntries) {
+      if ((entry.expansion == expansion) &&
+          (entry.maxArcTolerance == *maxArcTolerance)) {
+        return entry.path;
+      }
+    }
+  }
+
+  // convert without holding the lock, the conversion is the expensive part
+  ClipperLib::Path path = ClipperHelpers::convert(
+      getOutline(revision, expansion, generator), maxArcTolerance);
+  QMutexLocker lock(&mMutex);
+  if (revision == mRevision) {  // don't store outdated outlines
+    if (mEntries.count() >= sMaxCount) {
+      mEntries.removeFirst();
+    }
+    mEntries.append(Entry{expansion, *maxArcTolerance, path});
+  }
+  return path;
+}
+
+int ClipperOutlineCache::getCount() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mEntries.count();
+}
+
+void ClipperOutlineCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mOutlines.clear();
+  mEntries.clear();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void ClipperOutlineCache::setRevision(quint64 revision) const noexcept {
+  // note: the mutex must be locked by the caller
+  if (revision != mRevision) {
+    mOutlines.clear();
+    mEntries.clear();
+    mRevision = revision;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,145 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_CLIPPEROUTLINECACHE_H
+#define LIBREPCB_CLIPPEROUTLINECACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../geometry/path.h"
+#include "../units/all_length_units.h"
+
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class ClipperOutlineCache
+ ******************************************************************************/
+
+/**
+ * @brief Per-item cache of an outline converted to Clipper paths
+ *
+ * In contrast to ::librepcb::ClipperShapeCache, which is shared across the
+ * whole application and caches shapes relative to their origin, this cache
+ * is owned by a single item and stores its outline as placed in the scene,
+ * both as ::librepcb::Path and converted to Clipper paths.
+ * The entries are keyed by the revision of the item's geometry, the
+ * expansion of the outline and the arc tolerance. All entries of older
+ * revisions are discarded as soon as the outline is requested with a new
+ * revision, so the cache gets invalidated only if the item was actually
+ * moved or modified.
+ *
+ * Access is thread-safe, so it can be used from worker threads (e.g. plane
+ * builder) as well.
+ */
+class ClipperOutlineCache final {
+public:
+  // Types
+  typedef std::function<Path(const Length&)> OutlineGenerator;
+
+  // Constructors / Destructor
+  ClipperOutlineCache() noexcept;
+  ClipperOutlineCache(const ClipperOutlineCache& other) = delete;
+  ~ClipperOutlineCache() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Get the outline
+   *
+   * @param revision        Revision of the item's geometry.
+   * @param expansion       Expansion of the outline (e.g. a clearance).
+   * @param generator       Called to get the outline (with the expansion
+   *                        passed as argument) if it is not cached yet.
+   *
+   * @return The outline returned by the generator (possibly cached).
+   */
+  Path getOutline(quint64 revision, const Length& expansion,
+                  const OutlineGenerator& generator) const noexcept;
+
+  /**
+   * @brief Get the outline converted to a Clipper path
+   *
+   * @param revision        Revision of the item's geometry.
+   * @param expansion       Expansion of the outline (e.g. a clearance).
+   * @param maxArcTolerance Maximum allowed tolerance when flattening arcs.
+   * @param generator       Called to get the outline (with the expansion
+   *                        passed as argument) if it is not cached yet.
+   *
+   * @return The converted path, identical to ClipperHelpers::convert() of
+   *         the outline returned by the generator. The outline itself is
+   *         taken from the same cache as #getOutline() uses.
+   */
+  ClipperLib::Path get(quint64 revision, const Length& expansion,
+                       const PositiveLength&   maxArcTolerance,
+                       const OutlineGenerator& generator) const noexcept;
+
+  /**
+   * @brief Get the number of cached Clipper paths
+   *
+   * @return Count of converted outlines currently held by the cache.
+   */
+  int getCount() const noexcept;
+
+  /**
+   * @brief Remove all outlines from the cache
+   */
+  void clear() noexcept;
+
+  // Operator Overloadings
+  ClipperOutlineCache& operator=(const ClipperOutlineCache& rhs) = delete;
+
+private:  // Types
+  struct Entry {
+    Length           expansion;
+    Length           maxArcTolerance;
+    ClipperLib::Path path;
+  };
+
+private:  // Methods
+  void setRevision(quint64 revision) const noexcept;
+
+private:  // Data
+  /// Upper limit of cached outlines per revision (typically an item is only
+  /// requested with very few different expansions)
+  static constexpr int sMaxCount = 4;
+
+  mutable QMutex                       mMutex;
+  mutable quint64                      mRevision;
+  mutable QVector<QPair<Length, Path>> mOutlines;  ///< Per expansion
+  mutable QVector<Entry>               mEntries;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CLIPPEROUTLINECACHE_H
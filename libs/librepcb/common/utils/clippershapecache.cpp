@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "clippershapecache.h"
+
+#include "clipperhelpers.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ClipperShapeCache::ClipperShapeCache() noexcept : mMutex(), mShapes() {
+}
+
+ClipperShapeCache::~ClipperShapeCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+ClipperLib::Path ClipperShapeCache::get(
+    const Path& shape, const Point& position,
+    const PositiveLength& maxArcTolerance) noexcept {
+  Key              key(shape, *maxArcTolerance);
+  ClipperLib::Path path;
+  {
+    QMutexLocker lock(&mMutex);
+    auto         it = mShapes.constFind(key);
+    if (it != mShapes.constEnd()) {
+      path = *it;
+    }
+  }
+  if (path.empty() && (!shape.getVertices().isEmpty())) {
+    // convert without holding the lock, the conversion is the expensive part
+    path = ClipperHelpers::convert(shape, maxArcTolerance);
+    QMutexLocker lock(&mMutex);
+    if (mShapes.count() >= sMaxCount) {
+      mShapes.clear();
+    }
+    mShapes.insert(key, path);
+  }
+  ClipperLib::IntPoint offset = ClipperHelpers::convert(position);
+  for (ClipperLib::IntPoint& p : path) {
+    p.X += offset.X;
+    p.Y += offset.Y;
+  }
+  return path;
+}
+
+int ClipperShapeCache::getCount() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mShapes.count();
+}
+
+void ClipperShapeCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mShapes.clear();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+ClipperShapeCache& ClipperShapeCache::instance() noexcept {
+  static ClipperShapeCache cache;
+  return cache;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
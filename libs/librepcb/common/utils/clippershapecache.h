@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_CLIPPERSHAPECACHE_H
+#define LIBREPCB_CLIPPERSHAPECACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../geometry/path.h"
+#include "../units/all_length_units.h"
+
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class ClipperShapeCache
+ ******************************************************************************/
+
+/**
+ * @brief Shared cache of shapes converted to Clipper paths
+ *
+ * Boards typically contain a lot of identical pads and vias, but converting
+ * their outlines (which contain arcs) to Clipper paths is quite expensive.
+ * This cache stores the converted path of every distinct shape (i.e. an
+ * outline relative to its own origin, including any rotation and clearance)
+ * once, so all the instances of that shape only need to be translated to
+ * their position.
+ *
+ * The cache is shared across the whole application and access to it is
+ * thread-safe, so it can be used from worker threads (e.g. plane builder and
+ * design rule check) as well.
+ */
+class ClipperShapeCache final {
+public:
+  // Constructors / Destructor
+  ClipperShapeCache(const ClipperShapeCache& other) = delete;
+  ~ClipperShapeCache() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Get a shape converted to a Clipper path
+   *
+   * @param shape           The outline of the shape, relative to its origin.
+   * @param position        The position where to move the shape's origin to.
+   * @param maxArcTolerance Maximum allowed tolerance when flattening arcs.
+   *
+   * @return The converted path, translated by the given position. The result
+   *         is equivalent to ClipperHelpers::convert() of the translated shape
+   *         (possibly except for rounding differences of 1nm).
+   */
+  ClipperLib::Path get(const Path& shape, const Point& position,
+                       const PositiveLength& maxArcTolerance) noexcept;
+
+  /**
+   * @brief Get the number of cached shapes
+   *
+   * @return Count of shapes currently held by the cache.
+   */
+  int getCount() const noexcept;
+
+  /**
+   * @brief Remove all shapes from the cache
+   */
+  void clear() noexcept;
+
+  // Operator Overloadings
+  ClipperShapeCache& operator=(const ClipperShapeCache& rhs) = delete;
+
+  // Static Methods
+  static ClipperShapeCache& instance() noexcept;
+
+private:  // Methods
+  ClipperShapeCache() noexcept;
+
+private:  // Data
+  typedef QPair<Path, Length> Key;
+
+  /// Upper limit of cached shapes to avoid unbounded memory usage
+  static constexpr int sMaxCount = 10000;
+
+  mutable QMutex               mMutex;
+  QHash<Key, ClipperLib::Path> mShapes;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_CLIPPERSHAPECACHE_H
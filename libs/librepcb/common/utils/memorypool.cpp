@@ -0,0 +1,187 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "memorypool.h"
+
+#include <QtCore>
+
+#include <algorithm>
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+// Note: The block size is rounded up to a multiple of 16 bytes to keep every
+// block suitably aligned for any type (the chunks are aligned by the global
+// operator new).
+MemoryPool::MemoryPool(std::size_t blockSize, int blocksPerChunk) noexcept
+  : mBlockSize((qMax(blockSize, sizeof(FreeBlock)) + 15) & ~std::size_t(15)),
+    mBlocksPerChunk(qMax(blocksPerChunk, 1)),
+    mThread(QThread::currentThread()),
+    mFreeList(nullptr),
+    mChunks(),
+    mUsedBlocks(0) {
+  Registry&    reg = registry();
+  QMutexLocker lock(&reg.mutex);
+  reg.pools.push_back(this);
+}
+
+MemoryPool::~MemoryPool() noexcept {
+  if (mUsedBlocks > 0) {
+    qWarning() << "MemoryPool destroyed while" << mUsedBlocks
+               << "blocks are still in use!";
+  }
+  for (char* chunk : mChunks) {
+    ::operator delete(chunk);
+  }
+  Registry&    reg = registry();
+  QMutexLocker lock(&reg.mutex);
+  reg.pools.erase(std::remove(reg.pools.begin(), reg.pools.end(), this),
+                  reg.pools.end());
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+int MemoryPool::getUsedBlocks() const noexcept {
+  return mUsedBlocks;
+}
+
+int MemoryPool::getChunkCount() const noexcept {
+  return static_cast<int>(mChunks.size());
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void* MemoryPool::allocate() {
+  Q_ASSERT(QThread::currentThread() == mThread);
+  if (!mFreeList) {
+    // Allocate a new chunk and put all its blocks into the free list.
+    mChunks.reserve(mChunks.size() + 1);  // can throw
+    char* chunk = static_cast<char*>(
+        ::operator new(mBlockSize * mBlocksPerChunk));  // can throw
+    mChunks.push_back(chunk);
+    for (int i = mBlocksPerChunk - 1; i >= 0; --i) {
+      FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * mBlockSize);
+      block->next      = mFreeList;
+      mFreeList        = block;
+    }
+  }
+  FreeBlock* block = mFreeList;
+  mFreeList        = block->next;
+  ++mUsedBlocks;
+  return block;
+}
+
+void MemoryPool::deallocate(void* block) noexcept {
+  if (!block) {
+    return;
+  }
+  Q_ASSERT(QThread::currentThread() == mThread);
+  FreeBlock* freeBlock = static_cast<FreeBlock*>(block);
+  freeBlock->next      = mFreeList;
+  mFreeList            = freeBlock;
+  --mUsedBlocks;
+}
+
+int MemoryPool::releaseUnusedChunks() noexcept {
+  Q_ASSERT(QThread::currentThread() == mThread);
+
+  // Count the free blocks of each chunk. The chunks are sorted by address to
+  // find the chunk of a block with a binary search.
+  std::sort(mChunks.begin(), mChunks.end(), std::less<char*>());
+  auto chunkIndex = [this](FreeBlock* block) {
+    auto it = std::upper_bound(mChunks.begin(), mChunks.end(),
+                               reinterpret_cast<char*>(block),
+                               std::less<char*>());
+    return static_cast<std::size_t>(std::distance(mChunks.begin(), it) - 1);
+  };
+  std::vector<int> freeBlocks(mChunks.size(), 0);
+  for (FreeBlock* block = mFreeList; block; block = block->next) {
+    ++freeBlocks[chunkIndex(block)];
+  }
+
+  // Remove the blocks of unused chunks from the free list.
+  FreeBlock** next = &mFreeList;
+  while (*next) {
+    if (freeBlocks[chunkIndex(*next)] == mBlocksPerChunk) {
+      *next = (*next)->next;
+    } else {
+      next = &(*next)->next;
+    }
+  }
+
+  // Release the unused chunks.
+  int                count = 0;
+  std::vector<char*> usedChunks;
+  for (std::size_t i = 0; i < mChunks.size(); ++i) {
+    if (freeBlocks[i] == mBlocksPerChunk) {
+      ::operator delete(mChunks[i]);
+      ++count;
+    } else {
+      usedChunks.push_back(mChunks[i]);
+    }
+  }
+  mChunks.swap(usedChunks);
+  return count;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+int MemoryPool::releaseUnusedChunksOfAllPools() noexcept {
+  Registry&    reg = registry();
+  QMutexLocker lock(&reg.mutex);
+  int          count = 0;
+  for (MemoryPool* pool : reg.pools) {
+    if (pool->mThread == QThread::currentThread()) {
+      count += pool->releaseUnusedChunks();
+    }
+  }
+  return count;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+MemoryPool::Registry& MemoryPool::registry() noexcept {
+  // Never destroyed, like the pools of PoolAllocated.
+  static Registry* registry = new Registry();
+  return *registry;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
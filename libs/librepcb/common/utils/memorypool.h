@@ -0,0 +1,195 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_MEMORYPOOL_H
+#define LIBREPCB_MEMORYPOOL_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class MemoryPool
+ ******************************************************************************/
+
+/**
+ * @brief Pool of memory blocks of a fixed size
+ *
+ * Memory is requested from the heap in large chunks which are split into
+ * blocks. Freed blocks are kept in a free list for reuse. Chunks are released
+ * when the pool is destroyed, or by #releaseUnusedChunks() as soon as none of
+ * their blocks is in use anymore. This makes allocating and freeing a lot of
+ * small objects of the same type much cheaper than using the global `new` and
+ * `delete`, and avoids fragmenting the heap.
+ *
+ * @warning This class is not thread-safe (to keep allocations cheap), a pool
+ *          must only be used from the thread which created it.
+ *
+ * Usually this class is not used directly, but with ::librepcb::PoolAllocated.
+ */
+class MemoryPool final {
+public:
+  // Constructors / Destructor
+  MemoryPool()                        = delete;
+  MemoryPool(const MemoryPool& other) = delete;
+
+  /**
+   * @brief Constructor
+   *
+   * @param blockSize       Size of each block in bytes
+   * @param blocksPerChunk  Number of blocks to allocate at once
+   */
+  explicit MemoryPool(std::size_t blockSize, int blocksPerChunk = 256) noexcept;
+  ~MemoryPool() noexcept;
+
+  // Getters
+  std::size_t getBlockSize() const noexcept { return mBlockSize; }
+  int         getUsedBlocks() const noexcept;
+  int         getChunkCount() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Allocate a block
+   *
+   * @return Pointer to the uninitialized block (aligned for any type)
+   *
+   * @throw std::bad_alloc If there is not enough memory.
+   */
+  void* allocate();
+
+  /**
+   * @brief Return a block to the pool
+   *
+   * @param block   A block returned by #allocate() of this pool
+   */
+  void deallocate(void* block) noexcept;
+
+  /**
+   * @brief Return all chunks without used blocks to the heap
+   *
+   * @return Number of released chunks
+   */
+  int releaseUnusedChunks() noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Call #releaseUnusedChunks() on all pools of the current thread
+   *
+   * Intended to be called after a lot of objects have been deleted, e.g.
+   * when closing a project.
+   *
+   * @return Number of released chunks
+   */
+  static int releaseUnusedChunksOfAllPools() noexcept;
+
+  // Operator Overloadings
+  MemoryPool& operator=(const MemoryPool& rhs) = delete;
+
+private:  // Types
+  struct FreeBlock {
+    FreeBlock* next;
+  };
+  struct Registry {
+    QMutex                   mutex;  ///< Guards the pools
+    std::vector<MemoryPool*> pools;  ///< All existing pools
+  };
+
+private:  // Methods
+  static Registry& registry() noexcept;
+
+private:  // Data
+  const std::size_t  mBlockSize;
+  const int          mBlocksPerChunk;
+  QThread* const     mThread;      ///< The only thread allowed to use the pool
+  FreeBlock*         mFreeList;    ///< nullptr if there are no free blocks
+  std::vector<char*> mChunks;      ///< All allocated chunks
+  int                mUsedBlocks;  ///< Number of blocks currently allocated
+};
+
+/*******************************************************************************
+ *  Class PoolAllocated
+ ******************************************************************************/
+
+/**
+ * @brief Base class to allocate objects of a type from a ::librepcb::MemoryPool
+ *
+ * Derive frequently created types (e.g. net points and net lines) from this
+ * class to make `new` and `delete` of them use a pool:
+ *
+ * @code
+ * class MyClass final : public QObject, public PoolAllocated<MyClass> { ... };
+ * @endcode
+ *
+ * Each type has its own pool which lives until the application exits, so
+ * objects can be created and deleted in any order. But since the pool is not
+ * thread-safe, objects must only be created and deleted in the main thread.
+ * Objects of (unexpected) derived classes with a different size fall back to
+ * the global heap.
+ *
+ * @tparam T  The derived type
+ */
+template <typename T>
+class PoolAllocated {
+public:
+  static void* operator new(std::size_t size) {
+    return (size == sizeof(T)) ? pool().allocate() : ::operator new(size);
+  }
+  static void operator delete(void* ptr, std::size_t size) noexcept {
+    if (size == sizeof(T)) {
+      pool().deallocate(ptr);
+    } else {
+      ::operator delete(ptr);
+    }
+  }
+
+  /**
+   * @brief Get the pool of this type
+   *
+   * @return The pool, which is never destroyed (to avoid any static
+   *         destruction order problems)
+   */
+  static MemoryPool& pool() noexcept {
+    static MemoryPool* pool = new MemoryPool(sizeof(T));
+    return *pool;
+  }
+
+protected:
+  PoolAllocated() noexcept  = default;
+  ~PoolAllocated() noexcept = default;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_MEMORYPOOL_H
@@ -0,0 +1,277 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_TASKSCHEDULER_H
+#define LIBREPCB_TASKSCHEDULER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <functional>
+#include <utility>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class TaskContext
+ ******************************************************************************/
+
+/**
+ * @brief Access to the state of a task started by librepcb::TaskScheduler
+ *
+ * Passed to the functions started with TaskScheduler::runWithContext() to
+ * let them report their progress and check whether they were canceled by
+ * QFuture::cancel(). The progress can be observed with a QFutureWatcher.
+ */
+class TaskContext final {
+public:
+  // Constructors / Destructor
+  TaskContext()                         = delete;
+  TaskContext(const TaskContext& other) = delete;
+  explicit TaskContext(QFutureInterfaceBase& future) noexcept
+    : mFuture(future) {}
+  ~TaskContext() noexcept {}
+
+  // Getters
+
+  /**
+   * @brief Check whether the task should be aborted
+   *
+   * Long running tasks should check this regularly and return as soon as
+   * possible if it returns true. The result of a canceled task is discarded.
+   */
+  bool isCanceled() const noexcept { return mFuture.isCanceled(); }
+
+  // Setters
+  void setProgressRange(int minimum, int maximum) noexcept {
+    mFuture.setProgressRange(minimum, maximum);
+  }
+  void setProgressValue(int value) noexcept { mFuture.setProgressValue(value); }
+  void setProgressValueAndText(int value, const QString& text) noexcept {
+    mFuture.setProgressValueAndText(value, text);
+  }
+
+  // Operator Overloadings
+  TaskContext& operator=(const TaskContext& rhs) = delete;
+
+private:  // Data
+  QFutureInterfaceBase& mFuture;
+};
+
+/*******************************************************************************
+ *  Class TaskScheduler
+ ******************************************************************************/
+
+/**
+ * @brief Runs background computations on the application wide thread pool
+ *
+ * All CPU bound background work (DRC, planes, exports, library scans, ...)
+ * should be started through this class rather than in separate threads, so
+ * the application never runs more worker threads than there are cores.
+ * Pending tasks are executed in the order of their ::Priority, thus for
+ * example a font needed to render the current view is loaded before the
+ * library scanner continues parsing elements.
+ *
+ * The returned QFuture behaves like the one of QtConcurrent::run(): it can be
+ * observed with a QFutureWatcher, and exceptions derived from QException
+ * (like librepcb::Exception) are rethrown by QFuture::waitForFinished() and
+ * QFuture::result(). In addition, a task canceled by QFuture::cancel() before
+ * it was started is not executed at all, and tasks started with
+ * #runWithContext() can report progress and abort early when canceled.
+ *
+ * If a thread waits for a task which was not started yet (e.g. a DRC job
+ * waiting for its sub-jobs), the task is taken out of the queue and executed
+ * in the waiting thread. So nested tasks never leave a worker thread blocked
+ * while there is work to do.
+ */
+class TaskScheduler final {
+public:
+  // Types
+  enum class Priority : int {
+    Background  = -10,  ///< May be delayed arbitrarily (e.g. library scan)
+    Normal      = 0,    ///< Results awaited by the user (e.g. DRC, export)
+    Interactive = 10,   ///< Required to update the UI (e.g. loading fonts)
+  };
+
+  // Constructors / Destructor
+  TaskScheduler()                           = delete;
+  TaskScheduler(const TaskScheduler& other) = delete;
+  ~TaskScheduler()                          = delete;
+
+  // Getters
+
+  /**
+   * @brief Get the number of tasks which are executed in parallel
+   */
+  static int getMaxThreadCount() noexcept {
+    return QThreadPool::globalInstance()->maxThreadCount();
+  }
+
+  // General Methods
+
+  /**
+   * @brief Start a function in a worker thread
+   *
+   * @param priority  Priority of the task.
+   * @param func      The function to execute, without arguments.
+   *
+   * @return The future of the function's return value.
+   */
+  template <typename F>
+  static auto run(Priority priority, F func) -> QFuture<decltype(func())> {
+    typedef decltype(func()) T;
+    return start<T>(priority,
+                    [func](TaskContext&) mutable { return func(); });
+  }
+
+  /**
+   * @brief Start a function in a worker thread, passing it a TaskContext
+   *
+   * @param priority  Priority of the task.
+   * @param func      The function to execute, taking a librepcb::TaskContext
+   *                  reference as its only argument.
+   *
+   * @return The future of the function's return value.
+   */
+  template <typename F>
+  static auto runWithContext(Priority priority, F func)
+      -> QFuture<decltype(func(std::declval<TaskContext&>()))> {
+    typedef decltype(func(std::declval<TaskContext&>())) T;
+    return start<T>(priority, std::function<T(TaskContext&)>(func));
+  }
+
+  // Operator Overloadings
+  TaskScheduler& operator=(const TaskScheduler& rhs) = delete;
+
+private:  // Types
+  template <typename T>
+  class Task;
+
+private:  // Methods
+  template <typename T>
+  static QFuture<T> start(Priority                       priority,
+                          std::function<T(TaskContext&)> func);
+};
+
+/*******************************************************************************
+ *  Class TaskSchedulerInvoker
+ ******************************************************************************/
+
+/**
+ * @brief Helper of TaskScheduler to report the result of a function
+ *
+ * Only needed as the result of functions returning `void` must not be
+ * reported.
+ */
+template <typename T>
+struct TaskSchedulerInvoker {
+  static void invoke(QFutureInterface<T>&                  future,
+                     const std::function<T(TaskContext&)>& func,
+                     TaskContext&                          context) {
+    future.reportResult(func(context));
+  }
+};
+
+template <>
+struct TaskSchedulerInvoker<void> {
+  static void invoke(QFutureInterface<void>&                  future,
+                     const std::function<void(TaskContext&)>& func,
+                     TaskContext&                             context) {
+    Q_UNUSED(future);
+    func(context);
+  }
+};
+
+/*******************************************************************************
+ *  Class TaskScheduler::Task
+ ******************************************************************************/
+
+/**
+ * @brief The QRunnable executed by the thread pool for each task
+ *
+ * Same concept as the runnables of QtConcurrent::run(): The task itself holds
+ * the QFutureInterface and registers itself as its runnable, which allows the
+ * thread pool to execute it in a thread waiting for the future.
+ */
+template <typename T>
+class TaskScheduler::Task final : public QRunnable {
+public:
+  // Constructors / Destructor
+  Task()                  = delete;
+  Task(const Task& other) = delete;
+  explicit Task(std::function<T(TaskContext&)> func) noexcept
+    : QRunnable(), mFuture(), mFunc(std::move(func)) {}
+  ~Task() noexcept {}
+
+  // General Methods
+  QFuture<T> start(Priority priority) noexcept {
+    mFuture.setRunnable(this);
+    mFuture.reportStarted();
+    QFuture<T> future = mFuture.future();
+    // Note: The thread pool takes ownership of this object.
+    QThreadPool::globalInstance()->start(this, static_cast<int>(priority));
+    return future;
+  }
+
+  // Inherited from QRunnable
+  void run() noexcept override {
+    if (!mFuture.isCanceled()) {
+      try {
+        TaskContext context(mFuture);
+        TaskSchedulerInvoker<T>::invoke(mFuture, mFunc, context);
+      } catch (const QException& e) {
+        mFuture.reportException(e);
+      } catch (...) {
+        mFuture.reportException(QUnhandledException());
+      }
+    }
+    mFuture.reportFinished();
+  }
+
+  // Operator Overloadings
+  Task& operator=(const Task& rhs) = delete;
+
+private:  // Data
+  QFutureInterface<T>            mFuture;
+  std::function<T(TaskContext&)> mFunc;
+};
+
+/*******************************************************************************
+ *  Template Implementations
+ ******************************************************************************/
+
+template <typename T>
+QFuture<T> TaskScheduler::start(Priority                       priority,
+                                std::function<T(TaskContext&)> func) {
+  Task<T>* task = new Task<T>(std::move(func));
+  return task->start(priority);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_TASKSCHEDULER_H
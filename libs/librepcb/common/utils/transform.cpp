@@ -0,0 +1,143 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "transform.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+Transform::Transform(const Point& position, const Angle& rotation,
+                     bool mirrored) noexcept
+  : mPosition(position),
+    mRotation(rotation),
+    mMirrored(mirrored),
+    mExact(true),
+    mXX(1),
+    mXY(0),
+    mYX(0),
+    mYY(1),
+    mSin(0),
+    mCos(1) {
+  // Same case distinction as in Point::rotate()
+  const Angle angle0_360 = rotation.mappedTo0_360deg();
+  if (angle0_360 == Angle::deg90()) {
+    mXX = 0;
+    mXY = -1;
+    mYX = 1;
+    mYY = 0;
+  } else if (angle0_360 == Angle::deg180()) {
+    mXX = -1;
+    mYY = -1;
+  } else if (angle0_360 == Angle::deg270()) {
+    mXX = 0;
+    mXY = 1;
+    mYX = -1;
+    mYY = 0;
+  } else if (rotation != Angle::deg0()) {
+    mExact = false;
+    mSin   = qSin(rotation.toRad());
+    mCos   = qCos(rotation.toRad());
+  }
+  if (mMirrored) {
+    mXX = -mXX;
+    mXY = -mXY;
+  }
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+Point Transform::map(const Point& point) const noexcept {
+  const LengthBase_t x = point.getX().toNm();
+  const LengthBase_t y = point.getY().toNm();
+  if (mExact) {
+    return Point(Length(mXX * x + mXY * y + mPosition.getX().toNm()),
+                 Length(mYX * x + mYY * y + mPosition.getY().toNm()));
+  } else {
+    const LengthBase_t rx = static_cast<LengthBase_t>(mCos * x - mSin * y);
+    const LengthBase_t ry = static_cast<LengthBase_t>(mSin * x + mCos * y);
+    return Point(Length((mMirrored ? -rx : rx) + mPosition.getX().toNm()),
+                 Length(ry + mPosition.getY().toNm()));
+  }
+}
+
+Path Transform::map(Path path) const noexcept {
+  mapVertices(path.getVertices());
+  return path;
+}
+
+QVector<Path> Transform::map(QVector<Path> paths) const noexcept {
+  for (Path& path : paths) {
+    mapVertices(path.getVertices());
+  }
+  return paths;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void Transform::mapVertices(QVector<Vertex>& vertices) const noexcept {
+  const LengthBase_t px    = mPosition.getX().toNm();
+  const LengthBase_t py    = mPosition.getY().toNm();
+  Vertex*            begin = vertices.data();
+  Vertex*            end   = begin + vertices.count();
+  if (mExact) {
+    for (Vertex* v = begin; v != end; ++v) {
+      const LengthBase_t x = v->getPos().getX().toNm();
+      const LengthBase_t y = v->getPos().getY().toNm();
+      v->setPos(Point(Length(mXX * x + mXY * y + px),
+                      Length(mYX * x + mYY * y + py)));
+    }
+  } else {
+    // Note: The rotated coordinates must be truncated before mirroring to
+    // get exactly the same results as Point::rotate() and Point::mirror().
+    const LengthBase_t sign = mMirrored ? -1 : 1;
+    for (Vertex* v = begin; v != end; ++v) {
+      const LengthBase_t x  = v->getPos().getX().toNm();
+      const LengthBase_t y  = v->getPos().getY().toNm();
+      const LengthBase_t rx = static_cast<LengthBase_t>(mCos * x - mSin * y);
+      const LengthBase_t ry = static_cast<LengthBase_t>(mSin * x + mCos * y);
+      v->setPos(Point(Length(sign * rx + px), Length(ry + py)));
+    }
+  }
+  if (mMirrored) {
+    for (Vertex* v = begin; v != end; ++v) {
+      v->setAngle(-v->getAngle());
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
@@ -0,0 +1,93 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_TRANSFORM_H
+#define LIBREPCB_TRANSFORM_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "../geometry/path.h"
+#include "../units/all_length_units.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+/*******************************************************************************
+ *  Class Transform
+ ******************************************************************************/
+
+/**
+ * @brief Maps coordinates from the local coordinate system of an object (e.g.
+ *        a footprint or a text) to the coordinate system of its parent
+ *
+ * The transformation is the same as calling Point::rotate(), then
+ * Point::mirror() with Qt::Horizontal (if mirrored) and finally translating
+ * by the position, and the results are exactly the same. But the
+ * transformation is set up only once, i.e. the trigonometric functions are
+ * evaluated only once, and whole paths are transformed in a single tight
+ * loop. So this class should be preferred for transforming many vertices.
+ */
+class Transform final {
+public:
+  // Constructors / Destructor
+  Transform() noexcept : Transform(Point(0, 0), Angle::deg0(), false) {}
+  Transform(const Transform& other) noexcept = default;
+  Transform(const Point& position, const Angle& rotation,
+            bool mirrored) noexcept;
+  ~Transform() noexcept = default;
+
+  // Getters
+  const Point& getPosition() const noexcept { return mPosition; }
+  const Angle& getRotation() const noexcept { return mRotation; }
+  bool         getMirrored() const noexcept { return mMirrored; }
+
+  // General Methods
+  Point         map(const Point& point) const noexcept;
+  Path          map(Path path) const noexcept;
+  QVector<Path> map(QVector<Path> paths) const noexcept;
+
+  // Operator Overloadings
+  Transform& operator=(const Transform& rhs) noexcept = default;
+
+private:  // Methods
+  void mapVertices(QVector<Vertex>& vertices) const noexcept;
+
+private:  // Data
+  Point mPosition;
+  Angle mRotation;
+  bool  mMirrored;
+
+  // Precalculated transformation matrix
+  bool         mExact;  ///< Rotation is a multiple of 90° (integer math)
+  LengthBase_t mXX, mXY, mYX, mYY;  ///< Integer matrix (only if #mExact)
+  qreal        mSin, mCos;          ///< Rotation (only if not #mExact)
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace librepcb
+
+#endif  // LIBREPCB_TRANSFORM_H
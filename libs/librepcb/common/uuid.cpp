@@ -22,7 +22,6 @@
  ******************************************************************************/
 #include "uuid.h"
 
-#include <QRegularExpressionValidator>
 #include <QtCore>
 
 /*******************************************************************************
@@ -31,81 +30,52 @@
 namespace librepcb {
 
 /*******************************************************************************
- *  Static Methods
+ *  Getters
  ******************************************************************************/
 
-bool Uuid::isValid(const QString& str) noexcept {
-  // Note: This used to be done using a RegEx, but when profiling and
-  // optimizing the library rescan code we found that a manually unrolled
-  // comparison loop performs much better than the previous RegEx.
-  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
-  if (str.length() != 36) return false;
+QString Uuid::toStr() const noexcept {
+  static const char hexChars[] = "0123456789abcdef";
+  QString           str(36, Qt::Uninitialized);
+  QChar*            out    = str.data();
+  int               nibble = 0;
+  for (int i = 0; i < 36; ++i) {
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      out[i] = QLatin1Char('-');
+    } else {
+      const quint64 value = (nibble < 16) ? mHi : mLo;
+      const int     shift = (15 - (nibble % 16)) * 4;
+      out[i]              = QLatin1Char(hexChars[(value >> shift) & 0xF]);
+      ++nibble;
+    }
+  }
+  return str;
+}
 
-  // Helper function
-  auto isLowerHex = [](const QChar& chr) {
-    return (chr >= QChar('0') && chr <= QChar('9')) ||
-           (chr >= QChar('a') && chr <= QChar('f'));
-  };
-
-  if (!isLowerHex(str[0])) return false;
-  if (!isLowerHex(str[1])) return false;
-  if (!isLowerHex(str[2])) return false;
-  if (!isLowerHex(str[3])) return false;
-  if (!isLowerHex(str[4])) return false;
-  if (!isLowerHex(str[5])) return false;
-  if (!isLowerHex(str[6])) return false;
-  if (!isLowerHex(str[7])) return false;
-  if (str[8] != QChar('-')) return false;
-  if (!isLowerHex(str[9])) return false;
-  if (!isLowerHex(str[10])) return false;
-  if (!isLowerHex(str[11])) return false;
-  if (!isLowerHex(str[12])) return false;
-  if (str[13] != QChar('-')) return false;
-  if (!isLowerHex(str[14])) return false;
-  if (!isLowerHex(str[15])) return false;
-  if (!isLowerHex(str[16])) return false;
-  if (!isLowerHex(str[17])) return false;
-  if (str[18] != QChar('-')) return false;
-  if (!isLowerHex(str[19])) return false;
-  if (!isLowerHex(str[20])) return false;
-  if (!isLowerHex(str[21])) return false;
-  if (!isLowerHex(str[22])) return false;
-  if (str[23] != QChar('-')) return false;
-  if (!isLowerHex(str[24])) return false;
-  if (!isLowerHex(str[25])) return false;
-  if (!isLowerHex(str[26])) return false;
-  if (!isLowerHex(str[27])) return false;
-  if (!isLowerHex(str[28])) return false;
-  if (!isLowerHex(str[29])) return false;
-  if (!isLowerHex(str[30])) return false;
-  if (!isLowerHex(str[31])) return false;
-  if (!isLowerHex(str[32])) return false;
-  if (!isLowerHex(str[33])) return false;
-  if (!isLowerHex(str[34])) return false;
-  if (!isLowerHex(str[35])) return false;
-
-  // check type of uuid
-  QUuid quuid(str);
-  if (quuid.isNull()) return false;
-  if (quuid.variant() != QUuid::DCE) return false;
-  if (quuid.version() != QUuid::Random) return false;
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
 
-  return true;
+bool Uuid::isValid(const QString& str) noexcept {
+  quint64 hi, lo;
+  return parse(str, hi, lo);
 }
 
 Uuid Uuid::createRandom() noexcept {
-  QString str =
-      QUuid::createUuid().toString().remove("{").remove("}").toLower();
-  if (isValid(str)) {
-    return Uuid(str);
+  const QByteArray bytes = QUuid::createUuid().toRfc4122();
+  const uchar*     data  = reinterpret_cast<const uchar*>(bytes.constData());
+  const quint64    hi    = qFromBigEndian<quint64>(data);
+  const quint64    lo    = qFromBigEndian<quint64>(data + 8);
+  if ((bytes.size() == 16) && isValidVersionAndVariant(hi, lo)) {
+    return Uuid(hi, lo);
   } else {
     qFatal("Not able to generate valid random UUID!");  // calls abort()!
   }
 }
 
 Uuid Uuid::fromString(const QString& str) {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 hi, lo;
+  if (parse(str, hi, lo)) {
+    return Uuid(hi, lo);
   } else {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("String is not a valid UUID: \"%1\"").arg(str));
@@ -113,13 +83,59 @@ Uuid Uuid::fromString(const QString& str) {
 }
 
 tl::optional<Uuid> Uuid::tryFromString(const QString& str) noexcept {
-  if (isValid(str)) {
-    return Uuid(str);
+  quint64 hi, lo;
+  if (parse(str, hi, lo)) {
+    return Uuid(hi, lo);
   } else {
     return tl::nullopt;
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool Uuid::parse(const QString& str, quint64& hi, quint64& lo) noexcept {
+  // Note: This used to be done using a RegEx, but when profiling and
+  // optimizing the library rescan code we found that a manually unrolled
+  // comparison loop performs much better than the previous RegEx.
+  // See https://github.com/LibrePCB/LibrePCB/pull/651 for more details.
+  // Now the hex digits are also converted within the same loop.
+  if (str.length() != 36) return false;
+
+  const QChar* in        = str.constData();
+  quint64      values[2] = {0, 0};
+  int          nibble    = 0;
+  for (int i = 0; i < 36; ++i) {
+    const ushort chr = in[i].unicode();
+    if ((i == 8) || (i == 13) || (i == 18) || (i == 23)) {
+      if (chr != '-') return false;
+    } else {
+      quint64 digit;
+      if ((chr >= '0') && (chr <= '9')) {
+        digit = chr - '0';
+      } else if ((chr >= 'a') && (chr <= 'f')) {
+        digit = chr - 'a' + 10;  // only lowercase is valid
+      } else {
+        return false;
+      }
+      quint64& value = values[nibble / 16];
+      value          = (value << 4) | digit;
+      ++nibble;
+    }
+  }
+
+  if (!isValidVersionAndVariant(values[0], values[1])) return false;
+  hi = values[0];
+  lo = values[1];
+  return true;
+}
+
+bool Uuid::isValidVersionAndVariant(quint64 hi, quint64 lo) noexcept {
+  // DCE variant (bits "10") and version 4 (random), see RFC4122
+  return (((hi >> 12) & 0xF) == 4) && ((lo >> 62) == 2);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -71,7 +71,7 @@ public:
    *
    * @param other     Another ::librepcb::Uuid object
    */
-  Uuid(const Uuid& other) noexcept : mUuid(other.mUuid) {}
+  Uuid(const Uuid& other) noexcept : mHi(other.mHi), mLo(other.mLo) {}
 
   /**
    * @brief Destructor
@@ -83,9 +83,12 @@ public:
   /**
    * @brief Get the UUID as a string (without braces)
    *
+   * @note The string is created on every call, so avoid calling this method
+   *       in hot code paths (e.g. use the Uuid itself as key of containers).
+   *
    * @return The UUID as a string
    */
-  QString toStr() const noexcept { return mUuid; }
+  QString toStr() const noexcept;
 
   //@{
   /**
@@ -93,18 +96,24 @@ public:
    *
    * @param rhs   The other object to compare
    *
-   * @return Result of comparing the UUIDs as strings
+   * @return Result of comparing the UUIDs (the order is the same as when
+   *         comparing them as strings)
    */
   Uuid& operator=(const Uuid& rhs) noexcept {
-    mUuid = rhs.mUuid;
+    mHi = rhs.mHi;
+    mLo = rhs.mLo;
     return *this;
   }
-  bool operator==(const Uuid& rhs) const noexcept { return mUuid == rhs.mUuid; }
-  bool operator!=(const Uuid& rhs) const noexcept { return mUuid != rhs.mUuid; }
-  bool operator<(const Uuid& rhs) const noexcept { return mUuid < rhs.mUuid; }
-  bool operator>(const Uuid& rhs) const noexcept { return mUuid > rhs.mUuid; }
-  bool operator<=(const Uuid& rhs) const noexcept { return mUuid <= rhs.mUuid; }
-  bool operator>=(const Uuid& rhs) const noexcept { return mUuid >= rhs.mUuid; }
+  bool operator==(const Uuid& rhs) const noexcept {
+    return (mHi == rhs.mHi) && (mLo == rhs.mLo);
+  }
+  bool operator!=(const Uuid& rhs) const noexcept { return !(*this == rhs); }
+  bool operator<(const Uuid& rhs) const noexcept {
+    return (mHi < rhs.mHi) || ((mHi == rhs.mHi) && (mLo < rhs.mLo));
+  }
+  bool operator>(const Uuid& rhs) const noexcept { return rhs < *this; }
+  bool operator<=(const Uuid& rhs) const noexcept { return !(rhs < *this); }
+  bool operator>=(const Uuid& rhs) const noexcept { return !(*this < rhs); }
   //@}
 
   // Static Methods
@@ -150,14 +159,33 @@ public:
 
 private:  // Methods
   /**
-   * @brief Constructor which creates a Uuid object from a string
+   * @brief Constructor which creates a Uuid object from its binary value
    *
-   * @param str       The uuid as a string (lowercase and without braces)
+   * @param hi        The first 8 bytes of the UUID (big endian)
+   * @param lo        The last 8 bytes of the UUID (big endian)
    */
-  explicit Uuid(const QString& str) noexcept : mUuid(str) {}
+  Uuid(quint64 hi, quint64 lo) noexcept : mHi(hi), mLo(lo) {}
+
+  /**
+   * @brief Parse and validate a UUID string
+   *
+   * @param str       The string to parse
+   * @param hi        Receives the first 8 bytes if the string is valid
+   * @param lo        Receives the last 8 bytes if the string is valid
+   *
+   * @return Whether the string is a valid UUID or not
+   */
+  static bool parse(const QString& str, quint64& hi, quint64& lo) noexcept;
+  static bool isValidVersionAndVariant(quint64 hi, quint64 lo) noexcept;
+
+  friend uint qHash(const Uuid& key, uint seed) noexcept;
 
-private:          // Data
-  QString mUuid;  ///< Guaranteed to always contain a valid UUID
+private:  // Data
+  // The 128 bits of the UUID, guaranteed to always represent a valid UUID.
+  // Stored as integers instead of a string to save memory and to get fast
+  // comparisons and hashing.
+  quint64 mHi;
+  quint64 mLo;
 };
 
 /*******************************************************************************
@@ -206,7 +234,8 @@ inline QDebug operator<<(QDebug stream, const Uuid& uuid) noexcept {
 }
 
 inline uint qHash(const Uuid& key, uint seed) noexcept {
-  return ::qHash(key.toStr(), seed);
+  // The bits of random UUIDs are already well distributed
+  return ::qHash(key.mHi ^ key.mLo, seed);
 }
 
 /*******************************************************************************
@@ -36,9 +36,14 @@ namespace eagleimport {
 
 ConverterDb::ConverterDb(const FilePath& ini) noexcept
   : mIniFile(ini.toStr(), QSettings::IniFormat) {
+  // Accessing QSettings for every lookup is slow, so load all UUIDs at once.
+  foreach (const QString& key, mIniFile.allKeys()) {
+    mUuids.insert(key, mIniFile.value(key).toString());
+  }
 }
 
 ConverterDb::~ConverterDb() noexcept {
+  save();
 }
 
 /*******************************************************************************
@@ -93,6 +98,15 @@ Uuid ConverterDb::getDeviceUuid(const QString& deviceSetName,
   return getOrCreateUuid("devices_to_devices", deviceSetName, deviceName);
 }
 
+void ConverterDb::save() noexcept {
+  QMutexLocker locker(&mUuidsMutex);
+  foreach (const QString& key, mNewKeys) {
+    mIniFile.setValue(key, mUuids.value(key));
+  }
+  mNewKeys.clear();
+  mIniFile.sync();
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -115,10 +129,14 @@ Uuid ConverterDb::getOrCreateUuid(const QString& cat, const QString& key1,
   }
   settingsKey.prepend(cat % '/');
 
-  Uuid    uuid  = Uuid::createRandom();
-  QString value = mIniFile.value(settingsKey).toString();
-  if (!value.isEmpty()) uuid = Uuid::fromString(value);  // can throw
-  mIniFile.setValue(settingsKey, uuid.toStr());
+  QMutexLocker locker(&mUuidsMutex);
+  QString      value = mUuids.value(settingsKey);
+  if (!value.isEmpty()) {
+    return Uuid::fromString(value);  // can throw
+  }
+  Uuid uuid = Uuid::createRandom();
+  mUuids.insert(settingsKey, uuid.toStr());
+  mNewKeys.insert(settingsKey);
   return uuid;
 }
 
@@ -43,6 +43,11 @@ namespace eagleimport {
 
 /**
  * @brief The ConverterDb class
+ *
+ * The UUIDs are loaded from the INI file into memory on construction, and new
+ * UUIDs are written back in one batch by #save() (or when destroyed). The UUID
+ * getters are thread-safe, so elements of the current library can be
+ * converted in parallel.
  */
 class ConverterDb final {
 public:
@@ -72,6 +77,11 @@ public:
                                 const QString& gateName);
   Uuid getDeviceUuid(const QString& deviceSetName, const QString& deviceName);
 
+  /**
+   * @brief Write all newly created UUIDs to the INI file
+   */
+  void save() noexcept;
+
   // Operator Overloadings
   ConverterDb& operator=(const ConverterDb& rhs) = delete;
 
@@ -79,8 +89,11 @@ private:
   Uuid getOrCreateUuid(const QString& cat, const QString& key1,
                        const QString& key2 = QString());
 
-  QSettings mIniFile;
-  FilePath  mLibFilePath;
+  QSettings               mIniFile;
+  QHash<QString, QString> mUuids;       ///< All UUIDs by INI key
+  QSet<QString>           mNewKeys;     ///< Keys not saved yet
+  QMutex                  mUuidsMutex;  ///< Allows parallel conversions
+  FilePath                mLibFilePath;
 };
 
 /*******************************************************************************
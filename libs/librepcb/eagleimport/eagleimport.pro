@@ -30,14 +30,18 @@ SOURCES += \
     converterdb.cpp \
     deviceconverter.cpp \
     devicesetconverter.cpp \
+    libraryconverter.cpp \
     packageconverter.cpp \
+    polygonsimplifier.cpp \
     symbolconverter.cpp \
 
 HEADERS += \
     converterdb.h \
     deviceconverter.h \
     devicesetconverter.h \
+    libraryconverter.h \
     packageconverter.h \
+    polygonsimplifier.h \
     symbolconverter.h \
 
 FORMS += \
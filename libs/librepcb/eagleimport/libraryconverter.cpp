@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "libraryconverter.h"
+
+#include "converterdb.h"
+#include "deviceconverter.h"
+#include "devicesetconverter.h"
+#include "packageconverter.h"
+#include "polygonsimplifier.h"
+#include "symbolconverter.h"
+
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/sym/symbol.h>
+#include <parseagle/library.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace eagleimport {
+
+using namespace library;
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+LibraryConverter::Result LibraryConverter::convertSymbol(
+    ConverterDb& db, const parseagle::Symbol& symbol) noexcept {
+  Result result;
+  try {
+    // create symbol
+    SymbolConverter         converter(symbol, db);
+    std::shared_ptr<Symbol> newSymbol = converter.generate();
+
+    // convert line rects to polygon rects
+    PolygonSimplifier<Symbol> polygonSimplifier(*newSymbol);
+    polygonSimplifier.convertLineRectsToPolygonRects(false, true);
+
+    result.elements.append({"sym", newSymbol});
+    result.success = true;
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  }
+  return result;
+}
+
+LibraryConverter::Result LibraryConverter::convertPackage(
+    ConverterDb& db, const parseagle::Package& package) noexcept {
+  Result result;
+  try {
+    // create package
+    PackageConverter         converter(package, db);
+    std::shared_ptr<Package> newPackage = converter.generate();
+
+    // convert line rects to polygon rects
+    Q_ASSERT(newPackage->getFootprints().count() == 1);
+    PolygonSimplifier<Footprint> polygonSimplifier(
+        *newPackage->getFootprints().first());
+    polygonSimplifier.convertLineRectsToPolygonRects(false, true);
+
+    result.elements.append({"pkg", newPackage});
+    result.success = true;
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  }
+  return result;
+}
+
+LibraryConverter::Result LibraryConverter::convertDeviceSet(
+    ConverterDb& db, const parseagle::DeviceSet& deviceSet) noexcept {
+  Result result;
+  try {
+    // abort if device name ends with "-US" or "-US_"
+    if (deviceSet.getName().endsWith("-US")) return result;
+    if (deviceSet.getName().endsWith("-US_")) return result;
+
+    // create component
+    DeviceSetConverter         converter(deviceSet, db);
+    std::shared_ptr<Component> newComponent = converter.generate();
+
+    // create devices
+    foreach (const parseagle::Device& device, deviceSet.getDevices()) {
+      if (device.getPackage().isNull()) continue;
+
+      DeviceConverter         devConverter(deviceSet, device, db);
+      std::shared_ptr<Device> newDevice = devConverter.generate();
+      result.elements.append({"dev", newDevice});
+    }
+
+    // the component is saved after its devices
+    result.elements.append({"cmp", newComponent});
+    result.success = true;
+  } catch (const std::exception& e) {
+    result.error = e.what();
+  }
+  return result;
+}
+
+void LibraryConverter::save(const Result& result, const FilePath& outputDir) {
+  for (const auto& pair : result.elements) {
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRW(
+            outputDir.getPathTo(pair.first));  // can throw
+    TransactionalDirectory dir(fs);
+    pair.second->moveIntoParentDirectory(dir);  // can throw
+    fs->save();                                 // can throw
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace eagleimport
+}  // namespace librepcb
@@ -0,0 +1,111 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_EAGLEIMPORT_LIBRARYCONVERTER_H
+#define LIBREPCB_EAGLEIMPORT_LIBRARYCONVERTER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+
+namespace parseagle {
+class Symbol;
+class Package;
+class DeviceSet;
+}  // namespace parseagle
+
+namespace librepcb {
+
+class FilePath;
+
+namespace library {
+class LibraryBaseElement;
+}
+
+namespace eagleimport {
+
+class ConverterDb;
+
+/*******************************************************************************
+ *  Class LibraryConverter
+ ******************************************************************************/
+
+/**
+ * @brief Converts the elements of an Eagle library into LibrePCB elements
+ *
+ * Combines the element converters (e.g. librepcb::eagleimport::SymbolConverter)
+ * with the required post-processing, so the GUI importer and the command line
+ * interface produce the same output. The conversion functions do not throw and
+ * only access the (thread-safe) librepcb::eagleimport::ConverterDb, so the
+ * elements of a library can be converted in parallel.
+ */
+class LibraryConverter final {
+public:
+  // Types
+  struct Result {
+    bool    success = false;
+    QString error;  ///< Null if no error occurred
+    /// The generated elements to save, with their output subdirectory
+    QList<QPair<QString, std::shared_ptr<library::LibraryBaseElement>>>
+        elements;
+  };
+
+  // Constructors / Destructor
+  LibraryConverter()                              = delete;
+  LibraryConverter(const LibraryConverter& other) = delete;
+  ~LibraryConverter()                             = delete;
+
+  // General Methods
+  static Result convertSymbol(ConverterDb&             db,
+                              const parseagle::Symbol& symbol) noexcept;
+  static Result convertPackage(ConverterDb&              db,
+                               const parseagle::Package& package) noexcept;
+  static Result convertDeviceSet(
+      ConverterDb& db, const parseagle::DeviceSet& deviceSet) noexcept;
+
+  /**
+   * @brief Save the elements of a conversion result
+   *
+   * @param result      The conversion result to save.
+   * @param outputDir   The output directory, the elements are saved into its
+   *                    subdirectories (e.g. "sym").
+   *
+   * @throw Exception   If saving failed.
+   */
+  static void save(const Result& result, const FilePath& outputDir);
+
+  // Operator Overloadings
+  LibraryConverter& operator=(const LibraryConverter& rhs) = delete;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace eagleimport
+}  // namespace librepcb
+
+#endif  // LIBREPCB_EAGLEIMPORT_LIBRARYCONVERTER_H
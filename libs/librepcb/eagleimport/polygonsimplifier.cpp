@@ -32,6 +32,7 @@
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
+namespace eagleimport {
 
 /*******************************************************************************
  *  Constructors / Destructor
@@ -184,4 +185,5 @@ template class PolygonSimplifier<library::Footprint>;
  *  End of File
  ******************************************************************************/
 
+}  // namespace eagleimport
 }  // namespace librepcb
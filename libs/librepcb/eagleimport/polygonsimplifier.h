@@ -17,8 +17,8 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef POLYGONSIMPLIFIER_H
-#define POLYGONSIMPLIFIER_H
+#ifndef LIBREPCB_EAGLEIMPORT_POLYGONSIMPLIFIER_H
+#define LIBREPCB_EAGLEIMPORT_POLYGONSIMPLIFIER_H
 
 /*******************************************************************************
  *  Includes
@@ -32,6 +32,7 @@
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
+namespace eagleimport {
 
 /*******************************************************************************
  *  Class PolygonSimplifier
@@ -66,6 +67,7 @@ private:
  *  End of File
  ******************************************************************************/
 
+}  // namespace eagleimport
 }  // namespace librepcb
 
-#endif  // POLYGONSIMPLIFIER_H
+#endif  // LIBREPCB_EAGLEIMPORT_POLYGONSIMPLIFIER_H
@@ -112,7 +112,7 @@ LibraryBaseElement::LibraryBaseElement(
   QString  sexprFileName = mLongElementName % ".lp";
   FilePath sexprFilePath = mDirectory->getAbsPath(sexprFileName);
   mLoadingFileDocument =
-      SExpression::parse(mDirectory->read(sexprFileName), sexprFilePath);
+      parseFile(mDirectory->read(sexprFileName), sexprFilePath);  // can throw
 
   // read attributes
   mUuid         = mLoadingFileDocument.getChildByIndex(0).getValue<Uuid>();
@@ -213,6 +213,36 @@ void LibraryBaseElement::serialize(SExpression& root) const {
   root.appendChild("deprecated", mIsDeprecated, true);
 }
 
+SExpression LibraryBaseElement::parseFile(const QByteArray& content,
+                                          const FilePath&   fp) {
+  // The same elements are often loaded many times within a session (e.g. for
+  // each device added to a board), so recently parsed files are kept in
+  // memory. The file content is part of the key, thus modified files are
+  // always parsed again.
+  static QMutex                          mutex;
+  static QCache<QByteArray, SExpression> cache(sMaxParseCacheSizeKb);
+  QByteArray key = fp.toStr().toUtf8();
+  key.append('\0');
+  key.append(QCryptographicHash::hash(content, QCryptographicHash::Sha1));
+  {
+    QMutexLocker lock(&mutex);
+    if (const SExpression* cached = cache.object(key)) {
+      return *cached;
+    }
+  }
+
+  SExpression root = SExpression::parse(content, fp);  // can throw
+
+  // Cached documents are shared between threads, so they must not parse
+  // their lazy children on first access anymore.
+  foreach (const SExpression& child, root.getChildren()) {
+    child.getChildren();
+  }
+  QMutexLocker lock(&mutex);
+  cache.insert(key, new SExpression(root), qMax(content.size() / 1024, 1));
+  return root;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -79,6 +79,18 @@ public:
     return mLongElementName;
   }
 
+  /**
+   * @brief Get the estimated memory still occupied by the loaded file's DOM
+   *
+   * The DOM is released after loading, so this is expected to be zero. It is
+   * only used to detect elements which unintentionally retain their DOM.
+   *
+   * @return Estimated size in bytes
+   */
+  qint64 getRetainedDomSize() const noexcept {
+    return mLoadingFileDocument.getMemoryUsage() - sizeof(SExpression);
+  }
+
   // Getters: Attributes
   const Uuid&      getUuid() const noexcept { return mUuid; }
   const Version&   getVersion() const noexcept { return mVersion; }
@@ -131,6 +143,7 @@ public:
 protected:
   // Protected Methods
   virtual void cleanupAfterLoadingElementFromFile() noexcept;
+  static SExpression parseFile(const QByteArray& content, const FilePath& fp);
 
   /// @copydoc librepcb::SerializableObject::serialize()
   virtual void serialize(SExpression& root) const override;
@@ -153,6 +166,9 @@ protected:
   LocalizedNameMap        mNames;
   LocalizedDescriptionMap mDescriptions;
   LocalizedKeywordsMap    mKeywords;
+
+  /// Maximum total size of the files kept by #parseFile() (in KiB)
+  static const int sMaxParseCacheSizeKb = 32 * 1024;
 };
 
 /*******************************************************************************
@@ -56,8 +56,12 @@ public:
   LibraryElementCheckMessage() = delete;
 
   // Getters
-  Severity       getSeverity() const noexcept { return mSeverity; }
-  const QPixmap& getSeverityPixmap() const noexcept { return mSeverityPixmap; }
+  Severity getSeverity() const noexcept { return mSeverity; }
+  QPixmap  getSeverityPixmap() const noexcept {
+    // Created on demand since pixmaps must only be used in the GUI thread,
+    // while the checks may run in worker threads.
+    return getSeverityPixmap(mSeverity);
+  }
   const QString& getMessage() const noexcept { return mMessage; }
   const QString& getDescription() const noexcept { return mDescription; }
 
@@ -87,7 +91,6 @@ protected:  // Methods
 
 protected:  // Data
   Severity mSeverity;
-  QPixmap  mSeverityPixmap;
   QString  mMessage;
   QString  mDescription;
 };
@@ -109,12 +109,14 @@ int FootprintGraphicsItem::getItemsAtPosition(
     QList<QSharedPointer<PolygonGraphicsItem>>*    polygons,
     QList<QSharedPointer<StrokeTextGraphicsItem>>* texts,
     QList<QSharedPointer<HoleGraphicsItem>>*       holes) noexcept {
-  int count = 0;
+  const QSet<QGraphicsItem*> candidates = getChildItemsAt(pos.toPxQPointF());
+  int                        count      = 0;
   if (pads) {
     foreach (const QSharedPointer<FootprintPadGraphicsItem>& item,
              mPadGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         pads->append(item);
         ++count;
       }
@@ -124,7 +126,8 @@ int FootprintGraphicsItem::getItemsAtPosition(
     foreach (const QSharedPointer<CircleGraphicsItem>& item,
              mCircleGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         circles->append(item);
         ++count;
       }
@@ -134,7 +137,8 @@ int FootprintGraphicsItem::getItemsAtPosition(
     foreach (const QSharedPointer<PolygonGraphicsItem>& item,
              mPolygonGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         polygons->append(item);
         ++count;
       }
@@ -144,7 +148,8 @@ int FootprintGraphicsItem::getItemsAtPosition(
     foreach (const QSharedPointer<StrokeTextGraphicsItem>& item,
              mStrokeTextGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         texts->append(item);
         ++count;
       }
@@ -153,7 +158,8 @@ int FootprintGraphicsItem::getItemsAtPosition(
   if (holes) {
     foreach (const QSharedPointer<HoleGraphicsItem>& item, mHoleGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         holes->append(item);
         ++count;
       }
@@ -293,34 +299,59 @@ void FootprintGraphicsItem::removeHole(Hole& hole) noexcept {
 }
 
 void FootprintGraphicsItem::setSelectionRect(const QRectF rect) noexcept {
-  QPainterPath path;
+  const QSet<QGraphicsItem*> candidates = getChildItemsIn(rect);
+  QPainterPath               path;
   path.addRect(rect);
   foreach (const QSharedPointer<FootprintPadGraphicsItem>& item,
            mPadGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
   foreach (const QSharedPointer<CircleGraphicsItem>& item,
            mCircleGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
   foreach (const QSharedPointer<PolygonGraphicsItem>& item,
            mPolygonGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
   foreach (const QSharedPointer<StrokeTextGraphicsItem>& item,
            mStrokeTextGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
   foreach (const QSharedPointer<HoleGraphicsItem>& item, mHoleGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QSet<QGraphicsItem*> FootprintGraphicsItem::getChildItemsAt(
+    const QPointF& pos) const noexcept {
+  if (!scene()) {
+    return childItems().toSet();
+  }
+  return scene()
+      ->items(mapToScene(pos), Qt::IntersectsItemBoundingRect)
+      .toSet();
+}
+
+QSet<QGraphicsItem*> FootprintGraphicsItem::getChildItemsIn(
+    const QRectF& rect) const noexcept {
+  if (!scene()) {
+    return childItems().toSet();
+  }
+  return scene()
+      ->items(mapToScene(rect.normalized()), Qt::IntersectsItemBoundingRect)
+      .toSet();
+}
+
 /*******************************************************************************
  *  Inherited from QGraphicsItem
  ******************************************************************************/
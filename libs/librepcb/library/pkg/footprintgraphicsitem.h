@@ -115,6 +115,18 @@ public:
   // Operator Overloadings
   FootprintGraphicsItem& operator=(const FootprintGraphicsItem& rhs) = delete;
 
+private:  // Methods
+  /**
+   * @brief Get the items whose bounding rect contains a position (or
+   *        intersects an area), given in item coordinates
+   *
+   * Uses the spatial index of the graphics scene, so the expensive shape of
+   * only a few candidates needs to be checked for large footprints. The
+   * result may also contain items not belonging to this footprint.
+   */
+  QSet<QGraphicsItem*> getChildItemsAt(const QPointF& pos) const noexcept;
+  QSet<QGraphicsItem*> getChildItemsIn(const QRectF& rect) const noexcept;
+
 private:  // Data
   Footprint&                      mFootprint;
   const IF_GraphicsLayerProvider& mLayerProvider;
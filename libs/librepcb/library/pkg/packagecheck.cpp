@@ -128,8 +128,13 @@ void PackageCheck::checkPadsOverlapWithPlacement(MsgList& msgs) const {
        itFtp != mPackage.getFootprints().end(); ++itFtp) {
     std::shared_ptr<const Footprint> footprint = itFtp.ptr();
 
-    QPainterPath topPlacement;
-    QPainterPath botPlacement;
+    // Keep the placement areas separate instead of uniting them into a single
+    // path, so each pad only needs to be tested against the areas whose
+    // bounding rect it touches. Otherwise every pad would be tested against
+    // the whole placement geometry, which is slow for high pin count
+    // footprints.
+    QVector<QPainterPath> topPlacement;
+    QVector<QPainterPath> botPlacement;
     for (const Polygon& polygon : footprint->getPolygons()) {
       QPen pen(Qt::NoPen);
       if (polygon.getLineWidth() > 0) {
@@ -140,32 +145,37 @@ void PackageCheck::checkPadsOverlapWithPlacement(MsgList& msgs) const {
       if (polygon.isFilled() && polygon.getPath().isClosed()) {
         brush.setStyle(Qt::SolidPattern);
       }
-      QPainterPath area = Toolbox::shapeFromPath(
-          polygon.getPath().toQPainterPathPx(), pen, brush);
+      QVector<QPainterPath>* areas = nullptr;
       if (polygon.getLayerName() == GraphicsLayer::sTopPlacement) {
-        topPlacement.addPath(area);
+        areas = &topPlacement;
       } else if (polygon.getLayerName() == GraphicsLayer::sBotPlacement) {
-        botPlacement.addPath(area);
+        areas = &botPlacement;
+      } else {
+        continue;
       }
+      areas->append(Toolbox::shapeFromPath(
+          polygon.getPath().toQPainterPathPx(), pen, brush));
     }
 
     for (auto it = (*itFtp).getPads().begin(); it != (*itFtp).getPads().end();
          ++it) {
       std::shared_ptr<const FootprintPad> pad = it.ptr();
-      std::shared_ptr<const PackagePad>   pkgPad =
-          mPackage.getPads().find(pad->getUuid());
+      const bool checkTop = pad->isOnLayer(GraphicsLayer::sTopCopper) &&
+                            (!topPlacement.isEmpty());
+      const bool checkBot = pad->isOnLayer(GraphicsLayer::sBotCopper) &&
+                            (!botPlacement.isEmpty());
+      if ((!checkTop) && (!checkBot)) {
+        continue;  // no need to build the stop mask
+      }
       Length clearance(150000);  // 150 µm
       Length tolerance(10);      // 0.01 µm, to avoid rounding issues
       Path   stopMaskPath = pad->getOutline(clearance - tolerance);
       stopMaskPath.rotate(pad->getRotation()).translate(pad->getPosition());
       QPainterPath stopMask = stopMaskPath.toQPainterPathPx();
-      if (pad->isOnLayer(GraphicsLayer::sTopCopper) &&
-          stopMask.intersects(topPlacement)) {
-        msgs.append(std::make_shared<MsgPadOverlapsWithPlacement>(
-            footprint, pad, pkgPad ? *pkgPad->getName() : QString(),
-            clearance));
-      } else if (pad->isOnLayer(GraphicsLayer::sBotCopper) &&
-                 stopMask.intersects(botPlacement)) {
+      if ((checkTop && intersectsAny(stopMask, topPlacement)) ||
+          (checkBot && intersectsAny(stopMask, botPlacement))) {
+        std::shared_ptr<const PackagePad> pkgPad =
+            mPackage.getPads().find(pad->getUuid());
         msgs.append(std::make_shared<MsgPadOverlapsWithPlacement>(
             footprint, pad, pkgPad ? *pkgPad->getName() : QString(),
             clearance));
@@ -174,6 +184,23 @@ void PackageCheck::checkPadsOverlapWithPlacement(MsgList& msgs) const {
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool PackageCheck::intersectsAny(const QPainterPath&          path,
+                                 const QVector<QPainterPath>& areas) noexcept {
+  const QRectF rect = path.controlPointRect();
+  for (const QPainterPath& area : areas) {
+    // Exact intersection tests are expensive, so only do them if the
+    // bounding rects overlap.
+    if (rect.intersects(area.controlPointRect()) && path.intersects(area)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -26,6 +26,7 @@
 #include "libraryelementcheck.h"
 
 #include <QtCore>
+#include <QtGui>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -63,6 +64,10 @@ protected:  // Methods
   void checkWrongTextLayers(MsgList& msgs) const;
   void checkPadsOverlapWithPlacement(MsgList& msgs) const;
 
+private:  // Methods
+  static bool intersectsAny(const QPainterPath&          path,
+                            const QVector<QPainterPath>& areas) noexcept;
+
 private:  // Data
   const Package& mPackage;
 };
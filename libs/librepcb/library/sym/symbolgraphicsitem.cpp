@@ -95,12 +95,14 @@ int SymbolGraphicsItem::getItemsAtPosition(
     QList<QSharedPointer<CircleGraphicsItem>>*  circles,
     QList<QSharedPointer<PolygonGraphicsItem>>* polygons,
     QList<QSharedPointer<TextGraphicsItem>>*    texts) noexcept {
-  int count = 0;
+  const QSet<QGraphicsItem*> candidates = getChildItemsAt(pos.toPxQPointF());
+  int                        count      = 0;
   if (pins) {
     foreach (const QSharedPointer<SymbolPinGraphicsItem>& item,
              mPinGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         pins->append(item);
         ++count;
       }
@@ -110,7 +112,8 @@ int SymbolGraphicsItem::getItemsAtPosition(
     foreach (const QSharedPointer<CircleGraphicsItem>& item,
              mCircleGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         circles->append(item);
         ++count;
       }
@@ -120,7 +123,8 @@ int SymbolGraphicsItem::getItemsAtPosition(
     foreach (const QSharedPointer<PolygonGraphicsItem>& item,
              mPolygonGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         polygons->append(item);
         ++count;
       }
@@ -129,7 +133,8 @@ int SymbolGraphicsItem::getItemsAtPosition(
   if (texts) {
     foreach (const QSharedPointer<TextGraphicsItem>& item, mTextGraphicsItems) {
       QPointF mappedPos = mapToItem(item.data(), pos.toPxQPointF());
-      if (item->shape().contains(mappedPos)) {
+      if (candidates.contains(item.data()) &&
+          item->shape().contains(mappedPos)) {
         texts->append(item);
         ++count;
       }
@@ -246,29 +251,54 @@ void SymbolGraphicsItem::removeText(Text& text) noexcept {
 }
 
 void SymbolGraphicsItem::setSelectionRect(const QRectF rect) noexcept {
-  QPainterPath path;
+  const QSet<QGraphicsItem*> candidates = getChildItemsIn(rect);
+  QPainterPath               path;
   path.addRect(rect);
   foreach (const QSharedPointer<SymbolPinGraphicsItem>& item,
            mPinGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
   foreach (const QSharedPointer<CircleGraphicsItem>& item,
            mCircleGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
   foreach (const QSharedPointer<PolygonGraphicsItem>& item,
            mPolygonGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
   foreach (const QSharedPointer<TextGraphicsItem>& item, mTextGraphicsItems) {
-    QPainterPath mappedPath = mapToItem(item.data(), path);
-    item->setSelected(item->shape().intersects(mappedPath));
+    item->setSelected(candidates.contains(item.data()) &&
+                      item->shape().intersects(mapToItem(item.data(), path)));
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QSet<QGraphicsItem*> SymbolGraphicsItem::getChildItemsAt(
+    const QPointF& pos) const noexcept {
+  if (!scene()) {
+    return childItems().toSet();
+  }
+  return scene()
+      ->items(mapToScene(pos), Qt::IntersectsItemBoundingRect)
+      .toSet();
+}
+
+QSet<QGraphicsItem*> SymbolGraphicsItem::getChildItemsIn(
+    const QRectF& rect) const noexcept {
+  if (!scene()) {
+    return childItems().toSet();
+  }
+  return scene()
+      ->items(mapToScene(rect.normalized()), Qt::IntersectsItemBoundingRect)
+      .toSet();
+}
+
 /*******************************************************************************
  *  Inherited from QGraphicsItem
  ******************************************************************************/
@@ -103,6 +103,12 @@ public:
   // Operator Overloadings
   SymbolGraphicsItem& operator=(const SymbolGraphicsItem& rhs) = delete;
 
+private:  // Methods
+  /// Bounding rect hits from the scene index, see
+  /// FootprintGraphicsItem::getChildItemsAt()
+  QSet<QGraphicsItem*> getChildItemsAt(const QPointF& pos) const noexcept;
+  QSet<QGraphicsItem*> getChildItemsIn(const QRectF& rect) const noexcept;
+
 private:  // Data
   Symbol&                                                  mSymbol;
   const IF_GraphicsLayerProvider&                          mLayerProvider;
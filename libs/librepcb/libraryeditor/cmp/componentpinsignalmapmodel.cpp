@@ -24,6 +24,7 @@
 
 #include "../libraryelementcache.h"
 
+#include <librepcb/common/undocommandgroup.h>
 #include <librepcb/common/undostack.h>
 #include <librepcb/library/cmp/cmd/cmdcomponentpinsignalmapitemedit.h>
 #include <librepcb/library/sym/symbol.h>
@@ -67,15 +68,13 @@ ComponentPinSignalMapModel::~ComponentPinSignalMapModel() noexcept {
 
 void ComponentPinSignalMapModel::setSymbolVariant(
     ComponentSymbolVariant* variant) noexcept {
-  emit beginResetModel();
-
   mOnItemsEditedSlot.detachAll();
   mSymbolVariant = variant;
   if (mSymbolVariant) {
     mSymbolVariant->getSymbolItems().onEdited.attach(mOnItemsEditedSlot);
   }
 
-  emit endResetModel();
+  resetRows();
 }
 
 void ComponentPinSignalMapModel::setSymbolsCache(
@@ -110,6 +109,9 @@ void ComponentPinSignalMapModel::autoAssignSignals() noexcept {
   }
 
   try {
+    // Execute all modifications as a single undo step.
+    QScopedPointer<UndoCommandGroup> cmdGroup(
+        new UndoCommandGroup(tr("Auto-Assign Signals")));
     for (ComponentSymbolVariantItem& item : mSymbolVariant->getSymbolItems()) {
       std::shared_ptr<const Symbol> symbol =
           mSymbolsCache->getSymbol(item.getSymbolUuid());
@@ -124,10 +126,11 @@ void ComponentPinSignalMapModel::autoAssignSignals() noexcept {
           QScopedPointer<CmdComponentPinSignalMapItemEdit> cmd(
               new CmdComponentPinSignalMapItemEdit(map));
           cmd->setSignalUuid(signalUuid);
-          execCmd(cmd.take());  // can throw
+          cmdGroup->appendChild(cmd.take());  // can throw
         }
       }
     }
+    execCmd(cmdGroup.take());  // can throw
   } catch (const Exception& e) {
     QMessageBox::critical(0, tr("Error"), e.getMsg());
   }
@@ -138,13 +141,10 @@ void ComponentPinSignalMapModel::autoAssignSignals() noexcept {
  ******************************************************************************/
 
 int ComponentPinSignalMapModel::rowCount(const QModelIndex& parent) const {
-  int count = 0;
-  if (!parent.isValid() && mSymbolVariant) {
-    for (const auto& item : mSymbolVariant->getSymbolItems()) {
-      count += item.getPinSignalMap().count();
-    }
+  if (!parent.isValid()) {
+    return mRows.count();
   }
-  return count;
+  return 0;
 }
 
 int ComponentPinSignalMapModel::columnCount(const QModelIndex& parent) const {
@@ -212,14 +212,13 @@ QVariant ComponentPinSignalMapModel::data(const QModelIndex& index,
       }
     }
     case COLUMN_SIGNAL: {
-      tl::optional<Uuid>                     uuid = mapItem->getSignalUuid();
-      std::shared_ptr<const ComponentSignal> sig =
-          uuid && mSignals ? mSignals->find(*uuid) : nullptr;
+      tl::optional<Uuid> uuid    = mapItem->getSignalUuid();
+      QString            sigName = uuid ? mSignalNames.value(*uuid) : QString();
       switch (role) {
         case Qt::DisplayRole:
-          return sig ? *sig->getName()
-                     : (uuid ? uuid->toStr()
-                             : QString("(%1)").arg(tr("unconnected")));
+          return sigName.isEmpty()
+              ? (uuid ? uuid->toStr() : QString("(%1)").arg(tr("unconnected")))
+              : sigName;
         case Qt::EditRole:
         case Qt::ToolTipRole:
           return uuid ? uuid->toStr() : QVariant();  // NULL means unconnected!
@@ -337,10 +336,25 @@ void ComponentPinSignalMapModel::symbolItemsEdited(
   switch (event) {
     case ComponentSymbolVariantItemList::Event::ElementAdded:
     case ComponentSymbolVariantItemList::Event::ElementRemoved:
-    case ComponentSymbolVariantItemList::Event::ElementEdited:
-      emit beginResetModel();
-      emit endResetModel();
+      resetRows();
+      break;
+    case ComponentSymbolVariantItemList::Event::ElementEdited: {
+      // Most edits (e.g. assigning a signal to a pin) don't modify the rows,
+      // so avoid the expensive model reset in that case.
+      QVector<Row> rows      = buildRows();
+      bool         unchanged = (rows.count() == mRows.count()) &&
+          std::equal(rows.begin(), rows.end(), mRows.begin(),
+                     [](const Row& a, const Row& b) {
+                       return a.mapItem == b.mapItem;
+                     });
+      if (unchanged) {
+        emit dataChanged(this->index(0, 0),
+                         this->index(rowCount() - 1, _COLUMN_COUNT - 1));
+      } else {
+        resetRows();
+      }
       break;
+    }
     default:
       qWarning() << "Unhandled switch-case in "
                     "ComponentPinSignalMapModel::symbolItemsEdited()";
@@ -381,10 +395,12 @@ void ComponentPinSignalMapModel::execCmd(UndoCommand* cmd) {
 
 void ComponentPinSignalMapModel::updateSignalComboBoxItems() noexcept {
   mSignalComboBoxItems.clear();
+  mSignalNames.clear();
   if (mSignals) {
     for (const ComponentSignal& sig : *mSignals) {
       mSignalComboBoxItems.append(ComboBoxDelegate::Item{
           *sig.getName(), QIcon(), sig.getUuid().toStr()});
+      mSignalNames.insert(sig.getUuid(), *sig.getName());
     }
   }
   mSignalComboBoxItems.sort();
@@ -397,17 +413,32 @@ void ComponentPinSignalMapModel::getRowItem(
     int row, int& symbolItemIndex,
     std::shared_ptr<ComponentSymbolVariantItem>& symbolItem,
     std::shared_ptr<ComponentPinSignalMapItem>&  mapItem) const noexcept {
-  int count = 0;
-  for (int i = 0; i < mSymbolVariant->getSymbolItems().count(); ++i) {
-    symbolItemIndex = i;
-    symbolItem      = mSymbolVariant->getSymbolItems().value(i);
-    if (row < (count + symbolItem->getPinSignalMap().count())) {
-      mapItem = symbolItem->getPinSignalMap().value(row - count);
-      break;
-    } else {
-      count += symbolItem->getPinSignalMap().count();
+  if ((row >= 0) && (row < mRows.count())) {
+    symbolItemIndex = mRows[row].symbolItemIndex;
+    symbolItem      = mRows[row].symbolItem;
+    mapItem         = mRows[row].mapItem;
+  }
+}
+
+QVector<ComponentPinSignalMapModel::Row> ComponentPinSignalMapModel::buildRows()
+    const noexcept {
+  QVector<Row> rows;
+  if (mSymbolVariant) {
+    ComponentSymbolVariantItemList& items = mSymbolVariant->getSymbolItems();
+    for (int i = 0; i < items.count(); ++i) {
+      std::shared_ptr<ComponentSymbolVariantItem> item = items.value(i);
+      for (int k = 0; k < item->getPinSignalMap().count(); ++k) {
+        rows.append(Row{i, item, item->getPinSignalMap().value(k)});
+      }
     }
   }
+  return rows;
+}
+
+void ComponentPinSignalMapModel::resetRows() noexcept {
+  emit beginResetModel();
+  mRows = buildRows();
+  emit endResetModel();
 }
 
 /*******************************************************************************
@@ -91,7 +91,14 @@ public:
   ComponentPinSignalMapModel& operator=(
       const ComponentPinSignalMapModel& rhs) noexcept;
 
-private:
+private:  // Types
+  struct Row {
+    int                                         symbolItemIndex;
+    std::shared_ptr<ComponentSymbolVariantItem> symbolItem;
+    std::shared_ptr<ComponentPinSignalMapItem>  mapItem;
+  };
+
+private:  // Methods
   void symbolItemsEdited(
       const ComponentSymbolVariantItemList& list, int index,
       const std::shared_ptr<const ComponentSymbolVariantItem>& item,
@@ -101,6 +108,8 @@ private:
                         ComponentSignalList::Event event) noexcept;
   void execCmd(UndoCommand* cmd);
   void updateSignalComboBoxItems() noexcept;
+  QVector<Row> buildRows() const noexcept;
+  void         resetRows() noexcept;
   void getRowItem(int row, int& symbolItemIndex,
                   std::shared_ptr<ComponentSymbolVariantItem>& symbolItem,
                   std::shared_ptr<ComponentPinSignalMapItem>&  mapItem) const
@@ -114,6 +123,10 @@ private:  // Data
   ComboBoxDelegate::Items                    mSignalComboBoxItems;
   ComboBoxDelegate::Items                    mDisplayTypeComboBoxItems;
 
+  /// Lookup tables to avoid iterating over all items for every table cell
+  QVector<Row>         mRows;
+  QHash<Uuid, QString> mSignalNames;
+
   // Slots
   ComponentSymbolVariantItemList::OnEditedSlot mOnItemsEditedSlot;
   ComponentSignalList::OnEditedSlot            mOnSignalsEditedSlot;
@@ -53,6 +53,8 @@ class LibraryBaseElement;
 
 namespace editor {
 
+class LibraryElementCache;
+
 /*******************************************************************************
  *  Class EditorWidgetBase
  ******************************************************************************/
@@ -72,6 +74,9 @@ public:
     const IF_GraphicsLayerProvider& layerProvider;
     bool                            elementIsNewlyCreated;
     bool                            readOnly;
+
+    /// Referenced elements, shared by all editors of a library editor
+    std::shared_ptr<const LibraryElementCache> elementCache;
   };
 
   enum Tool {
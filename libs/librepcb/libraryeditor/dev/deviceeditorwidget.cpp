@@ -24,6 +24,7 @@
 
 #include "../common/componentchooserdialog.h"
 #include "../common/packagechooserdialog.h"
+#include "../libraryelementcache.h"
 #include "ui_deviceeditorwidget.h"
 
 #include <librepcb/common/graphics/defaultgraphicslayerprovider.h>
@@ -60,7 +61,10 @@ namespace editor {
 
 DeviceEditorWidget::DeviceEditorWidget(const Context&  context,
                                        const FilePath& fp, QWidget* parent)
-  : EditorWidgetBase(context, fp, parent), mUi(new Ui::DeviceEditorWidget) {
+  : EditorWidgetBase(context, fp, parent),
+    mUi(new Ui::DeviceEditorWidget),
+    mComponentPreviewOutdated(false),
+    mPackagePreviewOutdated(false) {
   mUi->setupUi(this);
   mUi->lstMessages->setHandler(this);
   setupErrorNotificationWidget(*mUi->errorNotificationWidget);
@@ -175,6 +179,16 @@ bool DeviceEditorWidget::zoomAll() noexcept {
   return true;
 }
 
+/*******************************************************************************
+ *  Inherited from QWidget
+ ******************************************************************************/
+
+void DeviceEditorWidget::showEvent(QShowEvent* e) noexcept {
+  EditorWidgetBase::showEvent(e);
+  if (mComponentPreviewOutdated) updateComponentPreview();
+  if (mPackagePreviewOutdated) updatePackagePreview();
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -230,14 +244,11 @@ void DeviceEditorWidget::btnChooseComponentClicked() noexcept {
     if (cmpUuid && (*cmpUuid != mDevice->getComponentUuid())) {
       try {
         // load component
-        FilePath fp = mContext.workspace.getLibraryDb().getLatestComponent(
-            *cmpUuid);  // can throw
-        if (!fp.isValid()) {
+        std::shared_ptr<const Component> component =
+            mContext.elementCache->getComponent(*cmpUuid);
+        if (!component) {
           throw RuntimeError(__FILE__, __LINE__, tr("Component not found!"));
         }
-        Component component(
-            std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-                TransactionalFileSystem::openRO(fp))));  // can throw
 
         // edit device
         QScopedPointer<UndoCommandGroup> cmdGroup(
@@ -247,7 +258,7 @@ void DeviceEditorWidget::btnChooseComponentClicked() noexcept {
         cmdGroup->appendChild(cmdDevEdit.take());
         for (DevicePadSignalMapItem& item : mDevice->getPadSignalMap()) {
           tl::optional<Uuid> signalUuid = item.getSignalUuid();
-          if (!signalUuid || !component.getSignals().contains(*signalUuid)) {
+          if (!signalUuid || !component->getSignals().contains(*signalUuid)) {
             QScopedPointer<CmdDevicePadSignalMapItemEdit> cmdItem(
                 new CmdDevicePadSignalMapItemEdit(item));
             cmdItem->setSignalUuid(tl::nullopt);
@@ -270,15 +281,12 @@ void DeviceEditorWidget::btnChoosePackageClicked() noexcept {
     if (pkgUuid && (*pkgUuid != mDevice->getPackageUuid())) {
       try {
         // load package
-        FilePath fp = mContext.workspace.getLibraryDb().getLatestPackage(
-            *pkgUuid);  // can throw
-        if (!fp.isValid()) {
+        std::shared_ptr<const Package> package =
+            mContext.elementCache->getPackage(*pkgUuid);
+        if (!package) {
           throw RuntimeError(__FILE__, __LINE__, tr("Package not found!"));
         }
-        Package package(
-            std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-                TransactionalFileSystem::openRO(fp))));  // can throw
-        QSet<Uuid> pads = package.getPads().getUuidSet();
+        QSet<Uuid> pads = package->getPads().getUuidSet();
 
         // edit device
         QScopedPointer<UndoCommandGroup> cmdGroup(
@@ -311,14 +319,10 @@ void DeviceEditorWidget::updateDeviceComponentUuid(const Uuid& uuid) noexcept {
   mSymbolGraphicsItems.clear();
   mSymbols.clear();
   try {
-    FilePath fp = mContext.workspace.getLibraryDb().getLatestComponent(
-        uuid);  // can throw
-    if (!fp.isValid()) {
+    mComponent = mContext.elementCache->getComponent(uuid);
+    if (!mComponent) {
       throw RuntimeError(__FILE__, __LINE__, tr("Component not found!"));
     }
-    mComponent.reset(new Component(
-        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-            TransactionalFileSystem::openRO(fp)))));  // can throw
     mUi->padSignalMapEditorWidget->setSignalList(mComponent->getSignals());
     mUi->lblComponentName->setText(
         *mComponent->getNames().value(getLibLocaleOrder()));
@@ -335,28 +339,27 @@ void DeviceEditorWidget::updateDeviceComponentUuid(const Uuid& uuid) noexcept {
 }
 
 void DeviceEditorWidget::updateComponentPreview() noexcept {
+  // Building the graphics items is expensive, so do it only once the tab is
+  // actually shown.
+  mComponentPreviewOutdated = !isVisible();
+  if (mComponentPreviewOutdated) return;
+
   if (mComponent && mComponent->getSymbolVariants().count() > 0) {
     const ComponentSymbolVariant& symbVar =
         *mComponent->getSymbolVariants().first();
     for (const ComponentSymbolVariantItem& item : symbVar.getSymbolItems()) {
-      try {
-        FilePath fp = mContext.workspace.getLibraryDb().getLatestSymbol(
-            item.getSymbolUuid());  // can throw
-        std::shared_ptr<Symbol> sym = std::make_shared<Symbol>(
-            std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-                TransactionalFileSystem::openRO(fp))));  // can throw
-        mSymbols.append(sym);
-        std::shared_ptr<SymbolPreviewGraphicsItem> graphicsItem =
-            std::make_shared<SymbolPreviewGraphicsItem>(
-                *mGraphicsLayerProvider, QStringList(), *sym, mComponent.data(),
-                symbVar.getUuid(), item.getUuid());
-        graphicsItem->setPos(item.getSymbolPosition().toPxQPointF());
-        graphicsItem->setRotation(-item.getSymbolRotation().toDeg());
-        mComponentGraphicsScene->addItem(*graphicsItem);
-        mSymbolGraphicsItems.append(graphicsItem);
-      } catch (const Exception& e) {
-        // what could we do here? ;)
-      }
+      std::shared_ptr<const Symbol> sym =
+          mContext.elementCache->getSymbol(item.getSymbolUuid());
+      if (!sym) continue;  // what could we do here? ;)
+      mSymbols.append(sym);
+      std::shared_ptr<SymbolPreviewGraphicsItem> graphicsItem =
+          std::make_shared<SymbolPreviewGraphicsItem>(
+              *mGraphicsLayerProvider, QStringList(), *sym, mComponent.get(),
+              symbVar.getUuid(), item.getUuid());
+      graphicsItem->setPos(item.getSymbolPosition().toPxQPointF());
+      graphicsItem->setRotation(-item.getSymbolRotation().toDeg());
+      mComponentGraphicsScene->addItem(*graphicsItem);
+      mSymbolGraphicsItems.append(graphicsItem);
     }
     mUi->viewComponent->zoomAll();
   }
@@ -365,14 +368,10 @@ void DeviceEditorWidget::updateComponentPreview() noexcept {
 void DeviceEditorWidget::updateDevicePackageUuid(const Uuid& uuid) noexcept {
   mFootprintGraphicsItem.reset();
   try {
-    FilePath fp =
-        mContext.workspace.getLibraryDb().getLatestPackage(uuid);  // can throw
-    if (!fp.isValid()) {
+    mPackage = mContext.elementCache->getPackage(uuid);
+    if (!mPackage) {
       throw RuntimeError(__FILE__, __LINE__, tr("Package not found!"));
     }
-    mPackage.reset(new Package(
-        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-            TransactionalFileSystem::openRO(fp)))));  // can throw
     mUi->padSignalMapEditorWidget->setPadList(mPackage->getPads());
     mUi->lblPackageName->setText(
         *mPackage->getNames().value(getLibLocaleOrder()));
@@ -389,11 +388,14 @@ void DeviceEditorWidget::updateDevicePackageUuid(const Uuid& uuid) noexcept {
 }
 
 void DeviceEditorWidget::updatePackagePreview() noexcept {
+  mPackagePreviewOutdated = !isVisible();
+  if (mPackagePreviewOutdated) return;
+
   if (mPackage && mPackage->getFootprints().count() > 0) {
     mFootprintGraphicsItem.reset(
         new FootprintPreviewGraphicsItem(*mGraphicsLayerProvider, QStringList(),
                                          *mPackage->getFootprints().first(),
-                                         mPackage.data(), mComponent.data()));
+                                         mPackage.get(), mComponent.get()));
     mPackageGraphicsScene->addItem(*mFootprintGraphicsItem);
     mUi->viewPackage->zoomAll();
   }
@@ -90,6 +90,7 @@ private:  // Methods
   void    updateComponentPreview() noexcept;
   void    updateDevicePackageUuid(const Uuid& uuid) noexcept;
   void    updatePackagePreview() noexcept;
+  void    showEvent(QShowEvent* e) noexcept override;
   void    memorizeDeviceInterface() noexcept;
   bool    isInterfaceBroken() const noexcept override;
   bool    runChecks(LibraryElementCheckMessageList& msgs) const override;
@@ -109,15 +110,17 @@ private:  // Data
   QScopedPointer<DefaultGraphicsLayerProvider>      mGraphicsLayerProvider;
 
   // component
-  QScopedPointer<Component>                         mComponent;
+  std::shared_ptr<const Component>                  mComponent;
   QScopedPointer<GraphicsScene>                     mComponentGraphicsScene;
-  QList<std::shared_ptr<Symbol>>                    mSymbols;
+  QList<std::shared_ptr<const Symbol>>              mSymbols;
   QList<std::shared_ptr<SymbolPreviewGraphicsItem>> mSymbolGraphicsItems;
+  bool                                              mComponentPreviewOutdated;
 
   // package
-  QScopedPointer<Package>                      mPackage;
+  std::shared_ptr<const Package>               mPackage;
   QScopedPointer<GraphicsScene>                mPackageGraphicsScene;
   QScopedPointer<FootprintPreviewGraphicsItem> mFootprintGraphicsItem;
+  bool                                         mPackagePreviewOutdated;
 
   // broken interface detection
   tl::optional<Uuid> mOriginalComponentUuid;
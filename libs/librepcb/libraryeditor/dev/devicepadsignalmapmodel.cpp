@@ -44,8 +44,6 @@ DevicePadSignalMapModel::DevicePadSignalMapModel(QObject* parent) noexcept
   : QAbstractTableModel(parent),
     mPadSignalMap(nullptr),
     mUndoStack(nullptr),
-    mSignals(),
-    mPads(),
     mComboBoxItems(),
     mOnEditedSlot(*this, &DevicePadSignalMapModel::padSignalMapEdited) {
   updateComboBoxItems();
@@ -81,14 +79,20 @@ void DevicePadSignalMapModel::setUndoStack(UndoStack* stack) noexcept {
 
 void DevicePadSignalMapModel::setSignalList(
     const ComponentSignalList& list) noexcept {
-  mSignals = list;
+  mSignalNames.clear();
+  for (const ComponentSignal& sig : list) {
+    mSignalNames.insert(sig.getUuid(), *sig.getName());
+  }
   updateComboBoxItems();
   emit dataChanged(index(0, COLUMN_SIGNAL),
                    index(rowCount() - 1, COLUMN_SIGNAL));
 }
 
 void DevicePadSignalMapModel::setPadList(const PackagePadList& list) noexcept {
-  mPads = list;
+  mPadNames.clear();
+  for (const PackagePad& pad : list) {
+    mPadNames.insert(pad.getUuid(), *pad.getName());
+  }
   emit dataChanged(index(0, COLUMN_PAD), index(rowCount() - 1, COLUMN_PAD));
 }
 
@@ -124,11 +128,10 @@ QVariant DevicePadSignalMapModel::data(const QModelIndex& index,
 
   switch (index.column()) {
     case COLUMN_PAD: {
-      Uuid                              uuid = item->getPadUuid();
-      std::shared_ptr<const PackagePad> pad  = mPads.find(uuid);
+      Uuid uuid = item->getPadUuid();
       switch (role) {
         case Qt::DisplayRole:
-          return pad ? *pad->getName() : uuid.toStr();
+          return mPadNames.value(uuid, uuid.toStr());
         case Qt::ToolTipRole:
           return uuid.toStr();
         default:
@@ -136,13 +139,11 @@ QVariant DevicePadSignalMapModel::data(const QModelIndex& index,
       }
     }
     case COLUMN_SIGNAL: {
-      tl::optional<Uuid>                     uuid = item->getSignalUuid();
-      std::shared_ptr<const ComponentSignal> sig =
-          uuid ? mSignals.find(*uuid) : nullptr;
+      tl::optional<Uuid> uuid = item->getSignalUuid();
       switch (role) {
         case Qt::DisplayRole:
-          return sig ? *sig->getName()
-                     : (uuid ? uuid->toStr() : tr("(unconnected)"));
+          return uuid ? mSignalNames.value(*uuid, uuid->toStr())
+                      : tr("(unconnected)");
         case Qt::EditRole:
           return uuid ? uuid->toStr() : QVariant();  // NULL means unconnected!
         case Qt::ToolTipRole:
@@ -266,9 +267,10 @@ void DevicePadSignalMapModel::execCmd(UndoCommand* cmd) {
 
 void DevicePadSignalMapModel::updateComboBoxItems() noexcept {
   mComboBoxItems.clear();
-  for (const ComponentSignal& sig : mSignals) {
+  for (auto it = mSignalNames.constBegin(); it != mSignalNames.constEnd();
+       ++it) {
     mComboBoxItems.append(
-        ComboBoxDelegate::Item{*sig.getName(), QIcon(), sig.getUuid().toStr()});
+        ComboBoxDelegate::Item{it.value(), QIcon(), it.key().toStr()});
   }
   mComboBoxItems.sort();
   mComboBoxItems.insert(
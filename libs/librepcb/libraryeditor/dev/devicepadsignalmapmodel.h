@@ -91,10 +91,12 @@ private:
 private:  // Data
   DevicePadSignalMap*     mPadSignalMap;
   UndoStack*              mUndoStack;
-  ComponentSignalList     mSignals;
-  PackagePadList          mPads;
   ComboBoxDelegate::Items mComboBoxItems;
 
+  /// Names of all signals and pads, to avoid list lookups for every cell
+  QHash<Uuid, QString> mSignalNames;
+  QHash<Uuid, QString> mPadNames;
+
   // Slots
   DevicePadSignalMap::OnEditedSlot mOnEditedSlot;
 };
@@ -27,11 +27,13 @@
 
 #include <librepcb/common/dialogs/filedialog.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/utils/taskscheduler.h>
 #include <librepcb/library/cmd/cmdlibraryedit.h>
 #include <librepcb/library/elements.h>
 #include <librepcb/library/msg/msgmissingauthor.h>
 #include <librepcb/library/msg/msgnamenottitlecase.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibrarythumbnailcache.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/workspace.h>
 
@@ -122,6 +124,12 @@ LibraryOverviewWidget::LibraryOverviewWidget(const Context&  context,
   connect(mUi->lstDev, &QListWidget::customContextMenuRequested, this,
           &LibraryOverviewWidget::openContextMenuAtPos);
 
+  // Fetch the element tooltips lazily when they are shown.
+  for (QListWidget* list : {mUi->lstCmpCat, mUi->lstPkgCat, mUi->lstSym,
+                            mUi->lstPkg, mUi->lstCmp, mUi->lstDev}) {
+    list->viewport()->installEventFilter(this);
+  }
+
   // Load all library elements.
   updateElementLists();
   connect(&mContext.workspace.getLibraryDb(),
@@ -130,6 +138,16 @@ LibraryOverviewWidget::LibraryOverviewWidget(const Context&  context,
 }
 
 LibraryOverviewWidget::~LibraryOverviewWidget() noexcept {
+  // Don't start any more checks and wait for the running ones, since they
+  // can't be aborted.
+  foreach (QFutureWatcher<LibraryElementCheckMessageList>* watcher,
+           mRunningChecks) {
+    watcher->cancel();
+  }
+  foreach (QFutureWatcher<LibraryElementCheckMessageList>* watcher,
+           mRunningChecks) {
+    watcher->waitForFinished();
+  }
 }
 
 /*******************************************************************************
@@ -137,13 +155,17 @@ LibraryOverviewWidget::~LibraryOverviewWidget() noexcept {
  ******************************************************************************/
 
 void LibraryOverviewWidget::setFilter(const QString& filter) noexcept {
-  mCurrentFilter = filter.toLower().trimmed();
-  updateElementListFilter(*mUi->lstCmpCat);
-  updateElementListFilter(*mUi->lstPkgCat);
-  updateElementListFilter(*mUi->lstSym);
-  updateElementListFilter(*mUi->lstPkg);
-  updateElementListFilter(*mUi->lstCmp);
-  updateElementListFilter(*mUi->lstDev);
+  QString newFilter = filter.toLower().trimmed();
+  // If the filter got only more restrictive (e.g. while typing), hidden items
+  // can't match anymore, so only the visible items need to be filtered.
+  const bool onlyVisible = newFilter.contains(mCurrentFilter);
+  mCurrentFilter         = newFilter;
+  updateElementListFilter(*mUi->lstCmpCat, onlyVisible);
+  updateElementListFilter(*mUi->lstPkgCat, onlyVisible);
+  updateElementListFilter(*mUi->lstSym, onlyVisible);
+  updateElementListFilter(*mUi->lstPkg, onlyVisible);
+  updateElementListFilter(*mUi->lstCmp, onlyVisible);
+  updateElementListFilter(*mUi->lstDev, onlyVisible);
 }
 
 /*******************************************************************************
@@ -180,6 +202,26 @@ bool LibraryOverviewWidget::remove() noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Inherited from QObject
+ ******************************************************************************/
+
+bool LibraryOverviewWidget::eventFilter(QObject* obj, QEvent* event) noexcept {
+  if (event->type() == QEvent::ToolTip) {
+    for (QListWidget* list : {mUi->lstCmpCat, mUi->lstPkgCat, mUi->lstSym,
+                              mUi->lstPkg, mUi->lstCmp, mUi->lstDev}) {
+      if (obj == list->viewport()) {
+        QHelpEvent* e = static_cast<QHelpEvent*>(event);
+        if (QListWidgetItem* item = list->itemAt(e->pos())) {
+          updateElementListItemToolTip(*list, *item);
+        }
+        break;
+      }
+    }
+  }
+  return EditorWidgetBase::eventFilter(obj, event);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -294,7 +336,8 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
   QHash<FilePath, QString> elementNames;
 
   try {
-    // get all library element names
+    // get all library element names (the tooltips are fetched lazily when
+    // they are shown, see updateElementListItemToolTip())
     QList<FilePath> elements =
         mContext.workspace.getLibraryDb().getLibraryElements<ElementType>(
             mLibrary->getDirectory().getAbsPath());  // can throw
@@ -315,13 +358,21 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
     return;
   }
 
+  // Inserting items into a sorted list is expensive for large libraries, so
+  // sort only once after all items are updated.
+  listWidget.setUpdatesEnabled(false);
+  listWidget.setSortingEnabled(false);
+
   // update/remove existing list widget items
   for (int i = listWidget.count() - 1; i >= 0; --i) {
     QListWidgetItem* item = listWidget.item(i);
     Q_ASSERT(item);
-    FilePath filePath(item->data(Qt::UserRole).toString());
+    FilePath filePath(item->data(FilePathRole).toString());
     if (elementNames.contains(filePath)) {
-      item->setText(elementNames.take(filePath));
+      QString name = elementNames.take(filePath);
+      item->setText(name);
+      item->setData(FilterTextRole, name.toLower());
+      item->setData(ToolTipRole, QVariant());  // thumbnail might have changed
     } else {
       delete item;
     }
@@ -332,13 +383,146 @@ void LibraryOverviewWidget::updateElementList(QListWidget& listWidget,
     QString          name = elementNames.value(fp);
     QListWidgetItem* item = new QListWidgetItem(&listWidget);
     item->setText(name);
-    item->setToolTip(name);
-    item->setData(Qt::UserRole, fp.toStr());
+    item->setData(FilePathRole, fp.toStr());
+    item->setData(FilterTextRole, name.toLower());
     item->setIcon(icon);
   }
 
+  listWidget.setSortingEnabled(true);
+  listWidget.setUpdatesEnabled(true);
+
   // apply filter
   updateElementListFilter(listWidget);
+
+  // (re-)check all elements since any of them might have been modified
+  startElementChecks<ElementType>(listWidget, icon);
+}
+
+template <typename ElementType>
+void LibraryOverviewWidget::startElementChecks(QListWidget& listWidget,
+                                               const QIcon& icon) noexcept {
+  // The elements are opened and checked in worker threads, so even large
+  // libraries don't block the GUI. Each result is shown in the list as soon
+  // as it is available.
+  for (int i = 0; i < listWidget.count(); ++i) {
+    QListWidgetItem* item = listWidget.item(i);
+    Q_ASSERT(item);
+    FilePath fp(item->data(FilePathRole).toString());
+    if (!fp.isValid()) continue;
+
+    // Results of outdated checks are not interesting anymore.
+    if (QFutureWatcher<LibraryElementCheckMessageList>* watcher =
+            mRunningChecks.take(fp)) {
+      watcher->cancel();
+      delete watcher;
+    }
+
+    QFutureWatcher<LibraryElementCheckMessageList>* watcher =
+        new QFutureWatcher<LibraryElementCheckMessageList>(this);
+    connect(watcher,
+            &QFutureWatcher<LibraryElementCheckMessageList>::finished, this,
+            [this, &listWidget, icon, fp]() {
+              elementChecksFinished(listWidget, icon, fp);
+            });
+    mRunningChecks.insert(fp, watcher);
+    watcher->setFuture(TaskScheduler::run(
+        TaskScheduler::Priority::Background,
+        [fp]() { return runElementChecks<ElementType>(fp); }));
+  }
+}
+
+template <typename ElementType>
+LibraryElementCheckMessageList LibraryOverviewWidget::runElementChecks(
+    const FilePath& fp) {
+  // Each element gets its own file system since TransactionalFileSystem is
+  // not thread-safe.
+  ElementType element(std::unique_ptr<TransactionalDirectory>(
+      new TransactionalDirectory(
+          TransactionalFileSystem::openRO(fp))));  // can throw
+  return element.runChecks();                      // can throw
+}
+
+void LibraryOverviewWidget::elementChecksFinished(QListWidget&    listWidget,
+                                                  const QIcon&    icon,
+                                                  const FilePath& fp) noexcept {
+  QFutureWatcher<LibraryElementCheckMessageList>* watcher =
+      mRunningChecks.take(fp);
+  Q_ASSERT(watcher);
+  watcher->deleteLater();
+
+  QListWidgetItem* item = nullptr;
+  for (int i = 0; i < listWidget.count(); ++i) {
+    if (listWidget.item(i)->data(FilePathRole).toString() == fp.toStr()) {
+      item = listWidget.item(i);
+      break;
+    }
+  }
+  if (!item) return;  // element was removed in the meantime
+
+  QString checks;
+  try {
+    LibraryElementCheckMessageList msgs = watcher->result();  // can throw
+    LibraryElementCheckMessage::Severity severity =
+        LibraryElementCheckMessage::Severity::Hint;
+    QString list;
+    for (const auto& msg : msgs) {
+      severity = std::max(severity, msg->getSeverity());
+      list += "<li>" % msg->getMessage().toHtmlEscaped() % "</li>";
+    }
+    if (severity > LibraryElementCheckMessage::Severity::Hint) {
+      item->setIcon(LibraryElementCheckMessage::getSeverityPixmap(severity));
+    } else {
+      item->setIcon(icon);
+    }
+    if (!msgs.isEmpty()) {
+      checks = "<ul>" % list % "</ul>";
+    }
+  } catch (const Exception& e) {
+    item->setIcon(QIcon(":/img/status/dialog_error.png"));
+    checks = "<p>" % e.getMsg().toHtmlEscaped() % "</p>";
+  }
+  item->setData(ChecksRole, checks);
+  if (item->data(ToolTipRole).isValid()) {
+    updateElementListItemToolTip(listWidget, *item);
+  }
+}
+
+void LibraryOverviewWidget::updateElementListItemToolTip(
+    const QListWidget& listWidget, QListWidgetItem& item) noexcept {
+  FilePath fp(item.data(FilePathRole).toString());
+  if (!fp.isValid()) return;  // error message item
+
+  // The element metadata and thumbnail are fetched only when the tooltip is
+  // shown the first time, which avoids database queries for all elements
+  // when opening large libraries.
+  QString toolTip = item.data(ToolTipRole).toString();
+  if (toolTip.isNull()) {
+    QString thumbnail;
+    if (&listWidget == mUi->lstSym) {
+      thumbnail = getElementThumbnailHtml<Symbol>(fp);
+    } else if (&listWidget == mUi->lstPkg) {
+      thumbnail = getElementThumbnailHtml<Package>(fp);
+    }
+    toolTip = "<p>" % item.text().toHtmlEscaped() % "</p>" % thumbnail;
+    item.setData(ToolTipRole, toolTip);
+  }
+  item.setToolTip(toolTip % item.data(ChecksRole).toString());
+}
+
+template <typename ElementType>
+QString LibraryOverviewWidget::getElementThumbnailHtml(
+    const FilePath& fp) const noexcept {
+  try {
+    // the initial values get overwritten by the database query
+    Uuid    uuid    = Uuid::createRandom();
+    Version version = Version::fromString("0.1");
+    mContext.workspace.getLibraryDb().getElementMetadata<ElementType>(
+        fp, &uuid, &version);  // can throw
+    return mContext.workspace.getLibraryThumbnailCache().getThumbnailHtml(
+        uuid, version);
+  } catch (const Exception& e) {
+    return QString();
+  }
 }
 
 QHash<QListWidgetItem*, FilePath>
@@ -346,7 +530,7 @@ LibraryOverviewWidget::getElementListItemFilePaths(
     const QList<QListWidgetItem*>& items) const noexcept {
   QHash<QListWidgetItem*, FilePath> itemPaths;
   foreach (QListWidgetItem* item, items) {
-    FilePath fp = FilePath(item->data(Qt::UserRole).toString());
+    FilePath fp = FilePath(item->data(FilePathRole).toString());
     if (fp.isValid()) {
       itemPaths.insert(item, fp);
     } else {
@@ -356,13 +540,15 @@ LibraryOverviewWidget::getElementListItemFilePaths(
   return itemPaths;
 }
 
-void LibraryOverviewWidget::updateElementListFilter(
-    QListWidget& listWidget) noexcept {
+void LibraryOverviewWidget::updateElementListFilter(QListWidget& listWidget,
+                                                    bool onlyVisible) noexcept {
   for (int i = 0; i < listWidget.count(); ++i) {
     QListWidgetItem* item = listWidget.item(i);
     Q_ASSERT(item);
-    item->setHidden((!mCurrentFilter.isEmpty()) &&
-                    (!item->text().toLower().contains(mCurrentFilter)));
+    if (onlyVisible && item->isHidden()) continue;
+    item->setHidden(
+        (!mCurrentFilter.isEmpty()) &&
+        (!item->data(FilterTextRole).toString().contains(mCurrentFilter)));
   }
 }
 
@@ -621,7 +807,7 @@ void LibraryOverviewWidget::lstDoubleClicked(
   Q_ASSERT(list);
   QListWidgetItem* item = list->item(index.row());
   FilePath         fp =
-      item ? FilePath(item->data(Qt::UserRole).toString()) : FilePath();
+      item ? FilePath(item->data(FilePathRole).toString()) : FilePath();
   if (fp.isValid()) {
     editItem(list, fp);
   }
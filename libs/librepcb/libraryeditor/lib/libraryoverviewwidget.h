@@ -60,6 +60,14 @@ class LibraryOverviewWidget final : public EditorWidgetBase {
     FilePath filepath;
   };
 
+  /// Custom data roles of the element list items
+  enum ElementListItemRole {
+    FilePathRole = Qt::UserRole,  ///< Element directory
+    FilterTextRole,               ///< Lower case name, used for filtering
+    ToolTipRole,                  ///< Lazily fetched tooltip (w/o checks)
+    ChecksRole,                   ///< Check messages (HTML)
+  };
+
 public:
   // Constructors / Destructor
   LibraryOverviewWidget()                                   = delete;
@@ -102,6 +110,10 @@ signals:
   void duplicateDeviceTriggered(const FilePath& fp);
   void removeElementTriggered(const FilePath& fp);
 
+protected:
+  // Inherited from QObject
+  bool eventFilter(QObject* obj, QEvent* event) noexcept override;
+
 private:  // Methods
   void    updateMetadata() noexcept;
   QString commitMetadata() noexcept;
@@ -118,9 +130,20 @@ private:  // Methods
   void updateElementLists() noexcept;
   template <typename ElementType>
   void updateElementList(QListWidget& listWidget, const QIcon& icon) noexcept;
+  template <typename ElementType>
+  void startElementChecks(QListWidget& listWidget, const QIcon& icon) noexcept;
+  template <typename ElementType>
+  static LibraryElementCheckMessageList runElementChecks(const FilePath& fp);
+  void elementChecksFinished(QListWidget& listWidget, const QIcon& icon,
+                             const FilePath& fp) noexcept;
+  void updateElementListItemToolTip(const QListWidget& listWidget,
+                                    QListWidgetItem&   item) noexcept;
+  template <typename ElementType>
+  QString getElementThumbnailHtml(const FilePath& fp) const noexcept;
   QHash<QListWidgetItem*, FilePath> getElementListItemFilePaths(
       const QList<QListWidgetItem*>& items) const noexcept;
-  void updateElementListFilter(QListWidget& listWidget) noexcept;
+  void updateElementListFilter(QListWidget& listWidget,
+                               bool         onlyVisible = false) noexcept;
   void openContextMenuAtPos(const QPoint& pos) noexcept;
   void newItem(QListWidget* list) noexcept;
   void editItem(QListWidget* list, const FilePath& fp) noexcept;
@@ -142,6 +165,10 @@ private:  // Data
   QSharedPointer<Library>                   mLibrary;
   QByteArray                                mIcon;
   QString                                   mCurrentFilter;
+
+  // Background Checks
+  QHash<FilePath, QFutureWatcher<LibraryElementCheckMessageList>*>
+      mRunningChecks;  ///< pending checks by element directory
 };
 
 /*******************************************************************************
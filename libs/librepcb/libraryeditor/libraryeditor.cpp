@@ -27,6 +27,7 @@
 #include "cmpcat/componentcategoryeditorwidget.h"
 #include "dev/deviceeditorwidget.h"
 #include "lib/libraryoverviewwidget.h"
+#include "libraryelementcache.h"
 #include "pkg/packageeditorwidget.h"
 #include "pkgcat/packagecategoryeditorwidget.h"
 #include "sym/symboleditorwidget.h"
@@ -63,7 +64,8 @@ LibraryEditor::LibraryEditor(workspace::Workspace& ws, const FilePath& libFp,
     mIsOpenedReadOnly(readOnly),
     mUi(new Ui::LibraryEditor),
     mCurrentEditorWidget(nullptr),
-    mLibrary(nullptr) {
+    mLibrary(nullptr),
+    mElementCache(std::make_shared<LibraryElementCache>(ws.getLibraryDb())) {
   mUi->setupUi(this);
   connect(mUi->actionClose, &QAction::triggered, this, &LibraryEditor::close);
   connect(mUi->actionNew, &QAction::triggered, this,
@@ -116,8 +118,14 @@ LibraryEditor::LibraryEditor(workspace::Workspace& ws, const FilePath& libFp,
   connect(mUi->actionAbout_Qt, &QAction::triggered, qApp,
           &QApplication::aboutQt);
 
+  // Referenced elements might have been modified after a library rescan.
+  connect(&mWorkspace.getLibraryDb(),
+          &workspace::WorkspaceLibraryDb::scanFinished, this,
+          [this]() { mElementCache->clear(); });
+
   // add overview tab
-  EditorWidgetBase::Context context{mWorkspace, *this, false, readOnly};
+  EditorWidgetBase::Context context{mWorkspace, *this, false, readOnly,
+                                    mElementCache};
   LibraryOverviewWidget*    overviewWidget =
       new LibraryOverviewWidget(context, libFp);
   mLibrary = &overviewWidget->getLibrary();
@@ -386,7 +394,7 @@ void LibraryEditor::newElementTriggered() noexcept {
   if (wizard.exec() == QDialog::Accepted) {
     FilePath fp = wizard.getContext().getOutputDirectory();
     editNewLibraryElement(wizard.getContext().mElementType, fp);
-    mWorkspace.getLibraryDb().startLibraryRescan();
+    mWorkspace.getLibraryDb().startElementUpdate(fp);
   }
 }
 
@@ -547,7 +555,7 @@ void LibraryEditor::editLibraryElementTriggered(const FilePath& fp,
     }
 
     EditorWidgetBase::Context context{mWorkspace, *this, isNewElement,
-                                      mIsOpenedReadOnly};
+                                      mIsOpenedReadOnly, mElementCache};
     EditWidgetType*           widget = new EditWidgetType(context, fp);
     connect(widget, &QWidget::windowTitleChanged, this,
             &LibraryEditor::updateTabTitles);
@@ -555,7 +563,7 @@ void LibraryEditor::editLibraryElementTriggered(const FilePath& fp,
             &LibraryEditor::updateTabTitles);
     connect(widget, &EditorWidgetBase::elementEdited,
             &mWorkspace.getLibraryDb(),
-            &workspace::WorkspaceLibraryDb::startLibraryRescan);
+            &workspace::WorkspaceLibraryDb::startElementUpdate);
     int index = mUi->tabWidget->addTab(widget, widget->windowIcon(),
                                        widget->windowTitle());
     mUi->tabWidget->setCurrentIndex(index);
@@ -677,7 +685,7 @@ void LibraryEditor::newLibraryElement(
   if (wizard.exec() == QDialog::Accepted) {
     FilePath fp = wizard.getContext().getOutputDirectory();
     editNewLibraryElement(wizard.getContext().mElementType, fp);
-    mWorkspace.getLibraryDb().startLibraryRescan();
+    mWorkspace.getLibraryDb().startElementUpdate(fp);
   }
 }
 
@@ -688,7 +696,7 @@ void LibraryEditor::duplicateLibraryElement(
   if (wizard.exec() == QDialog::Accepted) {
     FilePath fp = wizard.getContext().getOutputDirectory();
     editNewLibraryElement(wizard.getContext().mElementType, fp);
-    mWorkspace.getLibraryDb().startLibraryRescan();
+    mWorkspace.getLibraryDb().startElementUpdate(fp);
   }
 }
 
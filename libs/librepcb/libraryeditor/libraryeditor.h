@@ -55,6 +55,7 @@ class Library;
 namespace editor {
 
 class EditorWidgetBase;
+class LibraryElementCache;
 class LibraryOverviewWidget;
 
 namespace Ui {
@@ -191,6 +192,9 @@ private:  // Data
   QList<GraphicsLayer*>                mLayers;
   EditorWidgetBase*                    mCurrentEditorWidget;
   Library*                             mLibrary;
+
+  /// Referenced library elements, reloaded after library modifications
+  std::shared_ptr<LibraryElementCache> mElementCache;
 };
 
 /*******************************************************************************
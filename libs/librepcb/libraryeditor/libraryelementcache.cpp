@@ -87,6 +87,19 @@ std::shared_ptr<const Device> LibraryElementCache::getDevice(
                     uuid);
 }
 
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void LibraryElementCache::clear() noexcept {
+  mCmpCat.clear();
+  mPkgCat.clear();
+  mSym.clear();
+  mPkg.clear();
+  mCmp.clear();
+  mDev.clear();
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
@@ -79,6 +79,16 @@ public:
       noexcept;
   std::shared_ptr<const Device> getDevice(const Uuid& uuid) const noexcept;
 
+  // General Methods
+
+  /**
+   * @brief Forget all cached elements (e.g. after they were modified)
+   *
+   * Elements still referenced by the callers are kept alive, but subsequent
+   * calls of the getters load them again.
+   */
+  void clear() noexcept;
+
   // Operator Overloadings
   LibraryElementCache& operator=(const LibraryElementCache& rhs) = delete;
 
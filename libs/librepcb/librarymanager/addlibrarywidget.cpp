@@ -62,6 +62,17 @@ AddLibraryWidget::AddLibraryWidget(workspace::Workspace& ws) noexcept
   connect(mUi->btnRepoLibsDownload, &QPushButton::clicked, this,
           &AddLibraryWidget::downloadLibrariesFromRepositoryButtonClicked);
 
+  // tab "repository": populate the list in small chunks to keep the UI
+  // responsive, and load icons only for libraries scrolled into view
+  mAddPendingLibrariesTimer.setSingleShot(true);
+  mAddPendingLibrariesTimer.setInterval(0);
+  connect(&mAddPendingLibrariesTimer, &QTimer::timeout, this,
+          &AddLibraryWidget::addPendingRepositoryLibraries);
+  connect(mUi->lstRepoLibs->verticalScrollBar(), &QScrollBar::valueChanged,
+          this, &AddLibraryWidget::loadVisibleRepositoryLibraryIcons);
+  connect(mUi->lstRepoLibs->verticalScrollBar(), &QScrollBar::rangeChanged,
+          this, &AddLibraryWidget::loadVisibleRepositoryLibraryIcons);
+
   // tab "create local library": set placeholder texts
   mUi->edtLocalName->setPlaceholderText("My Library");
   mUi->edtLocalAuthor->setPlaceholderText(
@@ -352,16 +363,57 @@ void AddLibraryWidget::downloadZipFinished(bool           success,
 void AddLibraryWidget::repositoryLibraryListReceived(
     const QJsonArray& libs) noexcept {
   foreach (const QJsonValue& libVal, libs) {
-    RepositoryLibraryListWidgetItem* widget =
-        new RepositoryLibraryListWidgetItem(mWorkspace, libVal.toObject());
-    widget->setChecked(mUi->cbxRepoLibsSelectAll->isChecked());
-    connect(mUi->cbxRepoLibsSelectAll, &QCheckBox::clicked, widget,
-            &RepositoryLibraryListWidgetItem::setChecked);
-    connect(widget, &RepositoryLibraryListWidgetItem::checkedChanged, this,
-            &AddLibraryWidget::repoLibraryDownloadCheckedChanged);
-    QListWidgetItem* item = new QListWidgetItem(mUi->lstRepoLibs);
-    item->setSizeHint(widget->sizeHint());
-    mUi->lstRepoLibs->setItemWidget(item, widget);
+    mPendingRepositoryLibraries.append(libVal.toObject());
+  }
+  mAddPendingLibrariesTimer.start();
+}
+
+void AddLibraryWidget::addPendingRepositoryLibraries() noexcept {
+  // Creating the item widgets is quite expensive, so only a few of them are
+  // created per event loop iteration.
+  for (int i = 0; (i < 20) && (!mPendingRepositoryLibraries.isEmpty()); ++i) {
+    addRepositoryLibrary(mPendingRepositoryLibraries.takeFirst());
+  }
+  if (!mPendingRepositoryLibraries.isEmpty()) {
+    mAddPendingLibrariesTimer.start();
+  }
+  loadVisibleRepositoryLibraryIcons();
+}
+
+void AddLibraryWidget::addAllPendingRepositoryLibraries() noexcept {
+  mAddPendingLibrariesTimer.stop();
+  while (!mPendingRepositoryLibraries.isEmpty()) {
+    addRepositoryLibrary(mPendingRepositoryLibraries.takeFirst());
+  }
+  loadVisibleRepositoryLibraryIcons();
+}
+
+void AddLibraryWidget::addRepositoryLibrary(const QJsonObject& obj) noexcept {
+  RepositoryLibraryListWidgetItem* widget =
+      new RepositoryLibraryListWidgetItem(mWorkspace, obj);
+  widget->setChecked(mUi->cbxRepoLibsSelectAll->isChecked());
+  connect(mUi->cbxRepoLibsSelectAll, &QCheckBox::clicked, widget,
+          &RepositoryLibraryListWidgetItem::setChecked);
+  connect(widget, &RepositoryLibraryListWidgetItem::checkedChanged, this,
+          &AddLibraryWidget::repoLibraryDownloadCheckedChanged);
+  QListWidgetItem* item = new QListWidgetItem(mUi->lstRepoLibs);
+  item->setSizeHint(widget->sizeHint());
+  mUi->lstRepoLibs->setItemWidget(item, widget);
+}
+
+void AddLibraryWidget::loadVisibleRepositoryLibraryIcons() noexcept {
+  QListWidget*     list   = mUi->lstRepoLibs;
+  int              height = list->viewport()->height();
+  QListWidgetItem* first  = list->itemAt(0, 0);
+  QListWidgetItem* last   = list->itemAt(0, height - 1);
+  int              begin  = first ? list->row(first) : 0;
+  int              end    = last ? list->row(last) : (list->count() - 1);
+  for (int i = begin; i <= end; ++i) {
+    auto* widget = dynamic_cast<RepositoryLibraryListWidgetItem*>(
+        list->itemWidget(list->item(i)));
+    if (widget) {
+      widget->loadIcon();
+    }
   }
 }
 
@@ -374,6 +426,8 @@ void AddLibraryWidget::errorWhileFetchingLibraryList(
 
 void AddLibraryWidget::clearRepositoryLibraryList() noexcept {
   mRepositories.clear();  // disconnects all signal/slot connections
+  mPendingRepositoryLibraries.clear();
+  mAddPendingLibrariesTimer.stop();
   for (int i = mUi->lstRepoLibs->count() - 1; i >= 0; i--) {
     QListWidgetItem* item = mUi->lstRepoLibs->item(i);
     Q_ASSERT(item);
@@ -385,6 +439,9 @@ void AddLibraryWidget::clearRepositoryLibraryList() noexcept {
 
 void AddLibraryWidget::repoLibraryDownloadCheckedChanged(
     bool checked) noexcept {
+  // dependencies may be contained in libraries not added to the list yet
+  addAllPendingRepositoryLibraries();
+
   if (checked) {
     // one more library is checked, check all dependencies too
     QSet<Uuid> libs;
@@ -432,6 +489,7 @@ void AddLibraryWidget::repoLibraryDownloadCheckedChanged(
 }
 
 void AddLibraryWidget::downloadLibrariesFromRepositoryButtonClicked() noexcept {
+  addAllPendingRepositoryLibraries();
   for (int i = 0; i < mUi->lstRepoLibs->count(); i++) {
     QListWidgetItem* item = mUi->lstRepoLibs->item(i);
     Q_ASSERT(item);
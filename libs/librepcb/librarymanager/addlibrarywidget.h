@@ -84,6 +84,10 @@ private:  // Methods
   void downloadZippedLibraryButtonClicked() noexcept;
   void downloadZipFinished(bool success, const QString& errMsg) noexcept;
   void repositoryLibraryListReceived(const QJsonArray& libs) noexcept;
+  void addPendingRepositoryLibraries() noexcept;
+  void addAllPendingRepositoryLibraries() noexcept;
+  void addRepositoryLibrary(const QJsonObject& obj) noexcept;
+  void loadVisibleRepositoryLibraryIcons() noexcept;
   void errorWhileFetchingLibraryList(const QString& errorMsg) noexcept;
   void clearRepositoryLibraryList() noexcept;
   void repoLibraryDownloadCheckedChanged(bool checked) noexcept;
@@ -97,6 +101,8 @@ private:  // Data
   QScopedPointer<Ui::AddLibraryWidget> mUi;
   QScopedPointer<LibraryDownload>      mManualLibraryDownload;
   QList<std::shared_ptr<Repository>>   mRepositories;
+  QList<QJsonObject>                   mPendingRepositoryLibraries;
+  QTimer                               mAddPendingLibrariesTimer;
 };
 
 /*******************************************************************************
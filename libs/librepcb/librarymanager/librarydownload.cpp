@@ -47,6 +47,7 @@ LibraryDownload::LibraryDownload(const QUrl&     urlToZip,
   mFileDownload.reset(
       new FileDownload(urlToZip, FilePath(mDestDir.toStr() % ".zip")));
   mFileDownload->setZipExtractionDirectory(mTempDestDir);
+  mFileDownload->setPriority(QNetworkRequest::LowPriority);  // bulk download
   connect(mFileDownload.data(), &FileDownload::progressState, this,
           &LibraryDownload::progressState, Qt::QueuedConnection);
   connect(mFileDownload.data(), &FileDownload::progressPercent, this,
@@ -140,6 +141,11 @@ void LibraryDownload::downloadSucceeded() noexcept {
     return;
   }
 
+  // keep the modification times of unchanged files to avoid a full rescan
+  if (mDestDir.isExistingDir()) {
+    preserveUnchangedFileTimes(libDir, mDestDir);
+  }
+
   // back-up existing library (if any)
   FilePath backupDir = FilePath(mDestDir.toStr() % ".backup");
   try {
@@ -179,6 +185,45 @@ void LibraryDownload::downloadSucceeded() noexcept {
   emit finished(true, QString());
 }
 
+void LibraryDownload::preserveUnchangedFileTimes(
+    const FilePath& newDir, const FilePath& oldDir) noexcept {
+  // The extracted files all get the current time as modification time, thus
+  // the workspace library scanner would consider every element as modified
+  // and parse all of them again. By restoring the modification time of files
+  // whose content didn't change, only the elements which were really modified
+  // get updated in the library database.
+#if (QT_VERSION >= QT_VERSION_CHECK(5, 10, 0))
+  int          unchangedCount = 0;
+  QDir         qdir(newDir.toStr());
+  QDirIterator it(newDir.toStr(), QDir::Files | QDir::Hidden,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    QString   relPath = qdir.relativeFilePath(it.filePath());
+    QFileInfo oldInfo(oldDir.getPathTo(relPath).toStr());
+    if ((!oldInfo.isFile()) || (oldInfo.size() != it.fileInfo().size())) {
+      continue;
+    }
+    QFile newFile(it.filePath());
+    QFile oldFile(oldInfo.filePath());
+    if ((!newFile.open(QIODevice::ReadWrite)) ||
+        (!oldFile.open(QIODevice::ReadOnly))) {
+      continue;
+    }
+    if (newFile.readAll() == oldFile.readAll()) {
+      if (newFile.setFileTime(oldInfo.lastModified(),
+                              QFileDevice::FileModificationTime)) {
+        ++unchangedCount;
+      }
+    }
+  }
+  qDebug() << "Unchanged files in downloaded library:" << unchangedCount;
+#else
+  Q_UNUSED(newDir);
+  Q_UNUSED(oldDir);
+#endif
+}
+
 FilePath LibraryDownload::getPathToLibDir() noexcept {
   if (library::Library::isValidElementDirectory<library::Library>(
           mTempDestDir)) {
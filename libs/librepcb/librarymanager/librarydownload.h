@@ -93,10 +93,12 @@ signals:
   void abortRequested();  // internal signal!
 
 private:  // Methods
-  void     downloadErrored(const QString& errMsg) noexcept;
-  void     downloadAborted() noexcept;
-  void     downloadSucceeded() noexcept;
-  FilePath getPathToLibDir() noexcept;
+  void        downloadErrored(const QString& errMsg) noexcept;
+  void        downloadAborted() noexcept;
+  void        downloadSucceeded() noexcept;
+  FilePath    getPathToLibDir() noexcept;
+  static void preserveUnchangedFileTimes(const FilePath& newDir,
+                                         const FilePath& oldDir) noexcept;
 
 private:  // Data
   QScopedPointer<FileDownload> mFileDownload;
@@ -49,6 +49,7 @@ RepositoryLibraryListWidgetItem::RepositoryLibraryListWidgetItem(
   : QWidget(nullptr),
     mWorkspace(ws),
     mJsonObject(obj),
+    mIconRequested(false),
     mUi(new Ui::RepositoryLibraryListWidgetItem) {
   mUi->setupUi(this);
   mUi->lblIcon->setText("");
@@ -63,8 +64,8 @@ RepositoryLibraryListWidgetItem::RepositoryLibraryListWidgetItem(
       mJsonObject.value("name").toObject().value("default").toString();
   QString desc =
       mJsonObject.value("description").toObject().value("default").toString();
-  QString author  = mJsonObject.value("author").toString();
-  QUrl    iconUrl = QUrl(mJsonObject.value("icon_url").toString());
+  QString author = mJsonObject.value("author").toString();
+  mIconUrl       = QUrl(mJsonObject.value("icon_url").toString());
   foreach (const QJsonValue& value,
            mJsonObject.value("dependencies").toArray()) {
     tl::optional<Uuid> uuid = Uuid::tryFromString(value.toString());
@@ -80,11 +81,6 @@ RepositoryLibraryListWidgetItem::RepositoryLibraryListWidgetItem(
   mUi->lblDescription->setText(desc);
   mUi->lblAuthor->setText(QString("Author: %1").arg(author));
 
-  NetworkRequest* request = new NetworkRequest(iconUrl);
-  connect(request, &NetworkRequest::dataReceived, this,
-          &RepositoryLibraryListWidgetItem::iconReceived, Qt::QueuedConnection);
-  request->start();
-
   // check if this library is already installed
   updateInstalledStatus();
   connect(&mWorkspace.getLibraryDb(),
@@ -115,6 +111,21 @@ void RepositoryLibraryListWidgetItem::setChecked(bool checked) noexcept {
  *  General Methods
  ******************************************************************************/
 
+void RepositoryLibraryListWidgetItem::loadIcon() noexcept {
+  if (mIconRequested || (!mIconUrl.isValid())) {
+    return;
+  }
+  mIconRequested = true;
+
+  // Icons of released library versions are not expected to change, so don't
+  // even revalidate them if they are in the cache already.
+  NetworkRequest* request = new NetworkRequest(mIconUrl);
+  request->setCacheLoadControl(QNetworkRequest::PreferCache);
+  connect(request, &NetworkRequest::dataReceived, this,
+          &RepositoryLibraryListWidgetItem::iconReceived, Qt::QueuedConnection);
+  request->start();
+}
+
 void RepositoryLibraryListWidgetItem::startDownloadIfSelected() noexcept {
   if (mUuid && mUi->cbxDownload->isVisible() && mUi->cbxDownload->isChecked() &&
       (!mLibraryDownload)) {
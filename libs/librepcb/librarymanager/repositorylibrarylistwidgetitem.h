@@ -77,6 +77,7 @@ public:
   void setChecked(bool checked) noexcept;
 
   // General Methods
+  void loadIcon() noexcept;
   void startDownloadIfSelected() noexcept;
 
   // Operator Overloadings
@@ -98,6 +99,8 @@ private:  // Data
   tl::optional<Version>                               mVersion;
   bool                                                mIsRecommended;
   QSet<Uuid>                                          mDependencies;
+  QUrl                                                mIconUrl;
+  bool                                                mIconRequested;
   QScopedPointer<Ui::RepositoryLibraryListWidgetItem> mUi;
   QScopedPointer<LibraryDownload>                     mLibraryDownload;
 };
@@ -28,10 +28,16 @@
 #include "../erc/ercmsg.h"
 #include "../project.h"
 #include "boardairwiresbuilder.h"
+#include "boardconnectivitygraph.h"
+#include "boardcopperpathcache.h"
 #include "boardfabricationoutputsettings.h"
 #include "boardlayerstack.h"
+#include "boardoutlineareacache.h"
+#include "boardplanefragmentsbuilder.h"
+#include "boardplanesrebuilder.h"
 #include "boardselectionquery.h"
 #include "boardusersettings.h"
+#include "graphicsitems/bgi_airwires.h"
 #include "items/bi_airwire.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
@@ -54,6 +60,9 @@
 #include <librepcb/common/gridproperties.h>
 #include <librepcb/common/scopeguardlist.h>
 #include <librepcb/common/toolbox.h>
+#include <librepcb/common/tracer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/taskscheduler.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/pkg/footprint.h>
 
@@ -74,11 +83,20 @@ namespace project {
 
 Board::Board(const Board&                            other,
              std::unique_ptr<TransactionalDirectory> directory,
-             const ElementName&                      name)
+             const ElementName&                      name,
+             bool                                    graphicsItems)
   : QObject(&other.getProject()),
     mProject(other.getProject()),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mGraphicsItemsEnabled(other.mGraphicsItemsEnabled && graphicsItems),
+    mHasGraphicsItems(false),
+    mIsFullyLoaded(other.mIsFullyLoaded),
+    mCopperPathCache(new BoardCopperPathCache(*this)),
+    mOutlineAreaCache(new BoardOutlineAreaCache(*this)),
+    mPlanesRebuilder(new BoardPlanesRebuilder(*this)),
+    mAirWiresRebuildCount(0),
+    mLastAirWiresRebuildDurationMs(0),
     mUuid(Uuid::createRandom()),
     mName(name),
     mDefaultFontFileName(other.mDefaultFontFileName) {
@@ -117,6 +135,7 @@ Board::Board(const Board&                            other,
           new BI_NetSegment(*this, *netsegment, copiedDeviceInstances);
       Q_ASSERT(!getNetSegmentByUuid(copy->getUuid()));
       mNetSegments.append(copy);
+      mNetSegmentsByUuid.insert(copy->getUuid(), copy);
     }
 
     // copy planes
@@ -153,9 +172,11 @@ Board::Board(const Board&                            other,
             &Board::attributesChanged);
 
     connect(&mProject.getCircuit(), &Circuit::componentAdded, this,
-            &Board::updateErcMessages);
+            &Board::updateErcMessagesOfComponent);
     connect(&mProject.getCircuit(), &Circuit::componentRemoved, this,
-            &Board::updateErcMessages);
+            [this](const ComponentInstance& cmp) {
+              delete mErcMsgListUnplacedComponentInstances.take(cmp.getUuid());
+            });
   } catch (...) {
     // free the allocated memory in the reverse order of their allocation...
     qDeleteAll(mErcMsgListUnplacedComponentInstances);
@@ -172,6 +193,7 @@ Board::Board(const Board&                            other,
     mPlanes.clear();
     qDeleteAll(mNetSegments);
     mNetSegments.clear();
+    mNetSegmentsByUuid.clear();
     qDeleteAll(mDeviceInstances);
     mDeviceInstances.clear();
     mUserSettings.reset();
@@ -186,11 +208,19 @@ Board::Board(const Board&                            other,
 
 Board::Board(Project&                                project,
              std::unique_ptr<TransactionalDirectory> directory, bool create,
-             const QString& newName)
+             const QString& newName, const SExpression& root)
   : QObject(&project),
     mProject(project),
     mDirectory(std::move(directory)),
     mIsAddedToProject(false),
+    mGraphicsItemsEnabled(!project.isHeadless()),
+    mHasGraphicsItems(false),
+    mIsFullyLoaded(create),
+    mCopperPathCache(new BoardCopperPathCache(*this)),
+    mOutlineAreaCache(new BoardOutlineAreaCache(*this)),
+    mPlanesRebuilder(new BoardPlanesRebuilder(*this)),
+    mAirWiresRebuildCount(0),
+    mLastAirWiresRebuildDurationMs(0),
     mUuid(Uuid::createRandom()),
     mName("New Board") {
   try {
@@ -227,9 +257,6 @@ Board::Board(Project&                                project,
                       Path::rect(Point(0, 0), Point(100000000, 80000000)));
       mPolygons.append(new BI_Polygon(*this, polygon));
     } else {
-      SExpression root = SExpression::parse(
-          mDirectory->read(getFilePath().getFilename()), getFilePath());
-
       // the board seems to be ready to open, so we will create all needed
       // objects
 
@@ -297,6 +324,7 @@ Board::Board(Project&                                project,
                   .arg(netsegment->getUuid().toStr()));
         }
         mNetSegments.append(netsegment);
+        mNetSegmentsByUuid.insert(netsegment->getUuid(), netsegment);
       }
 
       // Load all planes
@@ -324,7 +352,8 @@ Board::Board(Project&                                project,
       }
     }
 
-    rebuildAllPlanes();
+    // Outdated planes are rebuilt when the board is needed, see
+    // finishLoading().
     updateErcMessages();
     updateIcon();
 
@@ -333,9 +362,11 @@ Board::Board(Project&                                project,
             &Board::attributesChanged);
 
     connect(&mProject.getCircuit(), &Circuit::componentAdded, this,
-            &Board::updateErcMessages);
+            &Board::updateErcMessagesOfComponent);
     connect(&mProject.getCircuit(), &Circuit::componentRemoved, this,
-            &Board::updateErcMessages);
+            [this](const ComponentInstance& cmp) {
+              delete mErcMsgListUnplacedComponentInstances.take(cmp.getUuid());
+            });
   } catch (...) {
     // free the allocated memory in the reverse order of their allocation...
     qDeleteAll(mErcMsgListUnplacedComponentInstances);
@@ -352,6 +383,7 @@ Board::Board(Project&                                project,
     mPlanes.clear();
     qDeleteAll(mNetSegments);
     mNetSegments.clear();
+    mNetSegmentsByUuid.clear();
     qDeleteAll(mDeviceInstances);
     mDeviceInstances.clear();
     mUserSettings.reset();
@@ -367,10 +399,15 @@ Board::Board(Project&                                project,
 Board::~Board() noexcept {
   Q_ASSERT(!mIsAddedToProject);
 
+  // must be stopped before the planes are deleted
+  mPlanesRebuilder.reset();
+
   qDeleteAll(mErcMsgListUnplacedComponentInstances);
   mErcMsgListUnplacedComponentInstances.clear();
 
   // delete all items
+  qDeleteAll(mAirWiresGraphicsItems);
+  mAirWiresGraphicsItems.clear();
   qDeleteAll(mAirWires);
   mAirWires.clear();
   qDeleteAll(mHoles);
@@ -383,9 +420,12 @@ Board::~Board() noexcept {
   mPlanes.clear();
   qDeleteAll(mNetSegments);
   mNetSegments.clear();
+  mNetSegmentsByUuid.clear();
   qDeleteAll(mDeviceInstances);
   mDeviceInstances.clear();
 
+  mOutlineAreaCache.reset();
+  mCopperPathCache.reset();
   mUserSettings.reset();
   mFabricationOutputSettings.reset();
   mDesignRules.reset();
@@ -410,6 +450,10 @@ bool Board::isEmpty() const noexcept {
 
 QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
   QPointF scenePosPx = pos.toPxQPointF();
+  // Use the spatial index to avoid calculating the (expensive) grab areas of
+  // all items of the board.
+  QSet<BI_Base*> candidates =
+      getItemsFromSceneIndex(pos, UnsignedLength(0)).toSet();
   QList<BI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
@@ -427,7 +471,7 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
   // footprints & pads
   foreach (BI_Device* device, mDeviceInstances) {
     BI_Footprint& footprint = device->getFootprint();
-    if (footprint.isSelectable() &&
+    if (candidates.contains(&footprint) && footprint.isSelectable() &&
         footprint.getGrabAreaScenePx().contains(scenePosPx)) {
       if (footprint.getIsMirrored()) {
         list.append(&footprint);
@@ -436,7 +480,7 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
       }
     }
     foreach (BI_FootprintPad* pad, footprint.getPads()) {
-      if (pad->isSelectable() &&
+      if (candidates.contains(pad) && pad->isSelectable() &&
           pad->getGrabAreaScenePx().contains(scenePosPx)) {
         if (pad->getIsMirrored()) {
           list.append(pad);
@@ -446,7 +490,7 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
       }
     }
     foreach (BI_StrokeText* text, device->getFootprint().getStrokeTexts()) {
-      if (text->isSelectable() &&
+      if (candidates.contains(text) && text->isSelectable() &&
           text->getGrabAreaScenePx().contains(scenePosPx)) {
         if (GraphicsLayer::isTopLayer(*text->getText().getLayerName())) {
           list.prepend(text);
@@ -458,28 +502,28 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
   }
   // planes
   foreach (BI_Plane* planes, mPlanes) {
-    if (planes->isSelectable() &&
+    if (candidates.contains(planes) && planes->isSelectable() &&
         planes->getGrabAreaScenePx().contains(scenePosPx)) {
       list.append(planes);
     }
   }
   // polygons
   foreach (BI_Polygon* polygon, mPolygons) {
-    if (polygon->isSelectable() &&
+    if (candidates.contains(polygon) && polygon->isSelectable() &&
         polygon->getGrabAreaScenePx().contains(scenePosPx)) {
       list.append(polygon);
     }
   }
   // texts
   foreach (BI_StrokeText* text, mStrokeTexts) {
-    if (text->isSelectable() &&
+    if (candidates.contains(text) && text->isSelectable() &&
         text->getGrabAreaScenePx().contains(scenePosPx)) {
       list.append(text);
     }
   }
   // holes
   foreach (BI_Hole* hole, mHoles) {
-    if (hole->isSelectable() &&
+    if (candidates.contains(hole) && hole->isSelectable() &&
         hole->getGrabAreaScenePx().contains(scenePosPx)) {
       list.append(hole);
     }
@@ -490,10 +534,19 @@ QList<BI_Base*> Board::getItemsAtScenePos(const Point& pos) const noexcept {
 QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
                                         const NetSignal* netsignal) const
     noexcept {
+  // The spatial index returns the items in z-order, so it is only used to
+  // filter the items while the list keeps the order of the netsegments.
+  QSet<BI_Base*> candidates =
+      getItemsFromSceneIndex(pos, UnsignedLength(0)).toSet();
   QList<BI_Via*> list;
   foreach (BI_NetSegment* segment, mNetSegments) {
     if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getViasAtScenePos(pos, list);
+      foreach (BI_Via* via, segment->getVias()) {
+        if (candidates.contains(via) && via->isSelectable() &&
+            via->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+          list.append(via);
+        }
+      }
     }
   }
   return list;
@@ -502,10 +555,18 @@ QList<BI_Via*> Board::getViasAtScenePos(const Point&     pos,
 QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QSet<BI_Base*> candidates =
+      getItemsFromSceneIndex(pos, UnsignedLength(0)).toSet();
   QList<BI_NetPoint*> list;
   foreach (BI_NetSegment* segment, mNetSegments) {
     if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetPointsAtScenePos(pos, layer, list);
+      foreach (BI_NetPoint* netpoint, segment->getNetPoints()) {
+        if (candidates.contains(netpoint) && netpoint->isSelectable() &&
+            netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
+            ((!layer) || (netpoint->getLayerOfLines() == layer))) {
+          list.append(netpoint);
+        }
+      }
     }
   }
   return list;
@@ -514,10 +575,18 @@ QList<BI_NetPoint*> Board::getNetPointsAtScenePos(
 QList<BI_NetLine*> Board::getNetLinesAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QSet<BI_Base*> candidates =
+      getItemsFromSceneIndex(pos, UnsignedLength(0)).toSet();
   QList<BI_NetLine*> list;
   foreach (BI_NetSegment* segment, mNetSegments) {
     if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      segment->getNetLinesAtScenePos(pos, layer, list);
+      foreach (BI_NetLine* netline, segment->getNetLines()) {
+        if (candidates.contains(netline) && netline->isSelectable() &&
+            netline->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
+            ((!layer) || (&netline->getLayer() == layer))) {
+          list.append(netline);
+        }
+      }
     }
   }
   return list;
@@ -526,10 +595,12 @@ QList<BI_NetLine*> Board::getNetLinesAtScenePos(
 QList<BI_FootprintPad*> Board::getPadsAtScenePos(
     const Point& pos, const GraphicsLayer* layer,
     const NetSignal* netsignal) const noexcept {
+  QSet<BI_Base*> candidates =
+      getItemsFromSceneIndex(pos, UnsignedLength(0)).toSet();
   QList<BI_FootprintPad*> list;
   foreach (BI_Device* device, mDeviceInstances) {
     foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
-      if (pad->isSelectable() &&
+      if (candidates.contains(pad) && pad->isSelectable() &&
           pad->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
           ((!layer) || (pad->isOnLayer(layer->getName()))) &&
           ((!netsignal) || (pad->getCompSigInstNetSignal() == netsignal))) {
@@ -540,15 +611,32 @@ QList<BI_FootprintPad*> Board::getPadsAtScenePos(
   return list;
 }
 
+QList<BI_Base*> Board::getItemsInSceneRect(const QRectF& rectPx) const
+    noexcept {
+  return getBoardItems(mGraphicsScene->items(
+      rectPx, Qt::IntersectsItemBoundingRect, Qt::DescendingOrder));
+}
+
 BI_NetPoint* Board::getNetPointNextToScenePos(
     const Point& pos, UnsignedLength& maxDistance, const GraphicsLayer* layer,
     const NetSignal* netsignal) const {
-  BI_NetPoint* bestMatch = nullptr;
+  // Iterate in the order of the netsegments (not in z-order) to pick the same
+  // item as before if several items have the same distance.
+  QSet<BI_Base*> candidates = getItemsFromSceneIndex(pos, maxDistance).toSet();
+  BI_NetPoint*   bestMatch  = nullptr;
   foreach (BI_NetSegment* segment, mNetSegments) {
     if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      BI_NetPoint* newMatch =
-          segment->getNetPointNextToScenePos(pos, layer, maxDistance);
-      if (newMatch) bestMatch = newMatch;
+      foreach (BI_NetPoint* netpoint, segment->getNetPoints()) {
+        if (candidates.contains(netpoint) && netpoint->isSelectable() &&
+            ((!layer) || (netpoint->getLayerOfLines() == layer))) {
+          UnsignedLength distance =
+              (netpoint->getPosition() - pos).getLength();
+          if (distance < maxDistance) {
+            bestMatch   = netpoint;
+            maxDistance = distance;
+          }
+        }
+      }
     }
   }
   return bestMatch;
@@ -557,11 +645,22 @@ BI_NetPoint* Board::getNetPointNextToScenePos(
 BI_Via* Board::getViaNextToScenePos(const Point&     pos,
                                     UnsignedLength&  maxDistance,
                                     const NetSignal* netsignal) const {
-  BI_Via* bestMatch = nullptr;
+  QSet<BI_Base*> candidates = getItemsFromSceneIndex(pos, maxDistance).toSet();
+  BI_Via*        bestMatch  = nullptr;
   foreach (BI_NetSegment* segment, mNetSegments) {
     if ((!netsignal) || (&segment->getNetSignal() == netsignal)) {
-      BI_Via* newMatch = segment->getViaNextToScenePos(pos, maxDistance);
-      if (newMatch) bestMatch = newMatch;
+      foreach (BI_Via* via, segment->getVias()) {
+        if (candidates.contains(via) && via->isSelectable()) {
+          // NOTE(5n8ke): maxDistance is depending on the center of the via
+          // and not the actual distance between the position and the edge of
+          // the via
+          UnsignedLength distance = (via->getPosition() - pos).getLength();
+          if (distance < maxDistance) {
+            bestMatch   = via;
+            maxDistance = distance;
+          }
+        }
+      }
     }
   }
   return bestMatch;
@@ -572,8 +671,11 @@ BI_FootprintPad* Board::getPadNextToScenePos(const Point&         pos,
                                              const GraphicsLayer* layer,
                                              const NetSignal* netsignal) const {
   BI_FootprintPad* bestMatch = nullptr;
+  QSet<BI_Base*>   candidates =
+      getItemsFromSceneIndex(pos, maxDistance).toSet();
   foreach (BI_Device* device, mDeviceInstances) {
     foreach (BI_FootprintPad* pad, device->getFootprint().getPads()) {
+      if (!candidates.contains(pad)) continue;
       QPainterPath area = QPainterPath();
       area.addEllipse(pos.toPxQPointF(), maxDistance->toPx(),
                       maxDistance->toPx());
@@ -583,9 +685,9 @@ BI_FootprintPad* Board::getPadNextToScenePos(const Point&         pos,
         UnsignedLength distance = (pad->getPosition() - pos).getLength();
         if (distance < maxDistance) {
           bestMatch = pad;
-          // NOTE(5n8ke): maxDistance is depending on the center of the pad and
-          // not the actual distance between the position and the edge of the
-          // pad
+          // NOTE(5n8ke): maxDistance is depending on the center of the pad
+          // and not the actual distance between the position and the edge of
+          // the pad
           maxDistance = distance;
         }
       }
@@ -645,7 +747,7 @@ void Board::addDeviceInstance(BI_Device& instance) {
   // add to board
   instance.addToBoard();  // can throw
   mDeviceInstances.insert(instance.getComponentInstanceUuid(), &instance);
-  updateErcMessages();
+  updateErcMessagesOfComponent(instance.getComponentInstance());
   emit deviceAdded(instance);
 }
 
@@ -657,7 +759,7 @@ void Board::removeDeviceInstance(BI_Device& instance) {
   // remove from board
   instance.removeFromBoard();  // can throw
   mDeviceInstances.remove(instance.getComponentInstanceUuid());
-  updateErcMessages();
+  updateErcMessagesOfComponent(instance.getComponentInstance());
   emit deviceRemoved(instance);
 }
 
@@ -666,14 +768,12 @@ void Board::removeDeviceInstance(BI_Device& instance) {
  ******************************************************************************/
 
 BI_NetSegment* Board::getNetSegmentByUuid(const Uuid& uuid) const noexcept {
-  foreach (BI_NetSegment* netsegment, mNetSegments) {
-    if (netsegment->getUuid() == uuid) return netsegment;
-  }
-  return nullptr;
+  return mNetSegmentsByUuid.value(uuid, nullptr);
 }
 
 void Board::addNetSegment(BI_NetSegment& netsegment) {
-  if ((!mIsAddedToProject) || (mNetSegments.contains(&netsegment)) ||
+  if ((!mIsAddedToProject) ||
+      (mNetSegmentsByUuid.value(netsegment.getUuid()) == &netsegment) ||
       (&netsegment.getBoard() != this)) {
     throw LogicError(__FILE__, __LINE__);
   }
@@ -687,21 +787,33 @@ void Board::addNetSegment(BI_NetSegment& netsegment) {
   // add to board
   netsegment.addToBoard();  // can throw
   mNetSegments.append(&netsegment);
+  mNetSegmentsByUuid.insert(netsegment.getUuid(), &netsegment);
 }
 
 void Board::removeNetSegment(BI_NetSegment& netsegment) {
-  if ((!mIsAddedToProject) || (!mNetSegments.contains(&netsegment))) {
+  if ((!mIsAddedToProject) ||
+      (mNetSegmentsByUuid.value(netsegment.getUuid()) != &netsegment)) {
     throw LogicError(__FILE__, __LINE__);
   }
   // remove from board
   netsegment.removeFromBoard();  // can throw
   mNetSegments.removeOne(&netsegment);
+  mNetSegmentsByUuid.remove(netsegment.getUuid());
 }
 
 /*******************************************************************************
  *  Plane Methods
  ******************************************************************************/
 
+QList<BI_Plane*> Board::getPlanesSortedByPriority() const noexcept {
+  QList<BI_Plane*> planes = mPlanes;
+  std::sort(planes.begin(), planes.end(),
+            [](const BI_Plane* p1, const BI_Plane* p2) {
+              return !(*p1 < *p2);
+            });  // sort by priority (highest priority first)
+  return planes;
+}
+
 void Board::addPlane(BI_Plane& plane) {
   if ((!mIsAddedToProject) || (mPlanes.contains(&plane)) ||
       (&plane.getBoard() != this)) {
@@ -720,12 +832,95 @@ void Board::removePlane(BI_Plane& plane) {
 }
 
 void Board::rebuildAllPlanes() noexcept {
-  QList<BI_Plane*> planes = mPlanes;
-  std::sort(planes.begin(), planes.end(),
-            [](const BI_Plane* p1, const BI_Plane* p2) {
-              return !(*p1 < *p2);
-            });  // sort by priority (highest priority first)
-  foreach (BI_Plane* plane, planes) { plane->rebuild(); }
+  LIBREPCB_TRACE_SCOPE("board", "Board::rebuildAllPlanes");
+  mPlanesRebuilder->cancel();  // results would be outdated
+
+  // The builders copy the inputs, then all planes are built concurrently.
+  QList<std::shared_ptr<BoardPlaneFragmentsBuilder>> builders;
+  foreach (const BI_Plane* plane, getPlanesSortedByPriority()) {
+    builders.append(std::make_shared<BoardPlaneFragmentsBuilder>(*plane));
+  }
+  QHash<const BI_Plane*, BoardPlaneFragmentsBuilder::Result> results =
+      BoardPlaneFragmentsBuilder::buildAll(builders);
+
+  // Apply the fragments in the main thread since this modifies the planes.
+  foreach (BI_Plane* plane, mPlanes) {
+    BoardPlaneFragmentsBuilder::Result result = results.value(plane);
+    plane->setCalculatedFragments(result.fragments, result.fingerprint,
+                                  result.statistics);
+  }
+  mScheduledAreaForPlanesRebuild = Path();
+}
+
+void Board::rebuildOutdatedPlanes() noexcept {
+  // Rebuilding a plane changes the fingerprints of lower priority planes on
+  // the same layer, so they will be rebuilt as well.
+  foreach (BI_Plane* plane, getPlanesSortedByPriority()) {
+    BoardPlaneFragmentsBuilder builder(*plane);
+    QByteArray                 fingerprint = builder.calcFingerprint();
+    if (fingerprint != plane->getFragmentsFingerprint()) {
+      QVector<Path> fragments = builder.buildFragments();
+      plane->setCalculatedFragments(fragments, fingerprint,
+                                    builder.getStatistics());
+    }
+  }
+  mScheduledAreaForPlanesRebuild = Path();  // all planes are up to date now
+}
+
+void Board::schedulePlanesRebuild(const Path& area) noexcept {
+  schedulePlanesRebuild(QVector<Path>{area});
+}
+
+void Board::schedulePlanesRebuild(const QVector<Path>& areas) noexcept {
+  // While loading, outdated planes are detected by their fingerprints (see
+  // finishLoading()), so there is no need to track modified areas.
+  if ((!mIsAddedToProject) || (!mIsFullyLoaded)) {
+    return;
+  }
+
+  // Only the bounding rectangle of all scheduled areas is relevant for the
+  // incremental rebuild, so merge them into a single rectangle.
+  PositiveLength    tolerance = BoardPlaneFragmentsBuilder::maxArcTolerance();
+  ClipperLib::Paths paths;
+  paths.reserve(areas.count() + 1);
+  foreach (const Path& area, areas) {
+    paths.push_back(ClipperHelpers::convert(area, tolerance));
+  }
+  paths.push_back(
+      ClipperHelpers::convert(mScheduledAreaForPlanesRebuild, tolerance));
+  ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect(paths);
+  if (rect.left <= rect.right) {
+    mScheduledAreaForPlanesRebuild = Path::rect(
+        ClipperHelpers::convert(ClipperLib::IntPoint(rect.left, rect.top)),
+        ClipperHelpers::convert(ClipperLib::IntPoint(rect.right, rect.bottom)));
+    mPlanesRebuilder->scheduleIncremental();
+  }
+}
+
+void Board::triggerPlanesRebuild() noexcept {
+  const Path area = takeScheduledAreaForPlanesRebuild();
+  if (area.getVertices().isEmpty()) {
+    return;
+  }
+  QList<std::shared_ptr<BoardPlaneFragmentsBuilder>> builders;
+  foreach (const BI_Plane* plane, getPlanesSortedByPriority()) {
+    builders.append(std::make_shared<BoardPlaneFragmentsBuilder>(*plane));
+  }
+  QHash<const BI_Plane*, BoardPlaneFragmentsBuilder::Result> results =
+      BoardPlaneFragmentsBuilder::buildAllIncremental(builders, {area});
+  foreach (BI_Plane* plane, mPlanes) {
+    auto it = results.constFind(plane);
+    if (it != results.constEnd()) {
+      plane->setCalculatedFragments(it->fragments, it->fingerprint,
+                                    it->statistics);
+    }
+  }
+}
+
+Path Board::takeScheduledAreaForPlanesRebuild() noexcept {
+  Path area                      = mScheduledAreaForPlanesRebuild;
+  mScheduledAreaForPlanesRebuild = Path();
+  return area;
 }
 
 /*******************************************************************************
@@ -796,50 +991,116 @@ void Board::removeHole(BI_Hole& hole) {
  ******************************************************************************/
 
 void Board::triggerAirWiresRebuild() noexcept {
-  if (!mIsAddedToProject) {
-    return;
+  LIBREPCB_TRACE_SCOPE("board", "Board::triggerAirWiresRebuild");
+  if ((!mIsAddedToProject) || (!mIsFullyLoaded) ||
+      mScheduledNetSignalsForAirWireRebuild.isEmpty()) {
+    return;  // Note: Rebuilt anyway when the board gets fully loaded
   }
+  QElapsedTimer timer;
+  timer.start();
 
   try {
+    // Calculate the new airwires of all net signals in parallel, since there
+    // might be hundreds of them (e.g. after adding all devices). The builders
+    // take a snapshot of the board, so the calculation itself does not access
+    // the board.
+    QHash<NetSignal*, QFuture<QVector<QPair<Point, Point>>>> jobs;
     foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
-      // remove old airwires
-      while (BI_AirWire* airWire = mAirWires.take(netsignal)) {
-        airWire->removeFromBoard();  // can throw
-        delete airWire;
+      if (netsignal && netsignal->isAddedToCircuit()) {
+        std::shared_ptr<BoardAirWiresBuilder> builder(
+            new BoardAirWiresBuilder(*this, *netsignal));
+        // the UI waits for the results, thus run them with priority
+        jobs.insert(netsignal,
+                    TaskScheduler::run(TaskScheduler::Priority::Interactive,
+                                       [builder]() {
+                                         return builder->buildAirWires();
+                                       }));
       }
+    }
 
-      if (netsignal && netsignal->isAddedToCircuit()) {
-        // calculate new airwires
-        BoardAirWiresBuilder         builder(*this, *netsignal);
-        QVector<QPair<Point, Point>> airwires = builder.buildAirWires();
-
-        // add new airwires
-        foreach (const auto& points, airwires) {
-          QScopedPointer<BI_AirWire> airWire(
-              new BI_AirWire(*this, *netsignal, points.first, points.second));
-          airWire->addToBoard();  // can throw
-          mAirWires.insertMulti(netsignal, airWire.take());
+    // update airwires on the board (Note: Waits for each job to finish)
+    foreach (NetSignal* netsignal, mScheduledNetSignalsForAirWireRebuild) {
+      QVector<QPair<Point, Point>> airwires;
+      if (jobs.contains(netsignal)) {
+        airwires = jobs[netsignal].result();
+      }
+
+      // Keep old airwires which are still valid, to avoid recreating them.
+      // Typically most airwires of a net are not affected by a modification,
+      // e.g. when moving a single device.
+      foreach (BI_AirWire* airWire, mAirWires.values(netsignal)) {
+        const Point& p1    = airWire->getP1();
+        const Point& p2    = airWire->getP2();
+        int          index = airwires.indexOf(qMakePair(p1, p2));
+        if (index < 0) {
+          index = airwires.indexOf(qMakePair(p2, p1));
+        }
+        if (index >= 0) {
+          airwires.remove(index);
+        } else {
+          mAirWires.remove(netsignal, airWire);
+          airWire->removeFromBoard();  // can throw
+          delete airWire;
         }
       }
+
+      // add new airwires (the list is empty if the net signal was removed)
+      foreach (const auto& points, airwires) {
+        QScopedPointer<BI_AirWire> airWire(
+            new BI_AirWire(*this, *netsignal, points.first, points.second));
+        airWire->addToBoard();  // can throw
+        mAirWires.insertMulti(netsignal, airWire.take());
+      }
+      updateAirWiresGraphicsItem(netsignal);
     }
     mScheduledNetSignalsForAirWireRebuild.clear();
   } catch (const std::exception&
                e) {  // std::exception because of the many std containers...
     qCritical() << "Failed to build airwires:" << e.what();
   }
+  ++mAirWiresRebuildCount;
+  mLastAirWiresRebuildDurationMs = timer.elapsed();
 }
 
 void Board::forceAirWiresRebuild() noexcept {
   mScheduledNetSignalsForAirWireRebuild.unite(
       Toolbox::toSet(mProject.getCircuit().getNetSignals().values()));
   mScheduledNetSignalsForAirWireRebuild.unite(Toolbox::toSet(mAirWires.keys()));
+  mConnectivityGraphs.clear();
   triggerAirWiresRebuild();
 }
 
+/*******************************************************************************
+ *  Connectivity Methods
+ ******************************************************************************/
+
+std::shared_ptr<const BoardConnectivityGraph> Board::getConnectivityGraph(
+    const NetSignal& netsignal) const noexcept {
+  std::shared_ptr<const BoardConnectivityGraph>& graph =
+      mConnectivityGraphs[&netsignal];
+  if (!graph) {
+    graph = std::make_shared<BoardConnectivityGraph>(*this, netsignal);
+  }
+  return graph;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
+void Board::finishLoading() noexcept {
+  if (mIsFullyLoaded) {
+    return;
+  }
+  LIBREPCB_TRACE_SCOPE("board", "Board::finishLoading");
+  mIsFullyLoaded = true;
+  rebuildOutdatedPlanes();
+  // build all airwires with the next triggerAirWiresRebuild()
+  mScheduledNetSignalsForAirWireRebuild.unite(
+      Toolbox::toSet(mProject.getCircuit().getNetSignals().values()));
+  mConnectivityGraphs.clear();
+}
+
 void Board::addToProject() {
   if (mIsAddedToProject) {
     throw LogicError(__FILE__, __LINE__);
@@ -852,7 +1113,9 @@ void Board::addToProject() {
     sgl.add([item]() { item->removeFromBoard(); });
   }
   mIsAddedToProject = true;
-  forceAirWiresRebuild();
+  if (mIsFullyLoaded) {
+    forceAirWiresRebuild();
+  }
   updateErcMessages();
   sgl.dismiss();
 }
@@ -861,6 +1124,11 @@ void Board::removeFromProject() {
   if (!mIsAddedToProject) {
     throw LogicError(__FILE__, __LINE__);
   }
+  foreach (BGI_AirWires* item, mAirWiresGraphicsItems) {
+    if (item->scene()) {
+      mGraphicsScene->removeItem(*item);
+    }
+  }
   QList<BI_Base*> items = getAllItems();
   ScopeGuardList  sgl(items.count());
   for (int i = items.count() - 1; i >= 0; --i) {
@@ -869,16 +1137,22 @@ void Board::removeFromProject() {
     sgl.add([item]() { item->addToBoard(); });
   }
   mIsAddedToProject = false;
+  mPlanesRebuilder->cancel();
+  mScheduledAreaForPlanesRebuild = Path();
   updateErcMessages();
   sgl.dismiss();
 }
 
-void Board::save() {
+QByteArray Board::serializeToByteArray() const {
+  return serializeToDomElement("librepcb_board").toByteArray();  // can throw
+}
+
+void Board::save(const QByteArray& content) {
   if (mIsAddedToProject) {
     // save board file
-    SExpression brdDoc(serializeToDomElement("librepcb_board"));  // can throw
     mDirectory->write(getFilePath().getFilename(),
-                      brdDoc.toByteArray());  // can throw
+                      content.isNull() ? serializeToByteArray()
+                                       : content);  // can throw
 
     // save user settings
     SExpression usrDoc(mUserSettings->serializeToDomElement(
@@ -889,6 +1163,15 @@ void Board::save() {
   }
 }
 
+std::unique_ptr<Board> Board::createSnapshot() const {
+  // An empty temporary directory, opened read-only.
+  std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory());
+  std::unique_ptr<Board> snapshot(
+      new Board(*this, std::move(dir), mName, false));
+  snapshot->mUuid = mUuid;  // the UUID is part of some exported data
+  return snapshot;
+}
+
 void Board::print(QPrinter& printer) {
   clearSelection();
 
@@ -919,9 +1202,19 @@ void Board::renderToQPainter(QPainter& painter, int dpi) const {
 }
 
 void Board::showInView(GraphicsView& view) noexcept {
+  if (mGraphicsItemsEnabled && (!mHasGraphicsItems)) {
+    createGraphicsItems();
+  }
   view.setScene(mGraphicsScene.data());
 }
 
+void Board::ensureGraphicsItems() noexcept {
+  mGraphicsItemsEnabled = true;
+  if (!mHasGraphicsItems) {
+    createGraphicsItems();
+  }
+}
+
 void Board::selectAll() noexcept {
   foreach (BI_Device* device, mDeviceInstances) {
     device->setSelected(device->isSelectable());
@@ -944,63 +1237,72 @@ void Board::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+    // Only items found in the spatial index can intersect with the rect, so
+    // there's no need to calculate the grab areas of all the other items.
+    QSet<BI_Base*> candidates;
+    foreach (QGraphicsItem* graphicsItem,
+             mGraphicsScene->items(rectPx, Qt::IntersectsItemBoundingRect)) {
+      if (BI_Base* item = BI_Base::fromGraphicsItem(*graphicsItem)) {
+        candidates.insert(item);
+      }
+    }
+    auto isHit = [&](BI_Base& item) {
+      return candidates.contains(&item) && item.isSelectable() &&
+             item.getGrabAreaScenePx().intersects(rectPx);
+    };
+    // Avoid repainting items whose selection state did not change.
+    auto select = [](BI_Base& item, bool selected) {
+      if (item.isSelected() != selected) item.setSelected(selected);
+    };
     foreach (BI_Device* component, mDeviceInstances) {
       BI_Footprint& footprint       = component->getFootprint();
-      bool          selectFootprint = footprint.isSelectable() &&
-                             footprint.getGrabAreaScenePx().intersects(rectPx);
-      footprint.setSelected(selectFootprint);
+      bool          selectFootprint = isHit(footprint);
+      select(footprint, selectFootprint);
       foreach (BI_FootprintPad* pad, footprint.getPads()) {
-        bool selectPad =
-            pad->isSelectable() && pad->getGrabAreaScenePx().intersects(rectPx);
-        pad->setSelected(selectFootprint || selectPad);
+        select(*pad, selectFootprint || isHit(*pad));
       }
       foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
-        bool selectText = text->isSelectable() &&
-                          text->getGrabAreaScenePx().intersects(rectPx);
-        text->setSelected(selectFootprint || selectText);
+        select(*text, selectFootprint || isHit(*text));
       }
     }
     foreach (BI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
-    }
-    foreach (BI_Plane* plane, mPlanes) {
-      bool select = plane->isSelectable() &&
-                    plane->getGrabAreaScenePx().intersects(rectPx);
-      plane->setSelected(select);
+      foreach (BI_Via* via, segment->getVias()) { select(*via, isHit(*via)); }
+      foreach (BI_NetPoint* netpoint, segment->getNetPoints()) {
+        select(*netpoint, isHit(*netpoint));
+      }
+      foreach (BI_NetLine* netline, segment->getNetLines()) {
+        select(*netline, isHit(*netline));
+      }
     }
+    foreach (BI_Plane* plane, mPlanes) { select(*plane, isHit(*plane)); }
     foreach (BI_Polygon* polygon, mPolygons) {
-      bool select = polygon->isSelectable() &&
-                    polygon->getGrabAreaScenePx().intersects(rectPx);
-      polygon->setSelected(select);
+      select(*polygon, isHit(*polygon));
     }
     foreach (BI_StrokeText* text, mStrokeTexts) {
-      bool select =
-          text->isSelectable() && text->getGrabAreaScenePx().intersects(rectPx);
-      text->setSelected(select);
-    }
-    foreach (BI_Hole* hole, mHoles) {
-      bool select =
-          hole->isSelectable() && hole->getGrabAreaScenePx().intersects(rectPx);
-      hole->setSelected(select);
+      select(*text, isHit(*text));
     }
+    foreach (BI_Hole* hole, mHoles) { select(*hole, isHit(*hole)); }
   }
 }
 
 void Board::clearSelection() const noexcept {
-  foreach (BI_Device* device, mDeviceInstances)
-    device->getFootprint().setSelected(false);
-  foreach (BI_NetSegment* segment, mNetSegments) { segment->clearSelection(); }
-  foreach (BI_Plane* plane, mPlanes) { plane->setSelected(false); }
-  foreach (BI_Polygon* polygon, mPolygons) { polygon->setSelected(false); }
-  foreach (BI_StrokeText* text, mStrokeTexts) { text->setSelected(false); }
-  foreach (BI_Hole* hole, mHoles) { hole->setSelected(false); }
+  // Only the selected items need to be visited. Note that foreach() iterates
+  // over a copy of the set, so it's safe that items remove themselves.
+  foreach (BI_Base* item, mSelectedItems) { item->setSelected(false); }
 }
 
 std::unique_ptr<BoardSelectionQuery> Board::createSelectionQuery() const
     noexcept {
-  return std::unique_ptr<BoardSelectionQuery>(new BoardSelectionQuery(
-      mDeviceInstances, mNetSegments, mPlanes, mPolygons, mStrokeTexts, mHoles,
-      const_cast<Board*>(this)));
+  return std::unique_ptr<BoardSelectionQuery>(
+      new BoardSelectionQuery(mSelectedItems, const_cast<Board*>(this)));
+}
+
+void Board::updateSelectedItems(BI_Base& item, bool selected) noexcept {
+  if (selected) {
+    mSelectedItems.insert(&item);
+  } else {
+    mSelectedItems.remove(&item);
+  }
 }
 
 /*******************************************************************************
@@ -1025,9 +1327,31 @@ QVector<const AttributeProvider*> Board::getAttributeProviderParents() const
  ******************************************************************************/
 
 void Board::updateIcon() noexcept {
+  if (!mHasGraphicsItems) {
+    return;  // nothing to render
+  }
   mIcon = QIcon(mGraphicsScene->toPixmap(QSize(297, 210), Qt::white));
 }
 
+void Board::createGraphicsItems() noexcept {
+  // items created from now on will create their graphics items on their own
+  mHasGraphicsItems = true;
+  foreach (BI_Device* device, mDeviceInstances) {
+    device->createGraphicsItems();
+  }
+  foreach (BI_NetSegment* segment, mNetSegments) {
+    segment->createGraphicsItems();
+  }
+  foreach (BI_Plane* plane, mPlanes) { plane->createGraphicsItems(); }
+  foreach (BI_Polygon* polygon, mPolygons) { polygon->createGraphicsItems(); }
+  foreach (BI_StrokeText* text, mStrokeTexts) { text->createGraphicsItems(); }
+  foreach (BI_Hole* hole, mHoles) { hole->createGraphicsItems(); }
+  foreach (NetSignal* netsignal, Toolbox::toSet(mAirWires.keys())) {
+    updateAirWiresGraphicsItem(netsignal);
+  }
+  updateIcon();
+}
+
 void Board::serialize(SExpression& root) const {
   root.appendChild(mUuid);
   root.appendChild("name", mName, true);
@@ -1059,23 +1383,7 @@ void Board::updateErcMessages() noexcept {
     const QMap<Uuid, ComponentInstance*>& componentInstances =
         mProject.getCircuit().getComponentInstances();
     foreach (const ComponentInstance* component, componentInstances) {
-      if (component->getLibComponent().isSchematicOnly()) continue;
-      BI_Device* device = mDeviceInstances.value(component->getUuid());
-      ErcMsg*    ercMsg =
-          mErcMsgListUnplacedComponentInstances.value(component->getUuid());
-      if ((!device) && (!ercMsg)) {
-        ErcMsg* ercMsg = new ErcMsg(
-            mProject, *this,
-            QString("%1/%2").arg(mUuid.toStr(), component->getUuid().toStr()),
-            "UnplacedComponent", ErcMsg::ErcMsgType_t::BoardError,
-            QString("Unplaced Component: %1 (Board: %2)")
-                .arg(*component->getName(), *mName));
-        ercMsg->setVisible(true);
-        mErcMsgListUnplacedComponentInstances.insert(component->getUuid(),
-                                                     ercMsg);
-      } else if ((device) && (ercMsg)) {
-        delete mErcMsgListUnplacedComponentInstances.take(component->getUuid());
-      }
+      updateErcMessagesOfComponent(*component);
     }
     foreach (const Uuid& uuid, mErcMsgListUnplacedComponentInstances.keys()) {
       if (!componentInstances.contains(uuid))
@@ -1087,6 +1395,74 @@ void Board::updateErcMessages() noexcept {
   }
 }
 
+void Board::updateErcMessagesOfComponent(
+    const ComponentInstance& cmp) noexcept {
+  // type: UnplacedComponent (ComponentInstance without DeviceInstance)
+  if ((!mIsAddedToProject) || cmp.getLibComponent().isSchematicOnly()) {
+    return;
+  }
+  const Uuid& uuid   = cmp.getUuid();
+  BI_Device*  device = mDeviceInstances.value(uuid);
+  ErcMsg*     ercMsg = mErcMsgListUnplacedComponentInstances.value(uuid);
+  if ((!device) && (!ercMsg)) {
+    ercMsg = new ErcMsg(mProject, *this,
+                        QString("%1/%2").arg(mUuid.toStr(), uuid.toStr()),
+                        "UnplacedComponent", ErcMsg::ErcMsgType_t::BoardError,
+                        QString("Unplaced Component: %1 (Board: %2)")
+                            .arg(*cmp.getName(), *mName));
+    ercMsg->setVisible(true);
+    mErcMsgListUnplacedComponentInstances.insert(uuid, ercMsg);
+  } else if ((device) && (ercMsg)) {
+    delete mErcMsgListUnplacedComponentInstances.take(uuid);
+  }
+}
+
+void Board::updateAirWiresGraphicsItem(NetSignal* netsignal) noexcept {
+  if (!mHasGraphicsItems) {
+    return;
+  }
+  QList<BI_AirWire*> airWires = mAirWires.values(netsignal);
+  BGI_AirWires*      item     = mAirWiresGraphicsItems.value(netsignal);
+  if (airWires.isEmpty()) {
+    delete mAirWiresGraphicsItems.take(netsignal);  // removes it from scene
+    return;
+  }
+  if (!item) {
+    item = new BGI_AirWires(*this, *netsignal);
+    mAirWiresGraphicsItems.insert(netsignal, item);
+  }
+  item->setAirWires(airWires);
+  if (mIsAddedToProject && (!item->scene())) {
+    mGraphicsScene->addItem(*item);
+  }
+}
+
+QList<BI_Base*> Board::getItemsFromSceneIndex(
+    const Point& pos, const UnsignedLength& maxDistance) const noexcept {
+  if (maxDistance > 0) {
+    qreal  radius = maxDistance->toPx();
+    QRectF rect(pos.toPxQPointF() - QPointF(radius, radius),
+                QSizeF(2 * radius, 2 * radius));
+    return getItemsInSceneRect(rect);
+  } else {
+    return getBoardItems(mGraphicsScene->items(pos.toPxQPointF(),
+                                               Qt::IntersectsItemBoundingRect,
+                                               Qt::DescendingOrder));
+  }
+}
+
+QList<BI_Base*> Board::getBoardItems(
+    const QList<QGraphicsItem*>& graphicsItems) const noexcept {
+  QList<BI_Base*> items;
+  foreach (QGraphicsItem* graphicsItem, graphicsItems) {
+    BI_Base* item = BI_Base::fromGraphicsItem(*graphicsItem);
+    if (item && (&item->getBoard() == this)) {
+      items.append(item);
+    }
+  }
+  return items;
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -1094,7 +1470,8 @@ void Board::updateErcMessages() noexcept {
 Board* Board::create(Project&                                project,
                      std::unique_ptr<TransactionalDirectory> directory,
                      const ElementName&                      name) {
-  return new Board(project, std::move(directory), true, *name);
+  return new Board(project, std::move(directory), true, *name,
+                   SExpression());
 }
 
 /*******************************************************************************
@@ -31,6 +31,7 @@
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/fileio/transactionaldirectory.h>
+#include <librepcb/common/geometry/path.h>
 #include <librepcb/common/units/all_length_units.h>
 #include <librepcb/common/uuid.h>
 
@@ -55,6 +56,7 @@ namespace project {
 
 class NetSignal;
 class Project;
+class ComponentInstance;
 class BI_Device;
 class BI_Base;
 class BI_FootprintPad;
@@ -67,7 +69,12 @@ class BI_StrokeText;
 class BI_Hole;
 class BI_Plane;
 class BI_AirWire;
+class BGI_AirWires;
 class BoardLayerStack;
+class BoardConnectivityGraph;
+class BoardCopperPathCache;
+class BoardOutlineAreaCache;
+class BoardPlanesRebuilder;
 class BoardFabricationOutputSettings;
 class BoardUserSettings;
 class BoardSelectionQuery;
@@ -123,9 +130,10 @@ public:
   Board()                   = delete;
   Board(const Board& other) = delete;
   Board(const Board& other, std::unique_ptr<TransactionalDirectory> directory,
-        const ElementName& name);
-  Board(Project& project, std::unique_ptr<TransactionalDirectory> directory)
-    : Board(project, std::move(directory), false, QString()) {}
+        const ElementName& name, bool graphicsItems = true);
+  Board(Project& project, std::unique_ptr<TransactionalDirectory> directory,
+        const SExpression& root)
+    : Board(project, std::move(directory), false, QString(), root) {}
   ~Board() noexcept;
 
   // Getters: General
@@ -135,6 +143,31 @@ public:
     return *mGridProperties;
   }
   GraphicsScene&   getGraphicsScene() const noexcept { return *mGraphicsScene; }
+
+  /**
+   * @brief Check whether the items of this board have graphics items
+   *
+   * Graphics items are created lazily when the board is shown the first time
+   * (see #showInView()), so boards which are never opened in an editor don't
+   * pay for them. They are never created for headless projects (see
+   * librepcb::project::Project::isHeadless()) and for snapshots (see
+   * #createSnapshot()). Items must check this before creating their graphics
+   * items.
+   *
+   * @return Whether graphics items are created or not
+   */
+  bool hasGraphicsItems() const noexcept { return mHasGraphicsItems; }
+
+  /**
+   * @brief Check whether the deferred parts of this board are loaded
+   *
+   * Boards loaded from files skip rebuilding outdated plane fragments and
+   * airwires until they are needed (see #finishLoading()), since projects
+   * often contain several board variants of which only one is used.
+   *
+   * @return Whether #finishLoading() was called (always true for new boards)
+   */
+  bool isFullyLoaded() const noexcept { return mIsFullyLoaded; }
   BoardLayerStack& getLayerStack() noexcept { return *mLayerStack; }
   const BoardLayerStack& getLayerStack() const noexcept { return *mLayerStack; }
   BoardDesignRules&      getDesignRules() noexcept { return *mDesignRules; }
@@ -148,6 +181,20 @@ public:
       noexcept {
     return *mFabricationOutputSettings;
   }
+  BoardCopperPathCache& getCopperPathCache() const noexcept {
+    return *mCopperPathCache;
+  }
+  const std::shared_ptr<BoardCopperPathCache>& getSharedCopperPathCache() const
+      noexcept {
+    return mCopperPathCache;
+  }
+  BoardOutlineAreaCache& getOutlineAreaCache() const noexcept {
+    return *mOutlineAreaCache;
+  }
+  const std::shared_ptr<BoardOutlineAreaCache>& getSharedOutlineAreaCache()
+      const noexcept {
+    return mOutlineAreaCache;
+  }
   bool            isEmpty() const noexcept;
   QList<BI_Base*> getItemsAtScenePos(const Point& pos) const noexcept;
   QList<BI_Via*>  getViasAtScenePos(const Point&     pos,
@@ -163,6 +210,19 @@ public:
       const Point& pos, const GraphicsLayer* layer = nullptr,
       const NetSignal* netsignal = nullptr) const noexcept;
 
+  /**
+   * @brief Get all items whose bounding rect intersects a given area
+   *
+   * This is a fast lookup in the spatial index of the graphics scene, thus
+   * it only works if the board has graphics items (see #hasGraphicsItems()).
+   *
+   * @param rectPx      The area to look at, in scene coordinates (pixels).
+   *
+   * @return All items whose bounding rect intersects the area, top most item
+   *         first. The caller still needs to check the exact geometry.
+   */
+  QList<BI_Base*> getItemsInSceneRect(const QRectF& rectPx) const noexcept;
+
   BI_NetPoint* getNetPointNextToScenePos(
       const Point& pos, UnsignedLength& maxDistance,
       const GraphicsLayer* layer     = nullptr,
@@ -204,9 +264,51 @@ public:
 
   // Plane Methods
   const QList<BI_Plane*>& getPlanes() const noexcept { return mPlanes; }
+  QList<BI_Plane*>        getPlanesSortedByPriority() const noexcept;
   void                    addPlane(BI_Plane& plane);
   void                    removePlane(BI_Plane& plane);
   void                    rebuildAllPlanes() noexcept;
+  void                    rebuildOutdatedPlanes() noexcept;
+  BoardPlanesRebuilder&   getPlanesRebuilder() noexcept {
+    return *mPlanesRebuilder;
+  }
+
+  /**
+   * @brief Schedule an incremental planes rebuild for a modified area
+   *
+   * The areas of all calls are merged and rebuilt in the background by the
+   * ::librepcb::project::BoardPlanesRebuilder (see
+   * ::librepcb::project::BoardPlanesRebuilder::scheduleIncremental()), or
+   * immediately with #triggerPlanesRebuild(). Calls are ignored until the
+   * board is added to the project and fully loaded.
+   *
+   * @param area    The modified area (e.g. old or new outline of an object).
+   */
+  void schedulePlanesRebuild(const Path& area) noexcept;
+
+  /**
+   * @brief Schedule the planes rebuild for several areas at once
+   *
+   * Equivalent to calling #schedulePlanesRebuild(const Path&) for each area,
+   * but much cheaper since all areas are merged in one step.
+   *
+   * @param areas   The modified areas.
+   */
+  void schedulePlanesRebuild(const QVector<Path>& areas) noexcept;
+
+  /**
+   * @brief Rebuild all planes within the scheduled area immediately
+   *
+   * Blocks until the planes are rebuilt, see #schedulePlanesRebuild().
+   */
+  void triggerPlanesRebuild() noexcept;
+
+  /**
+   * @brief Get and reset the area scheduled with #schedulePlanesRebuild()
+   *
+   * @return The bounding rectangle of all scheduled areas, or an empty path.
+   */
+  Path takeScheduledAreaForPlanesRebuild() noexcept;
 
   // Polygon Methods
   const QList<BI_Polygon*>& getPolygons() const noexcept { return mPolygons; }
@@ -229,14 +331,84 @@ public:
   QList<BI_AirWire*> getAirWires() const noexcept { return mAirWires.values(); }
   void               scheduleAirWiresRebuild(NetSignal* netsignal) noexcept {
     mScheduledNetSignalsForAirWireRebuild.insert(netsignal);
+    mConnectivityGraphs.remove(netsignal);  // outdated now
   }
   void triggerAirWiresRebuild() noexcept;
   void forceAirWiresRebuild() noexcept;
+  int  getAirWiresRebuildCount() const noexcept {
+    return mAirWiresRebuildCount;
+  }
+  qint64 getLastAirWiresRebuildDurationMs() const noexcept {
+    return mLastAirWiresRebuildDurationMs;
+  }
+
+  // Connectivity Methods
+
+  /**
+   * @brief Get the connectivity graph of a net signal on this board
+   *
+   * The graph is kept until the net signal gets modified (see
+   * #scheduleAirWiresRebuild()), so consecutive calls are cheap.
+   *
+   * @note Must be called from the main thread only, but the returned graph
+   *       itself can be accessed from any thread.
+   *
+   * @param netsignal   The net signal to get the graph of.
+   *
+   * @return The connectivity graph (never nullptr)
+   */
+  std::shared_ptr<const BoardConnectivityGraph> getConnectivityGraph(
+      const NetSignal& netsignal) const noexcept;
 
   // General Methods
+
+  /**
+   * @brief Load the parts of this board which were deferred on opening
+   *
+   * Rebuilds outdated plane fragments and schedules the rebuild of all
+   * airwires (see #triggerAirWiresRebuild()). Must be called before the board
+   * is shown in an editor or exported (e.g. Gerber files). Does nothing if
+   * the board is already fully loaded (see #isFullyLoaded()).
+   */
+  void finishLoading() noexcept;
   void addToProject();
   void removeFromProject();
-  void save();
+
+  /**
+   * @brief Serialize the board to the content of its board file
+   *
+   * @note  This method does not modify the board, so it may be called from
+   *        another thread as long as the board is not modified meanwhile.
+   *
+   * @return The file content
+   */
+  QByteArray serializeToByteArray() const;
+
+  /**
+   * @brief Write the board to the project directory
+   *
+   * @param content   The board file content if it was already serialized with
+   *                  #serializeToByteArray() (e.g. concurrently). If null, the
+   *                  board gets serialized by this method.
+   */
+  void save(const QByteArray& content = QByteArray());
+
+  /**
+   * @brief Create a snapshot of this board
+   *
+   * The snapshot is an independent copy with the same UUID and name. It is
+   * not added to the project and not backed by the project directory, so it
+   * must never be saved. This allows to read the board in another thread
+   * (e.g. to generate production data) while the original board is modified.
+   * Since the snapshot is never displayed, no graphics items are created
+   * for it, which makes taking a snapshot much cheaper.
+   *
+   * @return The snapshot (must be destroyed in the main thread)
+   *
+   * @throw Exception     On error
+   */
+  std::unique_ptr<Board> createSnapshot() const;
+
   /**
    * @brief Print board to a QPrinter (printer or file)
    *
@@ -255,6 +427,15 @@ public:
   void print(QPrinter& printer);
   void renderToQPainter(QPainter& painter, int dpi) const;
   void showInView(GraphicsView& view) noexcept;
+
+  /**
+   * @brief Create the graphics items, even if the project is headless
+   *
+   * Boards of headless projects have no graphics items to save time, but
+   * they are needed to render the board (e.g. to export images from the
+   * command line). Does nothing if the graphics items exist already.
+   */
+  void ensureGraphicsItems() noexcept;
   void saveViewSceneRect(const QRectF& rect) noexcept { mViewRect = rect; }
   const QRectF& restoreViewSceneRect() const noexcept { return mViewRect; }
   void          selectAll() noexcept;
@@ -263,6 +444,31 @@ public:
   void          clearSelection() const noexcept;
   std::unique_ptr<BoardSelectionQuery> createSelectionQuery() const noexcept;
 
+  /**
+   * @brief Get all selected items which are added to this board
+   *
+   * Allows to process the selection (e.g. clearing it or building a
+   * ::librepcb::project::BoardSelectionQuery) without iterating over all
+   * items of the board.
+   *
+   * @return Set of selected items
+   */
+  const QSet<BI_Base*>& getSelectedItems() const noexcept {
+    return mSelectedItems;
+  }
+
+  /**
+   * @brief Update the set of selected items (see #getSelectedItems())
+   *
+   * @note  Called by ::librepcb::project::BI_Base whenever the selection
+   *        state of an item changes or a selected item is added to or
+   *        removed from the board.
+   *
+   * @param item      The modified item.
+   * @param selected  Whether the item is selected and added to the board.
+   */
+  void updateSelectedItems(BI_Base& item, bool selected) noexcept;
+
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getBuiltInAttributeValue()
   QString getBuiltInAttributeValue(const QString& key) const noexcept override;
@@ -285,14 +491,46 @@ signals:
   /// @copydoc AttributeProvider::attributesChanged()
   void attributesChanged() override;
 
+  /**
+   * @brief This signal is emited when the design rules or the layer stack
+   *        have been modified
+   *
+   * Board items which depend on them have to update their graphics items.
+   * In contrast to #attributesChanged(), this signal is not emited if only
+   * attributes of the project have changed.
+   */
+  void designRulesOrLayersChanged();
+
   void deviceAdded(BI_Device& comp);
   void deviceRemoved(BI_Device& comp);
 
 private:
   Board(Project& project, std::unique_ptr<TransactionalDirectory> directory,
-        bool create, const QString& newName);
+        bool create, const QString& newName, const SExpression& root);
   void updateIcon() noexcept;
-  void updateErcMessages() noexcept;
+  void createGraphicsItems() noexcept;
+  void updateErcMessages() noexcept override;
+  void updateErcMessagesOfComponent(const ComponentInstance& cmp) noexcept;
+  void updateAirWiresGraphicsItem(NetSignal* netsignal) noexcept;
+
+  /**
+   * @brief Look up board items in the spatial index of the graphics scene
+   *
+   * The graphics scene maintains a BSP tree of all its items which is updated
+   * automatically when items are added, removed or moved, so it is used as
+   * the spatial index of the board instead of maintaining a separate one.
+   *
+   * @param pos           Center of the area to look at.
+   * @param maxDistance   Radius of the area to look at (zero to look only at
+   *                      the exact position).
+   *
+   * @return All items whose bounding rect intersects the area, top most item
+   *         first. The caller still needs to check the exact grab area.
+   */
+  QList<BI_Base*> getItemsFromSceneIndex(
+      const Point& pos, const UnsignedLength& maxDistance) const noexcept;
+  QList<BI_Base*> getBoardItems(
+      const QList<QGraphicsItem*>& graphicsItems) const noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -301,6 +539,9 @@ private:
   Project& mProject;  ///< A reference to the Project object (from the ctor)
   std::unique_ptr<TransactionalDirectory> mDirectory;
   bool                                    mIsAddedToProject;
+  bool                                    mGraphicsItemsEnabled;
+  bool                                    mHasGraphicsItems;
+  bool                                    mIsFullyLoaded;
 
   QScopedPointer<GraphicsScene>                  mGraphicsScene;
   QScopedPointer<BoardLayerStack>                mLayerStack;
@@ -308,8 +549,16 @@ private:
   QScopedPointer<BoardDesignRules>               mDesignRules;
   QScopedPointer<BoardFabricationOutputSettings> mFabricationOutputSettings;
   QScopedPointer<BoardUserSettings>              mUserSettings;
+  std::shared_ptr<BoardCopperPathCache>          mCopperPathCache;
+  std::shared_ptr<BoardOutlineAreaCache>         mOutlineAreaCache;
+  QScopedPointer<BoardPlanesRebuilder>           mPlanesRebuilder;
   QRectF                                         mViewRect;
   QSet<NetSignal*> mScheduledNetSignalsForAirWireRebuild;
+  mutable QHash<const NetSignal*, std::shared_ptr<const BoardConnectivityGraph>>
+      mConnectivityGraphs;  ///< Lazily built, see #getConnectivityGraph()
+  Path   mScheduledAreaForPlanesRebuild;  ///< Bounding rect or empty
+  int    mAirWiresRebuildCount;           ///< For diagnostics only
+  qint64 mLastAirWiresRebuildDurationMs;  ///< For diagnostics only
 
   // Attributes
   Uuid        mUuid;
@@ -320,11 +569,16 @@ private:
   // items
   QMap<Uuid, BI_Device*>              mDeviceInstances;
   QList<BI_NetSegment*>               mNetSegments;
+  QHash<Uuid, BI_NetSegment*>         mNetSegmentsByUuid;  ///< For lookups
   QList<BI_Plane*>                    mPlanes;
   QList<BI_Polygon*>                  mPolygons;
   QList<BI_StrokeText*>               mStrokeTexts;
   QList<BI_Hole*>                     mHoles;
   QMultiHash<NetSignal*, BI_AirWire*> mAirWires;
+  QSet<BI_Base*>                      mSelectedItems;  ///< Added to board
+
+  /// One graphics item per net signal, drawing all its airwires
+  QHash<NetSignal*, BGI_AirWires*> mAirWiresGraphicsItems;
 
   // ERC messages
   QHash<Uuid, ErcMsg*> mErcMsgListUnplacedComponentInstances;
@@ -22,21 +22,11 @@
  ******************************************************************************/
 #include "boardairwiresbuilder.h"
 
-#include "../circuit/circuit.h"
-#include "../circuit/componentsignalinstance.h"
-#include "../circuit/netsignal.h"
-#include "../project.h"
 #include "board.h"
-#include "items/bi_footprintpad.h"
-#include "items/bi_netline.h"
-#include "items/bi_netpoint.h"
-#include "items/bi_netsegment.h"
-#include "items/bi_plane.h"
-#include "items/bi_via.h"
+#include "boardconnectivitygraph.h"
 
 #include <librepcb/common/algorithm/airwiresbuilder.h>
-#include <librepcb/common/graphics/graphicslayer.h>
-#include <librepcb/library/pkg/footprintpad.h>
+#include <librepcb/common/tracer.h>
 
 #include <QtCore>
 
@@ -52,7 +42,7 @@ namespace project {
 
 BoardAirWiresBuilder::BoardAirWiresBuilder(const Board&     board,
                                            const NetSignal& netsignal) noexcept
-  : mBoard(board), mNetSignal(netsignal) {
+  : mGraph(board.getConnectivityGraph(netsignal)) {
 }
 
 BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
@@ -63,75 +53,18 @@ BoardAirWiresBuilder::~BoardAirWiresBuilder() noexcept {
  ******************************************************************************/
 
 QVector<QPair<Point, Point>> BoardAirWiresBuilder::buildAirWires() const {
-  AirWiresBuilder                       builder;
-  QHash<int, std::pair<Point, QString>> pointLayerMap;  // ID -> (point, layer)
-  QHash<const BI_NetLineAnchor*, int>   anchorMap;      // anchor -> ID
-
-  // pads
-  foreach (ComponentSignalInstance* cmpSig, mNetSignal.getComponentSignals()) {
-    Q_ASSERT(cmpSig);
-    foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
-      if (&pad->getBoard() != &mBoard) continue;
-      const Point& pos = pad->getPosition();
-      int          id  = builder.addPoint(pos);
-      pointLayerMap[id] =
-          std::make_pair(pos, (pad->getLibPad().getBoardSide() ==
-                               library::FootprintPad::BoardSide::THT)
-                                  ? QString()  // on all layers
-                                  : pad->getLayerName());
-      anchorMap[pad] = id;
-    }
-  }
-
-  // vias, netpoints, netlines
-  foreach (const BI_NetSegment* netsegment, mNetSignal.getBoardNetSegments()) {
-    Q_ASSERT(netsegment);
-    if (&netsegment->getBoard() != &mBoard) continue;
-    foreach (const BI_Via* via, netsegment->getVias()) {
-      Q_ASSERT(via);
-      const Point& pos  = via->getPosition();
-      int          id   = builder.addPoint(pos);
-      pointLayerMap[id] = std::make_pair(pos, QString());  // on all layers
-      anchorMap[via]    = id;
-    }
-    foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
-      Q_ASSERT(netpoint);
-      if (const GraphicsLayer* layer = netpoint->getLayerOfLines()) {
-        Point pos           = netpoint->getPosition();
-        int   id            = builder.addPoint(pos);
-        pointLayerMap[id]   = std::make_pair(pos, layer->getName());
-        anchorMap[netpoint] = id;
-      }
-    }
-    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
-      Q_ASSERT(netline);
-      Q_ASSERT(anchorMap.contains(&netline->getStartPoint()));
-      Q_ASSERT(anchorMap.contains(&netline->getEndPoint()));
-      builder.addEdge(anchorMap[&netline->getStartPoint()],
-                      anchorMap[&netline->getEndPoint()]);
-    }
+  LIBREPCB_TRACE_SCOPE("board", "BoardAirWiresBuilder::buildAirWires");
+  AirWiresBuilder builder;
+  foreach (const BoardConnectivityGraph::Anchor& anchor, mGraph->getAnchors()) {
+    builder.addPoint(anchor.position);  // IDs are equal to the indices
   }
 
-  // determine connections made by planes
-  foreach (const BI_Plane* plane, mNetSignal.getBoardPlanes()) {
-    Q_ASSERT(plane);
-    if (&plane->getBoard() != &mBoard) continue;
-    foreach (const Path& fragment, plane->getFragments()) {
-      int                                           lastId = -1;
-      QHashIterator<int, std::pair<Point, QString>> i(pointLayerMap);
-      while (i.hasNext()) {
-        i.next();
-        const Point&   pos        = i.value().first;
-        const QString& pointLayer = i.value().second;
-        if (pointLayer.isNull() || (pointLayer == plane->getLayerName())) {
-          if (fragment.toQPainterPathPx().contains(pos.toPxQPointF())) {
-            if (lastId >= 0) {
-              builder.addEdge(lastId, i.key());
-            }
-            lastId = i.key();
-          }
-        }
-      }
+  // connect each anchor with the representative of its copper cluster, this
+  // is sufficient since only the connectivity matters
+  const QVector<int> clusters = mGraph->getClusters();
+  for (int i = 0; i < clusters.count(); ++i) {
+    if (clusters.at(i) != i) {
+      builder.addEdge(i, clusters.at(i));
     }
   }
 
@@ -27,6 +27,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -35,13 +37,20 @@ namespace project {
 
 class NetSignal;
 class Board;
+class BoardConnectivityGraph;
 
 /*******************************************************************************
  *  Class BoardAirWiresBuilder
  ******************************************************************************/
 
 /**
- * @brief The BoardAirWiresBuilder class
+ * @brief The BoardAirWiresBuilder class calculates the air wires of a net
+ *        signal in a ::librepcb::project::Board
+ *
+ * The constructor only fetches the ::librepcb::project::BoardConnectivityGraph
+ * of the net signal (a snapshot of its anchors, traces and plane fragments),
+ * so #buildAirWires() does not access the board at all. This allows to
+ * calculate the air wires of many net signals in parallel worker threads.
  */
 class BoardAirWiresBuilder final {
 public:
@@ -52,14 +61,21 @@ public:
   ~BoardAirWiresBuilder() noexcept;
 
   // General Methods
+
+  /**
+   * @brief Calculate the air wires
+   *
+   * @note This method is thread-safe, even while the board is modified.
+   *
+   * @return The start and end points of all air wires
+   */
   QVector<QPair<Point, Point>> buildAirWires() const;
 
   // Operator Overloadings
   BoardAirWiresBuilder& operator=(const BoardAirWiresBuilder& rhs) = delete;
 
 private:  // Data
-  const Board&     mBoard;
-  const NetSignal& mNetSignal;
+  std::shared_ptr<const BoardConnectivityGraph> mGraph;
 };
 
 /*******************************************************************************
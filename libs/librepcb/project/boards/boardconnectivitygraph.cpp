@@ -0,0 +1,195 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardconnectivitygraph.h"
+
+#include "../circuit/componentsignalinstance.h"
+#include "../circuit/netsignal.h"
+#include "board.h"
+#include "items/bi_footprintpad.h"
+#include "items/bi_netline.h"
+#include "items/bi_netpoint.h"
+#include "items/bi_netsegment.h"
+#include "items/bi_plane.h"
+#include "items/bi_via.h"
+
+#include <librepcb/common/algorithm/unionfind.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/tracer.h>
+#include <librepcb/library/pkg/footprintpad.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardConnectivityGraph::BoardConnectivityGraph(
+    const Board& board, const NetSignal& netsignal) noexcept
+  : mAnchors(),
+    mIndices(),
+    mTraces(),
+    mPlanes(),
+    mMutex(),
+    mClustersValid(false),
+    mClusters(),
+    mClusterCount(0) {
+  auto addAnchor = [this](const BI_NetLineAnchor* item, const Point& position,
+                          const QString& layer) {
+    mIndices.insert(item, mAnchors.count());
+    mAnchors.append(Anchor{item, position, layer});
+  };
+
+  // pads
+  foreach (ComponentSignalInstance* cmpSig, netsignal.getComponentSignals()) {
+    Q_ASSERT(cmpSig);
+    foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
+      if (&pad->getBoard() != &board) continue;
+      addAnchor(pad, pad->getPosition(),
+                (pad->getLibPad().getBoardSide() ==
+                 library::FootprintPad::BoardSide::THT)
+                    ? QString()  // on all layers
+                    : pad->getLayerName());
+    }
+  }
+
+  // vias, netpoints, netlines
+  foreach (const BI_NetSegment* netsegment, netsignal.getBoardNetSegments()) {
+    Q_ASSERT(netsegment);
+    if (&netsegment->getBoard() != &board) continue;
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      Q_ASSERT(via);
+      addAnchor(via, via->getPosition(), QString());  // on all layers
+    }
+    foreach (const BI_NetPoint* netpoint, netsegment->getNetPoints()) {
+      Q_ASSERT(netpoint);
+      if (const GraphicsLayer* layer = netpoint->getLayerOfLines()) {
+        addAnchor(netpoint, netpoint->getPosition(), layer->getName());
+      }
+    }
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      Q_ASSERT(netline);
+      Q_ASSERT(mIndices.contains(&netline->getStartPoint()));
+      Q_ASSERT(mIndices.contains(&netline->getEndPoint()));
+      mTraces.append(qMakePair(mIndices.value(&netline->getStartPoint()),
+                               mIndices.value(&netline->getEndPoint())));
+    }
+  }
+
+  // planes
+  foreach (const BI_Plane* plane, netsignal.getBoardPlanes()) {
+    Q_ASSERT(plane);
+    if (&plane->getBoard() != &board) continue;
+    mPlanes.append(Plane{*plane->getLayerName(), plane->getFragments()});
+  }
+}
+
+BoardConnectivityGraph::~BoardConnectivityGraph() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QVector<int> BoardConnectivityGraph::getClusters() const noexcept {
+  QMutexLocker lock(&mMutex);
+  updateClusters();
+  return mClusters;
+}
+
+int BoardConnectivityGraph::getClusterCount() const noexcept {
+  QMutexLocker lock(&mMutex);
+  updateClusters();
+  return mClusterCount;
+}
+
+bool BoardConnectivityGraph::areConnected(
+    const BI_NetLineAnchor& a, const BI_NetLineAnchor& b) const noexcept {
+  int indexA = indexOf(a);
+  int indexB = indexOf(b);
+  if ((indexA < 0) || (indexB < 0)) {
+    return false;
+  }
+  QMutexLocker lock(&mMutex);
+  updateClusters();
+  return mClusters.at(indexA) == mClusters.at(indexB);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardConnectivityGraph::updateClusters() const noexcept {
+  if (mClustersValid) {
+    return;
+  }
+  LIBREPCB_TRACE_SCOPE("board", "BoardConnectivityGraph::updateClusters");
+
+  UnionFind groups(mAnchors.count());
+  foreach (const auto& trace, mTraces) {
+    groups.unite(trace.first, trace.second);
+  }
+
+  // determine connections made by planes
+  foreach (const Plane& plane, mPlanes) {
+    foreach (const Path& fragment, plane.fragments) {
+      // convert the fragment only once and skip most points by its bounds
+      QPainterPath area   = fragment.toQPainterPathPx();
+      QRectF       bounds = area.boundingRect();
+
+      int lastId = -1;
+      for (int i = 0; i < mAnchors.count(); ++i) {
+        const Anchor& anchor = mAnchors.at(i);
+        if (anchor.layer.isNull() || (anchor.layer == plane.layer)) {
+          QPointF posPx = anchor.position.toPxQPointF();
+          if (bounds.contains(posPx) && area.contains(posPx)) {
+            if (lastId >= 0) {
+              groups.unite(lastId, i);
+            }
+            lastId = i;
+          }
+        }
+      }
+    }
+  }
+
+  mClusters.resize(mAnchors.count());
+  for (int i = 0; i < mAnchors.count(); ++i) {
+    mClusters[i] = groups.find(i);
+  }
+  mClusterCount  = groups.getGroupCount();
+  mClustersValid = true;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
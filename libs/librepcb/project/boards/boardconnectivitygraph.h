@@ -0,0 +1,162 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BOARDCONNECTIVITYGRAPH_H
+#define LIBREPCB_PROJECT_BOARDCONNECTIVITYGRAPH_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/point.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class NetSignal;
+class Board;
+class BI_NetLineAnchor;
+
+/*******************************************************************************
+ *  Class BoardConnectivityGraph
+ ******************************************************************************/
+
+/**
+ * @brief The BoardConnectivityGraph class represents which copper objects of
+ *        a net signal in a ::librepcb::project::Board are connected together
+ *
+ * The nodes of the graph are the anchors of the net signal (pads, vias and
+ * net points), connected by the traces between them and by plane fragments
+ * covering them. The anchors are grouped into clusters of connected anchors
+ * with a ::librepcb::UnionFind structure.
+ *
+ * The constructor only takes a snapshot of the net signal, the clusters are
+ * determined lazily on the first access. All getters are thread-safe, so
+ * the (expensive) calculation may also run in a worker thread. The board
+ * keeps one graph per net signal (see
+ * ::librepcb::project::Board::getConnectivityGraph()) and discards it when
+ * the net signal gets modified.
+ */
+class BoardConnectivityGraph final {
+public:
+  // Types
+  struct Anchor {
+    const BI_NetLineAnchor* item;
+    Point                   position;
+    QString                 layer;  ///< Null if on all layers
+  };
+
+  // Constructors / Destructor
+  BoardConnectivityGraph()                                    = delete;
+  BoardConnectivityGraph(const BoardConnectivityGraph& other) = delete;
+  BoardConnectivityGraph(const Board&     board,
+                         const NetSignal& netsignal) noexcept;
+  ~BoardConnectivityGraph() noexcept;
+
+  // Getters
+
+  /**
+   * @brief Get all anchors of the net signal
+   *
+   * @note The items of the anchors must only be dereferenced in the main
+   *       thread, and only as long as the graph is up to date.
+   *
+   * @return All anchors (the indices are used as IDs within the graph)
+   */
+  const QVector<Anchor>& getAnchors() const noexcept { return mAnchors; }
+
+  /**
+   * @brief Get the index of an anchor
+   *
+   * @param anchor  The anchor item.
+   *
+   * @return Index in #getAnchors(), or -1 if the anchor is not part of the
+   *         graph (e.g. netpoints without any trace)
+   */
+  int indexOf(const BI_NetLineAnchor& anchor) const noexcept {
+    return mIndices.value(&anchor, -1);
+  }
+
+  /**
+   * @brief Get the cluster of each anchor
+   *
+   * @return For each anchor, the index of the representative anchor of its
+   *         cluster (equal for all connected anchors)
+   */
+  QVector<int> getClusters() const noexcept;
+
+  /**
+   * @brief Get the number of clusters
+   *
+   * @return Number of unconnected groups of anchors (i.e. one if all anchors
+   *         are connected together, and zero if there are no anchors)
+   */
+  int getClusterCount() const noexcept;
+
+  /**
+   * @brief Check whether two anchors are connected by copper
+   *
+   * @param a   First anchor.
+   * @param b   Second anchor.
+   *
+   * @return Whether both anchors are part of the graph and in the same
+   *         cluster
+   */
+  bool areConnected(const BI_NetLineAnchor& a,
+                    const BI_NetLineAnchor& b) const noexcept;
+
+  // Operator Overloadings
+  BoardConnectivityGraph& operator=(const BoardConnectivityGraph& rhs) = delete;
+
+private:  // Methods
+  void updateClusters() const noexcept;
+
+private:  // Types
+  struct Plane {
+    QString       layer;
+    QVector<Path> fragments;
+  };
+
+private:  // Data
+  QVector<Anchor>                     mAnchors;
+  QHash<const BI_NetLineAnchor*, int> mIndices;  ///< anchor -> index
+  QVector<QPair<int, int>>            mTraces;   ///< Connected anchor indices
+  QVector<Plane>                      mPlanes;
+
+  // Lazily calculated clusters
+  mutable QMutex       mMutex;
+  mutable bool         mClustersValid;
+  mutable QVector<int> mClusters;
+  mutable int          mClusterCount;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDCONNECTIVITYGRAPH_H
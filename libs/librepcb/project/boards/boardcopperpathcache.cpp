@@ -0,0 +1,118 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardcopperpathcache.h"
+
+#include "drc/boardclipperpathgenerator.h"
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardCopperPathCache::BoardCopperPathCache(Board& board) noexcept
+  : mBoard(board), mMutex(), mEntries() {
+}
+
+BoardCopperPathCache::~BoardCopperPathCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+uint BoardCopperPathCache::getRevisionStamp(const QString&   layerName,
+                                            const NetSignal* netsignal) const {
+  // the tolerance is irrelevant for calculating the stamp
+  BoardClipperPathGenerator gen(mBoard, PositiveLength(1));
+  return gen.calcCopperRevisionStamp(layerName, netsignal);
+}
+
+ClipperLib::Paths BoardCopperPathCache::getPaths(
+    const QString& layerName, const NetSignal* netsignal,
+    const PositiveLength& maxArcTolerance, uint* revisionStamp) {
+  BoardClipperPathGenerator gen(mBoard, maxArcTolerance);
+  uint stamp = gen.calcCopperRevisionStamp(layerName, netsignal);
+  if (revisionStamp) {
+    *revisionStamp = stamp;
+  }
+
+  Key key(layerName, netsignal);
+  {
+    QMutexLocker lock(&mMutex);
+    auto         it = mEntries.constFind(key);
+    if ((it != mEntries.constEnd()) && (it->revisionStamp == stamp) &&
+        (it->maxArcTolerance == *maxArcTolerance)) {
+      return it->paths;
+    }
+  }
+
+  // generate the paths without holding the lock to allow other threads
+  // generating other entries in parallel
+  gen.addCopper(layerName, netsignal);
+  QMutexLocker lock(&mMutex);
+  mEntries.insert(key, Entry{stamp, *maxArcTolerance, gen.getPaths()});
+  return gen.getPaths();
+}
+
+bool BoardCopperPathCache::tryGetPaths(
+    const QString& layerName, const NetSignal* netsignal, uint revisionStamp,
+    const PositiveLength& maxArcTolerance, ClipperLib::Paths& paths) const
+    noexcept {
+  QMutexLocker lock(&mMutex);
+  auto         it = mEntries.constFind(Key(layerName, netsignal));
+  if ((it != mEntries.constEnd()) && (it->revisionStamp == revisionStamp) &&
+      (it->maxArcTolerance == *maxArcTolerance)) {
+    paths = it->paths;
+    return true;
+  }
+  return false;
+}
+
+void BoardCopperPathCache::insertPaths(
+    const QString& layerName, const NetSignal* netsignal, uint revisionStamp,
+    const PositiveLength& maxArcTolerance,
+    const ClipperLib::Paths& paths) noexcept {
+  QMutexLocker lock(&mMutex);
+  mEntries.insert(Key(layerName, netsignal),
+                  Entry{revisionStamp, *maxArcTolerance, paths});
+}
+
+void BoardCopperPathCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mEntries.clear();
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
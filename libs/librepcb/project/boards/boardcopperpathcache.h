@@ -0,0 +1,162 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDCOPPERPATHCACHE_H
+#define LIBREPCB_PROJECT_BOARDCOPPERPATHCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/units/length.h>
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*******************************************************************************
+ *  Class BoardCopperPathCache
+ ******************************************************************************/
+
+/**
+ * @brief The BoardCopperPathCache class caches the copper areas of a
+ *        ::librepcb::project::Board per layer and net signal
+ *
+ * Each cache entry is tagged with the revision stamp of the copper objects it
+ * was generated from (see
+ * ::librepcb::project::BoardClipperPathGenerator::calcCopperRevisionStamp()).
+ * Entries are regenerated on demand as soon as any of these objects was
+ * modified, added or removed, so the cache never needs to be invalidated
+ * explicitly. This allows to share the generated areas between multiple
+ * consumers (e.g. consecutive design rule check runs) without regenerating
+ * them for thousands of unmodified pads and traces each time.
+ *
+ * @note All methods are thread-safe, as long as the board is not modified
+ *       while they are running.
+ */
+class BoardCopperPathCache final {
+public:
+  // Constructors / Destructor
+  BoardCopperPathCache()                                  = delete;
+  BoardCopperPathCache(const BoardCopperPathCache& other) = delete;
+  explicit BoardCopperPathCache(Board& board) noexcept;
+  ~BoardCopperPathCache() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Get the current revision stamp of a layer and net signal
+   *
+   * @param layerName   The copper layer.
+   * @param netsignal   The net signal (`nullptr` for unconnected copper).
+   *
+   * @return The stamp as returned by #getPaths() if called now
+   */
+  uint getRevisionStamp(const QString&   layerName,
+                        const NetSignal* netsignal) const;
+
+  /**
+   * @brief Get the united copper area of a layer and net signal
+   *
+   * @param layerName         The copper layer.
+   * @param netsignal         The net signal (`nullptr` for unconnected
+   *                          copper).
+   * @param maxArcTolerance   Maximum tolerance for approximating arcs.
+   * @param revisionStamp     If not `nullptr`, the revision stamp of the
+   *                          returned area is written to it.
+   *
+   * @return The (possibly cached) copper area
+   */
+  ClipperLib::Paths getPaths(const QString&        layerName,
+                             const NetSignal*      netsignal,
+                             const PositiveLength& maxArcTolerance,
+                             uint*                 revisionStamp = nullptr);
+
+  /**
+   * @brief Get the copper area of a layer and net signal, if cached
+   *
+   * In contrast to #getPaths(), this method does not access the board at all,
+   * so it can be used by worker threads even while the board is modified.
+   *
+   * @param layerName         The copper layer.
+   * @param netsignal         The net signal (only used as key).
+   * @param revisionStamp     The required revision stamp.
+   * @param maxArcTolerance   The required arc tolerance.
+   * @param paths             The cached area is written to it (if found).
+   *
+   * @retval true   If a matching entry was found.
+   * @retval false  If there is no matching entry.
+   */
+  bool tryGetPaths(const QString& layerName, const NetSignal* netsignal,
+                   uint revisionStamp, const PositiveLength& maxArcTolerance,
+                   ClipperLib::Paths& paths) const noexcept;
+
+  /**
+   * @brief Add an externally generated copper area to the cache
+   *
+   * Like #tryGetPaths(), this does not access the board.
+   *
+   * @param layerName         The copper layer.
+   * @param netsignal         The net signal (only used as key).
+   * @param revisionStamp     Revision stamp of the copper objects the area
+   *                          was generated from.
+   * @param maxArcTolerance   The arc tolerance used to generate the area.
+   * @param paths             The copper area.
+   */
+  void insertPaths(const QString& layerName, const NetSignal* netsignal,
+                   uint revisionStamp, const PositiveLength& maxArcTolerance,
+                   const ClipperLib::Paths& paths) noexcept;
+
+  /**
+   * @brief Remove all entries from the cache to release memory
+   */
+  void clear() noexcept;
+
+  // Operator Overloadings
+  BoardCopperPathCache& operator=(const BoardCopperPathCache& rhs) = delete;
+
+private:  // Types
+  typedef QPair<QString, const NetSignal*> Key;
+  struct Entry {
+    uint              revisionStamp;
+    Length            maxArcTolerance;
+    ClipperLib::Paths paths;
+  };
+
+private:  // Data
+  Board&            mBoard;
+  mutable QMutex    mMutex;    ///< Protects #mEntries
+  QHash<Key, Entry> mEntries;  ///< Kept until #clear() is called
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDCOPPERPATHCACHE_H
@@ -57,7 +57,8 @@ BoardFabricationOutputSettings::BoardFabricationOutputSettings() noexcept
         {GraphicsLayer::sBotPlacement, GraphicsLayer::sBotNames}),
     mMergeDrillFiles(false),
     mEnableSolderPasteTop(false),
-    mEnableSolderPasteBot(false) {
+    mEnableSolderPasteBot(false),
+    mMergeCopperRegions(false) {
 }
 
 BoardFabricationOutputSettings::BoardFabricationOutputSettings(
@@ -90,6 +91,9 @@ BoardFabricationOutputSettings::BoardFabricationOutputSettings(
   mMergeDrillFiles      = node.getValueByPath<bool>("drills/merge");
   mEnableSolderPasteTop = node.getValueByPath<bool>("solderpaste_top/create");
   mEnableSolderPasteBot = node.getValueByPath<bool>("solderpaste_bot/create");
+  if (const SExpression* e = node.tryGetChildByPath("copper_merge_regions")) {
+    mMergeCopperRegions = e->getValueOfFirstChild<bool>();
+  }
 
   mSilkscreenLayersTop.clear();
   foreach (const SExpression& child,
@@ -153,6 +157,8 @@ void BoardFabricationOutputSettings::serialize(SExpression& root) const {
   SExpression& solderPasteBot = root.appendList("solderpaste_bot", true);
   solderPasteBot.appendChild("create", mEnableSolderPasteBot, false);
   solderPasteBot.appendChild("suffix", mSuffixSolderPasteBot, false);
+
+  root.appendChild("copper_merge_regions", mMergeCopperRegions, true);
 }
 
 /*******************************************************************************
@@ -180,6 +186,7 @@ BoardFabricationOutputSettings& BoardFabricationOutputSettings::operator=(
   mMergeDrillFiles      = rhs.mMergeDrillFiles;
   mEnableSolderPasteTop = rhs.mEnableSolderPasteTop;
   mEnableSolderPasteBot = rhs.mEnableSolderPasteBot;
+  mMergeCopperRegions   = rhs.mMergeCopperRegions;
   return *this;
 }
 
@@ -204,6 +211,7 @@ bool BoardFabricationOutputSettings::operator==(
   if (mMergeDrillFiles != rhs.mMergeDrillFiles) return false;
   if (mEnableSolderPasteTop != rhs.mEnableSolderPasteTop) return false;
   if (mEnableSolderPasteBot != rhs.mEnableSolderPasteBot) return false;
+  if (mMergeCopperRegions != rhs.mMergeCopperRegions) return false;
   return true;
 }
 
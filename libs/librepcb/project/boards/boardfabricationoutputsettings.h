@@ -99,6 +99,7 @@ public:
   bool getEnableSolderPasteBot() const noexcept {
     return mEnableSolderPasteBot;
   }
+  bool getMergeCopperRegions() const noexcept { return mMergeCopperRegions; }
 
   // Setters
   void setOutputBasePath(const QString& p) noexcept { mOutputBasePath = p; }
@@ -138,6 +139,7 @@ public:
   void setMergeDrillFiles(bool m) noexcept { mMergeDrillFiles = m; }
   void setEnableSolderPasteTop(bool e) noexcept { mEnableSolderPasteTop = e; }
   void setEnableSolderPasteBot(bool e) noexcept { mEnableSolderPasteBot = e; }
+  void setMergeCopperRegions(bool m) noexcept { mMergeCopperRegions = m; }
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -170,6 +172,7 @@ private:  // Data
   bool        mMergeDrillFiles;
   bool        mEnableSolderPasteTop;
   bool        mEnableSolderPasteBot;
+  bool        mMergeCopperRegions;  ///< unite copper of each net to regions
 };
 
 /*******************************************************************************
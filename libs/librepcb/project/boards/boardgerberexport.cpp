@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boardgerberexport.h"
 
+#include "../circuit/netsignal.h"
 #include "../metadata/projectmetadata.h"
 #include "../project.h"
 #include "board.h"
@@ -41,10 +42,15 @@
 
 #include <librepcb/common/attributes/attributesubstitutor.h>
 #include <librepcb/common/boarddesignrules.h>
+#include <librepcb/common/cam/camoutputfingerprint.h>
 #include <librepcb/common/cam/excellongenerator.h>
 #include <librepcb/common/cam/gerbergenerator.h>
 #include <librepcb/common/geometry/hole.h>
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/tracer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/taskscheduler.h>
+#include <librepcb/common/utils/transform.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
@@ -65,7 +71,8 @@ BoardGerberExport::BoardGerberExport(
   : mProject(board.getProject()),
     mBoard(board),
     mSettings(new BoardFabricationOutputSettings(settings)),
-    mCurrentInnerCopperLayer(0) {
+    mCurrentInnerCopperLayer(0),
+    mAbortRequested(0) {
 }
 
 BoardGerberExport::~BoardGerberExport() noexcept {
@@ -84,27 +91,116 @@ FilePath BoardGerberExport::getOutputDirectory() const noexcept {
  ******************************************************************************/
 
 void BoardGerberExport::exportAllLayers() const {
+  LIBREPCB_TRACE_SCOPE("cam", "BoardGerberExport::exportAllLayers");
   mWrittenFiles.clear();
-
+  mReusedFiles.clear();
+
+  // Determine all output files in this thread since the file paths may depend
+  // on the current inner copper layer (see #getBuiltInAttributeValue()).
+  typedef std::function<OutputState(const FilePath&)> Job;
+  QVector<QPair<FilePath, Job>>                         jobs;
+  auto addJob = [&](const QString& suffix, Job func) {
+    jobs.append(qMakePair(getOutputFilePath(suffix), func));
+  };
   if (mSettings->getMergeDrillFiles()) {
-    exportDrills();
+    addJob(mSettings->getSuffixDrills(),
+           [this](const FilePath& fp) { return exportDrills(fp); });
   } else {
-    exportDrillsNpth();
-    exportDrillsPth();
-  }
-  exportLayerBoardOutlines();
-  exportLayerTopCopper();
-  exportLayerInnerCopper();
-  exportLayerBottomCopper();
-  exportLayerTopSolderMask();
-  exportLayerBottomSolderMask();
-  exportLayerTopSilkscreen();
-  exportLayerBottomSilkscreen();
+    addJob(mSettings->getSuffixDrillsNpth(),
+           [this](const FilePath& fp) { return exportDrillsNpth(fp); });
+    addJob(mSettings->getSuffixDrillsPth(),
+           [this](const FilePath& fp) { return exportDrillsPth(fp); });
+  }
+  addJob(mSettings->getSuffixOutlines(), [this](const FilePath& fp) {
+    return exportLayer(fp, GraphicsLayer::sBoardOutlines);
+  });
+  addJob(mSettings->getSuffixCopperTop(), [this](const FilePath& fp) {
+    return exportLayer(fp, GraphicsLayer::sTopCopper);
+  });
+  for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
+    mCurrentInnerCopperLayer = i;  // used for attribute provider
+    addJob(mSettings->getSuffixCopperInner(), [this, i](const FilePath& fp) {
+      return exportLayer(fp, GraphicsLayer::getInnerLayerName(i));
+    });
+  }
+  mCurrentInnerCopperLayer = 0;
+  addJob(mSettings->getSuffixCopperBot(), [this](const FilePath& fp) {
+    return exportLayer(fp, GraphicsLayer::sBotCopper);
+  });
+  addJob(mSettings->getSuffixSolderMaskTop(), [this](const FilePath& fp) {
+    return exportLayer(fp, GraphicsLayer::sTopStopMask);
+  });
+  addJob(mSettings->getSuffixSolderMaskBot(), [this](const FilePath& fp) {
+    return exportLayer(fp, GraphicsLayer::sBotStopMask);
+  });
+  // don't create silkscreen files if no layers selected
+  if (!mSettings->getSilkscreenLayersTop().isEmpty()) {
+    addJob(mSettings->getSuffixSilkscreenTop(), [this](const FilePath& fp) {
+      return exportLayerSilkscreen(fp, mSettings->getSilkscreenLayersTop(),
+                                   GraphicsLayer::sTopStopMask);
+    });
+  }
+  if (!mSettings->getSilkscreenLayersBot().isEmpty()) {
+    addJob(mSettings->getSuffixSilkscreenBot(), [this](const FilePath& fp) {
+      return exportLayerSilkscreen(fp, mSettings->getSilkscreenLayersBot(),
+                                   GraphicsLayer::sBotStopMask);
+    });
+  }
   if (mSettings->getEnableSolderPasteTop()) {
-    exportLayerTopSolderPaste();
+    addJob(mSettings->getSuffixSolderPasteTop(), [this](const FilePath& fp) {
+      return exportLayer(fp, GraphicsLayer::sTopSolderPaste);
+    });
   }
   if (mSettings->getEnableSolderPasteBot()) {
-    exportLayerBottomSolderPaste();
+    addJob(mSettings->getSuffixSolderPasteBot(), [this](const FilePath& fp) {
+      return exportLayer(fp, GraphicsLayer::sBotSolderPaste);
+    });
+  }
+
+  // All files are independent of each other (each job has its own generator
+  // and only reads the board), so they are generated in parallel. The board
+  // must not be modified until all jobs are finished.
+  QAtomicInt                  finishedJobs(0);
+  QList<QFuture<OutputState>> futures;
+  foreach (const auto& job, jobs) {
+    const int total = jobs.count();
+    futures.append(TaskScheduler::run(
+        TaskScheduler::Priority::Normal, [this, job, total, &finishedJobs]() {
+          OutputState state = OutputState::NotCreated;
+          if (!mAbortRequested.loadAcquire()) {
+            QElapsedTimer timer;
+            timer.start();
+            state = job.second(job.first);  // can throw
+            if (state != OutputState::NotCreated) {
+              emit fileExported(job.first, state == OutputState::Reused,
+                                timer.elapsed());
+            }
+          }
+          emit exportProgress(finishedJobs.fetchAndAddOrdered(1) + 1, total);
+          return state;
+        }));
+  }
+  // Wait for all jobs before evaluating any result because they access this
+  // object. Exceptions are re-thrown below by QFuture::result().
+  for (QFuture<OutputState>& future : futures) {
+    try {
+      future.waitForFinished();  // can throw
+    } catch (const QException&) {
+      // evaluated below
+    }
+  }
+  if (mAbortRequested.loadAcquire()) {
+    throw UserCanceled(__FILE__, __LINE__);
+  }
+  // Evaluate the results in the original order to get deterministic output.
+  for (int i = 0; i < jobs.count(); ++i) {
+    OutputState state = futures[i].result();  // can throw
+    if (state != OutputState::NotCreated) {
+      mWrittenFiles.append(jobs.at(i).first);
+    }
+    if (state == OutputState::Reused) {
+      mReusedFiles.append(jobs.at(i).first);
+    }
   }
 }
 
@@ -130,18 +226,19 @@ BoardGerberExport::getAttributeProviderParents() const noexcept {
  *  Private Methods
  ******************************************************************************/
 
-void BoardGerberExport::exportDrills() const {
-  FilePath          fp = getOutputFilePath(mSettings->getSuffixDrills());
+BoardGerberExport::OutputState BoardGerberExport::exportDrills(
+    const FilePath& fp) const {
+  LIBREPCB_TRACE_SCOPE("cam", "BoardGerberExport::exportDrills");
   ExcellonGenerator gen;
   drawPthDrills(gen);
   drawNpthDrills(gen);
   gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return saveExcellon(gen, fp);
 }
 
-void BoardGerberExport::exportDrillsNpth() const {
-  FilePath          fp = getOutputFilePath(mSettings->getSuffixDrillsNpth());
+BoardGerberExport::OutputState BoardGerberExport::exportDrillsNpth(
+    const FilePath& fp) const {
+  LIBREPCB_TRACE_SCOPE("cam", "BoardGerberExport::exportDrillsNpth");
   ExcellonGenerator gen;
   int               count = drawNpthDrills(gen);
   if (count > 0) {
@@ -150,144 +247,65 @@ void BoardGerberExport::exportDrillsNpth() const {
     // this file only if it's really needed. Maybe this avoids unnecessary
     // issues with manufacturers...
     gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+    return saveExcellon(gen, fp);
   }
+  return OutputState::NotCreated;
 }
 
-void BoardGerberExport::exportDrillsPth() const {
-  FilePath          fp = getOutputFilePath(mSettings->getSuffixDrillsPth());
+BoardGerberExport::OutputState BoardGerberExport::exportDrillsPth(
+    const FilePath& fp) const {
+  LIBREPCB_TRACE_SCOPE("cam", "BoardGerberExport::exportDrillsPth");
   ExcellonGenerator gen;
   drawPthDrills(gen);
   gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerBoardOutlines() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixOutlines());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBoardOutlines);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return saveExcellon(gen, fp);
 }
 
-void BoardGerberExport::exportLayerTopCopper() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixCopperTop());
+BoardGerberExport::OutputState BoardGerberExport::exportLayer(
+    const FilePath& fp, const QString& layerName) const {
+  LIBREPCB_TRACE_SCOPE("cam", "BoardGerberExport::exportLayer");
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopCopper);
+  drawLayer(gen, layerName);
   gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return saveGerber(gen, fp);
 }
 
-void BoardGerberExport::exportLayerBottomCopper() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixCopperBot());
+BoardGerberExport::OutputState BoardGerberExport::exportLayerSilkscreen(
+    const FilePath& fp, const QStringList& layers,
+    const QString& stopMaskLayer) const {
+  LIBREPCB_TRACE_SCOPE("cam", "BoardGerberExport::exportLayerSilkscreen");
   GerberGenerator gen(
       mProject.getMetadata().getName() % " - " % mBoard.getName(),
       mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotCopper);
+  foreach (const QString& layer, layers) { drawLayer(gen, layer); }
+  gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
+  drawLayer(gen, stopMaskLayer);
   gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  return saveGerber(gen, fp);
 }
 
-void BoardGerberExport::exportLayerInnerCopper() const {
-  for (int i = 1; i <= mBoard.getLayerStack().getInnerLayerCount(); ++i) {
-    mCurrentInnerCopperLayer = i;  // used for attribute provider
-    FilePath        fp = getOutputFilePath(mSettings->getSuffixCopperInner());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    drawLayer(gen, GraphicsLayer::getInnerLayerName(i));
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+BoardGerberExport::OutputState BoardGerberExport::saveGerber(
+    const GerberGenerator& gen, const FilePath& fp) const {
+  CamOutputFingerprint fingerprint;
+  gen.writeTo(fingerprint);  // can throw
+  if (isFileUpToDate(fp, fingerprint.getResult())) {  // can throw
+    return OutputState::Reused;
   }
-  mCurrentInnerCopperLayer = 0;
+  gen.saveToFile(fp);  // can throw
+  return OutputState::Written;
 }
 
-void BoardGerberExport::exportLayerTopSolderMask() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixSolderMaskTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerBottomSolderMask() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixSolderMaskBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotStopMask);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerTopSilkscreen() const {
-  QStringList layers = mSettings->getSilkscreenLayersTop();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath        fp = getOutputFilePath(mSettings->getSuffixSilkscreenTop());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
-    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sTopStopMask);
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
+BoardGerberExport::OutputState BoardGerberExport::saveExcellon(
+    const ExcellonGenerator& gen, const FilePath& fp) const {
+  CamOutputFingerprint fingerprint;
+  gen.writeTo(fingerprint);  // can throw
+  if (isFileUpToDate(fp, fingerprint.getResult())) {  // can throw
+    return OutputState::Reused;
   }
-}
-
-void BoardGerberExport::exportLayerBottomSilkscreen() const {
-  QStringList layers = mSettings->getSilkscreenLayersBot();
-  if (layers.count() >
-      0) {  // don't create silkscreen file if no layers selected
-    FilePath        fp = getOutputFilePath(mSettings->getSuffixSilkscreenBot());
-    GerberGenerator gen(
-        mProject.getMetadata().getName() % " - " % mBoard.getName(),
-        mBoard.getUuid(), mProject.getMetadata().getVersion());
-    foreach (const QString& layer, layers) { drawLayer(gen, layer); }
-    gen.setLayerPolarity(GerberGenerator::LayerPolarity::Negative);
-    drawLayer(gen, GraphicsLayer::sBotStopMask);
-    gen.generate();
-    gen.saveToFile(fp);
-    mWrittenFiles.append(fp);
-  }
-}
-
-void BoardGerberExport::exportLayerTopSolderPaste() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixSolderPasteTop());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sTopSolderPaste);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
-}
-
-void BoardGerberExport::exportLayerBottomSolderPaste() const {
-  FilePath        fp = getOutputFilePath(mSettings->getSuffixSolderPasteBot());
-  GerberGenerator gen(
-      mProject.getMetadata().getName() % " - " % mBoard.getName(),
-      mBoard.getUuid(), mProject.getMetadata().getVersion());
-  drawLayer(gen, GraphicsLayer::sBotSolderPaste);
-  gen.generate();
-  gen.saveToFile(fp);
-  mWrittenFiles.append(fp);
+  gen.saveToFile(fp);  // can throw
+  return OutputState::Written;
 }
 
 int BoardGerberExport::drawNpthDrills(ExcellonGenerator& gen) const {
@@ -341,43 +359,52 @@ int BoardGerberExport::drawPthDrills(ExcellonGenerator& gen) const {
 
 void BoardGerberExport::drawLayer(GerberGenerator& gen,
                                   const QString&   layerName) const {
+  // pads, vias, traces and planes are drawn as united regions if enabled
+  bool mergeCopper = mSettings->getMergeCopperRegions() &&
+      GraphicsLayer::isCopperLayer(layerName);
+  if (mergeCopper) {
+    drawMergedCopper(gen, layerName);
+  }
+
   // draw footprints incl. pads
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
     Q_ASSERT(device);
-    drawFootprint(gen, device->getFootprint(), layerName);
+    drawFootprint(gen, device->getFootprint(), layerName, !mergeCopper);
   }
 
-  // draw vias
-  foreach (const BI_NetSegment* netsegment,
-           sortedByUuid(mBoard.getNetSegments())) {
-    Q_ASSERT(netsegment);
-    foreach (const BI_Via* via, sortedByUuid(netsegment->getVias())) {
-      Q_ASSERT(via);
-      drawVia(gen, *via, layerName);
+  if (!mergeCopper) {
+    // draw vias
+    foreach (const BI_NetSegment* netsegment,
+             sortedByUuid(mBoard.getNetSegments())) {
+      Q_ASSERT(netsegment);
+      foreach (const BI_Via* via, sortedByUuid(netsegment->getVias())) {
+        Q_ASSERT(via);
+        drawVia(gen, *via, layerName);
+      }
     }
-  }
 
-  // draw traces
-  foreach (const BI_NetSegment* netsegment,
-           sortedByUuid(mBoard.getNetSegments())) {
-    Q_ASSERT(netsegment);
-    foreach (const BI_NetLine* netline,
-             sortedByUuid(netsegment->getNetLines())) {
-      Q_ASSERT(netline);
-      if (netline->getLayer().getName() == layerName) {
-        gen.drawLine(netline->getStartPoint().getPosition(),
-                     netline->getEndPoint().getPosition(),
-                     positiveToUnsigned(netline->getWidth()));
+    // draw traces
+    foreach (const BI_NetSegment* netsegment,
+             sortedByUuid(mBoard.getNetSegments())) {
+      Q_ASSERT(netsegment);
+      foreach (const BI_NetLine* netline,
+               sortedByUuid(netsegment->getNetLines())) {
+        Q_ASSERT(netline);
+        if (netline->getLayer().getName() == layerName) {
+          gen.drawLine(netline->getStartPoint().getPosition(),
+                       netline->getEndPoint().getPosition(),
+                       positiveToUnsigned(netline->getWidth()));
+        }
       }
     }
-  }
 
-  // draw planes
-  foreach (const BI_Plane* plane, sortedByUuid(mBoard.getPlanes())) {
-    Q_ASSERT(plane);
-    if (plane->getLayerName() == layerName) {
-      foreach (const Path& fragment, plane->getFragments()) {
-        gen.drawPathArea(fragment);
+    // draw planes
+    foreach (const BI_Plane* plane, sortedByUuid(mBoard.getPlanes())) {
+      Q_ASSERT(plane);
+      if (plane->getLayerName() == layerName) {
+        foreach (const Path& fragment, plane->getFragments()) {
+          gen.drawPathArea(fragment);
+        }
       }
     }
   }
@@ -404,16 +431,69 @@ void BoardGerberExport::drawLayer(GerberGenerator& gen,
     if (layerName == text->getText().getLayerName()) {
       UnsignedLength lineWidth =
           calcWidthOfLayer(text->getText().getStrokeWidth(), layerName);
-      foreach (Path path, text->getText().getPaths()) {
-        path.rotate(text->getText().getRotation());
-        if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(text->getText().getPosition());
+      Transform transform(text->getText().getPosition(),
+                          text->getText().getRotation(),
+                          text->getText().getMirrored());
+      foreach (const Path& path, transform.map(text->getText().getPaths())) {
         gen.drawPathOutline(path, lineWidth);
       }
     }
   }
 }
 
+void BoardGerberExport::drawMergedCopper(GerberGenerator& gen,
+                                         const QString&   layerName) const {
+  // Collect the copper areas of all pads, vias, traces and planes, grouped by
+  // net signal (key: UUID, or empty for unconnected pads). The paths need to
+  // have the same orientation to be united with the non-zero fill rule.
+  QMap<QString, ClipperLib::Paths> areas;
+  auto addArea = [&](const NetSignal* netsignal, const Path& outline) {
+    ClipperLib::Path path =
+        ClipperHelpers::convert(outline, maxArcTolerance());
+    if (!ClipperLib::Orientation(path)) {
+      ClipperLib::ReversePath(path);
+    }
+    areas[netsignal ? netsignal->getUuid().toStr() : QString()].push_back(path);
+  };
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+      if (pad->isOnLayer(layerName)) {
+        addArea(pad->getCompSigInstNetSignal(), pad->getSceneOutline());
+      }
+    }
+  }
+  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      if (via->isOnLayer(layerName)) {
+        addArea(&netsegment->getNetSignal(), via->getSceneOutline());
+      }
+    }
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      if (netline->getLayer().getName() == layerName) {
+        addArea(&netsegment->getNetSignal(), netline->getSceneOutline());
+      }
+    }
+  }
+  foreach (const BI_Plane* plane, mBoard.getPlanes()) {
+    if (plane->getLayerName() == layerName) {
+      foreach (const Path& fragment, plane->getFragments()) {
+        addArea(&plane->getNetSignal(), fragment);
+      }
+    }
+  }
+
+  // Unite the areas of each net signal and draw them as regions. Holes are
+  // converted to cut-ins since Gerber regions must not contain holes.
+  for (auto it = areas.constBegin(); it != areas.constEnd(); ++it) {
+    std::unique_ptr<ClipperLib::PolyTree> tree =
+        ClipperHelpers::uniteToTree(it.value());  // can throw
+    foreach (const Path& region,
+             ClipperHelpers::convert(ClipperHelpers::flattenTree(*tree))) {
+      gen.drawPathArea(region);
+    }
+  }
+}
+
 void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via,
                                 const QString& layerName) const {
   bool drawCopper = via.isOnLayer(layerName);
@@ -449,12 +529,18 @@ void BoardGerberExport::drawVia(GerberGenerator& gen, const BI_Via& via,
 
 void BoardGerberExport::drawFootprint(GerberGenerator&    gen,
                                       const BI_Footprint& footprint,
-                                      const QString&      layerName) const {
+                                      const QString&      layerName,
+                                      bool                drawPads) const {
   // draw pads
-  foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-    drawFootprintPad(gen, *pad, layerName);
+  if (drawPads) {
+    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+      drawFootprintPad(gen, *pad, layerName);
+    }
   }
 
+  const Transform transform(footprint.getPosition(), footprint.getRotation(),
+                            footprint.getIsMirrored());
+
   // draw polygons
   for (const Polygon& polygon :
        footprint.getLibFootprint().getPolygons().sortedByUuid()) {
@@ -462,10 +548,7 @@ void BoardGerberExport::drawFootprint(GerberGenerator&    gen,
                         ? GraphicsLayer::getMirroredLayerName(layerName)
                         : layerName;
     if (layer == polygon.getLayerName()) {
-      Path path = polygon.getPath();
-      path.rotate(footprint.getRotation());
-      if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
-      path.translate(footprint.getPosition());
+      Path path = transform.map(polygon.getPath());
       gen.drawPathOutline(path,
                           calcWidthOfLayer(polygon.getLineWidth(), layer));
       // Only fill closed paths (for consistency with the appearance in the
@@ -483,12 +566,8 @@ void BoardGerberExport::drawFootprint(GerberGenerator&    gen,
                         ? GraphicsLayer::getMirroredLayerName(layerName)
                         : layerName;
     if (layer == circle.getLayerName()) {
-      Circle copy        = circle;
-      Point  absolutePos = copy.getCenter();
-      absolutePos.rotate(footprint.getRotation());
-      if (footprint.getIsMirrored()) absolutePos.mirror(Qt::Horizontal);
-      absolutePos += footprint.getPosition();
-      copy.setCenter(absolutePos);
+      Circle copy = circle;
+      copy.setCenter(transform.map(copy.getCenter()));
       copy.setLineWidth(calcWidthOfLayer(copy.getLineWidth(), layer));
       gen.drawCircleOutline(copy);
       if (copy.isFilled()) {
@@ -503,10 +582,9 @@ void BoardGerberExport::drawFootprint(GerberGenerator&    gen,
     if (layerName == text->getText().getLayerName()) {
       UnsignedLength lineWidth =
           calcWidthOfLayer(text->getText().getStrokeWidth(), layerName);
-      foreach (Path path, text->getText().getPaths()) {
-        path.rotate(text->getText().getRotation());
-        if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(text->getPosition());
+      Transform transform(text->getPosition(), text->getText().getRotation(),
+                          text->getText().getMirrored());
+      foreach (const Path& path, transform.map(text->getText().getPaths())) {
         gen.drawPathOutline(path, lineWidth);
       }
     }
@@ -609,6 +687,14 @@ FilePath BoardGerberExport::getOutputFilePath(const QString& suffix) const
  *  Static Methods
  ******************************************************************************/
 
+bool BoardGerberExport::isFileUpToDate(const FilePath&   fp,
+                                       const QByteArray& fingerprint) {
+  // Existing files are kept as-is (e.g. to keep their modification time) if
+  // they only differ in volatile data like the creation date.
+  return fp.isExistingFile() &&
+      (CamOutputFingerprint::fromFile(fp) == fingerprint);  // can throw
+}
+
 UnsignedLength BoardGerberExport::calcWidthOfLayer(
     const UnsignedLength& width, const QString& name) noexcept {
   if ((name == GraphicsLayer::sBoardOutlines) &&
@@ -30,6 +30,7 @@
 #include <QtCore>
 
 #include <algorithm>
+#include <functional>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
@@ -74,9 +75,41 @@ public:
     return mWrittenFiles;
   }
 
+  /**
+   * @brief Get the output files which were already up to date
+   *
+   * Existing files which only differ in volatile data (e.g. the creation
+   * date) from the exported data are not overwritten.
+   *
+   * @return All files of #getWrittenFiles() which were left untouched
+   */
+  const QVector<FilePath>& getReusedFiles() const noexcept {
+    return mReusedFiles;
+  }
+
   // General Methods
+
+  /**
+   * @brief Generate all Gerber and Excellon files
+   *
+   * Emits #exportProgress() and #fileExported() during the export. This
+   * method may be called from any thread as long as the board is not modified
+   * meanwhile (see librepcb::project::Board::createSnapshot()). The signals
+   * are then emitted from worker threads.
+   *
+   * @throw UserCanceled  If #abort() was called.
+   * @throw Exception     On error.
+   */
   void exportAllLayers() const;
 
+  /**
+   * @brief Abort a running #exportAllLayers() (thread-safe)
+   *
+   * Files which are being generated at the moment are still finished, but
+   * no further files are started. The abort cannot be reverted.
+   */
+  void abort() noexcept { mAbortRequested.storeRelease(1); }
+
   // Inherited from AttributeProvider
   /// @copydoc librepcb::AttributeProvider::getBuiltInAttributeValue()
   QString getBuiltInAttributeValue(const QString& key) const noexcept override;
@@ -90,35 +123,59 @@ public:
 signals:
   void attributesChanged() override;
 
+  /**
+   * @brief Emitted whenever an output file has been processed
+   *
+   * @param finished    Number of already processed output files
+   * @param total       Total number of output files to process
+   */
+  void exportProgress(int finished, int total) const;
+
+  /**
+   * @brief Emitted for every written (or reused) output file
+   *
+   * @param filePath    The output file
+   * @param reused      Whether the existing file was up to date already
+   * @param durationMs  Time needed to generate the file
+   */
+  void fileExported(const FilePath& filePath, bool reused,
+                    qint64 durationMs) const;
+
 private:
+  // Types
+  enum class OutputState { NotCreated, Written, Reused };
+
   // Private Methods
-  void exportDrills() const;
-  void exportDrillsNpth() const;
-  void exportDrillsPth() const;
-  void exportLayerBoardOutlines() const;
-  void exportLayerTopCopper() const;
-  void exportLayerInnerCopper() const;
-  void exportLayerBottomCopper() const;
-  void exportLayerTopSolderMask() const;
-  void exportLayerBottomSolderMask() const;
-  void exportLayerTopSilkscreen() const;
-  void exportLayerBottomSilkscreen() const;
-  void exportLayerTopSolderPaste() const;
-  void exportLayerBottomSolderPaste() const;
+  OutputState exportDrills(const FilePath& fp) const;
+  OutputState exportDrillsNpth(const FilePath& fp) const;
+  OutputState exportDrillsPth(const FilePath& fp) const;
+  OutputState exportLayer(const FilePath& fp, const QString& layerName) const;
+  OutputState exportLayerSilkscreen(const FilePath&    fp,
+                                    const QStringList& layers,
+                                    const QString&     stopMaskLayer) const;
+  OutputState saveGerber(const GerberGenerator& gen, const FilePath& fp) const;
+  OutputState saveExcellon(const ExcellonGenerator& gen,
+                           const FilePath&          fp) const;
 
   int  drawNpthDrills(ExcellonGenerator& gen) const;
   int  drawPthDrills(ExcellonGenerator& gen) const;
   void drawLayer(GerberGenerator& gen, const QString& layerName) const;
+  void drawMergedCopper(GerberGenerator& gen, const QString& layerName) const;
   void drawVia(GerberGenerator& gen, const BI_Via& via,
                const QString& layerName) const;
   void drawFootprint(GerberGenerator& gen, const BI_Footprint& footprint,
-                     const QString& layerName) const;
+                     const QString& layerName, bool drawPads) const;
   void drawFootprintPad(GerberGenerator& gen, const BI_FootprintPad& pad,
                         const QString& layerName) const;
 
   FilePath getOutputFilePath(const QString& suffix) const noexcept;
 
   // Static Methods
+  static bool           isFileUpToDate(const FilePath&   fp,
+                                       const QByteArray& fingerprint);
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
   static UnsignedLength calcWidthOfLayer(const UnsignedLength& width,
                                          const QString&        name) noexcept;
   template <typename T>
@@ -137,6 +194,8 @@ private:
   QScopedPointer<const BoardFabricationOutputSettings> mSettings;
   mutable int                                          mCurrentInnerCopperLayer;
   mutable QVector<FilePath>                            mWrittenFiles;
+  mutable QVector<FilePath>                            mReusedFiles;
+  QAtomicInt                                           mAbortRequested;
 };
 
 /*******************************************************************************
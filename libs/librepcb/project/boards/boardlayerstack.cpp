@@ -76,6 +76,7 @@ BoardLayerStack::BoardLayerStack(Board& board)
 }
 
 BoardLayerStack::~BoardLayerStack() noexcept {
+  mLayersByName.clear();
   qDeleteAll(mLayers);
   mLayers.clear();
 }
@@ -144,6 +145,7 @@ void BoardLayerStack::serialize(SExpression& root) const {
 void BoardLayerStack::layerAttributesChanged() noexcept {
   if (!mLayersChanged) {
     emit mBoard.attributesChanged();
+    emit mBoard.designRulesOrLayersChanged();
     mLayersChanged = true;
   }
 }
@@ -223,6 +225,7 @@ void BoardLayerStack::addLayer(GraphicsLayer* layer) noexcept {
   connect(layer, &GraphicsLayer::attributesChanged, this,
           &BoardLayerStack::layerAttributesChanged, Qt::QueuedConnection);
   mLayers.append(layer);
+  mLayersByName.insert(layer->getName(), layer);
 }
 
 /*******************************************************************************
@@ -71,12 +71,7 @@ public:
 
   /// @copydoc ::librepcb::IF_GraphicsLayerProvider::getLayer()
   GraphicsLayer* getLayer(const QString& name) const noexcept override {
-    foreach (GraphicsLayer* layer, mLayers) {
-      if (layer->getName() == name) {
-        return layer;
-      }
-    }
-    return nullptr;
+    return mLayersByName.value(name, nullptr);
   }
 
   // Setters
@@ -101,8 +96,9 @@ private:
 
   // General
   Board& mBoard;  ///< A reference to the Board object (from the ctor)
-  QList<GraphicsLayer*> mLayers;
-  bool                  mLayersChanged;
+  QList<GraphicsLayer*>           mLayers;
+  QHash<QString, GraphicsLayer*> mLayersByName;  ///< Same as #mLayers
+  bool                           mLayersChanged;
 
   // Settings
   int mInnerLayerCount;
@@ -0,0 +1,185 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardoutlineareacache.h"
+
+#include "board.h"
+#include "items/bi_device.h"
+#include "items/bi_footprint.h"
+#include "items/bi_polygon.h"
+
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/library/pkg/footprint.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardOutlineAreaCache::BoardOutlineAreaCache(Board& board) noexcept
+  : mBoard(board),
+    mMutex(),
+    mRevisionStamp(0),
+    mBaseAreas(),
+    mOffsetAreas() {
+}
+
+BoardOutlineAreaCache::~BoardOutlineAreaCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+uint BoardOutlineAreaCache::getRevisionStamp() const noexcept {
+  uint stamp = qHash(GraphicsLayer::sBoardOutlines);
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+      stamp = qHash(polygon->getRevision(), stamp);
+    }
+  }
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+      if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
+        // the footprint revision covers its position, rotation and mirroring
+        stamp = qHash(device->getFootprint().getRevision(), stamp);
+        break;
+      }
+    }
+  }
+  return stamp;
+}
+
+QVector<Path> BoardOutlineAreaCache::getOutlines() const noexcept {
+  QVector<Path> outlines;
+  foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
+    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+      outlines.append(polygon->getPolygon().getPath());
+    }
+  }
+  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    const BI_Footprint& footprint = device->getFootprint();
+    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+      if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
+        Path path = polygon.getPath();
+        path.rotate(footprint.getRotation());
+        if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
+        path.translate(footprint.getPosition());
+        outlines.append(path);
+      }
+    }
+  }
+  return outlines;
+}
+
+ClipperLib::Paths BoardOutlineAreaCache::getArea(
+    const Length& offset, const PositiveLength& maxArcTolerance) {
+  return getArea(getRevisionStamp(), getOutlines(), offset, maxArcTolerance);
+}
+
+ClipperLib::Paths BoardOutlineAreaCache::getArea(
+    uint revisionStamp, const QVector<Path>& outlines, const Length& offset,
+    const PositiveLength& maxArcTolerance) {
+  ClipperLib::Paths paths;
+  if (tryGetOffsetArea(revisionStamp, offset, maxArcTolerance, paths)) {
+    return paths;
+  }
+
+  // Calculate the areas without holding the lock to allow other threads
+  // calculating other offsets in parallel. The area without offset is
+  // calculated only once and then shared by all offsets.
+  if (!tryGetBaseArea(revisionStamp, maxArcTolerance, paths)) {
+    ClipperLib::Paths   outlinePaths;
+    ClipperLib::Clipper clipper;
+    foreach (const Path& outline, outlines) {
+      outlinePaths.push_back(ClipperHelpers::convert(outline, maxArcTolerance));
+    }
+    clipper.AddPaths(outlinePaths, ClipperLib::ptSubject, true);
+    clipper.Execute(ClipperLib::ctXor, paths, ClipperLib::pftEvenOdd,
+                    ClipperLib::pftEvenOdd);
+    QMutexLocker lock(&mMutex);
+    if (revisionStamp != mRevisionStamp) {
+      mRevisionStamp = revisionStamp;
+      mBaseAreas.clear();
+      mOffsetAreas.clear();
+    }
+    mBaseAreas.insert(*maxArcTolerance, paths);
+  }
+  ClipperHelpers::offset(paths, offset, maxArcTolerance);  // can throw
+
+  QMutexLocker lock(&mMutex);
+  if (revisionStamp == mRevisionStamp) {
+    mOffsetAreas.insert(Key(offset, *maxArcTolerance), paths);
+  }
+  return paths;
+}
+
+void BoardOutlineAreaCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mBaseAreas.clear();
+  mOffsetAreas.clear();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool BoardOutlineAreaCache::tryGetBaseArea(
+    uint revisionStamp, const PositiveLength& maxArcTolerance,
+    ClipperLib::Paths& paths) const noexcept {
+  QMutexLocker lock(&mMutex);
+  auto         it = mBaseAreas.constFind(*maxArcTolerance);
+  if ((revisionStamp == mRevisionStamp) && (it != mBaseAreas.constEnd())) {
+    paths = *it;
+    return true;
+  }
+  return false;
+}
+
+bool BoardOutlineAreaCache::tryGetOffsetArea(
+    uint revisionStamp, const Length& offset,
+    const PositiveLength& maxArcTolerance, ClipperLib::Paths& paths) const
+    noexcept {
+  QMutexLocker lock(&mMutex);
+  auto         it = mOffsetAreas.constFind(Key(offset, *maxArcTolerance));
+  if ((revisionStamp == mRevisionStamp) && (it != mOffsetAreas.constEnd())) {
+    paths = *it;
+    return true;
+  }
+  return false;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
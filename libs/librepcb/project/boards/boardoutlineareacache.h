@@ -0,0 +1,162 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDOUTLINEAREACACHE_H
+#define LIBREPCB_PROJECT_BOARDOUTLINEAREACACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/length.h>
+#include <polyclipping/clipper.hpp>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+/*******************************************************************************
+ *  Class BoardOutlineAreaCache
+ ******************************************************************************/
+
+/**
+ * @brief The BoardOutlineAreaCache class caches the board area of a
+ *        ::librepcb::project::Board
+ *
+ * The board area is determined by XOR-ing all polygons on the board outlines
+ * layer, of the board itself as well as of all footprints. Since it is needed
+ * by every plane and by the design rule check, it is calculated only once per
+ * revision of these polygons. In addition, the area shrunk or grown by
+ * arbitrary offsets (i.e. clearances) is cached as well, so all planes with
+ * the same clearance share the same offset area.
+ *
+ * Like ::librepcb::project::BoardCopperPathCache, entries are tagged with a
+ * revision stamp (see #getRevisionStamp()) and thus never need to be
+ * invalidated explicitly.
+ *
+ * @note All methods are thread-safe, as long as the board is not modified
+ *       while they are running.
+ */
+class BoardOutlineAreaCache final {
+public:
+  // Constructors / Destructor
+  BoardOutlineAreaCache()                                   = delete;
+  BoardOutlineAreaCache(const BoardOutlineAreaCache& other) = delete;
+  explicit BoardOutlineAreaCache(Board& board) noexcept;
+  ~BoardOutlineAreaCache() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Get the current revision stamp of the board outlines
+   *
+   * @return A stamp which changes whenever any board outline polygon is
+   *         modified, added or removed
+   */
+  uint getRevisionStamp() const noexcept;
+
+  /**
+   * @brief Get all board outline polygons in scene coordinates
+   *
+   * @return Paths of all board and footprint polygons on the board outlines
+   *         layer
+   */
+  QVector<Path> getOutlines() const noexcept;
+
+  /**
+   * @brief Get the (offset) board area
+   *
+   * @param offset            Offset to apply to the area (negative to shrink
+   *                          it).
+   * @param maxArcTolerance   Maximum tolerance for approximating arcs.
+   *
+   * @return The (possibly cached) board area
+   *
+   * @throw Exception if the area could not be calculated.
+   */
+  ClipperLib::Paths getArea(const Length&         offset,
+                            const PositiveLength& maxArcTolerance);
+
+  /**
+   * @brief Get the (offset) board area from a snapshot of its outlines
+   *
+   * In contrast to the other overload, this method does not access the board
+   * at all, so it can be used by worker threads even while the board is
+   * modified.
+   *
+   * @param revisionStamp     Revision stamp of the outlines.
+   * @param outlines          The outlines as returned by #getOutlines() in
+   *                          the moment the stamp was determined.
+   * @param offset            Offset to apply to the area.
+   * @param maxArcTolerance   Maximum tolerance for approximating arcs.
+   *
+   * @return The (possibly cached) board area
+   *
+   * @throw Exception if the area could not be calculated.
+   */
+  ClipperLib::Paths getArea(uint revisionStamp, const QVector<Path>& outlines,
+                            const Length&         offset,
+                            const PositiveLength& maxArcTolerance);
+
+  /**
+   * @brief Remove all entries from the cache to release memory
+   */
+  void clear() noexcept;
+
+  // Operator Overloadings
+  BoardOutlineAreaCache& operator=(const BoardOutlineAreaCache& rhs) = delete;
+
+private:  // Methods
+  bool tryGetBaseArea(uint revisionStamp, const PositiveLength& maxArcTolerance,
+                      ClipperLib::Paths& paths) const noexcept;
+  bool tryGetOffsetArea(uint revisionStamp, const Length& offset,
+                        const PositiveLength& maxArcTolerance,
+                        ClipperLib::Paths&    paths) const noexcept;
+
+private:  // Types
+  typedef QPair<Length, Length> Key;  ///< Offset and arc tolerance
+
+private:  // Data
+  Board&         mBoard;
+  mutable QMutex mMutex;  ///< Protects all the members below
+
+  /// Revision stamp of all cached areas
+  uint mRevisionStamp;
+
+  /// Areas without offset (key: arc tolerance)
+  QHash<Length, ClipperLib::Paths> mBaseAreas;
+
+  /// Offset areas
+  QHash<Key, ClipperLib::Paths> mOffsetAreas;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDOUTLINEAREACACHE_H
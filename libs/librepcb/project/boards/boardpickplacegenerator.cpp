@@ -63,13 +63,29 @@ std::shared_ptr<PickPlaceData> BoardPickPlaceGenerator::generate() noexcept {
   const QStringList& locale =
       mBoard.getProject().getSettings().getLocaleOrder();
 
+  // Many devices share the same library elements, so look up their localized
+  // names only once per library element instead of once per device.
+  QHash<const library::Device*, QString>  deviceNames;
+  QHash<const library::Package*, QString> packageNames;
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
     QString designator = *device->getComponentInstance().getName();
     QString value = device->getComponentInstance().getValue(true).trimmed();
-    QString deviceName  = *device->getLibDevice().getNames().value(locale);
-    QString packageName = *device->getLibPackage().getNames().value(locale);
-    Point   position    = device->getPosition();
-    Angle   rotation    = device->getRotation();
+    const library::Device* libDevice = &device->getLibDevice();
+    auto                   devIt     = deviceNames.constFind(libDevice);
+    if (devIt == deviceNames.constEnd()) {
+      devIt = deviceNames.insert(libDevice,
+                                 *libDevice->getNames().value(locale));
+    }
+    const library::Package* libPackage = &device->getLibPackage();
+    auto                    pkgIt      = packageNames.constFind(libPackage);
+    if (pkgIt == packageNames.constEnd()) {
+      pkgIt = packageNames.insert(libPackage,
+                                  *libPackage->getNames().value(locale));
+    }
+    const QString& deviceName  = *devIt;
+    const QString& packageName = *pkgIt;
+    Point          position    = device->getPosition();
+    Angle          rotation    = device->getRotation();
     PickPlaceDataItem::BoardSide boardSide =
         device->getIsMirrored() ? PickPlaceDataItem::BoardSide::BOTTOM
                                 : PickPlaceDataItem::BoardSide::TOP;
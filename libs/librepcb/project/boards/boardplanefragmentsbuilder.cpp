@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "boardplanefragmentsbuilder.h"
 
+#include "board.h"
+#include "boardoutlineareacache.h"
 #include "items/bi_device.h"
 #include "items/bi_footprint.h"
 #include "items/bi_footprintpad.h"
@@ -30,11 +32,13 @@
 #include "items/bi_netpoint.h"
 #include "items/bi_netsegment.h"
 #include "items/bi_plane.h"
-#include "items/bi_polygon.h"
 #include "items/bi_via.h"
 
-#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/tracer.h>
 #include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/clippershapecache.h>
+#include <librepcb/common/utils/taskscheduler.h>
+#include <librepcb/common/utils/transform.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/footprintpad.h>
 
@@ -46,32 +50,279 @@
 namespace librepcb {
 namespace project {
 
+/*******************************************************************************
+ *  Helper Functions
+ ******************************************************************************/
+
+/// Planes taking longer than this to rebuild are reported with a warning
+static const qint64 SLOW_REBUILD_THRESHOLD_MS = 2000;
+
+static ClipperLib::IntRect inflatedRect(const ClipperLib::IntRect& rect,
+                                        ClipperLib::cInt offset) noexcept {
+  return {rect.left - offset, rect.top - offset, rect.right + offset,
+          rect.bottom + offset};
+}
+
+static ClipperLib::Path rectToPath(const ClipperLib::IntRect& rect) noexcept {
+  return {
+      ClipperLib::IntPoint(rect.left, rect.top),
+      ClipperLib::IntPoint(rect.right, rect.top),
+      ClipperLib::IntPoint(rect.right, rect.bottom),
+      ClipperLib::IntPoint(rect.left, rect.bottom),
+  };
+}
+
+static bool containsRect(const ClipperLib::IntRect& outer,
+                         const ClipperLib::IntRect& inner) noexcept {
+  return (outer.left <= inner.left) && (outer.top <= inner.top) &&
+         (outer.right >= inner.right) && (outer.bottom >= inner.bottom);
+}
+
+/**
+ * Remove vertices from a closed path, as long as the outline moves inwards
+ * by at most the given tolerance (i.e. copper is never added). Vertices
+ * occuring more than once (the cut-ins created by flattening holes) are
+ * always kept to not break the cut-ins.
+ */
+static ClipperLib::Path simplifiedPath(const ClipperLib::Path& path,
+                                       qreal tolerance) noexcept {
+  if (path.size() <= 3) return path;
+  QHash<QPair<ClipperLib::cInt, ClipperLib::cInt>, int> occurrences;
+  for (const ClipperLib::IntPoint& p : path) {
+    ++occurrences[qMakePair(p.X, p.Y)];
+  }
+
+  // Check if a point is on the chord a->b or outside of it, within tolerance.
+  // The inside of paths with positive area is on the left side.
+  const bool positive = ClipperLib::Orientation(path);
+  auto isCutOff = [positive, tolerance](const ClipperLib::IntPoint& a,
+                                        const ClipperLib::IntPoint& b,
+                                        const ClipperLib::IntPoint& p) {
+    const qreal dx     = b.X - a.X;
+    const qreal dy     = b.Y - a.Y;
+    const qreal length = qSqrt(dx * dx + dy * dy);
+    if (length <= 0) return false;
+    qreal distance = (dy * (p.X - a.X) - dx * (p.Y - a.Y)) / length;
+    if (!positive) distance = -distance;
+    return (distance >= 0) && (distance <= tolerance);
+  };
+
+  // Each removed vertex must stay within the tolerance of the chord between
+  // the surrounding kept vertices. Long runs are not worth the effort.
+  static const std::size_t maxRunLength = 32;
+  ClipperLib::Path         result;
+  result.reserve(path.size());
+  result.push_back(path.front());
+  std::size_t runStart = 1;  // first removed vertex after the last kept one
+  for (std::size_t i = 1; i < path.size(); ++i) {
+    const ClipperLib::IntPoint& next   = path[(i + 1) % path.size()];
+    bool                        remove = (i - runStart < maxRunLength) &&
+        (occurrences.value(qMakePair(path[i].X, path[i].Y)) == 1);
+    for (std::size_t k = runStart; remove && (k <= i); ++k) {
+      remove = isCutOff(result.back(), next, path[k]);
+    }
+    if (!remove) {
+      result.push_back(path[i]);
+      runStart = i + 1;
+    }
+  }
+  return (result.size() >= 3) ? result : path;
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
-BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept
-  : mPlane(plane) {
+BoardPlaneFragmentsBuilder::BoardPlaneFragmentsBuilder(
+    const BI_Plane& plane) noexcept
+  : mPlane(&plane),
+    mUuid(plane.getUuid()),
+    mMinWidth(plane.getMinWidth()),
+    mMinClearance(plane.getMinClearance()),
+    mKeepOrphans(plane.getKeepOrphans()),
+    mConnectStyle(plane.getConnectStyle()),
+    mOutline(ClipperHelpers::convert(plane.getOutline(), maxArcTolerance())),
+    mFragments(plane.getFragments()),
+    mFragmentsFingerprint(plane.getFragmentsFingerprint()),
+    mBoardAreaValid(false),
+    mStatistics{0, 0, 0, 0, 0} {
+  collectBoardArea(plane);
+  collectObstacles(plane);
 }
 
 BoardPlaneFragmentsBuilder::~BoardPlaneFragmentsBuilder() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QList<const BI_Plane*> BoardPlaneFragmentsBuilder::getDependencies() const
+    noexcept {
+  QList<const BI_Plane*> planes;
+  foreach (const OtherPlane& other, mOtherPlanes) {
+    planes.append(other.plane);
+  }
+  return planes;
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
 
-QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
-  try {
-    mResult.clear();
-    addPlaneOutline();
-    clipToBoardOutline();
-    subtractOtherObjects();
-    ensureMinimumWidth();
-    flattenResult();
-    if (!mPlane.getKeepOrphans()) {
-      removeOrphans();
+QVector<Path> BoardPlaneFragmentsBuilder::buildFragments(
+    const PlaneFragments& planeFragments) noexcept {
+  QElapsedTimer timer;
+  timer.start();
+  mStatistics.passCount   = 0;
+  QVector<Path> fragments = buildAllFragments(planeFragments);
+  updateStatistics(fragments, timer.elapsed());
+  return fragments;
+}
+
+QVector<Path> BoardPlaneFragmentsBuilder::buildFragments(
+    const QVector<Path>&  dirtyAreas,
+    const PlaneFragments& planeFragments) noexcept {
+  QElapsedTimer timer;
+  timer.start();
+  mStatistics.passCount   = 0;
+  QVector<Path> fragments = buildDirtyFragments(dirtyAreas, planeFragments);
+  updateStatistics(fragments, timer.elapsed());
+  return fragments;
+}
+
+QByteArray BoardPlaneFragmentsBuilder::calcFingerprint(
+    const PlaneFragments& planeFragments) const noexcept {
+  // The paths are sorted to get a fingerprint which is independent of the
+  // order of objects in the board (which changes when saving and loading).
+  QCryptographicHash hash(QCryptographicHash::Sha256);
+  auto addPaths = [&hash](const ClipperLib::Paths& paths) {
+    QList<QByteArray> data;
+    for (const ClipperLib::Path& path : paths) {
+      QByteArray pathData;
+      for (const ClipperLib::IntPoint& p : path) {
+        pathData += QByteArray::number(p.X) + ',';
+        pathData += QByteArray::number(p.Y) + ';';
+      }
+      data.append(pathData);
+    }
+    std::sort(data.begin(), data.end());
+    hash.addData(QByteArray::number(data.count()) + '\n');
+    foreach (const QByteArray& pathData, data) {
+      hash.addData(pathData + '\n');
+    }
+  };
+
+  // Increase the version number whenever the algorithm to build the fragments
+  // changes, to invalidate fingerprints calculated by older versions.
+  hash.addData("v3;");
+  hash.addData(QByteArray::number(maxArcTolerance()->toNm()) + ';');
+  hash.addData(QByteArray::number(mMinWidth->toNm()) + ';');
+  hash.addData(QByteArray::number(mMinClearance->toNm()) + ';');
+  hash.addData(QByteArray::number(static_cast<int>(mConnectStyle)) + ';');
+  hash.addData(mKeepOrphans ? "1;" : "0;");
+  addPaths(ClipperLib::Paths{mOutline});
+  addPaths(mBoardArea);
+  addPaths(getOtherPlanesPaths(planeFragments));
+  addPaths(mCutOuts);
+  addPaths(mConnectedAreas);
+  return hash.result();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QHash<const BI_Plane*, BoardPlaneFragmentsBuilder::Result>
+    BoardPlaneFragmentsBuilder::buildAll(
+        const QList<std::shared_ptr<BoardPlaneFragmentsBuilder>>&
+            builders) noexcept {
+  // Each job waits for the jobs of its dependencies, which were always
+  // started before since the builders are sorted by priority. Waiting from
+  // within the thread pool is fine because TaskScheduler runs a not yet
+  // started job in the waiting thread.
+  QHash<const BI_Plane*, QFuture<Result>> jobs;
+  foreach (const std::shared_ptr<BoardPlaneFragmentsBuilder>& builder,
+           builders) {
+    QHash<const BI_Plane*, QFuture<Result>> dependencies;
+    foreach (const BI_Plane* plane, builder->getDependencies()) {
+      if (jobs.contains(plane)) {
+        dependencies.insert(plane, jobs.value(plane));
+      }
+    }
+    jobs.insert(
+        builder->getPlane(),
+        TaskScheduler::run(
+            TaskScheduler::Priority::Normal, [builder, dependencies]() {
+              PlaneFragments fragments;
+              for (auto it = dependencies.constBegin();
+                   it != dependencies.constEnd(); ++it) {
+                fragments.insert(it.key(), it.value().result().fragments);
+              }
+              Result result;
+              result.fragments   = builder->buildFragments(fragments);
+              result.fingerprint = builder->calcFingerprint(fragments);
+              result.statistics  = builder->getStatistics();
+              return result;
+            }));
+  }
+
+  QHash<const BI_Plane*, Result> results;
+  for (auto it = jobs.constBegin(); it != jobs.constEnd(); ++it) {
+    results.insert(it.key(), it.value().result());
+  }
+  return results;
+}
+
+QHash<const BI_Plane*, BoardPlaneFragmentsBuilder::Result>
+    BoardPlaneFragmentsBuilder::buildAllIncremental(
+        const QList<std::shared_ptr<BoardPlaneFragmentsBuilder>>& builders,
+        const QVector<Path>& dirtyAreas) noexcept {
+  // Modified fragments of a plane are obstacles for the planes depending on
+  // it, so they are dirty areas for these planes.
+  QHash<const BI_Plane*, Result>        results;
+  QHash<const BI_Plane*, QVector<Path>> modifiedFragments;
+  PlaneFragments                        newFragments;
+  foreach (const std::shared_ptr<BoardPlaneFragmentsBuilder>& builder,
+           builders) {
+    if (builder->mFragmentsFingerprint.isEmpty()) {
+      continue;  // never built, thus nothing to update
+    }
+    QVector<Path> planeDirtyAreas = dirtyAreas;
+    foreach (const BI_Plane* plane, builder->getDependencies()) {
+      planeDirtyAreas += modifiedFragments.value(plane);
     }
+    Result result;
+    result.fragments   = builder->buildFragments(planeDirtyAreas, newFragments);
+    result.fingerprint = builder->calcFingerprint(newFragments);
+    result.statistics  = builder->getStatistics();
+    if (result.fragments != builder->mFragments) {
+      QVector<Path>& modified = modifiedFragments[builder->getPlane()];
+      foreach (const Path& fragment, result.fragments) {
+        if (!builder->mFragments.contains(fragment)) {
+          modified.append(fragment);
+        }
+      }
+      foreach (const Path& fragment, builder->mFragments) {
+        if (!result.fragments.contains(fragment)) {
+          modified.append(fragment);
+        }
+      }
+      newFragments.insert(builder->getPlane(), result.fragments);
+    }
+    results.insert(builder->getPlane(), result);
+  }
+  return results;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QVector<Path> BoardPlaneFragmentsBuilder::buildAllFragments(
+    const PlaneFragments& planeFragments) noexcept {
+  try {
+    build(nullptr, planeFragments);
     return ClipperHelpers::convert(mResult);
   } catch (const Exception& e) {
     qCritical() << "Failed to build plane fragments! Leave plane empty...";
@@ -80,131 +331,213 @@ QVector<Path> BoardPlaneFragmentsBuilder::buildFragments() noexcept {
   }
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
+QVector<Path> BoardPlaneFragmentsBuilder::buildDirtyFragments(
+    const QVector<Path>&  dirtyAreas,
+    const PlaneFragments& planeFragments) noexcept {
+  if (dirtyAreas.isEmpty() || mFragmentsFingerprint.isEmpty()) {
+    return mFragments;
+  }
 
-void BoardPlaneFragmentsBuilder::addPlaneOutline() {
-  mResult.push_back(
-      ClipperHelpers::convert(mPlane.getOutline(), maxArcTolerance()));
-}
+  try {
+    // Fragments outside the affected area are not influenced by the dirty
+    // areas since obstacles only affect their clearance area, and the minimum
+    // width only affects areas within the minimum width.
+    const Length margin = *mMinClearance + *mMinWidth + *maxArcTolerance();
+    const ClipperLib::IntRect affected =
+        inflatedRect(ClipperHelpers::getBoundingRect(ClipperHelpers::convert(
+                         dirtyAreas, maxArcTolerance())),
+                     margin.toNm());
+    const ClipperLib::IntRect planeArea =
+        ClipperHelpers::getBoundingRect(mOutline);
+    if (!ClipperHelpers::intersects(affected, planeArea)) {
+      return mFragments;  // plane not affected at all
+    }
 
-void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
-  // determine board area
-  ClipperLib::Paths   boardArea;
-  ClipperLib::Clipper boardAreaClipper;
-  foreach (const BI_Polygon* polygon, mPlane.getBoard().getPolygons()) {
-    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
-      ClipperLib::Path path = ClipperHelpers::convert(
-          polygon->getPolygon().getPath(), maxArcTolerance());
-      boardAreaClipper.AddPath(path, ClipperLib::ptSubject, true);
+    // Fragments are always within the board area, so a window covering both
+    // the plane outline and the board area leads to the same fragments as
+    // building the whole plane.
+    ClipperLib::IntRect fillArea = planeArea;
+    if (!mBoardArea.empty()) {
+      const ClipperLib::IntRect boardArea =
+          ClipperHelpers::getBoundingRect(mBoardArea);
+      fillArea = {qMax(planeArea.left, boardArea.left),
+                  qMax(planeArea.top, boardArea.top),
+                  qMin(planeArea.right, boardArea.right),
+                  qMin(planeArea.bottom, boardArea.bottom)};
     }
-  }
-  foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
-      if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
-        Path path = polygon.getPath();
-        path.rotate(footprint.getRotation());
-        if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(footprint.getPosition());
-        ClipperLib::Path clipperPath =
-            ClipperHelpers::convert(path, maxArcTolerance());
-        boardAreaClipper.AddPath(clipperPath, ClipperLib::ptSubject, true);
+
+    // Old fragments intersecting the affected area are replaced completely,
+    // so the window needs to cover them at least. If they already reach the
+    // fill area (e.g. a single large pour), growing the window step by step
+    // would end up with the whole plane anyway, so all fragments are built
+    // immediately.
+    ClipperLib::Paths dirtyFragments{rectToPath(affected)};
+    foreach (const Path& fragment, mFragments) {
+      ClipperLib::Path path =
+          ClipperHelpers::convert(fragment, maxArcTolerance());
+      if (ClipperHelpers::intersects(ClipperHelpers::getBoundingRect(path),
+                                     affected)) {
+        dirtyFragments.push_back(path);
+      }
+    }
+
+    // The window border truncates fragments, and the minimum width step
+    // modifies them up to a distance of the minimum width from the border.
+    // Fragments staying away further from the border are complete and thus
+    // valid. So grow the window until all fragments intersecting the affected
+    // area are valid, or until it covers the whole fill area.
+    ClipperLib::IntRect window = inflatedRect(
+        ClipperHelpers::getBoundingRect(dirtyFragments), 2 * margin.toNm());
+    while (!containsRect(window, fillArea)) {
+      const ClipperLib::IntRect validArea =
+          inflatedRect(window, -(*mMinWidth + *maxArcTolerance()).toNm());
+      build(&window, planeFragments);
+      QVector<Path> newFragments;
+      bool          complete = true;
+      for (const ClipperLib::Path& path : mResult) {
+        ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect(path);
+        if (!ClipperHelpers::intersects(rect, affected)) {
+          continue;  // not affected, will be taken from the plane
+        } else if (containsRect(validArea, rect)) {
+          newFragments.append(ClipperHelpers::convert(path));
+        } else {
+          complete = false;
+          break;
+        }
       }
+      if (complete) {
+        // Stitch the new fragments into the unaffected old fragments.
+        QVector<Path> fragments;
+        foreach (const Path& fragment, mFragments) {
+          ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect(
+              ClipperHelpers::convert(fragment, maxArcTolerance()));
+          if (!ClipperHelpers::intersects(rect, affected)) {
+            fragments.append(fragment);
+          }
+        }
+        return fragments + newFragments;
+      }
+      window = inflatedRect(window, qMax(window.right - window.left,
+                                         window.bottom - window.top) /
+                                        2);
     }
+  } catch (const Exception& e) {
+    qCritical() << "Failed to rebuild plane fragments incrementally!";
+    qCritical() << "Inner error message:" << e.getMsg();
   }
-  boardAreaClipper.Execute(ClipperLib::ctXor, boardArea, ClipperLib::pftEvenOdd,
-                           ClipperLib::pftEvenOdd);
 
-  // perform clearance offset
-  ClipperHelpers::offset(boardArea, -mPlane.getMinClearance(),
-                         maxArcTolerance());  // can throw
+  // The window covers the whole fill area anyway, or the incremental rebuild
+  // failed, so just build all fragments.
+  return buildAllFragments(planeFragments);
+}
+
+void BoardPlaneFragmentsBuilder::updateStatistics(
+    const QVector<Path>& fragments, qint64 durationMs) noexcept {
+  mStatistics.durationMs  = durationMs;
+  mStatistics.vertexCount = 0;
+  foreach (const Path& fragment, fragments) {
+    mStatistics.vertexCount += fragment.getVertices().count();
+  }
+  if (durationMs > SLOW_REBUILD_THRESHOLD_MS) {
+    qWarning().nospace() << "Rebuilding plane " << mUuid.toStr() << " took "
+                         << durationMs << " ms ("
+                         << mStatistics.obstacleCount << " obstacles, "
+                         << mStatistics.vertexCount << " vertices).";
+  }
+}
+
+void BoardPlaneFragmentsBuilder::build(const ClipperLib::IntRect* window,
+                                       const PlaneFragments& planeFragments) {
+  LIBREPCB_TRACE_SCOPE("board", "BoardPlaneFragmentsBuilder::build");
+  mResult.clear();
+  mConnectedNetSignalAreas.clear();
+  mStatistics.obstacleCount      = 0;
+  mStatistics.removedVertexCount = 0;
+  ++mStatistics.passCount;
+  addPlaneOutline();
+  if (window) {
+    clipToWindow(*window);
+  }
+  clipToBoardOutline();
+  subtractOtherObjects(planeFragments);
+  ensureMinimumWidth();
+  flattenResult();
+  if (!mKeepOrphans) {
+    removeOrphans();
+  }
+  simplifyResult();
+}
+
+void BoardPlaneFragmentsBuilder::addPlaneOutline() {
+  mResult.push_back(mOutline);
+}
+
+void BoardPlaneFragmentsBuilder::clipToWindow(
+    const ClipperLib::IntRect& window) {
+  ClipperLib::Clipper clip;
+  clip.AddPaths(mResult, ClipperLib::ptSubject, true);
+  clip.AddPath(rectToPath(window), ClipperLib::ptClip, true);
+  clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
+               ClipperLib::pftNonZero);
+}
+
+void BoardPlaneFragmentsBuilder::clipToBoardOutline() {
+  if (!mBoardAreaValid) {
+    throw LogicError(__FILE__, __LINE__,
+                     "Failed to determine the board area.");
+  }
 
   // if we have no board area, abort here
-  if (boardArea.empty()) return;
+  if (mBoardArea.empty()) return;
 
-  // clip result to board area
+  // clip result to board area (already reduced by the clearance)
   ClipperLib::Clipper clip;
   clip.AddPaths(mResult, ClipperLib::ptSubject, true);
-  clip.AddPaths(boardArea, ClipperLib::ptClip, true);
+  clip.AddPaths(mBoardArea, ClipperLib::ptClip, true);
   clip.Execute(ClipperLib::ctIntersection, mResult, ClipperLib::pftNonZero,
                ClipperLib::pftNonZero);
 }
 
-void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
+void BoardPlaneFragmentsBuilder::subtractOtherObjects(
+    const PlaneFragments& planeFragments) {
+  // Only objects overlapping the remaining plane area are relevant, so skip all
+  // other objects to keep the clipper input small. Comparing bounding
+  // rectangles is much cheaper than clipping.
+  const ClipperLib::IntRect area = ClipperHelpers::getBoundingRect(mResult);
+  if (area.left > area.right) return;  // nothing to subtract from
+  auto isRelevant = [&area](const ClipperLib::Path& path) {
+    return ClipperHelpers::intersects(area,
+                                      ClipperHelpers::getBoundingRect(path));
+  };
+
   ClipperLib::Clipper c;
   c.AddPaths(mResult, ClipperLib::ptSubject, true);
 
   // subtract other planes
-  foreach (const BI_Plane* plane, mPlane.getBoard().getPlanes()) {
-    if (plane == &mPlane) continue;
-    if (*plane < mPlane) continue;  // ignore planes with lower priority
-    if (plane->getLayerName() != mPlane.getLayerName()) continue;
-    if (&plane->getNetSignal() == &mPlane.getNetSignal()) continue;
-    ClipperLib::Paths paths =
-        ClipperHelpers::convert(plane->getFragments(), maxArcTolerance());
-    ClipperHelpers::offset(paths, *mPlane.getMinClearance(),
-                           maxArcTolerance());  // can throw
-    c.AddPaths(paths, ClipperLib::ptClip, true);
-  }
-
-  // subtract holes and pads from devices
-  foreach (const BI_Device* device, mPlane.getBoard().getDeviceInstances()) {
-    for (const Hole& hole :
-         device->getFootprint().getLibFootprint().getHoles()) {
-      Point pos = device->getFootprint().mapToScene(hole.getPosition());
-      PositiveLength dia(hole.getDiameter() + mPlane.getMinClearance() * 2);
-      Path           path = Path::circle(dia).translated(pos);
-      c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-                ClipperLib::ptClip, true);
+  const ClipperLib::IntRect planesArea =
+      inflatedRect(area, mMinClearance->toNm());
+  ClipperLib::Paths planes;
+  for (const ClipperLib::Path& path : getOtherPlanesPaths(planeFragments)) {
+    if (ClipperHelpers::intersects(planesArea,
+                                   ClipperHelpers::getBoundingRect(path))) {
+      planes.push_back(path);
     }
-    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
-      if (!pad->isOnLayer(*mPlane.getLayerName())) continue;
-      if (pad->getCompSigInstNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(pad->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      }
-      c.AddPath(createPadCutOut(*pad), ClipperLib::ptClip, true);
-    }
-  }
-
-  // subtract board holes
-  for (const BI_Hole* hole : mPlane.getBoard().getHoles()) {
-    PositiveLength dia(hole->getHole().getDiameter() +
-                       mPlane.getMinClearance() * 2);
-    Path path = Path::circle(dia).translated(hole->getHole().getPosition());
-    c.AddPath(ClipperHelpers::convert(path, maxArcTolerance()),
-              ClipperLib::ptClip, true);
   }
-
-  // subtract net segment items
-  foreach (const BI_NetSegment* netsegment,
-           mPlane.getBoard().getNetSegments()) {
-    // subtract vias
-    foreach (const BI_Via* via, netsegment->getVias()) {
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path =
-            ClipperHelpers::convert(via->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      }
-      c.AddPath(createViaCutOut(*via), ClipperLib::ptClip, true);
+  ClipperHelpers::offset(planes, *mMinClearance,
+                         maxArcTolerance());  // can throw
+  c.AddPaths(planes, ClipperLib::ptClip, true);
+  mStatistics.obstacleCount += static_cast<int>(planes.size());
+
+  // subtract holes, pads, vias and netlines
+  for (const ClipperLib::Path& path : mCutOuts) {
+    if (isRelevant(path)) {
+      c.AddPath(path, ClipperLib::ptClip, true);
+      ++mStatistics.obstacleCount;
     }
-
-    // subtract netlines
-    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
-      if (netline->getLayer().getName() != mPlane.getLayerName()) continue;
-      if (&netsegment->getNetSignal() == &mPlane.getNetSignal()) {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(), maxArcTolerance());
-        mConnectedNetSignalAreas.push_back(path);
-      } else {
-        ClipperLib::Path path = ClipperHelpers::convert(
-            netline->getSceneOutline(*mPlane.getMinClearance()),
-            maxArcTolerance());
-        c.AddPath(path, ClipperLib::ptClip, true);
-      }
+  }
+  for (const ClipperLib::Path& path : mConnectedAreas) {
+    if (isRelevant(path)) {
+      mConnectedNetSignalAreas.push_back(path);
     }
   }
 
@@ -213,7 +546,7 @@ void BoardPlaneFragmentsBuilder::subtractOtherObjects() {
 }
 
 void BoardPlaneFragmentsBuilder::ensureMinimumWidth() {
-  Length delta = mPlane.getMinWidth() / 2;
+  Length delta = mMinWidth / 2;
   ClipperHelpers::offset(mResult, -delta, maxArcTolerance());  // can throw
   ClipperHelpers::offset(mResult, delta, maxArcTolerance());   // can throw
 }
@@ -246,36 +579,165 @@ void BoardPlaneFragmentsBuilder::removeOrphans() {
                 mResult.end());
 }
 
+void BoardPlaneFragmentsBuilder::simplifyResult() noexcept {
+  // The tolerance is only a fraction of the arc tolerance because the design
+  // rule check accepts deviations up to the arc tolerance, which are already
+  // partially used by flattening the arcs.
+  const qreal tolerance = maxArcTolerance()->toNm() / qreal(4);
+  for (ClipperLib::Path& path : mResult) {
+    const std::size_t count = path.size();
+    path                    = simplifiedPath(path, tolerance);
+    mStatistics.removedVertexCount += static_cast<int>(count - path.size());
+  }
+}
+
 /*******************************************************************************
  *  Helper Methods
  ******************************************************************************/
 
+void BoardPlaneFragmentsBuilder::collectBoardArea(
+    const BI_Plane& plane) noexcept {
+  // The board area is shared with all other planes and the design rule check,
+  // so it is calculated only once per modification of the board outlines.
+  try {
+    mBoardArea = plane.getBoard().getOutlineAreaCache().getArea(
+        -mMinClearance, maxArcTolerance());
+    mBoardAreaValid = true;
+  } catch (const Exception& e) {
+    qCritical() << "Failed to determine the board area:" << e.getMsg();
+  }
+}
+
+void BoardPlaneFragmentsBuilder::collectObstacles(
+    const BI_Plane& plane) noexcept {
+  // Only objects overlapping the plane outline are relevant, so skip all
+  // other objects already here.
+  const ClipperLib::IntRect area = ClipperHelpers::getBoundingRect(mOutline);
+  auto addCutOut = [this, &area](const ClipperLib::Path& path) {
+    if (ClipperHelpers::intersects(area,
+                                   ClipperHelpers::getBoundingRect(path))) {
+      mCutOuts.push_back(path);
+    }
+  };
+  auto addConnectedArea = [this, &area](const ClipperLib::Path& path) {
+    if (ClipperHelpers::intersects(area,
+                                   ClipperHelpers::getBoundingRect(path))) {
+      mConnectedAreas.push_back(path);
+    }
+  };
+
+  // other planes
+  foreach (const BI_Plane* other, plane.getBoard().getPlanes()) {
+    if (other == &plane) continue;
+    if (*other < plane) continue;  // ignore planes with lower priority
+    if (other->getLayerName() != plane.getLayerName()) continue;
+    if (&other->getNetSignal() == &plane.getNetSignal()) continue;
+    mOtherPlanes.append(OtherPlane{other, other->getFragments()});
+  }
+
+  // holes and pads from devices
+  foreach (const BI_Device* device, plane.getBoard().getDeviceInstances()) {
+    for (const Hole& hole :
+         device->getFootprint().getLibFootprint().getHoles()) {
+      Point pos = device->getFootprint().mapToScene(hole.getPosition());
+      PositiveLength dia(hole.getDiameter() + mMinClearance * 2);
+      addCutOut(convertCircle(dia, pos));
+    }
+    foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+      if (!pad->isOnLayer(*plane.getLayerName())) continue;
+      if (pad->getCompSigInstNetSignal() == &plane.getNetSignal()) {
+        addConnectedArea(convertPadOutline(*pad, Length(0)));
+      }
+      addCutOut(createPadCutOut(plane, *pad));
+    }
+  }
+
+  // board holes
+  for (const BI_Hole* hole : plane.getBoard().getHoles()) {
+    PositiveLength dia(hole->getHole().getDiameter() + mMinClearance * 2);
+    addCutOut(convertCircle(dia, hole->getHole().getPosition()));
+  }
+
+  // net segment items
+  foreach (const BI_NetSegment* netsegment,
+           plane.getBoard().getNetSegments()) {
+    // vias
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      if (&netsegment->getNetSignal() == &plane.getNetSignal()) {
+        addConnectedArea(convertViaOutline(*via, Length(0)));
+      }
+      addCutOut(createViaCutOut(plane, *via));
+    }
+
+    // netlines
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      if (netline->getLayer().getName() != plane.getLayerName()) continue;
+      if (&netsegment->getNetSignal() == &plane.getNetSignal()) {
+        addConnectedArea(
+            netline->getSceneOutlineClipper(Length(0), maxArcTolerance()));
+      } else {
+        addCutOut(netline->getSceneOutlineClipper(*mMinClearance,
+                                                  maxArcTolerance()));
+      }
+    }
+  }
+}
+
+ClipperLib::Paths BoardPlaneFragmentsBuilder::getOtherPlanesPaths(
+    const PlaneFragments& planeFragments) const noexcept {
+  ClipperLib::Paths paths;
+  foreach (const OtherPlane& other, mOtherPlanes) {
+    ClipperLib::Paths fragments = ClipperHelpers::convert(
+        planeFragments.value(other.plane, other.fragments), maxArcTolerance());
+    paths.insert(paths.end(), fragments.begin(), fragments.end());
+  }
+  return paths;
+}
+
 ClipperLib::Path BoardPlaneFragmentsBuilder::createPadCutOut(
-    const BI_FootprintPad& pad) const noexcept {
+    const BI_Plane& plane, const BI_FootprintPad& pad) const noexcept {
   bool differentNetSignal =
-      (pad.getCompSigInstNetSignal() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        pad.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
+      (pad.getCompSigInstNetSignal() != &plane.getNetSignal());
+  if ((mConnectStyle == BI_Plane::ConnectStyle::None) || differentNetSignal) {
+    return convertPadOutline(pad, *mMinClearance);
   } else {
     return ClipperLib::Path();
   }
 }
 
 ClipperLib::Path BoardPlaneFragmentsBuilder::createViaCutOut(
-    const BI_Via& via) const noexcept {
+    const BI_Plane& plane, const BI_Via& via) const noexcept {
   bool differentNetSignal =
-      (&via.getNetSignalOfNetSegment() != &mPlane.getNetSignal());
-  if ((mPlane.getConnectStyle() == BI_Plane::ConnectStyle::None) ||
-      differentNetSignal) {
-    return ClipperHelpers::convert(
-        via.getSceneOutline(*mPlane.getMinClearance()), maxArcTolerance());
+      (&via.getNetSignalOfNetSegment() != &plane.getNetSignal());
+  if ((mConnectStyle == BI_Plane::ConnectStyle::None) || differentNetSignal) {
+    return convertViaOutline(via, *mMinClearance);
   } else {
     return ClipperLib::Path();
   }
 }
 
+ClipperLib::Path BoardPlaneFragmentsBuilder::convertPadOutline(
+    const BI_FootprintPad& pad, const Length& expansion) noexcept {
+  // same transformation as BI_FootprintPad::getSceneOutline(), but the
+  // translation is applied after the (cached) conversion
+  Angle rotation = pad.getIsMirrored() ? -pad.getRotation() : pad.getRotation();
+  return ClipperShapeCache::instance().get(
+      Transform(Point(0, 0), rotation, false).map(pad.getOutline(expansion)),
+      pad.getPosition(), maxArcTolerance());
+}
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::convertViaOutline(
+    const BI_Via& via, const Length& expansion) noexcept {
+  return ClipperShapeCache::instance().get(
+      via.getOutline(expansion), via.getPosition(), maxArcTolerance());
+}
+
+ClipperLib::Path BoardPlaneFragmentsBuilder::convertCircle(
+    const PositiveLength& diameter, const Point& center) noexcept {
+  return ClipperShapeCache::instance().get(Path::circle(diameter), center,
+                                           maxArcTolerance());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -23,18 +23,21 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "items/bi_plane.h"
+
 #include <librepcb/common/geometry/path.h>
 #include <polyclipping/clipper.hpp>
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 namespace project {
 
-class BI_Plane;
 class BI_Via;
 class BI_FootprintPad;
 
@@ -44,47 +47,222 @@ class BI_FootprintPad;
 
 /**
  * @brief The BoardPlaneFragmentsBuilder class
+ *
+ * The constructor copies all inputs from the plane and its board, so all
+ * other methods do not access the board anymore and can be called from
+ * any thread, even while the board is modified. The fragments of other
+ * planes are taken from this copy too, unless they are passed explicitly.
+ * This allows to build fragments of a plane before the new fragments of
+ * higher priority planes were applied to the board (see #buildAll()).
  */
 class BoardPlaneFragmentsBuilder final {
 public:
+  // Types
+  typedef QHash<const BI_Plane*, QVector<Path>> PlaneFragments;
+  struct Result {
+    QVector<Path>               fragments;
+    QByteArray                  fingerprint;
+    BI_Plane::RebuildStatistics statistics;
+  };
+
   // Constructors / Destructor
   BoardPlaneFragmentsBuilder()                                        = delete;
   BoardPlaneFragmentsBuilder(const BoardPlaneFragmentsBuilder& other) = delete;
-  BoardPlaneFragmentsBuilder(BI_Plane& plane) noexcept;
+  explicit BoardPlaneFragmentsBuilder(const BI_Plane& plane) noexcept;
   ~BoardPlaneFragmentsBuilder() noexcept;
 
+  // Getters
+
+  /**
+   * @brief Get the plane this builder was created for
+   *
+   * @warning Only use the returned pointer as a key since the plane might
+   *          be modified or even deleted in the meantime.
+   */
+  const BI_Plane* getPlane() const noexcept { return mPlane; }
+
+  /**
+   * @brief Get the planes whose fragments are obstacles for this plane
+   *
+   * These are all planes with higher priority on the same layer and with a
+   * different net signal.
+   *
+   * @warning See #getPlane().
+   */
+  QList<const BI_Plane*> getDependencies() const noexcept;
+
+  /**
+   * @brief Get the statistics of the last call to #buildFragments()
+   *
+   * The obstacle count only contains objects near the area which was actually
+   * rebuilt, thus it is zero if an incremental rebuild did not have to
+   * calculate anything.
+   */
+  const BI_Plane::RebuildStatistics& getStatistics() const noexcept {
+    return mStatistics;
+  }
+
   // General Methods
-  QVector<Path> buildFragments() noexcept;
+
+  /**
+   * @brief Build the fragments of the plane
+   *
+   * @param planeFragments  New fragments of other planes, if they differ from
+   *                        the fragments at the time this builder was created.
+   *
+   * @return The fragments of the plane.
+   */
+  QVector<Path> buildFragments(
+      const PlaneFragments& planeFragments = PlaneFragments()) noexcept;
+
+  /**
+   * @brief Rebuild only the fragments affected by modifications in some areas
+   *
+   * Fragments which are not located near the passed dirty areas are taken
+   * from the current fragments of the plane, all other fragments are
+   * calculated within a window around the dirty areas. The result is
+   * equivalent to #buildFragments(), but much faster for small modifications.
+   * If the fragments of the plane were never built (or have been cleared),
+   * they are kept empty.
+   *
+   * @param dirtyAreas      Outlines of all objects which were added, removed
+   *                        or modified since the fragments of the plane were
+   *                        built (both the old and the new outlines of
+   *                        modified or moved objects).
+   * @param planeFragments  See #buildFragments(const PlaneFragments&).
+   *
+   * @return The new fragments of the plane.
+   */
+  QVector<Path> buildFragments(
+      const QVector<Path>&  dirtyAreas,
+      const PlaneFragments& planeFragments = PlaneFragments()) noexcept;
+
+  /**
+   * @brief Calculate a fingerprint of all inputs of the fragments calculation
+   *
+   * As long as the fingerprint does not change, the fragments built by
+   * #buildFragments() do not change either. This allows to store the
+   * fragments together with their fingerprint and reuse them later.
+   *
+   * @param planeFragments  See #buildFragments().
+   *
+   * @return  SHA-256 hash of all data the plane fragments depend on.
+   */
+  QByteArray calcFingerprint(
+      const PlaneFragments& planeFragments = PlaneFragments()) const noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Build the fragments of several planes concurrently
+   *
+   * Each plane is built in a separate job of the global thread pool, which
+   * waits only for the jobs of its dependencies (see #getDependencies()).
+   * This method blocks until all jobs are finished.
+   *
+   * @param builders  The builders of all planes to build, sorted by priority
+   *                  (highest priority first). Dependencies which are not
+   *                  contained in this list are taken from the builders.
+   *
+   * @return The results of all planes.
+   */
+  static QHash<const BI_Plane*, Result> buildAll(
+      const QList<std::shared_ptr<BoardPlaneFragmentsBuilder>>&
+          builders) noexcept;
+
+  /**
+   * @brief Rebuild several planes incrementally (see
+   *        #buildFragments(const QVector<Path>&, const PlaneFragments&))
+   *
+   * The planes are rebuilt one after the other since fragments modified in a
+   * plane are additional dirty areas for all planes depending on it. Planes
+   * which were never built are skipped, i.e. not contained in the result.
+   *
+   * @param builders    The builders of all planes, sorted by priority
+   *                    (highest priority first).
+   * @param dirtyAreas  The modified areas of the board.
+   *
+   * @return The results of all planes which were built before.
+   */
+  static QHash<const BI_Plane*, Result> buildAllIncremental(
+      const QList<std::shared_ptr<BoardPlaneFragmentsBuilder>>& builders,
+      const QVector<Path>& dirtyAreas) noexcept;
+
+  /**
+   * Returns the maximum allowed arc tolerance when flattening arcs. Do not
+   * change this if you don't know exactly what you're doing (it affects all
+   * planes in all existing boards)!
+   */
+  static PositiveLength maxArcTolerance() noexcept {
+    return PositiveLength(5000);
+  }
 
   // Operator Overloadings
   BoardPlaneFragmentsBuilder& operator=(const BoardPlaneFragmentsBuilder& rhs) =
       delete;
 
+private:  // Types
+  struct OtherPlane {
+    const BI_Plane* plane;
+    QVector<Path>   fragments;
+  };
+
 private:  // Methods
+  QVector<Path> buildAllFragments(
+      const PlaneFragments& planeFragments) noexcept;
+  QVector<Path> buildDirtyFragments(
+      const QVector<Path>&  dirtyAreas,
+      const PlaneFragments& planeFragments) noexcept;
+  void updateStatistics(const QVector<Path>& fragments,
+                        qint64               durationMs) noexcept;
+  void build(const ClipperLib::IntRect* window,
+             const PlaneFragments&      planeFragments);
   void addPlaneOutline();
+  void clipToWindow(const ClipperLib::IntRect& window);
   void clipToBoardOutline();
-  void subtractOtherObjects();
+  void subtractOtherObjects(const PlaneFragments& planeFragments);
   void ensureMinimumWidth();
   void flattenResult();
   void removeOrphans();
+  void simplifyResult() noexcept;
 
   // Helper Methods
-  ClipperLib::Path createPadCutOut(const BI_FootprintPad& pad) const noexcept;
-  ClipperLib::Path createViaCutOut(const BI_Via& via) const noexcept;
-
-  /**
-   * Returns the maximum allowed arc tolerance when flattening arcs. Do not
-   * change this if you don't know exactly what you're doing (it affects all
-   * planes in all existing boards)!
-   */
-  static PositiveLength maxArcTolerance() noexcept {
-    return PositiveLength(5000);
-  }
+  void collectBoardArea(const BI_Plane& plane) noexcept;
+  void collectObstacles(const BI_Plane& plane) noexcept;
+  ClipperLib::Paths getOtherPlanesPaths(
+      const PlaneFragments& planeFragments) const noexcept;
+  ClipperLib::Path createPadCutOut(const BI_Plane&        plane,
+                                   const BI_FootprintPad& pad) const noexcept;
+  ClipperLib::Path createViaCutOut(const BI_Plane& plane,
+                                   const BI_Via&   via) const noexcept;
+  static ClipperLib::Path convertPadOutline(const BI_FootprintPad& pad,
+                                            const Length& expansion) noexcept;
+  static ClipperLib::Path convertViaOutline(const BI_Via& via,
+                                            const Length& expansion) noexcept;
+  static ClipperLib::Path convertCircle(const PositiveLength& diameter,
+                                        const Point&          center) noexcept;
 
 private:  // Data
-  BI_Plane&         mPlane;
-  ClipperLib::Paths mConnectedNetSignalAreas;
-  ClipperLib::Paths mResult;
+  // Copy of all inputs
+  const BI_Plane*        mPlane;
+  Uuid                   mUuid;
+  UnsignedLength         mMinWidth;
+  UnsignedLength         mMinClearance;
+  bool                   mKeepOrphans;
+  BI_Plane::ConnectStyle mConnectStyle;
+  ClipperLib::Path       mOutline;
+  QVector<Path>          mFragments;             ///< Current fragments
+  QByteArray             mFragmentsFingerprint;  ///< Of current fragments
+  ClipperLib::Paths      mBoardArea;  ///< Reduced by the clearance
+  bool                   mBoardAreaValid;
+  QVector<OtherPlane>    mOtherPlanes;
+  ClipperLib::Paths      mCutOuts;         ///< Obstacles (with clearance)
+  ClipperLib::Paths      mConnectedAreas;  ///< Copper of the plane's net
+
+  // State
+  ClipperLib::Paths           mConnectedNetSignalAreas;
+  ClipperLib::Paths           mResult;
+  BI_Plane::RebuildStatistics mStatistics;
 };
 
 /*******************************************************************************
@@ -0,0 +1,175 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanesrebuilder.h"
+
+#include "board.h"
+#include "items/bi_plane.h"
+
+#include <librepcb/common/utils/taskscheduler.h>
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPlanesRebuilder::BoardPlanesRebuilder(Board& board) noexcept
+  : QObject(nullptr),
+    mBoard(board),
+    mDebounceTimer(),
+    mWatcher(),
+    mRestartPending(false),
+    mFullRebuildPending(false),
+    mDiscardResults(false),
+    mJobTimer(),
+    mRebuildCount(0),
+    mLastRebuildDurationMs(0) {
+  mDebounceTimer.setSingleShot(true);
+  mDebounceTimer.setInterval(sDebounceIntervalMs);
+  connect(&mDebounceTimer, &QTimer::timeout, this,
+          &BoardPlanesRebuilder::start);
+  connect(&mWatcher, &QFutureWatcher<Results>::finished, this,
+          &BoardPlanesRebuilder::jobFinished);
+}
+
+BoardPlanesRebuilder::~BoardPlanesRebuilder() noexcept {
+  cancel();
+  mWatcher.waitForFinished();
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+bool BoardPlanesRebuilder::isBusy() const noexcept {
+  return mDebounceTimer.isActive() || mWatcher.isRunning() || mRestartPending;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BoardPlanesRebuilder::schedule() noexcept {
+  mFullRebuildPending = true;
+  scheduleIncremental();
+}
+
+void BoardPlanesRebuilder::scheduleIncremental() noexcept {
+  if (mWatcher.isRunning()) {
+    mRestartPending = true;
+  } else {
+    mDebounceTimer.start();  // restarts the timer if already running
+  }
+}
+
+void BoardPlanesRebuilder::cancel() noexcept {
+  mDebounceTimer.stop();
+  mRestartPending     = false;
+  mFullRebuildPending = false;
+  if (mWatcher.isRunning()) {
+    mDiscardResults = true;  // the job itself cannot be aborted
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardPlanesRebuilder::start() noexcept {
+  if (mWatcher.isRunning()) {
+    mRestartPending = true;
+    return;
+  }
+
+  // A full rebuild covers the scheduled area as well.
+  const bool full     = mFullRebuildPending;
+  const Path area     = mBoard.takeScheduledAreaForPlanesRebuild();
+  mFullRebuildPending = false;
+  if ((!full) && area.getVertices().isEmpty()) {
+    return;  // nothing to do
+  }
+
+  // Copy all inputs now, since the board must not be accessed by the job.
+  // Planes might be removed in the meantime, so the results are identified
+  // by the plane UUIDs.
+  QList<std::shared_ptr<BoardPlaneFragmentsBuilder>> builders;
+  QList<Uuid>                                        uuids;
+  foreach (const BI_Plane* plane, mBoard.getPlanesSortedByPriority()) {
+    builders.append(std::make_shared<BoardPlaneFragmentsBuilder>(*plane));
+    uuids.append(plane->getUuid());
+  }
+  mDiscardResults = false;
+  mJobTimer.start();
+  mWatcher.setFuture(TaskScheduler::run(
+      TaskScheduler::Priority::Normal, [builders, uuids, full, area]() {
+        QHash<const BI_Plane*, BoardPlaneFragmentsBuilder::Result> results =
+            full ? BoardPlaneFragmentsBuilder::buildAll(builders)
+                 : BoardPlaneFragmentsBuilder::buildAllIncremental(builders,
+                                                                   {area});
+        Results resultsByUuid;
+        for (int i = 0; i < builders.count(); ++i) {
+          auto it = results.constFind(builders.at(i)->getPlane());
+          if (it != results.constEnd()) {
+            resultsByUuid.insert(uuids.at(i), *it);
+          }
+        }
+        return resultsByUuid;
+      }));
+}
+
+void BoardPlanesRebuilder::jobFinished() noexcept {
+  if (!mDiscardResults) {
+    Results results = mWatcher.result();
+    foreach (BI_Plane* plane, mBoard.getPlanes()) {
+      auto it = results.constFind(plane->getUuid());
+      if (it != results.constEnd()) {
+        plane->setCalculatedFragments(it->fragments, it->fingerprint,
+                                      it->statistics);
+      }
+    }
+    ++mRebuildCount;
+    mLastRebuildDurationMs = mJobTimer.elapsed();
+    mBoard.triggerAirWiresRebuild();
+    emit finished();
+  }
+  mDiscardResults = false;
+  if (mRestartPending) {
+    mRestartPending = false;
+    mDebounceTimer.start();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+#define LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardplanefragmentsbuilder.h"
+
+#include <librepcb/common/uuid.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+class Board;
+
+/*******************************************************************************
+ *  Class BoardPlanesRebuilder
+ ******************************************************************************/
+
+/**
+ * @brief Rebuilds all planes of a ::librepcb::project::Board in the background
+ *
+ * When a rebuild starts, the inputs of all planes are copied in the main
+ * thread (see ::librepcb::project::BoardPlaneFragmentsBuilder). The fragments
+ * are then built in a worker thread, and finally applied to the planes in the
+ * main thread at once. Until then, the planes keep their old fragments, so
+ * the board stays fully usable in the meantime.
+ *
+ * A full rebuild is requested with #schedule(), an incremental rebuild of the
+ * areas scheduled with ::librepcb::project::Board::schedulePlanesRebuild()
+ * with #scheduleIncremental(). A pending full rebuild makes incremental
+ * rebuilds obsolete. Requests are debounced, i.e. a rebuild is only started
+ * after there were no more requests for a short time. Requests while a
+ * rebuild is running lead to another rebuild as soon as it is finished.
+ */
+class BoardPlanesRebuilder final : public QObject {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  BoardPlanesRebuilder()                                  = delete;
+  BoardPlanesRebuilder(const BoardPlanesRebuilder& other) = delete;
+  explicit BoardPlanesRebuilder(Board& board) noexcept;
+  ~BoardPlanesRebuilder() noexcept;
+
+  // Getters
+  bool isBusy() const noexcept;
+  int  getRebuildCount() const noexcept { return mRebuildCount; }
+  qint64 getLastRebuildDurationMs() const noexcept {
+    return mLastRebuildDurationMs;
+  }
+
+  // General Methods
+  void schedule() noexcept;
+  void scheduleIncremental() noexcept;
+  void cancel() noexcept;
+
+  // Operator Overloadings
+  BoardPlanesRebuilder& operator=(const BoardPlanesRebuilder& rhs) = delete;
+
+signals:
+  void finished();
+
+private:  // Methods
+  void start() noexcept;
+  void jobFinished() noexcept;
+
+private:  // Data
+  typedef QHash<Uuid, BoardPlaneFragmentsBuilder::Result> Results;
+
+  Board&                  mBoard;
+  QTimer                  mDebounceTimer;
+  QFutureWatcher<Results> mWatcher;
+  bool                    mRestartPending;
+  bool                    mFullRebuildPending;
+  bool                    mDiscardResults;
+  QElapsedTimer           mJobTimer;
+  int                     mRebuildCount;           ///< For diagnostics only
+  qint64                  mLastRebuildDurationMs;  ///< For diagnostics only
+
+  static const int sDebounceIntervalMs = 300;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDPLANESREBUILDER_H
@@ -23,6 +23,8 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+#include "items/bi_base.h"
+
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/uuid.h>
 
@@ -60,12 +62,8 @@ public:
   // Constructors / Destructor
   BoardSelectionQuery()                                 = delete;
   BoardSelectionQuery(const BoardSelectionQuery& other) = delete;
-  BoardSelectionQuery(const QMap<Uuid, BI_Device*>& deviceInstances,
-                      const QList<BI_NetSegment*>&  netsegments,
-                      const QList<BI_Plane*>&       planes,
-                      const QList<BI_Polygon*>&     polygons,
-                      const QList<BI_StrokeText*>&  strokeTexts,
-                      const QList<BI_Hole*>& holes, QObject* parent = nullptr);
+  BoardSelectionQuery(const QSet<BI_Base*>& selectedItems,
+                      QObject*              parent = nullptr);
   ~BoardSelectionQuery() noexcept;
 
   // Getters
@@ -106,13 +104,17 @@ public:
   BoardSelectionQuery& operator=(const BoardSelectionQuery& rhs) = delete;
 
 private:
-  // references to the Board object
-  const QMap<Uuid, BI_Device*>& mDevices;
-  const QList<BI_NetSegment*>&  mNetSegments;
-  const QList<BI_Plane*>&       mPlanes;
-  const QList<BI_Polygon*>&     mPolygons;
-  const QList<BI_StrokeText*>&  mStrokeTexts;
-  const QList<BI_Hole*>&        mHoles;
+  template <typename T>
+  void addSelectedItems(BI_Base::Type_t type, QSet<T*>& result) const noexcept {
+    foreach (BI_Base* item, mSelectedItems) {
+      if (item->getType() == type) {
+        result.insert(static_cast<T*>(item));
+      }
+    }
+  }
+
+  /// Reference to the selected items of the Board object
+  const QSet<BI_Base*>& mSelectedItems;
 
   // query result
   QSet<BI_Device*>     mResultDeviceInstances;
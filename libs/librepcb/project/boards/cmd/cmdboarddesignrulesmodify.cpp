@@ -62,11 +62,13 @@ bool CmdBoardDesignRulesModify::performExecute() {
 void CmdBoardDesignRulesModify::performUndo() {
   mBoard.getDesignRules() = mOldRules;
   emit mBoard.attributesChanged();
+  emit mBoard.designRulesOrLayersChanged();
 }
 
 void CmdBoardDesignRulesModify::performRedo() {
   mBoard.getDesignRules() = mNewRules;
   emit mBoard.attributesChanged();
+  emit mBoard.designRulesOrLayersChanged();
 }
 
 /*******************************************************************************
@@ -78,6 +78,14 @@ void CmdBoardNetPointEdit::rotate(const Angle& angle, const Point& center,
  *  Inherited from UndoCommand
  ******************************************************************************/
 
+bool CmdBoardNetPointEdit::mergeWith(const UndoCommand& other) noexcept {
+  const CmdBoardNetPointEdit* cmd =
+      dynamic_cast<const CmdBoardNetPointEdit*>(&other);
+  if ((!cmd) || (&cmd->mNetPoint != &mNetPoint)) return false;
+  mNewPos = cmd->mNewPos;
+  return true;
+}
+
 bool CmdBoardNetPointEdit::performExecute() {
   performRedo();  // can throw
 
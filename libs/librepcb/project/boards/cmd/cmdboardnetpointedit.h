@@ -54,6 +54,9 @@ public:
   void translate(const Point& deltaPos, bool immediate) noexcept;
   void rotate(const Angle& angle, const Point& center, bool immediate) noexcept;
 
+  // Inherited from UndoCommand
+  bool mergeWith(const UndoCommand& other) noexcept override;
+
 private:
   // Private Methods
 
@@ -23,6 +23,7 @@
 #include "cmdboardplaneedit.h"
 
 #include "../board.h"
+#include "../boardplanesrebuilder.h"
 
 #include <librepcb/common/graphics/graphicslayer.h>
 
@@ -168,7 +169,7 @@ void CmdBoardPlaneEdit::performUndo() {
   mPlane.setKeepOrphans(mOldKeepOrphans);
 
   // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  if (mDoRebuildOnChanges) mPlane.getBoard().getPlanesRebuilder().schedule();
 }
 
 void CmdBoardPlaneEdit::performRedo() {
@@ -182,7 +183,7 @@ void CmdBoardPlaneEdit::performRedo() {
   mPlane.setKeepOrphans(mNewKeepOrphans);
 
   // rebuild all planes to see the changes
-  if (mDoRebuildOnChanges) mPlane.getBoard().rebuildAllPlanes();
+  if (mDoRebuildOnChanges) mPlane.getBoard().getPlanesRebuilder().schedule();
 }
 
 /*******************************************************************************
@@ -44,7 +44,12 @@ namespace project {
 
 CmdFootprintStrokeTextsReset::CmdFootprintStrokeTextsReset(
     BI_Footprint& footprint) noexcept
-  : UndoCommandGroup(tr("Reset footprint texts")), mFootprint(footprint) {
+  : CmdFootprintStrokeTextsReset(QList<BI_Footprint*>{&footprint}) {
+}
+
+CmdFootprintStrokeTextsReset::CmdFootprintStrokeTextsReset(
+    const QList<BI_Footprint*>& footprints) noexcept
+  : UndoCommandGroup(tr("Reset footprint texts")), mFootprints(footprints) {
 }
 
 CmdFootprintStrokeTextsReset::~CmdFootprintStrokeTextsReset() noexcept {
@@ -55,32 +60,45 @@ CmdFootprintStrokeTextsReset::~CmdFootprintStrokeTextsReset() noexcept {
  ******************************************************************************/
 
 bool CmdFootprintStrokeTextsReset::performExecute() {
+  foreach (BI_Footprint* footprint, mFootprints) {
+    Q_ASSERT(footprint);
+    resetTexts(*footprint);  // can throw
+  }
+
+  // execute all child commands
+  return UndoCommandGroup::performExecute();  // can throw
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void CmdFootprintStrokeTextsReset::resetTexts(BI_Footprint& footprint) {
   // Remove all texts
-  foreach (BI_StrokeText* text, mFootprint.getStrokeTexts()) {
-    appendChild(new CmdFootprintStrokeTextRemove(mFootprint, *text));
+  foreach (BI_StrokeText* text, footprint.getStrokeTexts()) {
+    appendChild(new CmdFootprintStrokeTextRemove(footprint, *text));
   }
 
   // Copy all footprint texts and transform them to the global coordinate system
   // (not relative to the footprint). The original UUIDs are kept for future
-  // identification.
-  for (const StrokeText& text :
-       mFootprint.getDeviceInstance().getLibFootprint().getStrokeTexts()) {
-    QScopedPointer<BI_StrokeText> newText(
-        new BI_StrokeText(mFootprint.getBoard(), text));
-    CmdStrokeTextEdit cmd(newText->getText());
-    cmd.rotate(mFootprint.getRotation(), Point(0, 0), true);
-    if (mFootprint.getIsMirrored()) {
+  // identification. The transformation is applied before creating the board
+  // item, i.e. while the text has neither a font nor graphics items, thus it
+  // doesn't trigger any path or graphics updates.
+  for (const StrokeText& libText :
+       footprint.getDeviceInstance().getLibFootprint().getStrokeTexts()) {
+    StrokeText        text(libText);
+    CmdStrokeTextEdit cmd(text);
+    cmd.rotate(footprint.getRotation(), Point(0, 0), true);
+    if (footprint.getIsMirrored()) {
       cmd.mirrorGeometry(Qt::Horizontal, Point(0, 0), true);
       cmd.mirrorLayer(true);
     }
-    cmd.setPosition(newText->getText().getPosition() + mFootprint.getPosition(),
-                    true);
+    cmd.setPosition(text.getPosition() + footprint.getPosition(), true);
     cmd.execute();  // can throw
-    appendChild(new CmdFootprintStrokeTextAdd(mFootprint, *newText.take()));
+    QScopedPointer<BI_StrokeText> newText(
+        new BI_StrokeText(footprint.getBoard(), text));  // can throw
+    appendChild(new CmdFootprintStrokeTextAdd(footprint, *newText.take()));
   }
-
-  // execute all child commands
-  return UndoCommandGroup::performExecute();  // can throw
 }
 
 /*******************************************************************************
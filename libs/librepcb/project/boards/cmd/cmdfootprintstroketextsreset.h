@@ -41,11 +41,17 @@ class BI_Footprint;
 
 /**
  * @brief The CmdFootprintStrokeTextsReset class
+ *
+ * Replaces the stroke texts of one or more footprints by the texts of their
+ * library footprints. Resetting the texts of many footprints at once (e.g. of
+ * all devices of a board) results in a single undo command.
  */
 class CmdFootprintStrokeTextsReset final : public UndoCommandGroup {
 public:
   // Constructors / Destructor
-  CmdFootprintStrokeTextsReset(BI_Footprint& footprint) noexcept;
+  explicit CmdFootprintStrokeTextsReset(BI_Footprint& footprint) noexcept;
+  explicit CmdFootprintStrokeTextsReset(
+      const QList<BI_Footprint*>& footprints) noexcept;
   ~CmdFootprintStrokeTextsReset() noexcept;
 
 private:
@@ -54,8 +60,10 @@ private:
   /// @copydoc UndoCommand::performExecute()
   bool performExecute() override;
 
+  void resetTexts(BI_Footprint& footprint);
+
   // Private Member Variables
-  BI_Footprint& mFootprint;
+  QList<BI_Footprint*> mFootprints;
 };
 
 /*******************************************************************************
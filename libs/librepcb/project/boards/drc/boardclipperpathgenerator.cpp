@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boardclipperpathgenerator.h"
 
+#include "../../circuit/netsignal.h"
 #include "../board.h"
 #include "../items/bi_device.h"
 #include "../items/bi_footprint.h"
@@ -36,6 +37,8 @@
 #include <librepcb/common/geometry/polygon.h>
 #include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/clippershapecache.h>
+#include <librepcb/common/utils/transform.h>
 #include <librepcb/library/pkg/footprint.h>
 
 #include <QtCore>
@@ -75,16 +78,16 @@ void BoardClipperPathGenerator::addBoardOutline() {
 
   // footprint polygons
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
+    const Transform transform(device->getFootprint().getPosition(),
+                              device->getFootprint().getRotation(),
+                              device->getFootprint().getIsMirrored());
     for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
       if (polygon.getLayerName() != GraphicsLayer::sBoardOutlines) {
         continue;
       }
-      Path path = polygon.getPath();
-      path.rotate(device->getFootprint().getRotation());
-      if (device->getFootprint().getIsMirrored()) path.mirror(Qt::Horizontal);
-      path.translate(device->getFootprint().getPosition());
-      ClipperHelpers::unite(mPaths,
-                            ClipperHelpers::convert(path, mMaxArcTolerance));
+      ClipperHelpers::unite(
+          mPaths, ClipperHelpers::convert(transform.map(polygon.getPath()),
+                                          mMaxArcTolerance));
     }
   }
 }
@@ -96,10 +99,9 @@ void BoardClipperPathGenerator::addHoles(const Length& offset) {
     if (diameter <= 0) {
       continue;
     }
-    Path path =
-        Path::circle(PositiveLength(diameter)).translated(hole->getPosition());
-    ClipperHelpers::unite(mPaths,
-                          ClipperHelpers::convert(path, mMaxArcTolerance));
+    ClipperHelpers::unite(mPaths, ClipperShapeCache::instance().get(
+                                      Path::circle(PositiveLength(diameter)),
+                                      hole->getPosition(), mMaxArcTolerance));
   }
 
   // footprint holes
@@ -109,23 +111,58 @@ void BoardClipperPathGenerator::addHoles(const Length& offset) {
       if (diameter <= 0) {
         continue;
       }
-      Path path =
-          Path::circle(PositiveLength(diameter)).translated(hole.getPosition());
-      path.rotate(device->getFootprint().getRotation());
-      if (device->getFootprint().getIsMirrored()) path.mirror(Qt::Horizontal);
-      path.translate(device->getFootprint().getPosition());
-      ClipperHelpers::unite(mPaths,
-                            ClipperHelpers::convert(path, mMaxArcTolerance));
+      Point pos = device->getFootprint().mapToScene(hole.getPosition());
+      ClipperHelpers::unite(
+          mPaths,
+          ClipperShapeCache::instance().get(
+              Path::circle(PositiveLength(diameter)), pos, mMaxArcTolerance));
     }
   }
 }
 
 void BoardClipperPathGenerator::addCopper(const QString&   layerName,
                                           const NetSignal* netsignal) {
+  foreach (const Path& path, calcCopperPrimitives(layerName, netsignal)) {
+    ClipperHelpers::unite(mPaths,
+                          ClipperHelpers::convert(path, mMaxArcTolerance));
+  }
+}
+
+QVector<Path> BoardClipperPathGenerator::calcCopperPrimitives(
+    const QString& layerName, const NetSignal* netsignal) const {
+  QVector<Path> primitives;
+  visitCopper(QStringList{layerName},
+              [netsignal](int, const NetSignal* net, const BI_Base&) {
+                return net == netsignal;
+              },
+              [&primitives](int, const NetSignal*, const Path& path) {
+                primitives.append(path);
+              });
+  return primitives;
+}
+
+uint BoardClipperPathGenerator::calcCopperRevisionStamp(
+    const QString& layerName, const NetSignal* netsignal) const {
+  uint stamp = qHash(layerName);
+  visitCopper(QStringList{layerName},
+              [netsignal, &stamp](int, const NetSignal* net,
+                                  const BI_Base& item) {
+                if (net == netsignal) {
+                  stamp = qHash(item.getRevision(), stamp);
+                }
+                return false;  // no need to generate any paths
+              },
+              [](int, const NetSignal*, const Path&) {});
+  return stamp;
+}
+
+void BoardClipperPathGenerator::visitCopper(
+    const QStringList& layerNames, const ItemCallback& itemCallback,
+    const PathCallback& pathCallback) const {
   // polygons
   foreach (const BI_Polygon* polygon, mBoard.getPolygons()) {
-    if ((polygon->getPolygon().getLayerName() != layerName) ||
-        (netsignal != nullptr)) {
+    int layer = layerNames.indexOf(*polygon->getPolygon().getLayerName());
+    if ((layer < 0) || (!itemCallback(layer, nullptr, *polygon))) {
       continue;
     }
     // outline
@@ -133,54 +170,53 @@ void BoardClipperPathGenerator::addCopper(const QString&   layerName,
       QVector<Path> paths = polygon->getPolygon().getPath().toOutlineStrokes(
           PositiveLength(*polygon->getPolygon().getLineWidth()));
       foreach (const Path& p, paths) {
-        ClipperHelpers::unite(mPaths,
-                              ClipperHelpers::convert(p, mMaxArcTolerance));
+        pathCallback(layer, nullptr, p);
       }
     }
     // area (only fill closed paths, for consistency with the appearance in the
     // board editor and Gerber output)
     if (polygon->getPolygon().isFilled() &&
         polygon->getPolygon().getPath().isClosed()) {
-      ClipperHelpers::unite(
-          mPaths, ClipperHelpers::convert(polygon->getPolygon().getPath(),
-                                          mMaxArcTolerance));
+      pathCallback(layer, nullptr, polygon->getPolygon().getPath());
     }
   }
 
   // stroke texts
   foreach (const BI_StrokeText* text, mBoard.getStrokeTexts()) {
-    if ((text->getText().getLayerName() != layerName) ||
-        (netsignal != nullptr)) {
+    int layer = layerNames.indexOf(*text->getText().getLayerName());
+    if ((layer < 0) || (!itemCallback(layer, nullptr, *text))) {
       continue;
     }
-    PositiveLength width(qMax(*text->getText().getStrokeWidth(), Length(1)));
-    foreach (Path path, text->getText().getPaths()) {
-      path.rotate(text->getText().getRotation());
-      if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
-      path.translate(text->getText().getPosition());
+    PositiveLength  width(qMax(*text->getText().getStrokeWidth(), Length(1)));
+    const Transform transform(text->getText().getPosition(),
+                              text->getText().getRotation(),
+                              text->getText().getMirrored());
+    foreach (const Path& path, transform.map(text->getText().getPaths())) {
       QVector<Path> paths = path.toOutlineStrokes(width);
       foreach (const Path& p, paths) {
-        ClipperHelpers::unite(mPaths,
-                              ClipperHelpers::convert(p, mMaxArcTolerance));
+        pathCallback(layer, nullptr, p);
       }
     }
   }
 
   // planes
   foreach (const BI_Plane* plane, mBoard.getPlanes()) {
-    if ((plane->getLayerName() != layerName) ||
-        (&plane->getNetSignal() != netsignal)) {
+    int              layer = layerNames.indexOf(*plane->getLayerName());
+    const NetSignal* net   = &plane->getNetSignal();
+    if ((layer < 0) || (!itemCallback(layer, net, *plane))) {
       continue;
     }
     foreach (const Path& p, plane->getFragments()) {
-      ClipperHelpers::unite(mPaths,
-                            ClipperHelpers::convert(p, mMaxArcTolerance));
+      pathCallback(layer, net, p);
     }
   }
 
   // devices
   foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
     const BI_Footprint& footprint = device->getFootprint();
+    const Transform     transform(footprint.getPosition(),
+                                  footprint.getRotation(),
+                                  footprint.getIsMirrored());
 
     // polygons
     for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
@@ -188,27 +224,23 @@ void BoardClipperPathGenerator::addCopper(const QString&   layerName,
       if (footprint.getIsMirrored()) {
         polygonLayer = GraphicsLayer::getMirroredLayerName(polygonLayer);
       }
-      if ((polygonLayer != layerName) || (netsignal != nullptr)) {
+      int layer = layerNames.indexOf(polygonLayer);
+      if ((layer < 0) || (!itemCallback(layer, nullptr, footprint))) {
         continue;
       }
-      Path path = polygon.getPath();
-      path.rotate(footprint.getRotation());
-      if (footprint.getIsMirrored()) path.mirror(Qt::Horizontal);
-      path.translate(footprint.getPosition());
+      Path path = transform.map(polygon.getPath());
       // outline
       if (polygon.getLineWidth() > 0) {
         QVector<Path> paths =
             path.toOutlineStrokes(PositiveLength(*polygon.getLineWidth()));
         foreach (const Path& p, paths) {
-          ClipperHelpers::unite(mPaths,
-                                ClipperHelpers::convert(p, mMaxArcTolerance));
+          pathCallback(layer, nullptr, p);
         }
       }
       // area (only fill closed paths, for consistency with the appearance in
       // the board editor and Gerber output)
       if (polygon.isFilled() && path.isClosed()) {
-        ClipperHelpers::unite(mPaths,
-                              ClipperHelpers::convert(path, mMaxArcTolerance));
+        pathCallback(layer, nullptr, path);
       }
     }
 
@@ -218,86 +250,91 @@ void BoardClipperPathGenerator::addCopper(const QString&   layerName,
       if (footprint.getIsMirrored()) {
         circleLayer = GraphicsLayer::getMirroredLayerName(circleLayer);
       }
-      if ((circleLayer != layerName) || (netsignal != nullptr)) {
+      int layer = layerNames.indexOf(circleLayer);
+      if ((layer < 0) || (!itemCallback(layer, nullptr, footprint))) {
         continue;
       }
-      Point absolutePos = circle.getCenter();
-      absolutePos.rotate(footprint.getRotation());
-      if (footprint.getIsMirrored()) absolutePos.mirror(Qt::Horizontal);
-      absolutePos += footprint.getPosition();
-      Path path = Path::circle(circle.getDiameter());
-      path.translate(absolutePos);
+      Path path = Path::circle(circle.getDiameter())
+                      .translated(transform.map(circle.getCenter()));
       // outline
       if (circle.getLineWidth() > 0) {
         QVector<Path> paths =
             path.toOutlineStrokes(PositiveLength(*circle.getLineWidth()));
         foreach (const Path& p, paths) {
-          ClipperHelpers::unite(mPaths,
-                                ClipperHelpers::convert(p, mMaxArcTolerance));
+          pathCallback(layer, nullptr, p);
         }
       }
       // area
       if (circle.isFilled()) {
-        ClipperHelpers::unite(mPaths,
-                              ClipperHelpers::convert(path, mMaxArcTolerance));
+        pathCallback(layer, nullptr, path);
       }
     }
 
     // stroke texts
     foreach (const BI_StrokeText* text, footprint.getStrokeTexts()) {
       // Do *not* mirror layer since it is independent of the device!
-      if ((*text->getText().getLayerName() != layerName) ||
-          (netsignal != nullptr)) {
+      int layer = layerNames.indexOf(*text->getText().getLayerName());
+      if ((layer < 0) || (!itemCallback(layer, nullptr, *text))) {
         continue;
       }
-      PositiveLength width(qMax(*text->getText().getStrokeWidth(), Length(1)));
-      foreach (Path path, text->getText().getPaths()) {
-        path.rotate(text->getText().getRotation());
-        if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(text->getText().getPosition());
+      PositiveLength  width(qMax(*text->getText().getStrokeWidth(), Length(1)));
+      const Transform textTransform(text->getText().getPosition(),
+                                    text->getText().getRotation(),
+                                    text->getText().getMirrored());
+      foreach (const Path& path,
+               textTransform.map(text->getText().getPaths())) {
         foreach (const Path& p, path.toOutlineStrokes(width)) {
-          ClipperHelpers::unite(mPaths,
-                                ClipperHelpers::convert(p, mMaxArcTolerance));
+          pathCallback(layer, nullptr, p);
         }
       }
     }
 
-    // pads
+    // pads (THT pads are on multiple layers, so visit each of them but
+    // generate their outline only once since it's the same on all layers)
     foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-      if ((!pad->isOnLayer(layerName)) ||
-          (pad->getCompSigInstNetSignal() != netsignal)) {
-        continue;
+      const NetSignal* net = pad->getCompSigInstNetSignal();
+      Path             outline;
+      bool             outlineGenerated = false;
+      for (int layer = 0; layer < layerNames.count(); ++layer) {
+        if ((pad->isOnLayer(layerNames.at(layer))) &&
+            (itemCallback(layer, net, *pad))) {
+          if (!outlineGenerated) {
+            outline          = pad->getSceneOutline();
+            outlineGenerated = true;
+          }
+          pathCallback(layer, net, outline);
+        }
       }
-      ClipperHelpers::unite(
-          mPaths,
-          ClipperHelpers::convert(pad->getSceneOutline(), mMaxArcTolerance));
     }
   }
 
   // net segment items
   foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
-    if (&netsegment->getNetSignal() != netsignal) {
-      continue;
-    }
+    const NetSignal* net = &netsegment->getNetSignal();
 
-    // vias
+    // vias (on all copper layers, with the same outline on each of them)
     foreach (const BI_Via* via, netsegment->getVias()) {
-      if (!via->isOnLayer(layerName)) {
-        continue;
+      Path outline;
+      bool outlineGenerated = false;
+      for (int layer = 0; layer < layerNames.count(); ++layer) {
+        if ((via->isOnLayer(layerNames.at(layer))) &&
+            (itemCallback(layer, net, *via))) {
+          if (!outlineGenerated) {
+            outline          = via->getSceneOutline();
+            outlineGenerated = true;
+          }
+          pathCallback(layer, net, outline);
+        }
       }
-      ClipperHelpers::unite(
-          mPaths,
-          ClipperHelpers::convert(via->getSceneOutline(), mMaxArcTolerance));
     }
 
     // netlines
     foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
-      if (&netline->getLayer().getName() != layerName) {
+      int layer = layerNames.indexOf(netline->getLayer().getName());
+      if ((layer < 0) || (!itemCallback(layer, net, *netline))) {
         continue;
       }
-      ClipperHelpers::unite(mPaths,
-                            ClipperHelpers::convert(netline->getSceneOutline(),
-                                                    mMaxArcTolerance));
+      pathCallback(layer, net, netline->getSceneOutline());
     }
   }
 }
@@ -28,16 +28,20 @@
 
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 
 class GraphicsLayer;
+class Path;
 
 namespace project {
 
 class Board;
+class BI_Base;
 class NetSignal;
 
 /*******************************************************************************
@@ -50,6 +54,14 @@ class NetSignal;
  */
 class BoardClipperPathGenerator final {
 public:
+  // Types
+  typedef std::function<bool(int layer, const NetSignal* netsignal,
+                             const BI_Base& item)>
+      ItemCallback;
+  typedef std::function<void(int layer, const NetSignal* netsignal,
+                             const Path& path)>
+      PathCallback;
+
   // Constructors / Destructor
   explicit BoardClipperPathGenerator(
       Board& board, const PositiveLength& maxArcTolerance) noexcept;
@@ -63,6 +75,58 @@ public:
   void addHoles(const Length& offset);
   void addCopper(const QString& layerName, const NetSignal* netsignal);
 
+  /**
+   * @brief Calculate a revision stamp of the copper objects of a layer and net
+   *
+   * The stamp is calculated from the revisions (see
+   * ::librepcb::project::BI_Base::getRevision()) of the same objects as added
+   * by #addCopper(), but without generating any geometry. So it can be used
+   * to cheaply check whether previously generated copper paths are still up
+   * to date.
+   *
+   * @param layerName   The layer to calculate the stamp for.
+   * @param netsignal   The net signal to calculate the stamp for
+   *                    (`nullptr` for unconnected copper objects).
+   *
+   * @return The stamp (changes whenever any of the objects changes, or
+   *         objects are added or removed)
+   */
+  uint calcCopperRevisionStamp(const QString&   layerName,
+                               const NetSignal* netsignal) const;
+
+  /**
+   * @brief Get the (not yet united) copper paths of a layer and net
+   *
+   * @param layerName   The layer to get the paths for.
+   * @param netsignal   The net signal to get the paths for
+   *                    (`nullptr` for unconnected copper objects).
+   *
+   * @return All paths which #addCopper() would unite, in the same order
+   */
+  QVector<Path> calcCopperPrimitives(const QString&   layerName,
+                                     const NetSignal* netsignal) const;
+
+  /**
+   * @brief Visit the copper objects of several layers in a single pass
+   *
+   * For every copper object on one of the passed layers, the item callback
+   * is called with the index of the layer (in `layerNames`) and the net
+   * signal of the object (`nullptr` for unconnected objects). Objects which
+   * exist on multiple layers (e.g. vias) are visited once per layer. Only if
+   * the item callback returns `true`, the paths of the object are generated
+   * and passed to the path callback. Paths of objects which have the same
+   * shape on all layers (THT pads and vias) are generated only once and then
+   * passed for each layer, so visiting all layers at once is much cheaper
+   * than visiting them one by one.
+   *
+   * @param layerNames    The layers to visit.
+   * @param itemCallback  Called for every visited item.
+   * @param pathCallback  Called for every generated path.
+   */
+  void visitCopper(const QStringList& layerNames,
+                   const ItemCallback& itemCallback,
+                   const PathCallback& pathCallback) const;
+
 private:  // Data
   Board&            mBoard;
   PositiveLength    mMaxArcTolerance;
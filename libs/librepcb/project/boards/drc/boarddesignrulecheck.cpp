@@ -22,49 +22,147 @@
  ******************************************************************************/
 #include "boarddesignrulecheck.h"
 
-#include "../../circuit/circuit.h"
-#include "../../circuit/componentinstance.h"
-#include "../../circuit/netsignal.h"
-#include "../../project.h"
 #include "../board.h"
-#include "../boardlayerstack.h"
-#include "../items/bi_airwire.h"
-#include "../items/bi_device.h"
-#include "../items/bi_footprint.h"
-#include "../items/bi_footprintpad.h"
-#include "../items/bi_hole.h"
-#include "../items/bi_netline.h"
-#include "../items/bi_netsegment.h"
-#include "../items/bi_plane.h"
-#include "../items/bi_stroketext.h"
-#include "../items/bi_via.h"
-#include "boardclipperpathgenerator.h"
-
-#include <librepcb/common/geometry/hole.h>
-#include <librepcb/common/geometry/stroketext.h>
+#include "../boardcopperpathcache.h"
+#include "../boardoutlineareacache.h"
+#include "boarddesignrulechecksnapshot.h"
+
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/toolbox.h>
+#include <librepcb/common/tracer.h>
+#include <librepcb/common/utils/clipperareacache.h>
 #include <librepcb/common/utils/clipperhelpers.h>
-#include <librepcb/library/pkg/footprint.h>
-#include <librepcb/library/pkg/footprintpad.h>
+#include <librepcb/common/utils/clippershapecache.h>
+#include <librepcb/common/utils/taskscheduler.h>
 
 #include <QtCore>
 
+#include <exception>
+#include <functional>
+#include <numeric>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
 namespace librepcb {
 namespace project {
 
+/*******************************************************************************
+ *  Local Helpers
+ ******************************************************************************/
+
+/// Priority of all DRC jobs: The user waits for the results, but rendering
+/// and other interactive work must not be delayed by a running check.
+static const TaskScheduler::Priority sPriority =
+    TaskScheduler::Priority::Normal;
+
+/**
+ * @brief Wait until all given jobs are finished
+ *
+ * Errors are only rethrown after *all* jobs are finished since the jobs are
+ * accessing the snapshot and the data of the ::BoardDesignRuleCheck object.
+ *
+ * @param jobs      The jobs to wait for.
+ * @param progress  Callback which is called after each finished job with the
+ *                  normalized progress (0..1).
+ */
+template <typename T>
+static void waitForAllJobs(QList<QFuture<T>>                 jobs,
+                           const std::function<void(qreal)>& progress) {
+  std::exception_ptr error;
+  for (int i = 0; i < jobs.count(); ++i) {
+    try {
+      jobs[i].waitForFinished();
+    } catch (...) {
+      if (!error) error = std::current_exception();
+    }
+    progress(qreal(i + 1) / jobs.count());
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+/*******************************************************************************
+ *  Class BoardDesignRuleCheck::Options
+ ******************************************************************************/
+
+BoardDesignRuleCheck::Options::Options(const SExpression& node)
+  : Options()  // this loads all default values!
+{
+  if (const SExpression* e = node.tryGetChildByPath("min_copper_width")) {
+    minCopperWidth = e->getValueOfFirstChild<UnsignedLength>();
+  }
+  if (const SExpression* e =
+          node.tryGetChildByPath("min_copper_copper_clearance")) {
+    minCopperCopperClearance = e->getValueOfFirstChild<UnsignedLength>();
+  }
+  if (const SExpression* e =
+          node.tryGetChildByPath("min_copper_board_clearance")) {
+    minCopperBoardClearance = e->getValueOfFirstChild<UnsignedLength>();
+  }
+  if (const SExpression* e =
+          node.tryGetChildByPath("min_copper_npth_clearance")) {
+    minCopperNpthClearance = e->getValueOfFirstChild<UnsignedLength>();
+  }
+  if (const SExpression* e = node.tryGetChildByPath("min_pth_restring")) {
+    minPthRestring = e->getValueOfFirstChild<UnsignedLength>();
+  }
+  if (const SExpression* e =
+          node.tryGetChildByPath("min_npth_drill_diameter")) {
+    minNpthDrillDiameter = e->getValueOfFirstChild<UnsignedLength>();
+  }
+  if (const SExpression* e = node.tryGetChildByPath("min_pth_drill_diameter")) {
+    minPthDrillDiameter = e->getValueOfFirstChild<UnsignedLength>();
+  }
+  if (const SExpression* e = node.tryGetChildByPath("courtyard_offset")) {
+    courtyardOffset = e->getValueOfFirstChild<Length>();
+  }
+  if (const SExpression* e =
+          node.tryGetChildByPath("max_messages_per_check")) {
+    maxMessagesPerCheck = qMax(e->getValueOfFirstChild<int>(), 0);
+  }
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 BoardDesignRuleCheck::BoardDesignRuleCheck(Board& board, const Options& options,
                                            QObject* parent) noexcept
-  : QObject(parent), mBoard(board), mOptions(options), mMessages() {
+  : QObject(parent),
+    mBoard(board),
+    mCopperPathCache(board.getSharedCopperPathCache()),
+    mOutlineAreaCache(board.getSharedOutlineAreaCache()),
+    mOptions(options),
+    mMessages(),
+    mCancelRequested(0),
+    mStageFoundMessages(0),
+    mStageAddedMessages(0),
+    mMessageLimitReached(false),
+    mCachedRestrictedAreaFingerprint(0) {
 }
 
 BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
+  // The worker thread accesses this object, so wait until it is finished.
+  cancel();
+  try {
+    mFuture.waitForFinished();
+  } catch (...) {
+  }
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void BoardDesignRuleCheck::setOptions(const Options& options) noexcept {
+  Q_ASSERT(!isRunning());
+  if (options != mOptions) {
+    mOptions = options;
+    clearCache();  // cached results are based on the old options
+  }
 }
 
 /*******************************************************************************
@@ -72,20 +170,90 @@ BoardDesignRuleCheck::~BoardDesignRuleCheck() noexcept {
  ******************************************************************************/
 
 void BoardDesignRuleCheck::execute() {
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::execute");
+  prepare();  // can throw
+  run();      // can throw
+}
+
+void BoardDesignRuleCheck::start() {
+  if (isRunning()) {
+    throw LogicError(__FILE__, __LINE__, "The DRC is already running.");
+  }
+  prepare();  // can throw
+  mFuture = TaskScheduler::run(sPriority, [this]() { run(); });
+}
+
+void BoardDesignRuleCheck::waitForFinished() {
+  mFuture.waitForFinished();  // can throw
+}
+
+void BoardDesignRuleCheck::clearCache() noexcept {
+  mCachedPaths.clear();
+  mCachedRestrictedAreaFingerprint = 0;
+  mCachedBoardClearanceMessages.clear();
+  mCachedCopperClearanceMessages.clear();
+  mCachedCopperWidthMessages.clear();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardDesignRuleCheck::prepare() {
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::prepare");
   emit started();
   emit progressPercent(5);
 
   mMessages.clear();
+  mStageDurations.clear();
+  mCancelRequested.store(0);
+  mStageFoundMessages.store(0);
+  mStageAddedMessages  = 0;
+  mMessageLimitReached = false;
+  mStageTimer.start();
 
-  rebuildPlanes(5, 15);
-  checkCopperBoardClearances(15, 40);
-  checkCopperCopperClearances(40, 70);
-  checkMinimumCopperWidth(70, 72);
-  checkMinimumPthRestring(72, 74);
-  checkMinimumPthDrillDiameter(74, 76);
-  checkMinimumNpthDrillDiameter(76, 78);
-  checkCourtyardClearances(78, 88);
-  checkForMissingConnections(88, 90);
+  // These stages access the board, so they must run in the main thread.
+  try {
+    rebuildPlanes(5, 10);
+    finishStage("rebuild_planes");
+    takeSnapshot(10, 12);
+    finishStage("take_snapshot");
+  } catch (...) {
+    mSnapshot.reset();
+    clearCache();  // the cache might be inconsistent now
+    emit finished();
+    throw;
+  }
+}
+
+void BoardDesignRuleCheck::run() {
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::run");
+  // These stages only access the snapshot, so they may run in any thread.
+  try {
+    prepareCopperPaths(12, 15);
+    finishStage("prepare_copper_paths");
+    checkCopperBoardClearances(15, 40);
+    finishStage("copper_board_clearances");
+    checkCopperCopperClearances(40, 70);
+    finishStage("copper_copper_clearances");
+    checkMinimumCopperWidth(70, 75);
+    finishStage("min_copper_width");
+    checkDrills(75, 78);
+    finishStage("drills");
+    checkCourtyardClearances(78, 88);
+    finishStage("courtyard_clearances");
+    checkForMissingConnections(88, 90);
+    finishStage("missing_connections");
+  } catch (...) {
+    mSnapshot.reset();
+    clearCache();  // the cache might be inconsistent now
+    emit finished();
+    throw;
+  }
+  mSnapshot.reset();  // release memory
+  if (mMessageLimitReached) {
+    clearCache();  // some checks stopped early, thus results are incomplete
+  }
 
   emit progressStatus(
       tr("Finished with %1 message(s)!", "Count of messages", mMessages.count())
@@ -94,30 +262,94 @@ void BoardDesignRuleCheck::execute() {
   emit finished();
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
+void BoardDesignRuleCheck::finishStage(const char* stage) {
+  mStageDurations.append(qMakePair(QString(stage), mStageTimer.restart()));
+  resetMessageCounters();
+  throwIfCanceled();  // can throw
+}
 
 void BoardDesignRuleCheck::rebuildPlanes(int progressStart, int progressEnd) {
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::rebuildPlanes");
   Q_UNUSED(progressStart);
   emit progressStatus(tr("Rebuild planes..."));
   mBoard.rebuildAllPlanes();
   emit progressPercent(progressEnd);
 }
 
+void BoardDesignRuleCheck::takeSnapshot(int progressStart, int progressEnd) {
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::takeSnapshot");
+  Q_UNUSED(progressStart);
+  emit progressStatus(tr("Take snapshot of board..."));
+
+  // No check based on copper paths implemented yet for missing connections,
+  // so make sure the airwires are up to date.
+  mBoard.finishLoading();
+  mBoard.forceAirWiresRebuild();
+
+  // Only collect the copper objects of layers and net signals which were
+  // modified since the previous run, the others are taken from the cache.
+  mSnapshot = std::make_shared<const BoardDesignRuleCheckSnapshot>(
+      mBoard, [this](const GraphicsLayer* layer, const NetSignal* netsignal,
+                     uint revisionStamp) {
+        auto layerIt = mCachedPaths.constFind(layer);
+        if (layerIt != mCachedPaths.constEnd()) {
+          auto netIt = layerIt->constFind(netsignal);
+          if (netIt != layerIt->constEnd()) {
+            return netIt->revisionStamp != revisionStamp;
+          }
+        }
+        return true;
+      });
+
+  emit progressPercent(progressEnd);
+}
+
+void BoardDesignRuleCheck::prepareCopperPaths(int progressStart,
+                                              int progressEnd) {
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::prepareCopperPaths");
+  emit progressStatus(tr("Prepare copper areas..."));
+
+  // generate the paths of all layers and net signals in parallel
+  const BoardDesignRuleCheckSnapshot& snapshot = *mSnapshot;
+  QList<QFuture<CopperPaths>>         jobs;
+  for (int l = 0; l < snapshot.getCopperLayers().count(); ++l) {
+    for (int n = 0; n < snapshot.getNets().count(); ++n) {
+      jobs.append(TaskScheduler::run(
+          sPriority, [this, l, n]() { return calcCopperPaths(l, n); }));
+    }
+  }
+
+  qreal progressSpan = progressEnd - progressStart;
+  waitForAllJobs(jobs, [this, progressStart, progressSpan](qreal done) {
+    emit progressPercent(progressStart + static_cast<int>(progressSpan * done));
+  });
+
+  // replace the cache (also drops layers and net signals which do not exist
+  // anymore)
+  QHash<const GraphicsLayer*, QHash<const NetSignal*, CopperPaths>> paths;
+  int netCount = snapshot.getNets().count();
+  for (int i = 0; i < jobs.count(); ++i) {
+    const auto& layer = snapshot.getCopperLayers()[i / netCount];
+    const auto& net   = snapshot.getNets()[i % netCount];
+    paths[layer.layer][net.netsignal] = jobs[i].result();
+  }
+  mCachedPaths = paths;
+}
+
 void BoardDesignRuleCheck::checkForMissingConnections(int progressStart,
                                                       int progressEnd) {
+  LIBREPCB_TRACE_SCOPE("drc",
+                       "BoardDesignRuleCheck::checkForMissingConnections");
   Q_UNUSED(progressStart);
   emit progressStatus(tr("Check for missing connections..."));
 
   // No check based on copper paths implemented yet -> return existing airwires
   // instead.
-  mBoard.forceAirWiresRebuild();
-  foreach (const BI_AirWire* airwire, mBoard.getAirWires()) {
+  foreach (const auto& airwire, mSnapshot->getAirWires()) {
     QString msg = tr("Missing connection: '%1'", "Placeholder is net name")
-                      .arg(*airwire->getNetSignal().getName());
-    Path location = Path::obround(airwire->getP1(), airwire->getP2(),
-                                  PositiveLength(50000));
+                      .arg(airwire.netName);
+    Path location =
+        Path::obround(airwire.p1, airwire.p2, PositiveLength(50000));
     addMessage(BoardDesignRuleCheckMessage(msg, location));
   }
 
@@ -126,22 +358,18 @@ void BoardDesignRuleCheck::checkForMissingConnections(int progressStart,
 
 void BoardDesignRuleCheck::checkCopperBoardClearances(int progressStart,
                                                       int progressEnd) {
+  LIBREPCB_TRACE_SCOPE("drc",
+                       "BoardDesignRuleCheck::checkCopperBoardClearances");
   emit progressStatus(tr("Check board clearances..."));
 
-  qreal             progressSpan = progressEnd - progressStart;
-  QList<NetSignal*> netsignals =
-      mBoard.getProject().getCircuit().getNetSignals().values();
-  netsignals.append(nullptr);  // also check unconnected copper objects
-
-  // Board outline
-  ClipperLib::Paths outlineRestrictedArea;
+  // Board outline (the areas are shared with the planes and previous runs)
+  ClipperLib::Paths outlineRestrictedArea = mOutlineAreaCache->getArea(
+      mSnapshot->getBoardOutlinesRevisionStamp(),
+      mSnapshot->getBoardOutlines(), Length(0), maxArcTolerance());
   {
-    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-    gen.addBoardOutline();
-    outlineRestrictedArea               = gen.getPaths();
-    ClipperLib::Paths outlinePathsInner = gen.getPaths();
-    ClipperHelpers::offset(
-        outlinePathsInner,
+    ClipperLib::Paths outlinePathsInner = mOutlineAreaCache->getArea(
+        mSnapshot->getBoardOutlinesRevisionStamp(),
+        mSnapshot->getBoardOutlines(),
         *maxArcTolerance() - *mOptions.minCopperBoardClearance,
         maxArcTolerance());
     ClipperHelpers::subtract(outlineRestrictedArea, outlinePathsInner);
@@ -149,412 +377,668 @@ void BoardDesignRuleCheck::checkCopperBoardClearances(int progressStart,
 
   // Holes
   {
-    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-    gen.addHoles(*mOptions.minCopperNpthClearance - *maxArcTolerance());
-    ClipperHelpers::unite(outlineRestrictedArea, gen.getPaths());
-  }
+    Length offset = *mOptions.minCopperNpthClearance - *maxArcTolerance();
 
-  auto layers = mBoard.getLayerStack().getAllLayers();
-  for (int layerIndex = 0; layerIndex < layers.count(); ++layerIndex) {
-    const GraphicsLayer* layer = layers[layerIndex];
-    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
-      continue;
+    ClipperLib::Paths holes;
+    foreach (const auto& drill, mSnapshot->getDrills()) {
+      if (drill.type != BoardDesignRuleCheckSnapshot::Drill::Type::Hole) {
+        continue;
+      }
+      Length diameter = drill.diameter + (offset * 2);
+      if (diameter > 0) {
+        ClipperHelpers::unite(holes, ClipperShapeCache::instance().get(
+                                         Path::circle(PositiveLength(diameter)),
+                                         drill.position, maxArcTolerance()));
+      }
     }
-    for (int i = 0; i < netsignals.count(); ++i) {
-      std::unique_ptr<ClipperLib::PolyTree> intersections =
-          ClipperHelpers::intersect(outlineRestrictedArea,
-                                    getCopperPaths(layer, netsignals[i]));
-      for (const ClipperLib::Path& path :
-           ClipperHelpers::flattenTree(*intersections)) {
-        QString name1 = netsignals[i] ? *netsignals[i]->getName() : "";
-        QString msg   = tr("Clearance (%1): '%2' <-> Board Outline",
-                         "Placeholders are layer name + net name")
-                          .arg(layer->getNameTr(), name1);
-        Path location = ClipperHelpers::convert(path);
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+    ClipperHelpers::unite(outlineRestrictedArea, holes);
+  }
+
+  uint fingerprint = calcFingerprint(outlineRestrictedArea);
+  bool modified    = (fingerprint != mCachedRestrictedAreaFingerprint) ||
+                  mCachedBoardClearanceMessages.isEmpty();
+
+  // Note: The restricted area is captured by reference, this is safe since
+  // waitForAllJobs() waits until all jobs are finished.
+  const auto&                       layers = mSnapshot->getCopperLayers();
+  QList<QFuture<NetSignalMessages>> jobs;
+  for (int i = 0; i < layers.count(); ++i) {
+    jobs.append(TaskScheduler::run(
+        sPriority, [this, i, &outlineRestrictedArea, modified]() {
+          return checkCopperBoardClearancesOnLayer(i, outlineRestrictedArea,
+                                                   modified);
+        }));
+  }
+  qreal progressSpan = progressEnd - progressStart;
+  waitForAllJobs(jobs, [this, progressStart, progressSpan](qreal done) {
+    emit progressPercent(progressStart + static_cast<int>(progressSpan * done));
+  });
+
+  // add messages in a deterministic order and memorize them for the next run
+  mCachedRestrictedAreaFingerprint = fingerprint;
+  mCachedBoardClearanceMessages.clear();
+  for (int i = 0; i < jobs.count(); ++i) {
+    auto& cache =
+        mCachedBoardClearanceMessages[layers[i].layer];  // add empty layer
+    foreach (const auto& item, jobs[i].result()) {
+      cache.insert(item.first, item.second);
+      foreach (const BoardDesignRuleCheckMessage& msg, item.second) {
+        addMessage(msg);
       }
-      qreal progress = progressSpan *
-                       qreal((layerIndex + 1) * netsignals.count() + i + 1) /
-                       qreal(layers.count() * netsignals.count());
-      emit progressPercent(progressStart + static_cast<int>(progress));
     }
   }
 }
 
 void BoardDesignRuleCheck::checkCopperCopperClearances(int progressStart,
                                                        int progressEnd) {
+  LIBREPCB_TRACE_SCOPE("drc",
+                       "BoardDesignRuleCheck::checkCopperCopperClearances");
   emit progressStatus(tr("Check copper clearances..."));
 
-  qreal             progressSpan = progressEnd - progressStart;
-  QList<NetSignal*> netsignals =
-      mBoard.getProject().getCircuit().getNetSignals().values();
-  netsignals.append(nullptr);  // also check unconnected copper objects
+  const auto&                           layers = mSnapshot->getCopperLayers();
+  QList<QFuture<NetSignalPairMessages>> jobs;
+  for (int i = 0; i < layers.count(); ++i) {
+    jobs.append(TaskScheduler::run(sPriority, [this, i]() {
+      return checkCopperCopperClearancesOnLayer(i);
+    }));
+  }
+  qreal progressSpan = progressEnd - progressStart;
+  waitForAllJobs(jobs, [this, progressStart, progressSpan](qreal done) {
+    emit progressPercent(progressStart + static_cast<int>(progressSpan * done));
+  });
 
-  auto layers = mBoard.getLayerStack().getAllLayers();
-  for (int layerIndex = 0; layerIndex < layers.count(); ++layerIndex) {
-    const GraphicsLayer* layer = layers[layerIndex];
-    if ((!layer->isCopperLayer()) || (!layer->isEnabled())) {
-      continue;
-    }
-    for (int i = 0; i < netsignals.count(); ++i) {
-      ClipperLib::Paths paths1 = getCopperPaths(layer, netsignals[i]);
-      ClipperHelpers::offset(
-          paths1, (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
-          maxArcTolerance());
-      for (int k = i + 1; k < netsignals.count(); ++k) {
-        ClipperLib::Paths paths2 = getCopperPaths(layer, netsignals[k]);
-        ClipperHelpers::offset(
-            paths2,
-            (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
-            maxArcTolerance());
-        std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(paths1, paths2);
-        for (const ClipperLib::Path& path :
-             ClipperHelpers::flattenTree(*intersections)) {
-          QString name1 = netsignals[i] ? *netsignals[i]->getName() : "";
-          QString name2 = netsignals[k] ? *netsignals[k]->getName() : "";
-          QString msg   = tr("Clearance (%1): '%2' <-> '%3'",
-                           "Placeholders are layer name + net names")
-                            .arg(layer->getNameTr(), name1, name2);
-          Path location = ClipperHelpers::convert(path);
-          addMessage(BoardDesignRuleCheckMessage(msg, location));
-        }
+  // add messages in a deterministic order and memorize them for the next run
+  mCachedCopperClearanceMessages.clear();
+  for (int i = 0; i < jobs.count(); ++i) {
+    auto& cache = mCachedCopperClearanceMessages[layers[i].layer];
+    foreach (const auto& item, jobs[i].result()) {
+      cache.insert(item.first, item.second);
+      foreach (const BoardDesignRuleCheckMessage& msg, item.second) {
+        addMessage(msg);
       }
-      qreal progress = progressSpan *
-                       qreal((layerIndex + 1) * netsignals.count() + i + 1) /
-                       qreal(layers.count() * netsignals.count());
-      emit progressPercent(progressStart + static_cast<int>(progress));
     }
   }
 }
 
 void BoardDesignRuleCheck::checkCourtyardClearances(int progressStart,
                                                     int progressEnd) {
-  Q_UNUSED(progressStart);
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::checkCourtyardClearances");
   emit progressStatus(tr("Check courtyard clearances..."));
 
-  auto layers = mBoard.getLayerStack().getLayers(
-      {GraphicsLayer::sTopCourtyard, GraphicsLayer::sBotCourtyard});
-  foreach (const GraphicsLayer* layer, layers) {
-    // determine device courtyard areas
-    QMap<const BI_Device*, ClipperLib::Paths> deviceCourtyards;
-    foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-      ClipperLib::Paths paths = getDeviceCourtyardPaths(*device, layer);
-      ClipperHelpers::offset(paths, mOptions.courtyardOffset,
-                             maxArcTolerance());
-      deviceCourtyards.insert(device, paths);
-    }
+  const auto&              layers = mSnapshot->getCourtyardLayers();
+  QVector<QPair<int, int>> statistics(layers.count());  // {pairs, tests}
 
-    // check clearances
-    for (int i = 0; i < deviceCourtyards.count(); ++i) {
-      const BI_Device* dev1 = deviceCourtyards.keys()[i];
-      Q_ASSERT(dev1);
-      const ClipperLib::Paths& paths1 = deviceCourtyards[dev1];
-      for (int k = i + 1; k < deviceCourtyards.count(); ++k) {
-        const BI_Device* dev2 = deviceCourtyards.keys()[k];
-        Q_ASSERT(dev2);
-        const ClipperLib::Paths&              paths2 = deviceCourtyards[dev2];
-        std::unique_ptr<ClipperLib::PolyTree> intersections =
-            ClipperHelpers::intersect(paths1, paths2);
-        for (const ClipperLib::Path& path :
-             ClipperHelpers::flattenTree(*intersections)) {
-          QString name1 = *dev1->getComponentInstance().getName();
-          QString name2 = *dev2->getComponentInstance().getName();
-          QString msg   = tr("Clearance (%1): '%2' <-> '%3'",
-                           "Placeholders are layer name + component names")
-                            .arg(layer->getNameTr(), name1, name2);
-          Path location = ClipperHelpers::convert(path);
-          addMessage(BoardDesignRuleCheckMessage(msg, location));
-        }
-      }
-    }
+  QList<QFuture<QList<BoardDesignRuleCheckMessage>>> jobs;
+  for (int i = 0; i < layers.count(); ++i) {
+    QPair<int, int>* stats = &statistics[i];
+    jobs.append(TaskScheduler::run(sPriority, [this, i, stats]() {
+      return checkCourtyardClearancesOnLayer(i, stats->first, stats->second);
+    }));
   }
+  addMessagesOfJobs(jobs, progressStart, progressEnd);
 
-  emit progressPercent(progressEnd);
+  int pairs = 0;
+  int tests = 0;
+  for (const QPair<int, int>& stats : statistics) {
+    pairs += stats.first;
+    tests += stats.second;
+  }
+  emit progressStatus("  " % tr("%1 of %2 courtyard pairs checked exactly",
+                                "Placeholders are pair counts")
+                                 .arg(tests)
+                                 .arg(pairs));
 }
 
 void BoardDesignRuleCheck::checkMinimumCopperWidth(int progressStart,
                                                    int progressEnd) {
-  Q_UNUSED(progressStart);
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::checkMinimumCopperWidth");
   emit progressStatus(tr("Check minimum copper width..."));
 
-  // stroke texts
-  foreach (const BI_StrokeText* text, mBoard.getStrokeTexts()) {
-    const GraphicsLayer* layer =
-        mBoard.getLayerStack().getLayer(*text->getText().getLayerName());
-    if ((!layer) || (!layer->isCopperLayer()) || (!layer->isEnabled())) {
-      continue;
+  // Polygons and circles have no width attribute, so their copper areas need
+  // to be checked geometrically. This is done in parallel per layer and net
+  // signal, skipping all areas which consist only of objects whose width is
+  // checked by attribute below (traces, pads, vias, planes, texts).
+  const BoardDesignRuleCheckSnapshot&                snapshot = *mSnapshot;
+  QList<QPair<int, int>>                             keys;  // {layer, net}
+  QList<QFuture<QList<BoardDesignRuleCheckMessage>>> jobs;
+  for (int l = 0; l < snapshot.getCopperLayers().count(); ++l) {
+    for (int n = 0; n < snapshot.getNets().count(); ++n) {
+      if (snapshot.getCopper(l, n).hasShapes) {
+        keys.append(qMakePair(l, n));
+        jobs.append(TaskScheduler::run(sPriority, [this, l, n]() {
+          return checkMinimumCopperWidthOfNet(l, n);
+        }));
+      }
     }
-    if (text->getText().getStrokeWidth() < mOptions.minCopperWidth) {
+  }
+  addMessagesOfJobs(jobs, progressStart, progressEnd);
+
+  // memorize the messages for the next run
+  mCachedCopperWidthMessages.clear();
+  for (int i = 0; i < jobs.count(); ++i) {
+    const auto& layer = snapshot.getCopperLayers()[keys[i].first];
+    const auto& net   = snapshot.getNets()[keys[i].second];
+    mCachedCopperWidthMessages[layer.layer].insert(net.netsignal,
+                                                   jobs[i].result());
+  }
+
+  // stroke texts
+  foreach (const auto& text, mSnapshot->getTexts()) {
+    if (text.strokeWidth < mOptions.minCopperWidth) {
       QString msg = tr("Min. copper width (%1) of text: %2",
                        "Placeholders are layer name + width")
-                        .arg(layer->getNameTr(),
-                             formatLength(*text->getText().getStrokeWidth()));
+                        .arg(text.layerNameTr, formatLength(*text.strokeWidth));
       QVector<Path> locations;
-      foreach (Path path, text->getText().getPaths()) {
-        path.rotate(text->getText().getRotation());
-        if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
-        path.translate(text->getText().getPosition());
-        locations += path.toOutlineStrokes(PositiveLength(
-            qMax(*text->getText().getStrokeWidth(), Length(50000))));
+      foreach (const Path& path, text.paths) {
+        locations += path.toOutlineStrokes(
+            PositiveLength(qMax(*text.strokeWidth, Length(50000))));
       }
-      addMessage(BoardDesignRuleCheckMessage(msg, locations));
+      addMessage(BoardDesignRuleCheckMessage(msg, locations, {text.uuid}));
     }
   }
 
   // planes
-  foreach (const BI_Plane* plane, mBoard.getPlanes()) {
-    const GraphicsLayer* layer =
-        mBoard.getLayerStack().getLayer(*plane->getLayerName());
-    if ((!layer) || (!layer->isCopperLayer()) || (!layer->isEnabled())) {
-      continue;
-    }
-    if (plane->getMinWidth() < mOptions.minCopperWidth) {
-      QString msg =
-          tr("Min. copper width (%1) of plane: %2",
-             "Placeholders are layer name + width")
-              .arg(layer->getNameTr(), formatLength(*plane->getMinWidth()));
+  foreach (const auto& plane, mSnapshot->getPlanes()) {
+    if (plane.minWidth < mOptions.minCopperWidth) {
+      QString msg = tr("Min. copper width (%1) of plane: %2",
+                       "Placeholders are layer name + width")
+                        .arg(plane.layerNameTr, formatLength(*plane.minWidth));
       QVector<Path> locations =
-          plane->getOutline().toClosedPath().toOutlineStrokes(
-              PositiveLength(200000));
-      addMessage(BoardDesignRuleCheckMessage(msg, locations));
+          plane.outline.toClosedPath().toOutlineStrokes(PositiveLength(200000));
+      addMessage(BoardDesignRuleCheckMessage(msg, locations, {plane.uuid}));
     }
   }
 
-  // devices
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    foreach (const BI_StrokeText* text, footprint.getStrokeTexts()) {
-      // Do *not* mirror layer since it is independent of the device!
-      const GraphicsLayer* layer =
-          mBoard.getLayerStack().getLayer(*text->getText().getLayerName());
-      if ((!layer) || (!layer->isCopperLayer()) || (!layer->isEnabled())) {
-        continue;
+  // netlines
+  foreach (const auto& trace, mSnapshot->getTraces()) {
+    if (trace.width < mOptions.minCopperWidth) {
+      QString msg = tr("Min. copper width (%1) of trace: %2",
+                       "Placeholders are layer name + width")
+                        .arg(trace.layerNameTr, formatLength(*trace.width));
+      Path location = Path::obround(trace.startPos, trace.endPos, trace.width);
+      addMessage(BoardDesignRuleCheckMessage(msg, location, {trace.uuid}));
+    }
+  }
+
+  emit progressPercent(progressEnd);
+}
+
+void BoardDesignRuleCheck::checkDrills(int progressStart, int progressEnd) {
+  LIBREPCB_TRACE_SCOPE("drc", "BoardDesignRuleCheck::checkDrills");
+  Q_UNUSED(progressStart);
+  emit progressStatus(tr("Check drills..."));
+
+  typedef BoardDesignRuleCheckSnapshot::Drill Drill;
+  QString holeMsgTr =
+      tr("Min. hole diameter: %1", "Placeholder is drill diameter");
+
+  // Evaluate all drill rules in a single pass over the flat list of drills.
+  // The messages are collected per rule to keep them grouped and to apply
+  // the message limit per rule.
+  QList<BoardDesignRuleCheckMessage> restringMessages;
+  QList<BoardDesignRuleCheckMessage> pthDrillMessages;
+  QList<BoardDesignRuleCheckMessage> npthDrillMessages;
+  foreach (const Drill& drill, mSnapshot->getDrills()) {
+    Length restring = (*drill.size - *drill.diameter + 1) / 2;
+    switch (drill.type) {
+      case Drill::Type::Via: {
+        if (restring < *mOptions.minPthRestring) {
+          QString msg = tr("Min. via restring ('%1'): %2",
+                           "Placeholders are net name + restring width")
+                            .arg(drill.name, formatLength(restring));
+          PositiveLength diameter = PositiveLength(*drill.diameter) +
+                                    mOptions.minPthRestring +
+                                    mOptions.minPthRestring;
+          Path location = Path::circle(diameter).translated(drill.position);
+          restringMessages.append(
+              BoardDesignRuleCheckMessage(msg, location, {drill.uuid}));
+        }
+        if (drill.diameter < mOptions.minPthDrillDiameter) {
+          QString msg = tr("Min. via drill diameter ('%1'): %2",
+                           "Placeholders are net name + drill diameter")
+                            .arg(drill.name, formatLength(*drill.diameter));
+          Path location = Path::circle(PositiveLength(*drill.diameter))
+                              .translated(drill.position);
+          pthDrillMessages.append(
+              BoardDesignRuleCheckMessage(msg, location, {drill.uuid}));
+        }
+        break;
+      }
+      case Drill::Type::Pad: {
+        if (restring < *mOptions.minPthRestring) {
+          QString msg = tr("Min. pad restring ('%1'): %2",
+                           "Placeholders are pad name + restring width")
+                            .arg(drill.name, formatLength(restring));
+          PositiveLength diameter = PositiveLength(drill.diameter + 1) +
+                                    mOptions.minPthRestring +
+                                    mOptions.minPthRestring;
+          Path location = Path::circle(diameter).translated(drill.position);
+          restringMessages.append(
+              BoardDesignRuleCheckMessage(msg, location, {drill.uuid}));
+        }
+        if (drill.diameter < mOptions.minPthDrillDiameter) {
+          QString msg = tr("Min. pad drill diameter ('%1'): %2",
+                           "Placeholders are pad name + drill diameter")
+                            .arg(drill.name, formatLength(*drill.diameter));
+          PositiveLength diameter(qMax(*drill.diameter, Length(50000)));
+          Path location = Path::circle(diameter).translated(drill.position);
+          pthDrillMessages.append(
+              BoardDesignRuleCheckMessage(msg, location, {drill.uuid}));
+        }
+        break;
       }
-      if (text->getText().getStrokeWidth() < mOptions.minCopperWidth) {
-        QString msg = tr("Min. copper width (%1) of text: %2",
-                         "Placeholders are layer name + width")
-                          .arg(layer->getNameTr(),
-                               formatLength(*text->getText().getStrokeWidth()));
-        QVector<Path> locations;
-        foreach (Path path, text->getText().getPaths()) {
-          path.rotate(text->getText().getRotation());
-          if (text->getText().getMirrored()) path.mirror(Qt::Horizontal);
-          path.translate(text->getText().getPosition());
-          locations += path.toOutlineStrokes(PositiveLength(
-              qMax(*text->getText().getStrokeWidth(), Length(50000))));
+      case Drill::Type::Hole: {
+        if (drill.diameter < mOptions.minNpthDrillDiameter) {
+          QString msg      = holeMsgTr.arg(formatLength(*drill.diameter));
+          Path    location = Path::circle(PositiveLength(*drill.diameter))
+                              .translated(drill.position);
+          npthDrillMessages.append(
+              BoardDesignRuleCheckMessage(msg, location, {drill.uuid}));
         }
-        addMessage(BoardDesignRuleCheckMessage(msg, locations));
+        break;
+      }
+      default: {
+        qWarning() << "Unhandled switch-case in "
+                      "BoardDesignRuleCheck::checkDrills():"
+                   << static_cast<int>(drill.type);
+        break;
       }
     }
   }
 
-  // netlines
-  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
-    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
-      if ((!netline->getLayer().isCopperLayer()) ||
-          (!netline->getLayer().isEnabled())) {
-        continue;
-      }
-      if (netline->getWidth() < mOptions.minCopperWidth) {
-        QString msg = tr("Min. copper width (%1) of trace: %2",
-                         "Placeholders are layer name + width")
-                          .arg(netline->getLayer().getNameTr(),
-                               formatLength(*netline->getWidth()));
-        Path location = Path::obround(netline->getStartPoint().getPosition(),
-                                      netline->getEndPoint().getPosition(),
-                                      netline->getWidth());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
-      }
+  for (const auto* messages :
+       {&restringMessages, &pthDrillMessages, &npthDrillMessages}) {
+    resetMessageCounters();  // every rule has its own message limit
+    foreach (const BoardDesignRuleCheckMessage& msg, *messages) {
+      addMessage(msg);
     }
   }
 
   emit progressPercent(progressEnd);
 }
 
-void BoardDesignRuleCheck::checkMinimumPthRestring(int progressStart,
-                                                   int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum PTH restrings..."));
-
-  // vias
-  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
-    foreach (const BI_Via* via, netsegment->getVias()) {
-      Length restring = (*via->getSize() - *via->getDrillDiameter() + 1) / 2;
-      if (restring < *mOptions.minPthRestring) {
-        QString msg = tr("Min. via restring ('%1'): %2",
-                         "Placeholders are net name + restring width")
-                          .arg(*netsegment->getNetSignal().getName(),
-                               formatLength(restring));
-        PositiveLength diameter = via->getDrillDiameter() +
-                                  mOptions.minPthRestring +
-                                  mOptions.minPthRestring;
-        Path location = Path::circle(diameter).translated(via->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
-      }
+BoardDesignRuleCheck::CopperPaths BoardDesignRuleCheck::calcCopperPaths(
+    int layerIndex, int netIndex) const {
+  throwIfCanceled();  // can throw
+  const auto& layer  = mSnapshot->getCopperLayers()[layerIndex];
+  const auto& net    = mSnapshot->getNets()[netIndex];
+  const auto& copper = mSnapshot->getCopper(layerIndex, netIndex);
+
+  // reuse the paths of the previous run if nothing has changed
+  auto layerIt = mCachedPaths.constFind(layer.layer);
+  if (layerIt != mCachedPaths.constEnd()) {
+    auto netIt = layerIt->constFind(net.netsignal);
+    if ((netIt != layerIt->constEnd()) &&
+        (netIt->revisionStamp == copper.revisionStamp)) {
+      CopperPaths result = *netIt;
+      result.modified    = false;
+      return result;
     }
   }
+  if (!copper.hasPrimitives) {
+    throw LogicError(__FILE__, __LINE__);  // cache modified since snapshot?!
+  }
 
-  // pads
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-      if (pad->getLibPad().getBoardSide() !=
-          library::FootprintPad::BoardSide::THT) {
-        continue;  // skip SMT pads
-      }
-      PositiveLength size =
-          qMin(pad->getLibPad().getWidth(), pad->getLibPad().getHeight());
-      Length restring = (*size - *pad->getLibPad().getDrillDiameter() + 1) / 2;
-      if (restring < *mOptions.minPthRestring) {
-        QString msg = tr("Min. pad restring ('%1'): %2",
-                         "Placeholders are pad name + restring width")
-                          .arg(pad->getDisplayText().simplified(),
-                               formatLength(restring));
-        PositiveLength diameter =
-            PositiveLength(pad->getLibPad().getDrillDiameter() + 1) +
-            mOptions.minPthRestring + mOptions.minPthRestring;
-        Path location = Path::circle(diameter).translated(pad->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
-      }
+  // Note: Only the board's cache must be accessed, not the board itself!
+  CopperPaths result;
+  result.revisionStamp = copper.revisionStamp;
+  result.modified      = true;
+  if (!mCopperPathCache->tryGetPaths(layer.name, net.netsignal,
+                                     copper.revisionStamp, maxArcTolerance(),
+                                     result.paths)) {
+    foreach (const Path& path, copper.primitives) {
+      ClipperHelpers::unite(result.paths,
+                            ClipperHelpers::convert(path, maxArcTolerance()));
     }
+    mCopperPathCache->insertPaths(layer.name, net.netsignal,
+                                  copper.revisionStamp, maxArcTolerance(),
+                                  result.paths);
   }
-
-  emit progressPercent(progressEnd);
+  result.inflatedPaths = result.paths;
+  if (!result.inflatedPaths.empty()) {
+    ClipperHelpers::offset(
+        result.inflatedPaths,
+        (*mOptions.minCopperCopperClearance - *maxArcTolerance()) / 2,
+        maxArcTolerance());
+  }
+  result.inflatedBounds = ClipperHelpers::getBoundingRect(result.inflatedPaths);
+  return result;
 }
 
-void BoardDesignRuleCheck::checkMinimumPthDrillDiameter(int progressStart,
-                                                        int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum PTH drill diameters..."));
-
-  // vias
-  foreach (const BI_NetSegment* netsegment, mBoard.getNetSegments()) {
-    foreach (const BI_Via* via, netsegment->getVias()) {
-      if (via->getDrillDiameter() < mOptions.minPthDrillDiameter) {
-        QString msg = tr("Min. via drill diameter ('%1'): %2",
-                         "Placeholders are net name + drill diameter")
-                          .arg(*netsegment->getNetSignal().getName(),
-                               formatLength(*via->getDrillDiameter()));
-        Path location = Path::circle(via->getDrillDiameter())
-                            .translated(via->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+BoardDesignRuleCheck::NetSignalMessages
+    BoardDesignRuleCheck::checkCopperBoardClearancesOnLayer(
+        int layerIndex, const ClipperLib::Paths& restrictedArea,
+        bool restrictedAreaModified) const {
+  const auto&       layer = mSnapshot->getCopperLayers()[layerIndex];
+  const auto&       nets  = mSnapshot->getNets();
+  NetSignalMessages result;
+  for (int i = 0; i < nets.count(); ++i) {
+    throwIfCanceled();  // can throw
+    if (isMessageLimitReached()) {
+      break;
+    }
+    const CopperPaths& copper = getCopperPaths(layer.layer, nets[i].netsignal);
+    QList<BoardDesignRuleCheckMessage> messages;
+    if ((!restrictedAreaModified) && (!copper.modified)) {
+      // nothing has changed since the previous run
+      messages = mCachedBoardClearanceMessages.value(layer.layer)
+                     .value(nets[i].netsignal);
+    } else if (!copper.paths.empty()) {
+      std::unique_ptr<ClipperLib::PolyTree> intersections =
+          ClipperHelpers::intersect(restrictedArea, copper.paths);
+      for (const ClipperLib::Path& path :
+           ClipperHelpers::flattenTree(*intersections)) {
+        QString msg = tr("Clearance (%1): '%2' <-> Board Outline",
+                         "Placeholders are layer name + net name")
+                          .arg(layer.nameTr, nets[i].name);
+        Path location = ClipperHelpers::convert(path);
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
       }
     }
+    if (!messages.isEmpty()) {
+      countFoundMessages(messages.count());
+      result.append(qMakePair(nets[i].netsignal, messages));
+    }
+  }
+  return result;
+}
+
+BoardDesignRuleCheck::NetSignalPairMessages
+    BoardDesignRuleCheck::checkCopperCopperClearancesOnLayer(
+        int layerIndex) const {
+  const auto&           layer = mSnapshot->getCopperLayers()[layerIndex];
+  const auto&           nets  = mSnapshot->getNets();
+  NetSignalPairMessages result;
+
+  // get the inflated copper areas of all net signals
+  QVector<const CopperPaths*> copper(nets.count());
+  QVector<int>                indices;
+  for (int i = 0; i < nets.count(); ++i) {
+    copper[i] = &getCopperPaths(layer.layer, nets[i].netsignal);
+    if (!copper[i]->inflatedPaths.empty()) {
+      indices.append(i);
+    }
   }
 
-  // pads
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
-      if (pad->getLibPad().getBoardSide() !=
-          library::FootprintPad::BoardSide::THT) {
-        continue;  // skip SMT pads
+  // broadphase: sweep over the bounding rectangles sorted by their left
+  // edge to find the pairs of net signals which might overlap at all
+  std::sort(indices.begin(), indices.end(), [&copper](int a, int b) {
+    return copper[a]->inflatedBounds.left < copper[b]->inflatedBounds.left;
+  });
+  QVector<QPair<int, int>> candidates;
+  for (int i = 0; i < indices.count(); ++i) {
+    const ClipperLib::IntRect& rect1 = copper[indices[i]]->inflatedBounds;
+    for (int k = i + 1; k < indices.count(); ++k) {
+      const ClipperLib::IntRect& rect2 = copper[indices[k]]->inflatedBounds;
+      if (rect2.left > rect1.right) {
+        break;  // all remaining rectangles are located further right
       }
-      if (pad->getLibPad().getDrillDiameter() < *mOptions.minPthDrillDiameter) {
-        QString msg =
-            tr("Min. pad drill diameter ('%1'): %2",
-               "Placeholders are pad name + drill diameter")
-                .arg(pad->getDisplayText().simplified(),
-                     formatLength(*pad->getLibPad().getDrillDiameter()));
-        PositiveLength diameter(
-            qMax(*pad->getLibPad().getDrillDiameter(), Length(50000)));
-        Path location = Path::circle(diameter).translated(pad->getPosition());
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+      if (ClipperHelpers::intersects(rect1, rect2)) {
+        candidates.append(qMakePair(qMin(indices[i], indices[k]),
+                                    qMax(indices[i], indices[k])));
       }
     }
   }
+  // keep the order of messages independent from the sweep order
+  std::sort(candidates.begin(), candidates.end());
 
-  emit progressPercent(progressEnd);
+  // narrowphase: exact intersection of the candidate pairs
+  const QHash<NetSignalPair, QList<BoardDesignRuleCheckMessage>> cache =
+      mCachedCopperClearanceMessages.value(layer.layer);
+  for (int c = 0; c < candidates.count(); ++c) {
+    throwIfCanceled();  // can throw
+    if (isMessageLimitReached()) {
+      break;
+    }
+    int           i   = candidates[c].first;
+    int           k   = candidates[c].second;
+    NetSignalPair key = makeNetSignalPair(nets[i].netsignal, nets[k].netsignal);
+    QList<BoardDesignRuleCheckMessage> messages;
+    if ((!copper[i]->modified) && (!copper[k]->modified)) {
+      // nothing has changed since the previous run
+      messages = cache.value(key);
+    } else {
+      std::unique_ptr<ClipperLib::PolyTree> intersections =
+          ClipperHelpers::intersect(copper[i]->inflatedPaths,
+                                    copper[k]->inflatedPaths);
+      for (const ClipperLib::Path& path :
+           ClipperHelpers::flattenTree(*intersections)) {
+        QString msg = tr("Clearance (%1): '%2' <-> '%3'",
+                         "Placeholders are layer name + net names")
+                          .arg(layer.nameTr, nets[i].name, nets[k].name);
+        Path location = ClipperHelpers::convert(path);
+        messages.append(BoardDesignRuleCheckMessage(msg, location));
+      }
+    }
+    if (!messages.isEmpty()) {
+      countFoundMessages(messages.count());
+      result.append(qMakePair(key, messages));
+    }
+  }
+  return result;
 }
 
-void BoardDesignRuleCheck::checkMinimumNpthDrillDiameter(int progressStart,
-                                                         int progressEnd) {
-  Q_UNUSED(progressStart);
-  emit progressStatus(tr("Check minimum NPTH drill diameters..."));
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkMinimumCopperWidthOfNet(int layerIndex,
+                                                       int netIndex) const {
+  throwIfCanceled();  // can throw
+  const auto&        layer  = mSnapshot->getCopperLayers()[layerIndex];
+  const auto&        net    = mSnapshot->getNets()[netIndex];
+  const CopperPaths& copper = getCopperPaths(layer.layer, net.netsignal);
+  if (!copper.modified) {
+    // nothing has changed since the previous run
+    return mCachedCopperWidthMessages.value(layer.layer).value(net.netsignal);
+  }
 
-  QString msgTr = tr("Min. hole diameter: %1", "Placeholder is drill diameter");
+  // Erode and dilate the copper area (like BoardPlaneFragmentsBuilder does)
+  // to remove everything thinner than the minimum width. The area is dilated
+  // a bit more than eroded to not report the corners rounded by the erosion.
+  // The arc tolerance is subtracted to not report copper of exactly the
+  // minimum width.
+  QList<BoardDesignRuleCheckMessage> messages;
+  Length radius = (*mOptions.minCopperWidth - *maxArcTolerance()) / 2;
+  if (copper.paths.empty() || (radius <= 0) || isMessageLimitReached()) {
+    return messages;
+  }
+  ClipperLib::Paths remaining = copper.paths;
+  ClipperHelpers::offset(remaining, -radius, maxArcTolerance());
+  if (!remaining.empty()) {
+    ClipperHelpers::offset(remaining, radius + (radius / 2), maxArcTolerance());
+  }
 
-  // board holes
-  foreach (const BI_Hole* hole, mBoard.getHoles()) {
-    if (hole->getHole().getDiameter() < mOptions.minNpthDrillDiameter) {
-      QString msg = msgTr.arg(formatLength(*hole->getHole().getDiameter()));
-      Path    location = Path::circle(hole->getHole().getDiameter())
-                          .translated(hole->getPosition());
-      addMessage(BoardDesignRuleCheckMessage(msg, location));
+  // Too thin traces are already reported by their width attribute (see
+  // checkMinimumCopperWidth()), so exclude them to not report them twice.
+  foreach (const auto& trace, mSnapshot->getTraces()) {
+    if ((trace.layer == layer.layer) && (trace.netsignal == net.netsignal) &&
+        (trace.width < mOptions.minCopperWidth)) {
+      remaining.push_back(ClipperHelpers::convert(
+          Path::obround(trace.startPos, trace.endPos, trace.width),
+          maxArcTolerance()));
     }
   }
+  std::unique_ptr<ClipperLib::PolyTree> thinAreas =
+      ClipperHelpers::subtractToTree(copper.paths, remaining);
+  for (const ClipperLib::Path& path : ClipperHelpers::flattenTree(*thinAreas)) {
+    QString msg = tr("Min. copper width (%1) of polygon: '%2'",
+                     "Placeholders are layer name + net name")
+                      .arg(layer.nameTr, net.name);
+    Path location = ClipperHelpers::convert(path);
+    messages.append(BoardDesignRuleCheckMessage(msg, location));
+  }
+  countFoundMessages(messages.count());
+  return messages;
+}
 
-  // package holes
-  foreach (const BI_Device* device, mBoard.getDeviceInstances()) {
-    const BI_Footprint& footprint = device->getFootprint();
-    for (const Hole& hole : footprint.getLibFootprint().getHoles()) {
-      if (hole.getDiameter() < *mOptions.minNpthDrillDiameter) {
-        QString msg = msgTr.arg(formatLength(*hole.getDiameter()));
-        Path    location =
-            Path::circle(hole.getDiameter())
-                .translated(footprint.mapToScene(hole.getPosition()));
-        addMessage(BoardDesignRuleCheckMessage(msg, location));
+QList<BoardDesignRuleCheckMessage>
+    BoardDesignRuleCheck::checkCourtyardClearancesOnLayer(
+        int layerIndex, int& pairCount, int& testCount) const {
+  const auto& layer = mSnapshot->getCourtyardLayers()[layerIndex];
+  QList<BoardDesignRuleCheckMessage> messages;
+
+  // determine device courtyard areas and their bounding rectangles
+  QList<const BoardDesignRuleCheckSnapshot::Courtyard*> devices;
+  QVector<ClipperLib::Paths>                            courtyards;
+  QVector<ClipperLib::IntRect>                          bounds;
+  foreach (const auto& courtyard, layer.courtyards) {
+    // The united and offset area of a footprint is shared between all devices
+    // (of all boards) using it, only their placement is applied here.
+    ClipperLib::Paths paths = ClipperAreaCache::instance().get(
+        courtyard.paths, mOptions.courtyardOffset, maxArcTolerance(),
+        courtyard.transform);  // can throw
+    if (!paths.empty()) {
+      devices.append(&courtyard);
+      courtyards.append(paths);
+      bounds.append(ClipperHelpers::getBoundingRect(paths));
+    }
+  }
+
+  // broadphase: sweep over the bounding rectangles sorted by their left
+  // edge to find the pairs of courtyards which might overlap at all
+  QVector<int> indices(devices.count());
+  std::iota(indices.begin(), indices.end(), 0);
+  std::sort(indices.begin(), indices.end(), [&bounds](int a, int b) {
+    return bounds[a].left < bounds[b].left;
+  });
+  QVector<QPair<int, int>> candidates;
+  for (int i = 0; i < indices.count(); ++i) {
+    const ClipperLib::IntRect& rect1 = bounds[indices[i]];
+    for (int k = i + 1; k < indices.count(); ++k) {
+      const ClipperLib::IntRect& rect2 = bounds[indices[k]];
+      if (rect2.left > rect1.right) {
+        break;  // all remaining rectangles are located further right
+      }
+      if (ClipperHelpers::intersects(rect1, rect2)) {
+        candidates.append(qMakePair(qMin(indices[i], indices[k]),
+                                    qMax(indices[i], indices[k])));
       }
     }
   }
+  // keep the order of messages independent from the sweep order
+  std::sort(candidates.begin(), candidates.end());
+  pairCount = (devices.count() * (devices.count() - 1)) / 2;
+  testCount = candidates.count();
 
-  emit progressPercent(progressEnd);
+  // narrowphase: exact intersection of the candidate pairs
+  foreach (const auto& candidate, candidates) {
+    throwIfCanceled();  // can throw
+    if (isMessageLimitReached()) {
+      break;
+    }
+    const auto* dev1 = devices[candidate.first];
+    const auto* dev2 = devices[candidate.second];
+    std::unique_ptr<ClipperLib::PolyTree> intersections =
+        ClipperHelpers::intersect(courtyards[candidate.first],
+                                  courtyards[candidate.second]);
+    for (const ClipperLib::Path& path :
+         ClipperHelpers::flattenTree(*intersections)) {
+      QString msg = tr("Clearance (%1): '%2' <-> '%3'",
+                       "Placeholders are layer name + component names")
+                        .arg(layer.nameTr, dev1->componentName,
+                             dev2->componentName);
+      Path location = ClipperHelpers::convert(path);
+      messages.append(BoardDesignRuleCheckMessage(msg, location,
+                                                  {dev1->uuid, dev2->uuid}));
+      countFoundMessages(1);
+    }
+  }
+  return messages;
 }
 
-const ClipperLib::Paths& BoardDesignRuleCheck::getCopperPaths(
-    const GraphicsLayer* layer, const NetSignal* netsignal) {
-  if (!mCachedPaths[layer].contains(netsignal)) {
-    BoardClipperPathGenerator gen(mBoard, maxArcTolerance());
-    gen.addCopper(layer->getName(), netsignal);
-    mCachedPaths[layer][netsignal] = gen.getPaths();
+const BoardDesignRuleCheck::CopperPaths& BoardDesignRuleCheck::getCopperPaths(
+    const GraphicsLayer* layer, const NetSignal* netsignal) const {
+  // Note: This method is called from worker threads, so the cache must not be
+  // modified here. It is populated in advance by prepareCopperPaths().
+  auto layerIt = mCachedPaths.constFind(layer);
+  if (layerIt != mCachedPaths.constEnd()) {
+    auto netIt = layerIt->constFind(netsignal);
+    if (netIt != layerIt->constEnd()) {
+      return *netIt;
+    }
   }
-  return mCachedPaths[layer][netsignal];
+  throw LogicError(__FILE__, __LINE__);
 }
 
-ClipperLib::Paths BoardDesignRuleCheck::getDeviceCourtyardPaths(
-    const BI_Device& device, const GraphicsLayer* layer) {
-  ClipperLib::Paths paths;
-  for (const Polygon& polygon : device.getLibFootprint().getPolygons()) {
-    QString polygonLayer = *polygon.getLayerName();
-    if (device.getIsMirrored()) {
-      polygonLayer = GraphicsLayer::getMirroredLayerName(polygonLayer);
-    }
-    if (polygonLayer != layer->getName()) {
-      continue;
-    }
-    Path path = polygon.getPath();
-    path.rotate(device.getRotation());
-    if (device.getIsMirrored()) path.mirror(Qt::Horizontal);
-    path.translate(device.getPosition());
-    ClipperHelpers::unite(paths,
-                          ClipperHelpers::convert(path, maxArcTolerance()));
-  }
-  for (const Circle& circle : device.getLibFootprint().getCircles()) {
-    QString circleLayer = *circle.getLayerName();
-    if (device.getIsMirrored()) {
-      circleLayer = GraphicsLayer::getMirroredLayerName(circleLayer);
+BoardDesignRuleCheck::NetSignalPair BoardDesignRuleCheck::makeNetSignalPair(
+    const NetSignal* a, const NetSignal* b) noexcept {
+  // normalize the order to get the same key independent of the order of the
+  // net signals in the circuit
+  if (std::less<const NetSignal*>()(a, b)) {
+    return qMakePair(a, b);
+  } else {
+    return qMakePair(b, a);
+  }
+}
+
+uint BoardDesignRuleCheck::calcFingerprint(
+    const ClipperLib::Paths& paths) noexcept {
+  uint fingerprint = 0;
+  for (const ClipperLib::Path& path : paths) {
+    for (const ClipperLib::IntPoint& p : path) {
+      fingerprint = qHash(qMakePair(p.X, p.Y), fingerprint);
     }
-    if (circleLayer != layer->getName()) {
-      continue;
+    fingerprint = qHash(path.size(), fingerprint);
+  }
+  return fingerprint;
+}
+
+void BoardDesignRuleCheck::addMessagesOfJobs(
+    const QList<QFuture<QList<BoardDesignRuleCheckMessage>>>& jobs,
+    int progressStart, int progressEnd) {
+  qreal progressSpan = progressEnd - progressStart;
+  waitForAllJobs(jobs, [this, progressStart, progressSpan](qreal done) {
+    emit progressPercent(progressStart + static_cast<int>(progressSpan * done));
+  });
+
+  // Add the messages in the order of the jobs (not in the order in which they
+  // have finished) to get deterministic results.
+  foreach (const auto& job, jobs) {
+    foreach (const BoardDesignRuleCheckMessage& msg, job.result()) {
+      addMessage(msg);
     }
-    Point absolutePos = circle.getCenter();
-    absolutePos.rotate(device.getRotation());
-    if (device.getIsMirrored()) absolutePos.mirror(Qt::Horizontal);
-    absolutePos += device.getPosition();
-    ClipperHelpers::unite(
-        paths, ClipperHelpers::convert(Path::circle(circle.getDiameter()),
-                                       maxArcTolerance()));
   }
-  return paths;
+  emit progressPercent(progressEnd);
 }
 
 void BoardDesignRuleCheck::addMessage(
     const BoardDesignRuleCheckMessage& msg) noexcept {
+  int limit = mOptions.maxMessagesPerCheck;
+  if ((limit > 0) && (mStageAddedMessages >= limit)) {
+    if (mStageAddedMessages == limit) {
+      emit progressStatus(tr("Message limit reached, skipping remaining "
+                             "violations of this check."));
+      ++mStageAddedMessages;  // emit the status only once per check
+    }
+    mMessageLimitReached = true;
+    return;
+  }
   mMessages.append(msg);
+  ++mStageAddedMessages;
   emit progressMessage(msg.getMessage());
 }
 
+void BoardDesignRuleCheck::resetMessageCounters() noexcept {
+  mStageFoundMessages.store(0);
+  mStageAddedMessages = 0;
+}
+
+void BoardDesignRuleCheck::throwIfCanceled() const {
+  if (mCancelRequested.load()) {
+    throw UserCanceled(__FILE__, __LINE__);
+  }
+}
+
+bool BoardDesignRuleCheck::isMessageLimitReached() const noexcept {
+  // Note: This method is called from worker threads too!
+  int limit = mOptions.maxMessagesPerCheck;
+  return (limit > 0) && ((mStageFoundMessages.load() >= limit) ||
+                         (mStageAddedMessages >= limit));
+}
+
+void BoardDesignRuleCheck::countFoundMessages(int count) const noexcept {
+  // Note: This method is called from worker threads!
+  mStageFoundMessages.fetchAndAddRelaxed(count);
+}
+
 QString BoardDesignRuleCheck::formatLength(const Length& length) const
     noexcept {
   return Toolbox::floatToString(length.toMm(), 6, QLocale()) % "mm";
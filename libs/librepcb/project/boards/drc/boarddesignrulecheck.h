@@ -29,17 +29,22 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
 
 class GraphicsLayer;
+class SExpression;
 
 namespace project {
 
 class Board;
-class BI_Device;
+class BoardCopperPathCache;
+class BoardOutlineAreaCache;
+class BoardDesignRuleCheckSnapshot;
 class NetSignal;
 
 /*******************************************************************************
@@ -49,6 +54,28 @@ class NetSignal;
 /**
  * @brief The BoardDesignRuleCheck class checks a ::librepcb::project::Board for
  *        design rule violations
+ *
+ * The board is only accessed at the beginning of a run, to rebuild the planes
+ * and to take a ::librepcb::project::BoardDesignRuleCheckSnapshot of it. All
+ * checks are then performed on the snapshot, so they can run in a worker
+ * thread (see #start()) while the board is still being modified. The
+ * expensive checks are split into independent jobs (e.g. one per layer)
+ * which are executed in the global thread pool. The jobs return their
+ * messages, which are then merged in a deterministic order (independent of
+ * the order in which the jobs finished).
+ *
+ * The object can be kept alive and #execute() can be called again after the
+ * board was modified. Then the clearance messages of all layer/net signal
+ * combinations whose copper objects did not change since the last run
+ * (detected by their revision stamp) are reused instead of being calculated
+ * again. The copper areas themselves are taken from the board's
+ * ::librepcb::project::BoardCopperPathCache, so they are even shared between
+ * different DRC objects. The same applies to the board area (see
+ * ::librepcb::project::BoardOutlineAreaCache).
+ *
+ * A running check can be aborted with #cancel(), and the number of messages
+ * per check can be limited with
+ * ::librepcb::project::BoardDesignRuleCheck::Options::maxMessagesPerCheck.
  */
 class BoardDesignRuleCheck final : public QObject {
   Q_OBJECT
@@ -63,6 +90,8 @@ public:
     UnsignedLength minNpthDrillDiameter;
     UnsignedLength minPthDrillDiameter;
     Length         courtyardOffset;
+    int            maxMessagesPerCheck;  ///< Stop a check after this count of
+                                         ///< messages (0 = unlimited)
 
     Options()
       : minCopperWidth(200000),            // 200um
@@ -72,8 +101,37 @@ public:
         minPthRestring(150000),            // 150um
         minNpthDrillDiameter(250000),      // 250um
         minPthDrillDiameter(250000),       // 250um
-        courtyardOffset(0)                 // 0um
+        courtyardOffset(0),                // 0um
+        maxMessagesPerCheck(0)             // unlimited
     {}
+
+    /**
+     * @brief Load options from an S-Expression node
+     *
+     * All options not contained in the node are set to their default values.
+     *
+     * @param node    The node to load the options from (children with the
+     *                lowercase and underscore separated option names, e.g.
+     *                `(min_copper_width 0.2)`).
+     *
+     * @throw Exception   If the node contains invalid values.
+     */
+    explicit Options(const SExpression& node);
+
+    bool operator==(const Options& rhs) const noexcept {
+      return (minCopperWidth == rhs.minCopperWidth) &&
+             (minCopperCopperClearance == rhs.minCopperCopperClearance) &&
+             (minCopperBoardClearance == rhs.minCopperBoardClearance) &&
+             (minCopperNpthClearance == rhs.minCopperNpthClearance) &&
+             (minPthRestring == rhs.minPthRestring) &&
+             (minNpthDrillDiameter == rhs.minNpthDrillDiameter) &&
+             (minPthDrillDiameter == rhs.minPthDrillDiameter) &&
+             (courtyardOffset == rhs.courtyardOffset) &&
+             (maxMessagesPerCheck == rhs.maxMessagesPerCheck);
+    }
+    bool operator!=(const Options& rhs) const noexcept {
+      return !(*this == rhs);
+    }
   };
 
   // Constructors / Destructor
@@ -82,13 +140,78 @@ public:
   ~BoardDesignRuleCheck() noexcept;
 
   // Getters
+  Board&         getBoard() const noexcept { return mBoard; }
+  const Options& getOptions() const noexcept { return mOptions; }
   const QList<BoardDesignRuleCheckMessage>& getMessages() const noexcept {
     return mMessages;
   }
 
+  /**
+   * @brief Get the durations of all check stages of the last run
+   *
+   * @return Stage identifiers (e.g. "copper_clearances") and their durations
+   *         in milliseconds, in the order of execution
+   */
+  const QList<QPair<QString, qint64>>& getStageDurations() const noexcept {
+    return mStageDurations;
+  }
+
+  // Setters
+  void setOptions(const Options& options) noexcept;
+
   // General Methods
+
+  /**
+   * @brief Run the design rule check (blocking)
+   *
+   * @throw UserCanceled  If the check was aborted with #cancel().
+   * @throw Exception     On other errors.
+   */
   void execute();
 
+  /**
+   * @brief Start the design rule check in a worker thread
+   *
+   * Rebuilding the planes and taking the snapshot of the board is done
+   * synchronously (this is fast), the checks are then performed in the
+   * background. The signals are emitted from the worker thread, and
+   * #finished() is emitted at the end of every run (also if it failed).
+   *
+   * @attention Until the run is finished, only #isRunning(),
+   *            #waitForFinished() and #cancel() must be called!
+   *
+   * @throw Exception   If preparing the run failed (the worker thread is not
+   *                    started then).
+   */
+  void start();
+
+  /**
+   * @brief Check whether a run started with #start() is not finished yet
+   *
+   * @return True if the worker thread is still running
+   */
+  bool isRunning() const noexcept { return mFuture.isRunning(); }
+
+  /**
+   * @brief Wait until the run started with #start() is finished
+   *
+   * @throw UserCanceled  If the check was aborted with #cancel().
+   * @throw Exception     If the check failed.
+   */
+  void waitForFinished();
+
+  /**
+   * @brief Abort the currently running check
+   *
+   * This method is thread-safe, i.e. it may be called from any thread while
+   * the check is running. The check then stops as soon as possible and
+   * #execute() respectively #waitForFinished() throws
+   * ::librepcb::UserCanceled.
+   */
+  void cancel() noexcept { mCancelRequested.store(1); }
+
+  void clearCache() noexcept;
+
 signals:
   void started();
   void progressPercent(int percent);
@@ -96,21 +219,56 @@ signals:
   void progressMessage(const QString& msg);
   void finished();
 
+private:  // Types
+  struct CopperPaths {
+    uint                revisionStamp;   ///< Revision of copper objects
+    bool                modified;        ///< Changed since the previous run?
+    ClipperLib::Paths   paths;           ///< The copper area
+    ClipperLib::Paths   inflatedPaths;   ///< Area inflated by half clearance
+    ClipperLib::IntRect inflatedBounds;  ///< Bounding rect of #inflatedPaths
+  };
+  typedef QPair<const NetSignal*, const NetSignal*> NetSignalPair;
+  typedef QList<QPair<const NetSignal*, QList<BoardDesignRuleCheckMessage>>>
+      NetSignalMessages;
+  typedef QList<QPair<NetSignalPair, QList<BoardDesignRuleCheckMessage>>>
+      NetSignalPairMessages;
+
 private:  // Methods
+  void prepare();
+  void run();
+  void finishStage(const char* stage);
   void rebuildPlanes(int progressStart, int progressEnd);
+  void takeSnapshot(int progressStart, int progressEnd);
+  void prepareCopperPaths(int progressStart, int progressEnd);
   void checkForMissingConnections(int progressStart, int progressEnd);
   void checkCopperBoardClearances(int progressStart, int progressEnd);
   void checkCopperCopperClearances(int progressStart, int progressEnd);
   void checkCourtyardClearances(int progressStart, int progressEnd);
   void checkMinimumCopperWidth(int progressStart, int progressEnd);
-  void checkMinimumPthRestring(int progressStart, int progressEnd);
-  void checkMinimumPthDrillDiameter(int progressStart, int progressEnd);
-  void checkMinimumNpthDrillDiameter(int progressStart, int progressEnd);
-  const ClipperLib::Paths& getCopperPaths(const GraphicsLayer* layer,
-                                          const NetSignal*     netsignal);
-  ClipperLib::Paths        getDeviceCourtyardPaths(const BI_Device&     device,
-                                                   const GraphicsLayer* layer);
+  void checkDrills(int progressStart, int progressEnd);
+  CopperPaths       calcCopperPaths(int layerIndex, int netIndex) const;
+  NetSignalMessages checkCopperBoardClearancesOnLayer(
+      int layerIndex, const ClipperLib::Paths& restrictedArea,
+      bool restrictedAreaModified) const;
+  NetSignalPairMessages checkCopperCopperClearancesOnLayer(
+      int layerIndex) const;
+  QList<BoardDesignRuleCheckMessage> checkMinimumCopperWidthOfNet(
+      int layerIndex, int netIndex) const;
+  QList<BoardDesignRuleCheckMessage> checkCourtyardClearancesOnLayer(
+      int layerIndex, int& pairCount, int& testCount) const;
+  const CopperPaths& getCopperPaths(const GraphicsLayer* layer,
+                                    const NetSignal*     netsignal) const;
+  static NetSignalPair makeNetSignalPair(const NetSignal* a,
+                                         const NetSignal* b) noexcept;
+  static uint calcFingerprint(const ClipperLib::Paths& paths) noexcept;
+  void addMessagesOfJobs(
+      const QList<QFuture<QList<BoardDesignRuleCheckMessage>>>& jobs,
+      int progressStart, int progressEnd);
   void    addMessage(const BoardDesignRuleCheckMessage& msg) noexcept;
+  void    resetMessageCounters() noexcept;
+  void    throwIfCanceled() const;
+  bool    isMessageLimitReached() const noexcept;
+  void    countFoundMessages(int count) const noexcept;
   QString formatLength(const Length& length) const noexcept;
 
   /**
@@ -121,11 +279,54 @@ private:  // Methods
   }
 
 private:  // Data
-  Board&                             mBoard;
-  Options                            mOptions;
-  QList<BoardDesignRuleCheckMessage> mMessages;
-  QHash<const GraphicsLayer*, QHash<const NetSignal*, ClipperLib::Paths>>
+  Board&                                 mBoard;
+  std::shared_ptr<BoardCopperPathCache>  mCopperPathCache;
+  std::shared_ptr<BoardOutlineAreaCache> mOutlineAreaCache;
+  Options                                mOptions;
+  QList<BoardDesignRuleCheckMessage>     mMessages;
+  QList<QPair<QString, qint64>>          mStageDurations;
+  QElapsedTimer                          mStageTimer;
+
+  /// The snapshot checked by the current run (`nullptr` if not running)
+  std::shared_ptr<const BoardDesignRuleCheckSnapshot> mSnapshot;
+
+  /// The worker thread started by #start()
+  QFuture<void> mFuture;
+
+  // Abort conditions (the atomic members are accessed by jobs)
+  QAtomicInt         mCancelRequested;
+  mutable QAtomicInt mStageFoundMessages;  ///< Found by jobs in current stage
+  int                mStageAddedMessages;  ///< Added in current stage
+  bool               mMessageLimitReached;  ///< In any stage of the last run
+
+  // Caches
+  //
+  // Attention: These caches are only modified by the thread running the
+  // check between the check stages, i.e. while no jobs are running. The
+  // (concurrently running) jobs only read from them!
+
+  /// Copper paths of all enabled copper layers and net signals
+  QHash<const GraphicsLayer*, QHash<const NetSignal*, CopperPaths>>
       mCachedPaths;
+
+  /// Fingerprint of the area restricted by board outline and holes
+  uint mCachedRestrictedAreaFingerprint;
+
+  /// Copper-board clearance messages of the previous run
+  QHash<const GraphicsLayer*,
+        QHash<const NetSignal*, QList<BoardDesignRuleCheckMessage>>>
+      mCachedBoardClearanceMessages;
+
+  /// Copper-copper clearance messages of the previous run
+  QHash<const GraphicsLayer*,
+        QHash<NetSignalPair, QList<BoardDesignRuleCheckMessage>>>
+      mCachedCopperClearanceMessages;
+
+  /// Minimum copper width messages (of polygons and circles) of the previous
+  /// run
+  QHash<const GraphicsLayer*,
+        QHash<const NetSignal*, QList<BoardDesignRuleCheckMessage>>>
+      mCachedCopperWidthMessages;
 };
 
 /*******************************************************************************
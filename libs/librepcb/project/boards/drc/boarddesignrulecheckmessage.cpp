@@ -35,13 +35,15 @@ namespace project {
  ******************************************************************************/
 
 BoardDesignRuleCheckMessage::BoardDesignRuleCheckMessage(
-    const QString& message, const Path& location) noexcept
-  : BoardDesignRuleCheckMessage(message, QVector<Path>{location}) {
+    const QString& message, const Path& location,
+    const QList<Uuid>& items) noexcept
+  : BoardDesignRuleCheckMessage(message, QVector<Path>{location}, items) {
 }
 
 BoardDesignRuleCheckMessage::BoardDesignRuleCheckMessage(
-    const QString& message, const QVector<Path>& locations) noexcept
-  : mMessage(message), mLocations(locations) {
+    const QString& message, const QVector<Path>& locations,
+    const QList<Uuid>& items) noexcept
+  : mMessage(message), mLocations(locations), mItems(items) {
 }
 
 BoardDesignRuleCheckMessage::~BoardDesignRuleCheckMessage() noexcept {
@@ -24,6 +24,7 @@
  *  Includes
  ******************************************************************************/
 #include <librepcb/common/geometry/path.h>
+#include <librepcb/common/uuid.h>
 
 #include <QtCore>
 
@@ -44,19 +45,31 @@ namespace project {
 class BoardDesignRuleCheckMessage final {
 public:
   // Constructors / Destructor
-  BoardDesignRuleCheckMessage(const QString& message,
-                              const Path&    location) noexcept;
+  BoardDesignRuleCheckMessage(const QString&     message,
+                              const Path&        location,
+                              const QList<Uuid>& items = {}) noexcept;
   BoardDesignRuleCheckMessage(const QString&       message,
-                              const QVector<Path>& locations) noexcept;
+                              const QVector<Path>& locations,
+                              const QList<Uuid>&   items = {}) noexcept;
   ~BoardDesignRuleCheckMessage() noexcept;
 
   // Getters
   const QString&       getMessage() const noexcept { return mMessage; }
   const QVector<Path>& getLocations() const noexcept { return mLocations; }
 
+  /**
+   * @brief Get the UUIDs of the board items causing this message
+   *
+   * @return UUIDs of traces, vias, planes, stroke texts, holes or devices
+   *         (for objects of footprints). Might be empty if the message is not
+   *         related to particular items (e.g. copper clearances).
+   */
+  const QList<Uuid>& getItems() const noexcept { return mItems; }
+
 private:  // Data
   QString       mMessage;
   QVector<Path> mLocations;
+  QList<Uuid>   mItems;
 };
 
 /*******************************************************************************
@@ -0,0 +1,312 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boarddesignrulechecksnapshot.h"
+
+#include "../../circuit/circuit.h"
+#include "../../circuit/componentinstance.h"
+#include "../../circuit/netsignal.h"
+#include "../../project.h"
+#include "../board.h"
+#include "../boardlayerstack.h"
+#include "../boardoutlineareacache.h"
+#include "../items/bi_airwire.h"
+#include "../items/bi_device.h"
+#include "../items/bi_footprint.h"
+#include "../items/bi_footprintpad.h"
+#include "../items/bi_hole.h"
+#include "../items/bi_netline.h"
+#include "../items/bi_netsegment.h"
+#include "../items/bi_plane.h"
+#include "../items/bi_polygon.h"
+#include "../items/bi_stroketext.h"
+#include "../items/bi_via.h"
+#include "boardclipperpathgenerator.h"
+
+#include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/geometry/stroketext.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/library/pkg/footprint.h>
+#include <librepcb/library/pkg/footprintpad.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardDesignRuleCheckSnapshot::BoardDesignRuleCheckSnapshot(
+    Board& board, const CopperFilter& copperFilter) {
+  addCopper(board, copperFilter);
+  addCourtyards(board);
+  addItems(board);
+}
+
+BoardDesignRuleCheckSnapshot::~BoardDesignRuleCheckSnapshot() noexcept {
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardDesignRuleCheckSnapshot::addCopper(Board&              board,
+                                             const CopperFilter& copperFilter) {
+  // enabled copper layers
+  QStringList layerNames;
+  foreach (const GraphicsLayer* layer, board.getLayerStack().getAllLayers()) {
+    if (layer->isCopperLayer() && layer->isEnabled()) {
+      mCopperLayers.append(
+          CopperLayer{layer, layer->getName(), layer->getNameTr()});
+      layerNames.append(layer->getName());
+    }
+  }
+
+  // net signals (including unconnected copper objects)
+  QHash<const NetSignal*, int> netIndices;
+  foreach (const NetSignal* netsignal,
+           board.getProject().getCircuit().getNetSignals()) {
+    netIndices.insert(netsignal, mNets.count());
+    mNets.append(Net{netsignal, *netsignal->getName()});
+  }
+  netIndices.insert(nullptr, mNets.count());
+  mNets.append(Net{nullptr, QString()});
+
+  // First pass: calculate the revision stamps of all layers and net signals
+  // at once (calculated the same way as
+  // BoardClipperPathGenerator::calcCopperRevisionStamp()).
+  mCopper.resize(mCopperLayers.count() * mNets.count());
+  for (int i = 0; i < mCopper.count(); ++i) {
+    mCopper[i].revisionStamp = qHash(layerNames.at(i / mNets.count()));
+    mCopper[i].hasShapes     = false;
+    mCopper[i].hasPrimitives = false;
+  }
+  auto index = [this, &netIndices](int layer, const NetSignal* netsignal) {
+    return (layer * mNets.count()) + netIndices.value(netsignal);
+  };
+  BoardClipperPathGenerator gen(board, PositiveLength(1));  // tolerance unused
+  gen.visitCopper(layerNames,
+                  [this, &index](int layer, const NetSignal* netsignal,
+                                 const BI_Base& item) {
+                    Copper& copper = mCopper[index(layer, netsignal)];
+                    copper.revisionStamp =
+                        qHash(item.getRevision(), copper.revisionStamp);
+                    // Note: Footprints are visited for their polygons and
+                    // circles only.
+                    if ((item.getType() == BI_Base::Type_t::Polygon) ||
+                        (item.getType() == BI_Base::Type_t::Footprint)) {
+                      copper.hasShapes = true;
+                    }
+                    return false;  // no need to generate any paths
+                  },
+                  [](int, const NetSignal*, const Path&) {});
+
+  // Second pass: collect the primitives of the requested groups only
+  bool collect = false;
+  for (int i = 0; i < mCopper.count(); ++i) {
+    int l                    = i / mNets.count();
+    int n                    = i % mNets.count();
+    mCopper[i].hasPrimitives = (!copperFilter) ||
+        copperFilter(mCopperLayers[l].layer, mNets[n].netsignal,
+                     mCopper[i].revisionStamp);
+    collect = collect || mCopper[i].hasPrimitives;
+  }
+  if (collect) {
+    gen.visitCopper(layerNames,
+                    [this, &index](int layer, const NetSignal* netsignal,
+                                   const BI_Base&) {
+                      return mCopper[index(layer, netsignal)].hasPrimitives;
+                    },
+                    [this, &index](int layer, const NetSignal* netsignal,
+                                   const Path& path) {
+                      mCopper[index(layer, netsignal)].primitives.append(path);
+                    });
+  }
+}
+
+void BoardDesignRuleCheckSnapshot::addCourtyards(const Board& board) {
+  foreach (const GraphicsLayer* layer,
+           board.getLayerStack().getLayers(
+               {GraphicsLayer::sTopCourtyard, GraphicsLayer::sBotCourtyard})) {
+    CourtyardLayer courtyardLayer{layer->getNameTr(), {}};
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+      // Keep the paths in footprint coordinates, so the derived areas can be
+      // shared between all devices using the same footprint (see
+      // ClipperAreaCache). For mirrored devices, the courtyard of the
+      // opposite footprint layer ends up on this layer.
+      QString footprintLayer = layer->getName();
+      if (device->getIsMirrored()) {
+        footprintLayer = GraphicsLayer::getMirroredLayerName(footprintLayer);
+      }
+      QVector<Path> paths;
+      for (const Polygon& polygon : device->getLibFootprint().getPolygons()) {
+        if (*polygon.getLayerName() == footprintLayer) {
+          paths.append(polygon.getPath());
+        }
+      }
+      for (const Circle& circle : device->getLibFootprint().getCircles()) {
+        if (*circle.getLayerName() == footprintLayer) {
+          paths.append(Path::circle(circle.getDiameter())
+                           .translated(circle.getCenter()));
+        }
+      }
+      if (!paths.isEmpty()) {
+        courtyardLayer.courtyards.append(
+            Courtyard{device->getComponentInstanceUuid(),
+                      *device->getComponentInstance().getName(), paths,
+                      Transform(device->getPosition(), device->getRotation(),
+                                device->getIsMirrored())});
+      }
+    }
+    mCourtyardLayers.append(courtyardLayer);
+  }
+}
+
+void BoardDesignRuleCheckSnapshot::addItems(const Board& board) {
+  auto copperLayer = [&board](const QString& name) -> const GraphicsLayer* {
+    const GraphicsLayer* layer = board.getLayerStack().getLayer(name);
+    if (layer && layer->isCopperLayer() && layer->isEnabled()) {
+      return layer;
+    } else {
+      return nullptr;
+    }
+  };
+  auto textPaths = [](const StrokeText& text) {
+    QVector<Path> paths;
+    foreach (Path path, text.getPaths()) {
+      path.rotate(text.getRotation());
+      if (text.getMirrored()) path.mirror(Qt::Horizontal);
+      path.translate(text.getPosition());
+      paths.append(path);
+    }
+    return paths;
+  };
+
+  // board outlines (of the board and all footprints, calculated the same way
+  // as the board area cache does to allow sharing its areas)
+  mBoardOutlines               = board.getOutlineAreaCache().getOutlines();
+  mBoardOutlinesRevisionStamp = board.getOutlineAreaCache().getRevisionStamp();
+
+  // board holes
+  foreach (const BI_Hole* hole, board.getHoles()) {
+    mDrills.append(Drill{Drill::Type::Hole, hole->getPosition(),
+                         positiveToUnsigned(hole->getHole().getDiameter()),
+                         UnsignedLength(0), hole->getUuid(), QString()});
+  }
+
+  // board stroke texts
+  foreach (const BI_StrokeText* text, board.getStrokeTexts()) {
+    if (const GraphicsLayer* layer =
+            copperLayer(*text->getText().getLayerName())) {
+      mTexts.append(Text{text->getUuid(), layer->getNameTr(),
+                         text->getText().getStrokeWidth(),
+                         textPaths(text->getText())});
+    }
+  }
+
+  // planes
+  foreach (const BI_Plane* plane, board.getPlanes()) {
+    if (const GraphicsLayer* layer = copperLayer(*plane->getLayerName())) {
+      mPlanes.append(Plane{plane->getUuid(), layer->getNameTr(),
+                           plane->getMinWidth(), plane->getOutline()});
+    }
+  }
+
+  // devices
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    const BI_Footprint& footprint = device->getFootprint();
+    const Uuid&         uuid      = device->getComponentInstanceUuid();
+
+    // holes
+    for (const librepcb::Hole& hole : device->getLibFootprint().getHoles()) {
+      mDrills.append(Drill{Drill::Type::Hole,
+                           footprint.mapToScene(hole.getPosition()),
+                           positiveToUnsigned(hole.getDiameter()),
+                           UnsignedLength(0), uuid, QString()});
+    }
+
+    // stroke texts
+    foreach (const BI_StrokeText* text, footprint.getStrokeTexts()) {
+      // Do *not* mirror layer since it is independent of the device!
+      if (const GraphicsLayer* layer =
+              copperLayer(*text->getText().getLayerName())) {
+        mTexts.append(Text{uuid, layer->getNameTr(),
+                           text->getText().getStrokeWidth(),
+                           textPaths(text->getText())});
+      }
+    }
+
+    // THT pads
+    foreach (const BI_FootprintPad* pad, footprint.getPads()) {
+      if (pad->getLibPad().getBoardSide() ==
+          library::FootprintPad::BoardSide::THT) {
+        PositiveLength size =
+            qMin(pad->getLibPad().getWidth(), pad->getLibPad().getHeight());
+        mDrills.append(Drill{Drill::Type::Pad, pad->getPosition(),
+                             pad->getLibPad().getDrillDiameter(),
+                             positiveToUnsigned(size), uuid,
+                             pad->getDisplayText().simplified()});
+      }
+    }
+  }
+
+  // net segment items
+  foreach (const BI_NetSegment* netsegment, board.getNetSegments()) {
+    QString netName = *netsegment->getNetSignal().getName();
+    foreach (const BI_Via* via, netsegment->getVias()) {
+      mDrills.append(Drill{Drill::Type::Via, via->getPosition(),
+                           positiveToUnsigned(via->getDrillDiameter()),
+                           positiveToUnsigned(via->getSize()), via->getUuid(),
+                           netName});
+    }
+    foreach (const BI_NetLine* netline, netsegment->getNetLines()) {
+      if (netline->getLayer().isCopperLayer() &&
+          netline->getLayer().isEnabled()) {
+        mTraces.append(Trace{netline->getUuid(), &netline->getLayer(),
+                             &netsegment->getNetSignal(),
+                             netline->getLayer().getNameTr(),
+                             netline->getWidth(),
+                             netline->getStartPoint().getPosition(),
+                             netline->getEndPoint().getPosition()});
+      }
+    }
+  }
+
+  // air wires
+  foreach (const BI_AirWire* airwire, board.getAirWires()) {
+    mAirWires.append(AirWire{*airwire->getNetSignal().getName(),
+                             airwire->getP1(), airwire->getP2()});
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
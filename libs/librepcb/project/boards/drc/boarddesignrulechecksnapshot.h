@@ -0,0 +1,221 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_BOARDDESIGNRULECHECKSNAPSHOT_H
+#define LIBREPCB_PROJECT_BOARDDESIGNRULECHECKSNAPSHOT_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/all_length_units.h>
+#include <librepcb/common/utils/transform.h>
+#include <librepcb/common/uuid.h>
+
+#include <QtCore>
+
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class GraphicsLayer;
+
+namespace project {
+
+class Board;
+class NetSignal;
+
+/*******************************************************************************
+ *  Class BoardDesignRuleCheckSnapshot
+ ******************************************************************************/
+
+/**
+ * @brief The BoardDesignRuleCheckSnapshot class is an immutable copy of all
+ *        the data of a ::librepcb::project::Board needed by the design rule
+ *        check
+ *
+ * The snapshot must be taken in the thread the board lives in, but
+ * afterwards it is completely independent of the board. So it can be
+ * checked in a worker thread while the board is being modified.
+ *
+ * Taking a snapshot is cheap since it contains only plain geometry, without
+ * any (expensive) polygon operations. The copper objects are grouped by
+ * layer and net signal, and each group is tagged with its revision stamp
+ * (see
+ * ::librepcb::project::BoardClipperPathGenerator::calcCopperRevisionStamp()).
+ * The geometry of unmodified groups can even be omitted if the consumer
+ * still has the results of a previous snapshot.
+ *
+ * All objects carry the UUID of the board item they belong to (for objects
+ * of footprints, the UUID of the device), to allow mapping results back to
+ * the board.
+ *
+ * @attention The layer and net signal pointers are only used as keys to
+ *            identify them. They must not be dereferenced since the objects
+ *            may already be deleted!
+ */
+class BoardDesignRuleCheckSnapshot final {
+public:
+  // Types
+  struct CopperLayer {
+    const GraphicsLayer* layer;   ///< Key only, do not dereference!
+    QString              name;    ///< Name of the layer
+    QString              nameTr;  ///< Translated name of the layer
+  };
+  struct Net {
+    const NetSignal* netsignal;  ///< Key only (`nullptr` for unconnected)
+    QString          name;       ///< Empty for unconnected copper
+  };
+  struct Copper {
+    uint revisionStamp;  ///< Revision of the copper objects
+    bool hasShapes;  ///< Contains polygons or circles, i.e. objects whose
+                     ///< copper width is not defined by any attribute
+    bool          hasPrimitives;  ///< Whether #primitives were collected
+    QVector<Path> primitives;     ///< Not yet united copper paths
+  };
+  struct Drill {
+    enum class Type {
+      Via,  ///< Plated via hole
+      Pad,  ///< Plated THT pad hole
+      Hole  ///< Non-plated board or footprint hole
+    };
+    Type           type;
+    Point          position;
+    UnsignedLength diameter;
+    UnsignedLength size;  ///< Smallest copper diameter (0 for holes)
+    Uuid           uuid;  ///< Via, board hole or device
+    QString        name;  ///< Net name of vias, name of pads
+  };
+  struct Courtyard {
+    Uuid          uuid;  ///< Device
+    QString       componentName;
+    QVector<Path> paths;      ///< In footprint coordinates
+    Transform     transform;  ///< Footprint placement
+  };
+  struct CourtyardLayer {
+    QString          nameTr;
+    QList<Courtyard> courtyards;
+  };
+  struct Text {
+    Uuid           uuid;  ///< Board stroke text or device
+    QString        layerNameTr;
+    UnsignedLength strokeWidth;
+    QVector<Path>  paths;  ///< Transformed to scene coordinates
+  };
+  struct Plane {
+    Uuid           uuid;
+    QString        layerNameTr;
+    UnsignedLength minWidth;
+    Path           outline;
+  };
+  struct Trace {
+    Uuid                 uuid;
+    const GraphicsLayer* layer;      ///< Key only, do not dereference!
+    const NetSignal*     netsignal;  ///< Key only, do not dereference!
+    QString              layerNameTr;
+    PositiveLength       width;
+    Point                startPos;
+    Point                endPos;
+  };
+  struct AirWire {
+    QString netName;
+    Point   p1;
+    Point   p2;
+  };
+
+  /**
+   * Decides whether the primitives of a copper group need to be collected
+   * (parameters: layer, net signal, revision stamp).
+   */
+  typedef std::function<bool(const GraphicsLayer*, const NetSignal*, uint)>
+      CopperFilter;
+
+  // Constructors / Destructor
+  BoardDesignRuleCheckSnapshot() = delete;
+  BoardDesignRuleCheckSnapshot(const BoardDesignRuleCheckSnapshot& other) =
+      delete;
+
+  /**
+   * @brief Take a snapshot of a board
+   *
+   * @param board           The board (planes and air wires should be up to
+   *                        date).
+   * @param copperFilter    Returns whether the primitives of a copper group
+   *                        are needed. If `nullptr`, all are collected.
+   */
+  BoardDesignRuleCheckSnapshot(Board& board, const CopperFilter& copperFilter);
+  ~BoardDesignRuleCheckSnapshot() noexcept;
+
+  // Getters
+  const QList<CopperLayer>& getCopperLayers() const noexcept {
+    return mCopperLayers;
+  }
+  const QList<Net>& getNets() const noexcept { return mNets; }
+  const Copper&     getCopper(int layerIndex, int netIndex) const noexcept {
+    return mCopper[(layerIndex * mNets.count()) + netIndex];
+  }
+  const QVector<Path>& getBoardOutlines() const noexcept {
+    return mBoardOutlines;
+  }
+  uint getBoardOutlinesRevisionStamp() const noexcept {
+    return mBoardOutlinesRevisionStamp;
+  }
+  const QVector<Drill>&        getDrills() const noexcept { return mDrills; }
+  const QList<CourtyardLayer>& getCourtyardLayers() const noexcept {
+    return mCourtyardLayers;
+  }
+  const QList<Text>&    getTexts() const noexcept { return mTexts; }
+  const QList<Plane>&   getPlanes() const noexcept { return mPlanes; }
+  const QList<Trace>&   getTraces() const noexcept { return mTraces; }
+  const QList<AirWire>& getAirWires() const noexcept { return mAirWires; }
+
+  // Operator Overloadings
+  BoardDesignRuleCheckSnapshot& operator=(
+      const BoardDesignRuleCheckSnapshot& rhs) = delete;
+
+private:  // Methods
+  void addCopper(Board& board, const CopperFilter& copperFilter);
+  void addCourtyards(const Board& board);
+  void addItems(const Board& board);
+
+private:  // Data
+  QList<CopperLayer>    mCopperLayers;
+  QList<Net>            mNets;
+  QVector<Copper>       mCopper;  ///< Indexed by layer and net
+  QVector<Path>         mBoardOutlines;
+  uint                  mBoardOutlinesRevisionStamp;
+  QVector<Drill>        mDrills;  ///< All vias, THT pads and holes
+  QList<CourtyardLayer> mCourtyardLayers;
+  QList<Text>           mTexts;   ///< Stroke texts on copper layers
+  QList<Plane>          mPlanes;  ///< Planes on copper layers
+  QList<Trace>          mTraces;  ///< Traces on copper layers
+  QList<AirWire>        mAirWires;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BOARDDESIGNRULECHECKSNAPSHOT_H
@@ -20,7 +20,7 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
-#include "bgi_airwire.h"
+#include "bgi_airwires.h"
 
 #include "../../circuit/netsignal.h"
 #include "../board.h"
@@ -41,47 +41,38 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BGI_AirWire::BGI_AirWire(BI_AirWire& airwire) noexcept
-  : BGI_Base(), mAirWire(airwire), mLayer(nullptr) {
+BGI_AirWires::BGI_AirWires(Board& board, const NetSignal& netsignal) noexcept
+  : BGI_Base(), mBoard(board), mNetSignal(netsignal), mLayer(nullptr) {
   mLayer = getLayer(GraphicsLayer::sBoardAirWires);
+  setVisibilityLayers({mLayer});
   setZValue(Board::ZValue_AirWires);
-  updateCacheAndRepaint();
+  mHighlightChangedConnection =
+      QObject::connect(&mNetSignal, &NetSignal::highlightedChanged,
+                       [this]() { update(); });
 }
 
-BGI_AirWire::~BGI_AirWire() noexcept {
+BGI_AirWires::~BGI_AirWires() noexcept {
+  QObject::disconnect(mHighlightChangedConnection);
 }
 
 /*******************************************************************************
- *  Getters
+ *  Setters
  ******************************************************************************/
 
-bool BGI_AirWire::isSelectable() const noexcept {
-  return mLayer && mLayer->isVisible();
-}
-
-/*******************************************************************************
- *  General Methods
- ******************************************************************************/
-
-void BGI_AirWire::updateCacheAndRepaint() noexcept {
+void BGI_AirWires::setAirWires(const QList<BI_AirWire*>& airWires) noexcept {
   prepareGeometryChange();
 
+  mAirWires = airWires;
   mLines.clear();
-  if (mAirWire.isVertical()) {
-    Length size(200000);
-    Point  p1 = mAirWire.getP1() + Point(size, size);
-    Point  p2 = mAirWire.getP1() - Point(size, size);
-    Point  p3 = mAirWire.getP1() + Point(size, -size);
-    Point  p4 = mAirWire.getP1() - Point(size, -size);
-    mLines.append(QLineF(p1.toPxQPointF(), p2.toPxQPointF()));
-    mLines.append(QLineF(p3.toPxQPointF(), p4.toPxQPointF()));
-    mBoundingRect = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
-  } else {
-    mLines.append(
-        QLineF(mAirWire.getP1().toPxQPointF(), mAirWire.getP2().toPxQPointF()));
-    mBoundingRect =
-        QRectF(mAirWire.getP1().toPxQPointF(), mAirWire.getP2().toPxQPointF())
-            .normalized();
+  mCircles.clear();
+  mBoundingRect = QRectF();
+  foreach (const BI_AirWire* airWire, mAirWires) {
+    const QRectF rect = airWire->getBoundingRectPx();
+    mLines += airWire->getLinesPx();
+    if (airWire->isVertical()) {
+      mCircles.append(rect);
+    }
+    mBoundingRect = mBoundingRect.united(rect);
   }
 
   update();
@@ -91,25 +82,36 @@ void BGI_AirWire::updateCacheAndRepaint() noexcept {
  *  Inherited from QGraphicsItem
  ******************************************************************************/
 
-void BGI_AirWire::paint(QPainter*                       painter,
-                        const QStyleOptionGraphicsItem* option,
-                        QWidget*                        widget) {
+void BGI_AirWires::paint(QPainter*                       painter,
+                         const QStyleOptionGraphicsItem* option,
+                         QWidget*                        widget) {
   Q_UNUSED(widget);
 
-  bool highlight =
-      mAirWire.isSelected() || mAirWire.getNetSignal().isHighlighted();
+  const bool  highlight = mNetSignal.isHighlighted();
   const qreal lod =
       option->levelOfDetailFromTransform(painter->worldTransform());
 
-  // draw line
+  // draw lines
   if (mLayer && mLayer->isVisible()) {
     qreal width = highlight ? 3 / lod : 0;  // highlighted airwires are thicker
     QPen  pen(mLayer->getColor(highlight), width, Qt::SolidLine, Qt::RoundCap);
     painter->setPen(pen);
+    painter->setBrush(Qt::NoBrush);
     painter->drawLines(mLines);
-    if (mLines.count() > 1) {
-      painter->setBrush(Qt::NoBrush);
-      painter->drawEllipse(mBoundingRect);
+    foreach (const QRectF& rect, mCircles) { painter->drawEllipse(rect); }
+
+    // selected airwires are drawn highlighted on top of the others
+    if (!highlight) {
+      painter->setPen(
+          QPen(mLayer->getColor(true), 3 / lod, Qt::SolidLine, Qt::RoundCap));
+      foreach (const BI_AirWire* airWire, mAirWires) {
+        if (airWire->isSelected()) {
+          painter->drawLines(airWire->getLinesPx());
+          if (airWire->isVertical()) {
+            painter->drawEllipse(airWire->getBoundingRectPx());
+          }
+        }
+      }
     }
   }
 
@@ -130,8 +132,8 @@ void BGI_AirWire::paint(QPainter*                       painter,
  *  Private Methods
  ******************************************************************************/
 
-GraphicsLayer* BGI_AirWire::getLayer(const QString& name) const noexcept {
-  return mAirWire.getBoard().getLayerStack().getLayer(name);
+GraphicsLayer* BGI_AirWires::getLayer(const QString& name) const noexcept {
+  return mBoard.getLayerStack().getLayer(name);
 }
 
 /*******************************************************************************
@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef LIBREPCB_PROJECT_BGI_AIRWIRES_H
+#define LIBREPCB_PROJECT_BGI_AIRWIRES_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "bgi_base.h"
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class GraphicsLayer;
+
+namespace project {
+
+class Board;
+class BI_AirWire;
+class NetSignal;
+
+/*******************************************************************************
+ *  Class BGI_AirWires
+ ******************************************************************************/
+
+/**
+ * @brief The BGI_AirWires class draws all air wires of a net signal
+ *
+ * Boards often have thousands of air wires (e.g. right after adding all
+ * devices), so instead of adding one graphics item per air wire to the scene,
+ * the board adds one item per net signal which draws the lines of all its
+ * air wires at once. Hit-testing of single air wires is done with their
+ * geometry (see librepcb::project::BI_AirWire::getGrabAreaScenePx()).
+ */
+class BGI_AirWires final : public BGI_Base {
+public:
+  // Constructors / Destructor
+  BGI_AirWires()                          = delete;
+  BGI_AirWires(const BGI_AirWires& other) = delete;
+  BGI_AirWires(Board& board, const NetSignal& netsignal) noexcept;
+  ~BGI_AirWires() noexcept;
+
+  // Setters
+
+  /**
+   * @brief Set the air wires to draw
+   *
+   * @param airWires  All air wires of the net signal. Must be updated each
+   *                  time air wires are added or removed since they are not
+   *                  owned by this item.
+   */
+  void setAirWires(const QList<BI_AirWire*>& airWires) noexcept;
+
+  // Inherited from QGraphicsItem
+  QRectF       boundingRect() const { return mBoundingRect; }
+  QPainterPath shape() const { return QPainterPath(); }
+  void         paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
+                     QWidget* widget);
+
+  // Operator Overloadings
+  BGI_AirWires& operator=(const BGI_AirWires& rhs) = delete;
+
+private:  // Methods
+  GraphicsLayer* getLayer(const QString& name) const noexcept;
+
+private:  // Data
+  Board&                  mBoard;
+  const NetSignal&        mNetSignal;
+  GraphicsLayer*          mLayer;
+  QMetaObject::Connection mHighlightChangedConnection;
+
+  // Cached Attributes
+  QList<BI_AirWire*> mAirWires;
+  QVector<QLineF>    mLines;    ///< Lines of all air wires
+  QVector<QRectF>    mCircles;  ///< Circles of vertical air wires
+  QRectF             mBoundingRect;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_BGI_AIRWIRES_H
@@ -26,8 +26,11 @@
 
 #include <librepcb/common/graphics/graphicslayer.h>
 
+#include <QPrinter>
 #include <QtCore>
 
+#include <limits>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -38,7 +41,9 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BGI_Base::BGI_Base() noexcept {
+BGI_Base::BGI_Base() noexcept
+  : QGraphicsItem(),
+    mOnVisibilityLayerEditedSlot(*this, &BGI_Base::visibilityLayerEdited) {
 }
 
 BGI_Base::~BGI_Base() noexcept {
@@ -63,6 +68,71 @@ qreal BGI_Base::getZValueOfCopperLayer(const QString& name) noexcept {
   }
 }
 
+qreal BGI_Base::getLevelOfDetail(
+    const QPainter& painter, const QStyleOptionGraphicsItem& option) noexcept {
+  if (dynamic_cast<QPrinter*>(painter.device())) {
+    return std::numeric_limits<qreal>::infinity();
+  } else {
+    return option.levelOfDetailFromTransform(painter.worldTransform());
+  }
+}
+
+bool BGI_Base::isTextVisible(qreal lod, qreal heightPx) noexcept {
+  // texts smaller than this (in device pixels) are not readable anyway
+  return (heightPx * lod) >= 4;
+}
+
+bool BGI_Base::areDetailsVisible(qreal lod, const QRectF& rectPx) noexcept {
+  // below this size (in device pixels), details are not distinguishable
+  return (qMax(rectPx.width(), rectPx.height()) * lod) >= 6;
+}
+
+void BGI_Base::setVisibilityLayers(
+    const QVector<const GraphicsLayer*>& layers) noexcept {
+  foreach (const GraphicsLayer* layer, mVisibilityLayers) {
+    layer->onEdited.detach(mOnVisibilityLayerEditedSlot);
+  }
+  mVisibilityLayers.clear();
+  foreach (const GraphicsLayer* layer, layers) {
+    if (layer && (!mVisibilityLayers.contains(layer))) {
+      layer->onEdited.attach(mOnVisibilityLayerEditedSlot);
+      mVisibilityLayers.append(layer);
+    }
+  }
+  updateVisibility();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BGI_Base::visibilityLayerEdited(const GraphicsLayer& layer,
+                                     GraphicsLayer::Event event) noexcept {
+  switch (event) {
+    case GraphicsLayer::Event::VisibleChanged:
+    case GraphicsLayer::Event::EnabledChanged:
+      updateVisibility();
+      break;
+    case GraphicsLayer::Event::Destroyed:
+      mVisibilityLayers.removeAll(&layer);
+      updateVisibility();
+      break;
+    default:
+      break;
+  }
+}
+
+void BGI_Base::updateVisibility() noexcept {
+  bool visible = false;
+  foreach (const GraphicsLayer* layer, mVisibilityLayers) {
+    if (layer->isVisible()) {
+      visible = true;
+      break;
+    }
+  }
+  setVisible(visible);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "../board.h"
 
+#include <librepcb/common/graphics/graphicslayer.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -50,11 +52,71 @@ public:
 protected:
   static qreal getZValueOfCopperLayer(const QString& name) noexcept;
 
+  /**
+   * @brief Get the level of detail to paint an item with
+   *
+   * @param painter   The painter passed to QGraphicsItem::paint().
+   * @param option    The style option passed to QGraphicsItem::paint().
+   *
+   * @return The scale factor between scene and device pixels (see
+   *         QStyleOptionGraphicsItem::levelOfDetailFromTransform()). For
+   *         printers (e.g. PDF export), infinity is returned since they must
+   *         always get all details, independent of the zoom level.
+   */
+  static qreal getLevelOfDetail(
+      const QPainter& painter, const QStyleOptionGraphicsItem& option) noexcept;
+
+  /**
+   * @brief Check whether a text is large enough on screen to be painted
+   *
+   * @param lod       Level of detail (see #getLevelOfDetail()).
+   * @param heightPx  Height of the text in scene pixels.
+   *
+   * @return True if the text would be readable, false if it would only be a
+   *         few (expensive to render) pixels.
+   */
+  static bool isTextVisible(qreal lod, qreal heightPx) noexcept;
+
+  /**
+   * @brief Check whether an item is large enough on screen to paint details
+   *
+   * Items which are only a few pixels large on screen can be approximated by
+   * their most important shape (e.g. a filled rect) without visible
+   * difference, which significantly speeds up painting zoomed-out boards.
+   *
+   * @param lod     Level of detail (see #getLevelOfDetail()).
+   * @param rectPx  Bounding rect of the item in scene pixels.
+   *
+   * @return True if the item should be painted with all details.
+   */
+  static bool areDetailsVisible(qreal lod, const QRectF& rectPx) noexcept;
+
+  /**
+   * @brief Set the layers which determine the visibility of this item
+   *
+   * The item is hidden as long as none of the passed layers is visible.
+   * Hidden items are skipped by the graphics scene when painting and when
+   * looking up items at a position, so hiding layers (e.g. inner copper
+   * layers) really makes rendering and hit-testing cheaper.
+   *
+   * @param layers  The layers the item is drawn on (nullptr entries are
+   *                ignored).
+   */
+  void setVisibilityLayers(
+      const QVector<const GraphicsLayer*>& layers) noexcept;
+
 private:
+  void visibilityLayerEdited(const GraphicsLayer& layer,
+                             GraphicsLayer::Event event) noexcept;
+  void updateVisibility() noexcept;
+
   // make some methods inaccessible...
   // BGI_Base() = delete;
   BGI_Base(const BGI_Base& other) = delete;
   BGI_Base& operator=(const BGI_Base& rhs) = delete;
+
+  QVector<const GraphicsLayer*> mVisibilityLayers;
+  GraphicsLayer::OnEditedSlot   mOnVisibilityLayerEditedSlot;
 };
 
 /*******************************************************************************
@@ -123,13 +123,13 @@ void BGI_Footprint::updateCacheAndRepaint() noexcept {
 void BGI_Footprint::paint(QPainter*                       painter,
                           const QStyleOptionGraphicsItem* option,
                           QWidget*                        widget) {
-  Q_UNUSED(option);
   Q_UNUSED(widget);
 
   const GraphicsLayer* layer    = 0;
   const bool           selected = mFootprint.isSelected();
   const bool           deviceIsPrinter =
       (dynamic_cast<QPrinter*>(painter->device()) != 0);
+  const qreal          lod = getLevelOfDetail(*painter, *option);
 
   // draw all polygons
   for (const Polygon& polygon : mLibFootprint.getPolygons()) {
@@ -217,7 +217,8 @@ void BGI_Footprint::paint(QPainter*                       painter,
   // draw origin cross
   layer = getLayer(GraphicsLayer::sTopReferences);
   if (layer) {
-    if ((!deviceIsPrinter) && layer->isVisible()) {
+    if ((!deviceIsPrinter) && areDetailsVisible(lod, mBoundingRect) &&
+        layer->isVisible()) {
       qreal width = Length(700000).toPx();
       painter->setPen(QPen(layer->getColor(selected), 0));
       painter->drawLine(-width, 0, width, 0);
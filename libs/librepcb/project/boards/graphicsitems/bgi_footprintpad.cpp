@@ -113,6 +113,10 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept {
     mBottomCreamMaskLayer = nullptr;
   }
 
+  // hide the pad if none of its layers is visible
+  setVisibilityLayers({mPadLayer, mTopStopMaskLayer, mBottomStopMaskLayer,
+                       mTopCreamMaskLayer, mBottomCreamMaskLayer});
+
   // determine stop/cream mask clearance
   PositiveLength size = qMin(mLibPad.getWidth(), mLibPad.getHeight());
   Length         stopMaskClearance =
@@ -121,10 +125,12 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept {
       -mPad.getBoard().getDesignRules().calcCreamMaskClearance(*size);
 
   // set shapes and bounding rect
-  mShape        = mLibPad.getOutline().toQPainterPathPx();
-  mCopper       = mLibPad.toQPainterPathPx();
-  mStopMask     = mLibPad.getOutline(stopMaskClearance).toQPainterPathPx();
-  mCreamMask    = mLibPad.getOutline(creamMaskClearance).toQPainterPathPx();
+  Geometry geometry =
+      getGeometry(mLibPad, stopMaskClearance, creamMaskClearance);
+  mShape        = geometry.shape;
+  mCopper       = geometry.copper;
+  mStopMask     = geometry.stopMask;
+  mCreamMask    = geometry.creamMask;
   mBoundingRect = mStopMask.boundingRect();
 
   update();
@@ -137,24 +143,22 @@ void BGI_FootprintPad::updateCacheAndRepaint() noexcept {
 void BGI_FootprintPad::paint(QPainter*                       painter,
                              const QStyleOptionGraphicsItem* option,
                              QWidget*                        widget) {
-  Q_UNUSED(option);
   Q_UNUSED(widget);
-  // const bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) !=
-  // 0); const qreal lod =
-  // option->levelOfDetailFromTransform(painter->worldTransform());
+  const qreal lod     = getLevelOfDetail(*painter, *option);
+  const bool  details = areDetailsVisible(lod, mBoundingRect);
 
   const NetSignal* netsignal = mPad.getCompSigInstNetSignal();
   bool             highlight =
       mPad.isSelected() || (netsignal && netsignal->isHighlighted());
 
-  if (mBottomCreamMaskLayer && mBottomCreamMaskLayer->isVisible()) {
+  if (details && mBottomCreamMaskLayer && mBottomCreamMaskLayer->isVisible()) {
     // draw bottom cream mask
     painter->setPen(Qt::NoPen);
     painter->setBrush(mBottomCreamMaskLayer->getColor(highlight));
     painter->drawPath(mCreamMask);
   }
 
-  if (mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible()) {
+  if (details && mBottomStopMaskLayer && mBottomStopMaskLayer->isVisible()) {
     // draw bottom stop mask
     painter->setPen(Qt::NoPen);
     painter->setBrush(mBottomStopMaskLayer->getColor(highlight));
@@ -162,25 +166,32 @@ void BGI_FootprintPad::paint(QPainter*                       painter,
   }
 
   if (mPadLayer && mPadLayer->isVisible()) {
-    // draw pad
+    // draw pad (only a few pixels large pads are drawn as rect, which is much
+    // faster than drawing the path)
     painter->setPen(Qt::NoPen);
     painter->setBrush(mPadLayer->getColor(highlight));
-    painter->drawPath(mCopper);
+    if (details) {
+      painter->drawPath(mCopper);
+    } else {
+      painter->drawRect(mShape.boundingRect());
+    }
     // draw pad text
-    painter->setFont(mFont);
-    painter->setPen(mPadLayer->getColor(highlight).lighter(150));
-    painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
-                      mPad.getDisplayText());
+    if (isTextVisible(lod, mFont.pixelSize())) {
+      painter->setFont(mFont);
+      painter->setPen(mPadLayer->getColor(highlight).lighter(150));
+      painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
+                        mPad.getDisplayText());
+    }
   }
 
-  if (mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
+  if (details && mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
     // draw top stop mask
     painter->setPen(Qt::NoPen);
     painter->setBrush(mTopStopMaskLayer->getColor(highlight));
     painter->drawPath(mStopMask);
   }
 
-  if (mTopCreamMaskLayer && mTopCreamMaskLayer->isVisible()) {
+  if (details && mTopCreamMaskLayer && mTopCreamMaskLayer->isVisible()) {
     // draw top cream mask
     painter->setPen(Qt::NoPen);
     painter->setBrush(mTopCreamMaskLayer->getColor(highlight));
@@ -214,6 +225,34 @@ GraphicsLayer* BGI_FootprintPad::getLayer(QString name) const noexcept {
       .getLayer(name);
 }
 
+BGI_FootprintPad::Geometry BGI_FootprintPad::getGeometry(
+    const library::FootprintPad& pad, const Length& stopMaskClearance,
+    const Length& creamMaskClearance) noexcept {
+  // Note: Graphics items are only accessed from the main thread, thus no
+  // locking is required.
+  static QCache<QString, Geometry> cache(1000);  // max. count of geometries
+  const bool isTht =
+      (pad.getBoardSide() == library::FootprintPad::BoardSide::THT);
+  const QString key = QString("%1|%2|%3|%4|%5|%6")
+                          .arg(static_cast<int>(pad.getShape()))
+                          .arg(pad.getWidth()->toNm())
+                          .arg(pad.getHeight()->toNm())
+                          .arg(isTht ? pad.getDrillDiameter()->toNm() : -1)
+                          .arg(stopMaskClearance.toNm())
+                          .arg(creamMaskClearance.toNm());
+  if (const Geometry* cached = cache.object(key)) {
+    return *cached;
+  }
+  Geometry* geometry  = new Geometry();
+  geometry->shape     = pad.getOutline().toQPainterPathPx();
+  geometry->copper    = pad.toQPainterPathPx();
+  geometry->stopMask  = pad.getOutline(stopMaskClearance).toQPainterPathPx();
+  geometry->creamMask = pad.getOutline(creamMaskClearance).toQPainterPathPx();
+  Geometry result     = *geometry;
+  cache.insert(key, geometry);  // takes ownership
+  return result;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -75,9 +75,39 @@ private:
   BGI_FootprintPad(const BGI_FootprintPad& other) = delete;
   BGI_FootprintPad& operator=(const BGI_FootprintPad& rhs) = delete;
 
+  // Types
+
+  /// Painter paths of a pad, in the pad's local coordinate system
+  struct Geometry {
+    QPainterPath shape;
+    QPainterPath copper;
+    QPainterPath stopMask;
+    QPainterPath creamMask;
+  };
+
   // Private Methods
   GraphicsLayer* getLayer(QString name) const noexcept;
 
+  /**
+   * @brief Get the (shared) painter paths for a specific pad geometry
+   *
+   * Boards often contain hundreds of identical pads (e.g. of the same
+   * resistor footprint). Since the paths are in local coordinates (the
+   * position and rotation are applied by the item's transform), they are
+   * calculated only once and then shared between all identical pads.
+   * QPainterPath is implicitly shared, so copies don't occupy extra memory.
+   *
+   * @param pad                 The library pad.
+   * @param stopMaskClearance   Stop mask clearance of the pad.
+   * @param creamMaskClearance  Cream mask clearance of the pad (negative
+   *                            values shrink the cream mask).
+   *
+   * @return The painter paths of the pad.
+   */
+  static Geometry getGeometry(const library::FootprintPad& pad,
+                              const Length&                stopMaskClearance,
+                              const Length& creamMaskClearance) noexcept;
+
   // General Attributes
   BI_FootprintPad&             mPad;
   const library::FootprintPad& mLibPad;
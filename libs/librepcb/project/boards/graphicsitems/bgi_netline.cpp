@@ -73,6 +73,7 @@ void BGI_NetLine::updateCacheAndRepaint() noexcept {
 
   mLayer = &mNetLine.getLayer();
   Q_ASSERT(mLayer);
+  setVisibilityLayers({mLayer});
 
   mLineF.setP1(mNetLine.getStartPoint().getPosition().toPxQPointF());
   mLineF.setP2(mNetLine.getEndPoint().getPosition().toPxQPointF());
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "bgi_base.h"
 
+#include <librepcb/common/utils/memorypool.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -46,7 +48,7 @@ class BI_NetLine;
 /**
  * @brief The BGI_NetLine class
  */
-class BGI_NetLine final : public BGI_Base {
+class BGI_NetLine final : public BGI_Base, public PoolAllocated<BGI_NetLine> {
 public:
   // Constructors / Destructor
   explicit BGI_NetLine(BI_NetLine& netline) noexcept;
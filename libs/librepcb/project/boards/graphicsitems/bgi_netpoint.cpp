@@ -71,6 +71,7 @@ void BGI_NetPoint::updateCacheAndRepaint() noexcept {
   // set Z value
   GraphicsLayer* layer = mNetPoint.getLayerOfLines();
   setZValue(layer ? getZValueOfCopperLayer(layer->getName()) : 0);
+  setVisibilityLayers({layer});
 
   qreal radius  = mNetPoint.getMaxLineWidth()->toPx() / 2;
   mBoundingRect = QRectF(-radius, -radius, 2 * radius, 2 * radius);
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "bgi_base.h"
 
+#include <librepcb/common/utils/memorypool.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -46,7 +48,7 @@ class BI_NetPoint;
 /**
  * @brief The BGI_NetPoint class
  */
-class BGI_NetPoint final : public BGI_Base {
+class BGI_NetPoint final : public BGI_Base, public PoolAllocated<BGI_NetPoint> {
 public:
   // Constructors / Destructor
   explicit BGI_NetPoint(BI_NetPoint& netpoint) noexcept;
@@ -46,6 +46,7 @@ namespace project {
 
 BGI_Plane::BGI_Plane(BI_Plane& plane) noexcept
   : BGI_Base(), mPlane(plane), mLayer(nullptr) {
+  setFlag(QGraphicsItem::ItemUsesExtendedStyleOption, true);  // exposedRect
   updateCacheAndRepaint();
 }
 
@@ -70,6 +71,7 @@ void BGI_Plane::updateCacheAndRepaint() noexcept {
   setZValue(getZValueOfCopperLayer(*mPlane.getLayerName()));
 
   mLayer = getLayer(*mPlane.getLayerName());
+  setVisibilityLayers({mLayer});
 
   // set shape and bounding rect
   mOutline = mPlane.getOutline().toClosedPath().toQPainterPathPx();
@@ -77,11 +79,14 @@ void BGI_Plane::updateCacheAndRepaint() noexcept {
       mOutline, QPen(Length::fromMm(0.3).toPx()), QBrush());
   mBoundingRect = mShape.boundingRect();
 
-  // get areas
-  mAreas.clear();
-  for (const Path& r : mPlane.getFragments()) {
-    mAreas.append(r.toQPainterPathPx());
-    mBoundingRect = mBoundingRect.united(mAreas.last().boundingRect());
+  // The fragments are not converted to painter paths here since they can be
+  // huge. Only their bounding rects are cached, the painter paths are built
+  // in paint() for the fragments which are actually exposed.
+  mFragmentBoundingRects.clear();
+  mFragmentBoundingRects.reserve(mPlane.getFragments().count());
+  for (const Path& fragment : mPlane.getFragments()) {
+    mFragmentBoundingRects.append(getBoundingRectPx(fragment));
+    mBoundingRect = mBoundingRect.united(mFragmentBoundingRects.last());
   }
 
   update();
@@ -114,7 +119,13 @@ void BGI_Plane::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
     if (mPlane.isVisible()) {
       painter->setPen(Qt::NoPen);
       painter->setBrush(mLayer->getColor(selected));
-      foreach (const QPainterPath& area, mAreas) { painter->drawPath(area); }
+      const QVector<Path>& fragments = mPlane.getFragments();
+      Q_ASSERT(fragments.count() == mFragmentBoundingRects.count());
+      for (int i = 0; i < fragments.count(); ++i) {
+        if (mFragmentBoundingRects.at(i).intersects(option->exposedRect)) {
+          painter->drawPath(fragments.at(i).toQPainterPathPx());
+        }
+      }
     }
   }
 
@@ -141,6 +152,29 @@ GraphicsLayer* BGI_Plane::getLayer(QString name) const noexcept {
   return mPlane.getBoard().getLayerStack().getLayer(name);
 }
 
+QRectF BGI_Plane::getBoundingRectPx(const Path& fragment) noexcept {
+  // Plane fragments consist of straight segments only (see
+  // ClipperHelpers::convert()), so the vertices span the whole area.
+  const QVector<Vertex>& vertices = fragment.getVertices();
+  if (vertices.isEmpty()) {
+    return QRectF();
+  }
+  Length left   = vertices.first().getPos().getX();
+  Length right  = left;
+  Length bottom = vertices.first().getPos().getY();
+  Length top    = bottom;
+  foreach (const Vertex& vertex, vertices) {
+    Q_ASSERT(vertex.getAngle() == 0);
+    left   = qMin(left, vertex.getPos().getX());
+    right  = qMax(right, vertex.getPos().getX());
+    bottom = qMin(bottom, vertex.getPos().getY());
+    top    = qMax(top, vertex.getPos().getY());
+  }
+  // note: the y-axis is inverted in the scene
+  return QRectF(QPointF(left.toPx(), -top.toPx()),
+                QPointF(right.toPx(), -bottom.toPx()));
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -74,6 +74,7 @@ private:
 
   // Private Methods
   GraphicsLayer* getLayer(QString name) const noexcept;
+  static QRectF  getBoundingRectPx(const Path& fragment) noexcept;
 
   // General Attributes
   BI_Plane& mPlane;
@@ -83,7 +84,7 @@ private:
   QRectF                mBoundingRect;
   QPainterPath          mShape;
   QPainterPath          mOutline;
-  QVector<QPainterPath> mAreas;
+  QVector<QRectF>       mFragmentBoundingRects;  ///< Same order as fragments
 };
 
 /*******************************************************************************
@@ -89,6 +89,10 @@ void BGI_Via::updateCacheAndRepaint() noexcept {
   UnsignedLength stopMaskClearance =
       mVia.getBoard().getDesignRules().calcStopMaskClearance(*mVia.getSize());
 
+  // hide the via if none of its layers is visible
+  setVisibilityLayers({mViaLayer, mDrawStopMask ? mTopStopMaskLayer : nullptr,
+                       mDrawStopMask ? mBottomStopMaskLayer : nullptr});
+
   // set shapes and bounding rect
   mShape        = mVia.getOutline().toQPainterPathPx();
   mCopper       = mVia.toQPainterPathPx();
@@ -104,13 +108,14 @@ void BGI_Via::updateCacheAndRepaint() noexcept {
 
 void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
                     QWidget* widget) {
-  Q_UNUSED(option);
   Q_UNUSED(widget);
+  const qreal lod     = getLevelOfDetail(*painter, *option);
+  const bool  details = areDetailsVisible(lod, boundingRect());
 
   NetSignal& netsignal = mVia.getNetSignalOfNetSegment();
   bool       highlight = mVia.isSelected() || (netsignal.isHighlighted());
 
-  if (mDrawStopMask && mBottomStopMaskLayer &&
+  if (details && mDrawStopMask && mBottomStopMaskLayer &&
       mBottomStopMaskLayer->isVisible()) {
     // draw bottom stop mask
     painter->setPen(Qt::NoPen);
@@ -119,19 +124,27 @@ void BGI_Via::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
   }
 
   if (mViaLayer && mViaLayer->isVisible()) {
-    // draw via
+    // draw via (only a few pixels large vias are drawn as rect, which is much
+    // faster than drawing the path)
     painter->setPen(Qt::NoPen);
     painter->setBrush(mViaLayer->getColor(highlight));
-    painter->drawPath(mCopper);
+    if (details) {
+      painter->drawPath(mCopper);
+    } else {
+      painter->drawRect(mShape.boundingRect());
+    }
 
     // draw netsignal name
-    painter->setFont(mFont);
-    painter->setPen(mViaLayer->getColor(highlight).lighter(150));
-    painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
-                      *netsignal.getName());
+    if (isTextVisible(lod, mFont.pixelSize())) {
+      painter->setFont(mFont);
+      painter->setPen(mViaLayer->getColor(highlight).lighter(150));
+      painter->drawText(mShape.boundingRect(), Qt::AlignCenter,
+                        *netsignal.getName());
+    }
   }
 
-  if (mDrawStopMask && mTopStopMaskLayer && mTopStopMaskLayer->isVisible()) {
+  if (details && mDrawStopMask && mTopStopMaskLayer &&
+      mTopStopMaskLayer->isVisible()) {
     // draw top stop mask
     painter->setPen(Qt::NoPen);
     painter->setBrush(mTopStopMaskLayer->getColor(highlight));
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "bgi_base.h"
 
+#include <librepcb/common/utils/memorypool.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -46,7 +48,7 @@ class BI_Via;
 /**
  * @brief The BGI_Via class
  */
-class BGI_Via final : public BGI_Base {
+class BGI_Via final : public BGI_Base, public PoolAllocated<BGI_Via> {
 public:
   // Constructors / Destructor
   explicit BGI_Via(BI_Via& via) noexcept;
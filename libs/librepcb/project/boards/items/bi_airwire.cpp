@@ -23,6 +23,11 @@
 #include "bi_airwire.h"
 
 #include "../../circuit/netsignal.h"
+#include "../board.h"
+#include "../boardlayerstack.h"
+
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/toolbox.h>
 
 #include <QtCore>
 
@@ -39,12 +44,37 @@ namespace project {
 BI_AirWire::BI_AirWire(Board& board, const NetSignal& netsignal,
                        const Point& p1, const Point& p2)
   : BI_Base(board), mNetSignal(netsignal), mP1(p1), mP2(p2) {
-  mGraphicsItem.reset(new BGI_AirWire(*this));
 }
 
 BI_AirWire::~BI_AirWire() noexcept {
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+QVector<QLineF> BI_AirWire::getLinesPx() const noexcept {
+  if (isVertical()) {
+    // draw a cross to make the airwire visible
+    const QRectF rect = getBoundingRectPx();
+    return {QLineF(rect.topLeft(), rect.bottomRight()),
+            QLineF(rect.bottomLeft(), rect.topRight())};
+  } else {
+    return {QLineF(mP1.toPxQPointF(), mP2.toPxQPointF())};
+  }
+}
+
+QRectF BI_AirWire::getBoundingRectPx() const noexcept {
+  if (isVertical()) {
+    Length size(200000);
+    return QRectF((mP1 - Point(size, size)).toPxQPointF(),
+                  (mP1 + Point(size, size)).toPxQPointF())
+        .normalized();
+  } else {
+    return QRectF(mP1.toPxQPointF(), mP2.toPxQPointF()).normalized();
+  }
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -53,18 +83,18 @@ void BI_AirWire::addToBoard() {
   if (isAddedToBoard()) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mHighlightChangedConnection =
-      connect(&mNetSignal, &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
-  BI_Base::addToBoard(mGraphicsItem.data());
+  BI_Base::addToBoard(nullptr);
 }
 
 void BI_AirWire::removeFromBoard() {
   if (!isAddedToBoard()) {
     throw LogicError(__FILE__, __LINE__);
   }
-  disconnect(mHighlightChangedConnection);
-  BI_Base::removeFromBoard(mGraphicsItem.data());
+  BI_Base::removeFromBoard(nullptr);
+}
+
+void BI_AirWire::createGraphicsItems() noexcept {
+  // nothing to do, airwires are drawn by the board (see BGI_AirWires)
 }
 
 /*******************************************************************************
@@ -72,16 +102,29 @@ void BI_AirWire::removeFromBoard() {
  ******************************************************************************/
 
 QPainterPath BI_AirWire::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->shape();
+  QPainterPath path;
+  if (isVertical()) {
+    path.addEllipse(getBoundingRectPx());
+  } else {
+    path.moveTo(mP1.toPxQPointF());
+    path.lineTo(mP2.toPxQPointF());
+  }
+  return Toolbox::shapeFromPath(path, QPen(Length::fromMm(0.3).toPx()),
+                                QBrush());
 }
 
 void BI_AirWire::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  if (isAddedToBoard() && mBoard.hasGraphicsItems()) {
+    mBoard.getGraphicsScene().scheduleUpdate(
+        getGrabAreaScenePx().boundingRect());
+  }
 }
 
 bool BI_AirWire::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  GraphicsLayer* layer =
+      mBoard.getLayerStack().getLayer(GraphicsLayer::sBoardAirWires);
+  return mBoard.hasGraphicsItems() && layer && layer->isVisible();
 }
 
 /*******************************************************************************
@@ -23,7 +23,6 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
-#include "../graphicsitems/bgi_airwire.h"
 #include "bi_base.h"
 
 #include <QtCore>
@@ -40,6 +39,9 @@ namespace project {
 
 /**
  * @brief The BI_AirWire class
+ *
+ * Air wires do not have their own graphics items, all air wires of a net
+ * signal are drawn by one librepcb::project::BGI_AirWires item of the board.
  */
 class BI_AirWire final : public BI_Base {
   Q_OBJECT
@@ -57,10 +59,13 @@ public:
   const Point&     getP1() const noexcept { return mP1; }
   const Point&     getP2() const noexcept { return mP2; }
   bool             isVertical() const noexcept { return mP1 == mP2; }
+  QVector<QLineF>  getLinesPx() const noexcept;
+  QRectF           getBoundingRectPx() const noexcept;
 
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
 
   // Inherited from BI_Base
   Type_t getType() const noexcept override { return BI_Base::Type_t::AirWire; }
@@ -74,11 +79,9 @@ public:
   BI_AirWire& operator=(const BI_AirWire& rhs) = delete;
 
 private:
-  QScopedPointer<BGI_AirWire> mGraphicsItem;
-  QMetaObject::Connection     mHighlightChangedConnection;
-  const NetSignal&            mNetSignal;
-  Point                       mP1;
-  Point                       mP2;
+  const NetSignal& mNetSignal;
+  Point            mP1;
+  Point            mP2;
 };
 
 /*******************************************************************************
@@ -36,12 +36,22 @@
 namespace librepcb {
 namespace project {
 
+/*******************************************************************************
+ *  Static Variables
+ ******************************************************************************/
+
+std::atomic<quint64> BI_Base::sLastRevision(0);
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
 
 BI_Base::BI_Base(Board& board) noexcept
-  : QObject(&board), mBoard(board), mIsAddedToBoard(false), mIsSelected(false) {
+  : QObject(&board),
+    mBoard(board),
+    mIsAddedToBoard(false),
+    mIsSelected(false),
+    mRevision(++sLastRevision) {
 }
 
 BI_Base::~BI_Base() noexcept {
@@ -65,7 +75,12 @@ Circuit& BI_Base::getCircuit() const noexcept {
  ******************************************************************************/
 
 void BI_Base::setSelected(bool selected) noexcept {
-  mIsSelected = selected;
+  if (selected != mIsSelected) {
+    mIsSelected = selected;
+    if (mIsAddedToBoard) {
+      mBoard.updateSelectedItems(*this, selected);
+    }
+  }
 }
 
 /*******************************************************************************
@@ -74,10 +89,13 @@ void BI_Base::setSelected(bool selected) noexcept {
 
 void BI_Base::addToBoard(QGraphicsItem* item) noexcept {
   Q_ASSERT(!mIsAddedToBoard);
+  mIsAddedToBoard = true;
+  if (mIsSelected) {
+    mBoard.updateSelectedItems(*this, true);
+  }
   if (item) {
-    mBoard.getGraphicsScene().addItem(*item);
+    registerGraphicsItem(*item);
   }
-  mIsAddedToBoard = true;
 }
 
 void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
@@ -85,9 +103,40 @@ void BI_Base::removeFromBoard(QGraphicsItem* item) noexcept {
   if (item) {
     mBoard.getGraphicsScene().removeItem(*item);
   }
+  if (mIsSelected) {
+    mBoard.updateSelectedItems(*this, false);
+  }
   mIsAddedToBoard = false;
 }
 
+void BI_Base::registerGraphicsItem(QGraphicsItem& item) noexcept {
+  // allow spatial queries on the scene to find the board item (see
+  // #fromGraphicsItem())
+  item.setData(sGraphicsItemDataKey,
+               QVariant::fromValue(static_cast<void*>(this)));
+  if (mIsAddedToBoard) {
+    mBoard.getGraphicsScene().addItem(item);
+  }
+}
+
+void BI_Base::scheduleRepaint(const QGraphicsItem* item) noexcept {
+  if (item && mIsAddedToBoard) {
+    mBoard.getGraphicsScene().scheduleUpdate(item->sceneBoundingRect());
+  }
+}
+
+void BI_Base::increaseRevision() noexcept {
+  mRevision = ++sLastRevision;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+BI_Base* BI_Base::fromGraphicsItem(const QGraphicsItem& item) noexcept {
+  return static_cast<BI_Base*>(item.data(sGraphicsItemDataKey).value<void*>());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
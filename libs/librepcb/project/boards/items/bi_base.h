@@ -28,6 +28,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <atomic>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -87,6 +89,18 @@ public:
   virtual bool isSelectable() const noexcept = 0;
   virtual bool isSelected() const noexcept { return mIsSelected; }
 
+  /**
+   * @brief Get the current revision of the item's geometry
+   *
+   * The revision changes each time the geometry of the item (e.g. position,
+   * size or layer) changes. Revisions are unique across all items of all
+   * boards, so the (ordered) revisions of a set of items can be used as a
+   * cheap cache key for geometry derived from these items.
+   *
+   * @return Revision number (never zero)
+   */
+  quint64 getRevision() const noexcept { return mRevision; }
+
   // Setters
   virtual void setSelected(bool selected) noexcept;
 
@@ -94,21 +108,82 @@ public:
   virtual void addToBoard()      = 0;
   virtual void removeFromBoard() = 0;
 
+  /**
+   * @brief Create the graphics items of this item and of its child items
+   *
+   * Graphics items are created lazily when the board is shown the first time
+   * (see librepcb::project::Board::hasGraphicsItems()). Items created
+   * afterwards create their graphics items in their constructor.
+   */
+  virtual void createGraphicsItems() noexcept = 0;
+
   // Operator Overloadings
   BI_Base& operator=(const BI_Base& rhs) = delete;
 
+  // Static Methods
+
+  /**
+   * @brief Get the board item which owns a graphics item of the board scene
+   *
+   * @param item  Any graphics item of the board's graphics scene
+   *
+   * @return The item which added the graphics item to the board, or nullptr
+   *         if the graphics item is not directly owned by a board item (e.g.
+   *         child items or ERC markers)
+   */
+  static BI_Base* fromGraphicsItem(const QGraphicsItem& item) noexcept;
+
 protected:
   // General Methods
   void addToBoard(QGraphicsItem* item) noexcept;
   void removeFromBoard(QGraphicsItem* item) noexcept;
 
+  /**
+   * @brief Register a newly created graphics item of this item
+   *
+   * Allows finding this item from the graphics item (see #fromGraphicsItem())
+   * and adds it to the board's scene if this item is already added to the
+   * board.
+   *
+   * @param item  The new graphics item
+   */
+  void registerGraphicsItem(QGraphicsItem& item) noexcept;
+
+  /**
+   * @brief Schedule a repaint of a graphics item of this item
+   *
+   * Used instead of QGraphicsItem::update() when a change affects many items
+   * at once (e.g. net signal highlighting), see
+   * librepcb::GraphicsScene::scheduleUpdate().
+   *
+   * @param item  The graphics item to repaint (may be nullptr)
+   */
+  void scheduleRepaint(const QGraphicsItem* item) noexcept;
+
+  /**
+   * @brief Assign a new revision to this item
+   *
+   * Must be called by derived classes whenever their geometry has changed.
+   *
+   * @see #getRevision()
+   */
+  void increaseRevision() noexcept;
+
 protected:
   Board& mBoard;
 
 private:
   // General Attributes
   bool mIsAddedToBoard;
-  bool mIsSelected;
+  bool    mIsSelected;
+  quint64 mRevision;
+
+  /// Last assigned revision (atomic, so items may be created or modified in
+  /// any thread without ever getting the same revision)
+  static std::atomic<quint64> sLastRevision;
+
+  /// Key of the QGraphicsItem::data() slot referring back to the board item
+  static const int sGraphicsItemDataKey = 0x4249;  // "BI"
 };
 
 /*******************************************************************************
@@ -243,6 +243,10 @@ void BI_Device::removeFromBoard() {
   updateErcMessages();
 }
 
+void BI_Device::createGraphicsItems() noexcept {
+  mFootprint->createGraphicsItems();
+}
+
 void BI_Device::serialize(SExpression& root) const {
   if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 
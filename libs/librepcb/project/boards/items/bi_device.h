@@ -102,6 +102,7 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -140,7 +141,7 @@ private:
                                                       const Uuid& footprintUuid);
   void               init();
   bool               checkAttributesValidity() const noexcept;
-  void               updateErcMessages() noexcept;
+  void               updateErcMessages() noexcept override;
   const QStringList& getLocaleOrder() const noexcept;
 
   // General
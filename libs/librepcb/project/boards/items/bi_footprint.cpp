@@ -31,6 +31,7 @@
 #include "bi_footprintpad.h"
 
 #include <librepcb/common/font/strokefontpool.h>
+#include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/scopeguardlist.h>
 #include <librepcb/library/dev/device.h>
@@ -73,9 +74,11 @@ BI_Footprint::BI_Footprint(BI_Device& device)
 
 void BI_Footprint::init() {
   // create graphics item
-  mGraphicsItem.reset(new BGI_Footprint(*this));
-  mGraphicsItem->setPos(mDevice.getPosition().toPxQPointF());
-  updateGraphicsItemTransform();
+  if (mBoard.hasGraphicsItems()) {
+    mGraphicsItem.reset(new BGI_Footprint(*this));
+    mGraphicsItem->setPos(mDevice.getPosition().toPxQPointF());
+    updateGraphicsItemTransform();
+  }
 
   // load pads
   const library::Device& libDev = mDevice.getLibDevice();
@@ -101,12 +104,16 @@ void BI_Footprint::init() {
   // connect to the "attributes changed" signal of device instance
   connect(&mDevice, &BI_Device::attributesChanged, this,
           &BI_Footprint::deviceInstanceAttributesChanged);
+  connect(&mBoard, &Board::designRulesOrLayersChanged, this,
+          &BI_Footprint::boardDesignRulesOrLayersChanged);
   connect(&mDevice, &BI_Device::moved, this,
           &BI_Footprint::deviceInstanceMoved);
   connect(&mDevice, &BI_Device::rotated, this,
           &BI_Footprint::deviceInstanceRotated);
   connect(&mDevice, &BI_Device::mirrored, this,
           &BI_Footprint::deviceInstanceMirrored);
+
+  mSceneHoleAndOutlineAreas = getSceneHoleAndOutlineAreas();
 }
 
 BI_Footprint::~BI_Footprint() noexcept {
@@ -141,7 +148,29 @@ bool BI_Footprint::isUsed() const noexcept {
 }
 
 QRectF BI_Footprint::getBoundingRect() const noexcept {
-  return mGraphicsItem->sceneTransform().mapRect(mGraphicsItem->boundingRect());
+  return mGraphicsItem ? mGraphicsItem->sceneTransform().mapRect(
+                             mGraphicsItem->boundingRect())
+                       : QRectF();
+}
+
+QVector<Path> BI_Footprint::getSceneHoleAndOutlineAreas() const noexcept {
+  // These objects of the library footprint are no board items, but they are
+  // obstacles for planes (holes) or modify the board area (outlines).
+  QVector<Path> areas;
+  for (const Hole& hole : getLibFootprint().getHoles()) {
+    areas.append(Path::circle(hole.getDiameter())
+                     .translated(mapToScene(hole.getPosition())));
+  }
+  for (const Polygon& polygon : getLibFootprint().getPolygons()) {
+    if (polygon.getLayerName() == GraphicsLayer::sBoardOutlines) {
+      Path path = polygon.getPath();
+      path.rotate(getRotation());
+      if (getIsMirrored()) path.mirror(Qt::Horizontal);
+      path.translate(getPosition());
+      areas.append(path);
+    }
+  }
+  return areas;
 }
 
 /*******************************************************************************
@@ -199,6 +228,9 @@ void BI_Footprint::addToBoard() {
     sgl.add([text]() { text->removeFromBoard(); });
   }
   BI_Base::addToBoard(mGraphicsItem.data());
+  if (!mSceneHoleAndOutlineAreas.isEmpty()) {
+    mBoard.schedulePlanesRebuild(mSceneHoleAndOutlineAreas);
+  }
   sgl.dismiss();
 }
 
@@ -216,9 +248,21 @@ void BI_Footprint::removeFromBoard() {
     sgl.add([text]() { text->addToBoard(); });
   }
   BI_Base::removeFromBoard(mGraphicsItem.data());
+  if (!mSceneHoleAndOutlineAreas.isEmpty()) {
+    mBoard.schedulePlanesRebuild(mSceneHoleAndOutlineAreas);
+  }
   sgl.dismiss();
 }
 
+void BI_Footprint::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(new BGI_Footprint(*this));
+  mGraphicsItem->setPos(mDevice.getPosition().toPxQPointF());
+  updateGraphicsItemTransform();
+  registerGraphicsItem(*mGraphicsItem);
+  foreach (BI_FootprintPad* pad, mPads) { pad->createGraphicsItems(); }
+  foreach (BI_StrokeText* text, mStrokeTexts) { text->createGraphicsItems(); }
+}
+
 void BI_Footprint::serialize(SExpression& root) const {
   serializePointerContainerUuidSorted(root, mStrokeTexts, "stroke_text");
 }
@@ -260,16 +304,18 @@ bool BI_Footprint::getIsMirrored() const noexcept {
 }
 
 QPainterPath BI_Footprint::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+  return mGraphicsItem
+      ? mGraphicsItem->sceneTransform().map(mGraphicsItem->shape())
+      : QPainterPath();
 }
 
 bool BI_Footprint::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Footprint::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  scheduleRepaint(mGraphicsItem.data());
   foreach (BI_FootprintPad* pad, mPads)
     pad->setSelected(selected);
   foreach (BI_StrokeText* text, mStrokeTexts)
@@ -281,49 +327,77 @@ void BI_Footprint::setSelected(bool selected) noexcept {
  ******************************************************************************/
 
 void BI_Footprint::deviceInstanceAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
   emit attributesChanged();
 }
 
+void BI_Footprint::boardDesignRulesOrLayersChanged() {
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+}
+
 void BI_Footprint::deviceInstanceMoved(const Point& pos) {
-  mGraphicsItem->setPos(pos.toPxQPointF());
-  mGraphicsItem->updateCacheAndRepaint();
-  foreach (BI_FootprintPad* pad, mPads) {
-    pad->updatePosition();
-    mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
+  increaseRevision();
+  if (mGraphicsItem) {
+    mGraphicsItem->setPos(pos.toPxQPointF());
+    mGraphicsItem->updateCacheAndRepaint();
   }
+  updatePadPositions();
   foreach (BI_StrokeText* text, mStrokeTexts) { text->updateGraphicsItems(); }
 }
 
 void BI_Footprint::deviceInstanceRotated(const Angle& rot) {
   Q_UNUSED(rot);
+  increaseRevision();
   updateGraphicsItemTransform();
-  mGraphicsItem->updateCacheAndRepaint();
-  foreach (BI_FootprintPad* pad, mPads) {
-    pad->updatePosition();
-    mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
   }
+  updatePadPositions();
 }
 
 void BI_Footprint::deviceInstanceMirrored(bool mirrored) {
   Q_UNUSED(mirrored);
+  increaseRevision();
   updateGraphicsItemTransform();
-  mGraphicsItem->updateCacheAndRepaint();
-  foreach (BI_FootprintPad* pad, mPads) {
-    pad->updatePosition();
-    mBoard.scheduleAirWiresRebuild(pad->getCompSigInstNetSignal());
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
   }
+  updatePadPositions();
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+void BI_Footprint::updatePadPositions() noexcept {
+  // Scheduling the planes rebuild is expensive (the areas get merged), so
+  // collect the areas of all pads, holes and outlines and schedule them at
+  // once, which leads to a single incremental rebuild of the planes. Same for
+  // the air wires, which are rebuilt per net signal anyway.
+  QVector<Path>    dirtyAreas = mSceneHoleAndOutlineAreas;
+  QSet<NetSignal*> netsignals;
+  foreach (BI_FootprintPad* pad, mPads) {
+    pad->updatePosition(&dirtyAreas);
+    netsignals.insert(pad->getCompSigInstNetSignal());
+  }
+  mSceneHoleAndOutlineAreas = getSceneHoleAndOutlineAreas();
+  dirtyAreas += mSceneHoleAndOutlineAreas;
+  if (!dirtyAreas.isEmpty()) {
+    mBoard.schedulePlanesRebuild(dirtyAreas);
+  }
+  foreach (NetSignal* netsignal, netsignals) {
+    mBoard.scheduleAirWiresRebuild(netsignal);
+  }
+}
+
 void BI_Footprint::updateGraphicsItemTransform() noexcept {
   QTransform t;
   if (mDevice.getIsMirrored()) t.scale(qreal(-1), qreal(1));
   t.rotate(-mDevice.getRotation().toDeg());
-  mGraphicsItem->setTransform(t);
+  if (mGraphicsItem) {
+    mGraphicsItem->setTransform(t);
+  }
 }
 
 /*******************************************************************************
@@ -29,6 +29,7 @@
 
 #include <librepcb/common/attributes/attributeprovider.h>
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/geometry/path.h>
 
 #include <QtCore>
 
@@ -80,6 +81,7 @@ public:
   bool                                isSelectable() const noexcept override;
   bool                                isUsed() const noexcept;
   QRectF                              getBoundingRect() const noexcept;
+  QVector<Path> getSceneHoleAndOutlineAreas() const noexcept;
   BGI_Footprint& getGraphicsItem() noexcept { return *mGraphicsItem; }
 
   // StrokeText Methods
@@ -93,6 +95,7 @@ public:
   void resetStrokeTextsToLibraryFootprint();
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -119,6 +122,7 @@ public:
 
 private slots:
   void deviceInstanceAttributesChanged();
+  void boardDesignRulesOrLayersChanged();
   void deviceInstanceMoved(const Point& pos);
   void deviceInstanceRotated(const Angle& rot);
   void deviceInstanceMirrored(bool mirrored);
@@ -129,6 +133,7 @@ signals:
 
 private:
   void init();
+  void updatePadPositions() noexcept;
   void updateGraphicsItemTransform() noexcept;
 
   // General
@@ -136,6 +141,10 @@ private:
   QScopedPointer<BGI_Footprint> mGraphicsItem;
   QMap<Uuid, BI_FootprintPad*>  mPads;  ///< key: footprint pad UUID
   QList<BI_StrokeText*>         mStrokeTexts;
+
+  /// The holes and board outlines at the last modification, to know the area
+  /// to rebuild the planes when the footprint gets moved
+  QVector<Path> mSceneHoleAndOutlineAreas;
 };
 
 /*******************************************************************************
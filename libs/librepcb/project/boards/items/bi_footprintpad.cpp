@@ -29,6 +29,7 @@
 #include "bi_footprint.h"
 
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/transform.h>
 #include <librepcb/library/dev/device.h>
 #include <librepcb/library/pkg/footprint.h>
 #include <librepcb/library/pkg/package.h>
@@ -72,12 +73,14 @@ BI_FootprintPad::BI_FootprintPad(BI_Footprint& footprint, const Uuid& padUuid)
             &BI_FootprintPad::componentSignalInstanceNetSignalChanged);
   }
 
-  mGraphicsItem.reset(new BGI_FootprintPad(*this));
   updatePosition();
+  if (mBoard.hasGraphicsItems()) {
+    createGraphicsItems();
+  }
 
-  // connect to the "attributes changed" signal of the footprint
-  connect(&mFootprint, &BI_Footprint::attributesChanged, this,
-          &BI_FootprintPad::footprintAttributesChanged);
+  // connect to the "design rules or layers changed" signal of the board
+  connect(&mBoard, &Board::designRulesOrLayersChanged, this,
+          &BI_FootprintPad::boardDesignRulesOrLayersChanged);
 }
 
 BI_FootprintPad::~BI_FootprintPad() {
@@ -152,6 +155,13 @@ void BI_FootprintPad::removeFromBoard() {
   BI_Base::removeFromBoard(mGraphicsItem.data());
 }
 
+void BI_FootprintPad::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(new BGI_FootprintPad(*this));
+  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  updateGraphicsItemTransform();
+  registerGraphicsItem(*mGraphicsItem);
+}
+
 void BI_FootprintPad::registerNetLine(BI_NetLine& netline) {
   if ((!isAddedToBoard()) || (mRegisteredNetLines.contains(&netline)) ||
       (netline.getBoard() != mBoard) ||
@@ -176,13 +186,33 @@ void BI_FootprintPad::unregisterNetLine(BI_NetLine& netline) {
   netline.updateLine();
 }
 
-void BI_FootprintPad::updatePosition() noexcept {
+void BI_FootprintPad::updatePosition(QVector<Path>* dirtyAreas) noexcept {
+  QVector<Path> areas;
+  if (isAddedToBoard()) {
+    areas.append(getSceneOutline());
+    foreach (const BI_NetLine* netline, mRegisteredNetLines) {
+      areas.append(netline->getSceneOutline());
+    }
+  }
   mPosition = mFootprint.mapToScene(mFootprintPad->getPosition());
   mRotation = mFootprint.getRotation() + mFootprintPad->getRotation();
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
-  updateGraphicsItemTransform();
-  mGraphicsItem->updateCacheAndRepaint();
-  foreach (BI_NetLine* netline, mRegisteredNetLines) { netline->updateLine(); }
+  increaseRevision();
+  if (mGraphicsItem) {
+    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    updateGraphicsItemTransform();
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  foreach (BI_NetLine* netline, mRegisteredNetLines) {
+    netline->updateLine(&areas);
+  }
+  if (isAddedToBoard()) {
+    areas.append(getSceneOutline());
+  }
+  if (dirtyAreas) {
+    *dirtyAreas += areas;
+  } else if (!areas.isEmpty()) {
+    mBoard.schedulePlanesRebuild(areas);
+  }
 }
 
 /*******************************************************************************
@@ -194,16 +224,18 @@ bool BI_FootprintPad::getIsMirrored() const noexcept {
 }
 
 QPainterPath BI_FootprintPad::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+  return mGraphicsItem
+      ? mGraphicsItem->sceneTransform().map(mGraphicsItem->shape())
+      : QPainterPath();
 }
 
 bool BI_FootprintPad::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_FootprintPad::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  scheduleRepaint(mGraphicsItem.data());
 }
 
 Path BI_FootprintPad::getOutline(const Length& expansion) const noexcept {
@@ -212,15 +244,17 @@ Path BI_FootprintPad::getOutline(const Length& expansion) const noexcept {
 
 Path BI_FootprintPad::getSceneOutline(const Length& expansion) const noexcept {
   Angle rotation = getIsMirrored() ? -mRotation : mRotation;
-  return getOutline(expansion).rotated(rotation).translated(mPosition);
+  return Transform(mPosition, rotation, false).map(getOutline(expansion));
 }
 
 /*******************************************************************************
  *  Private Slots
  ******************************************************************************/
 
-void BI_FootprintPad::footprintAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+void BI_FootprintPad::boardDesignRulesOrLayersChanged() {
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from,
@@ -232,8 +266,9 @@ void BI_FootprintPad::componentSignalInstanceNetSignalChanged(NetSignal* from,
   if (to) {
     mHighlightChangedConnection =
         connect(to, &NetSignal::highlightedChanged,
-                [this]() { mGraphicsItem->update(); });
+                [this]() { scheduleRepaint(mGraphicsItem.data()); });
   }
+  mBoard.schedulePlanesRebuild(getSceneOutline());
   mBoard.scheduleAirWiresRebuild(from);
   mBoard.scheduleAirWiresRebuild(to);
 }
@@ -246,7 +281,9 @@ void BI_FootprintPad::updateGraphicsItemTransform() noexcept {
   QTransform t;
   if (mFootprint.getIsMirrored()) t.scale(qreal(-1), qreal(1));
   t.rotate(-mRotation.toDeg());
-  mGraphicsItem->setTransform(t);
+  if (mGraphicsItem) {
+    mGraphicsItem->setTransform(t);
+  }
 }
 
 /*******************************************************************************
@@ -85,7 +85,18 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
-  void updatePosition() noexcept;
+  void createGraphicsItems() noexcept override;
+
+  /**
+   * @brief Update the position after the footprint was moved, rotated or
+   *        mirrored
+   *
+   * @param dirtyAreas  If not `nullptr`, the old and new outlines of the pad
+   *                    and its netlines are appended to it instead of
+   *                    scheduling the planes rebuild, so the caller can
+   *                    schedule the areas of all pads at once.
+   */
+  void updatePosition(QVector<Path>* dirtyAreas = nullptr) noexcept;
 
   // Inherited from BI_Base
   Type_t getType() const noexcept override {
@@ -108,7 +119,7 @@ public:
 
 private slots:
 
-  void footprintAttributesChanged();
+  void boardDesignRulesOrLayersChanged();
   void componentSignalInstanceNetSignalChanged(NetSignal* from, NetSignal* to);
 
 private:
@@ -41,23 +41,31 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BI_Hole::BI_Hole(Board& board, const BI_Hole& other) : BI_Base(board) {
+BI_Hole::BI_Hole(Board& board, const BI_Hole& other)
+  : BI_Base(board), mOnHoleEditedSlot(*this, &BI_Hole::holeEdited) {
   mHole.reset(new Hole(Uuid::createRandom(), *other.mHole));
   init();
 }
 
-BI_Hole::BI_Hole(Board& board, const SExpression& node) : BI_Base(board) {
+BI_Hole::BI_Hole(Board& board, const SExpression& node)
+  : BI_Base(board), mOnHoleEditedSlot(*this, &BI_Hole::holeEdited) {
   mHole.reset(new Hole(node));
   init();
 }
 
-BI_Hole::BI_Hole(Board& board, const Hole& hole) : BI_Base(board) {
+BI_Hole::BI_Hole(Board& board, const Hole& hole)
+  : BI_Base(board), mOnHoleEditedSlot(*this, &BI_Hole::holeEdited) {
   mHole.reset(new Hole(hole));
   init();
 }
 
 void BI_Hole::init() {
-  mGraphicsItem.reset(new HoleGraphicsItem(*mHole, mBoard.getLayerStack()));
+  mSceneOutline = getSceneOutline();
+  mHole->onEdited.attach(mOnHoleEditedSlot);
+
+  if (mBoard.hasGraphicsItems()) {
+    createGraphicsItems();
+  }
 }
 
 BI_Hole::~BI_Hole() noexcept {
@@ -65,6 +73,14 @@ BI_Hole::~BI_Hole() noexcept {
   mHole.reset();
 }
 
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+Path BI_Hole::getSceneOutline() const noexcept {
+  return Path::circle(mHole->getDiameter()).translated(mHole->getPosition());
+}
+
 /*******************************************************************************
  *  General Methods
  ******************************************************************************/
@@ -74,6 +90,7 @@ void BI_Hole::addToBoard() {
     throw LogicError(__FILE__, __LINE__);
   }
   BI_Base::addToBoard(mGraphicsItem.data());
+  mBoard.schedulePlanesRebuild(mSceneOutline);
 }
 
 void BI_Hole::removeFromBoard() {
@@ -81,6 +98,12 @@ void BI_Hole::removeFromBoard() {
     throw LogicError(__FILE__, __LINE__);
   }
   BI_Base::removeFromBoard(mGraphicsItem.data());
+  mBoard.schedulePlanesRebuild(mSceneOutline);
+}
+
+void BI_Hole::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(new HoleGraphicsItem(*mHole, mBoard.getLayerStack()));
+  registerGraphicsItem(*mGraphicsItem);
 }
 
 void BI_Hole::serialize(SExpression& root) const {
@@ -96,7 +119,9 @@ const Point& BI_Hole::getPosition() const noexcept {
 }
 
 QPainterPath BI_Hole::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+  return mGraphicsItem
+      ? mGraphicsItem->sceneTransform().map(mGraphicsItem->shape())
+      : QPainterPath();
 }
 
 const Uuid& BI_Hole::getUuid() const noexcept {
@@ -111,7 +136,27 @@ bool BI_Hole::isSelectable() const noexcept {
 
 void BI_Hole::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->setSelected(selected);
+  if (mGraphicsItem) {
+    mGraphicsItem->setSelected(selected);
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BI_Hole::holeEdited(const Hole& hole, Hole::Event event) noexcept {
+  Q_UNUSED(hole);
+  if (event != Hole::Event::UuidChanged) {
+    // The hole is already modified, so the old outline is taken from the
+    // last modification.
+    increaseRevision();
+    Path outline = getSceneOutline();
+    if (isAddedToBoard()) {
+      mBoard.schedulePlanesRebuild(QVector<Path>{mSceneOutline, outline});
+    }
+    mSceneOutline = outline;
+  }
 }
 
 /*******************************************************************************
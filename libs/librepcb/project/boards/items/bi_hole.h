@@ -27,6 +27,7 @@
 
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/geometry/hole.h>
+#include <librepcb/common/geometry/path.h>
 
 #include <QtCore>
 
@@ -67,10 +68,12 @@ public:
   const Uuid& getUuid() const
       noexcept;  // convenience function, e.g. for template usage
   bool isSelectable() const noexcept override;
+  Path getSceneOutline() const noexcept;
 
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -87,10 +90,18 @@ public:
 
 private:  // Methods
   void init();
+  void holeEdited(const Hole& hole, Hole::Event event) noexcept;
 
 private:  // Data
   QScopedPointer<Hole>             mHole;
   QScopedPointer<HoleGraphicsItem> mGraphicsItem;
+
+  /// The outline at the last modification, to know the area to rebuild the
+  /// planes when the hole gets modified
+  Path mSceneOutline;
+
+  // Slots
+  Hole::OnEditedSlot mOnHoleEditedSlot;
 };
 
 /*******************************************************************************
@@ -157,7 +157,9 @@ void BI_NetLine::init() {
                      "BI_NetLine: both endpoints are the same.");
   }
 
-  mGraphicsItem.reset(new BGI_NetLine(*this));
+  if (mBoard.hasGraphicsItems()) {
+    createGraphicsItems();
+  }
   updateLine();
 }
 
@@ -185,13 +187,17 @@ NetSignal& BI_NetLine::getNetSignalOfNetSegment() const noexcept {
 }
 
 Path BI_NetLine::getSceneOutline(const Length& expansion) const noexcept {
-  Length width = mWidth + (expansion * 2);
-  if (width > 0) {
-    return Path::obround(mStartPoint->getPosition(), mEndPoint->getPosition(),
-                         PositiveLength(width));
-  } else {
-    return Path();
-  }
+  return mClipperOutlineCache.getOutline(
+      getRevision(), expansion,
+      [this](const Length& e) { return createSceneOutline(e); });
+}
+
+ClipperLib::Path BI_NetLine::getSceneOutlineClipper(
+    const Length& expansion, const PositiveLength& maxArcTolerance) const
+    noexcept {
+  return mClipperOutlineCache.get(
+      getRevision(), expansion, maxArcTolerance,
+      [this](const Length& e) { return createSceneOutline(e); });
 }
 
 UnsignedLength BI_NetLine::getLength() const noexcept {
@@ -209,14 +215,22 @@ void BI_NetLine::setLayer(GraphicsLayer& layer) {
   }
   if (&layer != mLayer) {
     mLayer = &layer;
-    mGraphicsItem->updateCacheAndRepaint();
+    increaseRevision();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
   }
 }
 
 void BI_NetLine::setWidth(const PositiveLength& width) noexcept {
   if (width != mWidth) {
+    mBoard.schedulePlanesRebuild(getSceneOutline());
     mWidth = width;
-    mGraphicsItem->updateCacheAndRepaint();
+    increaseRevision();
+    mBoard.schedulePlanesRebuild(getSceneOutline());
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
   }
 }
 
@@ -235,8 +249,9 @@ void BI_NetLine::addToBoard() {
 
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+              [this]() { scheduleRepaint(mGraphicsItem.data()); });
   BI_Base::addToBoard(mGraphicsItem.data());
+  mBoard.schedulePlanesRebuild(getSceneOutline());
   sg.dismiss();
 }
 
@@ -251,12 +266,28 @@ void BI_NetLine::removeFromBoard() {
 
   disconnect(mHighlightChangedConnection);
   BI_Base::removeFromBoard(mGraphicsItem.data());
+  mBoard.schedulePlanesRebuild(getSceneOutline());
   sg.dismiss();
 }
 
-void BI_NetLine::updateLine() noexcept {
+void BI_NetLine::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(new BGI_NetLine(*this));
+  registerGraphicsItem(*mGraphicsItem);
+}
+
+void BI_NetLine::updateLine(QVector<Path>* dirtyAreas) noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
-  mGraphicsItem->updateCacheAndRepaint();
+  increaseRevision();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
+  if (isAddedToBoard()) {
+    if (dirtyAreas) {
+      dirtyAreas->append(getSceneOutline());
+    } else {
+      mBoard.schedulePlanesRebuild(getSceneOutline());
+    }
+  }
 }
 
 void BI_NetLine::serialize(SExpression& root) const {
@@ -301,21 +332,31 @@ void BI_NetLine::serializeAnchor(SExpression&      root,
   }
 }
 
+Path BI_NetLine::createSceneOutline(const Length& expansion) const noexcept {
+  Length width = mWidth + (expansion * 2);
+  if (width > 0) {
+    return Path::obround(mStartPoint->getPosition(), mEndPoint->getPosition(),
+                         PositiveLength(width));
+  } else {
+    return Path();
+  }
+}
+
 /*******************************************************************************
  *  Inherited from BI_Base
  ******************************************************************************/
 
 QPainterPath BI_NetLine::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->shape();
+  return mGraphicsItem ? mGraphicsItem->shape() : QPainterPath();
 }
 
 bool BI_NetLine::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_NetLine::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  scheduleRepaint(mGraphicsItem.data());
 }
 
 /*******************************************************************************
@@ -28,6 +28,8 @@
 
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/geometry/path.h>
+#include <librepcb/common/utils/clipperoutlinecache.h>
+#include <librepcb/common/utils/memorypool.h>
 #include <librepcb/common/uuid.h>
 
 #include <QtCore>
@@ -71,7 +73,9 @@ public:
 /**
  * @brief The BI_NetLine class
  */
-class BI_NetLine final : public BI_Base, public SerializableObject {
+class BI_NetLine final : public BI_Base,
+                         public SerializableObject,
+                         public PoolAllocated<BI_NetLine> {
   Q_OBJECT
 
 public:
@@ -98,6 +102,9 @@ public:
   NetSignal& getNetSignalOfNetSegment() const noexcept;
   bool       isSelectable() const noexcept override;
   Path getSceneOutline(const Length& expansion = Length(0)) const noexcept;
+  ClipperLib::Path getSceneOutlineClipper(
+      const Length& expansion, const PositiveLength& maxArcTolerance) const
+      noexcept;
   UnsignedLength getLength() const noexcept;
 
   // Setters
@@ -107,7 +114,17 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
-  void updateLine() noexcept;
+  void createGraphicsItems() noexcept override;
+
+  /**
+   * @brief Update the line after one of its anchors was moved
+   *
+   * @param dirtyAreas  If not `nullptr`, the new outline of the line is
+   *                    appended to it instead of scheduling the planes
+   *                    rebuild, so the caller can schedule the areas of many
+   *                    items at once.
+   */
+  void updateLine(QVector<Path>* dirtyAreas = nullptr) noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -127,12 +144,14 @@ private:
   BI_NetLineAnchor* deserializeAnchor(const SExpression& root,
                                       const QString&     key) const;
   void serializeAnchor(SExpression& root, BI_NetLineAnchor* anchor) const;
+  Path createSceneOutline(const Length& expansion) const noexcept;
 
   // General
   BI_NetSegment&              mNetSegment;
   QScopedPointer<BGI_NetLine> mGraphicsItem;
   Point                   mPosition;  ///< the center of startpoint and endpoint
   QMetaObject::Connection mHighlightChangedConnection;
+  ClipperOutlineCache     mClipperOutlineCache;
 
   // Attributes
   Uuid              mUuid;
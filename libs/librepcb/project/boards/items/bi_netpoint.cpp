@@ -64,8 +64,9 @@ BI_NetPoint::BI_NetPoint(BI_NetSegment& segment, const Point& position)
 
 void BI_NetPoint::init() {
   // create the graphics item
-  mGraphicsItem.reset(new BGI_NetPoint(*this));
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  if (mBoard.hasGraphicsItems()) {
+    createGraphicsItems();
+  }
 
   // create ERC messages
   mErcMsgDeadNetPoint.reset(new ErcMsg(mBoard.getProject(), *this,
@@ -100,8 +101,13 @@ GraphicsLayer* BI_NetPoint::getLayerOfLines() const noexcept {
 
 void BI_NetPoint::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
+    foreach (const BI_NetLine* line, mRegisteredNetLines) {
+      mBoard.schedulePlanesRebuild(line->getSceneOutline());
+    }
     mPosition = position;
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    if (mGraphicsItem) {
+      mGraphicsItem->setPos(mPosition.toPxQPointF());
+    }
     foreach (BI_NetLine* line, mRegisteredNetLines) { line->updateLine(); }
     mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
   }
@@ -120,7 +126,7 @@ void BI_NetPoint::addToBoard() {
   }
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+              [this]() { scheduleRepaint(mGraphicsItem.data()); });
   mErcMsgDeadNetPoint->setVisible(true);
   BI_Base::addToBoard(mGraphicsItem.data());
   mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
@@ -139,6 +145,12 @@ void BI_NetPoint::removeFromBoard() {
   mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
 
+void BI_NetPoint::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(new BGI_NetPoint(*this));
+  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  registerGraphicsItem(*mGraphicsItem);
+}
+
 void BI_NetPoint::registerNetLine(BI_NetLine& netline) {
   if ((!isAddedToBoard()) || (mRegisteredNetLines.contains(&netline)) ||
       (&netline.getNetSegment() != &mNetSegment) ||
@@ -148,7 +160,9 @@ void BI_NetPoint::registerNetLine(BI_NetLine& netline) {
   }
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -160,7 +174,9 @@ void BI_NetPoint::unregisterNetLine(BI_NetLine& netline) {
   }
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
   mErcMsgDeadNetPoint->setVisible(mRegisteredNetLines.isEmpty());
 }
 
@@ -174,16 +190,18 @@ void BI_NetPoint::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath BI_NetPoint::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
+  return mGraphicsItem
+      ? mGraphicsItem->shape().translated(mPosition.toPxQPointF())
+      : QPainterPath();
 }
 
 bool BI_NetPoint::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_NetPoint::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  scheduleRepaint(mGraphicsItem.data());
 }
 
 /*******************************************************************************
@@ -29,6 +29,7 @@
 #include "bi_base.h"
 
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/utils/memorypool.h>
 
 #include <QtCore>
 
@@ -48,7 +49,8 @@ namespace project {
 class BI_NetPoint final : public BI_Base,
                           public BI_NetLineAnchor,
                           public SerializableObject,
-                          public IF_ErcMsgProvider {
+                          public IF_ErcMsgProvider,
+                          public PoolAllocated<BI_NetPoint> {
   Q_OBJECT
   DECLARE_ERC_MSG_CLASS_NAME(BI_NetPoint)
 
@@ -75,6 +77,7 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -34,6 +34,7 @@
 #include "bi_netpoint.h"
 #include "bi_via.h"
 
+#include <librepcb/common/algorithm/unionfind.h>
 #include <librepcb/common/scopeguardlist.h>
 
 #include <QtCore>
@@ -181,86 +182,6 @@ bool BI_NetSegment::isUsed() const noexcept {
           (!mNetLines.isEmpty()));
 }
 
-int BI_NetSegment::getViasAtScenePos(const Point&    pos,
-                                     QList<BI_Via*>& vias) const noexcept {
-  int count = 0;
-  foreach (BI_Via* via, mVias) {
-    if (via->isSelectable() &&
-        via->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
-      vias.append(via);
-      ++count;
-    }
-  }
-  return count;
-}
-
-int BI_NetSegment::getNetPointsAtScenePos(const Point&         pos,
-                                          const GraphicsLayer* layer,
-                                          QList<BI_NetPoint*>& points) const
-    noexcept {
-  int count = 0;
-  foreach (BI_NetPoint* netpoint, mNetPoints) {
-    if (netpoint->isSelectable() &&
-        netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-        ((!layer) || (netpoint->getLayerOfLines() == layer))) {
-      points.append(netpoint);
-      ++count;
-    }
-  }
-  return count;
-}
-
-int BI_NetSegment::getNetLinesAtScenePos(const Point&         pos,
-                                         const GraphicsLayer* layer,
-                                         QList<BI_NetLine*>&  lines) const
-    noexcept {
-  int count = 0;
-  foreach (BI_NetLine* netline, mNetLines) {
-    if (netline->isSelectable() &&
-        netline->getGrabAreaScenePx().contains(pos.toPxQPointF()) &&
-        ((!layer) || (&netline->getLayer() == layer))) {
-      lines.append(netline);
-      ++count;
-    }
-  }
-  return count;
-}
-
-BI_NetPoint* BI_NetSegment::getNetPointNextToScenePos(
-    const Point& pos, const GraphicsLayer* layer,
-    UnsignedLength& maxDistance) const noexcept {
-  BI_NetPoint* result = nullptr;
-  foreach (BI_NetPoint* netpoint, mNetPoints) {
-    if (netpoint->isSelectable() &&
-        ((!layer) || (netpoint->getLayerOfLines() == layer))) {
-      UnsignedLength distance = (netpoint->getPosition() - pos).getLength();
-      if (distance < maxDistance) {
-        maxDistance = distance;
-        result      = netpoint;
-      }
-    }
-  }
-  return result;
-}
-
-BI_Via* BI_NetSegment::getViaNextToScenePos(const Point&    pos,
-                                            UnsignedLength& maxDistance) const
-    noexcept {
-  BI_Via* result = nullptr;
-  foreach (BI_Via* via, mVias) {
-    if (via->isSelectable()) {
-      // NOTE(5n8ke): maxDistance is depending on the center of the via and
-      // not the actual distance between the position and the edge of the via
-      UnsignedLength distance = (via->getPosition() - pos).getLength();
-      if (distance < maxDistance) {
-        maxDistance = distance;
-        result      = via;
-      }
-    }
-  }
-  return result;
-}
-
 /*******************************************************************************
  *  Setters
  ******************************************************************************/
@@ -504,6 +425,14 @@ void BI_NetSegment::removeFromBoard() {
   sgl.dismiss();
 }
 
+void BI_NetSegment::createGraphicsItems() noexcept {
+  foreach (BI_Via* via, mVias) { via->createGraphicsItems(); }
+  foreach (BI_NetPoint* netpoint, mNetPoints) {
+    netpoint->createGraphicsItems();
+  }
+  foreach (BI_NetLine* netline, mNetLines) { netline->createGraphicsItems(); }
+}
+
 void BI_NetSegment::selectAll() noexcept {
   foreach (BI_Via* via, mVias)
     via->setSelected(via->isSelectable());
@@ -513,18 +442,6 @@ void BI_NetSegment::selectAll() noexcept {
     netline->setSelected(netline->isSelectable());
 }
 
-void BI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept {
-  foreach (BI_Via* via, mVias)
-    via->setSelected(via->isSelectable() &&
-                     via->getGrabAreaScenePx().intersects(rectPx));
-  foreach (BI_NetPoint* netpoint, mNetPoints)
-    netpoint->setSelected(netpoint->isSelectable() &&
-                          netpoint->getGrabAreaScenePx().intersects(rectPx));
-  foreach (BI_NetLine* netline, mNetLines)
-    netline->setSelected(netline->isSelectable() &&
-                         netline->getGrabAreaScenePx().intersects(rectPx));
-}
-
 void BI_NetSegment::clearSelection() const noexcept {
   foreach (BI_Via* via, mVias)
     via->setSelected(false);
@@ -581,65 +498,37 @@ bool BI_NetSegment::checkAttributesValidity() const noexcept {
 }
 
 bool BI_NetSegment::areAllNetPointsConnectedTogether() const noexcept {
-  const BI_NetLineAnchor* p = nullptr;
-  if (mVias.count() > 0) {
-    p = mVias.first();
-  } else if (mNetPoints.count() > 0) {
-    p = mNetPoints.first();
-  } else {
+  // Determine the connectivity with a single pass over all netlines instead
+  // of searching the netlines of each anchor, pads may connect netlines too.
+  QHash<const BI_NetLineAnchor*, int> ids;  // anchor -> ID in union-find
+  foreach (const BI_Via* via, mVias) {
+    ids.insert(via, ids.count());
+  }
+  foreach (const BI_NetPoint* netpoint, mNetPoints) {
+    ids.insert(netpoint, ids.count());
+  }
+  if (ids.count() <= 1) {
     return true;  // there are no vias or netpoints => must be "connected
                   // together" :)
   }
-  Q_ASSERT(p);
-  QSet<const BI_Via*>          vias;
-  QSet<const BI_NetPoint*>     points;
-  QSet<const BI_FootprintPad*> pads;
-  findAllConnectedNetPoints(*p, vias, pads, points);
-  return (vias.count() == mVias.count()) &&
-         (points.count() == mNetPoints.count());
-}
-
-void BI_NetSegment::findAllConnectedNetPoints(
-    const BI_NetLineAnchor& p, QSet<const BI_Via*>& vias,
-    QSet<const BI_FootprintPad*>& pads, QSet<const BI_NetPoint*>& points) const
-    noexcept {
-  if (const BI_Via* via = dynamic_cast<const BI_Via*>(&p)) {
-    if (vias.contains(via)) return;
-    vias.insert(via);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == via) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == via) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
-    }
-  } else if (const BI_FootprintPad* pad =
-                 dynamic_cast<const BI_FootprintPad*>(&p)) {
-    if (pads.contains(pad)) return;
-    pads.insert(pad);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == pad) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == pad) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
+  UnionFind groups(ids.count());
+  auto      getId = [&ids, &groups](const BI_NetLineAnchor* anchor) {
+    auto it = ids.find(anchor);
+    if (it == ids.end()) {
+      it = ids.insert(anchor, groups.addElement());  // e.g. a pad
     }
-  } else if (const BI_NetPoint* np = dynamic_cast<const BI_NetPoint*>(&p)) {
-    if (points.contains(np)) return;
-    points.insert(np);
-    foreach (const BI_NetLine* netline, mNetLines) {
-      if (&netline->getStartPoint() == np) {
-        findAllConnectedNetPoints(netline->getEndPoint(), vias, pads, points);
-      }
-      if (&netline->getEndPoint() == np) {
-        findAllConnectedNetPoints(netline->getStartPoint(), vias, pads, points);
-      }
+    return it.value();
+  };
+  foreach (const BI_NetLine* netline, mNetLines) {
+    groups.unite(getId(&netline->getStartPoint()),
+                 getId(&netline->getEndPoint()));
+  }
+  for (int i = 1; i < mVias.count() + mNetPoints.count(); ++i) {
+    if (!groups.isConnected(0, i)) {
+      return false;
     }
-  } else {
-    Q_ASSERT(false);
   }
+  return true;
 }
 
 /*******************************************************************************
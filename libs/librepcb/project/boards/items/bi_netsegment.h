@@ -71,18 +71,6 @@ public:
   const Uuid& getUuid() const noexcept { return mUuid; }
   NetSignal&  getNetSignal() const noexcept { return *mNetSignal; }
   bool        isUsed() const noexcept;
-  int getViasAtScenePos(const Point& pos, QList<BI_Via*>& vias) const noexcept;
-  int getNetPointsAtScenePos(const Point& pos, const GraphicsLayer* layer,
-                             QList<BI_NetPoint*>& points) const noexcept;
-  int getNetLinesAtScenePos(const Point& pos, const GraphicsLayer* layer,
-                            QList<BI_NetLine*>& lines) const noexcept;
-
-  BI_NetPoint* getNetPointNextToScenePos(const Point&         pos,
-                                         const GraphicsLayer* layer,
-                                         UnsignedLength&      maxDistance) const
-      noexcept;
-  BI_Via* getViaNextToScenePos(const Point&    pos,
-                               UnsignedLength& maxDistance) const noexcept;
 
   // Setters
   void setNetSignal(NetSignal& netsignal);
@@ -112,8 +100,8 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
   void selectAll() noexcept;
-  void setSelectionRect(const QRectF rectPx) noexcept;
   void clearSelection() const noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
@@ -141,11 +129,6 @@ public:
 private:
   bool checkAttributesValidity() const noexcept;
   bool areAllNetPointsConnectedTogether() const noexcept;
-  void findAllConnectedNetPoints(const BI_NetLineAnchor&       p,
-                                 QSet<const BI_Via*>&          vias,
-                                 QSet<const BI_FootprintPad*>& pads,
-                                 QSet<const BI_NetPoint*>&     points) const
-      noexcept;
 
   // Attributes
   Uuid       mUuid;
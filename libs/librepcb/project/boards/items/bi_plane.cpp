@@ -56,9 +56,9 @@ BI_Plane::BI_Plane(Board& board, const BI_Plane& other)
     // mThermalGapWidth(other.mThermalGapWidth),
     // mThermalSpokeWidth(other.mThermalSpokeWidth),
     mIsVisible(true),
-    mFragments(other.mFragments)  // also copy fragments to avoid the need for
-                                  // a rebuild
-{
+    mFragments(other.mFragments),  // also copy fragments to avoid the need
+                                   // for a rebuild
+    mFragmentsFingerprint(other.mFragmentsFingerprint) {
   init();
 }
 
@@ -86,6 +86,16 @@ BI_Plane::BI_Plane(Board& board, const SExpression& node)
         tr("Invalid net signal UUID: \"%1\"").arg(netSignalUuid.toStr()));
   }
   mOutline = Path(node);
+
+  // Load the fragments calculated when the board was saved. Whether they are
+  // still valid is determined later by comparing their fingerprint.
+  if (const SExpression* child = node.tryGetChildByPath("fragments")) {
+    mFragmentsFingerprint = QByteArray::fromHex(
+        child->getValueOfFirstChild<QString>(true).toLatin1());
+    foreach (const SExpression& fragmentNode, child->getChildren("fragment")) {
+      mFragments.append(Path(fragmentNode));
+    }
+  }
   init();
 }
 
@@ -109,13 +119,15 @@ BI_Plane::BI_Plane(Board& board, const Uuid& uuid,
 }
 
 void BI_Plane::init() {
-  mGraphicsItem.reset(new BGI_Plane(*this));
-  mGraphicsItem->setPos(getPosition().toPxQPointF());
-  mGraphicsItem->setRotation(Angle::deg0().toDeg());
+  mRebuildStatistics = RebuildStatistics{-1, 0, 0, 0, 0};
+
+  if (mBoard.hasGraphicsItems()) {
+    createGraphicsItems();
+  }
 
   // connect to the "attributes changed" signal of the board
-  connect(&mBoard, &Board::attributesChanged, this,
-          &BI_Plane::boardAttributesChanged);
+  connect(&mBoard, &Board::designRulesOrLayersChanged, this,
+          &BI_Plane::boardDesignRulesOrLayersChanged);
 }
 
 BI_Plane::~BI_Plane() noexcept {
@@ -129,14 +141,18 @@ BI_Plane::~BI_Plane() noexcept {
 void BI_Plane::setOutline(const Path& outline) noexcept {
   if (outline != mOutline) {
     mOutline = outline;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
   }
 }
 
 void BI_Plane::setLayerName(const GraphicsLayerName& layerName) noexcept {
   if (layerName != mLayerName) {
     mLayerName = layerName;
-    mGraphicsItem->updateCacheAndRepaint();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
   }
 }
 
@@ -188,7 +204,9 @@ void BI_Plane::setKeepOrphans(bool keepOrphans) noexcept {
 void BI_Plane::setVisible(bool visible) noexcept {
   if (visible != mIsVisible) {
     mIsVisible = visible;
-    mGraphicsItem->update();
+    if (mGraphicsItem) {
+      mGraphicsItem->update();
+    }
   }
 }
 
@@ -202,7 +220,9 @@ void BI_Plane::addToBoard() {
   }
   mNetSignal->registerBoardPlane(*this);  // can throw
   BI_Base::addToBoard(mGraphicsItem.data());
-  mGraphicsItem->updateCacheAndRepaint();  // TODO: remove this
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();  // TODO: remove this
+  }
   mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
@@ -215,15 +235,44 @@ void BI_Plane::removeFromBoard() {
   mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
+void BI_Plane::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(new BGI_Plane(*this));
+  mGraphicsItem->setPos(getPosition().toPxQPointF());
+  mGraphicsItem->setRotation(Angle::deg0().toDeg());
+  registerGraphicsItem(*mGraphicsItem);
+}
+
 void BI_Plane::clear() noexcept {
-  mFragments.clear();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (!mFragments.isEmpty()) {
+    mFragments.clear();
+    increaseRevision();
+  }
+  mFragmentsFingerprint.clear();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void BI_Plane::rebuild() noexcept {
   BoardPlaneFragmentsBuilder builder(*this);
-  mFragments = builder.buildFragments();
-  mGraphicsItem->updateCacheAndRepaint();
+  QVector<Path>              fragments = builder.buildFragments();
+  setCalculatedFragments(fragments, builder.calcFingerprint(),
+                         builder.getStatistics());
+}
+
+void BI_Plane::setCalculatedFragments(
+    const QVector<Path>& fragments, const QByteArray& fingerprint,
+    const RebuildStatistics& statistics) noexcept {
+  mFragmentsFingerprint = fingerprint;
+  mRebuildStatistics    = statistics;
+  if (fragments == mFragments) {
+    return;  // keep revision, graphics and air wires if nothing has changed
+  }
+  mFragments = fragments;
+  increaseRevision();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
   mBoard.scheduleAirWiresRebuild(mNetSignal);
 }
 
@@ -239,6 +288,13 @@ void BI_Plane::serialize(SExpression& root) const {
   // root.appendChild("thermal_gap_width", mThermalGapWidth, false);
   // root.appendChild("thermal_spoke_width", mThermalSpokeWidth, false);
   mOutline.serialize(root);
+  if (!mFragmentsFingerprint.isEmpty()) {
+    SExpression& child = root.appendList("fragments", true);
+    child.appendChild(QString(mFragmentsFingerprint.toHex()));
+    foreach (const Path& fragment, mFragments) {
+      child.appendChild(fragment.serializeToDomElement("fragment"), true);
+    }
+  }
 }
 
 /*******************************************************************************
@@ -246,16 +302,18 @@ void BI_Plane::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath BI_Plane::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+  return mGraphicsItem
+      ? mGraphicsItem->sceneTransform().map(mGraphicsItem->shape())
+      : QPainterPath();
 }
 
 bool BI_Plane::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Plane::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  scheduleRepaint(mGraphicsItem.data());
 }
 
 /*******************************************************************************
@@ -278,8 +336,10 @@ bool BI_Plane::operator<(const BI_Plane& rhs) const noexcept {
  *  Private Slots
  ******************************************************************************/
 
-void BI_Plane::boardAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+void BI_Plane::boardDesignRulesOrLayersChanged() {
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 /*******************************************************************************
@@ -60,6 +60,13 @@ public:
     // Thermal,    ///< add thermals to connect pads/vias to plane
     Solid,  ///< completely connect pads/vias to plane
   };
+  struct RebuildStatistics {
+    qint64 durationMs;          ///< Wall time, or -1 if not built yet
+    int    obstacleCount;       ///< Objects subtracted from the plane
+    int    vertexCount;         ///< Total number of vertices of all fragments
+    int    removedVertexCount;  ///< Vertices removed by the simplification
+    int    passCount;           ///< Calculations (windows) to get the result
+  };
 
   // Constructors / Destructor
   BI_Plane()                      = delete;
@@ -86,6 +93,12 @@ public:
   // {return mThermalSpokeWidth;}
   const Path&          getOutline() const noexcept { return mOutline; }
   const QVector<Path>& getFragments() const noexcept { return mFragments; }
+  const QByteArray&    getFragmentsFingerprint() const noexcept {
+    return mFragmentsFingerprint;
+  }
+  const RebuildStatistics& getRebuildStatistics() const noexcept {
+    return mRebuildStatistics;
+  }
   bool                 isSelectable() const noexcept override;
   bool                 isVisible() const noexcept { return mIsVisible; }
 
@@ -103,8 +116,12 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
   void clear() noexcept;
   void rebuild() noexcept;
+  void setCalculatedFragments(const QVector<Path>&     fragments,
+                              const QByteArray&        fingerprint,
+                              const RebuildStatistics& statistics) noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -125,7 +142,7 @@ public:
 
 private slots:
 
-  void boardAttributesChanged();
+  void boardDesignRulesOrLayersChanged();
 
 private:  // Methods
   void init();
@@ -146,7 +163,9 @@ private:  // Data
   QScopedPointer<BGI_Plane> mGraphicsItem;
   bool                      mIsVisible;  // volatile, not saved to file
 
-  QVector<Path> mFragments;
+  QVector<Path>     mFragments;
+  QByteArray        mFragmentsFingerprint;  ///< Empty if not calculated
+  RebuildStatistics mRebuildStatistics;     ///< Of the last calculation
 };
 
 /*******************************************************************************
@@ -27,6 +27,7 @@
 #include "../boardlayerstack.h"
 
 #include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/polygongraphicsitem.h>
 
@@ -42,17 +43,23 @@ namespace project {
  *  Constructors / Destructor
  ******************************************************************************/
 
-BI_Polygon::BI_Polygon(Board& board, const BI_Polygon& other) : BI_Base(board) {
+BI_Polygon::BI_Polygon(Board& board, const BI_Polygon& other)
+  : BI_Base(board),
+    mOnPolygonEditedSlot(*this, &BI_Polygon::polygonEdited) {
   mPolygon.reset(new Polygon(Uuid::createRandom(), *other.mPolygon));
   init();
 }
 
-BI_Polygon::BI_Polygon(Board& board, const SExpression& node) : BI_Base(board) {
+BI_Polygon::BI_Polygon(Board& board, const SExpression& node)
+  : BI_Base(board),
+    mOnPolygonEditedSlot(*this, &BI_Polygon::polygonEdited) {
   mPolygon.reset(new Polygon(node));
   init();
 }
 
-BI_Polygon::BI_Polygon(Board& board, const Polygon& polygon) : BI_Base(board) {
+BI_Polygon::BI_Polygon(Board& board, const Polygon& polygon)
+  : BI_Base(board),
+    mOnPolygonEditedSlot(*this, &BI_Polygon::polygonEdited) {
   mPolygon.reset(new Polygon(polygon));
   init();
 }
@@ -61,20 +68,23 @@ BI_Polygon::BI_Polygon(Board& board, const Uuid& uuid,
                        const GraphicsLayerName& layerName,
                        const UnsignedLength& lineWidth, bool fill,
                        bool isGrabArea, const Path& path)
-  : BI_Base(board) {
+  : BI_Base(board), mOnPolygonEditedSlot(*this, &BI_Polygon::polygonEdited) {
   mPolygon.reset(
       new Polygon(uuid, layerName, lineWidth, fill, isGrabArea, path));
   init();
 }
 
 void BI_Polygon::init() {
-  mGraphicsItem.reset(
-      new PolygonGraphicsItem(*mPolygon, mBoard.getLayerStack()));
-  mGraphicsItem->setZValue(Board::ZValue_Default);
+  mBoardOutline = getBoardOutline();
+  mPolygon->onEdited.attach(mOnPolygonEditedSlot);
+
+  if (mBoard.hasGraphicsItems()) {
+    createGraphicsItems();
+  }
 
   // connect to the "attributes changed" signal of the board
-  connect(&mBoard, &Board::attributesChanged, this,
-          &BI_Polygon::boardAttributesChanged);
+  connect(&mBoard, &Board::designRulesOrLayersChanged, this,
+          &BI_Polygon::boardDesignRulesOrLayersChanged);
 }
 
 BI_Polygon::~BI_Polygon() noexcept {
@@ -91,6 +101,9 @@ void BI_Polygon::addToBoard() {
     throw LogicError(__FILE__, __LINE__);
   }
   BI_Base::addToBoard(mGraphicsItem.data());
+  if (!mBoardOutline.getVertices().isEmpty()) {
+    mBoard.schedulePlanesRebuild(mBoardOutline);
+  }
 }
 
 void BI_Polygon::removeFromBoard() {
@@ -98,6 +111,16 @@ void BI_Polygon::removeFromBoard() {
     throw LogicError(__FILE__, __LINE__);
   }
   BI_Base::removeFromBoard(mGraphicsItem.data());
+  if (!mBoardOutline.getVertices().isEmpty()) {
+    mBoard.schedulePlanesRebuild(mBoardOutline);
+  }
+}
+
+void BI_Polygon::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(
+      new PolygonGraphicsItem(*mPolygon, mBoard.getLayerStack()));
+  mGraphicsItem->setZValue(Board::ZValue_Default);
+  registerGraphicsItem(*mGraphicsItem);
 }
 
 void BI_Polygon::serialize(SExpression& root) const {
@@ -109,7 +132,9 @@ void BI_Polygon::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath BI_Polygon::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+  return mGraphicsItem
+      ? mGraphicsItem->sceneTransform().map(mGraphicsItem->shape())
+      : QPainterPath();
 }
 
 const Uuid& BI_Polygon::getUuid() const noexcept {
@@ -124,15 +149,48 @@ bool BI_Polygon::isSelectable() const noexcept {
 
 void BI_Polygon::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->setSelected(selected);
+  if (mGraphicsItem) {
+    mGraphicsItem->setSelected(selected);
+  }
 }
 
 /*******************************************************************************
  *  Private Slots
  ******************************************************************************/
 
-void BI_Polygon::boardAttributesChanged() {
-  mGraphicsItem->update();
+void BI_Polygon::boardDesignRulesOrLayersChanged() {
+  if (mGraphicsItem) {
+    mGraphicsItem->update();
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BI_Polygon::polygonEdited(const Polygon& polygon,
+                               Polygon::Event event) noexcept {
+  Q_UNUSED(polygon);
+  if (event != Polygon::Event::UuidChanged) {
+    increaseRevision();
+  }
+
+  // Board outlines modify the board area, thus the planes must be rebuilt
+  // within the old and new outline. The polygon is already modified, so the
+  // old outline is taken from the last modification.
+  Path outline = getBoardOutline();
+  if (isAddedToBoard() && (outline != mBoardOutline)) {
+    mBoard.schedulePlanesRebuild(QVector<Path>{mBoardOutline, outline});
+  }
+  mBoardOutline = outline;
+}
+
+Path BI_Polygon::getBoardOutline() const noexcept {
+  if (mPolygon->getLayerName() == GraphicsLayer::sBoardOutlines) {
+    return mPolygon->getPath();
+  } else {
+    return Path();
+  }
 }
 
 /*******************************************************************************
@@ -26,6 +26,7 @@
 #include "bi_base.h"
 
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/geometry/polygon.h>
 #include <librepcb/common/graphics/graphicslayername.h>
 #include <librepcb/common/uuid.h>
 
@@ -37,7 +38,6 @@
 namespace librepcb {
 
 class Path;
-class Polygon;
 class PolygonGraphicsItem;
 
 namespace project {
@@ -78,6 +78,7 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -97,14 +98,24 @@ public:
 
 private slots:
 
-  void boardAttributesChanged();
+  void boardDesignRulesOrLayersChanged();
 
 private:
   void init();
+  void polygonEdited(const Polygon& polygon, Polygon::Event event) noexcept;
+  Path getBoardOutline() const noexcept;
 
   // General
   QScopedPointer<Polygon>             mPolygon;
   QScopedPointer<PolygonGraphicsItem> mGraphicsItem;
+
+  /// The board outline at the last modification (empty if the polygon is on
+  /// another layer), to know the area to rebuild the planes when it gets
+  /// modified
+  Path mBoardOutline;
+
+  // Slots
+  Polygon::OnEditedSlot mOnPolygonEditedSlot;
 };
 
 /*******************************************************************************
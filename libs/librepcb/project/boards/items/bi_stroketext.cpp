@@ -75,10 +75,9 @@ void BI_StrokeText::init() {
   mText->setFont(&getProject().getStrokeFonts().getFont(
       mBoard.getDefaultFontName()));  // can throw
 
-  mGraphicsItem.reset(
-      new StrokeTextGraphicsItem(*mText, mBoard.getLayerStack()));
-  mAnchorGraphicsItem.reset(new LineGraphicsItem());
-  updateGraphicsItems();
+  if (mBoard.hasGraphicsItems()) {
+    createGraphicsItems();
+  }
 
   // connect to the "attributes changed" signal of the board
   connect(&mBoard, &Board::attributesChanged, this,
@@ -98,6 +97,10 @@ void BI_StrokeText::setFootprint(BI_Footprint* footprint) noexcept {
 }
 
 void BI_StrokeText::updateGraphicsItems() noexcept {
+  if ((!mGraphicsItem) || (!mAnchorGraphicsItem)) {
+    return;  // no graphics items (yet)
+  }
+
   // update z-value
   Board::ItemZValue zValue = Board::ZValue_Texts;
   if (GraphicsLayer::isTopLayer(*mText->getLayerName())) {
@@ -124,7 +127,9 @@ void BI_StrokeText::addToBoard() {
     throw LogicError(__FILE__, __LINE__);
   }
   BI_Base::addToBoard(mGraphicsItem.data());
-  mBoard.getGraphicsScene().addItem(*mAnchorGraphicsItem);
+  if (mAnchorGraphicsItem) {
+    mBoard.getGraphicsScene().addItem(*mAnchorGraphicsItem);
+  }
 }
 
 void BI_StrokeText::removeFromBoard() {
@@ -132,7 +137,20 @@ void BI_StrokeText::removeFromBoard() {
     throw LogicError(__FILE__, __LINE__);
   }
   BI_Base::removeFromBoard(mGraphicsItem.data());
-  mBoard.getGraphicsScene().removeItem(*mAnchorGraphicsItem);
+  if (mAnchorGraphicsItem) {
+    mBoard.getGraphicsScene().removeItem(*mAnchorGraphicsItem);
+  }
+}
+
+void BI_StrokeText::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(
+      new StrokeTextGraphicsItem(*mText, mBoard.getLayerStack()));
+  mAnchorGraphicsItem.reset(new LineGraphicsItem());
+  updateGraphicsItems();
+  registerGraphicsItem(*mGraphicsItem);
+  if (isAddedToBoard()) {
+    mBoard.getGraphicsScene().addItem(*mAnchorGraphicsItem);
+  }
 }
 
 void BI_StrokeText::serialize(SExpression& root) const {
@@ -148,7 +166,9 @@ const Point& BI_StrokeText::getPosition() const noexcept {
 }
 
 QPainterPath BI_StrokeText::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->sceneTransform().map(mGraphicsItem->shape());
+  return mGraphicsItem
+      ? mGraphicsItem->sceneTransform().map(mGraphicsItem->shape())
+      : QPainterPath();
 }
 
 const Uuid& BI_StrokeText::getUuid() const noexcept {
@@ -163,7 +183,9 @@ bool BI_StrokeText::isSelectable() const noexcept {
 
 void BI_StrokeText::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->setSelected(selected);
+  if (mGraphicsItem) {
+    mGraphicsItem->setSelected(selected);
+  }
   updateGraphicsItems();
 }
 
@@ -172,7 +194,7 @@ void BI_StrokeText::setSelected(bool selected) noexcept {
  ******************************************************************************/
 
 void BI_StrokeText::boardAttributesChanged() {
-  mText->updatePaths();
+  mText->updatePathsIfTextChanged();
 }
 
 /*******************************************************************************
@@ -182,6 +204,9 @@ void BI_StrokeText::boardAttributesChanged() {
 void BI_StrokeText::strokeTextEdited(const StrokeText& text,
                                      StrokeText::Event event) noexcept {
   Q_UNUSED(text);
+  if (event != StrokeText::Event::UuidChanged) {
+    increaseRevision();
+  }
   switch (event) {
     case StrokeText::Event::LayerNameChanged:
     case StrokeText::Event::PositionChanged:
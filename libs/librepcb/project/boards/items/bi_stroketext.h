@@ -78,6 +78,7 @@ public:
   void          updateGraphicsItems() noexcept;
   void          addToBoard() override;
   void          removeFromBoard() override;
+  void          createGraphicsItems() noexcept override;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
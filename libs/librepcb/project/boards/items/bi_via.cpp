@@ -24,6 +24,7 @@
 
 #include "../../circuit/netsignal.h"
 #include "../boardlayerstack.h"
+#include "../viageometrycache.h"
 #include "bi_netsegment.h"
 
 #include <QtCore>
@@ -74,12 +75,13 @@ BI_Via::BI_Via(BI_NetSegment& netsegment, const Point& position, Shape shape,
 
 void BI_Via::init() {
   // create the graphics item
-  mGraphicsItem.reset(new BGI_Via(*this));
-  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  if (mBoard.hasGraphicsItems()) {
+    createGraphicsItems();
+  }
 
   // connect to the "attributes changed" signal of the board
-  connect(&mBoard, &Board::attributesChanged, this,
-          &BI_Via::boardAttributesChanged);
+  connect(&mBoard, &Board::designRulesOrLayersChanged, this,
+          &BI_Via::boardDesignRulesOrLayersChanged);
 }
 
 BI_Via::~BI_Via() noexcept {
@@ -101,18 +103,8 @@ bool BI_Via::isOnLayer(const QString& layerName) const noexcept {
 Path BI_Via::getOutline(const Length& expansion) const noexcept {
   Length size = mSize + (expansion * 2);
   if (size > 0) {
-    PositiveLength pSize(size);
-    switch (mShape) {
-      case Shape::Round:
-        return Path::circle(pSize);
-      case Shape::Square:
-        return Path::centeredRect(pSize, pSize);
-      case Shape::Octagon:
-        return Path::octagon(pSize, pSize);
-      default:
-        Q_ASSERT(false);
-        break;
-    }
+    return ViaGeometryCache::instance().getOutline(mShape,
+                                                   PositiveLength(size));
   }
   return Path();
 }
@@ -122,7 +114,12 @@ Path BI_Via::getSceneOutline(const Length& expansion) const noexcept {
 }
 
 QPainterPath BI_Via::toQPainterPathPx(const Length& expansion) const noexcept {
-  QPainterPath p = getOutline(expansion).toQPainterPathPx();
+  Length size = mSize + (expansion * 2);
+  if (size > 0) {
+    return ViaGeometryCache::instance().getCopperPx(
+        mShape, PositiveLength(size), mDrillDiameter);
+  }
+  QPainterPath p;
   p.setFillRule(Qt::OddEvenFill);  // important to subtract the hole!
   p.addEllipse(QPointF(0, 0), mDrillDiameter->toPx() / 2,
                mDrillDiameter->toPx() / 2);
@@ -135,33 +132,54 @@ QPainterPath BI_Via::toQPainterPathPx(const Length& expansion) const noexcept {
 
 void BI_Via::setPosition(const Point& position) noexcept {
   if (position != mPosition) {
+    mBoard.schedulePlanesRebuild(getSceneOutline());
+    foreach (const BI_NetLine* netline, mRegisteredNetLines) {
+      mBoard.schedulePlanesRebuild(netline->getSceneOutline());
+    }
     mPosition = position;
-    mGraphicsItem->setPos(mPosition.toPxQPointF());
+    increaseRevision();
+    if (mGraphicsItem) {
+      mGraphicsItem->setPos(mPosition.toPxQPointF());
+    }
     foreach (BI_NetLine* netline, mRegisteredNetLines) {
       netline->updateLine();
     }
+    mBoard.schedulePlanesRebuild(getSceneOutline());
     mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
   }
 }
 
 void BI_Via::setShape(Shape shape) noexcept {
   if (shape != mShape) {
+    mBoard.schedulePlanesRebuild(getSceneOutline());
     mShape = shape;
-    mGraphicsItem->updateCacheAndRepaint();
+    increaseRevision();
+    mBoard.schedulePlanesRebuild(getSceneOutline());
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
   }
 }
 
 void BI_Via::setSize(const PositiveLength& size) noexcept {
   if (size != mSize) {
+    mBoard.schedulePlanesRebuild(getSceneOutline());
     mSize = size;
-    mGraphicsItem->updateCacheAndRepaint();
+    increaseRevision();
+    mBoard.schedulePlanesRebuild(getSceneOutline());
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
   }
 }
 
 void BI_Via::setDrillDiameter(const PositiveLength& diameter) noexcept {
   if (diameter != mDrillDiameter) {
     mDrillDiameter = diameter;
-    mGraphicsItem->updateCacheAndRepaint();
+    increaseRevision();
+    if (mGraphicsItem) {
+      mGraphicsItem->updateCacheAndRepaint();
+    }
   }
 }
 
@@ -175,8 +193,9 @@ void BI_Via::addToBoard() {
   }
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+              [this]() { scheduleRepaint(mGraphicsItem.data()); });
   BI_Base::addToBoard(mGraphicsItem.data());
+  mBoard.schedulePlanesRebuild(getSceneOutline());
   mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
 
@@ -186,9 +205,16 @@ void BI_Via::removeFromBoard() {
   }
   disconnect(mHighlightChangedConnection);
   BI_Base::removeFromBoard(mGraphicsItem.data());
+  mBoard.schedulePlanesRebuild(getSceneOutline());
   mBoard.scheduleAirWiresRebuild(&getNetSignalOfNetSegment());
 }
 
+void BI_Via::createGraphicsItems() noexcept {
+  mGraphicsItem.reset(new BGI_Via(*this));
+  mGraphicsItem->setPos(mPosition.toPxQPointF());
+  registerGraphicsItem(*mGraphicsItem);
+}
+
 void BI_Via::registerNetLine(BI_NetLine& netline) {
   if ((!isAddedToBoard()) || (mRegisteredNetLines.contains(&netline)) ||
       (&netline.getNetSegment() != &mNetSegment)) {
@@ -196,7 +222,9 @@ void BI_Via::registerNetLine(BI_NetLine& netline) {
   }
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void BI_Via::unregisterNetLine(BI_NetLine& netline) {
@@ -205,7 +233,9 @@ void BI_Via::unregisterNetLine(BI_NetLine& netline) {
   }
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
-  mGraphicsItem->updateCacheAndRepaint();
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 void BI_Via::serialize(SExpression& root) const {
@@ -221,24 +251,28 @@ void BI_Via::serialize(SExpression& root) const {
  ******************************************************************************/
 
 QPainterPath BI_Via::getGrabAreaScenePx() const noexcept {
-  return mGraphicsItem->shape().translated(mPosition.toPxQPointF());
+  return mGraphicsItem
+      ? mGraphicsItem->shape().translated(mPosition.toPxQPointF())
+      : QPainterPath();
 }
 
 bool BI_Via::isSelectable() const noexcept {
-  return mGraphicsItem->isSelectable();
+  return mGraphicsItem && mGraphicsItem->isSelectable();
 }
 
 void BI_Via::setSelected(bool selected) noexcept {
   BI_Base::setSelected(selected);
-  mGraphicsItem->update();
+  scheduleRepaint(mGraphicsItem.data());
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void BI_Via::boardAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+void BI_Via::boardDesignRulesOrLayersChanged() {
+  if (mGraphicsItem) {
+    mGraphicsItem->updateCacheAndRepaint();
+  }
 }
 
 /*******************************************************************************
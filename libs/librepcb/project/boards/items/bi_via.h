@@ -29,6 +29,7 @@
 
 #include <librepcb/common/fileio/serializableobject.h>
 #include <librepcb/common/geometry/path.h>
+#include <librepcb/common/utils/memorypool.h>
 #include <librepcb/common/uuid.h>
 
 #include <QtCore>
@@ -48,7 +49,8 @@ namespace project {
  */
 class BI_Via final : public BI_Base,
                      public BI_NetLineAnchor,
-                     public SerializableObject {
+                     public SerializableObject,
+                     public PoolAllocated<BI_Via> {
   Q_OBJECT
 
 public:
@@ -90,6 +92,7 @@ public:
   // General Methods
   void addToBoard() override;
   void removeFromBoard() override;
+  void createGraphicsItems() noexcept override;
 
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
@@ -115,7 +118,7 @@ public:
 
 private:
   void init();
-  void boardAttributesChanged();
+  void boardDesignRulesOrLayersChanged();
 
   // General
   BI_NetSegment&          mNetSegment;
@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "viageometrycache.h"
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ViaGeometryCache::ViaGeometryCache() noexcept
+  : mMutex(), mOutlines(), mCopperAreas() {
+}
+
+ViaGeometryCache::~ViaGeometryCache() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+Path ViaGeometryCache::getOutline(BI_Via::Shape         shape,
+                                  const PositiveLength& size) noexcept {
+  OutlineKey   key(static_cast<int>(shape), *size);
+  QMutexLocker lock(&mMutex);
+  auto         it = mOutlines.constFind(key);
+  if (it != mOutlines.constEnd()) {
+    return *it;
+  }
+  Path outline = createOutline(shape, size);
+  outline.toQPainterPathPx();  // create it once for all copies
+  if (mOutlines.count() >= sMaxCount) {
+    mOutlines.clear();
+  }
+  mOutlines.insert(key, outline);
+  return outline;
+}
+
+QPainterPath ViaGeometryCache::getCopperPx(
+    BI_Via::Shape shape, const PositiveLength& size,
+    const PositiveLength& drill) noexcept {
+  CopperKey key(OutlineKey(static_cast<int>(shape), *size), *drill);
+  {
+    QMutexLocker lock(&mMutex);
+    auto         it = mCopperAreas.constFind(key);
+    if (it != mCopperAreas.constEnd()) {
+      return *it;
+    }
+  }
+  QPainterPath p = getOutline(shape, size).toQPainterPathPx();
+  p.setFillRule(Qt::OddEvenFill);  // important to subtract the hole!
+  p.addEllipse(QPointF(0, 0), drill->toPx() / 2, drill->toPx() / 2);
+  QMutexLocker lock(&mMutex);
+  if (mCopperAreas.count() >= sMaxCount) {
+    mCopperAreas.clear();
+  }
+  mCopperAreas.insert(key, p);
+  return p;
+}
+
+int ViaGeometryCache::getCount() const noexcept {
+  QMutexLocker lock(&mMutex);
+  return mOutlines.count() + mCopperAreas.count();
+}
+
+void ViaGeometryCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mOutlines.clear();
+  mCopperAreas.clear();
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+ViaGeometryCache& ViaGeometryCache::instance() noexcept {
+  static ViaGeometryCache cache;
+  return cache;
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+Path ViaGeometryCache::createOutline(BI_Via::Shape         shape,
+                                     const PositiveLength& size) noexcept {
+  switch (shape) {
+    case BI_Via::Shape::Round:
+      return Path::circle(size);
+    case BI_Via::Shape::Square:
+      return Path::centeredRect(size, size);
+    case BI_Via::Shape::Octagon:
+      return Path::octagon(size, size);
+    default:
+      Q_ASSERT(false);
+      return Path();
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,132 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_VIAGEOMETRYCACHE_H
+#define LIBREPCB_PROJECT_VIAGEOMETRYCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "items/bi_via.h"
+
+#include <librepcb/common/geometry/path.h>
+#include <librepcb/common/units/all_length_units.h>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Class ViaGeometryCache
+ ******************************************************************************/
+
+/**
+ * @brief Shared cache of the local geometry of vias
+ *
+ * Boards often contain thousands of vias (e.g. via stitching), but typically
+ * only very few distinct via sizes. This cache stores the outline and the
+ * painter paths of every distinct via geometry (relative to the via position)
+ * once, so all vias with the same geometry share the same (implicitly shared)
+ * data instead of building their own copies.
+ *
+ * Access to the cache is thread-safe since via outlines are also needed by
+ * worker threads (e.g. plane builder).
+ *
+ * @see librepcb::ClipperShapeCache
+ */
+class ViaGeometryCache final {
+public:
+  // Constructors / Destructor
+  ViaGeometryCache(const ViaGeometryCache& other) = delete;
+  ~ViaGeometryCache() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Get the outline of a via
+   *
+   * @param shape   The via shape.
+   * @param size    The outer size of the via (including any expansion).
+   *
+   * @return The outline relative to the via position. Its painter path is
+   *         already created and shared by all returned copies.
+   */
+  Path getOutline(BI_Via::Shape shape, const PositiveLength& size) noexcept;
+
+  /**
+   * @brief Get the copper area of a via as a painter path (in pixels)
+   *
+   * @param shape   The via shape.
+   * @param size    The outer size of the via (including any expansion).
+   * @param drill   The drill diameter of the via.
+   *
+   * @return The outline with the drill hole subtracted, relative to the via
+   *         position.
+   */
+  QPainterPath getCopperPx(BI_Via::Shape shape, const PositiveLength& size,
+                           const PositiveLength& drill) noexcept;
+
+  /**
+   * @brief Get the number of cached geometries
+   *
+   * @return Count of outlines and copper areas currently held by the cache.
+   */
+  int getCount() const noexcept;
+
+  /**
+   * @brief Remove all geometries from the cache
+   */
+  void clear() noexcept;
+
+  // Operator Overloadings
+  ViaGeometryCache& operator=(const ViaGeometryCache& rhs) = delete;
+
+  // Static Methods
+  static ViaGeometryCache& instance() noexcept;
+
+private:  // Methods
+  ViaGeometryCache() noexcept;
+  static Path createOutline(BI_Via::Shape         shape,
+                            const PositiveLength& size) noexcept;
+
+private:  // Data
+  typedef QPair<int, Length>        OutlineKey;  ///< Shape and size
+  typedef QPair<OutlineKey, Length> CopperKey;   ///< Outline and drill
+
+  /// Upper limit of cached geometries to avoid unbounded memory usage
+  static constexpr int sMaxCount = 1000;
+
+  mutable QMutex                 mMutex;
+  QHash<OutlineKey, Path>        mOutlines;
+  QHash<CopperKey, QPainterPath> mCopperAreas;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_VIAGEOMETRYCACHE_H
@@ -214,12 +214,7 @@ NetSignal* Circuit::getNetSignalByUuid(const Uuid& uuid) const noexcept {
 }
 
 NetSignal* Circuit::getNetSignalByName(const QString& name) const noexcept {
-  foreach (NetSignal* netsignal, mNetSignals) {
-    if (netsignal->getName() == name) {
-      return netsignal;
-    }
-  }
-  return nullptr;
+  return mNetSignalsByName.value(name, nullptr);
 }
 
 NetSignal* Circuit::getNetSignalWithMostElements() const noexcept {
@@ -253,6 +248,7 @@ void Circuit::addNetSignal(NetSignal& netsignal) {
   // add netsignal to circuit
   netsignal.addToCircuit();  // can throw
   mNetSignals.insert(netsignal.getUuid(), &netsignal);
+  mNetSignalsByName.insert(*netsignal.getName(), &netsignal);
   emit netSignalAdded(netsignal);
 }
 
@@ -264,6 +260,7 @@ void Circuit::removeNetSignal(NetSignal& netsignal) {
   // remove netsignal from circuit
   netsignal.removeFromCircuit();  // can throw
   mNetSignals.remove(netsignal.getUuid());
+  mNetSignalsByName.remove(*netsignal.getName());
   emit netSignalRemoved(netsignal);
 }
 
@@ -281,7 +278,10 @@ void Circuit::setNetSignalName(NetSignal&               netsignal,
                            .arg(*newName));
   }
   // apply the new name
+  const QString oldName = *netsignal.getName();
   netsignal.setName(newName, isAutoName);  // can throw
+  mNetSignalsByName.remove(oldName);
+  mNetSignalsByName.insert(*newName, &netsignal);
 }
 
 void Circuit::setHighlightedNetSignal(NetSignal* signal) noexcept {
@@ -312,10 +312,7 @@ ComponentInstance* Circuit::getComponentInstanceByUuid(const Uuid& uuid) const
 
 ComponentInstance* Circuit::getComponentInstanceByName(
     const QString& name) const noexcept {
-  foreach (ComponentInstance* compInstance, mComponentInstances) {
-    if (compInstance->getName() == name) return compInstance;
-  }
-  return nullptr;
+  return mComponentInstancesByName.value(name, nullptr);
 }
 
 void Circuit::addComponentInstance(ComponentInstance& cmp) {
@@ -338,6 +335,7 @@ void Circuit::addComponentInstance(ComponentInstance& cmp) {
   // add to circuit
   cmp.addToCircuit();  // can throw
   mComponentInstances.insert(cmp.getUuid(), &cmp);
+  mComponentInstancesByName.insert(*cmp.getName(), &cmp);
   emit componentAdded(cmp);
 }
 
@@ -349,6 +347,7 @@ void Circuit::removeComponentInstance(ComponentInstance& cmp) {
   // remove from circuit
   cmp.removeFromCircuit();  // can throw
   mComponentInstances.remove(cmp.getUuid());
+  mComponentInstancesByName.remove(*cmp.getName());
   emit componentRemoved(cmp);
 }
 
@@ -365,7 +364,10 @@ void Circuit::setComponentInstanceName(ComponentInstance&       cmp,
         tr("There is already a component with the name \"%1\"!").arg(*newName));
   }
   // apply the new name
+  const QString oldName = *cmp.getName();
   cmp.setName(newName);  // can throw
+  mComponentInstancesByName.remove(oldName);
+  mComponentInstancesByName.insert(*newName, &cmp);
 }
 
 /*******************************************************************************
@@ -150,6 +150,11 @@ private:
   QMap<Uuid, NetClass*>          mNetClasses;
   QMap<Uuid, NetSignal*>         mNetSignals;
   QMap<Uuid, ComponentInstance*> mComponentInstances;
+
+  // Name indices for fast lookups, kept in sync by the add/remove/set name
+  // methods (names of added objects must only be changed through them!)
+  QHash<QString, NetSignal*>         mNetSignalsByName;
+  QHash<QString, ComponentInstance*> mComponentInstancesByName;
 };
 
 /*******************************************************************************
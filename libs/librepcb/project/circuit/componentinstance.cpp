@@ -24,6 +24,7 @@
 
 #include "../boards/items/bi_device.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
 #include "../library/projectlibrary.h"
 #include "../project.h"
 #include "../schematics/items/si_symbol.h"
@@ -140,7 +141,6 @@ void ComponentInstance::init() {
   mErcMsgUnplacedOptionalSymbols.reset(new ErcMsg(
       mCircuit.getProject(), *this, mUuid.toStr(), "UnplacedOptionalSymbols",
       ErcMsg::ErcMsgType_t::SchematicWarning));
-  updateErcMessages();
 
   // emit the "attributesChanged" signal when the project has emited it
   connect(&mCircuit.getProject(), &Project::attributesChanged, this,
@@ -152,6 +152,7 @@ void ComponentInstance::init() {
 ComponentInstance::~ComponentInstance() noexcept {
   Q_ASSERT(!mIsAddedToCircuit);
   Q_ASSERT(!isUsed());
+  mCircuit.getProject().getErcMsgList().unscheduleUpdate(*this);
 
   qDeleteAll(mSignals);
   mSignals.clear();
@@ -222,7 +223,7 @@ bool ComponentInstance::isUsed() const noexcept {
 void ComponentInstance::setName(const CircuitIdentifier& name) noexcept {
   if (name != mName) {
     mName = name;
-    updateErcMessages();
+    scheduleErcMessagesUpdate();
     emit attributesChanged();
   }
 }
@@ -264,7 +265,7 @@ void ComponentInstance::addToCircuit() {
     sgl.add([signal]() { signal->removeFromCircuit(); });
   }
   mIsAddedToCircuit = true;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
   sgl.dismiss();
 }
 
@@ -284,7 +285,7 @@ void ComponentInstance::removeFromCircuit() {
     sgl.add([signal]() { signal->addToCircuit(); });
   }
   mIsAddedToCircuit = false;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
   sgl.dismiss();
 }
 
@@ -318,7 +319,7 @@ void ComponentInstance::registerSymbol(SI_Symbol& symbol) {
     }
   }
   mRegisteredSymbols.insert(itemUuid, &symbol);
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void ComponentInstance::unregisterSymbol(SI_Symbol& symbol) {
@@ -328,7 +329,7 @@ void ComponentInstance::unregisterSymbol(SI_Symbol& symbol) {
     throw LogicError(__FILE__, __LINE__);
   }
   mRegisteredSymbols.remove(itemUuid);
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void ComponentInstance::registerDevice(BI_Device& device) {
@@ -338,7 +339,7 @@ void ComponentInstance::registerDevice(BI_Device& device) {
     throw LogicError(__FILE__, __LINE__);
   }
   mRegisteredDevices.append(&device);
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
   emit attributesChanged();  // parent attribute provider may have changed!
 }
 
@@ -347,7 +348,7 @@ void ComponentInstance::unregisterDevice(BI_Device& device) {
     throw LogicError(__FILE__, __LINE__);
   }
   mRegisteredDevices.removeOne(&device);
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
   emit attributesChanged();  // parent attribute provider may have changed!
 }
 
@@ -408,6 +409,10 @@ bool ComponentInstance::checkAttributesValidity() const noexcept {
   return true;
 }
 
+void ComponentInstance::scheduleErcMessagesUpdate() noexcept {
+  mCircuit.getProject().getErcMsgList().scheduleUpdate(*this);
+}
+
 void ComponentInstance::updateErcMessages() noexcept {
   int required = getUnplacedRequiredSymbolsCount();
   int optional = getUnplacedOptionalSymbolsCount();
@@ -177,7 +177,8 @@ signals:
 private:
   void               init();
   bool               checkAttributesValidity() const noexcept;
-  void               updateErcMessages() noexcept;
+  void               scheduleErcMessagesUpdate() noexcept;
+  void               updateErcMessages() noexcept override;
   const QStringList& getLocaleOrder() const noexcept;
 
   // General
@@ -24,6 +24,7 @@
 
 #include "../boards/items/bi_footprintpad.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
 #include "../project.h"
 #include "../schematics/items/si_symbolpin.h"
 #include "../settings/projectsettings.h"
@@ -104,11 +105,10 @@ void ComponentSignalInstance::init() {
                      .arg(mComponentSignal->getUuid().toStr()),
                  "ForcedNetSignalNameConflict",
                  ErcMsg::ErcMsgType_t::SchematicError, QString()));
-  updateErcMessages();
 
   // register to component attributes changed
   connect(&mComponentInstance, &ComponentInstance::attributesChanged, this,
-          &ComponentSignalInstance::updateErcMessages);
+          &ComponentSignalInstance::scheduleErcMessagesUpdate);
 
   // register to net signal name changed
   if (mNetSignal) {
@@ -123,6 +123,7 @@ ComponentSignalInstance::~ComponentSignalInstance() noexcept {
   Q_ASSERT(!mIsAddedToCircuit);
   Q_ASSERT(!isUsed());
   Q_ASSERT(!arePinsOrPadsUsed());
+  mCircuit.getProject().getErcMsgList().unscheduleUpdate(*this);
 }
 
 /*******************************************************************************
@@ -200,7 +201,7 @@ void ComponentSignalInstance::setNetSignal(NetSignal* netsignal) {
   }
   NetSignal* old = mNetSignal;
   mNetSignal     = netsignal;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
   sgl.dismiss();
   emit netSignalChanged(old, mNetSignal);
 }
@@ -217,7 +218,7 @@ void ComponentSignalInstance::addToCircuit() {
     mNetSignal->registerComponentSignal(*this);  // can throw
   }
   mIsAddedToCircuit = true;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void ComponentSignalInstance::removeFromCircuit() {
@@ -234,7 +235,7 @@ void ComponentSignalInstance::removeFromCircuit() {
     mNetSignal->unregisterComponentSignal(*this);  // can throw
   }
   mIsAddedToCircuit = false;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void ComponentSignalInstance::registerSymbolPin(SI_SymbolPin& pin) {
@@ -293,7 +294,11 @@ bool ComponentSignalInstance::checkAttributesValidity() const noexcept {
 void ComponentSignalInstance::netSignalNameChanged(
     const CircuitIdentifier& newName) noexcept {
   Q_UNUSED(newName);
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
+}
+
+void ComponentSignalInstance::scheduleErcMessagesUpdate() noexcept {
+  mCircuit.getProject().getErcMsgList().scheduleUpdate(*this);
 }
 
 void ComponentSignalInstance::updateErcMessages() noexcept {
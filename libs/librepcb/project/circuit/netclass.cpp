@@ -23,6 +23,8 @@
 #include "netclass.h"
 
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
+#include "../project.h"
 #include "circuit.h"
 #include "netsignal.h"
 
@@ -59,6 +61,7 @@ NetClass::NetClass(Circuit& circuit, const ElementName& name)
 NetClass::~NetClass() noexcept {
   Q_ASSERT(!mIsAddedToCircuit);
   Q_ASSERT(!isUsed());
+  mCircuit.getProject().getErcMsgList().unscheduleUpdate(*this);
 }
 
 /*******************************************************************************
@@ -70,7 +73,7 @@ void NetClass::setName(const ElementName& name) noexcept {
     return;
   }
   mName = name;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 /*******************************************************************************
@@ -82,7 +85,7 @@ void NetClass::addToCircuit() {
     throw LogicError(__FILE__, __LINE__);
   }
   mIsAddedToCircuit = true;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void NetClass::removeFromCircuit() {
@@ -96,7 +99,7 @@ void NetClass::removeFromCircuit() {
                            .arg(*mName));
   }
   mIsAddedToCircuit = false;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void NetClass::registerNetSignal(NetSignal& signal) {
@@ -106,7 +109,7 @@ void NetClass::registerNetSignal(NetSignal& signal) {
     throw LogicError(__FILE__, __LINE__);
   }
   mRegisteredNetSignals.insert(signal.getUuid(), &signal);
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void NetClass::unregisterNetSignal(NetSignal& signal) {
@@ -115,7 +118,7 @@ void NetClass::unregisterNetSignal(NetSignal& signal) {
     throw LogicError(__FILE__, __LINE__);
   }
   mRegisteredNetSignals.remove(signal.getUuid());
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void NetClass::serialize(SExpression& root) const {
@@ -127,6 +130,10 @@ void NetClass::serialize(SExpression& root) const {
  *  Private Methods
  ******************************************************************************/
 
+void NetClass::scheduleErcMessagesUpdate() noexcept {
+  mCircuit.getProject().getErcMsgList().scheduleUpdate(*this);
+}
+
 void NetClass::updateErcMessages() noexcept {
   if (mIsAddedToCircuit && (!isUsed())) {
     if (!mErcMsgUnusedNetClass) {
@@ -88,7 +88,8 @@ public:
   NetClass& operator=(const NetClass& rhs) = delete;
 
 private:
-  void updateErcMessages() noexcept;
+  void scheduleErcMessagesUpdate() noexcept;
+  void updateErcMessages() noexcept override;
 
   // General
   Circuit& mCircuit;
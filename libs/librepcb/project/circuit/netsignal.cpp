@@ -25,6 +25,8 @@
 #include "../boards/items/bi_netsegment.h"
 #include "../boards/items/bi_plane.h"
 #include "../erc/ercmsg.h"
+#include "../erc/ercmsglist.h"
+#include "../project.h"
 #include "../schematics/items/si_netsegment.h"
 #include "circuit.h"
 #include "componentinstance.h"
@@ -42,6 +44,33 @@
 namespace librepcb {
 namespace project {
 
+/*******************************************************************************
+ *  Helpers
+ ******************************************************************************/
+
+// Registered elements are stored in a list (for iteration) plus a hash of
+// their list indices, so registering and unregistering an element takes
+// constant time. This matters when combining or splitting big nets, which
+// moves thousands of elements from one net signal to another.
+template <typename T>
+static void registerElement(QList<T*>& list, QHash<const T*, int>& indices,
+                            T& element) noexcept {
+  indices.insert(&element, list.count());
+  list.append(&element);
+}
+
+template <typename T>
+static void unregisterElement(QList<T*>& list, QHash<const T*, int>& indices,
+                              T& element) noexcept {
+  // move the last element into the gap to avoid shifting the whole list
+  int index = indices.take(&element);
+  T*  last  = list.takeLast();
+  if (last != &element) {
+    list[index] = last;
+    indices.insert(last, index);
+  }
+}
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -54,7 +83,8 @@ NetSignal::NetSignal(Circuit& circuit, const SExpression& node)
     mUuid(node.getChildByIndex(0).getValue<Uuid>()),
     mName(node.getValueByPath<CircuitIdentifier>("name", true)),
     mHasAutoName(node.getValueByPath<bool>("auto")),
-    mNetClass(nullptr) {
+    mNetClass(nullptr),
+    mRealComponentSignalCount(0) {
   Uuid netclassUuid = node.getValueByPath<Uuid>("netclass");
   mNetClass         = circuit.getNetClassByUuid(netclassUuid);
   if (!mNetClass) {
@@ -75,13 +105,15 @@ NetSignal::NetSignal(Circuit& circuit, NetClass& netclass,
     mUuid(Uuid::createRandom()),
     mName(name),
     mHasAutoName(autoName),
-    mNetClass(&netclass) {
+    mNetClass(&netclass),
+    mRealComponentSignalCount(0) {
   if (!checkAttributesValidity()) throw LogicError(__FILE__, __LINE__);
 }
 
 NetSignal::~NetSignal() noexcept {
   Q_ASSERT(!mIsAddedToCircuit);
   Q_ASSERT(!isUsed());
+  mCircuit.getProject().getErcMsgList().unscheduleUpdate(*this);
 }
 
 /*******************************************************************************
@@ -121,7 +153,7 @@ void NetSignal::setName(const CircuitIdentifier& name,
   }
   mName        = name;
   mHasAutoName = isAutoName;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
   emit nameChanged(mName);
 }
 
@@ -142,7 +174,7 @@ void NetSignal::addToCircuit() {
   }
   mNetClass->registerNetSignal(*this);  // can throw
   mIsAddedToCircuit = true;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::removeFromCircuit() {
@@ -157,80 +189,89 @@ void NetSignal::removeFromCircuit() {
   }
   mNetClass->unregisterNetSignal(*this);  // can throw
   mIsAddedToCircuit = false;
-  updateErcMessages();
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerComponentSignal(ComponentSignalInstance& signal) {
-  if ((!mIsAddedToCircuit) || (mRegisteredComponentSignals.contains(&signal)) ||
+  if ((!mIsAddedToCircuit) || (mComponentSignalIndices.contains(&signal)) ||
       (signal.getCircuit() != mCircuit)) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mRegisteredComponentSignals.append(&signal);
-  updateErcMessages();
+  registerElement(mRegisteredComponentSignals, mComponentSignalIndices, signal);
+  if (!signal.getComponentInstance().getLibComponent().isSchematicOnly()) {
+    ++mRealComponentSignalCount;
+  }
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterComponentSignal(ComponentSignalInstance& signal) {
-  if ((!mIsAddedToCircuit) ||
-      (!mRegisteredComponentSignals.contains(&signal))) {
+  if ((!mIsAddedToCircuit) || (!mComponentSignalIndices.contains(&signal))) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mRegisteredComponentSignals.removeOne(&signal);
-  updateErcMessages();
+  unregisterElement(mRegisteredComponentSignals, mComponentSignalIndices,
+                    signal);
+  if (!signal.getComponentInstance().getLibComponent().isSchematicOnly()) {
+    --mRealComponentSignalCount;
+  }
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerSchematicNetSegment(SI_NetSegment& netsegment) {
   if ((!mIsAddedToCircuit) ||
-      (mRegisteredSchematicNetSegments.contains(&netsegment)) ||
+      (mSchematicNetSegmentIndices.contains(&netsegment)) ||
       (netsegment.getCircuit() != mCircuit)) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mRegisteredSchematicNetSegments.append(&netsegment);
-  updateErcMessages();
+  registerElement(mRegisteredSchematicNetSegments, mSchematicNetSegmentIndices,
+                  netsegment);
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterSchematicNetSegment(SI_NetSegment& netsegment) {
   if ((!mIsAddedToCircuit) ||
-      (!mRegisteredSchematicNetSegments.contains(&netsegment))) {
+      (!mSchematicNetSegmentIndices.contains(&netsegment))) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mRegisteredSchematicNetSegments.removeOne(&netsegment);
-  updateErcMessages();
+  unregisterElement(mRegisteredSchematicNetSegments,
+                    mSchematicNetSegmentIndices, netsegment);
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerBoardNetSegment(BI_NetSegment& netsegment) {
-  if ((!mIsAddedToCircuit) ||
-      (mRegisteredBoardNetSegments.contains(&netsegment)) ||
+  if ((!mIsAddedToCircuit) || (mBoardNetSegmentIndices.contains(&netsegment)) ||
       (netsegment.getCircuit() != mCircuit)) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mRegisteredBoardNetSegments.append(&netsegment);
-  updateErcMessages();
+  registerElement(mRegisteredBoardNetSegments, mBoardNetSegmentIndices,
+                  netsegment);
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterBoardNetSegment(BI_NetSegment& netsegment) {
   if ((!mIsAddedToCircuit) ||
-      (!mRegisteredBoardNetSegments.contains(&netsegment))) {
+      (!mBoardNetSegmentIndices.contains(&netsegment))) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mRegisteredBoardNetSegments.removeOne(&netsegment);
-  updateErcMessages();
+  unregisterElement(mRegisteredBoardNetSegments, mBoardNetSegmentIndices,
+                    netsegment);
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::registerBoardPlane(BI_Plane& plane) {
-  if ((!mIsAddedToCircuit) || (mRegisteredBoardPlanes.contains(&plane)) ||
+  if ((!mIsAddedToCircuit) || (mBoardPlaneIndices.contains(&plane)) ||
       (plane.getCircuit() != mCircuit)) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mRegisteredBoardPlanes.append(&plane);
-  updateErcMessages();
+  registerElement(mRegisteredBoardPlanes, mBoardPlaneIndices, plane);
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::unregisterBoardPlane(BI_Plane& plane) {
-  if ((!mIsAddedToCircuit) || (!mRegisteredBoardPlanes.contains(&plane))) {
+  if ((!mIsAddedToCircuit) || (!mBoardPlaneIndices.contains(&plane))) {
     throw LogicError(__FILE__, __LINE__);
   }
-  mRegisteredBoardPlanes.removeOne(&plane);
-  updateErcMessages();
+  unregisterElement(mRegisteredBoardPlanes, mBoardPlaneIndices, plane);
+  scheduleErcMessagesUpdate();
 }
 
 void NetSignal::serialize(SExpression& root) const {
@@ -251,6 +292,10 @@ bool NetSignal::checkAttributesValidity() const noexcept {
   return true;
 }
 
+void NetSignal::scheduleErcMessagesUpdate() noexcept {
+  mCircuit.getProject().getErcMsgList().scheduleUpdate(*this);
+}
+
 void NetSignal::updateErcMessages() noexcept {
   if (mIsAddedToCircuit && (!isUsed())) {
     if (!mErcMsgUnusedNetSignal) {
@@ -268,13 +313,7 @@ void NetSignal::updateErcMessages() noexcept {
   // signals. But do not count component signals of schematic-only components
   // since these are just "virtual" connections, i.e. not represented by a
   // real pad (see https://github.com/LibrePCB/LibrePCB/issues/739).
-  int registeredRealComponentCount = 0;
-  foreach (ComponentSignalInstance* signal, mRegisteredComponentSignals) {
-    if (!signal->getComponentInstance().getLibComponent().isSchematicOnly()) {
-      registeredRealComponentCount++;
-    }
-  }
-  if (mIsAddedToCircuit && (registeredRealComponentCount < 2)) {
+  if (mIsAddedToCircuit && (mRealComponentSignalCount < 2)) {
     if (!mErcMsgConnectedToLessThanTwoPins) {
       mErcMsgConnectedToLessThanTwoPins.reset(new ErcMsg(
           mCircuit.getProject(), *this, mUuid.toStr(),
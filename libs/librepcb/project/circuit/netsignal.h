@@ -75,7 +75,7 @@ public:
   NetClass&                getNetClass() const noexcept { return *mNetClass; }
   bool isHighlighted() const noexcept { return mIsHighlighted; }
 
-  // Getters: General
+  // Getters: General (the order of registered elements is not stable)
   Circuit& getCircuit() const noexcept { return mCircuit; }
   const QList<ComponentSignalInstance*>& getComponentSignals() const noexcept {
     return mRegisteredComponentSignals;
@@ -125,7 +125,8 @@ signals:
 
 private:
   bool checkAttributesValidity() const noexcept;
-  void updateErcMessages() noexcept;
+  void scheduleErcMessagesUpdate() noexcept;
+  void updateErcMessages() noexcept override;
 
   // General
   Circuit& mCircuit;
@@ -144,6 +145,17 @@ private:
   QList<BI_NetSegment*>           mRegisteredBoardNetSegments;
   QList<BI_Plane*>                mRegisteredBoardPlanes;
 
+  // Indices of the registered elements in the lists above, for constant time
+  // lookups and removals
+  QHash<const ComponentSignalInstance*, int> mComponentSignalIndices;
+  QHash<const SI_NetSegment*, int>           mSchematicNetSegmentIndices;
+  QHash<const BI_NetSegment*, int>           mBoardNetSegmentIndices;
+  QHash<const BI_Plane*, int>                mBoardPlaneIndices;
+
+  /// Count of registered component signals which don't belong to
+  /// schematic-only components, i.e. which are represented by real pads
+  int mRealComponentSignalCount;
+
   // ERC Messages
   /// @brief the ERC message for unused netsignals
   QScopedPointer<ErcMsg> mErcMsgUnusedNetSignal;
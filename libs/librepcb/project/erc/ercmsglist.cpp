@@ -42,10 +42,14 @@ namespace project {
 
 ErcMsgList::ErcMsgList(Project& project)
   : QObject(&project), mProject(project) {
+  mFlushTimer.setSingleShot(true);
+  mFlushTimer.setInterval(0);
+  connect(&mFlushTimer, &QTimer::timeout, this, &ErcMsgList::flush);
 }
 
 ErcMsgList::~ErcMsgList() noexcept {
   Q_ASSERT(mItems.isEmpty());
+  Q_ASSERT(mScheduledUpdates.isEmpty());
 }
 
 /*******************************************************************************
@@ -57,7 +61,13 @@ void ErcMsgList::add(ErcMsg* ercMsg) noexcept {
   Q_ASSERT(!mItems.contains(ercMsg));
   Q_ASSERT(!ercMsg->isIgnored());
   mItems.append(ercMsg);
-  emit ercMsgAdded(ercMsg);
+  auto it = mPendingChanges.find(ercMsg);
+  if ((it != mPendingChanges.end()) && (it.value() == Change::Removed)) {
+    it.value() = Change::Changed;  // still listed by the listeners
+  } else {
+    mPendingChanges.insert(ercMsg, Change::Added);
+  }
+  scheduleFlush();
 }
 
 void ErcMsgList::remove(ErcMsg* ercMsg) noexcept {
@@ -65,14 +75,69 @@ void ErcMsgList::remove(ErcMsg* ercMsg) noexcept {
   Q_ASSERT(mItems.contains(ercMsg));
   Q_ASSERT(!ercMsg->isIgnored());
   mItems.removeOne(ercMsg);
-  emit ercMsgRemoved(ercMsg);
+  if (mPendingChanges.value(ercMsg, Change::Changed) == Change::Added) {
+    mPendingChanges.remove(ercMsg);  // listeners never got to know it
+  } else {
+    mPendingChanges.insert(ercMsg, Change::Removed);
+  }
+  scheduleFlush();
 }
 
 void ErcMsgList::update(ErcMsg* ercMsg) noexcept {
   Q_ASSERT(ercMsg);
   Q_ASSERT(mItems.contains(ercMsg));
   Q_ASSERT(ercMsg->isVisible());
-  emit ercMsgChanged(ercMsg);
+  if (!mPendingChanges.contains(ercMsg)) {
+    mPendingChanges.insert(ercMsg, Change::Changed);
+  }
+  scheduleFlush();
+}
+
+void ErcMsgList::scheduleUpdate(IF_ErcMsgProvider& provider) noexcept {
+  if (!mScheduledUpdatesSet.contains(&provider)) {
+    mScheduledUpdatesSet.insert(&provider);
+    mScheduledUpdates.append(&provider);
+    scheduleFlush();
+  }
+}
+
+void ErcMsgList::unscheduleUpdate(IF_ErcMsgProvider& provider) noexcept {
+  if (mScheduledUpdatesSet.remove(&provider)) {
+    mScheduledUpdates.removeOne(&provider);
+  }
+}
+
+void ErcMsgList::flush() noexcept {
+  mFlushTimer.stop();
+
+  // Evaluate the scheduled objects. This might schedule further objects, so
+  // don't iterate over a copy of the list.
+  while (!mScheduledUpdates.isEmpty()) {
+    IF_ErcMsgProvider* provider = mScheduledUpdates.takeFirst();
+    mScheduledUpdatesSet.remove(provider);
+    provider->updateErcMessages();
+  }
+
+  // Notify listeners.
+  if (!mPendingChanges.isEmpty()) {
+    QList<ErcMsg*> added, removed, changed;
+    for (auto it = mPendingChanges.constBegin();
+         it != mPendingChanges.constEnd(); ++it) {
+      switch (it.value()) {
+        case Change::Added:
+          added.append(it.key());
+          break;
+        case Change::Removed:
+          removed.append(it.key());
+          break;
+        default:
+          changed.append(it.key());
+          break;
+      }
+    }
+    mPendingChanges.clear();
+    emit ercMsgsChanged(added, removed, changed);
+  }
 }
 
 void ErcMsgList::restoreIgnoreState() {
@@ -102,6 +167,7 @@ void ErcMsgList::restoreIgnoreState() {
 }
 
 void ErcMsgList::save() {
+  flush();  // make sure all messages are up to date
   SExpression doc(serializeToDomElement("librepcb_erc"));  // can throw
   mProject.getDirectory().write("circuit/erc.lp",
                                 doc.toByteArray());  // can throw
@@ -111,6 +177,12 @@ void ErcMsgList::save() {
  *  Private Methods
  ******************************************************************************/
 
+void ErcMsgList::scheduleFlush() noexcept {
+  if (!mFlushTimer.isActive()) {
+    mFlushTimer.start();
+  }
+}
+
 void ErcMsgList::serialize(SExpression& root) const {
   foreach (ErcMsg* ercMsg, mItems) {
     if (ercMsg->isIgnored()) {
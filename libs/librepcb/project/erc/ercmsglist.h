@@ -37,6 +37,7 @@ namespace project {
 
 class Project;
 class ErcMsg;
+class IF_ErcMsgProvider;
 
 /*******************************************************************************
  *  Class ErcMsgList
@@ -45,6 +46,13 @@ class ErcMsg;
 /**
  * @brief The ErcMsgList class contains a list of ERC messages which are visible
  * for the user
+ *
+ * To avoid evaluating the ERC state of an object again and again while many
+ * items get registered to it (e.g. during loading a project or bulk edits),
+ * objects schedule the update of their messages with #scheduleUpdate(). All
+ * scheduled updates are evaluated once when control returns to the event loop
+ * (or by calling #flush() explicitly), and listeners get notified about all
+ * changes with a single #ercMsgsChanged() signal.
  */
 class ErcMsgList final : public QObject, public SerializableObject {
   Q_OBJECT
@@ -63,6 +71,23 @@ public:
   void add(ErcMsg* ercMsg) noexcept;
   void remove(ErcMsg* ercMsg) noexcept;
   void update(ErcMsg* ercMsg) noexcept;
+
+  /**
+   * @brief Schedule IF_ErcMsgProvider::updateErcMessages() of an object
+   *
+   * Scheduling the same object multiple times evaluates it only once.
+   *
+   * @param provider  The object whose ERC messages are outdated. It must call
+   *                  #unscheduleUpdate() when it gets destroyed.
+   */
+  void scheduleUpdate(IF_ErcMsgProvider& provider) noexcept;
+  void unscheduleUpdate(IF_ErcMsgProvider& provider) noexcept;
+
+  /**
+   * @brief Evaluate all scheduled updates and notify listeners immediately
+   */
+  void flush() noexcept;
+
   void restoreIgnoreState();
   void save();
 
@@ -71,19 +96,41 @@ public:
 
 signals:
 
-  void ercMsgAdded(ErcMsg* ercMsg);
-  void ercMsgRemoved(ErcMsg* ercMsg);
-  void ercMsgChanged(ErcMsg* ercMsg);
+  /**
+   * @brief All changes of the list since the last emission of this signal
+   *
+   * Messages which were added and removed again in the meantime are not
+   * reported at all.
+   *
+   * @param added     Newly visible messages
+   * @param removed   Messages which are no longer visible. They may already be
+   *                  destroyed, so these pointers must not be dereferenced.
+   * @param changed   Visible messages whose text or ignore state changed
+   */
+  void ercMsgsChanged(const QList<ErcMsg*>& added,
+                      const QList<ErcMsg*>& removed,
+                      const QList<ErcMsg*>& changed);
 
 private:  // Methods
+  void scheduleFlush() noexcept;
+
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
 
+private:  // Data
+  enum class Change { Added, Removed, Changed };
+
   // General
   Project& mProject;
+  QTimer   mFlushTimer;
 
   // Misc
   QList<ErcMsg*> mItems;  ///< contains all visible ERC messages
+
+  // Deferred Evaluation
+  QList<IF_ErcMsgProvider*> mScheduledUpdates;     ///< In order of scheduling
+  QSet<IF_ErcMsgProvider*>  mScheduledUpdatesSet;  ///< For fast lookups
+  QHash<ErcMsg*, Change>    mPendingChanges;       ///< Not yet emitted
 };
 
 /*******************************************************************************
@@ -64,6 +64,14 @@ public:
 
   // Getters
   virtual const char* getErcMsgOwnerClassName() const noexcept = 0;
+
+  /**
+   * @brief Update the ERC messages of this object
+   *
+   * Called by librepcb::project::ErcMsgList for objects which scheduled an
+   * update with librepcb::project::ErcMsgList::scheduleUpdate().
+   */
+  virtual void updateErcMessages() noexcept {}
 };
 
 /*******************************************************************************
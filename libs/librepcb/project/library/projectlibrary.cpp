@@ -53,11 +53,12 @@ ProjectLibrary::ProjectLibrary(
   qDebug() << "load project library...";
 
   try {
-    // Load all library elements
-    loadElements<Symbol>("sym", "symbols", mSymbols);
-    loadElements<Package>("pkg", "packages", mPackages);
-    loadElements<Component>("cmp", "components", mComponents);
-    loadElements<Device>("dev", "devices", mDevices);
+    // Index all library elements, they are loaded on first access
+    indexElements<Symbol>("sym", "symbols", mSymbols, mPendingSymbols);
+    indexElements<Package>("pkg", "packages", mPackages, mPendingPackages);
+    indexElements<Component>("cmp", "components", mComponents,
+                             mPendingComponents);
+    indexElements<Device>("dev", "devices", mDevices, mPendingDevices);
   } catch (const Exception&) {
     qDeleteAll(mAllElements);
     mAllElements.clear();
@@ -74,6 +75,55 @@ ProjectLibrary::~ProjectLibrary() noexcept {
   mElementsToUpgrade.clear();
 }
 
+/*******************************************************************************
+ *  Getters: Library Elements
+ ******************************************************************************/
+
+const QHash<Uuid, library::Symbol*>& ProjectLibrary::getSymbols() const
+    noexcept {
+  loadPendingElements(mSymbols, mPendingSymbols);
+  return mSymbols;
+}
+
+const QHash<Uuid, library::Package*>& ProjectLibrary::getPackages() const
+    noexcept {
+  loadPendingElements(mPackages, mPendingPackages);
+  return mPackages;
+}
+
+const QHash<Uuid, library::Component*>& ProjectLibrary::getComponents() const
+    noexcept {
+  loadPendingElements(mComponents, mPendingComponents);
+  return mComponents;
+}
+
+const QHash<Uuid, library::Device*>& ProjectLibrary::getDevices() const
+    noexcept {
+  loadPendingElements(mDevices, mPendingDevices);
+  return mDevices;
+}
+
+/*******************************************************************************
+ *  Getters: Single Library Elements
+ ******************************************************************************/
+
+library::Symbol* ProjectLibrary::getSymbol(const Uuid& uuid) const noexcept {
+  return getElement(uuid, mSymbols, mPendingSymbols);
+}
+
+library::Package* ProjectLibrary::getPackage(const Uuid& uuid) const noexcept {
+  return getElement(uuid, mPackages, mPendingPackages);
+}
+
+library::Component* ProjectLibrary::getComponent(const Uuid& uuid) const
+    noexcept {
+  return getElement(uuid, mComponents, mPendingComponents);
+}
+
+library::Device* ProjectLibrary::getDevice(const Uuid& uuid) const noexcept {
+  return getElement(uuid, mDevices, mPendingDevices);
+}
+
 /*******************************************************************************
  *  Getters: Special Queries
  ******************************************************************************/
@@ -81,7 +131,7 @@ ProjectLibrary::~ProjectLibrary() noexcept {
 QHash<Uuid, library::Device*> ProjectLibrary::getDevicesOfComponent(
     const Uuid& compUuid) const noexcept {
   QHash<Uuid, library::Device*> list;
-  foreach (library::Device* device, mDevices) {
+  foreach (library::Device* device, getDevices()) {
     if (device->getComponentUuid() == compUuid) {
       list.insert(device->getUuid(), device);
     }
@@ -94,19 +144,19 @@ QHash<Uuid, library::Device*> ProjectLibrary::getDevicesOfComponent(
  ******************************************************************************/
 
 void ProjectLibrary::addSymbol(library::Symbol& s) {
-  addElement<Symbol>(s, mSymbols);
+  addElement<Symbol>(s, mSymbols, mPendingSymbols);
 }
 
 void ProjectLibrary::addPackage(library::Package& p) {
-  addElement<Package>(p, mPackages);
+  addElement<Package>(p, mPackages, mPendingPackages);
 }
 
 void ProjectLibrary::addComponent(library::Component& c) {
-  addElement<Component>(c, mComponents);
+  addElement<Component>(c, mComponents, mPendingComponents);
 }
 
 void ProjectLibrary::addDevice(library::Device& d) {
-  addElement<Device>(d, mDevices);
+  addElement<Device>(d, mDevices, mPendingDevices);
 }
 
 void ProjectLibrary::removeSymbol(library::Symbol& s) {
@@ -131,7 +181,11 @@ void ProjectLibrary::removeDevice(library::Device& d) {
 
 void ProjectLibrary::save() {
   // Save library elements to enforce a file format upgrade, but only once for
-  // optimal performance.
+  // optimal performance. Thus all elements need to be loaded now.
+  loadPendingElements(mSymbols, mPendingSymbols);
+  loadPendingElements(mPackages, mPendingPackages);
+  loadPendingElements(mComponents, mPendingComponents);
+  loadPendingElements(mDevices, mPendingDevices);
   foreach (LibraryBaseElement* element, mElementsToUpgrade) {
     element->save();  // can throw
     mElementsToUpgrade.remove(element);
@@ -143,44 +197,102 @@ void ProjectLibrary::save() {
  ******************************************************************************/
 
 template <typename ElementType>
-void ProjectLibrary::loadElements(const QString& dirname, const QString& type,
-                                  QHash<Uuid, ElementType*>& elementList) {
+void ProjectLibrary::indexElements(const QString& dirname, const QString& type,
+                                   QHash<Uuid, ElementType*>& elementList,
+                                   QHash<Uuid, QString>&      pendingList) {
   // search all subdirectories which have a valid UUID as directory name
   foreach (const QString& sub, mDirectory->getDirs(dirname)) {
-    std::unique_ptr<TransactionalDirectory> dir(
-        new TransactionalDirectory(*mDirectory, dirname % "/" % sub));
+    QString                path = dirname % "/" % sub;
+    TransactionalDirectory dir(*mDirectory, path);
 
     // check if directory is a valid library element
-    if (!LibraryBaseElement::isValidElementDirectory<ElementType>(*dir, "")) {
+    if (!LibraryBaseElement::isValidElementDirectory<ElementType>(dir, "")) {
       qWarning() << "Found an invalid directory in the library:"
-                 << dir->getAbsPath().toNative();
+                 << dir.getAbsPath().toNative();
       continue;
     }
 
-    // load the library element
-    QScopedPointer<ElementType> element(
-        new ElementType(std::move(dir)));  // can throw
-    if (elementList.contains(element->getUuid())) {
+    // Elements are stored in directories named by their UUID, so they don't
+    // need to be loaded yet. Only if the directory was renamed (which should
+    // not happen), the element needs to be loaded to get its UUID.
+    tl::optional<Uuid> uuid = Uuid::tryFromString(sub);
+    if (uuid && (!pendingList.contains(*uuid)) &&
+        (!elementList.contains(*uuid))) {
+      pendingList.insert(*uuid, path);
+      continue;
+    }
+    std::unique_ptr<ElementType> element =
+        loadElement<ElementType>(path);  // can throw
+    if (elementList.contains(element->getUuid()) ||
+        pendingList.contains(element->getUuid())) {
       throw RuntimeError(
           __FILE__, __LINE__,
           QString("There are multiple library elements with the same "
                   "UUID in the directory \"%1\"")
-              .arg(dir->getAbsPath().toNative()));
+              .arg(dir.getAbsPath().toNative()));
     }
 
     // everything is ok -> update members
-    elementList.insert(element->getUuid(), element.data());
-    mElementsToUpgrade.insert(element.data());
-    mAllElements.insert(element.take());  // Take object from smart pointer!
+    elementList.insert(element->getUuid(), element.get());
+    mElementsToUpgrade.insert(element.get());
+    mAllElements.insert(element.release());  // Take object from smart pointer!
+  }
+
+  int count = elementList.count() + pendingList.count();
+  qDebug() << "successfully indexed" << count << qPrintable(type);
+}
+
+template <typename ElementType>
+std::unique_ptr<ElementType> ProjectLibrary::loadElement(
+    const QString& path) const {
+  std::unique_ptr<TransactionalDirectory> dir(
+      new TransactionalDirectory(*mDirectory, path));
+  return std::unique_ptr<ElementType>(
+      new ElementType(std::move(dir)));  // can throw
+}
+
+template <typename ElementType>
+ElementType* ProjectLibrary::getElement(
+    const Uuid& uuid, QHash<Uuid, ElementType*>& elementList,
+    QHash<Uuid, QString>& pendingList) const noexcept {
+  ElementType* element = elementList.value(uuid);
+  if ((!element) && pendingList.contains(uuid)) {
+    QString path = pendingList.take(uuid);
+    try {
+      std::unique_ptr<ElementType> loaded =
+          loadElement<ElementType>(path);  // can throw
+      if (loaded->getUuid() != uuid) {
+        throw RuntimeError(
+            __FILE__, __LINE__,
+            QString("The library element in \"%1\" has an unexpected UUID.")
+                .arg(loaded->getDirectory().getAbsPath().toNative()));
+      }
+      element = loaded.get();
+      elementList.insert(uuid, element);
+      mElementsToUpgrade.insert(element);
+      mAllElements.insert(loaded.release());  // Take object from smart pointer!
+    } catch (const Exception& e) {
+      qCritical() << "Failed to load library element:" << e.getMsg();
+    }
   }
+  return element;
+}
 
-  qDebug() << "successfully loaded" << elementList.count() << qPrintable(type);
+template <typename ElementType>
+void ProjectLibrary::loadPendingElements(
+    QHash<Uuid, ElementType*>& elementList,
+    QHash<Uuid, QString>&      pendingList) const noexcept {
+  foreach (const Uuid& uuid, pendingList.keys()) {
+    getElement(uuid, elementList, pendingList);
+  }
 }
 
 template <typename ElementType>
-void ProjectLibrary::addElement(ElementType&               element,
-                                QHash<Uuid, ElementType*>& elementList) {
-  if (elementList.contains(element.getUuid())) {
+void ProjectLibrary::addElement(ElementType&                element,
+                                QHash<Uuid, ElementType*>&  elementList,
+                                const QHash<Uuid, QString>& pendingList) {
+  if (elementList.contains(element.getUuid()) ||
+      pendingList.contains(element.getUuid())) {
     throw LogicError(__FILE__, __LINE__,
                      QString("There is already an element with the same "
                              "UUID in the project's library: %1")
@@ -54,6 +54,9 @@ class Project;
 
 /**
  * @brief The ProjectLibrary class
+ *
+ * Library elements are only loaded when they are accessed the first time. At
+ * construction, only the directories of all elements are indexed.
  */
 class ProjectLibrary final : public QObject {
   Q_OBJECT
@@ -63,31 +66,17 @@ public:
   ProjectLibrary(std::unique_ptr<TransactionalDirectory> directory);
   ~ProjectLibrary() noexcept;
 
-  // Getters: Library Elements
-  const QHash<Uuid, library::Symbol*>& getSymbols() const noexcept {
-    return mSymbols;
-  }
-  const QHash<Uuid, library::Package*>& getPackages() const noexcept {
-    return mPackages;
-  }
-  const QHash<Uuid, library::Component*>& getComponents() const noexcept {
-    return mComponents;
-  }
-  const QHash<Uuid, library::Device*>& getDevices() const noexcept {
-    return mDevices;
-  }
-  library::Symbol* getSymbol(const Uuid& uuid) const noexcept {
-    return mSymbols.value(uuid);
-  }
-  library::Package* getPackage(const Uuid& uuid) const noexcept {
-    return mPackages.value(uuid);
-  }
-  library::Component* getComponent(const Uuid& uuid) const noexcept {
-    return mComponents.value(uuid);
-  }
-  library::Device* getDevice(const Uuid& uuid) const noexcept {
-    return mDevices.value(uuid);
-  }
+  // Getters: Library Elements (these load all not yet loaded elements)
+  const QHash<Uuid, library::Symbol*>&    getSymbols() const noexcept;
+  const QHash<Uuid, library::Package*>&   getPackages() const noexcept;
+  const QHash<Uuid, library::Component*>& getComponents() const noexcept;
+  const QHash<Uuid, library::Device*>&    getDevices() const noexcept;
+
+  // Getters: Single Library Elements (loaded on first access)
+  library::Symbol*    getSymbol(const Uuid& uuid) const noexcept;
+  library::Package*   getPackage(const Uuid& uuid) const noexcept;
+  library::Component* getComponent(const Uuid& uuid) const noexcept;
+  library::Device*    getDevice(const Uuid& uuid) const noexcept;
 
   // Getters: Special Queries
   QHash<Uuid, library::Device*> getDevicesOfComponent(
@@ -114,10 +103,23 @@ private:
 
   // Private Methods
   template <typename ElementType>
-  void loadElements(const QString& dirname, const QString& type,
-                    QHash<Uuid, ElementType*>& elementList);
+  void indexElements(const QString& dirname, const QString& type,
+                     QHash<Uuid, ElementType*>& elementList,
+                     QHash<Uuid, QString>&      pendingList);
+  template <typename ElementType>
+  std::unique_ptr<ElementType> loadElement(const QString& path) const;
   template <typename ElementType>
-  void addElement(ElementType& element, QHash<Uuid, ElementType*>& elementList);
+  ElementType* getElement(const Uuid&                uuid,
+                          QHash<Uuid, ElementType*>& elementList,
+                          QHash<Uuid, QString>&      pendingList) const
+      noexcept;
+  template <typename ElementType>
+  void loadPendingElements(QHash<Uuid, ElementType*>& elementList,
+                           QHash<Uuid, QString>&      pendingList) const
+      noexcept;
+  template <typename ElementType>
+  void addElement(ElementType& element, QHash<Uuid, ElementType*>& elementList,
+                  const QHash<Uuid, QString>& pendingList);
   template <typename ElementType>
   void removeElement(ElementType&               element,
                      QHash<Uuid, ElementType*>& elementList);
@@ -125,14 +127,20 @@ private:
   // General
   std::unique_ptr<TransactionalDirectory> mDirectory;
 
-  // The currently added library elements
-  QHash<Uuid, library::Symbol*>    mSymbols;
-  QHash<Uuid, library::Package*>   mPackages;
-  QHash<Uuid, library::Component*> mComponents;
-  QHash<Uuid, library::Device*>    mDevices;
+  // The currently added and already loaded library elements
+  mutable QHash<Uuid, library::Symbol*>    mSymbols;
+  mutable QHash<Uuid, library::Package*>   mPackages;
+  mutable QHash<Uuid, library::Component*> mComponents;
+  mutable QHash<Uuid, library::Device*>    mDevices;
+
+  // The directories of library elements not loaded yet (relative paths)
+  mutable QHash<Uuid, QString> mPendingSymbols;
+  mutable QHash<Uuid, QString> mPendingPackages;
+  mutable QHash<Uuid, QString> mPendingComponents;
+  mutable QHash<Uuid, QString> mPendingDevices;
 
-  QSet<library::LibraryBaseElement*> mAllElements;
-  QSet<library::LibraryBaseElement*> mElementsToUpgrade;
+  mutable QSet<library::LibraryBaseElement*> mAllElements;
+  mutable QSet<library::LibraryBaseElement*> mElementsToUpgrade;
 };
 
 /*******************************************************************************
@@ -38,10 +38,17 @@
 #include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/versionfile.h>
 #include <librepcb/common/font/strokefontpool.h>
+#include <librepcb/common/scopeguard.h>
+#include <librepcb/common/tracer.h>
+#include <librepcb/common/utils/memorypool.h>
 
+#include <QPicture>
 #include <QPrinter>
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
+#include <functional>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -53,11 +60,13 @@ namespace project {
  ******************************************************************************/
 
 Project::Project(std::unique_ptr<TransactionalDirectory> directory,
-                 const QString& filename, bool create)
+                 const QString& filename, bool create, bool headless)
   : QObject(nullptr),
     AttributeProvider(),
     mDirectory(std::move(directory)),
-    mFilename(filename) {
+    mFilename(filename),
+    mHeadless(headless) {
+  LIBREPCB_TRACE_SCOPE("project", "Project::Project");
   qDebug() << (create ? "create project:" : "open project:")
            << getFilepath().toNative();
 
@@ -144,6 +153,33 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
       mProjectMetadata.reset(new ProjectMetadata(root));
     }
 
+    // Start parsing all schematics and boards in worker threads, since this
+    // takes most of the time when opening big projects. The objects are
+    // created in the main thread once the circuit has been loaded.
+    QList<QPair<QString, QFuture<SExpression>>> schematicFiles;
+    QList<QPair<QString, QFuture<SExpression>>> boardFiles;
+    if (!create) {
+      QString     fp = "schematics/schematics.lp";
+      SExpression schRoot =
+          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
+      foreach (const SExpression& node, schRoot.getChildren("schematic")) {
+        FilePath fp = FilePath::fromRelative(
+            getPath(), node.getValueOfFirstChild<QString>());
+        QString dir = fp.getParentDir().toRelative(getPath());
+        schematicFiles.append(
+            qMakePair(dir, parseFileAsync(dir % "/schematic.lp")));
+      }
+      fp = "boards/boards.lp";
+      SExpression brdRoot =
+          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
+      foreach (const SExpression& node, brdRoot.getChildren("board")) {
+        FilePath fp = FilePath::fromRelative(
+            getPath(), node.getValueOfFirstChild<QString>());
+        QString dir = fp.getParentDir().toRelative(getPath());
+        boardFiles.append(qMakePair(dir, parseFileAsync(dir % "/board.lp")));
+      }
+    }
+
     // Create all needed objects
     connect(mProjectMetadata.data(), &ProjectMetadata::attributesChanged, this,
             &Project::attributesChanged);
@@ -157,42 +193,38 @@ Project::Project(std::unique_ptr<TransactionalDirectory> directory,
     // Load all schematic layers
     mSchematicLayerProvider.reset(new SchematicLayerProvider(*this));
 
-    // Load all schematics
+    // Load all schematics. Each file is taken out of the list, so its parsed
+    // DOM (stored in the future) gets released right after the schematic has
+    // been created, instead of keeping all DOMs alive until the end of loading.
     if (!create) {
-      QString     fp = "schematics/schematics.lp";
-      SExpression schRoot =
-          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
-      foreach (const SExpression& node, schRoot.getChildren("schematic")) {
-        FilePath fp = FilePath::fromRelative(
-            getPath(), node.getValueOfFirstChild<QString>());
-        std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
-            *mDirectory, fp.getParentDir().toRelative(getPath())));
-        Schematic* schematic = new Schematic(*this, std::move(dir));
+      while (!schematicFiles.isEmpty()) {
+        const auto file = schematicFiles.takeFirst();
+        std::unique_ptr<TransactionalDirectory> dir(
+            new TransactionalDirectory(*mDirectory, file.first));
+        Schematic* schematic =
+            new Schematic(*this, std::move(dir), file.second.result());
         addSchematic(*schematic);
       }
       qDebug() << mSchematics.count() << "schematics successfully loaded!";
     }
 
-    // Load all boards
+    // Load all boards (see comment above)
     if (!create) {
-      QString     fp = "boards/boards.lp";
-      SExpression brdRoot =
-          SExpression::parse(mDirectory->read(fp), mDirectory->getAbsPath(fp));
-      foreach (const SExpression& node, brdRoot.getChildren("board")) {
-        FilePath fp = FilePath::fromRelative(
-            getPath(), node.getValueOfFirstChild<QString>());
-        std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
-            *mDirectory, fp.getParentDir().toRelative(getPath())));
-        Board* board = new Board(*this, std::move(dir));
+      while (!boardFiles.isEmpty()) {
+        const auto file = boardFiles.takeFirst();
+        std::unique_ptr<TransactionalDirectory> dir(
+            new TransactionalDirectory(*mDirectory, file.first));
+        Board* board = new Board(*this, std::move(dir), file.second.result());
         addBoard(*board);
       }
       qDebug() << mBoards.count() << "boards successfully loaded!";
     }
 
     // at this point, the whole circuit with all schematics and boards is
-    // successfully loaded, so the ERC list now contains all the correct ERC
-    // messages. So we can now restore the ignore state of each ERC message from
-    // the file.
+    // successfully loaded, so evaluating the scheduled ERC updates once gives
+    // all the correct ERC messages. So we can now restore the ignore state of
+    // each ERC message from the file.
+    mErcMsgList->flush();
     mErcMsgList->restoreIgnoreState();  // can throw
 
     if (create) save();  // write all files to file system
@@ -238,6 +270,9 @@ Project::~Project() noexcept {
   qDeleteAll(mRemovedSchematics);
   mRemovedSchematics.clear();
 
+  // return the memory of the deleted net items to the heap
+  MemoryPool::releaseUnusedChunksOfAllPools();
+
   qDebug() << "closed project:" << getFilepath().toNative();
 }
 
@@ -360,24 +395,57 @@ void Project::printSchematicPages(QPrinter& printer, QList<int>& pages) {
   if (pages.isEmpty())
     throw RuntimeError(__FILE__, __LINE__, tr("No schematic pages selected."));
 
-  QPainter painter(&printer);
-
-  for (int i = 0; i < pages.count(); i++) {
-    Schematic* schematic = getSchematicByIndex(pages[i]);
+  QList<const Schematic*> schematics;
+  auto printModeSg = scopeGuard([&schematics]() {
+    foreach (const Schematic* schematic, schematics) {
+      schematic->getGraphicsScene().setPrintMode(false);
+    }
+  });
+  foreach (int index, pages) {
+    Schematic* schematic = getSchematicByIndex(index);
     if (!schematic) {
       throw RuntimeError(
           __FILE__, __LINE__,
-          tr("No schematic page with the index %1 found.").arg(pages[i]));
+          tr("No schematic page with the index %1 found.").arg(index));
     }
     schematic->clearSelection();
-    schematic->renderToQPainter(painter);
-
-    if (i != pages.count() - 1) {
-      if (!printer.newPage()) {
-        throw RuntimeError(__FILE__, __LINE__,
-                           tr("Unknown error while printing."));
-      }
+    // The graphics items can't detect printing from the QPicture they are
+    // rendered into, so tell them explicitly.
+    schematic->getGraphicsScene().setPrintMode(true);
+    schematics.append(schematic);
+  }
+
+  // Rendering a page accesses its graphics scene, which is only allowed in
+  // the main thread. So the pages are recorded into QPictures in the main
+  // thread, one after the other. But replaying them into the printer (i.e.
+  // generating the PDF) is thread-safe and takes most of the time, so it is
+  // done in a worker thread while the next page is recorded. The printer and
+  // its painter are never used by two threads at the same time.
+  QPainter      painter(&printer);
+  const QRectF  target = painter.viewport();
+  QFuture<bool> job;
+  auto          jobSg = scopeGuard([&job]() { job.waitForFinished(); });
+  for (int i = 0; i < schematics.count(); i++) {
+    QPicture picture;
+    QPainter p(&picture);
+    schematics.at(i)->renderToQPainter(p, target);
+    p.end();
+
+    if ((i > 0) && (!job.result())) {  // waits for the previous page
+      throw RuntimeError(__FILE__, __LINE__,
+                         tr("Unknown error while printing."));
     }
+    const bool newPage = (i > 0);
+    job = QtConcurrent::run([&printer, &painter, picture, newPage]() {
+      if (newPage && (!printer.newPage())) {
+        return false;
+      }
+      painter.drawPicture(0, 0, picture);
+      return true;
+    });
+  }
+  if (!job.result()) {
+    throw RuntimeError(__FILE__, __LINE__, tr("Unknown error while printing."));
   }
 }
 
@@ -493,8 +561,41 @@ void Project::removeBoard(Board& board, bool deleteBoard) {
  ******************************************************************************/
 
 void Project::save() {
+  LIBREPCB_TRACE_SCOPE("project", "Project::save");
   qDebug() << "Save project files to transactional file system...";
 
+  // Serializing schematics and boards takes most of the time for big projects,
+  // so serialize them concurrently while saving the other files. Serializing
+  // does not modify anything, and the file system is only accessed from this
+  // thread. If an exception is thrown in a job, the content is left null and
+  // the object gets serialized again when saving it, which then throws the
+  // exception in this thread.
+  auto serialize = [](const std::function<QByteArray()>& func) {
+    return QtConcurrent::run([func]() -> QByteArray {
+      try {
+        return func();
+      } catch (const Exception&) {
+        return QByteArray();
+      }
+    });
+  };
+  QList<QFuture<QByteArray>> schematicContents;
+  foreach (const Schematic* schematic, mSchematics) {
+    schematicContents.append(
+        serialize([schematic]() { return schematic->serializeToByteArray(); }));
+  }
+  QList<QFuture<QByteArray>> boardContents;
+  foreach (const Board* board, mBoards) {
+    boardContents.append(
+        serialize([board]() { return board->serializeToByteArray(); }));
+  }
+  // Make sure no job accesses the objects anymore if an exception is thrown.
+  auto sg = scopeGuard([&]() {
+    foreach (QFuture<QByteArray> future, schematicContents + boardContents) {
+      future.waitForFinished();
+    }
+  });
+
   // Save version file
   mDirectory->write(
       ".librepcb-project",
@@ -543,8 +644,8 @@ void Project::save() {
     schematic->save();  // can throw
   }
   // Save all added schematics (*.lp files)
-  foreach (Schematic* schematic, mSchematics) {
-    schematic->save();  // can throw
+  for (int i = 0; i < mSchematics.count(); ++i) {
+    mSchematics.at(i)->save(schematicContents[i].result());  // can throw
   }
 
   // Save all removed boards (*.lp files)
@@ -552,8 +653,8 @@ void Project::save() {
     board->save();  // can throw
   }
   // Save all added boards (*.lp files)
-  foreach (Board* board, mBoards) {
-    board->save();  // can throw
+  for (int i = 0; i < mBoards.count(); ++i) {
+    mBoards.at(i)->save(boardContents[i].result());  // can throw
   }
 
   // update the "last modified datetime" attribute of the project
@@ -606,6 +707,21 @@ QString Project::getBuiltInAttributeValue(const QString& key) const noexcept {
   }
 }
 
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QFuture<SExpression> Project::parseFileAsync(const QString& path) const {
+  // Note: Only parsing is done in the worker thread, reading the file must
+  // be done in the main thread as TransactionalDirectory is not thread-safe.
+  QByteArray content  = mDirectory->read(path);  // can throw
+  FilePath   filePath = mDirectory->getAbsPath(path);
+  // Note: Since Exception is a QException, it gets transferred to the main
+  // thread and is rethrown by QFuture::result().
+  return QtConcurrent::run(
+      [content, filePath]() { return SExpression::parse(content, filePath); });
+}
+
 /*******************************************************************************
  *  Static Methods
  ******************************************************************************/
@@ -28,6 +28,7 @@
 #include <librepcb/common/elementname.h>
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/directorylock.h>
+#include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/transactionaldirectory.h>
 #include <librepcb/common/uuid.h>
 #include <librepcb/common/version.h>
@@ -90,12 +91,14 @@ public:
    *
    * @param directory     The directory which contains the project.
    * @param filename      The filename of the *.lpp project file.
+   * @param headless      If true, no graphics items are created for the
+   *                      boards (see #isHeadless()).
    *
    * @throw Exception     If the project could not be opened successfully
    */
   Project(std::unique_ptr<TransactionalDirectory> directory,
-          const QString&                          filename)
-    : Project(std::move(directory), filename, false) {}
+          const QString& filename, bool headless = false)
+    : Project(std::move(directory), filename, false, headless) {}
 
   /**
    * @brief The destructor will close the whole project (without saving!)
@@ -126,6 +129,19 @@ public:
 
   TransactionalDirectory& getDirectory() noexcept { return *mDirectory; }
 
+  /**
+   * @brief Check whether the project was opened without graphics items
+   *
+   * Headless projects (e.g. opened by the command line interface) do not
+   * create graphics items for the board items, which saves a lot of time
+   * and memory. The boards can still be exported (e.g. Gerber files), but
+   * not be shown in a graphics view. Schematics are not affected since they
+   * are rendered from their graphics scene for the PDF export.
+   *
+   * @return Whether the project is headless or not
+   */
+  bool isHeadless() const noexcept { return mHeadless; }
+
   /**
    * @brief Get the StrokeFontPool which contains all stroke fonts of the
    * project
@@ -401,7 +417,7 @@ public:
 
   static Project* create(std::unique_ptr<TransactionalDirectory> directory,
                          const QString&                          filename) {
-    return new Project(std::move(directory), filename, true);
+    return new Project(std::move(directory), filename, true, false);
   }
 
   static bool    isFilePathInsideProjectDirectory(const FilePath& fp) noexcept;
@@ -453,6 +469,7 @@ private:
    * @param filename      The filename of the *.lpp project file.
    * @param create        True if the specified project does not exist already
    *                      and must be created.
+   * @param headless      See #isHeadless().
    *
    * @throw Exception     If the project could not be created/opened
    * successfully
@@ -460,10 +477,23 @@ private:
    * @todo Remove interactive message boxes, should be done at a higher layer!
    */
   explicit Project(std::unique_ptr<TransactionalDirectory> directory,
-                   const QString& filename, bool create);
+                   const QString& filename, bool create, bool headless);
+
+  /**
+   * @brief Read a file and parse it in a worker thread
+   *
+   * @param path    The path to the file, relative to the project directory.
+   *
+   * @return The root node of the parsed file. Note that
+   *         QFuture::result() rethrows the exception if parsing failed.
+   *
+   * @throw Exception     If the file could not be read
+   */
+  QFuture<SExpression> parseFileAsync(const QString& path) const;
 
   std::unique_ptr<TransactionalDirectory> mDirectory;
   QString mFilename;  ///< the name of the *.lpp project file
+  bool    mHeadless;  ///< see #isHeadless()
 
   // General
   QScopedPointer<StrokeFontPool>
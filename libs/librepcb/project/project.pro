@@ -28,11 +28,15 @@ RESOURCES += \
 SOURCES += \
     boards/board.cpp \
     boards/boardairwiresbuilder.cpp \
+    boards/boardconnectivitygraph.cpp \
+    boards/boardcopperpathcache.cpp \
     boards/boardfabricationoutputsettings.cpp \
     boards/boardgerberexport.cpp \
     boards/boardlayerstack.cpp \
+    boards/boardoutlineareacache.cpp \
     boards/boardpickplacegenerator.cpp \
     boards/boardplanefragmentsbuilder.cpp \
+    boards/boardplanesrebuilder.cpp \
     boards/boardselectionquery.cpp \
     boards/boardusersettings.cpp \
     boards/cmd/cmdboardadd.cpp \
@@ -66,7 +70,8 @@ SOURCES += \
     boards/drc/boardclipperpathgenerator.cpp \
     boards/drc/boarddesignrulecheck.cpp \
     boards/drc/boarddesignrulecheckmessage.cpp \
-    boards/graphicsitems/bgi_airwire.cpp \
+    boards/drc/boarddesignrulechecksnapshot.cpp \
+    boards/graphicsitems/bgi_airwires.cpp \
     boards/graphicsitems/bgi_base.cpp \
     boards/graphicsitems/bgi_footprint.cpp \
     boards/graphicsitems/bgi_footprintpad.cpp \
@@ -87,6 +92,7 @@ SOURCES += \
     boards/items/bi_polygon.cpp \
     boards/items/bi_stroketext.cpp \
     boards/items/bi_via.cpp \
+    boards/viageometrycache.cpp \
     bomgenerator.cpp \
     circuit/circuit.cpp \
     circuit/cmd/cmdcomponentinstanceadd.cpp \
@@ -111,6 +117,7 @@ SOURCES += \
     metadata/cmd/cmdprojectmetadataedit.cpp \
     metadata/projectmetadata.cpp \
     project.cpp \
+    projectmemoryreport.cpp \
     schematics/cmd/cmdschematicadd.cpp \
     schematics/cmd/cmdschematicedit.cpp \
     schematics/cmd/cmdschematicnetlabeladd.cpp \
@@ -149,11 +156,15 @@ SOURCES += \
 HEADERS += \
     boards/board.h \
     boards/boardairwiresbuilder.h \
+    boards/boardconnectivitygraph.h \
+    boards/boardcopperpathcache.h \
     boards/boardfabricationoutputsettings.h \
     boards/boardgerberexport.h \
     boards/boardlayerstack.h \
+    boards/boardoutlineareacache.h \
     boards/boardpickplacegenerator.h \
     boards/boardplanefragmentsbuilder.h \
+    boards/boardplanesrebuilder.h \
     boards/boardselectionquery.h \
     boards/boardusersettings.h \
     boards/cmd/cmdboardadd.h \
@@ -187,7 +198,8 @@ HEADERS += \
     boards/drc/boardclipperpathgenerator.h \
     boards/drc/boarddesignrulecheck.h \
     boards/drc/boarddesignrulecheckmessage.h \
-    boards/graphicsitems/bgi_airwire.h \
+    boards/drc/boarddesignrulechecksnapshot.h \
+    boards/graphicsitems/bgi_airwires.h \
     boards/graphicsitems/bgi_base.h \
     boards/graphicsitems/bgi_footprint.h \
     boards/graphicsitems/bgi_footprintpad.h \
@@ -208,6 +220,7 @@ HEADERS += \
     boards/items/bi_polygon.h \
     boards/items/bi_stroketext.h \
     boards/items/bi_via.h \
+    boards/viageometrycache.h \
     bomgenerator.h \
     circuit/circuit.h \
     circuit/cmd/cmdcomponentinstanceadd.h \
@@ -233,6 +246,7 @@ HEADERS += \
     metadata/cmd/cmdprojectmetadataedit.h \
     metadata/projectmetadata.h \
     project.h \
+    projectmemoryreport.h \
     schematics/cmd/cmdschematicadd.h \
     schematics/cmd/cmdschematicedit.h \
     schematics/cmd/cmdschematicnetlabeladd.h \
@@ -0,0 +1,307 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "projectmemoryreport.h"
+
+#include "boards/board.h"
+#include "boards/graphicsitems/bgi_airwires.h"
+#include "boards/graphicsitems/bgi_footprint.h"
+#include "boards/graphicsitems/bgi_footprintpad.h"
+#include "boards/graphicsitems/bgi_netline.h"
+#include "boards/graphicsitems/bgi_netpoint.h"
+#include "boards/graphicsitems/bgi_plane.h"
+#include "boards/graphicsitems/bgi_via.h"
+#include "boards/items/bi_airwire.h"
+#include "boards/items/bi_device.h"
+#include "boards/items/bi_footprint.h"
+#include "boards/items/bi_footprintpad.h"
+#include "boards/items/bi_hole.h"
+#include "boards/items/bi_netline.h"
+#include "boards/items/bi_netpoint.h"
+#include "boards/items/bi_netsegment.h"
+#include "boards/items/bi_plane.h"
+#include "boards/items/bi_polygon.h"
+#include "boards/items/bi_stroketext.h"
+#include "boards/items/bi_via.h"
+#include "circuit/circuit.h"
+#include "circuit/componentinstance.h"
+#include "circuit/netclass.h"
+#include "circuit/netsignal.h"
+#include "library/projectlibrary.h"
+#include "project.h"
+
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/graphics/holegraphicsitem.h>
+#include <librepcb/common/graphics/polygongraphicsitem.h>
+#include <librepcb/common/graphics/stroketextgraphicsitem.h>
+#include <librepcb/common/systeminfo.h>
+#include <librepcb/common/undostack.h>
+#include <librepcb/library/cmp/component.h>
+#include <librepcb/library/dev/device.h>
+#include <librepcb/library/pkg/package.h>
+#include <librepcb/library/sym/symbol.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+ProjectMemoryReport::ProjectMemoryReport(const Project&   project,
+                                         const UndoStack* undoStack) noexcept
+  : mEntries() {
+  const QString scope = tr("Project");
+
+  // Library elements, including the DOMs they might have retained
+  const ProjectLibrary& library  = project.getLibrary();
+  int                   domCount = 0;
+  qint64                domBytes = 0;
+  auto addLibraryElements = [&](const QString& subsystem, int count,
+                                qint64 size) {
+    add(scope, subsystem, count, count * size);
+  };
+  auto addDom = [&](const library::LibraryBaseElement* element) {
+    const qint64 size = element->getRetainedDomSize();
+    if (size > 0) {
+      ++domCount;
+      domBytes += size;
+    }
+  };
+  addLibraryElements(tr("Library Symbols"), library.getSymbols().count(),
+                     sizeof(library::Symbol));
+  addLibraryElements(tr("Library Packages"), library.getPackages().count(),
+                     sizeof(library::Package));
+  addLibraryElements(tr("Library Components"), library.getComponents().count(),
+                     sizeof(library::Component));
+  addLibraryElements(tr("Library Devices"), library.getDevices().count(),
+                     sizeof(library::Device));
+  foreach (const library::Symbol* element, library.getSymbols()) {
+    addDom(element);
+  }
+  foreach (const library::Package* element, library.getPackages()) {
+    addDom(element);
+  }
+  foreach (const library::Component* element, library.getComponents()) {
+    addDom(element);
+  }
+  foreach (const library::Device* element, library.getDevices()) {
+    addDom(element);
+  }
+  add(scope, tr("Retained SExpression DOMs"), domCount, domBytes);
+
+  // Circuit
+  const Circuit& circuit = project.getCircuit();
+  add(scope, "ComponentInstance", circuit.getComponentInstances().count(),
+      circuit.getComponentInstances().count() * sizeof(ComponentInstance));
+  add(scope, "NetSignal", circuit.getNetSignals().count(),
+      circuit.getNetSignals().count() * sizeof(NetSignal));
+  add(scope, "NetClass", circuit.getNetClasses().count(),
+      circuit.getNetClasses().count() * sizeof(NetClass));
+
+  // Undo stack (the size of commands is unknown, they are too manifold)
+  if (undoStack) {
+    add(scope, tr("Undo Commands"), undoStack->getCommandCount(), -1);
+  }
+
+  // Boards
+  foreach (const Board* board, project.getBoards()) {
+    addBoard(*board);
+  }
+}
+
+ProjectMemoryReport::~ProjectMemoryReport() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+qint64 ProjectMemoryReport::getTotalBytes() const noexcept {
+  qint64 total = 0;
+  foreach (const Entry& entry, mEntries) {
+    if (entry.bytes > 0) {
+      total += entry.bytes;
+    }
+  }
+  return total;
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+QString ProjectMemoryReport::toString() const noexcept {
+  int scopeWidth     = tr("Scope").length();
+  int subsystemWidth = tr("Subsystem").length();
+  foreach (const Entry& entry, mEntries) {
+    scopeWidth     = qMax(scopeWidth, entry.scope.length());
+    subsystemWidth = qMax(subsystemWidth, entry.subsystem.length());
+  }
+  auto line = [&](const QString& scope, const QString& subsystem,
+                  const QString& count, const QString& size) {
+    return QString("%1  %2  %3  %4\n")
+        .arg(scope, -scopeWidth)
+        .arg(subsystem, -subsystemWidth)
+        .arg(count, 10)
+        .arg(size, 12);
+  };
+
+  QString str = line(tr("Scope"), tr("Subsystem"), tr("Count"), tr("Size"));
+  str += QString(scopeWidth + subsystemWidth + 28, '-') % "\n";
+  foreach (const Entry& entry, mEntries) {
+    str += line(entry.scope, entry.subsystem, QString::number(entry.count),
+                formatBytes(entry.bytes));
+  }
+  str += QString(scopeWidth + subsystemWidth + 28, '-') % "\n";
+  str += line(tr("Total"), QString(), QString(), formatBytes(getTotalBytes()));
+  str += line(tr("Peak Process Memory"), QString(), QString(),
+              formatBytes(SystemInfo::getPeakMemoryUsage()));
+  return str;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+QString ProjectMemoryReport::formatBytes(qint64 bytes) noexcept {
+  if (bytes < 0) {
+    return "?";
+  } else if (bytes < 1024) {
+    return QString("%1 B").arg(bytes);
+  } else if (bytes < 1024 * 1024) {
+    return QString("%1 kB").arg(bytes / 1024.0, 0, 'f', 1);
+  } else {
+    return QString("%1 MB").arg(bytes / (1024.0 * 1024.0), 0, 'f', 1);
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+template <typename T>
+bool ProjectMemoryReport::addGraphicsItem(const QString&       scope,
+                                          const QGraphicsItem& item,
+                                          const QString& subsystem) noexcept {
+  if (!dynamic_cast<const T*>(&item)) {
+    return false;
+  }
+  add(scope, subsystem, 1, sizeof(T) + getPathSize(item.shape()));
+  return true;
+}
+
+void ProjectMemoryReport::addBoard(const Board& board) noexcept {
+  const QString scope = *board.getName();
+
+  // Board items
+  foreach (const BI_Device* device, board.getDeviceInstances()) {
+    add(scope, "BI_Device", 1, sizeof(BI_Device));
+    const BI_Footprint& footprint = device->getFootprint();
+    add(scope, "BI_Footprint", 1, sizeof(BI_Footprint));
+    add(scope, "BI_FootprintPad", footprint.getPads().count(),
+        footprint.getPads().count() * sizeof(BI_FootprintPad));
+    add(scope, "BI_StrokeText", footprint.getStrokeTexts().count(),
+        footprint.getStrokeTexts().count() * sizeof(BI_StrokeText));
+  }
+  foreach (const BI_NetSegment* segment, board.getNetSegments()) {
+    add(scope, "BI_NetSegment", 1, sizeof(BI_NetSegment));
+    add(scope, "BI_NetPoint", segment->getNetPoints().count(),
+        segment->getNetPoints().count() * sizeof(BI_NetPoint));
+    add(scope, "BI_NetLine", segment->getNetLines().count(),
+        segment->getNetLines().count() * sizeof(BI_NetLine));
+    add(scope, "BI_Via", segment->getVias().count(),
+        segment->getVias().count() * sizeof(BI_Via));
+  }
+  add(scope, "BI_Plane", board.getPlanes().count(),
+      board.getPlanes().count() * sizeof(BI_Plane));
+  add(scope, "BI_Polygon", board.getPolygons().count(),
+      board.getPolygons().count() * sizeof(BI_Polygon));
+  add(scope, "BI_StrokeText", board.getStrokeTexts().count(),
+      board.getStrokeTexts().count() * sizeof(BI_StrokeText));
+  add(scope, "BI_Hole", board.getHoles().count(),
+      board.getHoles().count() * sizeof(BI_Hole));
+  add(scope, "BI_AirWire", board.getAirWires().count(),
+      board.getAirWires().count() * sizeof(BI_AirWire));
+
+  // Plane fragments
+  int    fragmentCount = 0;
+  qint64 fragmentBytes = 0;
+  foreach (const BI_Plane* plane, board.getPlanes()) {
+    foreach (const Path& fragment, plane->getFragments()) {
+      ++fragmentCount;
+      fragmentBytes +=
+          sizeof(Path) + fragment.getVertices().count() * sizeof(Vertex);
+    }
+  }
+  add(scope, tr("Plane Fragments"), fragmentCount, fragmentBytes);
+
+  // Graphics items (not existing in headless projects) and their shapes
+  foreach (const QGraphicsItem* item, board.getGraphicsScene().items()) {
+    const bool known =
+        addGraphicsItem<BGI_Footprint>(scope, *item, "BGI_Footprint") ||
+        addGraphicsItem<BGI_FootprintPad>(scope, *item, "BGI_FootprintPad") ||
+        addGraphicsItem<BGI_NetPoint>(scope, *item, "BGI_NetPoint") ||
+        addGraphicsItem<BGI_NetLine>(scope, *item, "BGI_NetLine") ||
+        addGraphicsItem<BGI_Via>(scope, *item, "BGI_Via") ||
+        addGraphicsItem<BGI_Plane>(scope, *item, "BGI_Plane") ||
+        addGraphicsItem<BGI_AirWires>(scope, *item, "BGI_AirWires") ||
+        addGraphicsItem<PolygonGraphicsItem>(scope, *item,
+                                             "PolygonGraphicsItem") ||
+        addGraphicsItem<StrokeTextGraphicsItem>(scope, *item,
+                                                "StrokeTextGraphicsItem") ||
+        addGraphicsItem<HoleGraphicsItem>(scope, *item, "HoleGraphicsItem");
+    if (!known) {
+      add(scope, tr("Other Graphics Items"), 1, getPathSize(item->shape()));
+    }
+  }
+}
+
+void ProjectMemoryReport::add(const QString& scope, const QString& subsystem,
+                              int count, qint64 bytes) noexcept {
+  for (Entry& entry : mEntries) {
+    if ((entry.scope == scope) && (entry.subsystem == subsystem)) {
+      entry.count += count;
+      entry.bytes = ((entry.bytes < 0) || (bytes < 0)) ? -1
+                                                        : (entry.bytes + bytes);
+      return;
+    }
+  }
+  mEntries.append(Entry{scope, subsystem, count, bytes});
+}
+
+qint64 ProjectMemoryReport::getPathSize(const QPainterPath& path) noexcept {
+  return path.elementCount() * sizeof(QPainterPath::Element);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
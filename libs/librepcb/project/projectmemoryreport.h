@@ -0,0 +1,123 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_PROJECTMEMORYREPORT_H
+#define LIBREPCB_PROJECT_PROJECTMEMORYREPORT_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+class QGraphicsItem;
+
+namespace librepcb {
+
+class UndoStack;
+
+namespace project {
+
+class Board;
+class Project;
+
+/*******************************************************************************
+ *  Class ProjectMemoryReport
+ ******************************************************************************/
+
+/**
+ * @brief Estimates the memory occupied by the subsystems of a project
+ *
+ * The estimation counts the objects of each subsystem (e.g. board items,
+ * their graphics items, plane fragments or library elements) and adds up
+ * their size plus the size of their most important heap allocations (e.g.
+ * painter paths). Many small allocations (strings, containers, ...) are
+ * ignored, so the numbers are a lower bound rather than exact values. They
+ * are intended to find out which subsystem is responsible for a high memory
+ * usage, not to account for every byte.
+ */
+class ProjectMemoryReport final {
+  Q_DECLARE_TR_FUNCTIONS(ProjectMemoryReport)
+
+public:
+  // Types
+  struct Entry {
+    QString scope;      ///< "Project" or the board name
+    QString subsystem;  ///< e.g. "BI_NetLine"
+    int     count;      ///< number of objects
+    qint64  bytes;      ///< estimated size, or -1 if unknown
+  };
+
+  // Constructors / Destructor
+  ProjectMemoryReport()                                 = delete;
+  ProjectMemoryReport(const ProjectMemoryReport& other) = delete;
+
+  /**
+   * @brief Constructor which creates the report immediately
+   *
+   * @param project     The project to analyze
+   * @param undoStack   The undo stack of the project, if there is one
+   */
+  explicit ProjectMemoryReport(const Project&   project,
+                               const UndoStack* undoStack = nullptr) noexcept;
+  ~ProjectMemoryReport() noexcept;
+
+  // Getters
+  const QList<Entry>& getEntries() const noexcept { return mEntries; }
+  qint64              getTotalBytes() const noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Format the report as a human readable table
+   *
+   * @return Multi-line string with one subsystem per line
+   */
+  QString toString() const noexcept;
+
+  // Operator Overloadings
+  ProjectMemoryReport& operator=(const ProjectMemoryReport& rhs) = delete;
+
+  // Static Methods
+  static QString formatBytes(qint64 bytes) noexcept;
+
+private:  // Methods
+  void addBoard(const Board& board) noexcept;
+  template <typename T>
+  bool addGraphicsItem(const QString& scope, const QGraphicsItem& item,
+                       const QString& subsystem) noexcept;
+  void add(const QString& scope, const QString& subsystem, int count,
+           qint64 bytes) noexcept;
+  static qint64 getPathSize(const QPainterPath& path) noexcept;
+
+private:  // Data
+  QList<Entry> mEntries;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_PROJECTMEMORYREPORT_H
@@ -55,11 +55,11 @@ bool CmdSchematicNetLabelAnchorsUpdate::performExecute() {
 }
 
 void CmdSchematicNetLabelAnchorsUpdate::performUndo() {
-  mSchematic.updateAllNetLabelAnchors();
+  mSchematic.updateScheduledNetLabelAnchors();
 }
 
 void CmdSchematicNetLabelAnchorsUpdate::performRedo() {
-  mSchematic.updateAllNetLabelAnchors();
+  mSchematic.updateScheduledNetLabelAnchors();
 }
 
 /*******************************************************************************
@@ -42,8 +42,9 @@ class Schematic;
 /**
  * @brief The CmdSchematicNetLabelAnchorsUpdate class
  *
- * This is just a convenience undo cummand to update all netlabel anchors in a
- * schematic.
+ * This is just a convenience undo cummand to update the netlabel anchors of
+ * all net segments in a schematic which were modified since the last update
+ * (see Schematic::scheduleNetLabelAnchorsUpdate()).
  */
 class CmdSchematicNetLabelAnchorsUpdate final : public UndoCommand {
 public:
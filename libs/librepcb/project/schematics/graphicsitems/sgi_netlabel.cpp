@@ -30,9 +30,9 @@
 #include "../schematiclayerprovider.h"
 
 #include <librepcb/common/application.h>
+#include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/linegraphicsitem.h>
 
-#include <QPrinter>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -117,7 +117,7 @@ void SGI_NetLabel::paint(QPainter*                       painter,
                          const QStyleOptionGraphicsItem* option,
                          QWidget*                        widget) {
   Q_UNUSED(widget);
-  bool deviceIsPrinter = (dynamic_cast<QPrinter*>(painter->device()) != 0);
+  bool deviceIsPrinter = GraphicsScene::isPrinting(*painter, *this);
   const qreal lod =
       option->levelOfDetailFromTransform(painter->worldTransform());
 
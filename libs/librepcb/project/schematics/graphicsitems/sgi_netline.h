@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "sgi_base.h"
 
+#include <librepcb/common/utils/memorypool.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -46,7 +48,7 @@ class SI_NetLine;
 /**
  * @brief The SGI_NetLine class
  */
-class SGI_NetLine final : public SGI_Base {
+class SGI_NetLine final : public SGI_Base, public PoolAllocated<SGI_NetLine> {
 public:
   // Constructors / Destructor
   explicit SGI_NetLine(SI_NetLine& netline) noexcept;
@@ -28,7 +28,8 @@
 #include "../schematic.h"
 #include "../schematiclayerprovider.h"
 
-#include <QPrinter>
+#include <librepcb/common/graphics/graphicsscene.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -87,8 +88,7 @@ void SGI_NetPoint::paint(QPainter*                       painter,
   Q_UNUSED(option);
   Q_UNUSED(widget);
 
-  const bool deviceIsPrinter =
-      (dynamic_cast<QPrinter*>(painter->device()) != 0);
+  const bool deviceIsPrinter = GraphicsScene::isPrinting(*painter, *this);
   bool highlight = mNetPoint.isSelected() ||
                    mNetPoint.getNetSignalOfNetSegment().isHighlighted();
 
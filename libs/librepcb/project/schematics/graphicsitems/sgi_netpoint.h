@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "sgi_base.h"
 
+#include <librepcb/common/utils/memorypool.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -46,7 +48,7 @@ class SI_NetPoint;
 /**
  * @brief The SGI_NetPoint class
  */
-class SGI_NetPoint final : public SGI_Base {
+class SGI_NetPoint final : public SGI_Base, public PoolAllocated<SGI_NetPoint> {
 public:
   // Constructors / Destructor
   explicit SGI_NetPoint(SI_NetPoint& netpoint) noexcept;
@@ -30,10 +30,10 @@
 
 #include <librepcb/common/application.h>
 #include <librepcb/common/attributes/attributesubstitutor.h>
+#include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/sym/symbol.h>
 
-#include <QPrinter>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -53,6 +53,12 @@ SGI_Symbol::SGI_Symbol(SI_Symbol& symbol) noexcept
 
   mFont = qApp->getDefaultSansSerifFont();
 
+  // texts of library symbols are immutable, thus parse them only once
+  for (const Text& text : mLibSymbol.getTexts()) {
+    mTextTemplates.insert(&text,
+                          AttributeSubstitutor::Template(text.getText()));
+  }
+
   updateCacheAndRepaint();
 }
 
@@ -68,6 +74,21 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept {
 
   mBoundingRect = QRectF();
 
+  // invalidate the recorded picture
+  mCachedPicture = QPicture();
+  mCachedPictureKey.clear();
+  mCachedPictureLayers.clear();
+  auto addPictureLayer = [this](const QString& name) {
+    const GraphicsLayer* layer = getLayer(name);
+    if (layer && (!mCachedPictureLayers.contains(layer))) {
+      mCachedPictureLayers.append(layer);
+    }
+  };
+  addPictureLayer(GraphicsLayer::sSymbolGrabAreas);
+#ifdef QT_DEBUG
+  addPictureLayer(GraphicsLayer::sDebugGraphicsItemsTextsBoundingRects);
+#endif
+
   mShape = QPainterPath();
   mShape.setFillRule(Qt::WindingFill);
 
@@ -81,6 +102,7 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept {
     // query polygon path and line width
     QPainterPath polygonPath = polygon.getPath().toQPainterPathPx();
     qreal        w           = polygon.getLineWidth()->toPx() / 2;
+    addPictureLayer(*polygon.getLayerName());
 
     // update bounding rectangle
     mBoundingRect =
@@ -104,6 +126,7 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept {
     // get circle radius, including compensation for the stroke width
     qreal w = circle.getLineWidth()->toPx() / 2;
     qreal r = circle.getDiameter()->toPx() / 2 + w;
+    addPictureLayer(*circle.getLayerName());
 
     // get the bounding rectangle for the circle
     QPointF center = circle.getCenter().toPxQPointF();
@@ -124,9 +147,11 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept {
   for (const Text& text : mLibSymbol.getTexts()) {
     // create static text properties
     CachedTextProperties_t props;
+    addPictureLayer(*text.getLayerName());
 
     // get the text to display
-    props.text = AttributeSubstitutor::substitute(text.getText(), &mSymbol);
+    props.text =
+        AttributeSubstitutor::substitute(mTextTemplates.value(&text), &mSymbol);
 
     // calculate font metrics
     props.fontPixelSize = qCeil(text.getHeight()->toPx());
@@ -176,6 +201,18 @@ void SGI_Symbol::updateCacheAndRepaint() noexcept {
   update();
 }
 
+void SGI_Symbol::updateTexts() noexcept {
+  for (const Text& text : mLibSymbol.getTexts()) {
+    const AttributeSubstitutor::Template& tpl = mTextTemplates.value(&text);
+    if (tpl.dependsOnAttributes() &&
+        (AttributeSubstitutor::substitute(tpl, &mSymbol) !=
+         mCachedTextProperties.value(&text).text)) {
+      updateCacheAndRepaint();
+      return;
+    }
+  }
+}
+
 /*******************************************************************************
  *  Inherited from QGraphicsItem
  ******************************************************************************/
@@ -188,10 +225,95 @@ void SGI_Symbol::paint(QPainter*                       painter,
   const GraphicsLayer* layer    = 0;
   const bool           selected = mSymbol.isSelected();
   const bool           deviceIsPrinter =
-      (dynamic_cast<QPrinter*>(painter->device()) != 0);
+      GraphicsScene::isPrinting(*painter, *this);
   const qreal lod =
       option->levelOfDetailFromTransform(painter->worldTransform());
 
+  // draw polygons, circles and texts
+  if (deviceIsPrinter) {
+    paintStaticGeometry(*painter, selected, deviceIsPrinter, lod);
+  } else {
+    // replay the recorded picture, and only record it again if something
+    // changed which affects its content
+    QByteArray key = getCachedPictureKey(selected, lod);
+    if (key != mCachedPictureKey) {
+      mCachedPicture = QPicture();
+      QPainter picturePainter(&mCachedPicture);
+      paintStaticGeometry(picturePainter, selected, deviceIsPrinter, lod);
+      picturePainter.end();
+      mCachedPictureKey = key;
+    }
+    painter->drawPicture(0, 0, mCachedPicture);
+  }
+
+  // draw origin cross
+  if (!deviceIsPrinter) {
+    layer = getLayer(GraphicsLayer::sSchematicReferences);
+    Q_ASSERT(layer);
+    if (layer->isVisible()) {
+      qreal width = Length(700000).toPx();
+      painter->setPen(QPen(layer->getColor(selected), 0));
+      painter->drawLine(-2 * width, 0, 2 * width, 0);
+      painter->drawLine(0, -2 * width, 0, 2 * width);
+    }
+  }
+
+#ifdef QT_DEBUG
+  layer = getLayer(GraphicsLayer::sDebugComponentSymbolsCounts);
+  Q_ASSERT(layer);
+  if (layer->isVisible()) {
+    // show symbols count of the component
+    int count    = mSymbol.getComponentInstance().getPlacedSymbolsCount();
+    int maxCount = mSymbol.getComponentInstance()
+                       .getSymbolVariant()
+                       .getSymbolItems()
+                       .count();
+    mFont.setPixelSize(Length(1000000).toPx());
+    painter->setFont(mFont);
+    painter->setPen(
+        QPen(layer->getColor(selected), 0, Qt::SolidLine, Qt::RoundCap));
+    painter->drawText(QRectF(),
+                      Qt::AlignHCenter | Qt::AlignVCenter | Qt::TextSingleLine |
+                          Qt::TextDontClip,
+                      QString("[%1/%2]").arg(count).arg(maxCount));
+  }
+  layer = getLayer(GraphicsLayer::sDebugGraphicsItemsBoundingRects);
+  Q_ASSERT(layer);
+  if (layer->isVisible()) {
+    // draw bounding rect
+    painter->setPen(QPen(layer->getColor(selected), 0));
+    painter->setBrush(Qt::NoBrush);
+    painter->drawRect(mBoundingRect);
+  }
+#endif
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+GraphicsLayer* SGI_Symbol::getLayer(const QString& name) const noexcept {
+  return mSymbol.getProject().getLayers().getLayer(name);
+}
+
+QByteArray SGI_Symbol::getCachedPictureKey(bool selected, qreal lod) const
+    noexcept {
+  QByteArray key;
+  QDataStream stream(&key, QIODevice::WriteOnly);
+  stream << selected;
+  foreach (const GraphicsLayer* layer, mCachedPictureLayers) {
+    stream << layer->isVisible() << layer->getColor(selected).rgba();
+  }
+  for (const Text& text : mLibSymbol.getTexts()) {
+    stream << isTextDetailVisible(text, false, lod);
+  }
+  return key;
+}
+
+void SGI_Symbol::paintStaticGeometry(QPainter& painter, bool selected,
+                                     bool deviceIsPrinter, qreal lod) noexcept {
+  const GraphicsLayer* layer = 0;
+
   // draw all polygons
   for (const Polygon& polygon : mLibSymbol.getPolygons()) {
     // set colors
@@ -200,11 +322,11 @@ void SGI_Symbol::paint(QPainter*                       painter,
       if (!layer->isVisible()) layer = nullptr;
     }
     if (layer)
-      painter->setPen(QPen(layer->getColor(selected),
-                           polygon.getLineWidth()->toPx(), Qt::SolidLine,
-                           Qt::RoundCap, Qt::RoundJoin));
+      painter.setPen(QPen(layer->getColor(selected),
+                          polygon.getLineWidth()->toPx(), Qt::SolidLine,
+                          Qt::RoundCap, Qt::RoundJoin));
     else
-      painter->setPen(Qt::NoPen);
+      painter.setPen(Qt::NoPen);
     if (polygon.isFilled() && polygon.getPath().isClosed())
       layer = getLayer(*polygon.getLayerName());
     else if (polygon.isGrabArea())
@@ -214,12 +336,12 @@ void SGI_Symbol::paint(QPainter*                       painter,
     if (layer) {
       if (!layer->isVisible()) layer = nullptr;
     }
-    painter->setBrush(layer
-                          ? QBrush(layer->getColor(selected), Qt::SolidPattern)
-                          : Qt::NoBrush);
+    painter.setBrush(layer
+                         ? QBrush(layer->getColor(selected), Qt::SolidPattern)
+                         : Qt::NoBrush);
 
     // draw polygon
-    painter->drawPath(polygon.getPath().toQPainterPathPx());
+    painter.drawPath(polygon.getPath().toQPainterPathPx());
   }
 
   // draw all circles
@@ -230,11 +352,11 @@ void SGI_Symbol::paint(QPainter*                       painter,
       if (!layer->isVisible()) layer = nullptr;
     }
     if (layer)
-      painter->setPen(QPen(layer->getColor(selected),
-                           circle.getLineWidth()->toPx(), Qt::SolidLine,
-                           Qt::RoundCap, Qt::RoundJoin));
+      painter.setPen(QPen(layer->getColor(selected),
+                          circle.getLineWidth()->toPx(), Qt::SolidLine,
+                          Qt::RoundCap, Qt::RoundJoin));
     else
-      painter->setPen(Qt::NoPen);
+      painter.setPen(Qt::NoPen);
     if (circle.isFilled())
       layer = getLayer(*circle.getLayerName());
     else if (circle.isGrabArea())
@@ -244,14 +366,14 @@ void SGI_Symbol::paint(QPainter*                       painter,
     if (layer) {
       if (!layer->isVisible()) layer = nullptr;
     }
-    painter->setBrush(layer
-                          ? QBrush(layer->getColor(selected), Qt::SolidPattern)
-                          : Qt::NoBrush);
+    painter.setBrush(layer
+                         ? QBrush(layer->getColor(selected), Qt::SolidPattern)
+                         : Qt::NoBrush);
 
     // draw circle
-    painter->drawEllipse(circle.getCenter().toPxQPointF(),
-                         circle.getDiameter()->toPx() / 2,
-                         circle.getDiameter()->toPx() / 2);
+    painter.drawEllipse(circle.getCenter().toPxQPointF(),
+                        circle.getDiameter()->toPx() / 2,
+                        circle.getDiameter()->toPx() / 2);
     // TODO: rotation
   }
 
@@ -267,90 +389,46 @@ void SGI_Symbol::paint(QPainter*                       painter,
     mFont.setPixelSize(props.fontPixelSize);
 
     // draw text or rect
-    painter->save();
-    painter->translate(text.getPosition().toPxQPointF());
+    painter.save();
+    painter.translate(text.getPosition().toPxQPointF());
     if (props.mirrored) {
       static const QTransform gMirror(-1.0, 0.0, 0.0, 1.0, 0.0, 0.0);
       if (text.getAlign().getH() != HAlign::center()) {
-        painter->translate(props.textRect.width() * props.scaleFactor, 0);
+        painter.translate(props.textRect.width() * props.scaleFactor, 0);
       }
-      painter->setTransform(gMirror, true);
+      painter.setTransform(gMirror, true);
     }
-    painter->rotate(-text.getRotation().toDeg());
-    painter->translate(-text.getPosition().toPxQPointF());
-    painter->scale(props.scaleFactor, props.scaleFactor);
-    if (props.rotate180) painter->rotate(180);
-    if ((deviceIsPrinter) || (lod * text.getHeight()->toPx() > 8)) {
+    painter.rotate(-text.getRotation().toDeg());
+    painter.translate(-text.getPosition().toPxQPointF());
+    painter.scale(props.scaleFactor, props.scaleFactor);
+    if (props.rotate180) painter.rotate(180);
+    if (isTextDetailVisible(text, deviceIsPrinter, lod)) {
       // draw text
-      painter->setPen(QPen(layer->getColor(selected), 0));
-      painter->setFont(mFont);
-      painter->drawText(props.textRect, props.flags, props.text);
+      painter.setPen(QPen(layer->getColor(selected), 0));
+      painter.setFont(mFont);
+      painter.drawText(props.textRect, props.flags, props.text);
     } else {
       // fill rect
-      painter->fillRect(props.textRect,
-                        QBrush(layer->getColor(selected), Qt::Dense5Pattern));
+      painter.fillRect(props.textRect,
+                       QBrush(layer->getColor(selected), Qt::Dense5Pattern));
     }
 #ifdef QT_DEBUG
     layer = getLayer(GraphicsLayer::sDebugGraphicsItemsTextsBoundingRects);
     Q_ASSERT(layer);
     if (layer->isVisible()) {
       // draw text bounding rect
-      painter->setPen(QPen(layer->getColor(selected), 0));
-      painter->setBrush(Qt::NoBrush);
-      painter->drawRect(props.textRect);
+      painter.setPen(QPen(layer->getColor(selected), 0));
+      painter.setBrush(Qt::NoBrush);
+      painter.drawRect(props.textRect);
     }
 #endif
-    painter->restore();
-  }
-
-  // draw origin cross
-  if (!deviceIsPrinter) {
-    layer = getLayer(GraphicsLayer::sSchematicReferences);
-    Q_ASSERT(layer);
-    if (layer->isVisible()) {
-      qreal width = Length(700000).toPx();
-      painter->setPen(QPen(layer->getColor(selected), 0));
-      painter->drawLine(-2 * width, 0, 2 * width, 0);
-      painter->drawLine(0, -2 * width, 0, 2 * width);
-    }
-  }
-
-#ifdef QT_DEBUG
-  layer = getLayer(GraphicsLayer::sDebugComponentSymbolsCounts);
-  Q_ASSERT(layer);
-  if (layer->isVisible()) {
-    // show symbols count of the component
-    int count    = mSymbol.getComponentInstance().getPlacedSymbolsCount();
-    int maxCount = mSymbol.getComponentInstance()
-                       .getSymbolVariant()
-                       .getSymbolItems()
-                       .count();
-    mFont.setPixelSize(Length(1000000).toPx());
-    painter->setFont(mFont);
-    painter->setPen(
-        QPen(layer->getColor(selected), 0, Qt::SolidLine, Qt::RoundCap));
-    painter->drawText(QRectF(),
-                      Qt::AlignHCenter | Qt::AlignVCenter | Qt::TextSingleLine |
-                          Qt::TextDontClip,
-                      QString("[%1/%2]").arg(count).arg(maxCount));
+    painter.restore();
   }
-  layer = getLayer(GraphicsLayer::sDebugGraphicsItemsBoundingRects);
-  Q_ASSERT(layer);
-  if (layer->isVisible()) {
-    // draw bounding rect
-    painter->setPen(QPen(layer->getColor(selected), 0));
-    painter->setBrush(Qt::NoBrush);
-    painter->drawRect(mBoundingRect);
-  }
-#endif
 }
 
-/*******************************************************************************
- *  Private Methods
- ******************************************************************************/
-
-GraphicsLayer* SGI_Symbol::getLayer(const QString& name) const noexcept {
-  return mSymbol.getProject().getLayers().getLayer(name);
+bool SGI_Symbol::isTextDetailVisible(const Text& text, bool deviceIsPrinter,
+                                     qreal lod) noexcept {
+  return deviceIsPrinter || (lod * text.getHeight()->toPx() > 8);
 }
 
 /*******************************************************************************
@@ -25,6 +25,8 @@
  ******************************************************************************/
 #include "sgi_base.h"
 
+#include <librepcb/common/attributes/attributesubstitutor.h>
+
 #include <QtCore>
 #include <QtWidgets>
 
@@ -60,6 +62,15 @@ public:
   // General Methods
   void updateCacheAndRepaint() noexcept;
 
+  /**
+   * @brief Update the cache only if substituted texts have changed
+   *
+   * Much cheaper than #updateCacheAndRepaint() if the substituted attributes
+   * still have the same values, thus to be called when attributes have
+   * changed.
+   */
+  void updateTexts() noexcept;
+
   // Inherited from QGraphicsItem
   QRectF       boundingRect() const noexcept { return mBoundingRect; }
   QPainterPath shape() const noexcept { return mShape; }
@@ -74,6 +85,11 @@ private:
 
   // Private Methods
   GraphicsLayer* getLayer(const QString& name) const noexcept;
+  QByteArray     getCachedPictureKey(bool selected, qreal lod) const noexcept;
+  void           paintStaticGeometry(QPainter& painter, bool selected,
+                                     bool deviceIsPrinter, qreal lod) noexcept;
+  static bool    isTextDetailVisible(const Text& text, bool deviceIsPrinter,
+                                     qreal lod) noexcept;
 
   // Types
 
@@ -96,6 +112,20 @@ private:
   QRectF                                     mBoundingRect;
   QPainterPath                               mShape;
   QHash<const Text*, CachedTextProperties_t> mCachedTextProperties;
+
+  /// Parsed texts of the library symbol, to substitute attributes faster
+  QHash<const Text*, AttributeSubstitutor::Template> mTextTemplates;
+
+  /// All layers which affect the content of #mCachedPicture
+  QList<const GraphicsLayer*> mCachedPictureLayers;
+
+  /// Recorded polygons, circles and texts, to avoid painting them one by one
+  /// on every repaint (the origin cross and debug overlays are not included)
+  QPicture mCachedPicture;
+
+  /// The state (selection, layers, zoom level) #mCachedPicture was recorded
+  /// with, or an empty array if the picture is outdated
+  QByteArray mCachedPictureKey;
 };
 
 /*******************************************************************************
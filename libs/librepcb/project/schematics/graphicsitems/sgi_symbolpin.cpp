@@ -33,10 +33,10 @@
 #include "../schematiclayerprovider.h"
 
 #include <librepcb/common/application.h>
+#include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/library/cmp/component.h>
 #include <librepcb/library/sym/symbolpin.h>
 
-#include <QPrinter>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -140,8 +140,7 @@ void SGI_SymbolPin::paint(QPainter*                       painter,
                           const QStyleOptionGraphicsItem* option,
                           QWidget*                        widget) {
   Q_UNUSED(widget);
-  const bool deviceIsPrinter =
-      (dynamic_cast<QPrinter*>(painter->device()) != 0);
+  const bool deviceIsPrinter = GraphicsScene::isPrinting(*painter, *this);
   const qreal lod =
       option->levelOfDetailFromTransform(painter->worldTransform());
 
@@ -78,6 +78,10 @@ void SI_Base::setSelected(bool selected) noexcept {
 void SI_Base::addToSchematic(SGI_Base* item) noexcept {
   Q_ASSERT(!mIsAddedToSchematic);
   if (item) {
+    // allow spatial queries on the scene to find the schematic item (see
+    // #fromGraphicsItem())
+    item->setData(sGraphicsItemDataKey,
+                  QVariant::fromValue(static_cast<void*>(this)));
     mSchematic.getGraphicsScene().addItem(*item);
   }
   mIsAddedToSchematic = true;
@@ -91,6 +95,20 @@ void SI_Base::removeFromSchematic(SGI_Base* item) noexcept {
   mIsAddedToSchematic = false;
 }
 
+void SI_Base::scheduleRepaint(const QGraphicsItem* item) noexcept {
+  if (item && mIsAddedToSchematic) {
+    mSchematic.getGraphicsScene().scheduleUpdate(item->sceneBoundingRect());
+  }
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+SI_Base* SI_Base::fromGraphicsItem(const QGraphicsItem& item) noexcept {
+  return static_cast<SI_Base*>(item.data(sGraphicsItemDataKey).value<void*>());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -91,11 +91,35 @@ public:
   // Operator Overloadings
   SI_Base& operator=(const SI_Base& rhs) = delete;
 
+  // Static Methods
+
+  /**
+   * @brief Get the schematic item which owns a graphics item of the scene
+   *
+   * @param item  Any graphics item of the schematic's graphics scene
+   *
+   * @return The item which added the graphics item to the schematic, or
+   *         nullptr if the graphics item is not directly owned by a schematic
+   *         item (e.g. child items or ERC markers)
+   */
+  static SI_Base* fromGraphicsItem(const QGraphicsItem& item) noexcept;
+
 protected:
   // General Methods
   void addToSchematic(SGI_Base* item) noexcept;
   void removeFromSchematic(SGI_Base* item) noexcept;
 
+  /**
+   * @brief Schedule a repaint of a graphics item of this item
+   *
+   * Used instead of QGraphicsItem::update() when a change affects many items
+   * at once (e.g. net signal highlighting), see
+   * librepcb::GraphicsScene::scheduleUpdate().
+   *
+   * @param item  The graphics item to repaint (may be nullptr)
+   */
+  void scheduleRepaint(const QGraphicsItem* item) noexcept;
+
 protected:
   Schematic& mSchematic;
 
@@ -103,6 +127,9 @@ private:
   // General Attributes
   bool mIsAddedToSchematic;
   bool mIsSelected;
+
+  /// Key of the QGraphicsItem::data() slot referring back to the item
+  static const int sGraphicsItemDataKey = 0x5349;  // "SI"
 };
 
 /*******************************************************************************
@@ -123,7 +123,7 @@ void SI_NetLabel::addToSchematic() {
               [this]() { mGraphicsItem->updateCacheAndRepaint(); });
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+              [this]() { scheduleRepaint(mGraphicsItem.data()); });
   SI_Base::addToSchematic(mGraphicsItem.data());
   mGraphicsItem->updateCacheAndRepaint();
   updateAnchor();
@@ -134,7 +134,7 @@ void SI_NetLine::addToSchematic() {
 
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+              [this]() { scheduleRepaint(mGraphicsItem.data()); });
   SI_Base::addToSchematic(mGraphicsItem.data());
   sg.dismiss();
 }
@@ -156,6 +156,7 @@ void SI_NetLine::removeFromSchematic() {
 void SI_NetLine::updateLine() noexcept {
   mPosition = (mStartPoint->getPosition() + mEndPoint->getPosition()) / 2;
   mGraphicsItem->updateCacheAndRepaint();
+  mSchematic.scheduleNetLabelAnchorsUpdate(mNetSegment);
 }
 
 void SI_NetLine::serialize(SExpression& root) const {
@@ -27,6 +27,7 @@
 #include "si_base.h"
 
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/utils/memorypool.h>
 
 #include <QtCore>
 
@@ -61,7 +62,9 @@ public:
 /**
  * @brief The SI_NetLine class
  */
-class SI_NetLine final : public SI_Base, public SerializableObject {
+class SI_NetLine final : public SI_Base,
+                         public SerializableObject,
+                         public PoolAllocated<SI_NetLine> {
   Q_OBJECT
 
 public:
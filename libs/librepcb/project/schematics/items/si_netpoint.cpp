@@ -24,6 +24,7 @@
 
 #include "../../circuit/netsignal.h"
 #include "../../erc/ercmsg.h"
+#include "../schematic.h"
 #include "si_netsegment.h"
 
 #include <QtCore>
@@ -97,6 +98,7 @@ void SI_NetPoint::setPosition(const Point& position) noexcept {
     mPosition = position;
     mGraphicsItem->setPos(mPosition.toPxQPointF());
     foreach (SI_NetLine* line, mRegisteredNetLines) { line->updateLine(); }
+    mSchematic.updateAnchorIndex(*this);
   }
 }
 
@@ -110,9 +112,10 @@ void SI_NetPoint::addToSchematic() {
   }
   mHighlightChangedConnection =
       connect(&getNetSignalOfNetSegment(), &NetSignal::highlightedChanged,
-              [this]() { mGraphicsItem->update(); });
+              [this]() { scheduleRepaint(mGraphicsItem.data()); });
   mErcMsgDeadNetPoint->setVisible(true);
   SI_Base::addToSchematic(mGraphicsItem.data());
+  mSchematic.updateAnchorIndex(*this);
 }
 
 void SI_NetPoint::removeFromSchematic() {
@@ -122,6 +125,7 @@ void SI_NetPoint::removeFromSchematic() {
   disconnect(mHighlightChangedConnection);
   mErcMsgDeadNetPoint->setVisible(false);
   SI_Base::removeFromSchematic(mGraphicsItem.data());
+  mSchematic.updateAnchorIndex(*this);
 }
 
 void SI_NetPoint::registerNetLine(SI_NetLine& netline) {
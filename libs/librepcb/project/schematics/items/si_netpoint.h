@@ -29,6 +29,7 @@
 #include "si_base.h"
 
 #include <librepcb/common/fileio/serializableobject.h>
+#include <librepcb/common/utils/memorypool.h>
 
 #include <QtCore>
 
@@ -48,7 +49,8 @@ namespace project {
 class SI_NetPoint final : public SI_Base,
                           public SI_NetLineAnchor,
                           public SerializableObject,
-                          public IF_ErcMsgProvider {
+                          public IF_ErcMsgProvider,
+                          public PoolAllocated<SI_NetPoint> {
   Q_OBJECT
   DECLARE_ERC_MSG_CLASS_NAME(SI_NetPoint)
 
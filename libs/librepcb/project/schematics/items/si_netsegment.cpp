@@ -143,45 +143,6 @@ bool SI_NetSegment::isUsed() const noexcept {
           (!mNetLabels.isEmpty()));
 }
 
-int SI_NetSegment::getNetPointsAtScenePos(const Point&         pos,
-                                          QList<SI_NetPoint*>& points) const
-    noexcept {
-  int count = 0;
-  foreach (SI_NetPoint* netpoint, mNetPoints) {
-    if (netpoint->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
-      points.append(netpoint);
-      ++count;
-    }
-  }
-  return count;
-}
-
-int SI_NetSegment::getNetLinesAtScenePos(const Point&        pos,
-                                         QList<SI_NetLine*>& lines) const
-    noexcept {
-  int count = 0;
-  foreach (SI_NetLine* netline, mNetLines) {
-    if (netline->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
-      lines.append(netline);
-      ++count;
-    }
-  }
-  return count;
-}
-
-int SI_NetSegment::getNetLabelsAtScenePos(const Point&         pos,
-                                          QList<SI_NetLabel*>& labels) const
-    noexcept {
-  int count = 0;
-  foreach (SI_NetLabel* netlabel, mNetLabels) {
-    if (netlabel->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
-      labels.append(netlabel);
-      ++count;
-    }
-  }
-  return count;
-}
-
 QSet<QString> SI_NetSegment::getForcedNetNames() const noexcept {
   QSet<QString> names;
   foreach (SI_NetLine* netline, mNetLines) {
@@ -219,6 +180,7 @@ Point SI_NetSegment::calcNearestPoint(const Point& p) const noexcept {
     if ((i == 0) || (ld < dist)) {
       dist = *ld;
       pos  = lp;
+      if (dist == 0) break;  // can't get any nearer
     }
   }
   return pos;
@@ -499,15 +461,6 @@ void SI_NetSegment::selectAll() noexcept {
     netlabel->setSelected(true);
 }
 
-void SI_NetSegment::setSelectionRect(const QRectF rectPx) noexcept {
-  foreach (SI_NetPoint* netpoint, mNetPoints)
-    netpoint->setSelected(netpoint->getGrabAreaScenePx().intersects(rectPx));
-  foreach (SI_NetLine* netline, mNetLines)
-    netline->setSelected(netline->getGrabAreaScenePx().intersects(rectPx));
-  foreach (SI_NetLabel* netlabel, mNetLabels)
-    netlabel->setSelected(netlabel->getGrabAreaScenePx().intersects(rectPx));
-}
-
 void SI_NetSegment::clearSelection() const noexcept {
   foreach (SI_NetPoint* netpoint, mNetPoints)
     netpoint->setSelected(false);
@@ -64,15 +64,9 @@ public:
   ~SI_NetSegment() noexcept;
 
   // Getters
-  const Uuid& getUuid() const noexcept { return mUuid; }
-  NetSignal&  getNetSignal() const noexcept { return *mNetSignal; }
-  bool        isUsed() const noexcept;
-  int         getNetPointsAtScenePos(const Point&         pos,
-                                     QList<SI_NetPoint*>& points) const noexcept;
-  int getNetLinesAtScenePos(const Point& pos, QList<SI_NetLine*>& lines) const
-      noexcept;
-  int                 getNetLabelsAtScenePos(const Point&         pos,
-                                             QList<SI_NetLabel*>& labels) const noexcept;
+  const Uuid&         getUuid() const noexcept { return mUuid; }
+  NetSignal&          getNetSignal() const noexcept { return *mNetSignal; }
+  bool                isUsed() const noexcept;
   QSet<QString>       getForcedNetNames() const noexcept;
   QString             getForcedNetName() const noexcept;
   Point               calcNearestPoint(const Point& p) const noexcept;
@@ -110,7 +104,6 @@ public:
   void addToSchematic() override;
   void removeFromSchematic() override;
   void selectAll() noexcept;
-  void setSelectionRect(const QRectF rectPx) noexcept;
   void clearSelection() const noexcept;
 
   /// @copydoc librepcb::SerializableObject::serialize()
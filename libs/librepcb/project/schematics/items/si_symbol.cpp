@@ -156,7 +156,6 @@ void SI_Symbol::setPosition(const Point& newPos) noexcept {
   if (newPos != mPosition) {
     mPosition = newPos;
     mGraphicsItem->setPos(newPos.toPxQPointF());
-    mGraphicsItem->updateCacheAndRepaint();
     foreach (SI_SymbolPin* pin, mPins) { pin->updatePosition(); }
   }
 }
@@ -274,7 +273,7 @@ void SI_Symbol::setSelected(bool selected) noexcept {
  ******************************************************************************/
 
 void SI_Symbol::schematicOrComponentAttributesChanged() {
-  mGraphicsItem->updateCacheAndRepaint();
+  mGraphicsItem->updateTexts();
 }
 
 /*******************************************************************************
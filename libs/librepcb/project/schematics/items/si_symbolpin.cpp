@@ -26,6 +26,7 @@
 #include "../../circuit/componentsignalinstance.h"
 #include "../../circuit/netsignal.h"
 #include "../../erc/ercmsg.h"
+#include "../schematic.h"
 #include "si_symbol.h"
 
 #include <librepcb/library/cmp/component.h>
@@ -154,9 +155,11 @@ void SI_SymbolPin::addToSchematic() {
   if (getCompSigInstNetSignal()) {
     mHighlightChangedConnection =
         connect(getCompSigInstNetSignal(), &NetSignal::highlightedChanged,
-                [this]() { mGraphicsItem->update(); });
+                [this]() { scheduleRepaint(mGraphicsItem.data()); });
   }
   SI_Base::addToSchematic(mGraphicsItem.data());
+  mSchematic.updatePinConnectivity(*this);
+  mSchematic.updateAnchorIndex(*this);
   updateErcMessages();
   mGraphicsItem->updateCacheAndRepaint();
 }
@@ -172,6 +175,8 @@ void SI_SymbolPin::removeFromSchematic() {
     disconnect(mHighlightChangedConnection);
   }
   SI_Base::removeFromSchematic(mGraphicsItem.data());
+  mSchematic.updatePinConnectivity(*this);
+  mSchematic.updateAnchorIndex(*this);
   updateErcMessages();
 }
 
@@ -188,6 +193,7 @@ void SI_SymbolPin::registerNetLine(SI_NetLine& netline) {
   }
   mRegisteredNetLines.insert(&netline);
   netline.updateLine();
+  mSchematic.updatePinConnectivity(*this);
   updateErcMessages();
   mGraphicsItem
       ->updateCacheAndRepaint();  // re-check whether to fill the circle or not
@@ -199,6 +205,7 @@ void SI_SymbolPin::unregisterNetLine(SI_NetLine& netline) {
   }
   mRegisteredNetLines.remove(&netline);
   netline.updateLine();
+  mSchematic.updatePinConnectivity(*this);
   updateErcMessages();
   mGraphicsItem
       ->updateCacheAndRepaint();  // re-check whether to fill the circle or not
@@ -211,6 +218,7 @@ void SI_SymbolPin::updatePosition() noexcept {
   updateGraphicsItemTransform();
   mGraphicsItem->updateCacheAndRepaint();
   foreach (SI_NetLine* netline, mRegisteredNetLines) { netline->updateLine(); }
+  mSchematic.updateAnchorIndex(*this);
 }
 
 /*******************************************************************************
@@ -53,7 +53,8 @@ namespace project {
 
 Schematic::Schematic(Project&                                project,
                      std::unique_ptr<TransactionalDirectory> directory,
-                     bool create, const QString& newName)
+                     bool create, const QString& newName,
+                     const SExpression& root)
   : QObject(&project),
     AttributeProvider(),
     mProject(project),
@@ -72,9 +73,6 @@ Schematic::Schematic(Project&                                project,
       // load default grid properties
       mGridProperties.reset(new GridProperties());
     } else {
-      SExpression root = SExpression::parse(
-          mDirectory->read(getFilePath().getFilename()), getFilePath());
-
       // the schematic seems to be ready to open, so we will create all needed
       // objects
 
@@ -151,6 +149,9 @@ bool Schematic::isEmpty() const noexcept {
 
 QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
   QPointF scenePosPx = pos.toPxQPointF();
+  // Use the spatial index to avoid calculating the (expensive) grab areas of
+  // all items of the schematic.
+  QSet<SI_Base*> candidates = getItemsFromSceneIndex(pos).toSet();
   QList<SI_Base*>
       list;  // Note: The order of adding the items is very important (the
              // top most item must appear as the first item in the list)!
@@ -179,9 +180,15 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
   // symbols & pins
   foreach (SI_Symbol* symbol, mSymbols) {
     foreach (SI_SymbolPin* pin, symbol->getPins()) {
-      if (pin->getGrabAreaScenePx().contains(scenePosPx)) list.append(pin);
+      if (candidates.contains(pin) &&
+          pin->getGrabAreaScenePx().contains(scenePosPx)) {
+        list.append(pin);
+      }
+    }
+    if (candidates.contains(symbol) &&
+        symbol->getGrabAreaScenePx().contains(scenePosPx)) {
+      list.append(symbol);
     }
-    if (symbol->getGrabAreaScenePx().contains(scenePosPx)) list.append(symbol);
   }
   return list;
 }
@@ -189,8 +196,11 @@ QList<SI_Base*> Schematic::getItemsAtScenePos(const Point& pos) const noexcept {
 QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_NetPoint*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetPointsAtScenePos(pos, list);
+  foreach (SI_Base* item, getItemsFromAnchorIndex(pos)) {
+    if ((item->getType() == SI_Base::Type_t::NetPoint) &&
+        item->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      list.append(static_cast<SI_NetPoint*>(item));
+    }
   }
   return list;
 }
@@ -198,8 +208,11 @@ QList<SI_NetPoint*> Schematic::getNetPointsAtScenePos(const Point& pos) const
 QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_NetLine*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetLinesAtScenePos(pos, list);
+  foreach (SI_Base* item, getItemsFromSceneIndex(pos)) {
+    if ((item->getType() == SI_Base::Type_t::NetLine) &&
+        item->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      list.append(static_cast<SI_NetLine*>(item));
+    }
   }
   return list;
 }
@@ -207,8 +220,11 @@ QList<SI_NetLine*> Schematic::getNetLinesAtScenePos(const Point& pos) const
 QList<SI_NetLabel*> Schematic::getNetLabelsAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_NetLabel*> list;
-  foreach (SI_NetSegment* segment, mNetSegments) {
-    segment->getNetLabelsAtScenePos(pos, list);
+  foreach (SI_Base* item, getItemsFromSceneIndex(pos)) {
+    if ((item->getType() == SI_Base::Type_t::NetLabel) &&
+        item->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      list.append(static_cast<SI_NetLabel*>(item));
+    }
   }
   return list;
 }
@@ -216,10 +232,10 @@ QList<SI_NetLabel*> Schematic::getNetLabelsAtScenePos(const Point& pos) const
 QList<SI_SymbolPin*> Schematic::getPinsAtScenePos(const Point& pos) const
     noexcept {
   QList<SI_SymbolPin*> list;
-  foreach (SI_Symbol* symbol, mSymbols) {
-    foreach (SI_SymbolPin* pin, symbol->getPins()) {
-      if (pin->getGrabAreaScenePx().contains(pos.toPxQPointF()))
-        list.append(pin);
+  foreach (SI_Base* item, getItemsFromAnchorIndex(pos)) {
+    if ((item->getType() == SI_Base::Type_t::SymbolPin) &&
+        item->getGrabAreaScenePx().contains(pos.toPxQPointF())) {
+      list.append(static_cast<SI_SymbolPin*>(item));
     }
   }
   return list;
@@ -310,6 +326,40 @@ void Schematic::removeNetSegment(SI_NetSegment& netsegment) {
   // remove from schematic
   netsegment.removeFromSchematic();  // can throw
   mNetSegments.removeOne(&netsegment);
+  mNetSegmentsWithOutdatedLabelAnchors.remove(&netsegment);
+}
+
+/*******************************************************************************
+ *  Connectivity Methods
+ ******************************************************************************/
+
+void Schematic::updatePinConnectivity(SI_SymbolPin& pin) noexcept {
+  Q_ASSERT(&pin.getSchematic() == this);
+  if (pin.isAddedToSchematic() && (!pin.isUsed())) {
+    mUnconnectedPins.insert(&pin);
+  } else {
+    mUnconnectedPins.remove(&pin);
+  }
+}
+
+void Schematic::updateAnchorIndex(SI_Base& anchor) noexcept {
+  Q_ASSERT((anchor.getType() == SI_Base::Type_t::SymbolPin) ||
+           (anchor.getType() == SI_Base::Type_t::NetPoint));
+  auto it = mAnchorIndexCells.find(&anchor);
+  if (anchor.isAddedToSchematic()) {
+    AnchorIndexCell cell = getAnchorIndexCell(anchor.getPosition());
+    if (it != mAnchorIndexCells.end()) {
+      if (it.value() == cell) return;  // still in the same cell
+      mAnchorIndex.remove(it.value(), &anchor);
+      it.value() = cell;
+    } else {
+      mAnchorIndexCells.insert(&anchor, cell);
+    }
+    mAnchorIndex.insert(cell, &anchor);
+  } else if (it != mAnchorIndexCells.end()) {
+    mAnchorIndex.remove(it.value(), &anchor);
+    mAnchorIndexCells.erase(it);
+  }
 }
 
 /*******************************************************************************
@@ -355,12 +405,17 @@ void Schematic::removeFromProject() {
   sgl.dismiss();
 }
 
-void Schematic::save() {
+QByteArray Schematic::serializeToByteArray() const {
+  SExpression doc = serializeToDomElement("librepcb_schematic");  // can throw
+  return doc.toByteArray();
+}
+
+void Schematic::save(const QByteArray& content) {
   if (mIsAddedToProject) {
     // save schematic file
-    SExpression doc(serializeToDomElement("librepcb_schematic"));  // can throw
     mDirectory->write(getFilePath().getFilename(),
-                      doc.toByteArray());  // can throw
+                      content.isNull() ? serializeToByteArray()
+                                       : content);  // can throw
   } else {
     mDirectory->removeDirRecursively();  // can throw
   }
@@ -380,16 +435,40 @@ void Schematic::setSelectionRect(const Point& p1, const Point& p2,
   mGraphicsScene->setSelectionRect(p1, p2);
   if (updateItems) {
     QRectF rectPx = QRectF(p1.toPxQPointF(), p2.toPxQPointF()).normalized();
+    // Only items found in the spatial index can intersect with the rect, so
+    // there's no need to calculate the grab areas of all the other items.
+    QSet<SI_Base*> candidates;
+    foreach (QGraphicsItem* graphicsItem,
+             mGraphicsScene->items(rectPx, Qt::IntersectsItemBoundingRect)) {
+      if (SI_Base* item = SI_Base::fromGraphicsItem(*graphicsItem)) {
+        candidates.insert(item);
+      }
+    }
+    auto isHit = [&](SI_Base& item) {
+      return candidates.contains(&item) &&
+             item.getGrabAreaScenePx().intersects(rectPx);
+    };
+    // Avoid repainting items whose selection state did not change.
+    auto select = [](SI_Base& item, bool selected) {
+      if (item.isSelected() != selected) item.setSelected(selected);
+    };
     foreach (SI_Symbol* symbol, mSymbols) {
-      bool selectSymbol = symbol->getGrabAreaScenePx().intersects(rectPx);
-      symbol->setSelected(selectSymbol);
+      bool selectSymbol = isHit(*symbol);
+      select(*symbol, selectSymbol);
       foreach (SI_SymbolPin* pin, symbol->getPins()) {
-        bool selectPin = pin->getGrabAreaScenePx().intersects(rectPx);
-        pin->setSelected(selectSymbol || selectPin);
+        select(*pin, selectSymbol || isHit(*pin));
       }
     }
     foreach (SI_NetSegment* segment, mNetSegments) {
-      segment->setSelectionRect(rectPx);
+      foreach (SI_NetPoint* netpoint, segment->getNetPoints()) {
+        select(*netpoint, isHit(*netpoint));
+      }
+      foreach (SI_NetLine* netline, segment->getNetLines()) {
+        select(*netline, isHit(*netline));
+      }
+      foreach (SI_NetLabel* netlabel, segment->getNetLabels()) {
+        select(*netlabel, isHit(*netlabel));
+      }
     }
   }
 }
@@ -403,10 +482,26 @@ void Schematic::updateAllNetLabelAnchors() noexcept {
   foreach (SI_NetSegment* netsegment, mNetSegments) {
     netsegment->updateAllNetLabelAnchors();
   }
+  mNetSegmentsWithOutdatedLabelAnchors.clear();
+}
+
+void Schematic::scheduleNetLabelAnchorsUpdate(
+    SI_NetSegment& netsegment) noexcept {
+  if (netsegment.isAddedToSchematic()) {
+    mNetSegmentsWithOutdatedLabelAnchors.insert(&netsegment);
+  }
+}
+
+void Schematic::updateScheduledNetLabelAnchors() noexcept {
+  foreach (SI_NetSegment* netsegment, mNetSegmentsWithOutdatedLabelAnchors) {
+    netsegment->updateAllNetLabelAnchors();
+  }
+  mNetSegmentsWithOutdatedLabelAnchors.clear();
 }
 
-void Schematic::renderToQPainter(QPainter& painter) const noexcept {
-  mGraphicsScene->render(&painter, QRectF(),
+void Schematic::renderToQPainter(QPainter&     painter,
+                                 const QRectF& target) const noexcept {
+  mGraphicsScene->render(&painter, target,
                          mGraphicsScene->itemsBoundingRect(),
                          Qt::KeepAspectRatio);
 }
@@ -444,6 +539,45 @@ void Schematic::updateIcon() noexcept {
   mIcon = QIcon(mGraphicsScene->toPixmap(QSize(297, 210), Qt::white));
 }
 
+QList<SI_Base*> Schematic::getItemsFromSceneIndex(const Point& pos) const
+    noexcept {
+  QList<SI_Base*> items;
+  foreach (QGraphicsItem* graphicsItem,
+           mGraphicsScene->items(pos.toPxQPointF(),
+                                 Qt::IntersectsItemBoundingRect,
+                                 Qt::DescendingOrder)) {
+    SI_Base* item = SI_Base::fromGraphicsItem(*graphicsItem);
+    if (item && (&item->getSchematic() == this)) {
+      items.append(item);
+    }
+  }
+  return items;
+}
+
+QList<SI_Base*> Schematic::getItemsFromAnchorIndex(const Point& pos) const
+    noexcept {
+  QList<SI_Base*> list;
+  AnchorIndexCell center = getAnchorIndexCell(pos);
+  for (qint64 x = center.first - 1; x <= center.first + 1; ++x) {
+    for (qint64 y = center.second - 1; y <= center.second + 1; ++y) {
+      list.append(mAnchorIndex.values(AnchorIndexCell(x, y)));
+    }
+  }
+  return list;
+}
+
+Schematic::AnchorIndexCell Schematic::getAnchorIndexCell(
+    const Point& pos) noexcept {
+  // The cell size must be larger than the grab area radius of pins and net
+  // points, so looking at the neighbour cells finds every candidate.
+  static const qint64 cellSize = 2540000;  // 2.54mm
+  auto floorDiv = [](qint64 value) {
+    return (value >= 0) ? (value / cellSize) : ((value + 1) / cellSize - 1);
+  };
+  return AnchorIndexCell(floorDiv(pos.getX().toNm()),
+                         floorDiv(pos.getY().toNm()));
+}
+
 void Schematic::serialize(SExpression& root) const {
   root.appendChild(mUuid);
   root.appendChild("name", mName, true);
@@ -462,7 +596,8 @@ void Schematic::serialize(SExpression& root) const {
 Schematic* Schematic::create(Project&                                project,
                              std::unique_ptr<TransactionalDirectory> directory,
                              const ElementName&                      name) {
-  return new Schematic(project, std::move(directory), true, *name);
+  return new Schematic(project, std::move(directory), true, *name,
+                       SExpression());
 }
 
 /*******************************************************************************
@@ -112,8 +112,9 @@ public:
   // Constructors / Destructor
   Schematic()                       = delete;
   Schematic(const Schematic& other) = delete;
-  Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory)
-    : Schematic(project, std::move(directory), false, QString()) {}
+  Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory,
+            const SExpression& root)
+    : Schematic(project, std::move(directory), false, QString(), root) {}
   ~Schematic() noexcept;
 
   // Getters: General
@@ -153,10 +154,62 @@ public:
   void                  addNetSegment(SI_NetSegment& netsegment);
   void                  removeNetSegment(SI_NetSegment& netsegment);
 
+  // Connectivity Methods
+
+  /**
+   * @brief Get all symbol pins of this schematic which are not connected to
+   *        any net line
+   *
+   * This index is updated by the pins whenever their connection state
+   * changes, so it can be used without scanning all symbols.
+   *
+   * @return All unconnected pins (in no particular order)
+   */
+  const QSet<SI_SymbolPin*>& getUnconnectedPins() const noexcept {
+    return mUnconnectedPins;
+  }
+
+  /**
+   * @brief Update the connectivity index for a specific pin
+   *
+   * @param pin   The pin whose connection state may have changed. If it is
+   *              added to the schematic but not used, it is considered as
+   *              unconnected, otherwise it is removed from the index.
+   */
+  void updatePinConnectivity(SI_SymbolPin& pin) noexcept;
+
+  /**
+   * @brief Update the anchor index for a specific pin or net point
+   *
+   * The anchor index is a hash grid of all symbol pins and net points of
+   * this schematic, used to quickly find the snap candidates around a
+   * position (see #getPinsAtScenePos() and #getNetPointsAtScenePos()).
+   *
+   * @param anchor  The pin or net point which was added, removed or moved.
+   *                If it is not added to the schematic, it is removed from
+   *                the index.
+   */
+  void updateAnchorIndex(SI_Base& anchor) noexcept;
+
   // General Methods
   void addToProject();
   void removeFromProject();
-  void save();
+
+  /**
+   * @brief Serialize the schematic to the content of its file
+   *
+   * @note  See Board::serializeToByteArray().
+   *
+   * @return The file content
+   */
+  QByteArray serializeToByteArray() const;
+
+  /**
+   * @brief Write the schematic to the project directory
+   *
+   * @param content   See Board::save().
+   */
+  void save(const QByteArray& content = QByteArray());
   void showInView(GraphicsView& view) noexcept;
   void saveViewSceneRect(const QRectF& rect) noexcept { mViewRect = rect; }
   const QRectF& restoreViewSceneRect() const noexcept { return mViewRect; }
@@ -165,7 +218,27 @@ public:
                                  bool updateItems) noexcept;
   void          clearSelection() const noexcept;
   void          updateAllNetLabelAnchors() noexcept;
-  void          renderToQPainter(QPainter& painter) const noexcept;
+
+  /**
+   * @brief Remember a net segment whose net labels need new anchors
+   *
+   * Called whenever the geometry of a net line changes. The anchors are not
+   * updated immediately but only by #updateScheduledNetLabelAnchors(), so
+   * moving many net points at once updates every affected label only once.
+   *
+   * @param netsegment  The net segment which was modified.
+   */
+  void scheduleNetLabelAnchorsUpdate(SI_NetSegment& netsegment) noexcept;
+
+  /**
+   * @brief Update the net label anchors of all scheduled net segments
+   *
+   * @see #scheduleNetLabelAnchorsUpdate()
+   */
+  void updateScheduledNetLabelAnchors() noexcept;
+  void          renderToQPainter(QPainter&     painter,
+                                 const QRectF& target = QRectF()) const
+      noexcept;
   std::unique_ptr<SchematicSelectionQuery> createSelectionQuery() const
       noexcept;
 
@@ -192,10 +265,40 @@ signals:
   void attributesChanged() override;
 
 private:
+  /// Index of a cell in the anchor index grid (x, y)
+  typedef QPair<qint64, qint64> AnchorIndexCell;
+
   Schematic(Project& project, std::unique_ptr<TransactionalDirectory> directory,
-            bool create, const QString& newName);
+            bool create, const QString& newName, const SExpression& root);
   void updateIcon() noexcept;
 
+  /**
+   * @brief Look up schematic items in the spatial index of the graphics scene
+   *
+   * The graphics scene maintains a BSP tree of all its items which is updated
+   * automatically when items are added, removed or moved, so it is used as
+   * the spatial index of the schematic instead of maintaining a separate one.
+   *
+   * @param pos   The position to look at.
+   *
+   * @return All items whose bounding rect contains the position, top most
+   *         item first. The caller still needs to check the exact grab area.
+   */
+  QList<SI_Base*> getItemsFromSceneIndex(const Point& pos) const noexcept;
+
+  /**
+   * @brief Look up pins and net points in the anchor index
+   *
+   * @param pos   The position to look at.
+   *
+   * @return All pins and net points in the cell of the position and its
+   *         neighbour cells. The caller still needs to check the exact grab
+   *         area.
+   */
+  QList<SI_Base*> getItemsFromAnchorIndex(const Point& pos) const noexcept;
+
+  static AnchorIndexCell getAnchorIndexCell(const Point& pos) noexcept;
+
   /// @copydoc librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
 
@@ -215,6 +318,14 @@ private:
 
   QList<SI_Symbol*>     mSymbols;
   QList<SI_NetSegment*> mNetSegments;
+
+  // Connectivity Index
+  QSet<SI_SymbolPin*>                    mUnconnectedPins;   ///< unused pins
+  QMultiHash<AnchorIndexCell, SI_Base*>  mAnchorIndex;       ///< pins & points
+  QHash<const SI_Base*, AnchorIndexCell> mAnchorIndexCells;  ///< reverse map
+
+  /// Net segments with outdated net label anchors
+  QSet<SI_NetSegment*> mNetSegmentsWithOutdatedLabelAnchors;
 };
 
 /*******************************************************************************
@@ -24,7 +24,6 @@
 
 #include "ui_boarddesignrulecheckdialog.h"
 
-#include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/drc/boarddesignrulecheck.h>
 
 #include <QtCore>
@@ -41,10 +40,13 @@ namespace editor {
  ******************************************************************************/
 
 BoardDesignRuleCheckDialog::BoardDesignRuleCheckDialog(
-    Board& board, const BoardDesignRuleCheck::Options& options,
+    BoardDesignRuleCheck& drc, const BoardDesignRuleCheck::Options& options,
     const LengthUnit& lengthUnit, const QString& settingsPrefix,
     QWidget* parent) noexcept
-  : QDialog(parent), mBoard(board), mUi(new Ui::BoardDesignRuleCheckDialog) {
+  : QDialog(parent),
+    mDrc(drc),
+    mIsRunning(false),
+    mUi(new Ui::BoardDesignRuleCheckDialog) {
   mUi->setupUi(this);
   mUi->edtClearanceCopperCopper->configure(
       lengthUnit, LengthEditBase::Steps::generic(),
@@ -105,45 +107,78 @@ BoardDesignRuleCheck::Options BoardDesignRuleCheckDialog::getOptions() const
   return options;
 }
 
+/*******************************************************************************
+ *  Inherited from QDialog
+ ******************************************************************************/
+
+void BoardDesignRuleCheckDialog::reject() noexcept {
+  if (mIsRunning) {
+    mDrc.cancel();  // don't close the dialog while the DRC is running
+  } else {
+    QDialog::reject();
+  }
+}
+
 /*******************************************************************************
  *  GUI Event Handlers
  ******************************************************************************/
 
 void BoardDesignRuleCheckDialog::btnRunDrcClicked() noexcept {
+  if (mIsRunning) {
+    mDrc.cancel();
+    return;
+  }
+
+  QString btnRunText = mUi->btnRun->text();
+  mIsRunning         = true;
   mUi->grpOptions->setEnabled(false);
-  mUi->btnRun->setEnabled(false);
+  mUi->btnRun->setText(tr("Cancel"));
   mUi->buttonBox->setEnabled(false);
 
+  // The DRC object is reused for later runs, so remember the connections to
+  // remove them afterwards.
+  QList<QMetaObject::Connection> connections;
   try {
     mUi->lstMessages->clear();
     mUi->lstProgress->clear();
 
-    BoardDesignRuleCheck drc(mBoard, getOptions());
-    connect(&drc, &BoardDesignRuleCheck::progressPercent, mUi->prgProgress,
-            &QProgressBar::setValue);
-    connect(&drc, &BoardDesignRuleCheck::progressStatus, mUi->lstProgress,
-            static_cast<void (QListWidget::*)(const QString&)>(
-                &QListWidget::addItem));
-    connect(&drc, &BoardDesignRuleCheck::progressMessage, mUi->lstMessages,
-            static_cast<void (QListWidget::*)(const QString&)>(
-                &QListWidget::addItem));
-
-    // Use the progressStatus() signal (because it is not emitted too often
-    // which would lead to flickering) to update both list widgets.
-    connect(&drc, SIGNAL(progressStatus(QString)), mUi->lstProgress,
-            SLOT(repaint()));
-    connect(&drc, SIGNAL(progressStatus(QString)), mUi->lstMessages,
-            SLOT(repaint()));
-
-    drc.execute();  // can throw
-    mMessages = drc.getMessages();
+    mDrc.setOptions(getOptions());
+    connections.append(connect(&mDrc, &BoardDesignRuleCheck::progressPercent,
+                               mUi->prgProgress, &QProgressBar::setValue));
+    connections.append(
+        connect(&mDrc, &BoardDesignRuleCheck::progressStatus, mUi->lstProgress,
+                static_cast<void (QListWidget::*)(const QString&)>(
+                    &QListWidget::addItem)));
+    connections.append(
+        connect(&mDrc, &BoardDesignRuleCheck::progressMessage,
+                mUi->lstMessages,
+                static_cast<void (QListWidget::*)(const QString&)>(
+                    &QListWidget::addItem)));
+
+    // Run the checks in a worker thread and keep processing events meanwhile
+    // to keep the dialog responsive and allow clicking the cancel button
+    // (other windows are blocked anyway since the dialog is modal). Note that
+    // the signals are queued, so the loop must be connected before starting.
+    QEventLoop loop;
+    connections.append(connect(&mDrc, &BoardDesignRuleCheck::finished, &loop,
+                               &QEventLoop::quit, Qt::QueuedConnection));
+    mDrc.start();  // can throw
+    loop.exec();
+    mDrc.waitForFinished();  // can throw
+    mMessages = mDrc.getMessages();
+  } catch (const UserCanceled&) {
+    mUi->lstProgress->addItem(tr("Canceled."));
   } catch (Exception& e) {
     QMessageBox::warning(this, tr("Error"), e.getMsg());
   }
+  foreach (const QMetaObject::Connection& connection, connections) {
+    disconnect(connection);
+  }
 
   mUi->grpOptions->setEnabled(true);
-  mUi->btnRun->setEnabled(true);
+  mUi->btnRun->setText(btnRunText);
   mUi->buttonBox->setEnabled(true);
+  mIsRunning = false;
 }
 
 /*******************************************************************************
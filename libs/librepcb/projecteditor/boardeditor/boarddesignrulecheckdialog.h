@@ -34,9 +34,6 @@
  ******************************************************************************/
 namespace librepcb {
 namespace project {
-
-class Board;
-
 namespace editor {
 
 namespace Ui {
@@ -49,6 +46,10 @@ class BoardDesignRuleCheckDialog;
 
 /**
  * @brief The BoardDesignRuleCheckDialog class
+ *
+ * The passed ::librepcb::project::BoardDesignRuleCheck object is reused for
+ * every run, so subsequent runs only need to check the modified parts of the
+ * board.
  */
 class BoardDesignRuleCheckDialog final : public QDialog {
   Q_OBJECT
@@ -57,7 +58,7 @@ public:
   // Constructors / Destructor
   BoardDesignRuleCheckDialog()                                        = delete;
   BoardDesignRuleCheckDialog(const BoardDesignRuleCheckDialog& other) = delete;
-  BoardDesignRuleCheckDialog(Board&                               board,
+  BoardDesignRuleCheckDialog(BoardDesignRuleCheck&                drc,
                              const BoardDesignRuleCheck::Options& options,
                              const LengthUnit&                    lengthUnit,
                              const QString& settingsPrefix,
@@ -71,11 +72,15 @@ public:
     return mMessages;
   }
 
+  // Inherited from QDialog
+  void reject() noexcept override;
+
 private:  // GUI Event Handlers
   void btnRunDrcClicked() noexcept;
 
 private:
-  Board&                                           mBoard;
+  BoardDesignRuleCheck&                            mDrc;
+  bool                                             mIsRunning;
   QScopedPointer<Ui::BoardDesignRuleCheckDialog>   mUi;
   tl::optional<QList<BoardDesignRuleCheckMessage>> mMessages;
 };
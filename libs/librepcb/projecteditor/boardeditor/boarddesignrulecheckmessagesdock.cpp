@@ -22,6 +22,7 @@
  ******************************************************************************/
 #include "boarddesignrulecheckmessagesdock.h"
 
+#include "boarddesignrulecheckmessagesmodel.h"
 #include "ui_boarddesignrulecheckmessagesdock.h"
 
 #include <QtCore>
@@ -40,18 +41,22 @@ namespace editor {
 
 BoardDesignRuleCheckMessagesDock::BoardDesignRuleCheckMessagesDock(
     QWidget* parent) noexcept
-  : QDockWidget(parent), mUi(new Ui::BoardDesignRuleCheckMessagesDock) {
+  : QDockWidget(parent),
+    mUi(new Ui::BoardDesignRuleCheckMessagesDock),
+    mModel(new BoardDesignRuleCheckMessagesModel()) {
   mUi->setupUi(this);
-  connect(mUi->listWidget, &QListWidget::currentRowChanged, this,
-          &BoardDesignRuleCheckMessagesDock::listWidgetCurrentItemChanged);
-  connect(mUi->listWidget, &QListWidget::itemClicked, this,
-          &BoardDesignRuleCheckMessagesDock::listWidgetCurrentItemChanged);
-  connect(
-      mUi->listWidget, &QListWidget::itemDoubleClicked, this,
-      &BoardDesignRuleCheckMessagesDock::listWidgetCurrentItemDoubleClicked);
+  mUi->treeView->setModel(mModel.data());
+  connect(mUi->treeView->selectionModel(),
+          &QItemSelectionModel::currentChanged, this,
+          &BoardDesignRuleCheckMessagesDock::treeViewCurrentIndexChanged);
+  connect(mUi->treeView, &QTreeView::clicked, this,
+          &BoardDesignRuleCheckMessagesDock::treeViewCurrentIndexChanged);
+  connect(mUi->treeView, &QTreeView::doubleClicked, this,
+          &BoardDesignRuleCheckMessagesDock::treeViewDoubleClicked);
 }
 
 BoardDesignRuleCheckMessagesDock::~BoardDesignRuleCheckMessagesDock() noexcept {
+  mUi->treeView->setModel(nullptr);
 }
 
 /*******************************************************************************
@@ -60,34 +65,49 @@ BoardDesignRuleCheckMessagesDock::~BoardDesignRuleCheckMessagesDock() noexcept {
 
 void BoardDesignRuleCheckMessagesDock::setMessages(
     const QList<BoardDesignRuleCheckMessage>& messages) noexcept {
-  mMessages = messages;
+  // Memorize which groups were expanded to restore them after the reset.
+  QSet<QString> expandedGroups;
+  for (int i = 0; i < mModel->rowCount(); ++i) {
+    QModelIndex index = mModel->index(i, 0);
+    if (mUi->treeView->isExpanded(index)) {
+      expandedGroups.insert(mModel->getGroupTitle(index));
+    }
+  }
 
-  bool signalsBlocked = mUi->listWidget->blockSignals(true);
-  mUi->listWidget->clear();
-  foreach (const BoardDesignRuleCheckMessage& message, mMessages) {
-    mUi->listWidget->addItem(message.getMessage());
+  // Don't emit messageSelected() just because the model was reset.
+  bool signalsBlocked = mUi->treeView->selectionModel()->blockSignals(true);
+  mModel->setMessages(messages);
+  mUi->treeView->selectionModel()->blockSignals(signalsBlocked);
+
+  // Only the groups are created by the view, the messages of collapsed groups
+  // are not even queried. Thus even huge amounts of messages are cheap.
+  int groupCount = mModel->rowCount();
+  for (int i = 0; i < groupCount; ++i) {
+    QModelIndex index = mModel->index(i, 0);
+    if ((groupCount == 1) ||
+        expandedGroups.contains(mModel->getGroupTitle(index))) {
+      mUi->treeView->expand(index);
+    }
   }
-  mUi->listWidget->blockSignals(signalsBlocked);
 
-  setWindowTitle(tr("DRC [%1]", "Number of messages").arg(mMessages.count()));
+  setWindowTitle(tr("DRC [%1]", "Number of messages").arg(messages.count()));
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
-void BoardDesignRuleCheckMessagesDock::listWidgetCurrentItemChanged() noexcept {
-  int index = mUi->listWidget->currentRow();
-  if ((index >= 0) && (index < mMessages.count())) {
-    emit messageSelected(mMessages[index], mUi->cbxCenterInView->isChecked());
+void BoardDesignRuleCheckMessagesDock::treeViewCurrentIndexChanged(
+    const QModelIndex& index) noexcept {
+  if (const BoardDesignRuleCheckMessage* msg = mModel->getMessage(index)) {
+    emit messageSelected(*msg, mUi->cbxCenterInView->isChecked());
   }
 }
 
-void BoardDesignRuleCheckMessagesDock::
-    listWidgetCurrentItemDoubleClicked() noexcept {
-  int index = mUi->listWidget->currentRow();
-  if ((index >= 0) && (index < mMessages.count())) {
-    emit messageSelected(mMessages[index], true);
+void BoardDesignRuleCheckMessagesDock::treeViewDoubleClicked(
+    const QModelIndex& index) noexcept {
+  if (const BoardDesignRuleCheckMessage* msg = mModel->getMessage(index)) {
+    emit messageSelected(*msg, true);
   }
 }
 
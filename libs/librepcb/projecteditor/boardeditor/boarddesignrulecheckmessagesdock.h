@@ -35,6 +35,8 @@ namespace librepcb {
 namespace project {
 namespace editor {
 
+class BoardDesignRuleCheckMessagesModel;
+
 namespace Ui {
 class BoardDesignRuleCheckMessagesDock;
 }
@@ -67,12 +69,12 @@ signals:
   void messageSelected(const BoardDesignRuleCheckMessage& msg, bool zoomTo);
 
 private:  // Methods
-  void listWidgetCurrentItemChanged() noexcept;
-  void listWidgetCurrentItemDoubleClicked() noexcept;
+  void treeViewCurrentIndexChanged(const QModelIndex& index) noexcept;
+  void treeViewDoubleClicked(const QModelIndex& index) noexcept;
 
 private:
   QScopedPointer<Ui::BoardDesignRuleCheckMessagesDock> mUi;
-  QList<BoardDesignRuleCheckMessage>                   mMessages;
+  QScopedPointer<BoardDesignRuleCheckMessagesModel>    mModel;
 };
 
 /*******************************************************************************
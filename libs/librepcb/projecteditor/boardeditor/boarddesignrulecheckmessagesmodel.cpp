@@ -0,0 +1,177 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boarddesignrulecheckmessagesmodel.h"
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardDesignRuleCheckMessagesModel::BoardDesignRuleCheckMessagesModel(
+    QObject* parent) noexcept
+  : QAbstractItemModel(parent) {
+}
+
+BoardDesignRuleCheckMessagesModel::
+    ~BoardDesignRuleCheckMessagesModel() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+const BoardDesignRuleCheckMessage*
+    BoardDesignRuleCheckMessagesModel::getMessage(
+        const QModelIndex& index) const noexcept {
+  if (index.isValid() && (index.internalId() > 0)) {
+    const Group& group = mGroups.at(index.internalId() - 1);
+    return &mMessages.at(group.messages.at(index.row()));
+  }
+  return nullptr;
+}
+
+QString BoardDesignRuleCheckMessagesModel::getGroupTitle(
+    const QModelIndex& index) const noexcept {
+  if (index.isValid() && (index.internalId() == 0)) {
+    return mGroups.at(index.row()).title;
+  }
+  return QString();
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void BoardDesignRuleCheckMessagesModel::setMessages(
+    const QList<BoardDesignRuleCheckMessage>& messages) noexcept {
+  beginResetModel();
+  mMessages = messages;
+  mGroups.clear();
+  QHash<QString, int> groupIndices;
+  for (int i = 0; i < mMessages.count(); ++i) {
+    const QString title = extractGroupTitle(mMessages.at(i).getMessage());
+    auto          it    = groupIndices.find(title);
+    if (it == groupIndices.end()) {
+      it = groupIndices.insert(title, mGroups.count());
+      mGroups.append(Group{title, QVector<int>()});
+    }
+    mGroups[it.value()].messages.append(i);
+  }
+  endResetModel();
+}
+
+/*******************************************************************************
+ *  Inherited from QAbstractItemModel
+ ******************************************************************************/
+
+QModelIndex BoardDesignRuleCheckMessagesModel::index(
+    int row, int column, const QModelIndex& parent) const {
+  if (!hasIndex(row, column, parent)) {
+    return QModelIndex();
+  } else if (parent.isValid()) {
+    // The internal ID of messages is the index of their group plus one.
+    return createIndex(row, column, quintptr(parent.row() + 1));
+  } else {
+    return createIndex(row, column, quintptr(0));
+  }
+}
+
+QModelIndex BoardDesignRuleCheckMessagesModel::parent(
+    const QModelIndex& index) const {
+  if (index.isValid() && (index.internalId() > 0)) {
+    return createIndex(static_cast<int>(index.internalId() - 1), 0,
+                       quintptr(0));
+  }
+  return QModelIndex();
+}
+
+int BoardDesignRuleCheckMessagesModel::rowCount(
+    const QModelIndex& parent) const {
+  if (!parent.isValid()) {
+    return mGroups.count();
+  } else if ((parent.internalId() == 0) && (parent.column() == 0)) {
+    return mGroups.at(parent.row()).messages.count();
+  }
+  return 0;
+}
+
+int BoardDesignRuleCheckMessagesModel::columnCount(
+    const QModelIndex& parent) const {
+  Q_UNUSED(parent);
+  return 1;
+}
+
+QVariant BoardDesignRuleCheckMessagesModel::data(const QModelIndex& index,
+                                                 int role) const {
+  if (!index.isValid()) {
+    return QVariant();
+  }
+  if (const BoardDesignRuleCheckMessage* msg = getMessage(index)) {
+    switch (role) {
+      case Qt::DisplayRole:
+      case Qt::ToolTipRole:
+        return msg->getMessage();
+      default:
+        return QVariant();
+    }
+  }
+  const Group& group = mGroups.at(index.row());
+  switch (role) {
+    case Qt::DisplayRole:
+      return QString("%1 [%2]").arg(group.title).arg(group.messages.count());
+    case Qt::FontRole: {
+      QFont font;
+      font.setBold(true);
+      return font;
+    }
+    default:
+      return QVariant();
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+QString BoardDesignRuleCheckMessagesModel::extractGroupTitle(
+    const QString& message) noexcept {
+  int pos = message.indexOf(':');
+  return (pos > 0) ? message.left(pos).trimmed() : message;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,106 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_EDITOR_BOARDDESIGNRULECHECKMESSAGESMODEL_H
+#define LIBREPCB_PROJECT_EDITOR_BOARDDESIGNRULECHECKMESSAGESMODEL_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/project/boards/drc/boarddesignrulecheckmessage.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*******************************************************************************
+ *  Class BoardDesignRuleCheckMessagesModel
+ ******************************************************************************/
+
+/**
+ * @brief Item model of DRC messages, grouped by the kind of message
+ *
+ * The top level rows are the groups, their children are the messages. The
+ * group of a message is determined by its text before the first colon (e.g.
+ * "Clearance (0.2mm)" or "Missing connection"), which is the same for all
+ * messages of the same check.
+ */
+class BoardDesignRuleCheckMessagesModel final : public QAbstractItemModel {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  BoardDesignRuleCheckMessagesModel(
+      const BoardDesignRuleCheckMessagesModel& other) = delete;
+  explicit BoardDesignRuleCheckMessagesModel(
+      QObject* parent = nullptr) noexcept;
+  ~BoardDesignRuleCheckMessagesModel() noexcept;
+
+  // Getters
+  const QList<BoardDesignRuleCheckMessage>& getMessages() const noexcept {
+    return mMessages;
+  }
+  const BoardDesignRuleCheckMessage* getMessage(const QModelIndex& index) const
+      noexcept;
+  QString getGroupTitle(const QModelIndex& index) const noexcept;
+
+  // Setters
+  void setMessages(const QList<BoardDesignRuleCheckMessage>& messages) noexcept;
+
+  // Inherited from QAbstractItemModel
+  QModelIndex index(int row, int column,
+                    const QModelIndex& parent = QModelIndex()) const override;
+  QModelIndex parent(const QModelIndex& index) const override;
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+  QVariant data(const QModelIndex& index,
+                int                role = Qt::DisplayRole) const override;
+
+  // Operator Overloadings
+  BoardDesignRuleCheckMessagesModel& operator       =(
+      const BoardDesignRuleCheckMessagesModel& rhs) = delete;
+
+private:  // Types
+  struct Group {
+    QString      title;
+    QVector<int> messages;  ///< Indices in #mMessages
+  };
+
+private:  // Methods
+  static QString extractGroupTitle(const QString& message) noexcept;
+
+private:  // Data
+  QList<BoardDesignRuleCheckMessage> mMessages;
+  QVector<Group>                     mGroups;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_EDITOR_BOARDDESIGNRULECHECKMESSAGESMODEL_H
@@ -30,6 +30,7 @@
 #include "boarddesignrulecheckmessagesdock.h"
 #include "boardlayersdock.h"
 #include "boardlayerstacksetupdialog.h"
+#include "boardperformancedock.h"
 #include "boardpickplacegeneratordialog.h"
 #include "fabricationoutputdialog.h"
 #include "fsm/boardeditorfsm.h"
@@ -51,6 +52,7 @@
 #include <librepcb/common/utils/undostackactiongroup.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/boardlayerstack.h>
+#include <librepcb/project/boards/boardplanesrebuilder.h>
 #include <librepcb/project/boards/cmd/cmdboardadd.h>
 #include <librepcb/project/boards/cmd/cmdboarddesignrulesmodify.h>
 #include <librepcb/project/boards/cmd/cmdboardremove.h>
@@ -61,6 +63,7 @@
 #include <librepcb/project/circuit/componentinstance.h>
 #include <librepcb/project/metadata/projectmetadata.h>
 #include <librepcb/project/project.h>
+#include <librepcb/project/projectmemoryreport.h>
 #include <librepcb/project/settings/projectsettings.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
@@ -94,6 +97,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
     mUnplacedComponentsDock(nullptr),
     mBoardLayersDock(nullptr),
     mDrcMessagesDock(),
+    mPerformanceDock(),
     mFsm(nullptr) {
   mUi->setupUi(this);
   mUi->lblUnplacedComponentsNote->hide();
@@ -110,6 +114,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
   mGraphicsView = new GraphicsView(nullptr, this);
   mGraphicsView->setUseOpenGl(
       mProjectEditor.getWorkspace().getSettings().useOpenGl.get());
+  mGraphicsView->setUseTileCache(true);  // boards are expensive to render
   mGraphicsView->setBackgroundBrush(Qt::black);
   mGraphicsView->setForegroundBrush(Qt::white);
   // setCentralWidget(mGraphicsView);
@@ -189,6 +194,11 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
           &BoardEditor::highlightDrcMessage);
   addDockWidget(Qt::RightDockWidgetArea, mDrcMessagesDock.data());
   tabifyDockWidget(mErcMsgDock, mDrcMessagesDock.data());
+  mPerformanceDock.reset(new BoardPerformanceDock(mProjectEditor.getUndoStack(),
+                                                  *mGraphicsView, this));
+  addDockWidget(Qt::RightDockWidgetArea, mPerformanceDock.data());
+  tabifyDockWidget(mDrcMessagesDock.data(), mPerformanceDock.data());
+  mPerformanceDock->hide();  // only for diagnostics, thus hidden by default
   mUnplacedComponentsDock->raise();
 
   // Add actions to toggle visibility of dock widgets
@@ -197,6 +207,7 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
   mUi->menuView->addAction(mBoardLayersDock->toggleViewAction());
   mUi->menuView->addAction(mErcMsgDock->toggleViewAction());
   mUi->menuView->addAction(mDrcMessagesDock->toggleViewAction());
+  mUi->menuView->addAction(mPerformanceDock->toggleViewAction());
 
   // add all boards to the menu and connect to project signals
   for (int i = 0; i < mProject.getBoards().count(); i++) boardAdded(i);
@@ -265,6 +276,10 @@ BoardEditor::BoardEditor(ProjectEditor& projectEditor, Project& project)
   // Load first board
   if (mProject.getBoards().count() > 0) setActiveBoardIndex(0);
 
+  // Load the other boards in the background once the first one is shown, so
+  // switching to them doesn't need to wait for rebuilding their planes
+  QTimer::singleShot(500, this, &BoardEditor::finishLoadingNextBoard);
+
   // Set focus to graphics view (avoid having the focus in some arbitrary
   // widget).
   mGraphicsView->setFocus();
@@ -294,6 +309,7 @@ BoardEditor::~BoardEditor() {
   delete mErcMsgDock;
   mErcMsgDock = nullptr;
   mDrcMessagesDock.reset();
+  mPerformanceDock.reset();
   delete mGraphicsView;
   mGraphicsView = nullptr;
   delete mUi;
@@ -325,6 +341,7 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept {
     mActiveBoard = newBoard;
     if (mActiveBoard) {
       // show scene, restore view scene rect, set grid properties
+      mActiveBoard->finishLoading();
       mActiveBoard->showInView(*mGraphicsView);
       mGraphicsView->setVisibleSceneRect(mActiveBoard->restoreViewSceneRect());
       mGraphicsView->setGridProperties(mActiveBoard->getGridProperties());
@@ -341,6 +358,7 @@ bool BoardEditor::setActiveBoardIndex(int index) noexcept {
     // update dock widgets
     mUnplacedComponentsDock->setBoard(mActiveBoard);
     mBoardLayersDock->setActiveBoard(mActiveBoard);
+  mPerformanceDock->setActiveBoard(mActiveBoard);
     mDrcMessagesDock->setMessages(mActiveBoard
                                       ? mDrcMessages[mActiveBoard->getUuid()]
                                       : QList<BoardDesignRuleCheckMessage>());
@@ -697,6 +715,7 @@ void BoardEditor::on_actionModifyDesignRules_triggered() {
             [&](const BoardDesignRules& rules) {
               board->getDesignRules() = rules;
               emit board->attributesChanged();
+              emit board->designRulesOrLayersChanged();
             });
     int result              = dialog.exec();
     board->getDesignRules() = originalRules;  // important hack ;)
@@ -714,7 +733,14 @@ void BoardEditor::on_actionDesignRuleCheck_triggered() {
   Board* board = getActiveBoard();
   if (!board) return;
 
-  BoardDesignRuleCheckDialog dialog(*board, mDrcOptions,
+  // Note: The DRC object is a child of the board to make sure it gets deleted
+  // together with the board.
+  QPointer<BoardDesignRuleCheck>& drc = mDrcs[board->getUuid()];
+  if (!drc) {
+    drc = new BoardDesignRuleCheck(*board, mDrcOptions, board);
+  }
+
+  BoardDesignRuleCheckDialog dialog(*drc, mDrcOptions,
                                     mProjectEditor.getDefaultLengthUnit(),
                                     "board_editor/drc_dialog", this);
   dialog.exec();
@@ -733,8 +759,7 @@ void BoardEditor::on_actionDesignRuleCheck_triggered() {
 void BoardEditor::on_actionRebuildPlanes_triggered() {
   Board* board = getActiveBoard();
   if (board) {
-    board->rebuildAllPlanes();
-    board->forceAirWiresRebuild();
+    board->getPlanesRebuilder().schedule();
   }
 }
 
@@ -754,6 +779,39 @@ void BoardEditor::on_actionHideAllPlanes_triggered() {
   }
 }
 
+void BoardEditor::on_actionShowPerformanceOverlay_triggered() {
+  mGraphicsView->setPerformanceOverlayVisible(
+      mUi->actionShowPerformanceOverlay->isChecked());
+}
+
+void BoardEditor::on_actionSavePerformanceStatistics_triggered() {
+  try {
+    QString filename = FileDialog::getSaveFileName(
+        this, tr("Save Performance Statistics"),
+        mProject.getPath().getPathTo("performance.csv").toNative(), "*.csv");
+    if (filename.isEmpty()) return;
+    if (!filename.endsWith(".csv")) filename.append(".csv");
+    FileUtils::writeFile(FilePath(filename),
+                         mGraphicsView->getFrameStatisticsCsv().toUtf8());
+  } catch (Exception& e) {
+    QMessageBox::warning(this, tr("Error"), e.getMsg());
+  }
+}
+
+void BoardEditor::on_actionSaveMemoryReport_triggered() {
+  try {
+    QString filename = FileDialog::getSaveFileName(
+        this, tr("Save Memory Report"),
+        mProject.getPath().getPathTo("memory.txt").toNative(), "*.txt");
+    if (filename.isEmpty()) return;
+    if (!filename.endsWith(".txt")) filename.append(".txt");
+    ProjectMemoryReport report(mProject, &mProjectEditor.getUndoStack());
+    FileUtils::writeFile(FilePath(filename), report.toString().toUtf8());
+  } catch (Exception& e) {
+    QMessageBox::warning(this, tr("Error"), e.getMsg());
+  }
+}
+
 void BoardEditor::on_tabBar_currentChanged(int index) {
   setActiveBoardIndex(index);
 }
@@ -911,6 +969,17 @@ void BoardEditor::clearDrcMarker() noexcept {
   mGraphicsView->setSceneRectMarker(QRectF());
 }
 
+void BoardEditor::finishLoadingNextBoard() noexcept {
+  // Only load one board at a time to keep the UI responsive
+  foreach (Board* board, mProject.getBoards()) {
+    if (!board->isFullyLoaded()) {
+      board->finishLoading();
+      QTimer::singleShot(0, this, &BoardEditor::finishLoadingNextBoard);
+      return;
+    }
+  }
+}
+
 QList<BI_Device*> BoardEditor::getSearchCandidates() noexcept {
   QList<BI_Device*> candidates = {};
   if (Board* board = getActiveBoard()) {
@@ -52,6 +52,7 @@ class ErcMsgDock;
 class UnplacedComponentsDock;
 class BoardLayersDock;
 class BoardDesignRuleCheckMessagesDock;
+class BoardPerformanceDock;
 class BoardEditorFsm;
 
 namespace Ui {
@@ -78,6 +79,9 @@ public:
   ProjectEditor& getProjectEditor() const noexcept { return mProjectEditor; }
   Project&       getProject() const noexcept { return mProject; }
   Board*         getActiveBoard() const noexcept { return mActiveBoard.data(); }
+  const BoardDesignRuleCheck::Options& getDrcOptions() const noexcept {
+    return mDrcOptions;
+  }
 
   // Setters
   bool setActiveBoardIndex(int index) noexcept;
@@ -115,6 +119,9 @@ private slots:
   void on_actionRebuildPlanes_triggered();
   void on_actionShowAllPlanes_triggered();
   void on_actionHideAllPlanes_triggered();
+  void on_actionShowPerformanceOverlay_triggered();
+  void on_actionSavePerformanceStatistics_triggered();
+  void on_actionSaveMemoryReport_triggered();
   void on_tabBar_currentChanged(int index);
   void on_lblUnplacedComponentsNote_linkActivated();
   void boardListActionGroupTriggered(QAction* action);
@@ -132,6 +139,7 @@ private:
   void highlightDrcMessage(const BoardDesignRuleCheckMessage& msg,
                            bool                               zoomTo) noexcept;
   void clearDrcMarker() noexcept;
+  void finishLoadingNextBoard() noexcept;
   QList<BI_Device*> getSearchCandidates() noexcept;
   QStringList       getSearchToolBarCompleterList() noexcept;
   void goToDevice(const QString& name, unsigned int index) noexcept;
@@ -146,6 +154,8 @@ private:
 
   // DRC
   BoardDesignRuleCheck::Options mDrcOptions;
+  QHash<Uuid, QPointer<BoardDesignRuleCheck>>
+      mDrcs;  ///< Key: Board UUID, kept to reuse results of previous runs
   QHash<Uuid, QList<BoardDesignRuleCheckMessage>>
                                     mDrcMessages;  ///< Key: Board UUID
   QScopedPointer<QGraphicsPathItem> mDrcLocationGraphicsItem;
@@ -160,6 +170,7 @@ private:
   UnplacedComponentsDock*                          mUnplacedComponentsDock;
   BoardLayersDock*                                 mBoardLayersDock;
   QScopedPointer<BoardDesignRuleCheckMessagesDock> mDrcMessagesDock;
+  QScopedPointer<BoardPerformanceDock>             mPerformanceDock;
 
   // Finite State Machine
   QScopedPointer<BoardEditorFsm> mFsm;
@@ -0,0 +1,204 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "boardperformancedock.h"
+
+#include "ui_boardperformancedock.h"
+
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/graphics/graphicsview.h>
+#include <librepcb/common/systeminfo.h>
+#include <librepcb/common/undostack.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardplanesrebuilder.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace editor {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BoardPerformanceDock::BoardPerformanceDock(const UndoStack&    undoStack,
+                                           const GraphicsView& view,
+                                           QWidget* parent) noexcept
+  : QDockWidget(parent),
+    mUi(new Ui::BoardPerformanceDock),
+    mUndoStack(undoStack),
+    mGraphicsView(view),
+    mActiveBoard(nullptr),
+    mUpdateTimer(),
+    mItems() {
+  mUi->setupUi(this);
+  mUi->treeWidget->header()->setStretchLastSection(false);
+  mUi->treeWidget->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+  mUi->treeWidget->header()->setSectionResizeMode(
+      1, QHeaderView::ResizeToContents);
+
+  mUpdateTimer.setInterval(sUpdateIntervalMs);
+  connect(&mUpdateTimer, &QTimer::timeout, this,
+          &BoardPerformanceDock::updateCounters);
+  connect(this, &QDockWidget::visibilityChanged, this,
+          &BoardPerformanceDock::visibilityChanged);
+}
+
+BoardPerformanceDock::~BoardPerformanceDock() noexcept {
+}
+
+/*******************************************************************************
+ *  Setters
+ ******************************************************************************/
+
+void BoardPerformanceDock::setActiveBoard(Board* board) noexcept {
+  mActiveBoard = board;
+  mUi->treeWidget->clear();
+  mItems.clear();
+  updateCounters();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void BoardPerformanceDock::visibilityChanged(bool visible) noexcept {
+  if (visible) {
+    updateCounters();
+    mUpdateTimer.start();
+  } else {
+    mUpdateTimer.stop();
+  }
+}
+
+void BoardPerformanceDock::updateCounters() noexcept {
+  if (!isVisible()) {
+    return;
+  }
+
+  if (mActiveBoard) {
+    Board& board     = *mActiveBoard;
+    int    pads      = 0;
+    int    netPoints = 0;
+    int    netLines  = 0;
+    int    vias      = 0;
+    int    fragments = 0;
+    foreach (const BI_Device* device, board.getDeviceInstances()) {
+      pads += device->getFootprint().getPads().count();
+    }
+    foreach (const BI_NetSegment* segment, board.getNetSegments()) {
+      netPoints += segment->getNetPoints().count();
+      netLines += segment->getNetLines().count();
+      vias += segment->getVias().count();
+    }
+    foreach (const BI_Plane* plane, board.getPlanes()) {
+      fragments += plane->getFragments().count();
+    }
+
+    const QString items = tr("Items");
+    setCounter(items, tr("Devices"),
+               QString::number(board.getDeviceInstances().count()));
+    setCounter(items, tr("Pads"), QString::number(pads));
+    setCounter(items, tr("Net Segments"),
+               QString::number(board.getNetSegments().count()));
+    setCounter(items, tr("Net Points"), QString::number(netPoints));
+    setCounter(items, tr("Net Lines"), QString::number(netLines));
+    setCounter(items, tr("Vias"), QString::number(vias));
+    setCounter(items, tr("Planes"), QString::number(board.getPlanes().count()));
+    setCounter(items, tr("Plane Fragments"), QString::number(fragments));
+    setCounter(items, tr("Polygons"),
+               QString::number(board.getPolygons().count()));
+    setCounter(items, tr("Texts"),
+               QString::number(board.getStrokeTexts().count()));
+    setCounter(items, tr("Holes"), QString::number(board.getHoles().count()));
+    setCounter(items, tr("Airwires"),
+               QString::number(board.getAirWires().count()));
+
+    const QString               planes    = tr("Planes");
+    const BoardPlanesRebuilder& rebuilder = board.getPlanesRebuilder();
+    setCounter(planes, tr("Rebuilds"),
+               QString::number(rebuilder.getRebuildCount()));
+    setCounter(planes, tr("Last Rebuild"),
+               tr("%1 ms").arg(rebuilder.getLastRebuildDurationMs()));
+
+    const QString airWires = tr("Airwires");
+    setCounter(airWires, tr("Rebuilds"),
+               QString::number(board.getAirWiresRebuildCount()));
+    setCounter(airWires, tr("Last Rebuild"),
+               tr("%1 ms").arg(board.getLastAirWiresRebuildDurationMs()));
+  }
+
+  const QString         graphics = tr("Graphics");
+  const QGraphicsScene* scene    = mGraphicsView.scene();
+  setCounter(graphics, tr("Scene Items"),
+             QString::number(scene ? scene->items().count() : 0));
+  setCounter(graphics, tr("Last Repaint"),
+             tr("%1 ms").arg(mGraphicsView.getLastFrameTimeMs(), 0, 'f', 1));
+
+  const QString memory = tr("Memory");
+  setCounter(memory, tr("Undo Commands"),
+             QString::number(mUndoStack.getCommandCount()));
+  const qint64 peakMemory = SystemInfo::getPeakMemoryUsage();
+  if (peakMemory >= 0) {
+    setCounter(memory, tr("Peak Process Memory"),
+               tr("%1 MB").arg(peakMemory / (1024 * 1024)));
+  }
+}
+
+void BoardPerformanceDock::setCounter(const QString& group,
+                                      const QString& name,
+                                      const QString& value) noexcept {
+  QTreeWidgetItem* groupItem = mItems.value(group);
+  if (!groupItem) {
+    groupItem = new QTreeWidgetItem(mUi->treeWidget, QStringList{group});
+    groupItem->setExpanded(true);
+    QFont font = groupItem->font(0);
+    font.setBold(true);
+    groupItem->setFont(0, font);
+    mItems.insert(group, groupItem);
+  }
+  const QString    key  = group % "/" % name;
+  QTreeWidgetItem* item = mItems.value(key);
+  if (!item) {
+    item = new QTreeWidgetItem(groupItem, QStringList{name});
+    item->setTextAlignment(1, Qt::AlignRight | Qt::AlignVCenter);
+    mItems.insert(key, item);
+  }
+  item->setText(1, value);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,106 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_PROJECT_EDITOR_BOARDPERFORMANCEDOCK_H
+#define LIBREPCB_PROJECT_EDITOR_BOARDPERFORMANCEDOCK_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class GraphicsView;
+class UndoStack;
+
+namespace project {
+
+class Board;
+
+namespace editor {
+
+namespace Ui {
+class BoardPerformanceDock;
+}
+
+/*******************************************************************************
+ *  Class BoardPerformanceDock
+ ******************************************************************************/
+
+/**
+ * @brief Dock widget displaying live performance counters of a board
+ *
+ * Shows the number of items per type together with the duration of the
+ * expensive background operations (plane and airwire rebuilds) and of the
+ * last repaint. This allows users to find out which features of their board
+ * make the editor slow, without running a profiler.
+ *
+ * The counters are only refreshed periodically while the dock is visible, so
+ * a hidden dock does not cost any performance.
+ */
+class BoardPerformanceDock final : public QDockWidget {
+  Q_OBJECT
+
+public:
+  // Constructors / Destructor
+  BoardPerformanceDock()                                  = delete;
+  BoardPerformanceDock(const BoardPerformanceDock& other) = delete;
+  BoardPerformanceDock(const UndoStack& undoStack, const GraphicsView& view,
+                       QWidget* parent = nullptr) noexcept;
+  ~BoardPerformanceDock() noexcept;
+
+  // Setters
+  void setActiveBoard(Board* board) noexcept;
+
+  // Operator Overloadings
+  BoardPerformanceDock& operator=(const BoardPerformanceDock& rhs) = delete;
+
+private:  // Methods
+  void visibilityChanged(bool visible) noexcept;
+  void updateCounters() noexcept;
+  void setCounter(const QString& group, const QString& name,
+                  const QString& value) noexcept;
+
+private:  // Data
+  QScopedPointer<Ui::BoardPerformanceDock> mUi;
+  const UndoStack&                         mUndoStack;
+  const GraphicsView&                      mGraphicsView;
+  QPointer<Board>                          mActiveBoard;
+  QTimer                                   mUpdateTimer;
+
+  /// Tree items of all counters, key: group + name
+  QHash<QString, QTreeWidgetItem*> mItems;
+
+  static const int sUpdateIntervalMs = 1000;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace editor
+}  // namespace project
+}  // namespace librepcb
+
+#endif  // LIBREPCB_PROJECT_EDITOR_BOARDPERFORMANCEDOCK_H
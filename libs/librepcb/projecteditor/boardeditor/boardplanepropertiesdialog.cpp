@@ -105,6 +105,20 @@ BoardPlanePropertiesDialog::BoardPlanePropertiesDialog(
 
   // vertices
   mUi->pathEditorWidget->setPath(mPlane.getOutline());
+
+  // statistics of the last fragments calculation
+  const BI_Plane::RebuildStatistics& stats = mPlane.getRebuildStatistics();
+  if (stats.durationMs >= 0) {
+    mUi->lblRebuildStatistics->setText(
+        tr("%1 ms, %2 obstacle(s), %3 vertices (%4 removed by "
+           "simplification)")
+            .arg(stats.durationMs)
+            .arg(stats.obstacleCount)
+            .arg(stats.vertexCount)
+            .arg(stats.removedVertexCount));
+  } else {
+    mUi->lblRebuildStatistics->setText(tr("Not rebuilt yet"));
+  }
 }
 
 BoardPlanePropertiesDialog::~BoardPlanePropertiesDialog() noexcept {
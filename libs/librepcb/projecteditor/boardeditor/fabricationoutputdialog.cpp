@@ -25,6 +25,7 @@
 #include "ui_fabricationoutputdialog.h"
 
 #include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/taskscheduler.h>
 #include <librepcb/project/boards/board.h>
 #include <librepcb/project/boards/boardfabricationoutputsettings.h>
 #include <librepcb/project/boards/boardgerberexport.h>
@@ -50,6 +51,10 @@ FabricationOutputDialog::FabricationOutputDialog(Board& board, QWidget* parent)
     mBoard(board),
     mUi(new Ui::FabricationOutputDialog) {
   mUi->setupUi(this);
+  mUi->prgExport->hide();
+  mUi->lstExportLog->hide();
+  connect(&mExportWatcher, &QFutureWatcher<void>::finished, this,
+          &FabricationOutputDialog::exportFinished);
   connect(mUi->cbxDrillsMerge, &QCheckBox::toggled, mUi->edtSuffixDrills,
           &QLineEdit::setEnabled);
   connect(mUi->cbxDrillsMerge, &QCheckBox::toggled, mUi->edtSuffixDrillsNpth,
@@ -79,6 +84,7 @@ FabricationOutputDialog::FabricationOutputDialog(Board& board, QWidget* parent)
   mUi->cbxDrillsMerge->setChecked(s.getMergeDrillFiles());
   mUi->cbxSolderPasteTop->setChecked(s.getEnableSolderPasteTop());
   mUi->cbxSolderPasteBot->setChecked(s.getEnableSolderPasteBot());
+  mUi->cbxCopperMergeRegions->setChecked(s.getMergeCopperRegions());
 
   QStringList topSilkscreen = s.getSilkscreenLayersTop();
   mUi->cbxSilkTopPlacement->setChecked(
@@ -98,10 +104,21 @@ FabricationOutputDialog::FabricationOutputDialog(Board& board, QWidget* parent)
 }
 
 FabricationOutputDialog::~FabricationOutputDialog() {
+  abortExport();
   delete mUi;
   mUi = nullptr;
 }
 
+/*******************************************************************************
+ *  Public Slots
+ ******************************************************************************/
+
+void FabricationOutputDialog::reject() {
+  // Don't leave the export running in the background, it accesses this dialog.
+  abortExport();
+  QDialog::reject();
+}
+
 /*******************************************************************************
  *  Private Slots
  ******************************************************************************/
@@ -141,39 +158,17 @@ void FabricationOutputDialog::on_btnProtelSuffixes_clicked() {
 }
 
 void FabricationOutputDialog::on_btnGenerate_clicked() {
-  try {
-    // rebuild planes because they may be outdated!
-    mBoard.rebuildAllPlanes();
-
-    // update fabrication output settings if modified
-    BoardFabricationOutputSettings s = mBoard.getFabricationOutputSettings();
-    s.setOutputBasePath(mUi->edtBasePath->text().trimmed());
-    s.setSuffixDrills(mUi->edtSuffixDrills->text().trimmed());
-    s.setSuffixDrillsNpth(mUi->edtSuffixDrillsNpth->text().trimmed());
-    s.setSuffixDrillsPth(mUi->edtSuffixDrillsPth->text().trimmed());
-    s.setSuffixOutlines(mUi->edtSuffixOutlines->text().trimmed());
-    s.setSuffixCopperTop(mUi->edtSuffixCopperTop->text().trimmed());
-    s.setSuffixCopperInner(mUi->edtSuffixCopperInner->text().trimmed());
-    s.setSuffixCopperBot(mUi->edtSuffixCopperBot->text().trimmed());
-    s.setSuffixSolderMaskTop(mUi->edtSuffixSoldermaskTop->text().trimmed());
-    s.setSuffixSolderMaskBot(mUi->edtSuffixSoldermaskBot->text().trimmed());
-    s.setSuffixSilkscreenTop(mUi->edtSuffixSilkscreenTop->text().trimmed());
-    s.setSuffixSilkscreenBot(mUi->edtSuffixSilkscreenBot->text().trimmed());
-    s.setSuffixSolderPasteTop(mUi->edtSuffixSolderPasteTop->text().trimmed());
-    s.setSuffixSolderPasteBot(mUi->edtSuffixSolderPasteBot->text().trimmed());
-    s.setSilkscreenLayersTop(getTopSilkscreenLayers());
-    s.setSilkscreenLayersBot(getBotSilkscreenLayers());
-    s.setMergeDrillFiles(mUi->cbxDrillsMerge->isChecked());
-    s.setEnableSolderPasteTop(mUi->cbxSolderPasteTop->isChecked());
-    s.setEnableSolderPasteBot(mUi->cbxSolderPasteBot->isChecked());
-    if (s != mBoard.getFabricationOutputSettings()) {
-      mBoard.getFabricationOutputSettings() = s;  // TODO: use undo command
-    }
+  if (mExport) {
+    mExport->abort();  // the button is a cancel button while exporting
+    mUi->btnGenerate->setEnabled(false);
+    return;
+  }
 
-    // generate files
-    BoardGerberExport grbExport(mBoard, mBoard.getFabricationOutputSettings());
-    grbExport.exportAllLayers();
+  try {
+    startExport();  // can throw
   } catch (Exception& e) {
+    mExport.reset();
+    mBoardSnapshot.reset();
     QMessageBox::warning(this, tr("Error"), e.getMsg());
   }
 }
@@ -188,10 +183,111 @@ void FabricationOutputDialog::on_btnBrowseOutputDir_clicked() {
   }
 }
 
+void FabricationOutputDialog::exportFinished() noexcept {
+  try {
+    mExportWatcher.waitForFinished();  // re-throws exceptions of the export
+    addLogMessage(tr("Finished in %1 ms, %2 files written.")
+                      .arg(mExportTimer.elapsed())
+                      .arg(mExport->getWrittenFiles().count()));
+  } catch (const UserCanceled&) {
+    addLogMessage(tr("Canceled."));
+  } catch (const Exception& e) {
+    addLogMessage(tr("Failed: %1").arg(e.getMsg()));
+    QMessageBox::warning(this, tr("Error"), e.getMsg());
+  }
+  // The snapshot must be destroyed in the main thread.
+  mExport.reset();
+  mBoardSnapshot.reset();
+  setExportRunning(false);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+void FabricationOutputDialog::startExport() {
+  // rebuild planes because they may be outdated!
+  mBoard.rebuildAllPlanes();
+
+  // update fabrication output settings if modified
+  BoardFabricationOutputSettings s = mBoard.getFabricationOutputSettings();
+  s.setOutputBasePath(mUi->edtBasePath->text().trimmed());
+  s.setSuffixDrills(mUi->edtSuffixDrills->text().trimmed());
+  s.setSuffixDrillsNpth(mUi->edtSuffixDrillsNpth->text().trimmed());
+  s.setSuffixDrillsPth(mUi->edtSuffixDrillsPth->text().trimmed());
+  s.setSuffixOutlines(mUi->edtSuffixOutlines->text().trimmed());
+  s.setSuffixCopperTop(mUi->edtSuffixCopperTop->text().trimmed());
+  s.setSuffixCopperInner(mUi->edtSuffixCopperInner->text().trimmed());
+  s.setSuffixCopperBot(mUi->edtSuffixCopperBot->text().trimmed());
+  s.setSuffixSolderMaskTop(mUi->edtSuffixSoldermaskTop->text().trimmed());
+  s.setSuffixSolderMaskBot(mUi->edtSuffixSoldermaskBot->text().trimmed());
+  s.setSuffixSilkscreenTop(mUi->edtSuffixSilkscreenTop->text().trimmed());
+  s.setSuffixSilkscreenBot(mUi->edtSuffixSilkscreenBot->text().trimmed());
+  s.setSuffixSolderPasteTop(mUi->edtSuffixSolderPasteTop->text().trimmed());
+  s.setSuffixSolderPasteBot(mUi->edtSuffixSolderPasteBot->text().trimmed());
+  s.setSilkscreenLayersTop(getTopSilkscreenLayers());
+  s.setSilkscreenLayersBot(getBotSilkscreenLayers());
+  s.setMergeDrillFiles(mUi->cbxDrillsMerge->isChecked());
+  s.setEnableSolderPasteTop(mUi->cbxSolderPasteTop->isChecked());
+  s.setEnableSolderPasteBot(mUi->cbxSolderPasteBot->isChecked());
+  s.setMergeCopperRegions(mUi->cbxCopperMergeRegions->isChecked());
+  if (s != mBoard.getFabricationOutputSettings()) {
+    mBoard.getFabricationOutputSettings() = s;  // TODO: use undo command
+  }
+
+  // Generate the files in the background from a snapshot of the board, so
+  // the GUI stays responsive and the board may be modified meanwhile.
+  mBoardSnapshot = mBoard.createSnapshot();  // can throw
+  mExport.reset(new BoardGerberExport(*mBoardSnapshot, s));
+  connect(mExport.data(), &BoardGerberExport::exportProgress, this,
+          [this](int finished, int total) {
+            mUi->prgExport->setMaximum(total);
+            mUi->prgExport->setValue(finished);
+          },
+          Qt::QueuedConnection);
+  connect(mExport.data(), &BoardGerberExport::fileExported, this,
+          [this](const FilePath& fp, bool reused, qint64 durationMs) {
+            QString msg = reused ? tr("%1 (unchanged, %2 ms)")
+                                 : tr("%1 (%2 ms)");
+            addLogMessage(msg.arg(fp.getFilename()).arg(durationMs));
+          },
+          Qt::QueuedConnection);
+  mUi->lstExportLog->clear();
+  setExportRunning(true);
+  mExportTimer.start();
+  const BoardGerberExport* exp = mExport.data();
+  mExportWatcher.setFuture(TaskScheduler::run(
+      TaskScheduler::Priority::Normal, [exp]() { exp->exportAllLayers(); }));
+}
+
+void FabricationOutputDialog::abortExport() noexcept {
+  if (mExport) {
+    mExport->abort();
+    try {
+      mExportWatcher.waitForFinished();  // can throw
+    } catch (...) {
+      // ignore errors, the user is not interested in the result anymore
+    }
+  }
+}
+
+void FabricationOutputDialog::setExportRunning(bool running) noexcept {
+  mUi->btnGenerate->setText(running ? tr("Cancel")
+                                    : tr("Generate Gerber && Excellon Files"));
+  mUi->btnGenerate->setEnabled(true);
+  mUi->prgExport->setVisible(running);
+  mUi->prgExport->setValue(0);
+  mUi->lstExportLog->setVisible(true);
+  mUi->edtBasePath->setEnabled(!running);
+  mUi->btnDefaultSuffixes->setEnabled(!running);
+  mUi->btnProtelSuffixes->setEnabled(!running);
+}
+
+void FabricationOutputDialog::addLogMessage(const QString& msg) noexcept {
+  mUi->lstExportLog->addItem(msg);
+  mUi->lstExportLog->scrollToBottom();
+}
+
 QStringList FabricationOutputDialog::getTopSilkscreenLayers() const noexcept {
   QStringList layers;
   if (mUi->cbxSilkTopPlacement->isChecked()) {
@@ -26,6 +26,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -34,6 +36,7 @@ namespace project {
 
 class Project;
 class Board;
+class BoardGerberExport;
 
 namespace editor {
 
@@ -58,19 +61,33 @@ public:
   explicit FabricationOutputDialog(Board& board, QWidget* parent = 0);
   ~FabricationOutputDialog();
 
+public slots:
+  void reject() override;
+
 private slots:
   void on_btnDefaultSuffixes_clicked();
   void on_btnProtelSuffixes_clicked();
   void on_btnGenerate_clicked();
   void on_btnBrowseOutputDir_clicked();
+  void exportFinished() noexcept;
 
 private:
+  void        startExport();
+  void        abortExport() noexcept;
+  void        setExportRunning(bool running) noexcept;
+  void        addLogMessage(const QString& msg) noexcept;
   QStringList getTopSilkscreenLayers() const noexcept;
   QStringList getBotSilkscreenLayers() const noexcept;
 
   Project&                     mProject;
   Board&                       mBoard;
   Ui::FabricationOutputDialog* mUi;
+
+  // The export runs in the background on a snapshot of the board
+  std::unique_ptr<Board>            mBoardSnapshot;
+  QScopedPointer<BoardGerberExport> mExport;
+  QFutureWatcher<void>              mExportWatcher;
+  QElapsedTimer                     mExportTimer;
 };
 
 /*******************************************************************************
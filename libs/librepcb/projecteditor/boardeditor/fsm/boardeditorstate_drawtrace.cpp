@@ -27,6 +27,7 @@
 #include "../boardeditor.h"
 #include "ui_boardeditor.h"
 
+#include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/graphicsview.h>
 #include <librepcb/common/toolbox.h>
 #include <librepcb/common/undostack.h>
@@ -748,6 +749,7 @@ bool BoardEditorState_DrawTrace::abortPositioning(bool showErrMsgBox) noexcept {
     mPositioningNetPoint2 = nullptr;
     mTempVia              = nullptr;
     mAddVia               = false;
+    mClearanceViolationsGraphicsItem.reset();
     showVia(false);
     if (mSubState != SubState_Idle) {
       mContext.undoStack.abortCmdGroup();  // can throw
@@ -879,6 +881,8 @@ void BoardEditorState_DrawTrace::updateNetpointPositions() noexcept {
   // Force updating airwires immediately as they are important for creating
   // traces.
   board.triggerAirWiresRebuild();
+
+  updateClearanceViolations();
 }
 
 void BoardEditorState_DrawTrace::showVia(bool isVisible) noexcept {
@@ -925,6 +929,90 @@ void BoardEditorState_DrawTrace::showVia(bool isVisible) noexcept {
   }
 }
 
+void BoardEditorState_DrawTrace::updateClearanceViolations() noexcept {
+  // Limit the time spent per mouse move, the check is only a preview.
+  const qint64  timeBudgetMs = 10;
+  QElapsedTimer timer;
+  timer.start();
+
+  Board&           board     = mPositioningNetPoint1->getBoard();
+  const NetSignal& netsignal = mCurrentNetSegment->getNetSignal();
+  Length           clearance =
+      *mContext.editor.getDrcOptions().minCopperCopperClearance;
+
+  // Expand the active copper objects by the clearance, then any copper of
+  // other net signals intersecting them is too close. Note that the via is
+  // on all copper layers, so it is checked against all layers.
+  QList<QPair<QPainterPath, const GraphicsLayer*>> activeAreas;
+  for (BI_NetLine* netline : {mPositioningNetLine1, mPositioningNetLine2}) {
+    activeAreas.append(
+        qMakePair(netline->getSceneOutline(clearance).toQPainterPathPx(),
+                  &netline->getLayer()));
+  }
+  if (mTempVia) {
+    activeAreas.append(
+        qMakePair(mTempVia->toQPainterPathPx(clearance),
+                  static_cast<const GraphicsLayer*>(nullptr)));
+  }
+
+  QPainterPath   violations;
+  QSet<BI_Base*> violatingItems;
+  for (const auto& area : activeAreas) {
+    if (timer.elapsed() > timeBudgetMs) break;
+    const QString layerName = area.second ? area.second->getName() : QString();
+    foreach (BI_Base* item,
+             board.getItemsInSceneRect(area.first.boundingRect())) {
+      if (timer.elapsed() > timeBudgetMs) break;
+      if (violatingItems.contains(item)) continue;
+      QPainterPath copper;
+      switch (item->getType()) {
+        case BI_Base::Type_t::NetLine: {
+          BI_NetLine* netline = static_cast<BI_NetLine*>(item);
+          if ((&netline->getNetSignalOfNetSegment() != &netsignal) &&
+              ((!area.second) || (&netline->getLayer() == area.second))) {
+            copper = netline->getSceneOutline().toQPainterPathPx();
+          }
+          break;
+        }
+        case BI_Base::Type_t::Via: {
+          BI_Via* via = static_cast<BI_Via*>(item);
+          if (&via->getNetSignalOfNetSegment() != &netsignal) {
+            copper = via->toQPainterPathPx();
+          }
+          break;
+        }
+        case BI_Base::Type_t::FootprintPad: {
+          BI_FootprintPad* pad = static_cast<BI_FootprintPad*>(item);
+          if ((pad->getCompSigInstNetSignal() != &netsignal) &&
+              ((!area.second) || pad->isOnLayer(layerName))) {
+            copper = pad->getSceneOutline().toQPainterPathPx();
+          }
+          break;
+        }
+        default:
+          break;
+      }
+      if ((!copper.isEmpty()) && area.first.intersects(copper)) {
+        violations.addPath(copper);
+        violatingItems.insert(item);
+      }
+    }
+  }
+
+  if (violations.isEmpty()) {
+    mClearanceViolationsGraphicsItem.reset();
+  } else {
+    if (!mClearanceViolationsGraphicsItem) {
+      mClearanceViolationsGraphicsItem.reset(new QGraphicsPathItem());
+      mClearanceViolationsGraphicsItem->setZValue(Board::ZValue_AirWires);
+      mClearanceViolationsGraphicsItem->setPen(Qt::NoPen);
+      mClearanceViolationsGraphicsItem->setBrush(QColor(255, 127, 0, 150));
+      board.getGraphicsScene().addItem(mClearanceViolationsGraphicsItem.data());
+    }
+    mClearanceViolationsGraphicsItem->setPath(violations);
+  }
+}
+
 BI_NetLineAnchor* BoardEditorState_DrawTrace::combineAnchors(
     BI_NetLineAnchor& a, BI_NetLineAnchor& b) {
   BI_NetPoint*      removePoint = nullptr;
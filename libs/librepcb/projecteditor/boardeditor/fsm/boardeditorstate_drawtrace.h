@@ -233,6 +233,19 @@ private:
    */
   void showVia(bool isVisible) noexcept;
 
+  /**
+   * @brief Check the clearance of the currently active trace
+   *
+   * Only the geometry of the traces (and the via) which are currently
+   * positioned is checked against the copper objects of other net signals
+   * next to them, which are looked up in the spatial index of the board. The
+   * check is aborted if it takes longer than a few milliseconds to keep the
+   * mouse movement smooth, so it is just a preview and does not replace
+   * the design rule check. Copper objects which violate the clearance are
+   * highlighted.
+   */
+  void updateClearanceViolations() noexcept;
+
   BI_NetLineAnchor* combineAnchors(BI_NetLineAnchor& a, BI_NetLineAnchor& b);
 
   // Callback Functions for the Gui elements
@@ -283,6 +296,9 @@ private:
   BI_NetLine*  mPositioningNetLine2;     ///< line between p1 and p2
   BI_NetPoint* mPositioningNetPoint2;    ///< the second netpoint to place
 
+  /// Highlights copper objects violating the clearance to the active trace
+  QScopedPointer<QGraphicsPathItem> mClearanceViolationsGraphicsItem;
+
   // Widgets for the command toolbar
   QHash<WireMode, QAction*>          mWireModeActions;
   QList<QAction*>                    mActionSeparators;
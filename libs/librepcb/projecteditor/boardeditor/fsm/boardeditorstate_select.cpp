@@ -75,7 +75,15 @@ namespace editor {
 
 BoardEditorState_Select::BoardEditorState_Select(
     const Context& context) noexcept
-  : BoardEditorState(context), mCurrentSelectionIndex(0) {
+  : BoardEditorState(context),
+    mCurrentSelectionIndex(0),
+    mDragUpdateTimer(),
+    mPendingDragPos(),
+    mDragUpdatePending(false) {
+  mDragUpdateTimer.setSingleShot(true);
+  mDragUpdateTimer.setInterval(sDragUpdateIntervalMs);
+  connect(&mDragUpdateTimer, &QTimer::timeout, this,
+          &BoardEditorState_Select::applyPendingDragPosition);
 }
 
 BoardEditorState_Select::~BoardEditorState_Select() noexcept {
@@ -90,6 +98,7 @@ bool BoardEditorState_Select::entry() noexcept {
 }
 
 bool BoardEditorState_Select::exit() noexcept {
+  discardPendingDragPosition();
   mSelectedItemsDragCommand.reset();
   return true;
 }
@@ -138,9 +147,13 @@ bool BoardEditorState_Select::processGraphicsSceneMouseMoved(
   if (!board) return false;
 
   if (mSelectedItemsDragCommand) {
-    // Move selected elements to cursor position
-    Point pos = Point::fromPx(e.scenePos());
-    mSelectedItemsDragCommand->setCurrentPosition(pos);
+    // Move selected elements to cursor position, but at most once per frame.
+    // The first movement is applied immediately to keep the latency low.
+    mPendingDragPos    = Point::fromPx(e.scenePos());
+    mDragUpdatePending = true;
+    if (!mDragUpdateTimer.isActive()) {
+      applyPendingDragPosition();
+    }
     return true;
   } else if (e.buttons().testFlag(Qt::LeftButton)) {
     // Draw selection rectangle
@@ -202,6 +215,7 @@ bool BoardEditorState_Select::processGraphicsSceneLeftMouseButtonReleased(
 
   if (mSelectedItemsDragCommand) {
     // Stop moving items (set position of all selected elements permanent)
+    discardPendingDragPosition();  // superseded by the release position
     Point pos = Point::fromPx(e.scenePos());
     mSelectedItemsDragCommand->setCurrentPosition(pos);
     try {
@@ -229,6 +243,7 @@ bool BoardEditorState_Select::processGraphicsSceneLeftMouseButtonDoubleClicked(
 #if (QT_VERSION < QT_VERSION_CHECK(5, 3, 0))
   if (mSelectedItemsDragCommand) {
     // Abort moving and handle double click
+    discardPendingDragPosition();
     mSelectedItemsDragCommand.reset();
   }
 #endif
@@ -295,10 +310,19 @@ bool BoardEditorState_Select::processGraphicsSceneRightMouseButtonReleased(
         addActionSnap(menu, devInst.getPosition(), *board, *selectedItem);
         QAction* aResetTexts = menu.addAction(QIcon(":/img/actions/undo.png"),
                                               tr("Reset all texts"));
-        connect(aResetTexts, &QAction::triggered, [this, footprint]() {
+        connect(aResetTexts, &QAction::triggered, [this, board]() {
+          // reset the texts of all selected footprints at once
+          QList<BI_Footprint*> footprints;
+          foreach (BI_Base* item, board->getSelectedItems()) {
+            if (item->getType() == BI_Base::Type_t::Footprint) {
+              BI_Footprint* fpt = dynamic_cast<BI_Footprint*>(item);
+              Q_ASSERT(fpt);
+              footprints.append(fpt);
+            }
+          }
           try {
             mContext.undoStack.execCmd(
-                new CmdFootprintStrokeTextsReset(*footprint));
+                new CmdFootprintStrokeTextsReset(footprints));
           } catch (const Exception& e) {
             QMessageBox::critical(parentWidget(), tr("Error"), e.getMsg());
           }
@@ -570,12 +594,26 @@ bool BoardEditorState_Select::startMovingSelectedItems(
   return true;
 }
 
+void BoardEditorState_Select::applyPendingDragPosition() noexcept {
+  if (mSelectedItemsDragCommand && mDragUpdatePending) {
+    mSelectedItemsDragCommand->setCurrentPosition(mPendingDragPos);
+    mDragUpdateTimer.start();  // no further update within this frame
+  }
+  mDragUpdatePending = false;
+}
+
+void BoardEditorState_Select::discardPendingDragPosition() noexcept {
+  mDragUpdateTimer.stop();
+  mDragUpdatePending = false;
+}
+
 bool BoardEditorState_Select::rotateSelectedItems(const Angle& angle) noexcept {
   Board* board = getActiveBoard();
   if (!board) return false;
 
   try {
     if (mSelectedItemsDragCommand) {
+      applyPendingDragPosition();  // rotate around the current position
       mSelectedItemsDragCommand->rotate(angle);
     } else {
       QScopedPointer<CmdDragSelectedBoardItems> cmd(
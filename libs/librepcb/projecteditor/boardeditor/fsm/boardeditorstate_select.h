@@ -125,6 +125,8 @@ private:  // Methods
 
   // Actions
   bool startMovingSelectedItems(Board& board, const Point& startPos) noexcept;
+  void applyPendingDragPosition() noexcept;
+  void discardPendingDragPosition() noexcept;
   bool rotateSelectedItems(const Angle& angle) noexcept;
   bool flipSelectedItems(Qt::Orientation orientation) noexcept;
   bool removeSelectedItems() noexcept;
@@ -171,6 +173,14 @@ private:  // Data
   /// When moving items, this undo command will be active
   QScopedPointer<CmdDragSelectedBoardItems> mSelectedItemsDragCommand;
   int                                       mCurrentSelectionIndex;
+
+  /// Mouse move events may arrive much more often than the screen gets
+  /// refreshed, but each drag update modifies lots of items. Thus the
+  /// cursor position is applied at most once per this interval.
+  static constexpr int sDragUpdateIntervalMs = 16;  // ~60 FPS
+  QTimer mDragUpdateTimer;    ///< Running until the next update is allowed
+  Point  mPendingDragPos;     ///< Last cursor position while dragging
+  bool   mDragUpdatePending;  ///< Whether #mPendingDragPos is not applied yet
 };
 
 /*******************************************************************************
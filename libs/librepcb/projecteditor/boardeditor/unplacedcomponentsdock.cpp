@@ -26,7 +26,6 @@
 #include "../projecteditor.h"
 #include "ui_unplacedcomponentsdock.h"
 
-#include <librepcb/common/fileio/transactionalfilesystem.h>
 #include <librepcb/common/graphics/defaultgraphicslayerprovider.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/graphicsview.h>
@@ -42,6 +41,7 @@
 #include <librepcb/project/project.h>
 #include <librepcb/project/settings/projectsettings.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
 #include <librepcb/workspace/workspace.h>
 
 #include <QtCore>
@@ -74,7 +74,8 @@ UnplacedComponentsDock::UnplacedComponentsDock(ProjectEditor& editor)
     mCircuitConnection2(),
     mBoardConnection1(),
     mBoardConnection2(),
-    mDisableListUpdate(false) {
+    mDisableListUpdate(false),
+    mSelectedComponentUpdatePending(false) {
   mUi->setupUi(this);
   mFootprintPreviewGraphicsScene = new GraphicsScene();
   mUi->graphicsView->setBackgroundBrush(QBrush(Qt::black, Qt::SolidPattern));
@@ -90,17 +91,21 @@ UnplacedComponentsDock::UnplacedComponentsDock(ProjectEditor& editor)
 
   mCircuitConnection1 =
       connect(&mProject.getCircuit(), &Circuit::componentAdded,
-              [this](ComponentInstance& cmp) {
-                Q_UNUSED(cmp);
-                updateComponentsList();
-              });
+              [this](ComponentInstance& cmp) { addComponentToList(cmp); });
   mCircuitConnection2 =
       connect(&mProject.getCircuit(), &Circuit::componentRemoved,
               [this](ComponentInstance& cmp) {
-                Q_UNUSED(cmp);
-                updateComponentsList();
+                removeComponentFromList(cmp.getUuid());
               });
 
+  // While the undo stack modifies the project, components/devices might be
+  // added or removed one by one, so postpone loading the device suggestions
+  // of the selected component until the undo stack has finished.
+  connect(&mProjectEditor.getUndoStack(), &UndoStack::stateModified, this,
+          [this]() {
+            if (mSelectedComponentUpdatePending) updateSelectedComponent();
+          });
+
   updateComponentsList();
 }
 
@@ -149,13 +154,11 @@ void UnplacedComponentsDock::setBoard(Board* board) {
   if (board) {
     mBoardConnection1 =
         connect(board, &Board::deviceAdded, [this](BI_Device& c) {
-          Q_UNUSED(c);
-          updateComponentsList();
+          removeComponentFromList(c.getComponentInstance().getUuid());
         });
     mBoardConnection2 =
         connect(board, &Board::deviceRemoved, [this](BI_Device& c) {
-          Q_UNUSED(c);
-          updateComponentsList();
+          addComponentToList(c.getComponentInstance());
         });
     mNextPosition = Point::fromMm(0, -20).mappedToGrid(
         board->getGridProperties().getInterval());
@@ -169,16 +172,16 @@ void UnplacedComponentsDock::setBoard(Board* board) {
 
 void UnplacedComponentsDock::on_lstUnplacedComponents_currentItemChanged(
     QListWidgetItem* current, QListWidgetItem* previous) {
+  Q_UNUSED(current);
   Q_UNUSED(previous);
 
-  ComponentInstance* component = nullptr;
-  if (mBoard && current) {
-    tl::optional<Uuid> cmpUuid =
-        Uuid::tryFromString(current->data(Qt::UserRole).toString());
-    if (cmpUuid)
-      component = mProject.getCircuit().getComponentInstanceByUuid(*cmpUuid);
+  if (mProjectEditor.getUndoStack().isBatchActive()) {
+    // the current item might change many times during the modification
+    setSelectedComponentInstance(nullptr);
+    mSelectedComponentUpdatePending = true;
+  } else {
+    updateSelectedComponent();
   }
-  setSelectedComponentInstance(component);
 }
 
 void UnplacedComponentsDock::on_cbxSelectedDevice_currentIndexChanged(
@@ -191,16 +194,16 @@ void UnplacedComponentsDock::on_cbxSelectedDevice_currentIndexChanged(
       devFp = mProjectEditor.getWorkspace().getLibraryDb().getLatestDevice(
           *deviceUuid);
     if (devFp.isValid()) {
-      const library::Device* device = new library::Device(
-          std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-              TransactionalFileSystem::openRO(devFp))));
+      std::shared_ptr<const library::Device> device =
+          mProjectEditor.getWorkspace().getLibraryElementCache().getDevice(
+              devFp);  // can throw
       FilePath pkgFp =
           mProjectEditor.getWorkspace().getLibraryDb().getLatestPackage(
               device->getPackageUuid());
       if (pkgFp.isValid()) {
-        const library::Package* package = new library::Package(
-            std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-                TransactionalFileSystem::openRO(pkgFp))));
+        std::shared_ptr<const library::Package> package =
+            mProjectEditor.getWorkspace().getLibraryElementCache().getPackage(
+                pkgFp);  // can throw
         setSelectedDeviceAndPackage(device, package);
       } else {
         setSelectedDeviceAndPackage(nullptr, nullptr);
@@ -226,7 +229,6 @@ void UnplacedComponentsDock::on_btnAdd_clicked() {
     addDeviceManually(*mSelectedComponent, mSelectedDevice->getUuid(),
                       *mSelectedFootprintUuid);
   }
-  updateComponentsList();
 }
 
 void UnplacedComponentsDock::on_pushButton_clicked() {
@@ -256,6 +258,10 @@ void UnplacedComponentsDock::on_pushButton_clicked() {
 void UnplacedComponentsDock::on_btnAddAll_clicked() {
   if (!mBoard) return;
 
+  // Many components typically share the same library component, so look up
+  // their devices in the workspace library only once.
+  QHash<Uuid, tl::optional<Uuid>> devicesOfLibComponent;
+
   beginUndoCmdGroup();
   for (int i = 0; i < mUi->lstUnplacedComponents->count(); i++) {
     tl::optional<Uuid> componentUuid = Uuid::tryFromString(
@@ -265,13 +271,19 @@ void UnplacedComponentsDock::on_btnAddAll_clicked() {
         mProject.getCircuit().getComponentInstanceByUuid(*componentUuid);
     if (component) {
       try {
-        QList<Uuid> devices =
-            mProjectEditor.getWorkspace()
-                .getLibraryDb()
-                .getDevicesOfComponent(component->getLibComponent().getUuid())
-                .values();
-        if (devices.count() > 0)
-          addNextDeviceToCmdGroup(*component, devices.first(), tl::nullopt);
+        const Uuid& libCmpUuid = component->getLibComponent().getUuid();
+        if (!devicesOfLibComponent.contains(libCmpUuid)) {
+          QList<Uuid> devices = mProjectEditor.getWorkspace()
+                                    .getLibraryDb()
+                                    .getDevicesOfComponent(libCmpUuid)
+                                    .values();
+          devicesOfLibComponent.insert(
+              libCmpUuid,
+              devices.isEmpty() ? tl::nullopt
+                                : tl::make_optional(devices.first()));
+        }
+        tl::optional<Uuid> device = devicesOfLibComponent.value(libCmpUuid);
+        if (device) addNextDeviceToCmdGroup(*component, *device, tl::nullopt);
       } catch (const Exception& e) {
         qCritical() << e.getMsg();
       }
@@ -301,14 +313,9 @@ void UnplacedComponentsDock::updateComponentsList() noexcept {
       if (boardDeviceList.contains(component->getUuid())) continue;
       if (component->getLibComponent().isSchematicOnly()) continue;
 
-      // add component to list
-      CircuitIdentifier name  = component->getName();
-      QString           value = component->getValue(true).replace("\n", "|");
-      ElementName compName    = component->getLibComponent().getNames().value(
-          mProject.getSettings().getLocaleOrder());
-      QString          text = QString("%1: %2 %3").arg(*name, value, *compName);
-      QListWidgetItem* item =
-          new QListWidgetItem(text, mUi->lstUnplacedComponents);
+      // add component to list (sorted by UUID since it's a QMap)
+      QListWidgetItem* item = new QListWidgetItem(
+          getListItemText(*component), mUi->lstUnplacedComponents);
       item->setData(Qt::UserRole, component->getUuid().toStr());
     }
 
@@ -318,11 +325,92 @@ void UnplacedComponentsDock::updateComponentsList() noexcept {
     }
   }
 
+  updateComponentsCount();
+}
+
+void UnplacedComponentsDock::addComponentToList(
+    ComponentInstance& cmp) noexcept {
+  if (mDisableListUpdate || (!mBoard)) return;
+  if (mBoard->getDeviceInstanceByComponentUuid(cmp.getUuid())) return;
+  if (cmp.getLibComponent().isSchematicOnly()) return;
+
+  bool exists = false;
+  int  row    = getListRow(cmp.getUuid(), exists);
+  if (exists) return;
+  QListWidgetItem* item = new QListWidgetItem(getListItemText(cmp));
+  item->setData(Qt::UserRole, cmp.getUuid().toStr());
+  mUi->lstUnplacedComponents->insertItem(row, item);
+  updateComponentsCount();
+}
+
+void UnplacedComponentsDock::removeComponentFromList(
+    const Uuid& cmpUuid) noexcept {
+  if (mDisableListUpdate) return;
+
+  bool exists = false;
+  int  row    = getListRow(cmpUuid, exists);
+  if (!exists) return;
+  if (mSelectedComponent && (mSelectedComponent->getUuid() == cmpUuid)) {
+    setSelectedComponentInstance(nullptr);
+  }
+  // Note: This automatically moves the current item to a neighbour item.
+  delete mUi->lstUnplacedComponents->takeItem(row);
+  updateComponentsCount();
+}
+
+int UnplacedComponentsDock::getListRow(const Uuid& cmpUuid,
+                                       bool&       exists) const noexcept {
+  // the list is sorted by component UUID, so we can do a binary search
+  int lower = 0;
+  int upper = mUi->lstUnplacedComponents->count();
+  while (lower < upper) {
+    int                middle = (lower + upper) / 2;
+    QListWidgetItem*   item   = mUi->lstUnplacedComponents->item(middle);
+    tl::optional<Uuid> uuid =
+        Uuid::tryFromString(item->data(Qt::UserRole).toString());
+    if (uuid && (*uuid < cmpUuid)) {
+      lower = middle + 1;
+    } else {
+      upper = middle;
+    }
+  }
+  exists = (lower < mUi->lstUnplacedComponents->count()) &&
+      (mUi->lstUnplacedComponents->item(lower)->data(Qt::UserRole).toString() ==
+       cmpUuid.toStr());
+  return lower;
+}
+
+QString UnplacedComponentsDock::getListItemText(ComponentInstance& cmp) const
+    noexcept {
+  CircuitIdentifier name     = cmp.getName();
+  QString           value    = cmp.getValue(true).replace("\n", "|");
+  ElementName       compName = cmp.getLibComponent().getNames().value(
+      mProject.getSettings().getLocaleOrder());
+  return QString("%1: %2 %3").arg(*name, value, *compName);
+}
+
+void UnplacedComponentsDock::updateComponentsCount() noexcept {
   setWindowTitle(
       tr("Place Devices [%1]").arg(mUi->lstUnplacedComponents->count()));
   emit unplacedComponentsCountChanged(getUnplacedComponentsCount());
 }
 
+void UnplacedComponentsDock::updateSelectedComponent() noexcept {
+  mSelectedComponentUpdatePending = false;
+
+  ComponentInstance* component = nullptr;
+  QListWidgetItem*   current   = mUi->lstUnplacedComponents->currentItem();
+  if (mBoard && current) {
+    tl::optional<Uuid> cmpUuid =
+        Uuid::tryFromString(current->data(Qt::UserRole).toString());
+    if (cmpUuid)
+      component = mProject.getCircuit().getComponentInstanceByUuid(*cmpUuid);
+  }
+  if (component != mSelectedComponent) {
+    setSelectedComponentInstance(component);
+  }
+}
+
 void UnplacedComponentsDock::setSelectedComponentInstance(
     ComponentInstance* cmp) noexcept {
   setSelectedDeviceAndPackage(nullptr, nullptr);
@@ -392,13 +480,12 @@ void UnplacedComponentsDock::setSelectedComponentInstance(
 }
 
 void UnplacedComponentsDock::setSelectedDeviceAndPackage(
-    const library::Device* device, const library::Package* package) noexcept {
+    std::shared_ptr<const library::Device>  device,
+    std::shared_ptr<const library::Package> package) noexcept {
   setSelectedFootprintUuid(tl::nullopt);
   mUi->cbxSelectedFootprint->clear();
-  delete mSelectedPackage;
-  mSelectedPackage = nullptr;
-  delete mSelectedDevice;
-  mSelectedDevice = nullptr;
+  mSelectedPackage.reset();
+  mSelectedDevice.reset();
 
   if (mBoard && mSelectedComponent && device && package) {
     if (device->getComponentUuid() ==
@@ -440,7 +527,7 @@ void UnplacedComponentsDock::setSelectedFootprintUuid(
     if (fpt) {
       mFootprintPreviewGraphicsItem = new library::FootprintPreviewGraphicsItem(
           *mGraphicsLayerProvider, mProject.getSettings().getLocaleOrder(),
-          *fpt, mSelectedPackage, &mSelectedComponent->getLibComponent(),
+          *fpt, mSelectedPackage.get(), &mSelectedComponent->getLibComponent(),
           mSelectedComponent);
       mFootprintPreviewGraphicsScene->addItem(*mFootprintPreviewGraphicsItem);
       mUi->graphicsView->zoomAll();
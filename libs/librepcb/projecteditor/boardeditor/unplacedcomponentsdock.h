@@ -29,6 +29,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -104,9 +106,14 @@ private:
 
   // Private Methods
   void updateComponentsList() noexcept;
+  void addComponentToList(ComponentInstance& cmp) noexcept;
+  void removeComponentFromList(const Uuid& cmpUuid) noexcept;
+  void updateComponentsCount() noexcept;
+  void updateSelectedComponent() noexcept;
   void setSelectedComponentInstance(ComponentInstance* cmp) noexcept;
-  void setSelectedDeviceAndPackage(const library::Device*  device,
-                                   const library::Package* package) noexcept;
+  void setSelectedDeviceAndPackage(
+      std::shared_ptr<const library::Device>  device,
+      std::shared_ptr<const library::Package> package) noexcept;
   void setSelectedFootprintUuid(const tl::optional<Uuid>& uuid) noexcept;
   void beginUndoCmdGroup() noexcept;
   void addNextDeviceToCmdGroup(
@@ -116,6 +123,9 @@ private:
   void addDeviceManually(ComponentInstance& cmp, const Uuid& deviceUuid,
                          Uuid footprintUuid) noexcept;
 
+  int     getListRow(const Uuid& cmpUuid, bool& exists) const noexcept;
+  QString getListItemText(ComponentInstance& cmp) const noexcept;
+
   // General
   ProjectEditor&                               mProjectEditor;
   Project&                                     mProject;
@@ -125,8 +135,8 @@ private:
   GraphicsScene*                               mFootprintPreviewGraphicsScene;
   library::FootprintPreviewGraphicsItem*       mFootprintPreviewGraphicsItem;
   ComponentInstance*                           mSelectedComponent;
-  const library::Device*                       mSelectedDevice;
-  const library::Package*                      mSelectedPackage;
+  std::shared_ptr<const library::Device>       mSelectedDevice;
+  std::shared_ptr<const library::Package>      mSelectedPackage;
   tl::optional<Uuid>                           mSelectedFootprintUuid;
   QMetaObject::Connection                      mCircuitConnection1;
   QMetaObject::Connection                      mCircuitConnection2;
@@ -134,6 +144,7 @@ private:
   QMetaObject::Connection                      mBoardConnection2;
   Point                                        mNextPosition;
   bool                                         mDisableListUpdate;
+  bool                                         mSelectedComponentUpdatePending;
   QHash<Uuid, Uuid>                            mLastDeviceOfComponent;
   QHash<Uuid, tl::optional<Uuid>>              mLastFootprintOfDevice;
   QScopedPointer<UndoCommandGroup>             mCurrentUndoCmdGroup;
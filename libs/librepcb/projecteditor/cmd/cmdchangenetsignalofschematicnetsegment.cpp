@@ -106,25 +106,30 @@ void CmdChangeNetSignalOfSchematicNetSegment::changeNetSignalOfNetSegment() {
 
   // change netsignal of all connected symbol pins (resp. their component
   // signals)
+  QSet<ComponentSignalInstance*> cmpSigs;
   foreach (SI_SymbolPin* pin, pins) {
     Q_ASSERT(pin);
     ComponentSignalInstance* sig = pin->getComponentSignalInstance();
     if (sig) {
-      updateCompSigInstNetSignal(*sig);
+      cmpSigs.insert(sig);
     }
   }
+  updateCompSigInstNetSignals(cmpSigs);  // can throw
 
   // re-add netsegment
   execNewChildCmd(new CmdSchematicNetSegmentAdd(mNetSegment));  // can throw
 }
 
-void CmdChangeNetSignalOfSchematicNetSegment::updateCompSigInstNetSignal(
-    ComponentSignalInstance& cmpSig) {
-  // disconnect traces from pads in all boards
+void CmdChangeNetSignalOfSchematicNetSegment::updateCompSigInstNetSignals(
+    const QSet<ComponentSignalInstance*>& cmpSigs) {
+  // disconnect traces from pads in all boards, with only one command per board
+  // for all component signals
   QHash<Board*, QSet<BI_NetLine*>> boardNetLinesToRemove;
-  foreach (BI_FootprintPad* pad, cmpSig.getRegisteredFootprintPads()) {
-    Q_ASSERT(pad && pad->isAddedToBoard());
-    boardNetLinesToRemove[&pad->getBoard()] += pad->getNetLines();
+  foreach (const ComponentSignalInstance* cmpSig, cmpSigs) {
+    foreach (BI_FootprintPad* pad, cmpSig->getRegisteredFootprintPads()) {
+      Q_ASSERT(pad && pad->isAddedToBoard());
+      boardNetLinesToRemove[&pad->getBoard()] += pad->getNetLines();
+    }
   }
   for (auto it = boardNetLinesToRemove.constBegin();
        it != boardNetLinesToRemove.constEnd(); ++it) {
@@ -133,9 +138,11 @@ void CmdChangeNetSignalOfSchematicNetSegment::updateCompSigInstNetSignal(
     execNewChildCmd(cmd.take());  // can throw
   }
 
-  // change netsignal of component signal instance
-  execNewChildCmd(
-      new CmdCompSigInstSetNetSignal(cmpSig, &mNewNetSignal));  // can throw
+  // change netsignal of the component signal instances
+  foreach (ComponentSignalInstance* cmpSig, cmpSigs) {
+    execNewChildCmd(
+        new CmdCompSigInstSetNetSignal(*cmpSig, &mNewNetSignal));  // can throw
+  }
 }
 
 /*******************************************************************************
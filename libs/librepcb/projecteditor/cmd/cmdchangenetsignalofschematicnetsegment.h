@@ -65,7 +65,8 @@ private:
   bool performExecute() override;
 
   void changeNetSignalOfNetSegment();
-  void updateCompSigInstNetSignal(ComponentSignalInstance& cmpSig);
+  void updateCompSigInstNetSignals(
+      const QSet<ComponentSignalInstance*>& cmpSigs);
 
   // Private Member Variables
 
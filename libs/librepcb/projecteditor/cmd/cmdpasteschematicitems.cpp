@@ -66,12 +66,12 @@ namespace editor {
  ******************************************************************************/
 
 CmdPasteSchematicItems::CmdPasteSchematicItems(
-    Schematic& schematic, std::unique_ptr<SchematicClipboardData> data,
+    Schematic& schematic, std::shared_ptr<const SchematicClipboardData> data,
     const Point& posOffset) noexcept
   : UndoCommandGroup(tr("Paste Schematic Elements")),
     mProject(schematic.getProject()),
     mSchematic(schematic),
-    mData(std::move(data)),
+    mData(data),
     mPosOffset(posOffset) {
   Q_ASSERT(mData);
 }
@@ -144,7 +144,7 @@ bool CmdPasteSchematicItems::performExecute() {
   }
 
   // Paste symbols
-  QHash<Uuid, Uuid> symbolMap;
+  QHash<Uuid, SI_Symbol*> symbolMap;
   for (const SchematicClipboardData::SymbolInstance& sym :
        mData->getSymbolInstances()) {
     ComponentInstance* cmpInst =
@@ -157,7 +157,7 @@ bool CmdPasteSchematicItems::performExecute() {
         new SI_Symbol(mSchematic, *cmpInst, sym.symbolVariantItemUuid,
                       sym.position + mPosOffset, sym.rotation, sym.mirrored));
     copy->setSelected(true);
-    symbolMap.insert(sym.uuid, copy->getUuid());
+    symbolMap.insert(sym.uuid, copy.data());
     execNewChildCmd(new CmdSymbolInstanceAdd(*copy.take()));
   }
 
@@ -204,8 +204,7 @@ bool CmdPasteSchematicItems::performExecute() {
         start = netPointMap[*nl.startJunction];
         Q_ASSERT(start);
       } else {
-        SI_Symbol* symbol = mSchematic.getSymbolByUuid(
-            symbolMap.value(*nl.startSymbol, Uuid::createRandom()));
+        SI_Symbol* symbol = symbolMap.value(*nl.startSymbol, nullptr);
         Q_ASSERT(symbol);
         SI_SymbolPin* pin = symbol->getPin(*nl.startPin);
         Q_ASSERT(pin);
@@ -223,8 +222,7 @@ bool CmdPasteSchematicItems::performExecute() {
         end = netPointMap[*nl.endJunction];
         Q_ASSERT(end);
       } else {
-        SI_Symbol* symbol = mSchematic.getSymbolByUuid(
-            symbolMap.value(*nl.endSymbol, Uuid::createRandom()));
+        SI_Symbol* symbol = symbolMap.value(*nl.endSymbol, nullptr);
         Q_ASSERT(symbol);
         SI_SymbolPin* pin = symbol->getPin(*nl.endPin);
         Q_ASSERT(pin);
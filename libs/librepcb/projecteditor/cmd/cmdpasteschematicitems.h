@@ -55,8 +55,8 @@ public:
   // Constructors / Destructor
   CmdPasteSchematicItems()                                    = delete;
   CmdPasteSchematicItems(const CmdPasteSchematicItems& other) = delete;
-  CmdPasteSchematicItems(Schematic&                              schematic,
-                         std::unique_ptr<SchematicClipboardData> data,
+  CmdPasteSchematicItems(Schematic& schematic,
+                         std::shared_ptr<const SchematicClipboardData> data,
                          const Point& posOffset) noexcept;
   ~CmdPasteSchematicItems() noexcept;
 
@@ -68,10 +68,10 @@ private:  // Methods
   bool performExecute() override;
 
 private:  // Data
-  Project&                                mProject;
-  Schematic&                              mSchematic;
-  std::unique_ptr<SchematicClipboardData> mData;
-  Point                                   mPosOffset;
+  Project&                                      mProject;
+  Schematic&                                    mSchematic;
+  std::shared_ptr<const SchematicClipboardData> mData;
+  Point                                         mPosOffset;
 };
 
 /*******************************************************************************
@@ -24,7 +24,6 @@
 
 #include "ui_addcomponentdialog.h"
 
-#include <librepcb/common/fileio/transactionalfilesystem.h>
 #include <librepcb/common/graphics/defaultgraphicslayerprovider.h>
 #include <librepcb/common/graphics/graphicsscene.h>
 #include <librepcb/common/graphics/graphicsview.h>
@@ -45,9 +44,11 @@
 #include <librepcb/project/settings/projectsettings.h>
 #include <librepcb/workspace/library/cat/categorytreemodel.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
+#include <librepcb/workspace/library/workspacelibraryelementcache.h>
 #include <librepcb/workspace/settings/workspacesettings.h>
 #include <librepcb/workspace/workspace.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -87,6 +88,12 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace,
   mUi->cbxSymbVar->hide();
   connect(mUi->edtSearch, &QLineEdit::textChanged, this,
           &AddComponentDialog::searchEditTextChanged);
+  mSearchTimer.setSingleShot(true);
+  mSearchTimer.setInterval(sSearchDelayMs);
+  connect(&mSearchTimer, &QTimer::timeout, this,
+          [this]() { searchComponents(mUi->edtSearch->text().trimmed()); });
+  connect(&mSearchWatcher, &QFutureWatcher<SearchResult>::resultsReadyAt, this,
+          &AddComponentDialog::searchResultsReady);
   connect(mUi->treeComponents, &QTreeWidget::currentItemChanged, this,
           &AddComponentDialog::treeComponents_currentItemChanged);
   connect(mUi->treeComponents, &QTreeWidget::itemDoubleClicked, this,
@@ -117,17 +124,16 @@ AddComponentDialog::AddComponentDialog(workspace::Workspace& workspace,
 }
 
 AddComponentDialog::~AddComponentDialog() noexcept {
+  cancelSearch();  // the search does not access this object, no need to wait
   delete mPreviewFootprintGraphicsItem;
   mPreviewFootprintGraphicsItem = nullptr;
   qDeleteAll(mPreviewSymbolGraphicsItems);
   mPreviewSymbolGraphicsItems.clear();
-  delete mSelectedPackage;
-  mSelectedPackage = nullptr;
-  delete mSelectedDevice;
-  mSelectedDevice  = nullptr;
+  mPreviewSymbols.clear();
+  mSelectedPackage.reset();
+  mSelectedDevice.reset();
   mSelectedSymbVar = nullptr;
-  delete mSelectedComponent;
-  mSelectedComponent = nullptr;
+  mSelectedComponent.reset();
   delete mCategoryTreeModel;
   mCategoryTreeModel = nullptr;
   delete mDevicePreviewScene;
@@ -172,10 +178,12 @@ void AddComponentDialog::searchEditTextChanged(const QString& text) noexcept {
   try {
     QModelIndex catIndex = mUi->treeCategories->currentIndex();
     if (text.trimmed().isEmpty() && catIndex.isValid()) {
+      mSearchTimer.stop();
       setSelectedCategory(
           Uuid::tryFromString(catIndex.data(Qt::UserRole).toString()));
     } else {
-      searchComponents(text.trimmed());
+      // don't search on every keystroke, wait until the user stops typing
+      mSearchTimer.start();
     }
   } catch (const Exception& e) {
     QMessageBox::critical(this, tr("Error"), e.getMsg());
@@ -205,20 +213,15 @@ void AddComponentDialog::treeComponents_currentItemChanged(
       FilePath cmpFp = FilePath(cmpItem->data(0, Qt::UserRole).toString());
       if ((!mSelectedComponent) ||
           (mSelectedComponent->getDirectory().getAbsPath() != cmpFp)) {
-        library::Component* component = new library::Component(
-            std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-                TransactionalFileSystem::openRO(cmpFp))));
-        setSelectedComponent(component);
+        setSelectedComponent(
+            mWorkspace.getLibraryElementCache().getComponent(cmpFp));
       }
       if (current->parent()) {
         FilePath devFp = FilePath(current->data(0, Qt::UserRole).toString());
         if ((!mSelectedDevice) ||
             (mSelectedDevice->getDirectory().getAbsPath() != devFp)) {
-          library::Device* device =
-              new library::Device(std::unique_ptr<TransactionalDirectory>(
-                  new TransactionalDirectory(
-                      TransactionalFileSystem::openRO(devFp))));
-          setSelectedDevice(device);
+          setSelectedDevice(
+              mWorkspace.getLibraryElementCache().getDevice(devFp));
         }
       } else {
         setSelectedDevice(nullptr);
@@ -258,115 +261,155 @@ void AddComponentDialog::on_cbxSymbVar_currentIndexChanged(int index) noexcept {
  *  Private Methods
  ******************************************************************************/
 
-void AddComponentDialog::searchComponents(const QString& input) {
+void AddComponentDialog::searchComponents(const QString& input) noexcept {
+  cancelSearch();
   setSelectedComponent(nullptr);
   mUi->treeComponents->clear();
 
-  // min. 2 chars to avoid freeze on entering first character due to huge result
+  // min. 2 chars to avoid a huge result on entering the first character
   if (input.length() > 1) {
-    SearchResult result = searchComponentsAndDevices(input);
-    QHashIterator<FilePath, SearchResultComponent> cmpIt(result);
-    while (cmpIt.hasNext()) {
-      cmpIt.next();
-      QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
-      cmpItem->setText(0, cmpIt.value().name);
-      cmpItem->setData(0, Qt::UserRole, cmpIt.key().toStr());
-      QHashIterator<FilePath, SearchResultDevice> devIt(cmpIt.value().devices);
-      while (devIt.hasNext()) {
-        devIt.next();
-        QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
-        devItem->setText(0, devIt.value().name);
-        devItem->setData(0, Qt::UserRole, devIt.key().toStr());
-        devItem->setText(1, devIt.value().pkgName);
-        devItem->setTextAlignment(1, Qt::AlignRight);
-      }
-      cmpItem->setText(1, QString("[%1]").arg(cmpIt.value().devices.count()));
-      cmpItem->setTextAlignment(1, Qt::AlignRight);
-      cmpItem->setExpanded(!cmpIt.value().match);
-    }
+    // The search runs in a worker thread (the library database provides a
+    // separate connection for each thread) and reports its results in chunks
+    // as they become available. Canceling the future stops the search.
+    QFutureInterface<SearchResult> future;
+    future.reportStarted();
+    mSearchWatcher.setFuture(future.future());
+    const workspace::WorkspaceLibraryDb& db = mWorkspace.getLibraryDb();
+    const QStringList localeOrder = mProject.getSettings().getLocaleOrder();
+    QtConcurrent::run([future, &db, localeOrder, input]() {
+      searchComponentsAndDevices(future, db, localeOrder, input);
+    });
   }
+}
 
-  mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
+void AddComponentDialog::cancelSearch() noexcept {
+  mSearchWatcher.cancel();
+  mSearchWatcher.setFuture(QFuture<SearchResult>());
 }
 
-AddComponentDialog::SearchResult AddComponentDialog::searchComponentsAndDevices(
-    const QString& input) {
-  SearchResult       result;
-  const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
+void AddComponentDialog::searchResultsReady(int begin, int end) noexcept {
+  if (mSearchWatcher.isCanceled()) return;  // stale results
+  for (int i = begin; i < end; ++i) {
+    addSearchResult(mSearchWatcher.resultAt(i));
+  }
+  mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
+}
 
-  // add matching devices and their corresponding components
-  QList<Uuid> devices =
-      mWorkspace.getLibraryDb().getElementsBySearchKeyword<library::Device>(
-          input);  // can throw
-  foreach (const Uuid& devUuid, devices) {
-    FilePath devFp =
-        mWorkspace.getLibraryDb().getLatestDevice(devUuid);  // can throw
-    if (!devFp.isValid()) continue;
-    Uuid cmpUuid = Uuid::createRandom();
-    Uuid pkgUuid = Uuid::createRandom();
-    mWorkspace.getLibraryDb().getDeviceMetadata(devFp, &pkgUuid,
-                                                &cmpUuid);  // can throw
-    FilePath cmpFp =
-        mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);  // can throw
-    if (!cmpFp.isValid()) continue;
-    FilePath pkgFp =
-        mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);  // can throw
-    SearchResultDevice& resDev = result[cmpFp].devices[devFp];
-    resDev.pkgFp               = pkgFp;
-    resDev.match               = true;
+void AddComponentDialog::addSearchResult(const SearchResult& result) noexcept {
+  QHashIterator<FilePath, SearchResultComponent> cmpIt(result);
+  while (cmpIt.hasNext()) {
+    cmpIt.next();
+    QTreeWidgetItem* cmpItem = new QTreeWidgetItem(mUi->treeComponents);
+    cmpItem->setText(0, cmpIt.value().name);
+    cmpItem->setData(0, Qt::UserRole, cmpIt.key().toStr());
+    QHashIterator<FilePath, SearchResultDevice> devIt(cmpIt.value().devices);
+    while (devIt.hasNext()) {
+      devIt.next();
+      QTreeWidgetItem* devItem = new QTreeWidgetItem(cmpItem);
+      devItem->setText(0, devIt.value().name);
+      devItem->setData(0, Qt::UserRole, devIt.key().toStr());
+      devItem->setText(1, devIt.value().pkgName);
+      devItem->setTextAlignment(1, Qt::AlignRight);
+    }
+    cmpItem->setText(1, QString("[%1]").arg(cmpIt.value().devices.count()));
+    cmpItem->setTextAlignment(1, Qt::AlignRight);
+    cmpItem->setExpanded(!cmpIt.value().match);
   }
+}
 
-  // add matching components and all their devices
-  QList<Uuid> components =
-      mWorkspace.getLibraryDb().getElementsBySearchKeyword<library::Component>(
-          input);  // can throw
-  foreach (const Uuid& cmpUuid, components) {
-    FilePath cmpFp =
-        mWorkspace.getLibraryDb().getLatestComponent(cmpUuid);  // can throw
-    if (!cmpFp.isValid()) continue;
-    QSet<Uuid> devices =
-        mWorkspace.getLibraryDb().getDevicesOfComponent(cmpUuid);  // can throw
-    SearchResultComponent& resCmp = result[cmpFp];
-    resCmp.match                  = true;
+void AddComponentDialog::searchComponentsAndDevices(
+    QFutureInterface<SearchResult>       future,
+    const workspace::WorkspaceLibraryDb& db, const QStringList& localeOrder,
+    const QString& input) noexcept {
+  try {
+    SearchResult          result;
+    QHash<FilePath, Uuid> matchingComponents;
+
+    // add matching devices and their corresponding components
+    QList<Uuid> devices =
+        db.getElementsBySearchKeyword<library::Device>(input);  // can throw
     foreach (const Uuid& devUuid, devices) {
-      FilePath devFp =
-          mWorkspace.getLibraryDb().getLatestDevice(devUuid);  // can throw
+      if (future.isCanceled()) break;
+      FilePath devFp = db.getLatestDevice(devUuid);  // can throw
       if (!devFp.isValid()) continue;
-      if (resCmp.devices.contains(devFp)) continue;
+      Uuid cmpUuid = Uuid::createRandom();
       Uuid pkgUuid = Uuid::createRandom();
-      mWorkspace.getLibraryDb().getDeviceMetadata(devFp, &pkgUuid,
-                                                  nullptr);  // can throw
-      FilePath pkgFp =
-          mWorkspace.getLibraryDb().getLatestPackage(pkgUuid);  // can throw
-      SearchResultDevice& resDev = resCmp.devices[devFp];
+      db.getDeviceMetadata(devFp, &pkgUuid, &cmpUuid);  // can throw
+      FilePath cmpFp = db.getLatestComponent(cmpUuid);  // can throw
+      if (!cmpFp.isValid()) continue;
+      FilePath pkgFp = db.getLatestPackage(pkgUuid);  // can throw
+      SearchResultDevice& resDev = result[cmpFp].devices[devFp];
       resDev.pkgFp               = pkgFp;
+      resDev.match               = true;
     }
-  }
 
-  // get name of elements
-  QMutableHashIterator<FilePath, SearchResultComponent> resultIt(result);
-  while (resultIt.hasNext()) {
-    resultIt.next();
-    mWorkspace.getLibraryDb().getElementTranslations<library::Component>(
-        resultIt.key(), localeOrder, &resultIt.value().name);
-    QMutableHashIterator<FilePath, SearchResultDevice> devIt(
-        resultIt.value().devices);
-    while (devIt.hasNext()) {
-      devIt.next();
-      mWorkspace.getLibraryDb().getElementTranslations<library::Device>(
-          devIt.key(), localeOrder, &devIt.value().name);
-      if (devIt.value().pkgFp.isValid()) {
-        mWorkspace.getLibraryDb().getElementTranslations<library::Package>(
-            devIt.value().pkgFp, localeOrder, &devIt.value().pkgName);
+    // add matching components (their devices are added below)
+    QList<Uuid> components =
+        db.getElementsBySearchKeyword<library::Component>(input);  // can throw
+    foreach (const Uuid& cmpUuid, components) {
+      if (future.isCanceled()) break;
+      FilePath cmpFp = db.getLatestComponent(cmpUuid);  // can throw
+      if (!cmpFp.isValid()) continue;
+      result[cmpFp].match = true;
+      matchingComponents.insert(cmpFp, cmpUuid);
+    }
+
+    // complete the components one by one and report them in chunks
+    SearchResult  chunk;
+    QElapsedTimer timer;
+    timer.start();
+    QMutableHashIterator<FilePath, SearchResultComponent> resultIt(result);
+    while (resultIt.hasNext() && (!future.isCanceled())) {
+      resultIt.next();
+      SearchResultComponent& resCmp = resultIt.value();
+      if (matchingComponents.contains(resultIt.key())) {
+        // add all devices of matching components
+        QSet<Uuid> devices = db.getDevicesOfComponent(
+            matchingComponents.value(resultIt.key()));  // can throw
+        foreach (const Uuid& devUuid, devices) {
+          FilePath devFp = db.getLatestDevice(devUuid);  // can throw
+          if (!devFp.isValid()) continue;
+          if (resCmp.devices.contains(devFp)) continue;
+          Uuid pkgUuid = Uuid::createRandom();
+          db.getDeviceMetadata(devFp, &pkgUuid, nullptr);  // can throw
+          resCmp.devices[devFp].pkgFp = db.getLatestPackage(pkgUuid);
+        }
       }
+
+      // get name of elements
+      db.getElementTranslations<library::Component>(
+          resultIt.key(), localeOrder, &resCmp.name);  // can throw
+      QMutableHashIterator<FilePath, SearchResultDevice> devIt(resCmp.devices);
+      while (devIt.hasNext()) {
+        devIt.next();
+        db.getElementTranslations<library::Device>(
+            devIt.key(), localeOrder, &devIt.value().name);  // can throw
+        if (devIt.value().pkgFp.isValid()) {
+          db.getElementTranslations<library::Package>(
+              devIt.value().pkgFp, localeOrder,
+              &devIt.value().pkgName);  // can throw
+        }
+      }
+
+      chunk.insert(resultIt.key(), resCmp);
+      if (timer.elapsed() >= sSearchReportIntervalMs) {
+        future.reportResult(chunk);
+        chunk.clear();
+        timer.restart();
+      }
+    }
+    if (!chunk.isEmpty()) {
+      future.reportResult(chunk);
     }
+  } catch (const Exception& e) {
+    qCritical() << "Failed to search components:" << e.getMsg();
   }
-
-  return result;
+  future.reportFinished();
 }
 
 void AddComponentDialog::setSelectedCategory(
     const tl::optional<Uuid>& categoryUuid) {
+  cancelSearch();
   setSelectedComponent(nullptr);
   mUi->treeComponents->clear();
 
@@ -421,7 +464,8 @@ void AddComponentDialog::setSelectedCategory(
   mUi->treeComponents->sortByColumn(0, Qt::AscendingOrder);
 }
 
-void AddComponentDialog::setSelectedComponent(const library::Component* cmp) {
+void AddComponentDialog::setSelectedComponent(
+    std::shared_ptr<const library::Component> cmp) {
   if (cmp && (cmp == mSelectedComponent)) return;
 
   mUi->lblCompName->setText(tr("No component selected"));
@@ -429,8 +473,7 @@ void AddComponentDialog::setSelectedComponent(const library::Component* cmp) {
   mUi->cbxSymbVar->clear();
   setSelectedDevice(nullptr);
   setSelectedSymbVar(nullptr);
-  delete mSelectedComponent;
-  mSelectedComponent = nullptr;
+  mSelectedComponent.reset();
 
   if (cmp) {
     const QStringList& localeOrder = mProject.getSettings().getLocaleOrder();
@@ -466,6 +509,7 @@ void AddComponentDialog::setSelectedSymbVar(
   if (symbVar && (symbVar == mSelectedSymbVar)) return;
   qDeleteAll(mPreviewSymbolGraphicsItems);
   mPreviewSymbolGraphicsItems.clear();
+  mPreviewSymbols.clear();
   mSelectedSymbVar = symbVar;
 
   if (mSelectedComponent && symbVar) {
@@ -475,14 +519,13 @@ void AddComponentDialog::setSelectedSymbVar(
       FilePath symbolFp =
           mWorkspace.getLibraryDb().getLatestSymbol(item.getSymbolUuid());
       if (!symbolFp.isValid()) continue;  // TODO: show warning
-      const library::Symbol* symbol =
-          new library::Symbol(std::unique_ptr<TransactionalDirectory>(
-              new TransactionalDirectory(TransactionalFileSystem::openRO(
-                  symbolFp))));  // TODO: fix memory leak...
+      std::shared_ptr<const library::Symbol> symbol =
+          mWorkspace.getLibraryElementCache().getSymbol(symbolFp);
+      mPreviewSymbols.append(symbol);
       library::SymbolPreviewGraphicsItem* graphicsItem =
           new library::SymbolPreviewGraphicsItem(
-              *mGraphicsLayerProvider, localeOrder, *symbol, mSelectedComponent,
-              symbVar->getUuid(), item.getUuid());
+              *mGraphicsLayerProvider, localeOrder, *symbol,
+              mSelectedComponent.get(), symbVar->getUuid(), item.getUuid());
       graphicsItem->setPos(item.getSymbolPosition().toPxQPointF());
       graphicsItem->setRotation(-item.getSymbolRotation().toDeg());
       mPreviewSymbolGraphicsItems.append(graphicsItem);
@@ -492,16 +535,15 @@ void AddComponentDialog::setSelectedSymbVar(
   }
 }
 
-void AddComponentDialog::setSelectedDevice(const library::Device* dev) {
+void AddComponentDialog::setSelectedDevice(
+    std::shared_ptr<const library::Device> dev) {
   if (dev && (dev == mSelectedDevice)) return;
 
   mUi->lblDeviceName->setText(tr("No device selected"));
   delete mPreviewFootprintGraphicsItem;
   mPreviewFootprintGraphicsItem = nullptr;
-  delete mSelectedPackage;
-  mSelectedPackage = nullptr;
-  delete mSelectedDevice;
-  mSelectedDevice = nullptr;
+  mSelectedPackage.reset();
+  mSelectedDevice.reset();
 
   if (dev) {
     mSelectedDevice                = dev;
@@ -509,9 +551,8 @@ void AddComponentDialog::setSelectedDevice(const library::Device* dev) {
     FilePath           pkgFp       = mWorkspace.getLibraryDb().getLatestPackage(
         mSelectedDevice->getPackageUuid());
     if (pkgFp.isValid()) {
-      mSelectedPackage = new library::Package(
-          std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
-              TransactionalFileSystem::openRO(pkgFp))));
+      mSelectedPackage =
+          mWorkspace.getLibraryElementCache().getPackage(pkgFp);
       QString devName = *mSelectedDevice->getNames().value(localeOrder);
       QString pkgName = *mSelectedPackage->getNames().value(localeOrder);
       if (devName.contains(pkgName, Qt::CaseInsensitive)) {
@@ -524,8 +565,8 @@ void AddComponentDialog::setSelectedDevice(const library::Device* dev) {
         mPreviewFootprintGraphicsItem =
             new library::FootprintPreviewGraphicsItem(
                 *mGraphicsLayerProvider, localeOrder,
-                *mSelectedPackage->getFootprints().first(), mSelectedPackage,
-                mSelectedComponent);
+                *mSelectedPackage->getFootprints().first(),
+                mSelectedPackage.get(), mSelectedComponent.get());
         mDevicePreviewScene->addItem(*mPreviewFootprintGraphicsItem);
         mUi->viewDevice->zoomAll();
       }
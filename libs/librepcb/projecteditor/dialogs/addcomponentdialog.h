@@ -31,6 +31,8 @@
 #include <QtCore>
 #include <QtWidgets>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -52,7 +54,8 @@ class ComponentCategory;
 
 namespace workspace {
 class Workspace;
-}
+class WorkspaceLibraryDb;
+}  // namespace workspace
 
 namespace project {
 
@@ -90,6 +93,12 @@ class AddComponentDialog final : public QDialog {
 
   typedef QHash<FilePath, SearchResultComponent> SearchResult;
 
+  /// Delay after the last keystroke until the search is started [ms]
+  static constexpr int sSearchDelayMs = 250;
+
+  /// Minimum interval between reporting two chunks of search results [ms]
+  static constexpr int sSearchReportIntervalMs = 50;
+
 public:
   // Constructors / Destructor
   explicit AddComponentDialog(workspace::Workspace& workspace, Project& project,
@@ -113,14 +122,27 @@ private slots:
 
 private:
   // Private Methods
-  void         searchComponents(const QString& input);
-  SearchResult searchComponentsAndDevices(const QString& input);
-  void         setSelectedCategory(const tl::optional<Uuid>& categoryUuid);
-  void         setSelectedComponent(const library::Component* cmp);
+  void searchComponents(const QString& input) noexcept;
+  void cancelSearch() noexcept;
+  void searchResultsReady(int begin, int end) noexcept;
+  void addSearchResult(const SearchResult& result) noexcept;
+  void setSelectedCategory(const tl::optional<Uuid>& categoryUuid);
+  void setSelectedComponent(std::shared_ptr<const library::Component> cmp);
   void setSelectedSymbVar(const library::ComponentSymbolVariant* symbVar);
-  void setSelectedDevice(const library::Device* dev);
+  void setSelectedDevice(std::shared_ptr<const library::Device> dev);
   void accept() noexcept;
 
+  /**
+   * @brief Search components and devices (executed in a worker thread)
+   *
+   * The results are reported in chunks to the passed future. The search stops
+   * as soon as the future gets canceled.
+   */
+  static void searchComponentsAndDevices(
+      QFutureInterface<SearchResult>       future,
+      const workspace::WorkspaceLibraryDb& db, const QStringList& localeOrder,
+      const QString& input) noexcept;
+
   // General
   workspace::Workspace&                        mWorkspace;
   Project&                                     mProject;
@@ -129,15 +151,18 @@ private:
   GraphicsScene*                               mDevicePreviewScene;
   QScopedPointer<DefaultGraphicsLayerProvider> mGraphicsLayerProvider;
   workspace::ComponentCategoryTreeModel*       mCategoryTreeModel;
+  QTimer                                       mSearchTimer;
+  QFutureWatcher<SearchResult>                 mSearchWatcher;
 
   // Attributes
-  tl::optional<Uuid>                         mSelectedCategoryUuid;
-  const library::Component*                  mSelectedComponent;
-  const library::ComponentSymbolVariant*     mSelectedSymbVar;
-  const library::Device*                     mSelectedDevice;
-  const library::Package*                    mSelectedPackage;
-  QList<library::SymbolPreviewGraphicsItem*> mPreviewSymbolGraphicsItems;
-  library::FootprintPreviewGraphicsItem*     mPreviewFootprintGraphicsItem;
+  tl::optional<Uuid>                            mSelectedCategoryUuid;
+  std::shared_ptr<const library::Component>     mSelectedComponent;
+  const library::ComponentSymbolVariant*        mSelectedSymbVar;
+  std::shared_ptr<const library::Device>        mSelectedDevice;
+  std::shared_ptr<const library::Package>       mSelectedPackage;
+  QList<std::shared_ptr<const library::Symbol>> mPreviewSymbols;
+  QList<library::SymbolPreviewGraphicsItem*>    mPreviewSymbolGraphicsItems;
+  library::FootprintPreviewGraphicsItem*        mPreviewFootprintGraphicsItem;
 };
 
 /*******************************************************************************
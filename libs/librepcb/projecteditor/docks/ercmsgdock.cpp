@@ -104,30 +104,12 @@ ErcMsgDock::ErcMsgDock(Project& project)
 
   // add all already existing ERC messages
   foreach (ErcMsg* ercMsg, mProject.getErcMsgList().getItems()) {
-    QTreeWidgetItem* parent;
-    if (!ercMsg->isIgnored())
-      parent = mTopLevelItems.value(static_cast<int>(ercMsg->getMsgType()), 0);
-    else
-      parent = mTopLevelItems.value(
-          static_cast<int>(ErcMsg::ErcMsgType_t::_Count), 0);
-    Q_ASSERT(parent);
-    if (!parent) continue;
-    QTreeWidgetItem* child =
-        new QTreeWidgetItem(parent, QStringList(ercMsg->getMsg()));
-    child->setData(
-        0, Qt::UserRole,
-        QVariant::fromValue(reinterpret_cast<void*>(ercMsg)));  // ugly...
-    child->setToolTip(0, ercMsg->getMsg());
-    mErcMsgItems.insert(ercMsg, child);
+    addErcMsgItem(*ercMsg);
   }
 
   // connect to ErcMsgList signals
-  connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgAdded, this,
-          &ErcMsgDock::ercMsgAdded);
-  connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgRemoved, this,
-          &ErcMsgDock::ercMsgRemoved);
-  connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgChanged, this,
-          &ErcMsgDock::ercMsgChanged);
+  connect(&mProject.getErcMsgList(), &ErcMsgList::ercMsgsChanged, this,
+          &ErcMsgDock::ercMsgsChanged);
 
   updateTopLevelItemTexts();
 }
@@ -141,37 +123,26 @@ ErcMsgDock::~ErcMsgDock() {
  *  Public Slots
  ******************************************************************************/
 
-void ErcMsgDock::ercMsgAdded(ErcMsg* ercMsg) noexcept {
-  QTreeWidgetItem* parent;
-  Q_ASSERT(ercMsg);
-  Q_ASSERT(!mErcMsgItems.contains(ercMsg));
-  if (!ercMsg->isIgnored())
-    parent = mTopLevelItems.value(static_cast<int>(ercMsg->getMsgType()), 0);
-  else
-    parent =
-        mTopLevelItems.value(static_cast<int>(ErcMsg::ErcMsgType_t::_Count), 0);
-  Q_ASSERT(parent);
-  if (!parent) return;
-  QTreeWidgetItem* child =
-      new QTreeWidgetItem(parent, QStringList(ercMsg->getMsg()));
-  child->setToolTip(0, ercMsg->getMsg());
-  parent->sortChildren(0, Qt::AscendingOrder);
-  mErcMsgItems.insert(ercMsg, child);
-  updateTopLevelItemTexts();
-}
-
-void ErcMsgDock::ercMsgRemoved(ErcMsg* ercMsg) noexcept {
-  Q_ASSERT(ercMsg);
-  Q_ASSERT(mErcMsgItems.contains(ercMsg));
-  delete mErcMsgItems.take(ercMsg);
+void ErcMsgDock::ercMsgsChanged(const QList<ErcMsg*>& added,
+                                const QList<ErcMsg*>& removed,
+                                const QList<ErcMsg*>& changed) noexcept {
+  // Note: Removed messages may already be deleted, don't dereference them!
+  foreach (ErcMsg* ercMsg, removed + changed) {
+    Q_ASSERT(mErcMsgItems.contains(ercMsg));
+    delete mErcMsgItems.take(ercMsg);
+  }
+  QSet<QTreeWidgetItem*> parents;
+  foreach (ErcMsg* ercMsg, added + changed) {
+    if (QTreeWidgetItem* child = addErcMsgItem(*ercMsg)) {
+      parents.insert(child->parent());
+    }
+  }
+  foreach (QTreeWidgetItem* parent, parents) {
+    parent->sortChildren(0, Qt::AscendingOrder);
+  }
   updateTopLevelItemTexts();
 }
 
-void ErcMsgDock::ercMsgChanged(ErcMsg* ercMsg) noexcept {
-  ercMsgRemoved(ercMsg);
-  ercMsgAdded(ercMsg);
-}
-
 /*******************************************************************************
  *  GUI Actions
  ******************************************************************************/
@@ -210,6 +181,26 @@ void ErcMsgDock::on_btnIgnore_clicked(bool checked) {
  *  Private Methods
  ******************************************************************************/
 
+QTreeWidgetItem* ErcMsgDock::addErcMsgItem(ErcMsg& ercMsg) noexcept {
+  Q_ASSERT(!mErcMsgItems.contains(&ercMsg));
+  QTreeWidgetItem* parent;
+  if (!ercMsg.isIgnored())
+    parent = mTopLevelItems.value(static_cast<int>(ercMsg.getMsgType()), 0);
+  else
+    parent =
+        mTopLevelItems.value(static_cast<int>(ErcMsg::ErcMsgType_t::_Count), 0);
+  Q_ASSERT(parent);
+  if (!parent) return nullptr;
+  QTreeWidgetItem* child =
+      new QTreeWidgetItem(parent, QStringList(ercMsg.getMsg()));
+  child->setData(
+      0, Qt::UserRole,
+      QVariant::fromValue(reinterpret_cast<void*>(&ercMsg)));  // ugly...
+  child->setToolTip(0, ercMsg.getMsg());
+  mErcMsgItems.insert(&ercMsg, child);
+  return child;
+}
+
 void ErcMsgDock::updateTopLevelItemTexts() noexcept {
   int              countOfNonIgnoredErcMessages = 0;
   QTreeWidgetItem* item;
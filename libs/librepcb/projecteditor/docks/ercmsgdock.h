@@ -59,9 +59,9 @@ public:
 
 public slots:
 
-  void ercMsgAdded(ErcMsg* ercMsg) noexcept;
-  void ercMsgRemoved(ErcMsg* ercMsg) noexcept;
-  void ercMsgChanged(ErcMsg* ercMsg) noexcept;
+  void ercMsgsChanged(const QList<ErcMsg*>& added,
+                      const QList<ErcMsg*>& removed,
+                      const QList<ErcMsg*>& changed) noexcept;
 
 private slots:
 
@@ -71,7 +71,8 @@ private slots:
 
 private:
   // Private Methods
-  void updateTopLevelItemTexts() noexcept;
+  QTreeWidgetItem* addErcMsgItem(ErcMsg& ercMsg) noexcept;
+  void             updateTopLevelItemTexts() noexcept;
 
   // make some methods inaccessible...
   ErcMsgDock();
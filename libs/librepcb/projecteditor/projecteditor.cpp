@@ -56,6 +56,8 @@ ProjectEditor::ProjectEditor(workspace::Workspace& workspace, Project& project)
     mBoardEditor(nullptr) {
   try {
     mUndoStack = new UndoStack();
+    mUndoStack->setCommandLimit(
+        mWorkspace.getSettings().projectUndoLimit.get());
 
     // create the whole schematic/board editor GUI inclusive FSM and so on
     mSchematicEditor = new SchematicEditor(*this, mProject);
@@ -28,9 +28,11 @@ RESOURCES += \
 SOURCES += \
     boardeditor/boarddesignrulecheckdialog.cpp \
     boardeditor/boarddesignrulecheckmessagesdock.cpp \
+    boardeditor/boarddesignrulecheckmessagesmodel.cpp \
     boardeditor/boardeditor.cpp \
     boardeditor/boardlayersdock.cpp \
     boardeditor/boardlayerstacksetupdialog.cpp \
+    boardeditor/boardperformancedock.cpp \
     boardeditor/boardpickplacegeneratordialog.cpp \
     boardeditor/boardplanepropertiesdialog.cpp \
     boardeditor/boardviapropertiesdialog.cpp \
@@ -96,9 +98,11 @@ SOURCES += \
 HEADERS += \
     boardeditor/boarddesignrulecheckdialog.h \
     boardeditor/boarddesignrulecheckmessagesdock.h \
+    boardeditor/boarddesignrulecheckmessagesmodel.h \
     boardeditor/boardeditor.h \
     boardeditor/boardlayersdock.h \
     boardeditor/boardlayerstacksetupdialog.h \
+    boardeditor/boardperformancedock.h \
     boardeditor/boardpickplacegeneratordialog.h \
     boardeditor/boardplanepropertiesdialog.h \
     boardeditor/boardviapropertiesdialog.h \
@@ -167,6 +171,7 @@ FORMS += \
     boardeditor/boardeditor.ui \
     boardeditor/boardlayersdock.ui \
     boardeditor/boardlayerstacksetupdialog.ui \
+    boardeditor/boardperformancedock.ui \
     boardeditor/boardpickplacegeneratordialog.ui \
     boardeditor/boardplanepropertiesdialog.ui \
     boardeditor/boardviapropertiesdialog.ui \
@@ -444,8 +444,9 @@ bool SchematicEditorState_Select::copySelectedItemsToClipboard() noexcept {
     Point cursorPos = mContext.editorGraphicsView.mapGlobalPosToScenePos(
         QCursor::pos(), true, false);
     SchematicClipboardDataBuilder           builder(*schematic);
-    std::unique_ptr<SchematicClipboardData> data = builder.generate(cursorPos);
-    qApp->clipboard()->setMimeData(data->toMimeData().release());
+    std::shared_ptr<SchematicClipboardData> data = builder.generate(cursorPos);
+    qApp->clipboard()->setMimeData(
+        SchematicClipboardData::toMimeData(data).release());
   } catch (Exception& e) {
     QMessageBox::critical(parentWidget(), tr("Error"), e.getMsg());
   }
@@ -458,7 +459,7 @@ bool SchematicEditorState_Select::pasteFromClipboard() noexcept {
 
   try {
     // get symbol items and abort if there are no items
-    std::unique_ptr<SchematicClipboardData> data =
+    std::shared_ptr<const SchematicClipboardData> data =
         SchematicClipboardData::fromMimeData(
             qApp->clipboard()->mimeData());  // can throw
     if (!data) {
@@ -478,7 +479,7 @@ bool SchematicEditorState_Select::pasteFromClipboard() noexcept {
     Point offset =
         (mStartPos - data->getCursorPos()).mappedToGrid(getGridInterval());
     QScopedPointer<CmdPasteSchematicItems> cmd(
-        new CmdPasteSchematicItems(*schematic, std::move(data), offset));
+        new CmdPasteSchematicItems(*schematic, data, offset));
 
     if (mContext.undoStack.appendToCmdGroup(cmd.take())) {  // can throw
       // start moving the selected items
@@ -39,6 +39,53 @@ namespace librepcb {
 namespace project {
 namespace editor {
 
+/*******************************************************************************
+ *  Class SchematicClipboardData::MimeData
+ ******************************************************************************/
+
+/**
+ * @brief Clipboard content which references a ::SchematicClipboardData object
+ *
+ * The serialized data is generated on the first request, i.e. only if the
+ * clipboard content is requested by another process.
+ */
+class SchematicClipboardData::MimeData final : public QMimeData {
+public:
+  explicit MimeData(std::shared_ptr<const SchematicClipboardData> data) noexcept
+    : QMimeData(), mData(data), mZip() {}
+
+  const std::shared_ptr<const SchematicClipboardData>& getData() const
+      noexcept {
+    return mData;
+  }
+
+  QStringList formats() const override {
+    return QStringList{getMimeType(), "application/zip"};
+  }
+
+protected:
+  QVariant retrieveData(const QString& mimeType,
+                        QVariant::Type type) const override {
+    Q_UNUSED(type);
+    if (!hasFormat(mimeType)) {
+      return QVariant();
+    }
+    if (mZip.isNull()) {
+      try {
+        mZip = mData->toZip();  // can throw
+      } catch (const Exception& e) {
+        qCritical() << "Failed to serialize clipboard data:" << e.getMsg();
+        return QVariant();
+      }
+    }
+    return mZip;
+  }
+
+private:
+  std::shared_ptr<const SchematicClipboardData> mData;
+  mutable QByteArray                            mZip;
+};
+
 /*******************************************************************************
  *  Constructors / Destructor
  ******************************************************************************/
@@ -79,7 +126,7 @@ SchematicClipboardData::~SchematicClipboardData() noexcept {
  ******************************************************************************/
 
 std::unique_ptr<TransactionalDirectory> SchematicClipboardData::getDirectory(
-    const QString& path) noexcept {
+    const QString& path) const noexcept {
   return std::unique_ptr<TransactionalDirectory>(
       new TransactionalDirectory(mFileSystem, path));
 }
@@ -88,25 +135,27 @@ std::unique_ptr<TransactionalDirectory> SchematicClipboardData::getDirectory(
  *  General Methods
  ******************************************************************************/
 
-std::unique_ptr<QMimeData> SchematicClipboardData::toMimeData() const {
+QByteArray SchematicClipboardData::toZip() const {
   SExpression sexpr =
       serializeToDomElement("librepcb_clipboard_schematic");  // can throw
   mFileSystem->write("schematic.lp", sexpr.toByteArray());
+  return mFileSystem->exportToZip();  // can throw
+}
 
-  QByteArray zip = mFileSystem->exportToZip();
-
-  std::unique_ptr<QMimeData> data(new QMimeData());
-  data->setData(getMimeType(), zip);
-  data->setData("application/zip", zip);
-  return data;
+std::unique_ptr<QMimeData> SchematicClipboardData::toMimeData(
+    std::shared_ptr<const SchematicClipboardData> data) noexcept {
+  Q_ASSERT(data);
+  return std::unique_ptr<QMimeData>(new MimeData(data));
 }
 
-std::unique_ptr<SchematicClipboardData> SchematicClipboardData::fromMimeData(
-    const QMimeData* mime) {
+std::shared_ptr<const SchematicClipboardData>
+SchematicClipboardData::fromMimeData(const QMimeData* mime) {
+  if (const MimeData* data = dynamic_cast<const MimeData*>(mime)) {
+    return data->getData();  // copied within this application, no parsing
+  }
   QByteArray content = mime ? mime->data(getMimeType()) : QByteArray();
   if (!content.isNull()) {
-    return std::unique_ptr<SchematicClipboardData>(
-        new SchematicClipboardData(content));  // can throw
+    return std::make_shared<SchematicClipboardData>(content);  // can throw
   } else {
     return nullptr;
   }
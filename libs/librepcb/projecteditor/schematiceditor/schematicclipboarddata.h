@@ -52,6 +52,11 @@ namespace editor {
 
 /**
  * @brief The SchematicClipboardData class
+ *
+ * Within the same application instance, the clipboard holds a reference to
+ * the data object itself, so pasting doesn't need to serialize and parse
+ * anything. The (zipped) S-Expression representation is only created when
+ * another process requests the clipboard content.
  */
 class SchematicClipboardData final : public SerializableObject {
 public:
@@ -297,29 +302,46 @@ public:
 
   // Getters
   std::unique_ptr<TransactionalDirectory> getDirectory(
-      const QString& path = "") noexcept;
+      const QString& path = "") const noexcept;
   const Uuid&  getSchematicUuid() const noexcept { return mSchematicUuid; }
   const Point& getCursorPos() const noexcept { return mCursorPos; }
   SerializableObjectList<ComponentInstance, ComponentInstance>&
   getComponentInstances() noexcept {
     return mComponentInstances;
   }
+  const SerializableObjectList<ComponentInstance, ComponentInstance>&
+  getComponentInstances() const noexcept {
+    return mComponentInstances;
+  }
   SerializableObjectList<SymbolInstance, SymbolInstance>&
   getSymbolInstances() noexcept {
     return mSymbolInstances;
   }
+  const SerializableObjectList<SymbolInstance, SymbolInstance>&
+  getSymbolInstances() const noexcept {
+    return mSymbolInstances;
+  }
   SerializableObjectList<NetSegment, NetSegment>& getNetSegments() noexcept {
     return mNetSegments;
   }
+  const SerializableObjectList<NetSegment, NetSegment>& getNetSegments() const
+      noexcept {
+    return mNetSegments;
+  }
 
   // General Methods
-  std::unique_ptr<QMimeData>                     toMimeData() const;
-  static std::unique_ptr<SchematicClipboardData> fromMimeData(
+  QByteArray toZip() const;
+  static std::unique_ptr<QMimeData> toMimeData(
+      std::shared_ptr<const SchematicClipboardData> data) noexcept;
+  static std::shared_ptr<const SchematicClipboardData> fromMimeData(
       const QMimeData* mime);
 
   // Operator Overloadings
   SchematicClipboardData& operator=(const SchematicClipboardData& rhs) = delete;
 
+private:  // Types
+  class MimeData;
+
 private:  // Methods
   /// @copydoc ::librepcb::SerializableObject::serialize()
   void serialize(SExpression& root) const override;
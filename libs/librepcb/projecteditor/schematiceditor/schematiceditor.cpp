@@ -48,6 +48,7 @@
 #include <librepcb/project/schematics/cmd/cmdschematicedit.h>
 #include <librepcb/project/schematics/cmd/cmdschematicremove.h>
 #include <librepcb/project/schematics/items/si_symbol.h>
+#include <librepcb/project/schematics/items/si_symbolpin.h>
 #include <librepcb/project/schematics/schematic.h>
 #include <librepcb/project/settings/projectsettings.h>
 #include <librepcb/workspace/library/workspacelibrarydb.h>
@@ -77,6 +78,7 @@ SchematicEditor::SchematicEditor(ProjectEditor& projectEditor, Project& project)
     mUi(new Ui::SchematicEditor),
     mGraphicsView(nullptr),
     mActiveSchematicIndex(-1),
+    mUnconnectedPinIndex(-1),
     mPagesDock(nullptr),
     mErcMsgDock(nullptr),
     mFsm(nullptr) {
@@ -339,6 +341,35 @@ void SchematicEditor::on_actionRenameSheet_triggered() {
   renameSchematic(mActiveSchematicIndex);
 }
 
+void SchematicEditor::on_actionGoToNextUnconnectedPin_triggered() {
+  QList<SI_SymbolPin*> pins = getUnconnectedRequiredPins();
+  if (pins.isEmpty()) {
+    mUi->statusbar->showMessage(tr("There are no unconnected pins."), 5000);
+    return;
+  }
+
+  mUnconnectedPinIndex = (mUnconnectedPinIndex + 1) % pins.count();
+  SI_SymbolPin* pin       = pins[mUnconnectedPinIndex];
+  Schematic&    schematic = pin->getSchematic();
+  if (setActiveSchematicIndex(mProject.getSchematics().indexOf(&schematic))) {
+    schematic.clearSelection();
+    pin->getSymbol().setSelected(true);
+    // Zoom to a rectangle around the pin, relative to the maximum symbol
+    // dimension to still see the context of the pin.
+    QRectF  symbolRect = pin->getSymbol().getBoundingRect();
+    qreal   margin     = std::max(symbolRect.width(), symbolRect.height());
+    QPointF center     = pin->getPosition().toPxQPointF();
+    mGraphicsView->zoomToRect(
+        QRectF(center, center).adjusted(-margin, -margin, margin, margin));
+    mUi->statusbar->showMessage(
+        tr("Unconnected pin %1 of %2 (%3 of %4)")
+            .arg(pin->getDisplayText(true, true), pin->getSymbol().getName())
+            .arg(mUnconnectedPinIndex + 1)
+            .arg(pins.count()),
+        5000);
+  }
+}
+
 void SchematicEditor::on_actionGrid_triggered() {
   if (const Schematic* activeSchematic = getActiveSchematic()) {
     GridSettingsDialog dialog(activeSchematic->getGridProperties(), this);
@@ -742,6 +773,32 @@ void SchematicEditor::goToSymbol(const QString& name,
   }
 }
 
+QList<SI_SymbolPin*> SchematicEditor::getUnconnectedRequiredPins() const
+    noexcept {
+  QList<SI_SymbolPin*> pins;
+  foreach (const Schematic* schematic, mProject.getSchematics()) {
+    // use the connectivity index of the schematic, and sort its pins to get
+    // a stable order when going through them
+    QList<SI_SymbolPin*> schematicPins;
+    foreach (SI_SymbolPin* pin, schematic->getUnconnectedPins()) {
+      if (pin->isRequired()) {
+        schematicPins.append(pin);
+      }
+    }
+    std::sort(schematicPins.begin(), schematicPins.end(),
+              [](const SI_SymbolPin* a, const SI_SymbolPin* b) {
+                if (a->getSymbol().getName() != b->getSymbol().getName()) {
+                  return a->getSymbol().getName() < b->getSymbol().getName();
+                } else {
+                  return a->getDisplayText(true, true) <
+                      b->getDisplayText(true, true);
+                }
+              });
+    pins += schematicPins;
+  }
+  return pins;
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -42,6 +42,7 @@ namespace project {
 class Project;
 class Schematic;
 class SI_Symbol;
+class SI_SymbolPin;
 
 namespace editor {
 
@@ -90,6 +91,7 @@ private slots:
   // Actions
   void on_actionClose_Project_triggered();
   void on_actionRenameSheet_triggered();
+  void on_actionGoToNextUnconnectedPin_triggered();
   void on_actionGrid_triggered();
   void on_actionPrint_triggered();
   void on_actionPDF_Export_triggered();
@@ -122,6 +124,7 @@ private:
   QList<SI_Symbol*> getSearchCandidates() noexcept;
   QStringList       getSearchToolBarCompleterList() noexcept;
   void goToSymbol(const QString& name, unsigned int index) noexcept;
+  QList<SI_SymbolPin*> getUnconnectedRequiredPins() const noexcept;
 
   // General Attributes
   ProjectEditor&                       mProjectEditor;
@@ -132,6 +135,7 @@ private:
   QScopedPointer<ExclusiveActionGroup> mToolsActionGroup;
 
   int mActiveSchematicIndex;
+  int mUnconnectedPinIndex;  ///< last shown pin of "go to unconnected pin"
 
   // Docks
   SchematicPagesDock* mPagesDock;
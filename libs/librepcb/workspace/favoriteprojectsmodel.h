@@ -62,6 +62,7 @@ public:
   FavoriteProjectsModel& operator=(const FavoriteProjectsModel& rhs) = delete;
 
 private:
+  void     visibleProjectsChecked() noexcept;
   void     save() noexcept;
   int      rowCount(const QModelIndex& parent = QModelIndex()) const;
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
@@ -71,6 +72,10 @@ private:
   FilePath         mFilePath;
   QList<FilePath>  mAllProjects;
   QList<FilePath>  mVisibleProjects;
+
+  /// Checks in a worker thread which projects exist (see
+  /// #updateVisibleProjects())
+  QFutureWatcher<QList<FilePath>> mVisibleProjectsWatcher;
 };
 
 /*******************************************************************************
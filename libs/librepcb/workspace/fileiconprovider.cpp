@@ -36,7 +36,12 @@ namespace workspace {
  *  Constructors / Destructor
  ******************************************************************************/
 
-FileIconProvider::FileIconProvider() noexcept : QFileIconProvider() {
+FileIconProvider::FileIconProvider() noexcept
+  : QFileIconProvider(),
+    mProjectFileIcon(":/img/app/librepcb.png"),
+    mFileIcon(":/img/places/file.png"),
+    mProjectFolderIcon(":/img/places/project_folder.png"),
+    mFolderIcon(":/img/places/folder.png") {
 }
 
 FileIconProvider::~FileIconProvider() noexcept {
@@ -47,22 +52,49 @@ FileIconProvider::~FileIconProvider() noexcept {
  ******************************************************************************/
 
 QIcon FileIconProvider::icon(const QFileInfo& info) const noexcept {
-  if (info.isFile()) {
-    if (info.suffix() == "lpp") {
-      return QIcon(":/img/app/librepcb.png");
-    } else {
-      return QIcon(":/img/places/file.png");
-    }
-  } else if (info.isDir()) {
-    if (project::Project::isProjectDirectory(
-            FilePath(info.absoluteFilePath()))) {
-      return QIcon(":/img/places/project_folder.png");
-    } else if (info.isDir()) {
-      return QIcon(":/img/places/folder.png");
+  // Note: Everything which is not a directory (e.g. broken symlinks) gets the
+  // file icon to avoid querying the operating system for its icon.
+  if (info.isDir()) {
+    return isProjectDirectory(info) ? mProjectFolderIcon : mFolderIcon;
+  } else if (info.suffix() == "lpp") {
+    return mProjectFileIcon;
+  } else {
+    return mFileIcon;
+  }
+}
+
+QString FileIconProvider::type(const QFileInfo& info) const noexcept {
+  // Same as the generic implementation of QFileIconProvider (the type is not
+  // displayed in the project tree anyway).
+  if (info.isDir()) {
+    return QStringLiteral("Folder");
+  } else if (info.suffix().isEmpty()) {
+    return QStringLiteral("File");
+  } else {
+    return info.suffix() % QStringLiteral(" File");
+  }
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool FileIconProvider::isProjectDirectory(const QFileInfo& info) const
+    noexcept {
+  const QString path = info.absoluteFilePath();
+  {
+    QMutexLocker lock(&mProjectDirectoriesMutex);
+    auto         it = mProjectDirectories.constFind(path);
+    if (it != mProjectDirectories.constEnd()) {
+      return it.value();
     }
   }
+  // don't block other threads while accessing the file system
+  bool isProject = project::Project::isProjectDirectory(FilePath(path));
 
-  return QFileIconProvider::icon(info);
+  QMutexLocker lock(&mProjectDirectoriesMutex);
+  mProjectDirectories.insert(path, isProject);
+  return isProject;
 }
 
 /*******************************************************************************
@@ -40,6 +40,17 @@ namespace workspace {
 
 /**
  * @brief The FileIconProvider class
+ *
+ * Since determining the icon of a directory requires a file system access
+ * (to check whether it is a project directory), the results are cached. This
+ * avoids accessing the file system again each time the model refreshes a
+ * directory, which is slow on network drives. Note that the icons are
+ * requested by a worker thread of QFileSystemModel, thus the cache is guarded
+ * by a mutex.
+ *
+ * The icons themselves are created only once and shared (QIcon is implicitly
+ * shared), and #type() is derived from the file name only, since the default
+ * implementations may query the operating system for every single file.
  */
 class FileIconProvider final : public QFileIconProvider {
 public:
@@ -47,7 +58,20 @@ public:
   ~FileIconProvider() noexcept;
 
   // Inherited Methods
-  virtual QIcon icon(const QFileInfo& info) const noexcept override;
+  virtual QIcon   icon(const QFileInfo& info) const noexcept override;
+  virtual QString type(const QFileInfo& info) const noexcept override;
+
+private:  // Methods
+  bool isProjectDirectory(const QFileInfo& info) const noexcept;
+
+private:  // Data
+  const QIcon mProjectFileIcon;
+  const QIcon mFileIcon;
+  const QIcon mProjectFolderIcon;
+  const QIcon mFolderIcon;
+
+  mutable QHash<QString, bool> mProjectDirectories;  ///< key: absolute path
+  mutable QMutex               mProjectDirectoriesMutex;
 };
 
 /*******************************************************************************
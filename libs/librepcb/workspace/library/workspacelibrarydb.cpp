@@ -52,7 +52,12 @@ using namespace library;
  ******************************************************************************/
 
 WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
-  : QObject(nullptr), mWorkspace(ws) {
+  : QObject(nullptr),
+    mWorkspace(ws),
+    mLifetimeToken(std::make_shared<int>(0)),
+    mRescanPending(false),
+    mFilePathsCache(sMaxCacheSize),
+    mTranslationsCache(sMaxCacheSize) {
   qDebug("Load workspace library database...");
 
   // open SQLite database
@@ -72,9 +77,17 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
     createAllTables();                         // can throw
     setDbVersion(sCurrentDbVersion);           // can throw
   }
+  mHasSearchIndex = getDb().tableExists("search_index");  // can throw
 
   // create library scanner object
   mLibraryScanner.reset(new WorkspaceLibraryScanner(mWorkspace, mFilePath));
+  // Flush caches before the signals are forwarded, so receivers already get
+  // the new data. Note that the library list is committed before the elements.
+  connect(mLibraryScanner.data(),
+          &WorkspaceLibraryScanner::scanLibraryListUpdated, this,
+          &WorkspaceLibraryDb::clearCaches, Qt::QueuedConnection);
+  connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanFinished, this,
+          &WorkspaceLibraryDb::clearCaches, Qt::QueuedConnection);
   connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanStarted, this,
           &WorkspaceLibraryDb::scanStarted, Qt::QueuedConnection);
   connect(mLibraryScanner.data(),
@@ -89,20 +102,45 @@ WorkspaceLibraryDb::WorkspaceLibraryDb(Workspace& ws)
   connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanFinished, this,
           &WorkspaceLibraryDb::scanFinished, Qt::QueuedConnection);
 
+  // automatically rescan libraries after they were modified externally
+  mRescanTimer.setSingleShot(true);
+  mRescanTimer.setInterval(sRescanDelayMs);
+  connect(&mRescanTimer, &QTimer::timeout, this,
+          &WorkspaceLibraryDb::processWatchedDirectoryChanges);
+  connect(&mFileSystemWatcher, &QFileSystemWatcher::directoryChanged, this,
+          &WorkspaceLibraryDb::watchedDirectoryChanged);
+  connect(mLibraryScanner.data(), &WorkspaceLibraryScanner::scanFinished, this,
+          &WorkspaceLibraryDb::updateWatchedDirectories, Qt::QueuedConnection);
+  updateWatchedDirectories();
+
   qDebug("Workspace library database successfully loaded!");
 }
 
 WorkspaceLibraryDb::~WorkspaceLibraryDb() noexcept {
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+qint64 WorkspaceLibraryDb::getSearchIndexRowId(const QString& table,
+                                               int            id) noexcept {
+  static const QStringList tables = {
+      "component_categories", "package_categories", "symbols",
+      "packages",             "components",         "devices",
+  };
+  int index = tables.indexOf(table);
+  return (index >= 0) ? (qint64(id) * sSearchIndexTableCount + index) : -1;
+}
+
 /*******************************************************************************
  *  Getters: Libraries
  ******************************************************************************/
 
 QMultiMap<Version, FilePath> WorkspaceLibraryDb::getLibraries() const {
   QSqlQuery query =
-      mDb->prepareQuery("SELECT version, filepath FROM libraries");
-  mDb->exec(query);
+      getDb().prepareQuery("SELECT version, filepath FROM libraries");
+  getDb().exec(query);
 
   QMultiMap<Version, FilePath> libraries;
   while (query.next()) {
@@ -386,11 +424,11 @@ void WorkspaceLibraryDb::getElementMetadata<Device>(const FilePath elemDir,
 
 void WorkspaceLibraryDb::getLibraryMetadata(const FilePath libDir,
                                             QPixmap*       icon) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT icon_png FROM libraries WHERE filepath = :filepath");
   query.bindValue(":filepath",
                   libDir.toRelative(mWorkspace.getLibrariesPath()));
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (query.first()) {
     QByteArray blob = query.value(0).toByteArray();
@@ -404,12 +442,12 @@ void WorkspaceLibraryDb::getLibraryMetadata(const FilePath libDir,
 
 void WorkspaceLibraryDb::getDeviceMetadata(const FilePath& devDir,
                                            Uuid* pkgUuid, Uuid* cmpUuid) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT package_uuid, component_uuid "
       "FROM devices WHERE filepath = :filepath");
   query.bindValue(":filepath",
                   devDir.toRelative(mWorkspace.getLibrariesPath()));
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (query.first()) {
     Uuid uuid = Uuid::fromString(query.value(0).toString());  // can throw
@@ -497,10 +535,10 @@ QSet<Uuid> WorkspaceLibraryDb::getDevicesByCategory(
 
 QSet<Uuid> WorkspaceLibraryDb::getDevicesOfComponent(
     const Uuid& component) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT uuid FROM devices WHERE component_uuid = :uuid");
   query.bindValue(":uuid", component.toStr());
-  mDb->exec(query);
+  getDb().exec(query);
 
   QSet<Uuid> elements;
   while (query.next()) {
@@ -517,17 +555,204 @@ void WorkspaceLibraryDb::startLibraryRescan() noexcept {
   mLibraryScanner->startScan();
 }
 
+void WorkspaceLibraryDb::startElementUpdate(
+    const FilePath& elementDir) noexcept {
+  mLibraryScanner->startElementUpdate(elementDir);
+}
+
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+SQLiteDatabase& WorkspaceLibraryDb::getDb() const {
+  QThread* currentThread = QThread::currentThread();
+  if (currentThread == thread()) {
+    return *mDb;
+  }
+
+  // The connections are owned by the calling thread, thus they are destroyed
+  // (i.e. closed) within this thread when it exits. This also works for
+  // thread pool threads, which don't reliably emit QThread::finished().
+  struct ThreadDb {
+    std::weak_ptr<int>              owner;
+    std::shared_ptr<SQLiteDatabase> db;
+  };
+  static thread_local QHash<const WorkspaceLibraryDb*, ThreadDb> threadDbs;
+  auto it = threadDbs.find(this);
+  if ((it != threadDbs.end()) && (!it->owner.expired())) {
+    return *it->db;
+  }
+
+  // Close connections of already destroyed databases (the address of this
+  // object might even be the same as the one of a destroyed object).
+  for (auto i = threadDbs.begin(); i != threadDbs.end();) {
+    if (i->owner.expired()) {
+      i = threadDbs.erase(i);
+    } else {
+      ++i;
+    }
+  }
+  ThreadDb threadDb{mLifetimeToken,
+                    std::make_shared<SQLiteDatabase>(mFilePath)};  // can throw
+  return *threadDbs.insert(this, threadDb)->db;
+}
+
+void WorkspaceLibraryDb::updateWatchedDirectories() noexcept {
+  QSet<QString> dirs;
+  QSet<QString> elementDirs;
+  FilePath      localLibsDir = mWorkspace.getLocalLibrariesPath();
+  if (localLibsDir.isExistingDir()) {
+    dirs.insert(localLibsDir.toStr());  // to detect new libraries
+  }
+  try {
+    foreach (const FilePath& libDir, getLibraries()) {  // can throw
+      if (!libDir.isLocatedInDir(localLibsDir)) {
+        continue;
+      }
+      dirs.insert(libDir.toStr());
+      QDir libQDir(libDir.toStr());
+      foreach (const QString& typeDir,
+               libQDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QDir typeQDir(libQDir.filePath(typeDir));
+        dirs.insert(typeQDir.path());
+        foreach (const QString& elementDir,
+                 typeQDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+          dirs.insert(typeQDir.filePath(elementDir));
+          elementDirs.insert(typeQDir.filePath(elementDir));
+        }
+      }
+    }
+  } catch (const Exception& e) {
+    qWarning() << "Failed to determine library directories to watch:"
+               << e.getMsg();
+  }
+
+  mWatchedElementDirs       = elementDirs;
+  QSet<QString> watchedDirs = mFileSystemWatcher.directories().toSet();
+  QStringList   removedDirs = (watchedDirs - dirs).toList();
+  QStringList   addedDirs   = (dirs - watchedDirs).toList();
+  if (!removedDirs.isEmpty()) {
+    mFileSystemWatcher.removePaths(removedDirs);
+  }
+  if (!addedDirs.isEmpty()) {
+    QStringList failed = mFileSystemWatcher.addPaths(addedDirs);
+    if (!failed.isEmpty()) {
+      // e.g. if the OS limit of watched directories is reached
+      qWarning() << "Could not watch" << failed.count()
+                 << "library directories for modifications.";
+    }
+  }
+}
+
+void WorkspaceLibraryDb::watchedDirectoryChanged(const QString& dir) noexcept {
+  if (mWatchedElementDirs.contains(dir)) {
+    mChangedElementDirs.insert(dir);
+  } else {
+    mRescanPending = true;  // e.g. element added or removed
+  }
+  mRescanTimer.start();
+}
+
+void WorkspaceLibraryDb::processWatchedDirectoryChanges() noexcept {
+  if (mRescanPending) {
+    startLibraryRescan();
+  } else {
+    foreach (const QString& dir, mChangedElementDirs) {
+      startElementUpdate(FilePath(dir));
+    }
+  }
+  mRescanPending = false;
+  mChangedElementDirs.clear();
+}
+
+void WorkspaceLibraryDb::clearCaches() noexcept {
+  QMutexLocker lock(&mCacheMutex);
+  mFilePathsCache.clear();
+  mTranslationsCache.clear();
+  mCategoryTrees.clear();
+  mCategoryElementCounts.clear();
+}
+
+WorkspaceLibraryDb::CategoryTree WorkspaceLibraryDb::getCategoryTree(
+    const QString& tablename) const {
+  {
+    QMutexLocker lock(&mCacheMutex);
+    auto         it = mCategoryTrees.find(tablename);
+    if (it != mCategoryTrees.end()) {
+      return it.value();
+    }
+  }
+
+  // Load the whole tree at once instead of querying each node separately.
+  // Ordering by version ensures the latest version of each category wins.
+  QSqlQuery query = getDb().prepareQuery("SELECT uuid, parent_uuid FROM " %
+                                         tablename % " ORDER BY version ASC");
+  getDb().exec(query);
+
+  CategoryTree tree;
+  while (query.next()) {
+    Uuid uuid = Uuid::fromString(query.value(0).toString());  // can throw
+
+    tl::optional<Uuid> parent;
+    if (!query.value(1).isNull()) {
+      parent = Uuid::fromString(query.value(1).toString());  // can throw
+    }
+    QString parentKey = parent ? parent->toStr() : QString();
+    tree.childs[parentKey].insert(uuid);
+    tree.childCount[parentKey]++;
+    tree.parents[uuid.toStr()] = parent;
+  }
+  QMutexLocker lock(&mCacheMutex);
+  mCategoryTrees.insert(tablename, tree);
+  return tree;
+}
+
+QHash<QString, int> WorkspaceLibraryDb::getCategoryElementCounts(
+    const QString& tablename, const QString& idrowname) const {
+  {
+    QMutexLocker lock(&mCacheMutex);
+    auto         it = mCategoryElementCounts.find(tablename);
+    if (it != mCategoryElementCounts.end()) {
+      return it.value();
+    }
+  }
+
+  // count the elements of all categories with a single query
+  QSqlQuery query = getDb().prepareQuery(
+      "SELECT category_uuid, COUNT(*) FROM " % tablename % " LEFT JOIN " %
+      tablename % "_cat" % " ON " % tablename % ".id=" % tablename % "_cat." %
+      idrowname % " GROUP BY category_uuid");
+  getDb().exec(query);
+
+  QHash<QString, int> counts;
+  while (query.next()) {
+    QVariant category = query.value(0);
+    counts.insert(category.isNull() ? QString() : category.toString(),
+                  query.value(1).toInt());
+  }
+  QMutexLocker lock(&mCacheMutex);
+  mCategoryElementCounts.insert(tablename, counts);
+  return counts;
+}
+
 void WorkspaceLibraryDb::getElementTranslations(const QString&     table,
                                                 const QString&     idRow,
                                                 const FilePath&    elemDir,
                                                 const QStringList& localeOrder,
                                                 QString* name, QString* desc,
                                                 QString* keywords) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QString key = table % "|" % elemDir.toStr() % "|" % localeOrder.join(",");
+  {
+    QMutexLocker lock(&mCacheMutex);
+    if (const CachedTranslations* cached = mTranslationsCache.object(key)) {
+      if (name) *name = cached->name;
+      if (desc) *desc = cached->description;
+      if (keywords) *keywords = cached->keywords;
+      return;
+    }
+  }
+
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT locale, name, description, keywords FROM " % table %
       "_tr "
       "INNER JOIN " %
@@ -537,7 +762,7 @@ void WorkspaceLibraryDb::getElementTranslations(const QString&     table,
       table % ".filepath = :filepath");
   query.bindValue(":filepath",
                   elemDir.toRelative(mWorkspace.getLibrariesPath()));
-  mDb->exec(query);
+  getDb().exec(query);
 
   LocalizedNameMap        nameMap(ElementName("unknown"));
   LocalizedDescriptionMap descriptionMap("unknown");
@@ -552,19 +777,24 @@ void WorkspaceLibraryDb::getElementTranslations(const QString&     table,
     if (!keywords.isNull()) keywordsMap.insert(locale, keywords);
   }
 
-  if (name) *name = *nameMap.value(localeOrder);
-  if (desc) *desc = descriptionMap.value(localeOrder);
-  if (keywords) *keywords = keywordsMap.value(localeOrder);
+  CachedTranslations* result = new CachedTranslations{
+      *nameMap.value(localeOrder), descriptionMap.value(localeOrder),
+      keywordsMap.value(localeOrder)};
+  if (name) *name = result->name;
+  if (desc) *desc = result->description;
+  if (keywords) *keywords = result->keywords;
+  QMutexLocker lock(&mCacheMutex);
+  mTranslationsCache.insert(key, result);  // takes ownership
 }
 
 void WorkspaceLibraryDb::getElementMetadata(const QString& table,
                                             const FilePath elemDir, Uuid* uuid,
                                             Version* version) const {
-  QSqlQuery query = mDb->prepareQuery("SELECT uuid, version FROM " % table %
-                                      " WHERE filepath = :filepath");
+  QSqlQuery query = getDb().prepareQuery("SELECT uuid, version FROM " % table %
+                                         " WHERE filepath = :filepath");
   query.bindValue(":filepath",
                   elemDir.toRelative(mWorkspace.getLibrariesPath()));
-  mDb->exec(query);
+  getDb().exec(query);
 
   while (query.next()) {
     QString uuidStr    = query.value(0).toString();
@@ -576,10 +806,18 @@ void WorkspaceLibraryDb::getElementMetadata(const QString& table,
 
 QMultiMap<Version, FilePath> WorkspaceLibraryDb::getElementFilePathsFromDb(
     const QString& tablename, const Uuid& uuid) const {
-  QSqlQuery query = mDb->prepareQuery("SELECT version, filepath FROM " %
-                                      tablename % " WHERE uuid = :uuid");
+  QString key = tablename % "|" % uuid.toStr();
+  {
+    QMutexLocker lock(&mCacheMutex);
+    if (const auto* cached = mFilePathsCache.object(key)) {
+      return *cached;
+    }
+  }
+
+  QSqlQuery query = getDb().prepareQuery("SELECT version, filepath FROM " %
+                                         tablename % " WHERE uuid = :uuid");
   query.bindValue(":uuid", uuid.toStr());
-  mDb->exec(query);
+  getDb().exec(query);
 
   QMultiMap<Version, FilePath> elements;
   while (query.next()) {
@@ -593,6 +831,8 @@ QMultiMap<Version, FilePath> WorkspaceLibraryDb::getElementFilePathsFromDb(
       throw LogicError(__FILE__, __LINE__);
     }
   }
+  QMutexLocker lock(&mCacheMutex);
+  mFilePathsCache.insert(key, new QMultiMap<Version, FilePath>(elements));
   return elements;
 }
 
@@ -606,17 +846,8 @@ FilePath WorkspaceLibraryDb::getLatestVersionFilePath(
 
 QSet<Uuid> WorkspaceLibraryDb::getCategoryChilds(
     const QString& tablename, const tl::optional<Uuid>& categoryUuid) const {
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT uuid FROM " % tablename % " WHERE parent_uuid " %
-      (categoryUuid ? "= '" % categoryUuid->toStr() % "'"
-                    : QString("IS NULL")));
-  mDb->exec(query);
-
-  QSet<Uuid> elements;
-  while (query.next()) {
-    elements.insert(Uuid::fromString(query.value(0).toString()));  // can throw
-  }
-  return elements;
+  return getCategoryTree(tablename).childs.value(
+      categoryUuid ? categoryUuid->toStr() : QString());  // can throw
 }
 
 QList<Uuid> WorkspaceLibraryDb::getCategoryParents(const QString& tablename,
@@ -638,18 +869,10 @@ QList<Uuid> WorkspaceLibraryDb::getCategoryParents(const QString& tablename,
 
 tl::optional<Uuid> WorkspaceLibraryDb::getCategoryParent(
     const QString& tablename, const Uuid& category) const {
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT parent_uuid FROM " % tablename % " WHERE uuid = '" %
-      category.toStr() % "'" % " ORDER BY version DESC" % " LIMIT 1");
-  mDb->exec(query);
-
-  if (query.next()) {
-    QVariant value = query.value(0);
-    if (!value.isNull()) {
-      return Uuid::fromString(value.toString());  // can throw
-    } else {
-      return tl::nullopt;
-    }
+  CategoryTree tree = getCategoryTree(tablename);  // can throw
+  auto         it   = tree.parents.find(category.toStr());
+  if (it != tree.parents.end()) {
+    return it.value();
   } else {
     throw RuntimeError(__FILE__, __LINE__,
                        tr("The category "
@@ -660,27 +883,21 @@ tl::optional<Uuid> WorkspaceLibraryDb::getCategoryParent(
 
 int WorkspaceLibraryDb::getCategoryChildCount(
     const QString& tablename, const tl::optional<Uuid>& category) const {
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT COUNT(*) FROM " % tablename % " WHERE parent_uuid " %
-      (category ? "= '" % category->toStr() % "'" : QString("IS NULL")));
-  return mDb->count(query);
+  return getCategoryTree(tablename).childCount.value(
+      category ? category->toStr() : QString());  // can throw
 }
 
 int WorkspaceLibraryDb::getCategoryElementCount(
     const QString& tablename, const QString& idrowname,
     const tl::optional<Uuid>& category) const {
-  QSqlQuery query = mDb->prepareQuery(
-      "SELECT COUNT(*) FROM " % tablename % " LEFT JOIN " % tablename % "_cat" %
-      " ON " % tablename % ".id=" % tablename % "_cat." % idrowname %
-      " WHERE category_uuid " %
-      (category ? "= '" % category->toStr() % "'" : QString("IS NULL")));
-  return mDb->count(query);
+  return getCategoryElementCounts(tablename, idrowname)
+      .value(category ? category->toStr() : QString());  // can throw
 }
 
 QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(
     const QString& tablename, const QString& idrowname,
     const tl::optional<Uuid>& categoryUuid) const {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "SELECT uuid FROM " % tablename % " LEFT JOIN " % tablename %
       "_cat "
       "ON " %
@@ -689,7 +906,7 @@ QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(
       "WHERE category_uuid " %
       (categoryUuid ? "= '" % categoryUuid->toStr() % "'"
                     : QString("IS NULL")));
-  mDb->exec(query);
+  getDb().exec(query);
 
   QSet<Uuid> elements;
   while (query.next()) {
@@ -701,14 +918,42 @@ QSet<Uuid> WorkspaceLibraryDb::getElementsByCategory(
 QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword(
     const QString& tablename, const QString& idrowname,
     const QString& keyword) const {
-  QSqlQuery query = mDb->prepareQuery(QString("SELECT %1.uuid FROM %1, %1_tr "
-                                              "ON %1.id=%1_tr.%2 "
-                                              "WHERE %1_tr.name LIKE :keyword "
-                                              "OR %1_tr.keywords LIKE :keyword "
-                                              "ORDER BY %1_tr.name ASC ")
-                                          .arg(tablename, idrowname));
+  // Use the full-text search index if possible. The trigram tokenizer requires
+  // at least 3 characters to match substrings, for shorter keywords (and for
+  // libraries, which are not indexed) fall back to the slow LIKE search.
+  qint64 tableIndex = getSearchIndexRowId(tablename, 0);
+  if (mHasSearchIndex && (tableIndex >= 0) && (keyword.length() >= 3)) {
+    QSqlQuery query = getDb().prepareQuery(
+        QString("SELECT %1.uuid FROM search_index "
+                "INNER JOIN %1 ON %1.id = search_index.rowid / %2 "
+                "WHERE search_index MATCH :keyword "
+                "AND search_index.rowid % %2 = :index "
+                "ORDER BY bm25(search_index, 10.0, 1.0) ASC")
+            .arg(tablename)
+            .arg(sSearchIndexTableCount));
+    // search for the keyword as a phrase to avoid interpreting FTS5 syntax
+    query.bindValue(":keyword",
+                    "\"" % QString(keyword).replace("\"", "\"\"") % "\"");
+    query.bindValue(":index", tableIndex);
+    getDb().exec(query);
+
+    QList<Uuid> elements;
+    while (query.next()) {
+      elements.append(
+          Uuid::fromString(query.value(0).toString()));  // can throw
+    }
+    return elements;
+  }
+
+  QSqlQuery query =
+      getDb().prepareQuery(QString("SELECT %1.uuid FROM %1, %1_tr "
+                                   "ON %1.id=%1_tr.%2 "
+                                   "WHERE %1_tr.name LIKE :keyword "
+                                   "OR %1_tr.keywords LIKE :keyword "
+                                   "ORDER BY %1_tr.name ASC ")
+                               .arg(tablename, idrowname));
   query.bindValue(":keyword", "%" + keyword + "%");
-  mDb->exec(query);
+  getDb().exec(query);
 
   QList<Uuid> elements;
   elements.reserve(query.size());
@@ -720,13 +965,13 @@ QList<Uuid> WorkspaceLibraryDb::getElementsBySearchKeyword(
 
 int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const {
   QString   relativeLibraryPath = lib.toRelative(mWorkspace.getLibrariesPath());
-  QSqlQuery query               = mDb->prepareQuery(
+  QSqlQuery query               = getDb().prepareQuery(
       "SELECT id FROM libraries "
       "WHERE filepath = '" %
       relativeLibraryPath %
       "'"
       "LIMIT 1");
-  mDb->exec(query);
+  getDb().exec(query);
 
   if (query.next()) {
     bool ok = false;
@@ -743,10 +988,10 @@ int WorkspaceLibraryDb::getLibraryId(const FilePath& lib) const {
 
 QList<FilePath> WorkspaceLibraryDb::getLibraryElements(
     const FilePath& lib, const QString& tablename) const {
-  QSqlQuery query = mDb->prepareQuery("SELECT filepath FROM " % tablename %
-                                      " WHERE lib_id = :lib_id");
+  QSqlQuery query = getDb().prepareQuery("SELECT filepath FROM " % tablename %
+                                         " WHERE lib_id = :lib_id");
   query.bindValue(":lib_id", getLibraryId(lib));
-  mDb->exec(query);
+  getDb().exec(query);
 
   QList<FilePath> elements;
   while (query.next()) {
@@ -804,6 +1049,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
       ")");
   queries << QString(
@@ -826,6 +1072,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`parent_uuid` TEXT"
       ")");
   queries << QString(
@@ -847,7 +1094,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
-      "`version` TEXT NOT NULL"
+      "`version` TEXT NOT NULL, "
+      "`fingerprint` TEXT NOT NULL"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS symbols_tr ("
@@ -876,7 +1124,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
-      "`version` TEXT NOT NULL "
+      "`version` TEXT NOT NULL, "
+      "`fingerprint` TEXT NOT NULL"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS packages_tr ("
@@ -905,7 +1154,8 @@ void WorkspaceLibraryDb::createAllTables() {
       "`lib_id` INTEGER NOT NULL, "
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
-      "`version` TEXT NOT NULL"
+      "`version` TEXT NOT NULL, "
+      "`fingerprint` TEXT NOT NULL"
       ")");
   queries << QString(
       "CREATE TABLE IF NOT EXISTS components_tr ("
@@ -935,6 +1185,7 @@ void WorkspaceLibraryDb::createAllTables() {
       "`filepath` TEXT UNIQUE NOT NULL, "
       "`uuid` TEXT NOT NULL, "
       "`version` TEXT NOT NULL, "
+      "`fingerprint` TEXT NOT NULL, "
       "`component_uuid` TEXT NOT NULL, "
       "`package_uuid` TEXT NOT NULL"
       ")");
@@ -958,18 +1209,55 @@ void WorkspaceLibraryDb::createAllTables() {
       "UNIQUE(device_id, category_uuid)"
       ")");
 
+  // Indices for the lookups done by this class. Note that columns with a
+  // UNIQUE constraint (filepath, *_tr and *_cat element IDs) are already
+  // indexed implicitly.
+  queries << QString(
+      "CREATE INDEX IF NOT EXISTS libraries_uuid ON libraries (uuid)");
+  foreach (const QString& table,
+           QStringList{"component_categories", "package_categories", "symbols",
+                       "packages", "components", "devices"}) {
+    queries << QString("CREATE INDEX IF NOT EXISTS %1_uuid ON %1 (uuid)")
+                   .arg(table);
+    queries << QString("CREATE INDEX IF NOT EXISTS %1_lib_id ON %1 (lib_id)")
+                   .arg(table);
+  }
+  foreach (const QString& table,
+           QStringList{"symbols", "packages", "components", "devices"}) {
+    queries << QString(
+                   "CREATE INDEX IF NOT EXISTS %1_cat_category_uuid ON %1_cat "
+                   "(category_uuid)")
+                   .arg(table);
+  }
+  queries << QString(
+      "CREATE INDEX IF NOT EXISTS devices_component_uuid ON devices "
+      "(component_uuid)");
+
   // execute queries
   foreach (const QString& string, queries) {
-    QSqlQuery query = mDb->prepareQuery(string);  // can throw
-    mDb->exec(query);                             // can throw
+    QSqlQuery query = getDb().prepareQuery(string);  // can throw
+    getDb().exec(query);                             // can throw
+  }
+
+  // Full-text search index for names and keywords of all library elements
+  // (except libraries), see getSearchIndexRowId() for the row IDs. It requires
+  // an SQLite build with FTS5 and the trigram tokenizer (SQLite >= 3.34), if
+  // not available the search falls back to (slow) LIKE queries.
+  try {
+    getDb().exec(
+        "CREATE VIRTUAL TABLE IF NOT EXISTS search_index USING fts5("
+        "name, keywords, tokenize = 'trigram'"
+        ")");  // can throw
+  } catch (const Exception& e) {
+    qWarning() << "Full-text search index not available:" << e.getMsg();
   }
 }
 
 int WorkspaceLibraryDb::getDbVersion() const noexcept {
   try {
-    QSqlQuery query = mDb->prepareQuery(
+    QSqlQuery query = getDb().prepareQuery(
         "SELECT value_int FROM internal WHERE key = 'version'");
-    mDb->exec(query);
+    getDb().exec(query);
     if (query.next()) {
       bool ok      = false;
       int  version = query.value(0).toInt(&ok);
@@ -984,11 +1272,11 @@ int WorkspaceLibraryDb::getDbVersion() const noexcept {
 }
 
 void WorkspaceLibraryDb::setDbVersion(int version) {
-  QSqlQuery query = mDb->prepareQuery(
+  QSqlQuery query = getDb().prepareQuery(
       "INSERT INTO internal (key, value_int) "
       "VALUES ('version', :version)");
   query.bindValue(":version", version);
-  mDb->insert(query);  // can throw
+  getDb().insert(query);  // can throw
 }
 
 /*******************************************************************************
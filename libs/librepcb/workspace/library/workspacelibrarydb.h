@@ -29,6 +29,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -136,6 +138,29 @@ public:
    */
   void startLibraryRescan() noexcept;
 
+  /**
+   * @brief Update the SQLite database entries of a single library element
+   *
+   * Much faster than #startLibraryRescan() after an element was saved (or
+   * removed) since only the given element directory gets parsed.
+   *
+   * @param elementDir  Directory of the modified library element
+   */
+  void startElementUpdate(const FilePath& elementDir) noexcept;
+
+  // Static Methods
+
+  /**
+   * @brief Get the row ID of an element in the full-text search index
+   *
+   * @param table   The element table (e.g. "symbols")
+   * @param id      The ID of the element in its table
+   *
+   * @return The row ID in the search index, or -1 if the elements of the
+   *         given table are not contained in the search index
+   */
+  static qint64 getSearchIndexRowId(const QString& table, int id) noexcept;
+
   // Operator Overloadings
   WorkspaceLibraryDb& operator=(const WorkspaceLibraryDb& rhs) = delete;
 
@@ -149,7 +174,62 @@ signals:
   void scanFinished();
 
 private:
+  // Types
+  struct CachedTranslations {
+    QString name;
+    QString description;
+    QString keywords;
+  };
+
+  /// Materialized category tree, keys are category UUIDs (null for the root)
+  struct CategoryTree {
+    QHash<QString, QSet<Uuid>>         childs;
+    QHash<QString, int>                childCount;  ///< including all versions
+    QHash<QString, tl::optional<Uuid>> parents;     ///< of the latest versions
+  };
+
   // Private Methods
+
+  /**
+   * @brief Get the database connection of the calling thread
+   *
+   * SQL connections must only be used in the thread which created them, so
+   * each thread gets its own connection. Thanks to the Write-Ahead Logging,
+   * all of them can read concurrently while the scanner is writing.
+   *
+   * The connections of other threads than the owning one are stored
+   * thread-locally, so they are always closed within their own thread: Either
+   * when the thread exits, or when the thread accesses any database after
+   * this object was destroyed.
+   *
+   * @return The database connection (valid until the thread has finished or
+   *         this object is destroyed)
+   */
+  SQLiteDatabase& getDb() const;
+
+  /**
+   * @brief Update the directories watched for external modifications
+   *
+   * All local libraries, their element type directories (e.g. "sym") and
+   * their element directories are watched. Remote libraries are not watched
+   * since they are only modified by the library manager, which triggers a
+   * rescan anyway.
+   */
+  void updateWatchedDirectories() noexcept;
+
+  /**
+   * @brief Remember a modified directory to be updated after #mRescanTimer
+   *
+   * Modifications within element directories only update these elements,
+   * all other modifications (e.g. new libraries) lead to a full rescan.
+   */
+  void watchedDirectoryChanged(const QString& dir) noexcept;
+  void processWatchedDirectoryChanges() noexcept;
+
+  void                clearCaches() noexcept;
+  CategoryTree        getCategoryTree(const QString& tablename) const;
+  QHash<QString, int> getCategoryElementCounts(
+      const QString& tablename, const QString& idrowname) const;
   void getElementTranslations(const QString& table, const QString& idRow,
                               const FilePath&    elemDir,
                               const QStringList& localeOrder, QString* name,
@@ -190,8 +270,41 @@ private:
   QScopedPointer<SQLiteDatabase> mDb;        ///< the SQLite database
   QScopedPointer<WorkspaceLibraryScanner> mLibraryScanner;
 
+  /// Expires on destruction to release the connections of other threads
+  std::shared_ptr<int> mLifetimeToken;
+
+  bool mHasSearchIndex;  ///< whether the full-text search index is available
+
+  /// Watches local libraries to rescan them after external modifications
+  QFileSystemWatcher mFileSystemWatcher;
+
+  /// Coalesces bursts of file system events (e.g. "git pull") into one rescan
+  QTimer mRescanTimer;
+
+  QSet<QString> mWatchedElementDirs;  ///< subset of the watched directories
+  QSet<QString> mChangedElementDirs;  ///< pending element updates
+  bool          mRescanPending;       ///< whether a full rescan is pending
+
+  /// Cached results of #getElementFilePathsFromDb(), key: table + UUID
+  mutable QCache<QString, QMultiMap<Version, FilePath>> mFilePathsCache;
+
+  /// Cached results of #getElementTranslations(), key: table + path + locales
+  mutable QCache<QString, CachedTranslations> mTranslationsCache;
+
+  /// Category trees, key: category table
+  mutable QHash<QString, CategoryTree> mCategoryTrees;
+
+  /// Number of elements per category, key: element table -> category UUID
+  mutable QHash<QString, QHash<QString, int>> mCategoryElementCounts;
+
+  /// Protects all the caches above since lookups may come from any thread
+  mutable QMutex mCacheMutex;
+
   // Constants
-  static const int sCurrentDbVersion = 2;
+  static const int sCurrentDbVersion      = 5;
+  static const int sSearchIndexTableCount = 8;      ///< search index row IDs
+  static const int sMaxCacheSize          = 10000;  ///< entries per cache
+  static const int sRescanDelayMs         = 2000;   ///< after last file event
 };
 
 /*******************************************************************************
@@ -0,0 +1,142 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibraryelementcache.h"
+
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/library/elements.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+using namespace library;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+WorkspaceLibraryElementCache::WorkspaceLibraryElementCache() noexcept
+  : mMutex(), mCache(sMaxCacheSizeKb) {
+}
+
+WorkspaceLibraryElementCache::~WorkspaceLibraryElementCache() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+std::shared_ptr<const ComponentCategory>
+WorkspaceLibraryElementCache::getComponentCategory(const FilePath& dir) {
+  return getElement<ComponentCategory>(dir);
+}
+
+std::shared_ptr<const PackageCategory>
+WorkspaceLibraryElementCache::getPackageCategory(const FilePath& dir) {
+  return getElement<PackageCategory>(dir);
+}
+
+std::shared_ptr<const Symbol> WorkspaceLibraryElementCache::getSymbol(
+    const FilePath& dir) {
+  return getElement<Symbol>(dir);
+}
+
+std::shared_ptr<const Package> WorkspaceLibraryElementCache::getPackage(
+    const FilePath& dir) {
+  return getElement<Package>(dir);
+}
+
+std::shared_ptr<const Component> WorkspaceLibraryElementCache::getComponent(
+    const FilePath& dir) {
+  return getElement<Component>(dir);
+}
+
+std::shared_ptr<const Device> WorkspaceLibraryElementCache::getDevice(
+    const FilePath& dir) {
+  return getElement<Device>(dir);
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void WorkspaceLibraryElementCache::clear() noexcept {
+  QMutexLocker lock(&mMutex);
+  mCache.clear();
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+template <typename ElementType>
+std::shared_ptr<const ElementType> WorkspaceLibraryElementCache::getElement(
+    const FilePath& dir) {
+  int     size  = 0;
+  QString stamp = getModificationStamp(dir, &size);
+  {
+    QMutexLocker lock(&mMutex);
+    if (const Entry* entry = mCache.object(dir.toStr())) {
+      std::shared_ptr<const ElementType> element =
+          std::dynamic_pointer_cast<const ElementType>(entry->element);
+      if (element && (entry->stamp == stamp)) {
+        return element;
+      }
+    }
+  }
+
+  // Parse the element without holding the lock, so other threads are not
+  // blocked while loading other elements.
+  std::shared_ptr<const ElementType> element = std::make_shared<ElementType>(
+      std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+          TransactionalFileSystem::openRO(dir))));  // can throw
+  QMutexLocker lock(&mMutex);
+  mCache.insert(dir.toStr(), new Entry{stamp, element}, qMax(size / 1024, 1));
+  return element;
+}
+
+QString WorkspaceLibraryElementCache::getModificationStamp(const FilePath& dir,
+                                                           int* size) noexcept {
+  // Element directories are flat and small, so checking sizes and timestamps
+  // of their files is much cheaper than parsing them.
+  QString stamp;
+  foreach (const QFileInfo& info,
+           QDir(dir.toStr()).entryInfoList(QDir::Files | QDir::Hidden,
+                                           QDir::Name)) {
+    stamp += info.fileName() % ":" % QString::number(info.size()) % ":" %
+        QString::number(info.lastModified().toMSecsSinceEpoch()) % ";";
+    *size += info.size();
+  }
+  return stamp;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
@@ -0,0 +1,117 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_WORKSPACELIBRARYELEMENTCACHE_H
+#define LIBREPCB_WORKSPACE_WORKSPACELIBRARYELEMENTCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+namespace library {
+class LibraryBaseElement;
+class ComponentCategory;
+class PackageCategory;
+class Symbol;
+class Package;
+class Component;
+class Device;
+}  // namespace library
+
+namespace workspace {
+
+/*******************************************************************************
+ *  Class WorkspaceLibraryElementCache
+ ******************************************************************************/
+
+/**
+ * @brief Cache of parsed library elements, shared by all editors and dialogs
+ *
+ * Elements are identified by their directory and are parsed again only if
+ * any file in the directory was modified since they were loaded. Since the
+ * elements are shared, they are immutable. The least recently used elements
+ * are evicted once the total size of their files exceeds a limit.
+ *
+ * @note All methods are thread-safe.
+ */
+class WorkspaceLibraryElementCache final {
+  Q_DECLARE_TR_FUNCTIONS(WorkspaceLibraryElementCache)
+
+public:
+  // Constructors / Destructor
+  WorkspaceLibraryElementCache(const WorkspaceLibraryElementCache& other) =
+      delete;
+  WorkspaceLibraryElementCache() noexcept;
+  ~WorkspaceLibraryElementCache() noexcept;
+
+  // Getters (all of them can throw if the element could not be loaded)
+  std::shared_ptr<const library::ComponentCategory> getComponentCategory(
+      const FilePath& dir);
+  std::shared_ptr<const library::PackageCategory> getPackageCategory(
+      const FilePath& dir);
+  std::shared_ptr<const library::Symbol>    getSymbol(const FilePath& dir);
+  std::shared_ptr<const library::Package>   getPackage(const FilePath& dir);
+  std::shared_ptr<const library::Component> getComponent(const FilePath& dir);
+  std::shared_ptr<const library::Device>    getDevice(const FilePath& dir);
+
+  // General Methods
+  void clear() noexcept;
+
+  // Operator Overloadings
+  WorkspaceLibraryElementCache& operator=(
+      const WorkspaceLibraryElementCache& rhs) = delete;
+
+private:  // Types
+  struct Entry {
+    QString                                            stamp;
+    std::shared_ptr<const library::LibraryBaseElement> element;
+  };
+
+private:  // Methods
+  template <typename ElementType>
+  std::shared_ptr<const ElementType> getElement(const FilePath& dir);
+  static QString getModificationStamp(const FilePath& dir, int* size) noexcept;
+
+private:  // Data
+  QMutex                 mMutex;
+  QCache<QString, Entry> mCache;  ///< key: directory, cost: size in KiB
+
+  /// Maximum total file size of the cached elements (in KiB)
+  static const int sMaxCacheSizeKb = 64 * 1024;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
+
+#endif  // LIBREPCB_WORKSPACE_WORKSPACELIBRARYELEMENTCACHE_H
@@ -23,10 +23,14 @@
 #include "workspacelibraryscanner.h"
 
 #include "../workspace.h"
+#include "workspacelibrarydb.h"
+#include "workspacelibrarythumbnailcache.h"
 
 #include <librepcb/common/fileio/transactionalfilesystem.h>
 #include <librepcb/common/sqlitedatabase.h>
 #include <librepcb/common/toolbox.h>
+#include <librepcb/common/tracer.h>
+#include <librepcb/common/utils/taskscheduler.h>
 #include <librepcb/library/elements.h>
 
 #include <QtCore>
@@ -49,7 +53,9 @@ WorkspaceLibraryScanner::WorkspaceLibraryScanner(
     mWorkspace(ws),
     mDbFilePath(dbFilePath),
     mSemaphore(0),
-    mAbort(false) {
+    mAbort(false),
+    mHasSearchIndex(false),
+    mScanRequested(false) {
   start();
 }
 
@@ -70,6 +76,17 @@ WorkspaceLibraryScanner::~WorkspaceLibraryScanner() noexcept {
  ******************************************************************************/
 
 void WorkspaceLibraryScanner::startScan() noexcept {
+  QMutexLocker lock(&mRequestsMutex);
+  mScanRequested = true;
+  mSemaphore.release();
+}
+
+void WorkspaceLibraryScanner::startElementUpdate(
+    const FilePath& elementDir) noexcept {
+  QMutexLocker lock(&mRequestsMutex);
+  if (!mRequestedElementUpdates.contains(elementDir)) {
+    mRequestedElementUpdates.append(elementDir);
+  }
   mSemaphore.release();
 }
 
@@ -89,6 +106,72 @@ QVariant WorkspaceLibraryScanner::optionalToVariant(
   return opt ? **opt : QVariant();
 }
 
+template <typename ElementType>
+void WorkspaceLibraryScanner::generateThumbnail(
+    WorkspaceLibraryThumbnailCache& thumbnails, const ElementType& element) {
+  Q_UNUSED(thumbnails);
+  Q_UNUSED(element);
+}
+
+template <>
+void WorkspaceLibraryScanner::generateThumbnail(
+    WorkspaceLibraryThumbnailCache& thumbnails, const Symbol& element) {
+  thumbnails.generate(element);
+}
+
+template <>
+void WorkspaceLibraryScanner::generateThumbnail(
+    WorkspaceLibraryThumbnailCache& thumbnails, const Package& element) {
+  thumbnails.generate(element);
+}
+
+template <typename ElementType>
+bool WorkspaceLibraryScanner::isThumbnailMissing(SQLiteDatabase& db,
+                                                 const QString&  table,
+                                                 const QString&  path) {
+  Q_UNUSED(db);
+  Q_UNUSED(table);
+  Q_UNUSED(path);
+  return false;
+}
+
+template <>
+bool WorkspaceLibraryScanner::isThumbnailMissing<Symbol>(SQLiteDatabase& db,
+                                                         const QString& table,
+                                                         const QString& path) {
+  return isThumbnailOfElementMissing(db, table, path);
+}
+
+template <>
+bool WorkspaceLibraryScanner::isThumbnailMissing<Package>(
+    SQLiteDatabase& db, const QString& table, const QString& path) {
+  return isThumbnailOfElementMissing(db, table, path);
+}
+
+bool WorkspaceLibraryScanner::isThumbnailOfElementMissing(SQLiteDatabase& db,
+                                                          const QString& table,
+                                                          const QString& path) {
+  // Elements which were scanned before thumbnails were introduced (or whose
+  // thumbnail was deleted) need to be parsed again to generate them.
+  if (!WorkspaceLibraryThumbnailCache::canGenerateInCurrentThread()) {
+    return false;
+  }
+  QSqlQuery& query = db.prepareCachedQuery(
+      "SELECT uuid, version FROM " % table % " WHERE filepath = :filepath");
+  query.bindValue(":filepath", path);
+  db.exec(query);
+  if (!query.next()) {
+    return false;  // new element
+  }
+  QString uuidStr    = query.value(0).toString();
+  QString versionStr = query.value(1).toString();
+  query.finish();
+  tl::optional<Uuid>    uuid    = Uuid::tryFromString(uuidStr);
+  tl::optional<Version> version = Version::tryFromString(versionStr);
+  return uuid && version &&
+      (!mWorkspace.getLibraryThumbnailCache().hasThumbnail(*uuid, *version));
+}
+
 void WorkspaceLibraryScanner::run() noexcept {
   qDebug() << "Workspace library scanner thread started.";
 
@@ -96,15 +179,33 @@ void WorkspaceLibraryScanner::run() noexcept {
     mSemaphore.acquire();
     if (mAbort) {
       break;
-    } else {
-      scan();
+    }
+
+    // Take all pending requests at once. A full scan covers all elements, so
+    // element updates are only needed if no scan is requested.
+    QMutexLocker    lock(&mRequestsMutex);
+    bool            scanRequested  = mScanRequested;
+    QList<FilePath> elementUpdates = mRequestedElementUpdates;
+    mScanRequested                 = false;
+    mRequestedElementUpdates.clear();
+    mSemaphore.tryAcquire(mSemaphore.available());
+    lock.unlock();
+    if (scanRequested) {
+      if ((!scan()) && (!mAbort)) {
+        // Aborted due to a new request, which must not discard the scan.
+        startScan();
+      }
+    } else if (!elementUpdates.isEmpty()) {
+      updateElements(elementUpdates);
     }
   }
 
   qDebug() << "Workspace library scanner thread stopped.";
 }
 
-void WorkspaceLibraryScanner::scan() noexcept {
+bool WorkspaceLibraryScanner::scan() noexcept {
+  LIBREPCB_TRACE_SCOPE("workspace", "WorkspaceLibraryScanner::scan");
+  bool completed = true;
   try {
     QElapsedTimer timer;
     timer.start();
@@ -113,7 +214,8 @@ void WorkspaceLibraryScanner::scan() noexcept {
     qDebug() << "Workspace library scan started.";
 
     // open SQLite database
-    SQLiteDatabase db(mDbFilePath);  // can throw
+    SQLiteDatabase db(mDbFilePath);                      // can throw
+    mHasSearchIndex = db.tableExists("search_index");  // can throw
 
     // update list of libraries
     std::shared_ptr<TransactionalFileSystem> fs =
@@ -130,8 +232,15 @@ void WorkspaceLibraryScanner::scan() noexcept {
     // begin database transaction
     SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
 
-    // clear all tables
-    clearAllTables(db);
+    // Get all elements currently contained in the database. Only new or
+    // modified elements need to be parsed and written to the database.
+    QStringList tables = {"component_categories", "package_categories",
+                          "symbols",              "packages",
+                          "components",           "devices"};
+    QHash<QString, DbElements> dbElements;
+    foreach (const QString& table, tables) {
+      dbElements.insert(table, getElementsFromDb(db, table));  // can throw
+    }
 
     // scan all libraries
     int   count   = 0;
@@ -144,37 +253,45 @@ void WorkspaceLibraryScanner::scan() noexcept {
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addCategoriesToDb<ComponentCategory>(
           db, fs, fp, lib->searchForElements<ComponentCategory>(),
-          "component_categories", "cat_id", libId);
+          "component_categories", "cat_id", libId,
+          dbElements["component_categories"]);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addCategoriesToDb<PackageCategory>(
           db, fs, fp, lib->searchForElements<PackageCategory>(),
-          "package_categories", "cat_id", libId);
+          "package_categories", "cat_id", libId,
+          dbElements["package_categories"]);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count +=
-          addElementsToDb<Symbol>(db, fs, fp, lib->searchForElements<Symbol>(),
-                                  "symbols", "symbol_id", libId);
+      count += addElementsToDb<Symbol>(db, fs, fp,
+                                       lib->searchForElements<Symbol>(),
+                                       "symbols", "symbol_id", libId,
+                                       dbElements["symbols"]);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
       count += addElementsToDb<Package>(db, fs, fp,
                                         lib->searchForElements<Package>(),
-                                        "packages", "package_id", libId);
+                                        "packages", "package_id", libId,
+                                        dbElements["packages"]);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count += addElementsToDb<Component>(db, fs, fp,
-                                          lib->searchForElements<Component>(),
-                                          "components", "component_id", libId);
+      count += addElementsToDb<Component>(
+          db, fs, fp, lib->searchForElements<Component>(), "components",
+          "component_id", libId, dbElements["components"]);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
       if (mAbort || (mSemaphore.available() > 0)) break;
-      count +=
-          addElementsToDb<Device>(db, fs, fp, lib->searchForElements<Device>(),
-                                  "devices", "device_id", libId);
+      count += addElementsToDb<Device>(db, fs, fp,
+                                       lib->searchForElements<Device>(),
+                                       "devices", "device_id", libId,
+                                       dbElements["devices"]);
       emit scanProgressUpdate(percent += qreal(98) / (libraries.count() * 6));
     }
 
-    // commit transaction
+    // remove elements which no longer exist, then commit transaction
     if ((!mAbort) && (mSemaphore.available() == 0)) {
+      foreach (const QString& table, tables) {
+        removeElementsFromDb(db, table, dbElements[table]);  // can throw
+      }
       transactionGuard.commit();  // can throw
       qDebug() << "Workspace library scan succeeded:" << count << "elements in"
                << timer.elapsed() << "ms";
@@ -182,6 +299,7 @@ void WorkspaceLibraryScanner::scan() noexcept {
     } else {
       qDebug() << "Workspace library scan aborted after" << timer.elapsed()
                << "ms.";
+      completed = false;
     }
   } catch (const Exception& e) {
     qDebug() << "Workspace library scan failed:" << e.getMsg();
@@ -189,6 +307,104 @@ void WorkspaceLibraryScanner::scan() noexcept {
   }
   emit scanProgressUpdate(100);
   emit scanFinished();
+  return completed;
+}
+
+void WorkspaceLibraryScanner::updateElements(
+    const QList<FilePath>& elementDirs) noexcept {
+  LIBREPCB_TRACE_SCOPE("workspace", "WorkspaceLibraryScanner::updateElements");
+  try {
+    QElapsedTimer timer;
+    timer.start();
+
+    // open SQLite database
+    SQLiteDatabase db(mDbFilePath);                      // can throw
+    mHasSearchIndex = db.tableExists("search_index");  // can throw
+
+    // Use the same code path as a scan, just with a single element.
+    std::shared_ptr<TransactionalFileSystem> fs =
+        TransactionalFileSystem::openRO(mWorkspace.getLibrariesPath());
+    SQLiteDatabase::TransactionScopeGuard transactionGuard(db);  // can throw
+    int                                   count = 0;
+    foreach (const FilePath& dir, elementDirs) {
+      if (dir.isLocatedInDir(mWorkspace.getLibrariesPath())) {
+        count += updateElement(db, fs, dir.toRelative(fs->getPath()));
+      }
+    }
+    transactionGuard.commit();  // can throw
+    qDebug() << "Workspace library elements updated:" << count << "of"
+             << elementDirs.count() << "elements in" << timer.elapsed()
+             << "ms";
+  } catch (const Exception& e) {
+    qDebug() << "Workspace library element update failed:" << e.getMsg();
+  }
+  emit scanFinished();
+}
+
+int WorkspaceLibraryScanner::updateElement(
+    SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
+    const QString& path) {
+  // path: "<library directory>/<element type directory>/<element directory>"
+  QString     libPath = path.section('/', 0, -3);
+  QString     type    = path.section('/', -2, -2);
+  QStringList dirs    = {path.section('/', -2)};  // relative to the library
+  QSqlQuery&  query   = db.prepareCachedQuery(
+      "SELECT id FROM libraries WHERE filepath = :filepath");
+  query.bindValue(":filepath", libPath);
+  db.exec(query);
+  if (!query.next()) {
+    qDebug() << "Library of updated element not indexed yet:" << libPath;
+    startScan();  // also adds the library
+    return 0;
+  }
+  int libId = query.value(0).toInt();
+  query.finish();
+
+  QString table;
+  if (type == ComponentCategory::getShortElementName()) {
+    table = "component_categories";
+  } else if (type == PackageCategory::getShortElementName()) {
+    table = "package_categories";
+  } else if (type == Symbol::getShortElementName()) {
+    table = "symbols";
+  } else if (type == Package::getShortElementName()) {
+    table = "packages";
+  } else if (type == Component::getShortElementName()) {
+    table = "components";
+  } else if (type == Device::getShortElementName()) {
+    table = "devices";
+  } else {
+    qWarning() << "Unknown type of updated library element:" << path;
+    return 0;
+  }
+
+  // If the element still exists, it is taken from dbElements. Otherwise it
+  // is removed from the database.
+  int        count      = 0;
+  DbElements dbElements = getElementsFromDb(db, table, path);  // can throw
+  if (fs->getAbsPath(path).isExistingDir()) {
+    if (table == "component_categories") {
+      count = addCategoriesToDb<ComponentCategory>(
+          db, fs, libPath, dirs, table, "cat_id", libId, dbElements);
+    } else if (table == "package_categories") {
+      count = addCategoriesToDb<PackageCategory>(
+          db, fs, libPath, dirs, table, "cat_id", libId, dbElements);
+    } else if (table == "symbols") {
+      count = addElementsToDb<Symbol>(db, fs, libPath, dirs, table,
+                                      "symbol_id", libId, dbElements);
+    } else if (table == "packages") {
+      count = addElementsToDb<Package>(db, fs, libPath, dirs, table,
+                                       "package_id", libId, dbElements);
+    } else if (table == "components") {
+      count = addElementsToDb<Component>(db, fs, libPath, dirs, table,
+                                         "component_id", libId, dbElements);
+    } else {
+      count = addElementsToDb<Device>(db, fs, libPath, dirs, table,
+                                      "device_id", libId, dbElements);
+    }
+  }
+  removeElementsFromDb(db, table, dbElements);  // can throw
+  return count;
 }
 
 void WorkspaceLibraryScanner::getLibrariesOfDirectory(
@@ -303,86 +519,104 @@ QHash<QString, int> WorkspaceLibraryScanner::updateLibraries(
   return dbLibIds;
 }
 
-void WorkspaceLibraryScanner::clearAllTables(SQLiteDatabase& db) {
-  // component categories
-  db.clearTable("component_categories_tr");
-  db.clearTable("component_categories");
-
-  // package categories
-  db.clearTable("package_categories_tr");
-  db.clearTable("package_categories");
+WorkspaceLibraryScanner::DbElements WorkspaceLibraryScanner::getElementsFromDb(
+    SQLiteDatabase& db, const QString& table, const QString& filepath) {
+  DbElements elements;
+  QSqlQuery  query =
+      db.prepareQuery("SELECT id, filepath, fingerprint FROM " % table %
+                      (filepath.isNull() ? "" : " WHERE filepath = :filepath"));
+  if (!filepath.isNull()) {
+    query.bindValue(":filepath", filepath);
+  }
+  db.exec(query);
+  while (query.next()) {
+    int     id          = query.value(0).toInt();
+    QString fp          = query.value(1).toString();
+    QString fingerprint = query.value(2).toString();
+    elements.insert(fp, qMakePair(id, fingerprint));
+  }
+  return elements;
+}
 
-  // symbols
-  db.clearTable("symbols_tr");
-  db.clearTable("symbols_cat");
-  db.clearTable("symbols");
+void WorkspaceLibraryScanner::removeElementsFromDb(SQLiteDatabase&   db,
+                                                   const QString&    table,
+                                                   const DbElements& elements) {
+  // translations and categories are removed by "ON DELETE CASCADE"
+  QSqlQuery& query =
+      db.prepareCachedQuery("DELETE FROM " % table % " WHERE id = :id");
+  foreach (const auto& element, elements) {
+    query.bindValue(":id", element.first);
+    db.exec(query);
+  }
 
-  // packages
-  db.clearTable("packages_tr");
-  db.clearTable("packages_cat");
-  db.clearTable("packages");
+  // the search index has no foreign keys, so remove its entries explicitly
+  if (mHasSearchIndex && (!elements.isEmpty())) {
+    QSqlQuery& indexQuery =
+        db.prepareCachedQuery("DELETE FROM search_index WHERE rowid = :rowid");
+    foreach (const auto& element, elements) {
+      indexQuery.bindValue(
+          ":rowid",
+          WorkspaceLibraryDb::getSearchIndexRowId(table, element.first));
+      db.exec(indexQuery);
+    }
+  }
+}
 
-  // components
-  db.clearTable("components_tr");
-  db.clearTable("components_cat");
-  db.clearTable("components");
+bool WorkspaceLibraryScanner::isElementUnchanged(SQLiteDatabase&   db,
+                                                 const QString&    table,
+                                                 const QString&    path,
+                                                 const QString&    fingerprint,
+                                                 bool              forceUpdate,
+                                                 DbElements&       dbElements) {
+  auto it = dbElements.find(path);
+  if (it == dbElements.end()) {
+    return false;  // new element
+  }
 
-  // devices
-  db.clearTable("devices_tr");
-  db.clearTable("devices_cat");
-  db.clearTable("devices");
+  // The element still exists, so take it from the list of elements to be
+  // removed. If it was modified, remove it from the database to allow adding
+  // it again.
+  bool unchanged = (it.value().second == fingerprint) && (!forceUpdate);
+  if (!unchanged) {
+    DbElements outdated;
+    outdated.insert(it.key(), it.value());
+    removeElementsFromDb(db, table, outdated);  // can throw
+  }
+  dbElements.erase(it);
+  return unchanged;
 }
 
 template <typename ElementType>
 int WorkspaceLibraryScanner::addCategoriesToDb(
     SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
     const QString& libPath, const QStringList& dirs, const QString& table,
-    const QString& idColumn, int libId) {
-  int count = 0;
-  foreach (const QString& dirpath, dirs) {
-    if (mAbort || (mSemaphore.available() > 0)) break;
-    QString fullPath = libPath % "/" % dirpath;
-    try {
-      std::unique_ptr<TransactionalDirectory> dir(
-          new TransactionalDirectory(fs, fullPath));  // can throw
-      ElementType element(std::move(dir));            // can throw
-      QSqlQuery   query = db.prepareQuery(
-          "INSERT INTO " % table %
-          " "
-          "(lib_id, filepath, uuid, version, parent_uuid) VALUES "
-          "(:lib_id, :filepath, :uuid, :version, :parent_uuid)");
-      query.bindValue(":lib_id", libId);
-      query.bindValue(":filepath", fullPath);
-      query.bindValue(":uuid", element.getUuid().toStr());
-      query.bindValue(":version", element.getVersion().toStr());
-      query.bindValue(":parent_uuid", element.getParentUuid()
-                                          ? element.getParentUuid()->toStr()
-                                          : QVariant(QVariant::String));
-      int id = db.insert(query);
-      foreach (const QString& locale, element.getAllAvailableLocales()) {
-        QSqlQuery query = db.prepareQuery(
-            "INSERT INTO " % table %
-            "_tr "
-            "(" %
-            idColumn %
-            ", locale, name, description, keywords) VALUES "
-            "(:element_id, :locale, :name, :description, :keywords)");
-        query.bindValue(":element_id", id);
-        query.bindValue(":locale", locale);
-        query.bindValue(":name",
-                        optionalToVariant(element.getNames().tryGet(locale)));
-        query.bindValue(
-            ":description",
-            optionalToVariant(element.getDescriptions().tryGet(locale)));
-        query.bindValue(":keywords", optionalToVariant(
-                                         element.getKeywords().tryGet(locale)));
-        db.insert(query);
-      }
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << fullPath;
-    }
-  }
+    const QString& idColumn, int libId, DbElements& dbElements) {
+  int                            count = 0;
+  QList<QPair<QString, QString>> modified =
+      getModifiedElements<ElementType>(db, fs, libPath, dirs, table, dbElements,
+                                       count);
+  parseElements<ElementType>(fs, modified, [&](const QString&     path,
+                                               const QString&     fingerprint,
+                                               const ElementType& element) {
+    QSqlQuery& query = db.prepareCachedQuery(
+        "INSERT INTO " % table %
+        " "
+        "(lib_id, filepath, uuid, version, fingerprint, parent_uuid) "
+        "VALUES "
+        "(:lib_id, :filepath, :uuid, :version, :fingerprint, :parent_uuid)");
+    query.bindValue(":lib_id", libId);
+    query.bindValue(":filepath", path);
+    query.bindValue(":fingerprint", fingerprint);
+    query.bindValue(":uuid", element.getUuid().toStr());
+    query.bindValue(":version", element.getVersion().toStr());
+    query.bindValue(":parent_uuid", element.getParentUuid()
+                                        ? element.getParentUuid()->toStr()
+                                        : QVariant(QVariant::String));
+    int id = db.insert(query);
+    addElementTranslationsToDb(db, table % "_tr", idColumn, id, element);
+    addElementToSearchIndex(db, table, id, element);
+    count++;
+  });
   return count;
 }
 
@@ -390,39 +624,109 @@ template <typename ElementType>
 int WorkspaceLibraryScanner::addElementsToDb(
     SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
     const QString& libPath, const QStringList& dirs, const QString& table,
-    const QString& idColumn, int libId) {
-  int count = 0;
+    const QString& idColumn, int libId, DbElements& dbElements) {
+  int                            count = 0;
+  QList<QPair<QString, QString>> modified =
+      getModifiedElements<ElementType>(db, fs, libPath, dirs, table, dbElements,
+                                       count);
+  parseElements<ElementType>(fs, modified, [&](const QString&     path,
+                                               const QString&     fingerprint,
+                                               const ElementType& element) {
+    addElementToDb(db, table, idColumn, libId, path, fingerprint, element);
+    count++;
+  });
+  return count;
+}
+
+template <typename ElementType>
+QList<QPair<QString, QString>> WorkspaceLibraryScanner::getModifiedElements(
+    SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
+    const QString& libPath, const QStringList& dirs, const QString& table,
+    DbElements& dbElements, int& unchangedCount) {
+  QList<QPair<QString, QString>> modified;
   foreach (const QString& dirpath, dirs) {
     if (mAbort || (mSemaphore.available() > 0)) break;
-    QString fullPath = libPath % "/" % dirpath;
-    try {
-      std::unique_ptr<TransactionalDirectory> dir(
-          new TransactionalDirectory(fs, fullPath));  // can throw
-      ElementType element(std::move(dir));            // can throw
-      addElementToDb(db, table, idColumn, libId, fullPath, element);
-      count++;
-    } catch (const Exception& e) {
-      qWarning() << "Failed to open library element:" << fullPath;
+    QString fullPath    = libPath % "/" % dirpath;
+    QString fingerprint = getElementFingerprint(fs->getAbsPath(fullPath));
+    bool    forceUpdate = isThumbnailMissing<ElementType>(db, table, fullPath);
+    if (isElementUnchanged(db, table, fullPath, fingerprint, forceUpdate,
+                           dbElements)) {  // can throw
+      unchangedCount++;
+    } else {
+      modified.append(qMakePair(fullPath, fingerprint));
     }
   }
-  return count;
+  return modified;
 }
 
 template <typename ElementType>
-void WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
-                                             const QString&  table,
-                                             const QString& idColumn, int libId,
-                                             const QString&     path,
-                                             const ElementType& element) {
-  QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                    " (lib_id, filepath, uuid, version) VALUES "
-                                    "(:lib_id, :filepath, :uuid, :version)");
+void WorkspaceLibraryScanner::parseElements(
+    std::shared_ptr<TransactionalFileSystem> fs,
+    const QList<QPair<QString, QString>>&    elements,
+    const std::function<void(const QString&, const QString&,
+                             const ElementType&)>& callback) {
+  LIBREPCB_TRACE_SCOPE("workspace", "WorkspaceLibraryScanner::parseElements");
+  // The elements are parsed in parallel, but in chunks to limit the memory
+  // usage. Each element gets its own file system since TransactionalFileSystem
+  // is not thread-safe. The database is only accessed from this thread.
+  for (int i = 0; i < elements.count(); i += sParseChunkSize) {
+    if (mAbort || (mSemaphore.available() > 0)) break;
+    QList<QFuture<std::shared_ptr<ElementType>>> futures;
+    WorkspaceLibraryThumbnailCache* thumbnails =
+        &mWorkspace.getLibraryThumbnailCache();
+    for (int k = i; k < qMin(i + sParseChunkSize, elements.count()); ++k) {
+      FilePath fp = fs->getAbsPath(elements.at(k).first);
+      // Scanning runs in background, don't delay work the user is waiting for.
+      futures.append(TaskScheduler::run(
+          TaskScheduler::Priority::Background, [fp, thumbnails]() {
+            return openElement<ElementType>(fp, thumbnails);
+          }));
+    }
+    for (int k = 0; k < futures.count(); ++k) {
+      const QString& path        = elements.at(i + k).first;
+      const QString& fingerprint = elements.at(i + k).second;
+      try {
+        std::shared_ptr<ElementType> element = futures[k].result();  // throws
+        callback(path, fingerprint, *element);  // can throw
+      } catch (const Exception& e) {
+        qWarning() << "Failed to open library element:" << path;
+      }
+    }
+  }
+}
+
+template <typename ElementType>
+std::shared_ptr<ElementType> WorkspaceLibraryScanner::openElement(
+    const FilePath& fp, WorkspaceLibraryThumbnailCache* thumbnails) {
+  LIBREPCB_TRACE_SCOPE("workspace", "WorkspaceLibraryScanner::openElement");
+  std::unique_ptr<TransactionalDirectory> dir(new TransactionalDirectory(
+      TransactionalFileSystem::openRO(fp)));  // can throw
+  std::shared_ptr<ElementType> element =
+      std::make_shared<ElementType>(std::move(dir));  // can throw
+
+  // Render the thumbnail in this worker thread as well, so it is done in
+  // parallel and only for new or modified elements.
+  generateThumbnail(*thumbnails, *element);
+  return element;
+}
+
+template <typename ElementType>
+void WorkspaceLibraryScanner::addElementToDb(
+    SQLiteDatabase& db, const QString& table, const QString& idColumn,
+    int libId, const QString& path, const QString& fingerprint,
+    const ElementType& element) {
+  QSqlQuery& query = db.prepareCachedQuery(
+      "INSERT INTO " % table %
+      " (lib_id, filepath, uuid, version, fingerprint) VALUES "
+      "(:lib_id, :filepath, :uuid, :version, :fingerprint)");
   query.bindValue(":lib_id", libId);
   query.bindValue(":filepath", path);
+  query.bindValue(":fingerprint", fingerprint);
   query.bindValue(":uuid", element.getUuid().toStr());
   query.bindValue(":version", element.getVersion().toStr());
   int id = db.insert(query);
   addElementTranslationsToDb(db, table % "_tr", idColumn, id, element);
+  addElementToSearchIndex(db, table, id, element);
   addElementCategoriesToDb(db, table % "_cat", idColumn, id,
                            element.getCategories());
 }
@@ -430,21 +734,25 @@ void WorkspaceLibraryScanner::addElementToDb(SQLiteDatabase& db,
 template <>
 void WorkspaceLibraryScanner::addElementToDb<Device>(
     SQLiteDatabase& db, const QString& table, const QString& idColumn,
-    int libId, const QString& path, const Device& element) {
-  QSqlQuery query = db.prepareQuery("INSERT INTO " % table %
-                                    " "
-                                    "(lib_id, filepath, uuid, version, "
-                                    "component_uuid, package_uuid) VALUES "
-                                    "(:lib_id, :filepath, :uuid, :version, "
-                                    ":component_uuid, :package_uuid)");
+    int libId, const QString& path, const QString& fingerprint,
+    const Device& element) {
+  QSqlQuery& query = db.prepareCachedQuery(
+      "INSERT INTO " % table %
+      " "
+      "(lib_id, filepath, uuid, version, fingerprint, component_uuid, "
+      "package_uuid) VALUES "
+      "(:lib_id, :filepath, :uuid, :version, :fingerprint, :component_uuid, "
+      ":package_uuid)");
   query.bindValue(":lib_id", libId);
   query.bindValue(":filepath", path);
+  query.bindValue(":fingerprint", fingerprint);
   query.bindValue(":uuid", element.getUuid().toStr());
   query.bindValue(":version", element.getVersion().toStr());
   query.bindValue(":component_uuid", element.getComponentUuid().toStr());
   query.bindValue(":package_uuid", element.getPackageUuid().toStr());
   int id = db.insert(query);
   addElementTranslationsToDb(db, table % "_tr", idColumn, id, element);
+  addElementToSearchIndex(db, table, id, element);
   addElementCategoriesToDb(db, table % "_cat", idColumn, id,
                            element.getCategories());
 }
@@ -453,11 +761,11 @@ template <typename ElementType>
 void WorkspaceLibraryScanner::addElementTranslationsToDb(
     SQLiteDatabase& db, const QString& table, const QString& idColumn, int id,
     const ElementType& element) {
+  QSqlQuery& query = db.prepareCachedQuery(
+      "INSERT INTO " % table % " (" % idColumn %
+      ", locale, name, description, keywords) VALUES "
+      "(:element_id, :locale, :name, :description, :keywords)");
   foreach (const QString& locale, element.getAllAvailableLocales()) {
-    QSqlQuery query = db.prepareQuery(
-        "INSERT INTO " % table % " (" % idColumn %
-        ", locale, name, description, keywords) VALUES "
-        "(:element_id, :locale, :name, :description, :keywords)");
     query.bindValue(":element_id", id);
     query.bindValue(":locale", locale);
     query.bindValue(":name",
@@ -471,19 +779,70 @@ void WorkspaceLibraryScanner::addElementTranslationsToDb(
   }
 }
 
+template <typename ElementType>
+void WorkspaceLibraryScanner::addElementToSearchIndex(
+    SQLiteDatabase& db, const QString& table, int id,
+    const ElementType& element) {
+  qint64 rowId = WorkspaceLibraryDb::getSearchIndexRowId(table, id);
+  if ((!mHasSearchIndex) || (rowId < 0)) {
+    return;
+  }
+
+  // one row per element, containing the texts of all locales
+  QStringList names;
+  QStringList keywords;
+  foreach (const QString& locale, element.getAllAvailableLocales()) {
+    if (auto name = element.getNames().tryGet(locale)) {
+      names.append(**name);
+    }
+    if (auto kw = element.getKeywords().tryGet(locale)) {
+      keywords.append(*kw);
+    }
+  }
+  QSqlQuery& query = db.prepareCachedQuery(
+      "INSERT INTO search_index (rowid, name, keywords) "
+      "VALUES (:rowid, :name, :keywords)");
+  query.bindValue(":rowid", rowId);
+  query.bindValue(":name", names.join("\n"));
+  query.bindValue(":keywords", keywords.join("\n"));
+  db.exec(query);
+}
+
 void WorkspaceLibraryScanner::addElementCategoriesToDb(
     SQLiteDatabase& db, const QString& table, const QString& idColumn, int id,
     const QSet<Uuid>& categories) {
+  QSqlQuery& query = db.prepareCachedQuery(
+      "INSERT INTO " % table % " (" % idColumn %
+      ", category_uuid) VALUES (:element_id, :category_uuid)");
   foreach (const Uuid& categoryUuid, categories) {
-    QSqlQuery query = db.prepareQuery("INSERT INTO " % table % " (" % idColumn %
-                                      ", category_uuid) VALUES "
-                                      "(:element_id, :category_uuid)");
     query.bindValue(":element_id", id);
     query.bindValue(":category_uuid", categoryUuid.toStr());
     db.insert(query);
   }
 }
 
+QString WorkspaceLibraryScanner::getElementFingerprint(
+    const FilePath& dir) noexcept {
+  // Only the file sizes and modification times are taken into account since
+  // reading all files would be almost as slow as parsing them.
+  QDir         qdir(dir.toStr());
+  QStringList  entries;
+  QDirIterator it(dir.toStr(), QDir::Files | QDir::Hidden,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    QFileInfo info = it.fileInfo();
+    entries.append(QString("%1:%2:%3")
+                       .arg(qdir.relativeFilePath(info.filePath()))
+                       .arg(info.size())
+                       .arg(info.lastModified().toMSecsSinceEpoch()));
+  }
+  entries.sort();  // order of QDirIterator is undefined
+  return QCryptographicHash::hash(entries.join('\n').toUtf8(),
+                                  QCryptographicHash::Sha1)
+      .toHex();
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
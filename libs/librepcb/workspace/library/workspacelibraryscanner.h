@@ -27,6 +27,7 @@
 
 #include <QtCore>
 
+#include <functional>
 #include <memory>
 
 /*******************************************************************************
@@ -46,6 +47,7 @@ class Library;
 namespace workspace {
 
 class Workspace;
+class WorkspaceLibraryThumbnailCache;
 
 /*******************************************************************************
  *  Class WorkspaceLibraryScanner
@@ -70,6 +72,21 @@ public:
   // General Methods
   void startScan() noexcept;
 
+  /**
+   * @brief Update the database rows of a single library element
+   *
+   * Much faster than a full scan, thus intended to update elements right
+   * after they were saved (e.g. by the library editor). If the element
+   * directory does not exist anymore, the element is removed from the
+   * database. If its library is not contained in the database yet, a full
+   * scan is started instead.
+   *
+   * @note  In contrast to #startScan(), only #scanFinished() is emitted.
+   *
+   * @param elementDir  The directory of the element (e.g. a symbol)
+   */
+  void startElementUpdate(const FilePath& elementDir) noexcept;
+
   // Operator Overloadings
   WorkspaceLibraryScanner& operator=(const WorkspaceLibraryScanner& rhs) =
       delete;
@@ -82,13 +99,20 @@ signals:
   void scanFailed(QString errorMsg);
   void scanFinished();
 
+private:  // Types
+  /// Elements in the database: filepath -> (id, fingerprint)
+  typedef QHash<QString, QPair<int, QString>> DbElements;
+
 private:  // Methods
   void                run() noexcept override;
-  void                scan() noexcept;
+  bool                scan() noexcept;
   QHash<QString, int> updateLibraries(
       SQLiteDatabase&                                          db,
       const QHash<QString, std::shared_ptr<library::Library>>& libs);
-  void clearAllTables(SQLiteDatabase& db);
+  DbElements getElementsFromDb(SQLiteDatabase& db, const QString& table,
+                               const QString& filepath = QString());
+  void       removeElementsFromDb(SQLiteDatabase& db, const QString& table,
+                                  const DbElements& elements);
   void getLibrariesOfDirectory(
       std::shared_ptr<TransactionalFileSystem> fs, const QString& root,
       QHash<QString, std::shared_ptr<library::Library>>& libs) noexcept;
@@ -97,31 +121,75 @@ private:  // Methods
                         std::shared_ptr<TransactionalFileSystem> fs,
                         const QString& libPath, const QStringList& dirs,
                         const QString& table, const QString& idColumn,
-                        int libId);
+                        int libId, DbElements& dbElements);
   template <typename ElementType>
   int addElementsToDb(SQLiteDatabase&                          db,
                       std::shared_ptr<TransactionalFileSystem> fs,
                       const QString& libPath, const QStringList& dirs,
-                      const QString& table, const QString& idColumn, int libId);
+                      const QString& table, const QString& idColumn, int libId,
+                      DbElements& dbElements);
+  template <typename ElementType>
+  QList<QPair<QString, QString>> getModifiedElements(
+      SQLiteDatabase& db, std::shared_ptr<TransactionalFileSystem> fs,
+      const QString& libPath, const QStringList& dirs, const QString& table,
+      DbElements& dbElements, int& unchangedCount);
+  template <typename ElementType>
+  void parseElements(std::shared_ptr<TransactionalFileSystem> fs,
+                     const QList<QPair<QString, QString>>&    elements,
+                     const std::function<void(const QString&, const QString&,
+                                              const ElementType&)>& callback);
+  template <typename ElementType>
+  static std::shared_ptr<ElementType> openElement(
+      const FilePath& fp, WorkspaceLibraryThumbnailCache* thumbnails);
+  template <typename ElementType>
+  static void generateThumbnail(WorkspaceLibraryThumbnailCache& thumbnails,
+                                const ElementType&              element);
+  template <typename ElementType>
+  bool isThumbnailMissing(SQLiteDatabase& db, const QString& table,
+                          const QString& path);
+  bool isThumbnailOfElementMissing(SQLiteDatabase& db, const QString& table,
+                                   const QString& path);
   template <typename ElementType>
   void addElementToDb(SQLiteDatabase& db, const QString& table,
                       const QString& idColumn, int libId, const QString& path,
-                      const ElementType& element);
+                      const QString& fingerprint, const ElementType& element);
+  bool isElementUnchanged(SQLiteDatabase& db, const QString& table,
+                          const QString& path, const QString& fingerprint,
+                          bool forceUpdate, DbElements& dbElements);
   template <typename ElementType>
   void addElementTranslationsToDb(SQLiteDatabase& db, const QString& table,
                                   const QString& idColumn, int id,
                                   const ElementType& element);
+  template <typename ElementType>
+  void addElementToSearchIndex(SQLiteDatabase& db, const QString& table,
+                               int id, const ElementType& element);
   void addElementCategoriesToDb(SQLiteDatabase& db, const QString& table,
                                 const QString& idColumn, int id,
                                 const QSet<Uuid>& categories);
   template <typename T>
   static QVariant optionalToVariant(const T& opt) noexcept;
+  static QString  getElementFingerprint(const FilePath& dir) noexcept;
+
+  // Methods for updating single elements
+  void updateElements(const QList<FilePath>& elementDirs) noexcept;
+  int  updateElement(SQLiteDatabase&                          db,
+                     std::shared_ptr<TransactionalFileSystem> fs,
+                     const QString&                           path);
 
 private:  // Data
   Workspace&    mWorkspace;
   FilePath      mDbFilePath;
   QSemaphore    mSemaphore;
   volatile bool mAbort;
+  bool          mHasSearchIndex;  ///< see WorkspaceLibraryDb::createAllTables()
+
+  // Requests, protected by #mRequestsMutex
+  QMutex          mRequestsMutex;
+  bool            mScanRequested;
+  QList<FilePath> mRequestedElementUpdates;
+
+  /// Number of elements parsed in parallel before writing them to the database
+  static constexpr int sParseChunkSize = 100;
 };
 
 /*******************************************************************************
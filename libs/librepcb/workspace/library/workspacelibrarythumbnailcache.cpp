@@ -0,0 +1,172 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "workspacelibrarythumbnailcache.h"
+
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/graphics/defaultgraphicslayerprovider.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/library/elements.h>
+#include <librepcb/library/pkg/footprintpreviewgraphicsitem.h>
+#include <librepcb/library/sym/symbolpreviewgraphicsitem.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace workspace {
+
+using namespace library;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+WorkspaceLibraryThumbnailCache::WorkspaceLibraryThumbnailCache(
+    const FilePath& dir) noexcept
+  : mDirectory(dir), mMutex(), mCache(sMaxCacheSizeKb) {
+}
+
+WorkspaceLibraryThumbnailCache::~WorkspaceLibraryThumbnailCache() noexcept {
+}
+
+/*******************************************************************************
+ *  Getters
+ ******************************************************************************/
+
+FilePath WorkspaceLibraryThumbnailCache::getFilePath(
+    const Uuid& uuid, const Version& version) const noexcept {
+  return mDirectory.getPathTo(uuid.toStr() % "_" % version.toStr() % ".png");
+}
+
+bool WorkspaceLibraryThumbnailCache::hasThumbnail(
+    const Uuid& uuid, const Version& version) const noexcept {
+  return getFilePath(uuid, version).isExistingFile();
+}
+
+QImage WorkspaceLibraryThumbnailCache::getThumbnail(
+    const Uuid& uuid, const Version& version) const noexcept {
+  FilePath fp = getFilePath(uuid, version);
+  {
+    QMutexLocker lock(&mMutex);
+    if (const QImage* image = mCache.object(fp.getFilename())) {
+      return *image;
+    }
+  }
+
+  // Load the image without holding the lock, so other threads are not blocked.
+  QImage image;
+  if ((!fp.isExistingFile()) || (!image.load(fp.toStr(), "PNG"))) {
+    return QImage();
+  }
+  QMutexLocker lock(&mMutex);
+  mCache.insert(fp.getFilename(), new QImage(image),
+                qMax(image.byteCount() / 1024, 1));
+  return image;
+}
+
+QString WorkspaceLibraryThumbnailCache::getThumbnailHtml(
+    const Uuid& uuid, const Version& version) const noexcept {
+  FilePath fp = getFilePath(uuid, version);
+  if (!fp.isExistingFile()) {
+    return QString();
+  }
+  return QString("<img src=\"%1\">").arg(fp.toStr().toHtmlEscaped());
+}
+
+bool WorkspaceLibraryThumbnailCache::canGenerateInCurrentThread() noexcept {
+  QCoreApplication* app = QCoreApplication::instance();
+  if (app && (QThread::currentThread() == app->thread())) {
+    return true;
+  }
+  return QFontDatabase::supportsThreadedFontRendering();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+bool WorkspaceLibraryThumbnailCache::generate(const Symbol& symbol) noexcept {
+  if (!canGenerateInCurrentThread()) {
+    return false;
+  }
+  DefaultGraphicsLayerProvider layers;
+  SymbolPreviewGraphicsItem    item(layers, QStringList(), symbol);
+  return generate(symbol.getUuid(), symbol.getVersion(), &item, Qt::white);
+}
+
+bool WorkspaceLibraryThumbnailCache::generate(const Package& package) noexcept {
+  if (!canGenerateInCurrentThread()) {
+    return false;
+  } else if (package.getFootprints().isEmpty()) {
+    return generate(package.getUuid(), package.getVersion(), nullptr,
+                    Qt::black);
+  }
+  DefaultGraphicsLayerProvider layers;
+  FootprintPreviewGraphicsItem item(layers, QStringList(),
+                                    *package.getFootprints().first(), &package);
+  return generate(package.getUuid(), package.getVersion(), &item, Qt::black);
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+bool WorkspaceLibraryThumbnailCache::generate(
+    const Uuid& uuid, const Version& version, QGraphicsItem* item,
+    const QColor& background) noexcept {
+  GraphicsScene scene;
+  if (item) scene.addItem(*item);
+  QImage image =
+      scene.toImage(QSize(sThumbnailSize, sThumbnailSize), background);
+  if (item) scene.removeItem(*item);
+
+  try {
+    QByteArray content;
+    QBuffer    buffer(&content);
+    buffer.open(QIODevice::WriteOnly);
+    if (!image.save(&buffer, "PNG")) {
+      return false;
+    }
+    FilePath fp = getFilePath(uuid, version);
+    FileUtils::writeFile(fp, content);  // can throw
+
+    // Drop an outdated thumbnail from memory, e.g. if a local library element
+    // was modified without incrementing its version.
+    QMutexLocker lock(&mMutex);
+    mCache.remove(fp.getFilename());
+    return true;
+  } catch (const Exception& e) {
+    qWarning() << "Failed to store library element thumbnail:" << e.getMsg();
+    return false;
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
@@ -0,0 +1,161 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef LIBREPCB_WORKSPACE_WORKSPACELIBRARYTHUMBNAILCACHE_H
+#define LIBREPCB_WORKSPACE_WORKSPACELIBRARYTHUMBNAILCACHE_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/uuid.h>
+#include <librepcb/common/version.h>
+
+#include <QtCore>
+#include <QtGui>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+class QGraphicsItem;
+
+namespace librepcb {
+
+namespace library {
+class Symbol;
+class Package;
+}  // namespace library
+
+namespace workspace {
+
+/*******************************************************************************
+ *  Class WorkspaceLibraryThumbnailCache
+ ******************************************************************************/
+
+/**
+ * @brief Disk-backed cache of preview thumbnails of library elements
+ *
+ * Thumbnails of symbols and packages are rendered by the
+ * librepcb::workspace::WorkspaceLibraryScanner in the background whenever it
+ * parses a new or modified element, and stored as PNG files named by the
+ * UUID and version of the element. Thus browsing libraries only needs to load
+ * small images instead of parsing and rendering every element. Recently used
+ * thumbnails are additionally kept in memory.
+ *
+ * @note All methods are thread-safe.
+ */
+class WorkspaceLibraryThumbnailCache final {
+  Q_DECLARE_TR_FUNCTIONS(WorkspaceLibraryThumbnailCache)
+
+public:
+  // Constructors / Destructor
+  WorkspaceLibraryThumbnailCache() = delete;
+  WorkspaceLibraryThumbnailCache(const WorkspaceLibraryThumbnailCache& other) =
+      delete;
+  explicit WorkspaceLibraryThumbnailCache(const FilePath& dir) noexcept;
+  ~WorkspaceLibraryThumbnailCache() noexcept;
+
+  // Getters
+  const FilePath& getDirectory() const noexcept { return mDirectory; }
+  FilePath        getFilePath(const Uuid&    uuid,
+                              const Version& version) const noexcept;
+  bool hasThumbnail(const Uuid& uuid, const Version& version) const noexcept;
+
+  /**
+   * @brief Get the thumbnail of a library element
+   *
+   * @param uuid      UUID of the element
+   * @param version   Version of the element
+   *
+   * @return The thumbnail or a null image if there is none (yet)
+   */
+  QImage getThumbnail(const Uuid& uuid, const Version& version) const noexcept;
+
+  /**
+   * @brief Get a HTML image tag of a thumbnail, e.g. for tooltips
+   *
+   * @param uuid      UUID of the element
+   * @param version   Version of the element
+   *
+   * @return The image tag or an empty string if there is no thumbnail (yet)
+   */
+  QString getThumbnailHtml(const Uuid& uuid, const Version& version) const
+      noexcept;
+
+  /**
+   * @brief Check whether thumbnails can be rendered in the calling thread
+   *
+   * Rendering texts outside the GUI thread is not supported on every
+   * platform, in that case no thumbnails are generated by worker threads.
+   */
+  static bool canGenerateInCurrentThread() noexcept;
+
+  // General Methods
+
+  /**
+   * @brief Render and store (or replace) the thumbnail of a symbol
+   *
+   * @param symbol    The symbol to render
+   *
+   * @retval true     If the thumbnail was stored
+   * @retval false    If the thumbnail could not be generated
+   */
+  bool generate(const library::Symbol& symbol) noexcept;
+
+  /**
+   * @brief Render and store (or replace) the thumbnail of a package
+   *
+   * The first footprint of the package is rendered. For packages without
+   * footprints, an empty thumbnail is stored to avoid rendering them again.
+   *
+   * @param package   The package to render
+   *
+   * @retval true     If the thumbnail was stored
+   * @retval false    If the thumbnail could not be generated
+   */
+  bool generate(const library::Package& package) noexcept;
+
+  // Operator Overloadings
+  WorkspaceLibraryThumbnailCache& operator=(
+      const WorkspaceLibraryThumbnailCache& rhs) = delete;
+
+private:  // Methods
+  bool generate(const Uuid& uuid, const Version& version, QGraphicsItem* item,
+                const QColor& background) noexcept;
+
+private:  // Data
+  FilePath                        mDirectory;
+  mutable QMutex                  mMutex;
+  mutable QCache<QString, QImage> mCache;  ///< key: file name, cost: KiB
+
+  /// Width and height of the thumbnails (in pixels)
+  static const int sThumbnailSize = 128;
+
+  /// Maximum total size of the thumbnails kept in memory (in KiB)
+  static const int sMaxCacheSizeKb = 16 * 1024;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace workspace
+}  // namespace librepcb
+
+#endif  // LIBREPCB_WORKSPACE_WORKSPACELIBRARYTHUMBNAILCACHE_H
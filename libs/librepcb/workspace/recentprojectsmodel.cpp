@@ -27,6 +27,7 @@
 
 #include <librepcb/common/fileio/fileutils.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 #include <QtWidgets>
 
@@ -42,12 +43,15 @@ namespace workspace {
 
 RecentProjectsModel::RecentProjectsModel(const Workspace& workspace) noexcept
   : QAbstractListModel(nullptr), mWorkspace(workspace) {
+  connect(&mVisibleProjectsWatcher,
+          &QFutureWatcher<QList<FilePath>>::finished, this,
+          &RecentProjectsModel::visibleProjectsChecked);
   try {
     mFilePath = mWorkspace.getMetadataPath().getPathTo("recent_projects.lp");
     if (mFilePath.isExistingFile()) {
       SExpression root =
           SExpression::parse(FileUtils::readFile(mFilePath), mFilePath);
-      const QList<SExpression>& childs = root.getChildren("project");
+      const QVector<SExpression>& childs = root.getChildren("project");
       foreach (const SExpression& child, childs) {
         QString  path    = child.getValueOfFirstChild<QString>(true);
         FilePath absPath = FilePath::fromRelative(mWorkspace.getPath(), path);
@@ -82,22 +86,34 @@ void RecentProjectsModel::setLastRecentProject(
 }
 
 void RecentProjectsModel::updateVisibleProjects() noexcept {
-  beginResetModel();
-  mVisibleProjects.clear();
-  foreach (const FilePath& fp, mAllProjects) {
-    if ((!mVisibleProjects.contains(fp)) && (mVisibleProjects.count() < 5) &&
-        fp.isExistingFile()) {
-      // show maximum 5 existing projects
-      mVisibleProjects.append(fp);
+  // Checking the existence of the projects might be slow (e.g. on network
+  // drives), so it's done in a worker thread to not block the control panel.
+  // If called again before the check has finished, the outdated result is
+  // discarded by the watcher.
+  QList<FilePath> allProjects = mAllProjects;
+  mVisibleProjectsWatcher.setFuture(QtConcurrent::run([allProjects]() {
+    QList<FilePath> visibleProjects;
+    foreach (const FilePath& fp, allProjects) {
+      if ((!visibleProjects.contains(fp)) && (visibleProjects.count() < 5) &&
+          fp.isExistingFile()) {
+        // show maximum 5 existing projects
+        visibleProjects.append(fp);
+      }
     }
-  }
-  endResetModel();
+    return visibleProjects;
+  }));
 }
 
 /*******************************************************************************
  *  Private Methods
  ******************************************************************************/
 
+void RecentProjectsModel::visibleProjectsChecked() noexcept {
+  beginResetModel();
+  mVisibleProjects = mVisibleProjectsWatcher.result();
+  endResetModel();
+}
+
 void RecentProjectsModel::save() noexcept {
   try {
     // save the new list in the workspace
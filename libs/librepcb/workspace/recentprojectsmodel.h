@@ -60,6 +60,7 @@ public:
   RecentProjectsModel& operator=(const RecentProjectsModel& rhs) = delete;
 
 private:
+  void     visibleProjectsChecked() noexcept;
   void     save() noexcept;
   int      rowCount(const QModelIndex& parent = QModelIndex()) const;
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const;
@@ -69,6 +70,10 @@ private:
   FilePath         mFilePath;
   QList<FilePath>  mAllProjects;
   QList<FilePath>  mVisibleProjects;
+
+  /// Checks in a worker thread which projects exist (see
+  /// #updateVisibleProjects())
+  QFutureWatcher<QList<FilePath>> mVisibleProjectsWatcher;
 };
 
 /*******************************************************************************
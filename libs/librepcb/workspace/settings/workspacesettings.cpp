@@ -37,7 +37,8 @@ namespace workspace {
  *  Constructors / Destructor
  ******************************************************************************/
 
-WorkspaceSettings::WorkspaceSettings(const FilePath& fp, QObject* parent)
+WorkspaceSettings::WorkspaceSettings(const FilePath&    fp,
+                                     const SExpression* root, QObject* parent)
   : QObject(parent),
     mFilePath(fp),
     // Initialize settings items. Their constructor will register them as
@@ -46,6 +47,7 @@ WorkspaceSettings::WorkspaceSettings(const FilePath& fp, QObject* parent)
     applicationLocale("application_locale", "", this),
     defaultLengthUnit("default_length_unit", LengthUnit::millimeters(), this),
     projectAutosaveIntervalSeconds("project_autosave_interval", 600U, this),
+    projectUndoLimit("project_undo_limit", 1000U, this),
     useOpenGl("use_opengl", false, this),
     libraryLocaleOrder("library_locale_order", "locale", QStringList(), this),
     libraryNormOrder("library_norm_order", "norm", QStringList(), this),
@@ -55,13 +57,11 @@ WorkspaceSettings::WorkspaceSettings(const FilePath& fp, QObject* parent)
     pdfReaderCommand("pdf_custom_reader_command", "", this),
     pdfOpenBehavior("pdf_open_behavior", PdfOpenBehavior::ALWAYS, this) {
   // load settings if the settings file exists
-  if (mFilePath.isExistingFile()) {
+  if (root) {
     qDebug("Load workspace settings...");
-    SExpression root =
-        SExpression::parse(FileUtils::readFile(mFilePath), mFilePath);
     foreach (WorkspaceSettingsItem* item, getAllItems()) {
       try {
-        item->load(root);  // can throw
+        item->load(*root);  // can throw
       } catch (const Exception& e) {
         qCritical() << "Could not load workspace settings item:" << e.getMsg();
       }
@@ -75,6 +75,19 @@ WorkspaceSettings::WorkspaceSettings(const FilePath& fp, QObject* parent)
 WorkspaceSettings::~WorkspaceSettings() noexcept {
 }
 
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+std::shared_ptr<SExpression> WorkspaceSettings::readFile(const FilePath& fp) {
+  if (fp.isExistingFile()) {
+    return std::make_shared<SExpression>(
+        SExpression::parse(FileUtils::readFile(fp), fp));  // can throw
+  } else {
+    return nullptr;
+  }
+}
+
 /*******************************************************************************
  *  Public Methods
  ******************************************************************************/
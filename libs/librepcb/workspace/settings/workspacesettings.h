@@ -32,6 +32,8 @@
 
 #include <QtCore>
 
+#include <memory>
+
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
@@ -73,9 +75,24 @@ public:
   // Constructors / Destructor
   WorkspaceSettings()                               = delete;
   WorkspaceSettings(const WorkspaceSettings& other) = delete;
-  explicit WorkspaceSettings(const FilePath& fp, QObject* parent = nullptr);
+  WorkspaceSettings(const FilePath& fp, const SExpression* root,
+                    QObject* parent = nullptr);
   ~WorkspaceSettings() noexcept;
 
+  /**
+   * @brief Read and parse a settings file
+   *
+   * This method is thread-safe, so the file can be parsed in a worker thread
+   * before creating the ::librepcb::workspace::WorkspaceSettings object.
+   *
+   * @param fp    Path to the "settings.lp" file
+   *
+   * @return The parsed file, or nullptr if the file does not exist
+   *
+   * @throw Exception if the file could not be read or parsed
+   */
+  static std::shared_ptr<SExpression> readFile(const FilePath& fp);
+
   /**
    * @brief Reset all settings to their default value
    */
@@ -144,6 +161,13 @@ public:
    */
   WorkspaceSettingsItem_GenericValue<uint> projectAutosaveIntervalSeconds;
 
+  /**
+   * @brief Maximum number of undo steps kept per project (0 = unlimited)
+   *
+   * Default: 1000
+   */
+  WorkspaceSettingsItem_GenericValue<uint> projectUndoLimit;
+
   /**
    * @brief Use OpenGL hardware acceleration
    *
@@ -264,6 +264,9 @@ void WorkspaceSettingsDialog::loadSettings() noexcept {
   mUi->spbAutosaveInterval->setValue(
       mSettings.projectAutosaveIntervalSeconds.get());
 
+  // Undo Limit
+  mUi->spbUndoLimit->setValue(mSettings.projectUndoLimit.get());
+
   // Use OpenGL
   mUi->cbxUseOpenGl->setChecked(mSettings.useOpenGl.get());
 
@@ -309,6 +312,9 @@ void WorkspaceSettingsDialog::saveSettings() noexcept {
     mSettings.projectAutosaveIntervalSeconds.set(
         mUi->spbAutosaveInterval->value());
 
+    // Undo Limit
+    mSettings.projectUndoLimit.set(mUi->spbUndoLimit->value());
+
     // Use OpenGL
     mSettings.useOpenGl.set(mUi->cbxUseOpenGl->isChecked());
 
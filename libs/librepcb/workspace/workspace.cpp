@@ -24,6 +24,8 @@
 
 #include "favoriteprojectsmodel.h"
 #include "library/workspacelibrarydb.h"
+#include "library/workspacelibraryelementcache.h"
+#include "library/workspacelibrarythumbnailcache.h"
 #include "projecttreemodel.h"
 #include "recentprojectsmodel.h"
 #include "settings/workspacesettings.h"
@@ -32,11 +34,14 @@
 #include <librepcb/common/exceptions.h>
 #include <librepcb/common/fileio/filepath.h>
 #include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
 #include <librepcb/common/fileio/versionfile.h>
+#include <librepcb/common/scopeguard.h>
 #include <librepcb/library/library.h>
 #include <librepcb/libraryeditor/libraryeditor.h>
 #include <librepcb/project/project.h>
 
+#include <QtConcurrent/QtConcurrent>
 #include <QtCore>
 
 #include <algorithm>
@@ -112,12 +117,33 @@ Workspace::Workspace(const FilePath& wsPath)
 
   // all OK, let's load the workspace stuff!
 
-  // load workspace settings
-  mWorkspaceSettings.reset(
-      new WorkspaceSettings(mMetadataPath.getPathTo("settings.lp"), this));
+  // Parse the workspace settings in a worker thread while the library
+  // database is opened. The database is opened in this thread since a SQLite
+  // connection can only be used in the thread which created it.
+  const FilePath settingsFp = mMetadataPath.getPathTo("settings.lp");
+  QFuture<std::shared_ptr<SExpression>> settingsFuture =
+      QtConcurrent::run(&WorkspaceSettings::readFile, settingsFp);
+  auto sg = scopeGuard([&settingsFuture]() {
+    // Don't leave this scope with a running job in case of an exception
+    try {
+      settingsFuture.waitForFinished();
+    } catch (...) {
+    }
+  });
 
   // load library database
+  QElapsedTimer timer;
+  timer.start();
+  mLibraryThumbnailCache.reset(new WorkspaceLibraryThumbnailCache(
+      mMetadataPath.getPathTo("thumbnails")));
   mLibraryDb.reset(new WorkspaceLibraryDb(*this));  // can throw
+  mLibraryElementCache.reset(new WorkspaceLibraryElementCache());
+  qDebug() << "Opened workspace library database in" << timer.elapsed()
+           << "ms.";
+
+  // load workspace settings
+  mWorkspaceSettings.reset(new WorkspaceSettings(
+      settingsFp, settingsFuture.result().get(), this));  // can throw
 
   // load project models
   mRecentProjectsModel.reset(new RecentProjectsModel(*this));
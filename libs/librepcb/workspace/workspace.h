@@ -48,6 +48,8 @@ class RecentProjectsModel;
 class FavoriteProjectsModel;
 class WorkspaceSettings;
 class WorkspaceLibraryDb;
+class WorkspaceLibraryElementCache;
+class WorkspaceLibraryThumbnailCache;
 
 /*******************************************************************************
  *  Class Workspace
@@ -134,6 +136,20 @@ public:
    */
   WorkspaceLibraryDb& getLibraryDb() const { return *mLibraryDb; }
 
+  /**
+   * @brief Get the cache of parsed library elements shared by all editors
+   */
+  WorkspaceLibraryElementCache& getLibraryElementCache() const {
+    return *mLibraryElementCache;
+  }
+
+  /**
+   * @brief Get the cache of library element thumbnails
+   */
+  WorkspaceLibraryThumbnailCache& getLibraryThumbnailCache() const {
+    return *mLibraryThumbnailCache;
+  }
+
   // Project Management
 
   /**
@@ -250,9 +266,16 @@ private:  // Data
   /// the WorkspaceSettings object
   QScopedPointer<WorkspaceSettings> mWorkspaceSettings;
 
+  /// the library thumbnails (must outlive the library database since they are
+  /// generated by its scanner thread)
+  QScopedPointer<WorkspaceLibraryThumbnailCache> mLibraryThumbnailCache;
+
   /// the library database
   QScopedPointer<WorkspaceLibraryDb> mLibraryDb;
 
+  /// the cache of parsed library elements
+  QScopedPointer<WorkspaceLibraryElementCache> mLibraryElementCache;
+
   /// a tree model for the whole projects directory
   QScopedPointer<ProjectTreeModel> mProjectTreeModel;
 
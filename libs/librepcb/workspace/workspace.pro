@@ -31,7 +31,9 @@ SOURCES += \
     library/cat/categorytreeitem.cpp \
     library/cat/categorytreemodel.cpp \
     library/workspacelibrarydb.cpp \
+    library/workspacelibraryelementcache.cpp \
     library/workspacelibraryscanner.cpp \
+    library/workspacelibrarythumbnailcache.cpp \
     projecttreemodel.cpp \
     recentprojectsmodel.cpp \
     settings/workspacesettings.cpp \
@@ -45,7 +47,9 @@ HEADERS += \
     library/cat/categorytreeitem.h \
     library/cat/categorytreemodel.h \
     library/workspacelibrarydb.h \
+    library/workspacelibraryelementcache.h \
     library/workspacelibraryscanner.h \
+    library/workspacelibrarythumbnailcache.h \
     projecttreemodel.h \
     recentprojectsmodel.h \
     settings/workspacesettings.h \
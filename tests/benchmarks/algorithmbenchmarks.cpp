@@ -0,0 +1,230 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "algorithmbenchmarks.h"
+
+#include "benchmarkrunner.h"
+
+#include <librepcb/common/algorithm/airwiresbuilder.h>
+#include <librepcb/common/alignment.h>
+#include <librepcb/common/application.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/font/strokefont.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/transform.h>
+#include <librepcb/common/uuid.h>
+
+#include <QtCore>
+
+#include <random>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+AlgorithmBenchmarks::AlgorithmBenchmarks(BenchmarkRunner& runner) noexcept
+  : mRunner(runner), mTextCounter(0) {
+}
+
+AlgorithmBenchmarks::~AlgorithmBenchmarks() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void AlgorithmBenchmarks::run(int size) {
+  runClipperBenchmarks(size);     // can throw
+  runPathBenchmarks(size);        // can throw
+  runAirWiresBenchmarks(size);    // can throw
+  runStrokeFontBenchmarks(size);  // can throw
+  runParserBenchmarks(size);      // can throw
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void AlgorithmBenchmarks::runClipperBenchmarks(int size) {
+  const PositiveLength    tolerance(5000);
+  const QVector<Path>     paths = generatePaths(size);
+  const ClipperLib::Paths converted =
+      ClipperHelpers::convert(paths, tolerance);
+  std::unique_ptr<ClipperLib::PolyTree> tree =
+      ClipperHelpers::uniteToTree(converted);  // can throw
+
+  mRunner.run("clipper_convert", size, 0, size,
+              [&]() { ClipperHelpers::convert(paths, tolerance); });
+  mRunner.run("clipper_offset", size, 0, size, [&]() {
+    ClipperLib::Paths copy = converted;
+    ClipperHelpers::offset(copy, Length(100000), tolerance);  // can throw
+  });
+  mRunner.run("clipper_unite", size, 0, size, [&]() {
+    ClipperLib::Paths copy = converted;
+    ClipperHelpers::unite(copy);  // can throw
+  });
+  mRunner.run("clipper_flatten_tree", size, 0, size, [&]() {
+    ClipperHelpers::flattenTree(*tree);  // can throw
+  });
+}
+
+void AlgorithmBenchmarks::runPathBenchmarks(int size) {
+  const QVector<Path> paths = generatePaths(size);
+  mRunner.run("path_rotate", size, 0, size, [&]() {
+    foreach (const Path& path, paths) {
+      path.rotated(Angle::deg45(), Point(1000000, 1000000));
+    }
+  });
+  mRunner.run("path_mirror", size, 0, size, [&]() {
+    foreach (const Path& path, paths) {
+      path.mirrored(Qt::Horizontal, Point(1000000, 1000000));
+    }
+  });
+  mRunner.run("path_translate", size, 0, size, [&]() {
+    foreach (const Path& path, paths) {
+      path.translated(Point(1000000, 1000000));
+    }
+  });
+  mRunner.run("path_transform", size, 0, size, [&]() {
+    const Transform transform(Point(1000000, 1000000), Angle::deg45(), true);
+    transform.map(paths);
+  });
+  mRunner.run("path_to_qpainterpath", size, 0, size, [&]() {
+    foreach (const Path& path, paths) {
+      // a new path object, so the cached painter path is not used
+      Path(path.getVertices()).toQPainterPathPx();
+    }
+  });
+}
+
+void AlgorithmBenchmarks::runAirWiresBenchmarks(int size) {
+  const QVector<Point> points = generatePoints(size);
+  mRunner.run("airwires_build", size, 0, size, [&]() {
+    AirWiresBuilder builder;
+    foreach (const Point& point, points) {
+      builder.addPoint(point);
+    }
+    builder.buildAirWires();
+  });
+}
+
+void AlgorithmBenchmarks::runStrokeFontBenchmarks(int size) {
+  const StrokeFont& font = qApp->getDefaultStrokeFont();
+  Point             bottomLeft, topRight;
+  mRunner.run("strokefont_stroke", size, 0, size, [&]() {
+    for (int i = 0; i < size; ++i) {
+      font.stroke(QString("R%1 100nF").arg(++mTextCounter),
+                  PositiveLength(1000000), Length(100000), Length(100000),
+                  Alignment(HAlign::center(), VAlign::center()), bottomLeft,
+                  topRight);
+    }
+  });
+}
+
+void AlgorithmBenchmarks::runParserBenchmarks(int size) {
+  const QVector<Point> points = generatePoints(size);
+  QStringList          lengths;
+  QVector<SExpression> nodes;
+  qint64               lengthsBytes = 0;
+  foreach (const Point& point, points) {
+    lengths.append(point.getX().toMmString());
+    lengthsBytes += lengths.last().length();
+    SExpression node = SExpression::createList("position");
+    node.appendChild(point.getX());
+    node.appendChild(point.getY());
+    nodes.append(node);
+  }
+  mRunner.run("length_parse", size, lengthsBytes, size, [&]() {
+    foreach (const QString& str, lengths) {
+      Length::fromMm(str);  // can throw
+    }
+  });
+  mRunner.run("point_parse", size, 0, size, [&]() {
+    foreach (const SExpression& node, nodes) {
+      Point p(node);  // can throw
+    }
+  });
+
+  QVector<Uuid> uuids;
+  for (int i = 0; i < size; ++i) {
+    uuids.append(Uuid::createRandom());
+  }
+  volatile uint hash = 0;  // keep the compiler from removing the loop
+  mRunner.run("uuid_hash", size, 0, size, [&]() {
+    foreach (const Uuid& uuid, uuids) {
+      hash = hash + qHash(uuid, 0);
+    }
+  });
+}
+
+QVector<Path> AlgorithmBenchmarks::generatePaths(int count) noexcept {
+  // Overlapping pads and traces, similar to the copper of a board
+  std::mt19937                          rng(42);
+  std::uniform_int_distribution<int>    type(0, 2);
+  std::uniform_int_distribution<qint64> size(200000, 2000000);
+  const QVector<Point>                  points = generatePoints(count);
+  QVector<Path>                         paths;
+  for (int i = 0; i < count; ++i) {
+    const Point&   pos = points.at(i);
+    PositiveLength width(size(rng));
+    PositiveLength height(size(rng));
+    switch (type(rng)) {
+      case 0:
+        paths.append(Path::obround(width, height).translated(pos));
+        break;
+      case 1:
+        paths.append(Path::circle(width).translated(pos));
+        break;
+      default:
+        paths.append(Path::obround(pos, points.at((i + 1) % count), width));
+        break;
+    }
+  }
+  return paths;
+}
+
+QVector<Point> AlgorithmBenchmarks::generatePoints(int count) noexcept {
+  // The board area grows with the count to keep the density constant
+  const qint64                          range = 1000000LL * qCeil(qSqrt(count));
+  std::mt19937                          rng(1337);
+  std::uniform_int_distribution<qint64> coordinate(0, range);
+  QVector<Point>                        points;
+  for (int i = 0; i < count; ++i) {
+    const Length x(coordinate(rng));  // not within the constructor call to
+    const Length y(coordinate(rng));  // get a well-defined evaluation order
+    points.append(Point(x, y));
+  }
+  return points;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,95 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ALGORITHMBENCHMARKS_H
+#define ALGORITHMBENCHMARKS_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <librepcb/common/geometry/path.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+class BenchmarkRunner;
+
+/*******************************************************************************
+ *  Class AlgorithmBenchmarks
+ ******************************************************************************/
+
+/**
+ * @brief Micro-benchmarks for the core geometry and algorithms
+ *
+ * For each size, the given number of (reproducible) pseudo-random items is
+ * generated and following operations are measured on them:
+ *  - `clipper_convert`: ClipperHelpers::convert() of paths with arcs
+ *  - `clipper_offset`: ClipperHelpers::offset() of the converted paths
+ *  - `clipper_unite`: ClipperHelpers::unite() of the converted paths
+ *  - `clipper_flatten_tree`: ClipperHelpers::flattenTree() of the united tree
+ *  - `path_rotate`, `path_mirror`, `path_translate`: Path transformations
+ *  - `path_to_qpainterpath`: Path::toQPainterPathPx() (without cache)
+ *  - `airwires_build`: AirWiresBuilder::buildAirWires() of random points
+ *  - `strokefont_stroke`: StrokeFont::stroke() of texts not yet cached
+ *  - `length_parse`: Length::fromMm() of numbers as strings
+ *  - `point_parse`: Point construction from S-Expression nodes
+ *  - `uuid_hash`: qHash() of UUIDs
+ */
+class AlgorithmBenchmarks final {
+public:
+  // Constructors / Destructor
+  AlgorithmBenchmarks()                                 = delete;
+  AlgorithmBenchmarks(const AlgorithmBenchmarks& other) = delete;
+  explicit AlgorithmBenchmarks(BenchmarkRunner& runner) noexcept;
+  ~AlgorithmBenchmarks() noexcept;
+
+  // General Methods
+  void run(int size);
+
+  // Operator Overloadings
+  AlgorithmBenchmarks& operator=(const AlgorithmBenchmarks& rhs) = delete;
+
+private:  // Methods
+  void                  runClipperBenchmarks(int size);
+  void                  runPathBenchmarks(int size);
+  void                  runAirWiresBenchmarks(int size);
+  void                  runStrokeFontBenchmarks(int size);
+  void                  runParserBenchmarks(int size);
+  static QVector<Path>  generatePaths(int count) noexcept;
+  static QVector<Point> generatePoints(int count) noexcept;
+
+private:  // Data
+  BenchmarkRunner& mRunner;
+  int              mTextCounter;  ///< to avoid stroke font cache hits
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
+
+#endif  // ALGORITHMBENCHMARKS_H
@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "benchmarkrunner.h"
+
+#include <QtCore>
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+BenchmarkRunner::BenchmarkRunner(int minTimeMs) noexcept
+  : mMinTimeMs(minTimeMs) {
+}
+
+BenchmarkRunner::~BenchmarkRunner() noexcept {
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void BenchmarkRunner::run(const QString& name, int size, qint64 bytes,
+                          qint64 items, const std::function<void()>& func) {
+  QElapsedTimer timer;
+  int           iterations = 0;
+  timer.start();
+  do {
+    func();  // can throw
+    ++iterations;
+  } while ((timer.elapsed() < mMinTimeMs) && (iterations < sMaxIterations));
+  qint64 ns = timer.nsecsElapsed();
+
+  Result result;
+  result.name       = name;
+  result.size       = size;
+  result.iterations = iterations;
+  result.nsPerIter  = ns / iterations;
+  result.bytes      = bytes;
+  result.items      = items;
+  result.peakMemory = getPeakMemoryUsage();
+  mResults.append(result);
+
+  QTextStream(stderr) << QString("%1 (size %2): %3 ms, %4 iterations\n")
+                             .arg(name)
+                             .arg(size)
+                             .arg(result.nsPerIter / 1e6, 0, 'f', 3)
+                             .arg(iterations);
+}
+
+QString BenchmarkRunner::toCsv() const noexcept {
+  QString csv =
+      "benchmark,size,iterations,time_ms,mb_per_s,items_per_s,peak_memory_mb\n";
+  foreach (const Result& r, mResults) {
+    qreal seconds = qMax(r.nsPerIter, qint64(1)) / 1e9;
+    csv += QString("%1,%2,%3,%4,%5,%6,%7\n")
+               .arg(r.name)
+               .arg(r.size)
+               .arg(r.iterations)
+               .arg(r.nsPerIter / 1e6, 0, 'f', 3)
+               .arg(r.bytes / seconds / 1e6, 0, 'f', 3)
+               .arg(r.items / seconds, 0, 'f', 0)
+               .arg((r.peakMemory >= 0) ? (r.peakMemory / 1e6) : -1, 0, 'f',
+                    1);
+  }
+  return csv;
+}
+
+/*******************************************************************************
+ *  Static Methods
+ ******************************************************************************/
+
+qint64 BenchmarkRunner::getPeakMemoryUsage() noexcept {
+#if defined(Q_OS_UNIX)
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(Q_OS_MAC)
+    return usage.ru_maxrss;  // bytes
+#else
+    return usage.ru_maxrss * qint64(1024);  // kilobytes
+#endif
+  }
+#endif
+  return -1;  // unknown
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
@@ -0,0 +1,95 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARKRUNNER_H
+#define BENCHMARKRUNNER_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <QtCore>
+
+#include <functional>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+/*******************************************************************************
+ *  Class BenchmarkRunner
+ ******************************************************************************/
+
+/**
+ * @brief Runs benchmarks and collects their results
+ *
+ * Each benchmark function is executed repeatedly until the minimum run time
+ * is reached. The results are printed as CSV to allow comparing them with the
+ * results of another build (see `tests/benchmarks/compare.py`).
+ */
+class BenchmarkRunner final {
+public:
+  // Types
+  struct Result {
+    QString name;        ///< Name of the benchmark
+    int     size;        ///< Size of the generated test data
+    int     iterations;  ///< Number of executed iterations
+    qint64  nsPerIter;   ///< Mean time per iteration [ns]
+    qint64  bytes;       ///< Processed bytes per iteration
+    qint64  items;       ///< Processed items per iteration
+    qint64  peakMemory;  ///< Peak memory usage of the process [bytes]
+  };
+
+  // Constructors / Destructor
+  BenchmarkRunner()                             = delete;
+  BenchmarkRunner(const BenchmarkRunner& other) = delete;
+  explicit BenchmarkRunner(int minTimeMs) noexcept;
+  ~BenchmarkRunner() noexcept;
+
+  // Getters
+  const QList<Result>& getResults() const noexcept { return mResults; }
+
+  // General Methods
+  void    run(const QString& name, int size, qint64 bytes, qint64 items,
+              const std::function<void()>& func);
+  QString toCsv() const noexcept;
+
+  // Operator Overloadings
+  BenchmarkRunner& operator=(const BenchmarkRunner& rhs) = delete;
+
+  // Static Methods
+  static qint64 getPeakMemoryUsage() noexcept;
+
+private:  // Data
+  int           mMinTimeMs;
+  QList<Result> mResults;
+
+  static constexpr int sMaxIterations = 1000;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
+
+#endif  // BENCHMARKRUNNER_H
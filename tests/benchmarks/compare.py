@@ -0,0 +1,35 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+
+"""
+Compare the CSV results of two runs of librepcb-benchmarks.
+"""
+
+import csv
+import sys
+
+
+def load(filename):
+    with open(filename, newline='') as f:
+        return {(row['benchmark'], int(row['size'])): row
+                for row in csv.DictReader(f)}
+
+
+def main(before_file, after_file):
+    before = load(before_file)
+    after = load(after_file)
+    print('{:<24} {:>8} {:>12} {:>12} {:>8}'.format(
+        'benchmark', 'size', 'before [ms]', 'after [ms]', 'change'))
+    for key in sorted(set(before) & set(after)):
+        t_before = float(before[key]['time_ms'])
+        t_after = float(after[key]['time_ms'])
+        change = (t_after - t_before) / t_before * 100 if t_before else 0
+        print('{:<24} {:>8} {:>12.3f} {:>12.3f} {:>+7.1f}%'.format(
+            key[0], key[1], t_before, t_after, change))
+
+
+if __name__ == '__main__':
+    if len(sys.argv) != 3:
+        print('Usage: {} BEFORE.csv AFTER.csv'.format(sys.argv[0]))
+        sys.exit(1)
+    main(sys.argv[1], sys.argv[2])
@@ -0,0 +1,176 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include "fileiobenchmarks.h"
+
+#include "benchmarkrunner.h"
+
+#include <librepcb/common/fileio/fileutils.h>
+#include <librepcb/common/fileio/sexpression.h>
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/uuid.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/project/project.h>
+#include <librepcb/project/schematics/schematic.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace benchmarks {
+
+using namespace project;
+
+/*******************************************************************************
+ *  Constructors / Destructor
+ ******************************************************************************/
+
+FileIoBenchmarks::FileIoBenchmarks(BenchmarkRunner& runner) noexcept
+  : mRunner(runner), mTempDir(FilePath::getRandomTempPath()) {
+}
+
+FileIoBenchmarks::~FileIoBenchmarks() noexcept {
+  QDir(mTempDir.toStr()).removeRecursively();
+}
+
+/*******************************************************************************
+ *  General Methods
+ ******************************************************************************/
+
+void FileIoBenchmarks::run(int size) {
+  mProjectDir = mTempDir.getPathTo(QString("project %1").arg(size));
+  generateProject(size);  // can throw
+  qint64 projectSize = getDirectorySize(mProjectDir);
+
+  // S-Expression parser and serializer
+  FilePath    boardFp = mProjectDir.getPathTo("boards/board/board.lp");
+  QByteArray  content = FileUtils::readFile(boardFp);          // can throw
+  SExpression root    = SExpression::parse(content, boardFp);  // can throw
+  int         nodes   = countNodes(root);
+  mRunner.run("sexpression_parse", size, content.size(), nodes, [&]() {
+    // count the nodes to also parse lazily parsed subtrees
+    countNodes(SExpression::parse(content, boardFp));  // can throw
+  });
+  mRunner.run("sexpression_serialize", size, content.size(), nodes,
+              [&]() { root.toByteArray(); });  // can throw
+
+  // length conversions (coordinates make up most of the files)
+  QVector<Length>  lengths;
+  QVector<QString> strings;
+  qint64           bytes = 0;
+  for (int i = 0; i < size * 100; ++i) {
+    lengths.append(Length(((i * 7919LL) % 100000000LL) - 50000000LL));
+    strings.append(lengths.last().toMmString());
+    bytes += strings.last().size();
+  }
+  mRunner.run("length_parse", size, bytes, strings.count(), [&]() {
+    foreach (const QString& str, strings) {
+      Length::fromMm(str);  // can throw
+    }
+  });
+  mRunner.run("length_serialize", size, bytes, lengths.count(), [&]() {
+    foreach (const Length& length, lengths) {
+      length.toMmString();
+    }
+  });
+
+  // project
+  mRunner.run("project_open", size, projectSize, size, [&]() {
+    Project project(createDir(false), "project.lpp");  // can throw
+  });
+  Project project(createDir(true), "project.lpp");  // can throw
+  std::shared_ptr<TransactionalFileSystem> fs =
+      project.getDirectory().getFileSystem();
+  mRunner.run("project_save", size, projectSize, size, [&]() {
+    project.save();  // can throw
+    fs->save();      // can throw
+  });
+  mRunner.run("project_autosave", size, projectSize, size, [&]() {
+    project.save();  // can throw
+    fs->autosave();  // can throw
+  });
+  FilePath zipFp = mTempDir.getPathTo(QString("project %1.lppz").arg(size));
+  mRunner.run("zip_export", size, projectSize, size,
+              [&]() { fs->exportToZip(zipFp); });  // can throw
+}
+
+/*******************************************************************************
+ *  Private Methods
+ ******************************************************************************/
+
+void FileIoBenchmarks::generateProject(int size) const {
+  QScopedPointer<Project> project(
+      Project::create(createDir(true), "project.lpp"));  // can throw
+  Schematic* schematic = project->createSchematic(ElementName("Schematic"));
+  project->addSchematic(*schematic);
+  Board* board = project->createBoard(ElementName("Board"));
+  project->addBoard(*board);
+  for (int i = 0; i < size; ++i) {
+    Point pos(Length((i % 100) * 2000000LL), Length((i / 100) * 2000000LL));
+    Path  path = Path::centeredRect(PositiveLength(1000000),
+                                    PositiveLength(500000));
+    BI_Polygon* polygon = new BI_Polygon(
+        *board, Uuid::createRandom(),
+        GraphicsLayerName(GraphicsLayer::sBoardDocumentation),
+        UnsignedLength(200000), false, false, path.translated(pos));
+    board->addPolygon(*polygon);  // can throw
+  }
+  project->save();                                  // can throw
+  project->getDirectory().getFileSystem()->save();  // can throw
+}
+
+std::unique_ptr<TransactionalDirectory> FileIoBenchmarks::createDir(
+    bool writable) const {
+  return std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+      TransactionalFileSystem::open(mProjectDir, writable)));  // can throw
+}
+
+qint64 FileIoBenchmarks::getDirectorySize(const FilePath& dir) const
+    noexcept {
+  qint64       size = 0;
+  QDirIterator it(dir.toStr(), QDir::Files | QDir::Hidden,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    it.next();
+    size += it.fileInfo().size();
+  }
+  return size;
+}
+
+int FileIoBenchmarks::countNodes(const SExpression& node) noexcept {
+  int count = 1;
+  foreach (const SExpression& child, node.getChildren()) {
+    count += countNodes(child);
+  }
+  return count;
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
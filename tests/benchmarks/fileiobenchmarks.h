@@ -0,0 +1,95 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FILEIOBENCHMARKS_H
+#define FILEIOBENCHMARKS_H
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <librepcb/common/fileio/filepath.h>
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace / Forward Declarations
+ ******************************************************************************/
+namespace librepcb {
+
+class SExpression;
+class TransactionalDirectory;
+
+namespace benchmarks {
+
+class BenchmarkRunner;
+
+/*******************************************************************************
+ *  Class FileIoBenchmarks
+ ******************************************************************************/
+
+/**
+ * @brief Benchmarks for parsing, serializing, loading and saving files
+ *
+ * For each size, a project containing a board with the given number of
+ * polygons is generated in a temporary directory. Then following operations
+ * are measured on it:
+ *  - `sexpression_parse`: SExpression::parse() of the board file
+ *  - `sexpression_serialize`: SExpression::toByteArray() of the board file
+ *  - `project_open`: Opening (and closing) the project
+ *  - `project_save`: Project::save() and TransactionalFileSystem::save()
+ *  - `project_autosave`: Project::save() and an autosave of the file system
+ *  - `zip_export`: TransactionalFileSystem::exportToZip()
+ */
+class FileIoBenchmarks final {
+public:
+  // Constructors / Destructor
+  FileIoBenchmarks()                              = delete;
+  FileIoBenchmarks(const FileIoBenchmarks& other) = delete;
+  explicit FileIoBenchmarks(BenchmarkRunner& runner) noexcept;
+  ~FileIoBenchmarks() noexcept;
+
+  // General Methods
+  void run(int size);
+
+  // Operator Overloadings
+  FileIoBenchmarks& operator=(const FileIoBenchmarks& rhs) = delete;
+
+private:  // Methods
+  void                                    generateProject(int size) const;
+  std::unique_ptr<TransactionalDirectory> createDir(bool writable) const;
+  qint64 getDirectorySize(const FilePath& dir) const noexcept;
+  static int countNodes(const SExpression& node) noexcept;
+
+private:  // Data
+  BenchmarkRunner& mRunner;
+  FilePath         mTempDir;
+  FilePath         mProjectDir;
+};
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace benchmarks
+}  // namespace librepcb
+
+#endif  // FILEIOBENCHMARKS_H
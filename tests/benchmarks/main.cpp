@@ -0,0 +1,100 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include "algorithmbenchmarks.h"
+#include "benchmarkrunner.h"
+#include "fileiobenchmarks.h"
+
+#include <librepcb/common/application.h>
+#include <librepcb/common/debug.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/fileutils.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+using namespace librepcb;
+using namespace librepcb::benchmarks;
+
+/*******************************************************************************
+ *  The Benchmark Program
+ ******************************************************************************/
+
+int main(int argc, char* argv[]) {
+  // many classes rely on a QApplication instance, so we create it here
+  Application app(argc, argv);
+  Application::setOrganizationName("LibrePCB");
+  Application::setOrganizationDomain("librepcb.org");
+  Application::setApplicationName("LibrePCB-Benchmarks");
+
+  // disable the whole debug output (we want only the benchmark results)
+  Debug::instance()->setDebugLevelLogFile(Debug::DebugLevel_t::Nothing);
+  Debug::instance()->setDebugLevelStderr(Debug::DebugLevel_t::Nothing);
+
+  QCommandLineParser parser;
+  parser.setApplicationDescription("LibrePCB benchmarks");
+  parser.addHelpOption();
+  QCommandLineOption suitesOption(
+      "suites", "Comma separated benchmark suites to run (fileio, algorithms).",
+      "suites", "fileio,algorithms");
+  QCommandLineOption sizesOption(
+      "sizes", "Comma separated sizes of the generated test data.", "sizes",
+      "100,1000,10000");
+  QCommandLineOption minTimeOption(
+      "min-time", "Minimum run time of each benchmark [ms].", "ms", "1000");
+  QCommandLineOption outputOption(
+      "output", "Write the results as CSV to this file instead of stdout.",
+      "file");
+  parser.addOption(suitesOption);
+  parser.addOption(sizesOption);
+  parser.addOption(minTimeOption);
+  parser.addOption(outputOption);
+  parser.process(app);
+
+  try {
+    const QStringList suites = parser.value(suitesOption).split(',');
+    BenchmarkRunner     runner(parser.value(minTimeOption).toInt());
+    FileIoBenchmarks    fileIo(runner);
+    AlgorithmBenchmarks algorithms(runner);
+    foreach (const QString& size, parser.value(sizesOption).split(',')) {
+      if (suites.contains("fileio")) {
+        fileIo.run(size.trimmed().toInt());  // can throw
+      }
+      if (suites.contains("algorithms")) {
+        algorithms.run(size.trimmed().toInt());  // can throw
+      }
+    }
+    if (parser.isSet(outputOption)) {
+      FilePath fp(QFileInfo(parser.value(outputOption)).absoluteFilePath());
+      FileUtils::writeFile(fp, runner.toCsv().toUtf8());  // can throw
+    } else {
+      QTextStream(stdout) << runner.toCsv();
+    }
+  } catch (const Exception& e) {
+    QTextStream(stderr) << "ERROR: " << e.getMsg() << "\n";
+    return 1;
+  }
+  return 0;
+}
@@ -47,11 +47,12 @@ class CliExecutor(object):
         else:
             shutil.copytree(src, dst)
 
-    def run(self, *args):
+    def run(self, *args, **kwargs):
         p = subprocess.Popen([self.executable] + list(args), cwd=self.tmpdir,
-                             stdout=subprocess.PIPE, stderr=subprocess.PIPE,
-                             universal_newlines=True, env=self._env())
-        stdout, stderr = p.communicate()
+                             stdin=subprocess.PIPE, stdout=subprocess.PIPE,
+                             stderr=subprocess.PIPE, universal_newlines=True,
+                             env=self._env())
+        stdout, stderr = p.communicate(kwargs.get('stdin', ''))
         # output to stdout/stderr because it helps debugging failed tests
         sys.stdout.write(stdout)
         sys.stderr.write(stderr)
@@ -0,0 +1,59 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import os
+
+"""
+Test command "generate-project"
+"""
+
+DATA_DIR = os.path.join(os.path.dirname(os.path.dirname(os.path.dirname(
+    os.path.abspath(__file__)))), 'data')
+LIBRARY = os.path.join(DATA_DIR, 'libraries', 'Populated Library.lplib')
+
+
+def test_help(cli):
+    code, stdout, stderr = cli.run('generate-project', '--help')
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 10
+
+
+def test_missing_library(cli):
+    code, stdout, stderr = cli.run('generate-project', 'Stress/Stress.lpp')
+    assert code == 1
+    assert stderr[0] == 'Wrong argument count.'
+
+
+def test_invalid_count(cli):
+    code, stdout, stderr = cli.run('generate-project', '--components=-1',
+                                   'Stress/Stress.lpp', LIBRARY)
+    assert code == 1
+    assert stderr[0] == "Invalid value for option '--components': -1"
+
+
+def test_generate_and_open(cli):
+    code, stdout, stderr = cli.run('generate-project', '--components=50',
+                                   '--nets=20', '--schematics=2',
+                                   '--boards=2', '--inner-layers=2',
+                                   '--traces', '--vias', '--planes=3',
+                                   'Stress/Stress.lpp', LIBRARY)
+    assert code == 0
+    assert stdout[-1] == 'SUCCESS'
+    assert os.path.isfile(cli.abspath('Stress/Stress.lpp'))
+
+    # the generated project must be valid
+    code, stdout, stderr = cli.run('open-project', '--erc', '--drc',
+                                   'Stress/Stress.lpp')
+    assert code in [0, 1]  # ERC/DRC messages are expected
+    assert "Open project 'Stress/Stress.lpp'..." in stdout
+    assert not any(line.startswith('ERROR') for line in stderr)
+
+
+def test_existing_project(cli):
+    args = ['generate-project', '--components=1', 'Stress/Stress.lpp', LIBRARY]
+    code, stdout, stderr = cli.run(*args)
+    assert code == 0
+    code, stdout, stderr = cli.run(*args)
+    assert code == 1
+    assert stderr[0].startswith('ERROR: The directory')
@@ -0,0 +1,39 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import os
+
+"""
+Test command "import-eagle"
+"""
+
+
+def test_help(cli):
+    code, stdout, stderr = cli.run('import-eagle', '--help')
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 10
+
+
+def test_missing_input(cli):
+    code, stdout, stderr = cli.run('import-eagle', 'Imported.lplib')
+    assert code == 1
+    assert stderr[0] == 'Wrong argument count.'
+
+
+def test_nonexistent_input(cli):
+    code, stdout, stderr = cli.run('import-eagle', 'Imported.lplib',
+                                   'nonexistent.lbr')
+    assert code == 1
+    assert stderr[0] == 'ERROR: File not found: nonexistent.lbr'
+    assert stdout[-1] == 'Finished with errors!'
+    assert os.path.isfile(cli.abspath('Imported.lplib/library.lp'))
+
+
+def test_empty_input_directory(cli):
+    os.makedirs(cli.abspath('eagle'))
+    code, stdout, stderr = cli.run('import-eagle', 'Imported.lplib', 'eagle')
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[0] == "Import 0 Eagle libraries into 'Imported.lplib'..."
+    assert stdout[-1] == 'SUCCESS'
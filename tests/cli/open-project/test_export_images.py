@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import os
+import params
+import pytest
+
+"""
+Test command "open-project --export-schematic-images --export-board-images"
+"""
+
+
+def is_png(path):
+    with open(path, 'rb') as f:
+        return f.read(4) == b'\x89PNG'
+
+
+def is_svg(path):
+    with open(path, 'r') as f:
+        return '<svg' in f.read()
+
+
+@pytest.mark.parametrize("option", [
+    '--export-schematic-images',
+    '--export-board-images',
+])
+def test_if_unknown_file_extension_fails(cli, option):
+    project = params.PROJECT_WITH_TWO_BOARDS_LPP
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run('open-project',
+                                   option + '=foo.bar',
+                                   project.path)
+    assert code == 1
+    assert len(stderr) == 1
+    assert 'Unknown extension' in stderr[0]
+    assert len(stdout) > 0
+    assert stdout[-1] == 'Finished with errors!'
+
+
+def test_if_invalid_resolution_fails(cli):
+    project = params.PROJECT_WITH_TWO_BOARDS_LPP
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-board-images=board.png',
+                                   '--image-dpi=0',
+                                   project.path)
+    assert code == 1
+    assert 'Invalid image resolution: 0' in stderr[0]
+
+
+@pytest.mark.parametrize("project", [
+    params.EMPTY_PROJECT_LPP_PARAM,
+    params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM,
+])
+@pytest.mark.parametrize("suffix", ['png', 'svg'])
+def test_export_schematic_images(cli, project, suffix):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    dir = cli.abspath(project.output_dir + '/images')
+    assert not os.path.exists(dir)
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-schematic-images=' +
+                                   dir + '/{{PAGE}}.' + suffix,
+                                   '--image-dpi=50',
+                                   project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    files = os.listdir(dir)
+    assert len(files) > 0
+    assert '1.' + suffix in files
+    for filename in files:
+        path = os.path.join(dir, filename)
+        assert is_png(path) if suffix == 'png' else is_svg(path)
+
+
+@pytest.mark.parametrize("project", [
+    params.PROJECT_WITH_TWO_BOARDS_LPP_PARAM,
+    params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM,
+])
+def test_export_board_images_of_all_layers(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    dir = cli.abspath(project.output_dir + '/images')
+    assert not os.path.exists(dir)
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-board-images=' +
+                                   dir + '/{{BOARD}}.png',
+                                   '--image-dpi=50',
+                                   project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    files = os.listdir(dir)
+    assert len(files) == 2
+    for filename in files:
+        assert is_png(os.path.join(dir, filename))
+
+
+@pytest.mark.parametrize("project", [
+    params.PROJECT_WITH_TWO_BOARDS_LPP_PARAM,
+    params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM,
+])
+def test_export_board_images_per_layer(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    dir = cli.abspath(project.output_dir + '/images')
+    assert not os.path.exists(dir)
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-board-images=' +
+                                   dir + '/{{BOARD}}_{{LAYER}}.svg',
+                                   '--image-dpi=50',
+                                   '--board=copy',
+                                   project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    files = os.listdir(dir)
+    assert 'copy_top_cu.svg' in files
+    assert 'copy_bot_cu.svg' in files
+    assert 'copy_brd_outlines.svg' in files
+    for filename in files:
+        assert filename.startswith('copy_')
+        assert is_svg(os.path.join(dir, filename))
@@ -288,3 +288,28 @@ def test_if_export_with_invalid_settings_fails(cli, project):
     assert len(stdout) > 0
     assert stdout[-1] == 'Finished with errors!'
     assert not os.path.exists(dir)
+
+
+@pytest.mark.parametrize("project", [
+    params.EMPTY_PROJECT_LPP_PARAM,
+    params.EMPTY_PROJECT_LPPZ_PARAM,
+])
+def test_if_unchanged_files_are_reused(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    dir = cli.abspath(project.output_dir + '/gerber')
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-pcb-fabrication-data',
+                                   project.path)
+    assert code == 0
+    assert not any('(unchanged)' in line for line in stdout)
+    mtimes = {f: os.path.getmtime(os.path.join(dir, f))
+              for f in os.listdir(dir)}
+    code, stdout, stderr = cli.run('open-project',
+                                   '--export-pcb-fabrication-data',
+                                   project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    assert len([line for line in stdout if '(unchanged)' in line]) == 8
+    for f, mtime in mtimes.items():
+        assert os.path.getmtime(os.path.join(dir, f)) == mtime
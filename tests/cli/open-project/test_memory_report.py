@@ -0,0 +1,27 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import params
+import pytest
+
+"""
+Test command "open-project --memory-report"
+"""
+
+
+@pytest.mark.parametrize("project", [
+    params.EMPTY_PROJECT_LPP_PARAM,
+    params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM,
+])
+def test_memory_report(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run('open-project', '--memory-report',
+                                   project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert 'Memory report:' in stdout
+    report = stdout[stdout.index('Memory report:') + 1:-1]
+    assert report[0].split() == ['Scope', 'Subsystem', 'Count', 'Size']
+    assert any('Library Symbols' in line for line in report)
+    assert any(line.startswith('Peak Process Memory') for line in report)
+    assert stdout[-1] == 'SUCCESS'
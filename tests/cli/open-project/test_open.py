@@ -53,3 +53,31 @@ def test_open_project_verbose(cli, project):
     assert len(stderr) > 0  # logging messages are on stderr
     assert len(stdout) > 0
     assert stdout[-1] == 'SUCCESS'
+
+
+def test_open_multiple_projects(cli):
+    cli.add_project(params.EMPTY_PROJECT_LPP.dir)
+    cli.add_project(params.PROJECT_WITH_TWO_BOARDS_LPP.dir)
+    code, stdout, stderr = cli.run('open-project', '--jobs=2',
+                                   params.EMPTY_PROJECT_LPP.path,
+                                   params.PROJECT_WITH_TWO_BOARDS_LPP.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert '==> ' + params.EMPTY_PROJECT_LPP.path in stdout
+    assert '==> ' + params.PROJECT_WITH_TWO_BOARDS_LPP.path in stdout
+    assert stdout[-2] == 'Processed 2 projects, 0 failed.'
+    assert stdout[-1] == 'SUCCESS'
+
+
+def test_open_multiple_projects_from_file(cli):
+    cli.add_project(params.EMPTY_PROJECT_LPP.dir)
+    with open(cli.abspath('projects.txt'), mode='w') as f:
+        f.write('# comment\n')
+        f.write(params.EMPTY_PROJECT_LPP.path + '\n')
+        f.write('nonexistent.lpp\n')
+    code, stdout, stderr = cli.run('open-project',
+                                   '--projects-file=projects.txt')
+    assert code == 1
+    assert stdout[-2] == 'Processed 2 projects, 1 failed.'
+    assert stdout[-1] == 'Finished with errors!'
+    assert stderr[-1] == '  - ' + cli.abspath('nonexistent.lpp')
@@ -0,0 +1,59 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import json
+import os
+import params
+import pytest
+import stressproject
+
+"""
+Performance regression tests of command "open-project" with large projects
+
+The limits are intentionally generous to avoid flaky tests on slow CI
+machines, they shall only catch severe regressions. On very slow machines
+(e.g. with sanitizers), they can be scaled with the environment variable
+LIBREPCB_PERFORMANCE_FACTOR (e.g. "4" for 4 times higher limits).
+"""
+
+FACTOR = float(os.environ.get('LIBREPCB_PERFORMANCE_FACTOR', '1'))
+
+# Maximum wall time per stage [ms] and maximum peak memory [bytes]
+MAX_TIME_MS = {
+    'open_project': 30000,
+    'erc': 10000,
+    'drc': 120000,
+    'export_pcb_fabrication_data': 60000,
+}
+MAX_MEMORY_BYTES = 2 * 1024 * 1024 * 1024
+
+STRESS_PROJECTS = [
+    pytest.param((2000, 3, 4), id='2000cmp-3brd-4planes'),
+    pytest.param((5000, 2, 2), id='5000cmp-2brd-2planes'),
+]
+
+
+@pytest.mark.performance
+@pytest.mark.parametrize("size", STRESS_PROJECTS)
+def test_large_project(cli, size):
+    project = params.PROJECT_WITH_TWO_BOARDS_LPP
+    cli.add_project(project.dir)
+    components, boards, planes = size
+    path = stressproject.generate(cli.abspath(project.dir),
+                                  os.path.basename(project.path),
+                                  components, boards, planes)
+    profile_path = cli.abspath('profile.json')
+    code, stdout, stderr = cli.run('open-project', '--erc', '--drc',
+                                   '--export-pcb-fabrication-data',
+                                   '--profile=' + profile_path, path)
+    assert code in [0, 1]  # ERC/DRC messages are expected
+    with open(profile_path, 'r') as f:
+        profile = json.load(f)
+    stages = [s['stage'] for s in profile['stages']]
+    assert stages.count('drc') == boards
+    assert stages.count('export_pcb_fabrication_data') == boards
+    for stage in profile['stages']:
+        limit = MAX_TIME_MS.get(stage['stage'])
+        if limit is not None:
+            assert stage['wall_time_ms'] <= limit * FACTOR, stage
+    assert profile['peak_rss_bytes'] <= MAX_MEMORY_BYTES * FACTOR
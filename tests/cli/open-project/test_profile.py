@@ -0,0 +1,54 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import json
+import params
+import pytest
+
+"""
+Test command "open-project --profile"
+"""
+
+
+@pytest.mark.parametrize("project", [
+    params.EMPTY_PROJECT_LPP_PARAM,
+    params.PROJECT_WITH_TWO_BOARDS_LPPZ_PARAM,
+])
+def test_profile(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    path = cli.abspath('profile.json')
+    code, stdout, stderr = cli.run('open-project', '--erc', '--drc',
+                                   '--export-pcb-fabrication-data',
+                                   '--profile=' + path, project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    with open(path, 'r') as f:
+        profile = json.load(f)
+    assert profile['wall_time_ms'] >= 0
+    assert profile['cpu_time_ms'] >= 0
+    assert profile['peak_rss_bytes'] > 0
+    stages = [s['stage'] for s in profile['stages']]
+    assert stages[0] == 'open_project'
+    assert stages[1] == 'erc'
+    assert stages.count('drc') == project.board_count
+    assert stages.count('export_pcb_fabrication_data') == project.board_count
+    for stage in profile['stages']:
+        assert stage['wall_time_ms'] >= 0
+        assert stage['cpu_time_ms'] >= 0
+        assert stage['peak_rss_bytes'] > 0
+        if stage['stage'] in ['drc', 'export_pcb_fabrication_data']:
+            assert len(stage['details']) > 0
+
+
+@pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
+def test_profile_only(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    path = cli.abspath('profile.json')
+    code, stdout, stderr = cli.run('open-project', '--profile=' + path,
+                                   project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    with open(path, 'r') as f:
+        profile = json.load(f)
+    assert [s['stage'] for s in profile['stages']] == ['open_project']
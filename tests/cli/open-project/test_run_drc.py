@@ -0,0 +1,51 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import json
+import params
+import pytest
+
+"""
+Test command "open-project --drc"
+"""
+
+
+@pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
+def test_project_without_messages(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    code, stdout, stderr = cli.run('open-project', '--drc', project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 0
+    assert any(['0 message(s)' in line for line in stdout])
+    assert stdout[-1] == 'SUCCESS'
+
+
+@pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
+def test_json_report(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    path = cli.abspath('drc.json')
+    code, stdout, stderr = cli.run('open-project', '--drc',
+                                   '--drc-report=' + path, project.path)
+    assert code == 0
+    assert len(stderr) == 0
+    assert stdout[-1] == 'SUCCESS'
+    with open(path, 'r') as f:
+        report = json.load(f)
+    assert len(report['board']) > 0
+    assert report['messages'] == []
+    assert len(report['stages']) > 0
+
+
+@pytest.mark.parametrize("project", [params.EMPTY_PROJECT_LPP_PARAM])
+def test_invalid_settings(cli, project):
+    cli.add_project(project.dir, as_lppz=project.is_lppz)
+    with open(cli.abspath('drc.lp'), 'w') as f:
+        f.write('(librepcb_drc_settings')
+    code, stdout, stderr = cli.run('open-project', '--drc',
+                                   '--drc-settings=' + cli.abspath('drc.lp'),
+                                   project.path)
+    assert code == 1
+    assert len(stderr) == 1
+    assert 'Failed to load DRC settings' in stderr[0]
+    assert stdout[-1] == 'Finished with errors!'
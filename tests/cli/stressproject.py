@@ -0,0 +1,209 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import os
+import re
+import shutil
+import uuid
+
+"""
+Generator for large projects used by the performance regression tests
+
+The generated project is derived from an existing test project: all its
+components (and their devices on the boards) are copied until the requested
+component count is reached, the first board is copied until the requested
+board count is reached, and planes are added to each board. The files are
+modified on text level, so the output is not canonical (which doesn't matter
+for the tests).
+"""
+
+UUID_PATTERN = '[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}'
+GRID_PITCH_MM = 5.0
+
+
+def generate(src_dir, project_file, components, boards, planes):
+    """
+    Scale up the project in the given directory (in place)
+
+    :param src_dir: Directory of the project to scale up
+    :param project_file: Name of the *.lpp file within the directory
+    :param components: Total number of components after scaling
+    :param boards: Total number of boards after scaling
+    :param planes: Number of planes to add to each board
+    :return: Path to the *.lpp file
+    """
+    board_files = _read_board_list(src_dir)
+    _add_boards(src_dir, board_files, boards)
+    cmp_map = _add_components(src_dir, components)
+    net = _get_first_net(src_dir)
+    side = _grid_size(components)
+    for board_file in _read_board_list(src_dir):
+        path = os.path.join(src_dir, board_file)
+        content = _read(path)
+        content = _add_devices(content, cmp_map)
+        content = _add_planes(content, net, planes, side)
+        _write(path, content)
+    return os.path.join(src_dir, project_file)
+
+
+def _add_boards(src_dir, board_files, count):
+    boards_dir = os.path.join(src_dir, 'boards')
+    template_dir = os.path.dirname(os.path.join(src_dir, board_files[0]))
+    template_file = os.path.basename(board_files[0])
+    for i in range(len(board_files), count):
+        name = 'stress_{}'.format(i + 1)
+        shutil.copytree(template_dir, os.path.join(boards_dir, name))
+        path = os.path.join(boards_dir, name, template_file)
+        content = _read(path)
+        content = re.sub('^(\\(librepcb_board )' + UUID_PATTERN,
+                         lambda m: m.group(1) + _new_uuid(), content, count=1)
+        content = re.sub('\\(name "[^"]*"\\)',
+                         '(name "Stress Board {}")'.format(i + 1), content,
+                         count=1)
+        _write(path, content)
+        board_files.append('boards/{}/{}'.format(name, template_file))
+    lines = ['(librepcb_boards']
+    lines += [' (board "{}")'.format(f) for f in board_files]
+    _write(os.path.join(boards_dir, 'boards.lp'), '\n'.join(lines) + '\n)\n')
+
+
+def _add_components(src_dir, count):
+    """
+    Copy components, returns a dict {template UUID: [UUIDs of the copies]}
+    """
+    path = os.path.join(src_dir, 'circuit', 'circuit.lp')
+    content = _read(path)
+    templates = _get_child_nodes(content, 'component')
+    if len(templates) == 0:
+        raise Exception('The template project does not contain components.')
+    cmp_map = dict()
+    copies = []
+    for i in range(count - len(templates)):
+        template = templates[i % len(templates)]
+        template_uuid = _get_uuid(template)
+        new_uuid = _new_uuid()
+        node = template.replace(template_uuid, new_uuid, 1)
+        node = re.sub('\\(name "([^"]*)"\\)',
+                      lambda m: '(name "{}S{}")'.format(m.group(1), i + 1),
+                      node, count=1)
+        cmp_map.setdefault(template_uuid, []).append(new_uuid)
+        copies.append(node)
+    _write(path, _insert_nodes(content, copies))
+    return cmp_map
+
+
+def _add_devices(content, cmp_map):
+    devices = [n for n in _get_child_nodes(content, 'device')
+               if _get_uuid(n) in cmp_map]
+    if len(devices) == 0:
+        return content  # board without devices, e.g. an empty one
+    side = _grid_size(sum(len(v) for v in cmp_map.values()))
+    copies = []
+    for template in devices:
+        for new_uuid in cmp_map[_get_uuid(template)]:
+            index = len(copies)
+            node = template.replace(_get_uuid(template), new_uuid, 1)
+            node = re.sub('\\(position [^)]*\\)', '(position {} {})'.format(
+                (index % side) * GRID_PITCH_MM,
+                (index // side) * GRID_PITCH_MM), node, count=1)
+            node = re.sub('(\\(stroke_text )' + UUID_PATTERN,
+                          lambda m: m.group(1) + _new_uuid(), node)
+            copies.append(node)
+    return _insert_nodes(content, copies)
+
+
+def _add_planes(content, net, count, side):
+    size = side * GRID_PITCH_MM
+    layers = ['top_cu', 'bot_cu']
+    planes = []
+    for i in range(count):
+        vertices = [(-5.0, -5.0), (size, -5.0), (size, size), (-5.0, size)]
+        planes.append(
+            '(plane {} (layer {})\n'
+            ' (net {}) (priority {})\n'
+            ' (min_width 0.2) (min_clearance 0.3) (keep_orphans false)\n'
+            ' (connect_style solid)\n'.format(_new_uuid(),
+                                              layers[i % len(layers)], net,
+                                              i // len(layers)) +
+            ''.join(' (vertex (position {} {}) (angle 0.0))\n'.format(x, y)
+                    for x, y in vertices + vertices[:1]) +
+            ')')
+    return _insert_nodes(content, planes)
+
+
+def _get_first_net(src_dir):
+    content = _read(os.path.join(src_dir, 'circuit', 'circuit.lp'))
+    nets = _get_child_nodes(content, 'netsignal')
+    if len(nets) == 0:
+        raise Exception('The template project does not contain nets.')
+    return _get_uuid(nets[0])
+
+
+def _read_board_list(src_dir):
+    content = _read(os.path.join(src_dir, 'boards', 'boards.lp'))
+    return re.findall('\\(board "([^"]*)"\\)', content)
+
+
+def _get_child_nodes(content, name):
+    """
+    Get the source of all direct child nodes of the root with the given name
+    """
+    nodes = []
+    depth = 0
+    start = None
+    in_string = False
+    i = 0
+    while i < len(content):
+        c = content[i]
+        if in_string:
+            if c == '\\':
+                i += 1
+            elif c == '"':
+                in_string = False
+        elif c == '"':
+            in_string = True
+        elif c == '(':
+            depth += 1
+            if depth == 2 and content.startswith(name + ' ', i + 1):
+                start = i
+        elif c == ')':
+            if depth == 2 and start is not None:
+                nodes.append(content[start:i + 1])
+                start = None
+            depth -= 1
+        i += 1
+    return nodes
+
+
+def _insert_nodes(content, nodes):
+    """
+    Insert nodes at the end of the root node
+    """
+    end = content.rstrip().rfind(')')
+    return content[:end] + ''.join(' ' + n + '\n' for n in nodes) + \
+        content[end:]
+
+
+def _get_uuid(node):
+    return re.search(UUID_PATTERN, node).group(0)
+
+
+def _grid_size(count):
+    side = 1
+    while side * side < count:
+        side += 1
+    return side
+
+
+def _new_uuid():
+    return str(uuid.uuid4())
+
+
+def _read(path):
+    with open(path, 'r') as f:
+        return f.read()
+
+
+def _write(path, content):
+    with open(path, 'w') as f:
+        f.write(content)
@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+
+import json
+import params
+
+"""
+Test command "serve"
+"""
+
+
+def serve(cli, *requests):
+    stdin = ''.join(json.dumps(r) + '\n' for r in requests)
+    code, stdout, stderr = cli.run('serve', stdin=stdin)
+    return code, [json.loads(line) for line in stdout], stderr
+
+
+def test_help(cli):
+    code, stdout, stderr = cli.run('serve', '--help')
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(stdout) > 5
+
+
+def test_no_requests(cli):
+    code, responses, stderr = serve(cli)
+    assert code == 0
+    assert len(stderr) == 0
+    assert len(responses) == 0
+
+
+def test_open_project_twice(cli):
+    project = params.EMPTY_PROJECT_LPP
+    cli.add_project(project.dir)
+    request = {'args': ['open-project', '--erc', project.path]}
+    code, responses, stderr = serve(cli, dict(request, id=1),
+                                    dict(request, id=2))
+    assert code == 0
+    assert len(stderr) == 0
+    assert [r['id'] for r in responses] == [1, 2]
+    for response in responses:
+        assert response['exit_code'] == 0
+        assert response['stderr'] == ''
+        assert response['stdout'].splitlines()[-1] == 'SUCCESS'
+
+
+def test_cwd(cli):
+    project = params.EMPTY_PROJECT_LPP
+    cli.add_project(project.dir)
+    request = {
+        'id': 'foo',
+        'cwd': cli.abspath(project.dir),
+        'args': ['open-project', project.path.split('/')[-1]],
+    }
+    code, responses, stderr = serve(cli, request)
+    assert code == 0
+    assert len(responses) == 1
+    assert responses[0]['id'] == 'foo'
+    assert responses[0]['exit_code'] == 0
+
+
+def test_failing_request(cli):
+    code, responses, stderr = serve(cli, {
+        'id': 1,
+        'args': ['open-project', 'nonexistent.lpp'],
+    }, {
+        'id': 2,
+        'args': ['serve'],
+    })
+    assert code == 0
+    assert len(stderr) == 0
+    assert [r['exit_code'] for r in responses] == [1, 1]
+    assert 'Already running in server mode' in responses[1]['stderr']
+
+
+def test_invalid_request(cli):
+    code, stdout, stderr = cli.run('serve', stdin='foo\n')
+    assert code == 0
+    assert len(stdout) == 1
+    response = json.loads(stdout[0])
+    assert response['id'] is None
+    assert response['exit_code'] == 1
@@ -26,6 +26,9 @@
 
 #include <QtCore>
 
+#include <iostream>
+#include <random>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -38,6 +41,35 @@ namespace tests {
 
 class AirWiresBuilderTest : public ::testing::Test {
 protected:
+  static QVector<Point> randomPoints(int count, int seed) noexcept {
+    std::mt19937                       rng(seed);
+    std::uniform_int_distribution<int> dist(0, 100000000);
+    QVector<Point>                     points;
+    for (int i = 0; i < count; ++i) {
+      points.append(Point(dist(rng), dist(rng)));
+    }
+    return points;
+  }
+
+  static AirWiresBuilder::AirWires build(
+      const QVector<Point>& points, AirWiresBuilder::Engine engine) noexcept {
+    AirWiresBuilder builder(engine);
+    foreach (const Point& point, points) { builder.addPoint(point); }
+    // connect some points to get groups which are already connected
+    for (int i = 1; i < points.count(); i += 3) {
+      builder.addEdge(i - 1, i);
+    }
+    return builder.buildAirWires();
+  }
+
+  static qreal totalLength(const AirWiresBuilder::AirWires& airwires) noexcept {
+    qreal length = 0;
+    foreach (const AirWiresBuilder::AirWire& airwire, airwires) {
+      length += (airwire.second - airwire.first).getLength()->toMm();
+    }
+    return length;
+  }
+
   static AirWiresBuilder::AirWires sorted(
       AirWiresBuilder::AirWires airwires) noexcept {
     for (AirWiresBuilder::AirWire& airwire : airwires) {
@@ -178,6 +210,100 @@ TEST_F(AirWiresBuilderTest, testPartlyConnectedColinearPoints) {
   EXPECT_EQ(expected, airwires);
 }
 
+TEST_F(AirWiresBuilderTest, testConnectedGroupsWithCycles) {
+  AirWiresBuilder builder;
+  int             id0 = builder.addPoint(Point(0, 0));
+  int             id1 = builder.addPoint(Point(100000, 0));
+  int             id2 = builder.addPoint(Point(100000, 100000));
+  int             id3 = builder.addPoint(Point(0, 100000));
+  int             id4 = builder.addPoint(Point(500000, 0));
+  int             id5 = builder.addPoint(Point(600000, 0));
+  builder.addPoint(Point(300000, 0));
+  builder.addEdge(id0, id1);
+  builder.addEdge(id1, id2);
+  builder.addEdge(id2, id3);
+  builder.addEdge(id3, id0);  // cycle
+  builder.addEdge(id4, id5);
+  builder.addEdge(id5, id4);  // duplicate
+  AirWiresBuilder::AirWires airwires = sorted(builder.buildAirWires());
+  AirWiresBuilder::AirWires expected = {
+      {Point(100000, 0), Point(300000, 0)},
+      {Point(300000, 0), Point(500000, 0)}};
+  EXPECT_EQ(expected, airwires);
+}
+
+TEST_F(AirWiresBuilderTest, testEnginesAreEquivalentForRandomPoints) {
+  for (int count : {4, 10, 100, 500}) {
+    QVector<Point> points = randomPoints(count, count);
+    AirWiresBuilder::AirWires delaunay =
+        build(points, AirWiresBuilder::Engine::Delaunay);
+    AirWiresBuilder::AirWires neighbors =
+        build(points, AirWiresBuilder::Engine::NearestNeighbors);
+    EXPECT_EQ(delaunay.count(), neighbors.count()) << count;
+    EXPECT_NEAR(totalLength(delaunay), totalLength(neighbors), 0.001)
+        << count;
+  }
+}
+
+TEST_F(AirWiresBuilderTest, testNearestNeighborsWithDistantGroups) {
+  AirWiresBuilder builder(AirWiresBuilder::Engine::NearestNeighbors);
+  for (int i = 0; i < 20; ++i) {
+    builder.addPoint(Point(i * 100000, 0));
+    builder.addPoint(Point(i * 100000, 50000000));
+  }
+  AirWiresBuilder::AirWires airwires = builder.buildAirWires();
+  EXPECT_EQ(39, airwires.count());
+  EXPECT_NEAR(2 * 19 * 0.1 + 50, totalLength(airwires), 0.001);
+}
+
+// The nearest neighbor engine is only approximate: Two dense groups of points
+// which are near to each other, but only connected through a distant point,
+// don't get the direct (shortest) air wire between them.
+TEST_F(AirWiresBuilderTest, testNearestNeighborsIsApproximate) {
+  QVector<Point> points;
+  for (int x = 0; x < 3; ++x) {
+    for (int y = 0; y < 3; ++y) {
+      points.append(Point(-x * 100000, y * 100000));
+      points.append(Point(10000000 + x * 100000, y * 100000));
+    }
+  }
+  points.append(Point(5000000, 20000000));
+  AirWiresBuilder delaunayBuilder(AirWiresBuilder::Engine::Delaunay);
+  AirWiresBuilder neighborsBuilder(AirWiresBuilder::Engine::NearestNeighbors);
+  foreach (const Point& point, points) {
+    delaunayBuilder.addPoint(point);
+    neighborsBuilder.addPoint(point);
+  }
+  AirWiresBuilder::AirWires delaunay  = delaunayBuilder.buildAirWires();
+  AirWiresBuilder::AirWires neighbors = neighborsBuilder.buildAirWires();
+  EXPECT_EQ(18, delaunay.count());
+  EXPECT_EQ(18, neighbors.count());
+  EXPECT_NEAR(1.6 + 10 + 20.4216, totalLength(delaunay), 0.001);
+  EXPECT_NEAR(1.6 + 2 * 20.4216, totalLength(neighbors), 0.001);
+}
+
+// Not a real test, but a benchmark of both engines. Run it with the command
+// line arguments "--gtest_filter=*benchmark* --gtest_also_run_disabled_tests".
+TEST_F(AirWiresBuilderTest, DISABLED_benchmarkEngines) {
+  for (int count : {100, 1000, 10000, 100000}) {
+    QVector<Point> points = randomPoints(count, count);
+    for (AirWiresBuilder::Engine engine :
+         {AirWiresBuilder::Engine::Delaunay,
+          AirWiresBuilder::Engine::NearestNeighbors}) {
+      if ((engine == AirWiresBuilder::Engine::Delaunay) && (count > 10000)) {
+        continue;  // would take way too long
+      }
+      QElapsedTimer timer;
+      timer.start();
+      AirWiresBuilder::AirWires airwires = build(points, engine);
+      std::cout << "Points: " << count << ", engine: "
+                << static_cast<int>(engine) << ", air wires: "
+                << airwires.count() << ", time: " << timer.elapsed() << "ms"
+                << std::endl;
+    }
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,93 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/algorithm/unionfind.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class UnionFindTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(UnionFindTest, testInitialState) {
+  UnionFind uf(3);
+  EXPECT_EQ(3, uf.getElementCount());
+  EXPECT_EQ(3, uf.getGroupCount());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(i, uf.find(i));
+  }
+  EXPECT_FALSE(uf.isConnected(0, 1));
+}
+
+TEST_F(UnionFindTest, testUnite) {
+  UnionFind uf(5);
+  EXPECT_TRUE(uf.unite(0, 1));
+  EXPECT_TRUE(uf.unite(3, 4));
+  EXPECT_FALSE(uf.unite(1, 0));
+  EXPECT_EQ(3, uf.getGroupCount());
+  EXPECT_TRUE(uf.isConnected(0, 1));
+  EXPECT_FALSE(uf.isConnected(1, 3));
+  EXPECT_TRUE(uf.unite(1, 4));
+  EXPECT_EQ(2, uf.getGroupCount());
+  EXPECT_TRUE(uf.isConnected(0, 3));
+  EXPECT_FALSE(uf.isConnected(2, 3));
+}
+
+TEST_F(UnionFindTest, testAddElement) {
+  UnionFind uf;
+  EXPECT_EQ(0, uf.getGroupCount());
+  EXPECT_EQ(0, uf.addElement());
+  EXPECT_EQ(1, uf.addElement());
+  EXPECT_EQ(2, uf.getGroupCount());
+  uf.unite(0, 1);
+  EXPECT_EQ(2, uf.addElement());
+  EXPECT_EQ(2, uf.getGroupCount());
+  EXPECT_FALSE(uf.isConnected(1, 2));
+}
+
+TEST_F(UnionFindTest, testLongChain) {
+  const int count = 100000;
+  UnionFind uf(count);
+  for (int i = 1; i < count; ++i) {
+    uf.unite(i - 1, i);
+  }
+  EXPECT_EQ(1, uf.getGroupCount());
+  EXPECT_TRUE(uf.isConnected(0, count - 1));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -63,6 +63,29 @@ TEST_P(AttributeSubstitutorTest, testData) {
       << "Actual value: '" << qPrintable(output) << "'";
 }
 
+TEST(AttributeSubstitutorTemplateTest, testKeys) {
+  AttributeSubstitutor::Template tpl("{{KEY_1}} {{FOO or 'bar'}} {{KEY_4}}");
+  EXPECT_EQ(QSet<QString>({"KEY_1", "FOO", "KEY_4"}), tpl.getKeys());
+  EXPECT_TRUE(tpl.dependsOnAttributes());
+}
+
+TEST(AttributeSubstitutorTemplateTest, testWithoutKeys) {
+  AttributeSubstitutor::Template tpl("foo {{'bar'}}");
+  EXPECT_EQ(QSet<QString>(), tpl.getKeys());
+  EXPECT_FALSE(tpl.dependsOnAttributes());
+  EXPECT_EQ("foo bar", AttributeSubstitutor::substitute(tpl, nullptr));
+}
+
+TEST(AttributeSubstitutorTemplateTest, testUsedKeys) {
+  AttributeProviderDummy         ap;
+  AttributeSubstitutor::Template tpl("{{FOO or KEY_4}} {{'bar' or KEY_2}}");
+  QSet<QString>                  usedKeys;
+  QString                        output =
+      AttributeSubstitutor::substitute(tpl, &ap, nullptr, &usedKeys);
+  EXPECT_EQ("Recursive Normal value value bar", output);
+  EXPECT_EQ(QSet<QString>({"FOO", "KEY_4", "KEY_1"}), usedKeys);
+}
+
 /*******************************************************************************
  *  Test Data
  ******************************************************************************/
@@ -76,7 +99,7 @@ INSTANTIATE_TEST_SUITE_P(AttributeSubstitutorTest, AttributeSubstitutorTest, ::t
     ASTD({"{{NONEXISTENT}}",                    ""}),
     ASTD({"{{KEY}}",                            ""}),
     ASTD({"{{KEY_1}}",                          "Normal value"}),
-    //ASTD({"{{KEY_1}} {{KEY_1}}",                "Normal value Normal value"}),
+    ASTD({"{{KEY_1}} {{KEY_1}}",                "Normal value Normal value"}),
     ASTD({"some {}}}{{ noise",                  "some {}}}{{ noise"}),
     ASTD({"{{KEY_2}}",                          "Value with {}}}{{ noise"}),
     ASTD({"{{KEY_3}}",                          "Recursive  value"}),
@@ -87,9 +110,9 @@ INSTANTIATE_TEST_SUITE_P(AttributeSubstitutorTest, AttributeSubstitutorTest, ::t
     ASTD({"Foo {KEY_7 }}{{KEY_7}} {{KEYY}}",    "Foo {KEY_7 }}Endless Endless  part 1 part 2 "}),
     ASTD({"{{KEY_3}} foo{ { KEY_5}} {{KEY}}",   "Recursive  value foo{ { KEY_5}} "}),
     ASTD({"{{KEY_1}} {{KEY_2 or KEY_3}} foo",   "Normal value Value with {}}}{{ noise foo"}),
-    //ASTD({"{{KEY_8 or KEY_1}}",                 "Normal value"}),
-    //ASTD({"{{KEY or KEY_4 or KEY_3}} {{KEY_1}}","Recursive Normal value value Normal value"}),
-    //ASTD({"{{KEY_1}} {{FOO or KEY or KEY_5}}!", "Normal value Recursive Recursive Normal value value value!"}),
+    ASTD({"{{KEY_8 or KEY_1}}",                 "Normal value"}),
+    ASTD({"{{KEY or KEY_4 or KEY_3}} {{KEY_1}}","Recursive Normal value value Normal value"}),
+    ASTD({"{{KEY_1}} {{FOO or KEY or KEY_5}}!", "Normal value Recursive Recursive Normal value value value!"}),
     ASTD({"{{FOO or BAR or BAR or FOO}}",       ""}),
     ASTD({"{{FOO or BAR or KEY or KEY_1}}",     "Normal value"}),
     ASTD({"{{FOO or 'a literal!' or KEY_1}}",   "a literal!"}),
@@ -101,9 +124,6 @@ INSTANTIATE_TEST_SUITE_P(AttributeSubstitutorTest, AttributeSubstitutorTest, ::t
 ));
 // clang-format on
 
-// TODO: disabled test cases fail because of bugs in the
-// librepcb::AttributeSubstitutor!
-
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
@@ -0,0 +1,77 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/bom/bom.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BomTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BomTest, testItemsAreGroupedByAttributes) {
+  Bom bom(QStringList{"Value", "Package"});
+  bom.addItem("R10", QStringList{"1k", "0805"});
+  bom.addItem("C1", QStringList{"100n", "0805"});
+  bom.addItem("R2", QStringList{"1k", "0805"});
+  bom.addItem("R1", QStringList{"1k", "0603"});
+
+  ASSERT_EQ(3, bom.getItems().count());
+  EXPECT_EQ(QStringList{"C1"}, bom.getItems().at(0).getDesignators());
+  EXPECT_EQ(QStringList{"R1"}, bom.getItems().at(1).getDesignators());
+  EXPECT_EQ((QStringList{"R2", "R10"}), bom.getItems().at(2).getDesignators());
+  EXPECT_EQ((QStringList{"1k", "0805"}), bom.getItems().at(2).getAttributes());
+}
+
+TEST_F(BomTest, testAddItemsAfterGetItems) {
+  Bom bom(QStringList{"Value"});
+  bom.addItem("R2", QStringList{"1k"});
+  bom.addItem("C1", QStringList{"100n"});
+  ASSERT_EQ(2, bom.getItems().count());  // sorts the items
+
+  bom.addItem("C2", QStringList{"100n"});
+  bom.addItem("R1", QStringList{"1k"});
+  ASSERT_EQ(2, bom.getItems().count());
+  EXPECT_EQ((QStringList{"C1", "C2"}), bom.getItems().at(0).getDesignators());
+  EXPECT_EQ((QStringList{"R1", "R2"}), bom.getItems().at(1).getDesignators());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
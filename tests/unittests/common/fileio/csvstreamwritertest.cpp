@@ -0,0 +1,91 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/csvfile.h>
+#include <librepcb/common/fileio/csvstreamwriter.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class CsvStreamWriterTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(CsvStreamWriterTest, testWriteRowThrowsExceptionIfNoHeaderWritten) {
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  CsvStreamWriter writer(buffer);
+  EXPECT_THROW(writer.writeRow({"V1", "V2"}), Exception);
+}
+
+TEST_F(CsvStreamWriterTest, testWriteRowThrowsExceptionIfWrongCount) {
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  CsvStreamWriter writer(buffer);
+  writer.writeHeader({"Foo"});
+  EXPECT_THROW(writer.writeRow({"V1", "V2"}), Exception);
+}
+
+TEST_F(CsvStreamWriterTest, testWriteThrowsExceptionIfDeviceNotWritable) {
+  QBuffer         buffer;  // not opened
+  CsvStreamWriter writer(buffer);
+  EXPECT_THROW(writer.writeHeader({"Foo"}), Exception);
+}
+
+TEST_F(CsvStreamWriterTest, testOutputIsSameAsCsvFile) {
+  CsvFile f;
+  f.setComment("Foo\nBar");
+  f.setHeader({"Column", "Column With Space", "With,Comma", "\"With Quotes\""});
+  f.addValue({"", "", "", ""});
+  f.addValue({"Value", "Value With Space", "With,Comma", "\"With Quotes\""});
+  f.addValue({"-1.2345", "Foo\r\nBar", " spaces around ", "äöü"});
+
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  CsvStreamWriter writer(buffer);
+  writer.writeComment(f.getComment());
+  writer.writeHeader(f.getHeader());
+  foreach (const QStringList& row, f.getValues()) { writer.writeRow(row); }
+  EXPECT_EQ(f.toString().toStdString(),
+            QString::fromUtf8(buffer.data()).toStdString());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
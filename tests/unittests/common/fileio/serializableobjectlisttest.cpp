@@ -270,6 +270,80 @@ TEST_F(SerializableObjectListTest, testClear) {
   EXPECT_EQ(0, l.count());
 }
 
+TEST_F(SerializableObjectListTest, testLookupInLargeList) {
+  // large enough to use the hash index instead of a linear scan
+  List                         l;
+  QList<std::shared_ptr<Mock>> mocks;
+  for (int i = 0; i < 100; ++i) {
+    mocks.append(std::make_shared<Mock>(Uuid::createRandom(),
+                                        QString("mock%1").arg(i)));
+    l.append(mocks.last());
+  }
+  EXPECT_EQ(42, l.indexOf(mocks[42]->mUuid));
+  EXPECT_EQ(42, l.indexOf(QString("mock42")));
+  EXPECT_EQ(-1, l.indexOf(mMocks[0]->mUuid));
+
+  // append (extends the index)
+  l.append(mMocks[0]);
+  EXPECT_EQ(100, l.indexOf(mMocks[0]->mUuid));
+  EXPECT_EQ(100, l.indexOf(QString("foo")));
+
+  // insert (rebuilds the index)
+  l.insert(10, mMocks[1]);
+  EXPECT_EQ(10, l.indexOf(mMocks[1]->mUuid));
+  EXPECT_EQ(43, l.indexOf(mocks[42]->mUuid));
+  EXPECT_EQ(101, l.indexOf(QString("foo")));
+
+  // remove
+  l.remove(mocks[0].get());
+  EXPECT_EQ(-1, l.indexOf(mocks[0]->mUuid));
+  EXPECT_EQ(9, l.indexOf(mMocks[1]->mUuid));
+  EXPECT_EQ(42, l.indexOf(QString("mock42")));
+
+  // swap
+  l.swap(0, 50);
+  EXPECT_EQ(0, l.indexOf(l[0]->mUuid));
+  EXPECT_EQ(50, l.indexOf(l[50]->mName));
+
+  // duplicate names: the first element wins
+  l.append(std::make_shared<Mock>(Uuid::createRandom(), "mock42"));
+  EXPECT_EQ(42, l.indexOf(QString("mock42")));
+}
+
+TEST_F(SerializableObjectListTest, testLookupInLargeListAfterEdit) {
+  List                         l;
+  QList<std::shared_ptr<Mock>> mocks;
+  for (int i = 0; i < 100; ++i) {
+    mocks.append(std::make_shared<Mock>(Uuid::createRandom(),
+                                        QString("mock%1").arg(i)));
+    l.append(mocks.last());
+  }
+  EXPECT_EQ(42, l.indexOf(mocks[42].get()));
+  EXPECT_EQ(42, l.indexOf(QString("mock42")));
+
+  // edit (keeps the pointer index, but not the name index)
+  int editedIndex = -1;
+  List::OnEditedSlot slot(
+      [&](const List& list, int index, const std::shared_ptr<const Mock>& obj,
+          List::Event event) {
+        Q_UNUSED(list);
+        Q_UNUSED(obj);
+        if (event == List::Event::ElementEdited) editedIndex = index;
+      });
+  l.onEdited.attach(slot);
+  mocks[42]->mName = "edited";
+  mocks[42]->onEdited.notify();
+  EXPECT_EQ(42, editedIndex);
+  EXPECT_EQ(42, l.indexOf(mocks[42].get()));
+  EXPECT_EQ(-1, l.indexOf(QString("mock42")));
+  EXPECT_EQ(42, l.indexOf(QString("edited")));
+
+  // remove (rebuilds the pointer index)
+  l.remove(mocks[0].get());
+  EXPECT_EQ(-1, l.indexOf(mocks[0].get()));
+  EXPECT_EQ(41, l.indexOf(mocks[42].get()));
+}
+
 TEST_F(SerializableObjectListTest, testSerialize) {
   SExpression e = SExpression::createList("list");
   List        l{mMocks[0], mMocks[1], mMocks[2]};
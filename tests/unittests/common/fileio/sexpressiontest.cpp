@@ -0,0 +1,218 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/fileio/filepath.h>
+#include <librepcb/common/fileio/sexpression.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class SExpressionTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(SExpressionTest, testParseList) {
+  SExpression s = SExpression::parse(
+      "(librepcb_board 71762d7e\n"
+      " (name \"Foo \\\"Bar\\\"\\n\")\n"
+      " (position -1.5 2.0) (rotation 90.0)\n"
+      ")\n",
+      FilePath());
+  EXPECT_TRUE(s.isList());
+  EXPECT_EQ("librepcb_board", s.getName().toStdString());
+  EXPECT_EQ(4, s.getChildren().count());
+  EXPECT_TRUE(s.getChildByIndex(0).isToken());
+  EXPECT_EQ("71762d7e", s.getValueOfFirstChild<QString>().toStdString());
+  EXPECT_TRUE(s.getChildByPath("name").getChildByIndex(0).isString());
+  EXPECT_EQ("Foo \"Bar\"\n",
+            s.getValueByPath<QString>("name").toStdString());
+  EXPECT_EQ("-1.5", s.getChildByPath("position")
+                        .getChildByIndex(0)
+                        .getStringOrToken()
+                        .toStdString());
+  EXPECT_EQ("2.0", s.getChildByPath("position")
+                       .getChildByIndex(1)
+                       .getStringOrToken()
+                       .toStdString());
+}
+
+TEST_F(SExpressionTest, testParseUtf8String) {
+  SExpression s =
+      SExpression::parse(QString("(name \"Ω µ 电阻\")").toUtf8(), FilePath());
+  EXPECT_EQ(QString("Ω µ 电阻").toStdString(),
+            s.getValueOfFirstChild<QString>().toStdString());
+}
+
+TEST_F(SExpressionTest, testParseEmptyString) {
+  SExpression s = SExpression::parse("(name \"\")", FilePath());
+  EXPECT_EQ("", s.getValueOfFirstChild<QString>().toStdString());
+}
+
+TEST_F(SExpressionTest, testParseIgnoresComments) {
+  SExpression s =
+      SExpression::parse("; comment\n(foo ; comment\n bar)\n", FilePath());
+  EXPECT_EQ("foo", s.getName().toStdString());
+  EXPECT_EQ(1, s.getChildren().count());
+}
+
+TEST_F(SExpressionTest, testParseSharesRepeatedNames) {
+  SExpression s = SExpression::parse("(foo (vertex 0.0) (vertex 0.0))",
+                                     FilePath());
+  const SExpression& v1 = s.getChildByIndex(0);
+  const SExpression& v2 = s.getChildByIndex(1);
+  EXPECT_EQ(v1.getName().constData(), v2.getName().constData());
+  EXPECT_EQ(v1.getChildByIndex(0).getStringOrToken().constData(),
+            v2.getChildByIndex(0).getStringOrToken().constData());
+}
+
+TEST_F(SExpressionTest, testParseLargeSubtreesLazily) {
+  QByteArray content = "(board\n (device\n";
+  for (int i = 0; i < 100; ++i) {
+    content += QString("  (pad %1 (position %1.0 0.0))\n").arg(i).toUtf8();
+  }
+  content += " )\n (name \"foo\")\n)\n";
+  SExpression s = SExpression::parse(content, FilePath());
+  EXPECT_EQ("foo", s.getValueByPath<QString>("name").toStdString());
+  const SExpression& device = s.getChildByPath("device");
+  EXPECT_EQ("device", device.getName().toStdString());
+  EXPECT_EQ(100, device.getChildren("pad").count());
+  EXPECT_EQ("99.0", device.getChildByIndex(99)
+                        .getChildByPath("position")
+                        .getChildByIndex(0)
+                        .getStringOrToken()
+                        .toStdString());
+
+  // syntax errors in lazily parsed subtrees must be detected immediately
+  content.replace("(pad 50", "(pad \"\\x\"");  // invalid escape sequence
+  EXPECT_THROW(SExpression::parse(content, FilePath()), FileParseError);
+}
+
+TEST_F(SExpressionTest, testLazySubtreesAreParsedOnceForAllCopies) {
+  QByteArray content = "(board\n (device\n";
+  for (int i = 0; i < 1000; ++i) {
+    content += QString("  (pad %1 (position %1.0 0.0))\n").arg(i).toUtf8();
+  }
+  content += " )\n)\n";
+  const SExpression   root  = SExpression::parse(content, FilePath());
+  const SExpression   copy1 = root.getChildByPath("device");
+  const SExpression   copy2 = copy1;
+  QList<QFuture<int>> futures;
+  for (int i = 0; i < 8; ++i) {
+    futures.append(QtConcurrent::run([&copy1, &copy2, i]() {
+      return ((i % 2) ? copy1 : copy2).getChildren("pad").count();
+    }));
+  }
+  foreach (QFuture<int> future, futures) {
+    EXPECT_EQ(1000, future.result());
+  }
+  EXPECT_EQ(&copy1.getChildren(), &copy2.getChildren());
+  EXPECT_EQ(&copy1.getChildren(),
+            &root.getChildByPath("device").getChildren());
+
+  // modifying a copy must not affect the others
+  SExpression modified = copy1;
+  modified.appendChild("foo", QString("bar"), true);
+  EXPECT_EQ(1000, copy1.getChildren().count());
+  EXPECT_EQ(1002, modified.getChildren().count());
+}
+
+TEST_F(SExpressionTest, testParseInvalidContentThrows) {
+  QList<QByteArray> invalid = {
+      "",                     // no root node
+      "(foo) (bar)",          // multiple root nodes
+      "(foo",                 // list not closed
+      "(foo))",               // too many closing parentheses
+      "()",                   // list without name
+      "(\"foo\")",            // list name is a string
+      "(foo \"bar)",          // string not terminated
+      "(foo \"b\\ar\\\")",    // string not terminated after escape sequence
+      "(foo \"b\\xar\")",     // invalid escape sequence
+  };
+  foreach (const QByteArray& content, invalid) {
+    EXPECT_THROW(SExpression::parse(content, FilePath()), FileParseError)
+        << content.constData();
+  }
+}
+
+TEST_F(SExpressionTest, testParseErrorContainsPosition) {
+  try {
+    SExpression::parse("(foo\n  (bar \"baz\\q\")\n)", FilePath());
+    FAIL();
+  } catch (const FileParseError& e) {
+    EXPECT_TRUE(e.getMsg().contains("Line,Column: 2,13"))
+        << e.getMsg().toStdString();
+  }
+}
+
+TEST_F(SExpressionTest, testSerialize) {
+  SExpression s = SExpression::createList("librepcb_board");
+  s.appendChild(SExpression::createToken("abc"), false);
+  s.appendChild("name", QString("Foo \"Bar\""), true);
+  SExpression& child = s.appendList("position", true);
+  child.appendChild(SExpression::createToken("1.0"), false);
+  child.appendChild(SExpression::createToken("2.0"), false);
+  EXPECT_EQ(
+      "(librepcb_board abc\n"
+      " (name \"Foo \\\"Bar\\\"\")\n"
+      " (position 1.0 2.0)\n"
+      ")\n",
+      s.toByteArray().toStdString());
+}
+
+TEST_F(SExpressionTest, testSerializeInvalidTokenThrows) {
+  SExpression s = SExpression::createList("foo");
+  s.appendChild(SExpression::createToken("foo bar"), false);
+  EXPECT_THROW(s.toByteArray(), LogicError);
+}
+
+TEST_F(SExpressionTest, testGetMemoryUsage) {
+  EXPECT_GE(SExpression().getMemoryUsage(), qint64(sizeof(SExpression)));
+  SExpression s = SExpression::createList("root");
+  const qint64 emptySize = s.getMemoryUsage();
+  for (int i = 0; i < 100; ++i) {
+    s.appendChild(SExpression::createString(QString(100, 'x')), false);
+  }
+  EXPECT_GE(s.getMemoryUsage(),
+            emptySize + 100 * qint64(sizeof(SExpression) + 200));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -93,6 +93,12 @@ TEST_F(TransactionalFileSystemTest, testConstructorPopulatedDir) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 }
 
+TEST_F(TransactionalFileSystemTest, testConstructorReadOnlyDoesNotLock) {
+  TransactionalFileSystem fs1(mPopulatedDir, false);
+  TransactionalFileSystem fs2(mPopulatedDir, false);
+  EXPECT_FALSE(mPopulatedDir.getPathTo(".lock").isExistingFile());
+}
+
 TEST_F(TransactionalFileSystemTest, testGetPath) {
   TransactionalFileSystem fs(mPopulatedDir, false);
   EXPECT_EQ(mPopulatedDir, fs.getPath());
@@ -135,6 +141,18 @@ TEST_F(TransactionalFileSystemTest, testWriteExistingFile) {
   EXPECT_EQ("new content", fs.read("1.txt"));
 }
 
+TEST_F(TransactionalFileSystemTest, testWriteUnchangedFileIsSkippedOnSave) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  ASSERT_EQ("1", fs.read("1.txt"));
+  fs.write("1.txt", "1");  // same content as on disk
+
+  // modify the file on disk to detect whether it gets overwritten
+  FilePath fp = mPopulatedDir.getPathTo("1.txt");
+  FileUtils::writeFile(fp, "foo");
+  fs.save();
+  EXPECT_EQ("foo", FileUtils::readFile(fp));
+}
+
 TEST_F(TransactionalFileSystemTest, testWriteCreatesNewDirectoryAndFile) {
   TransactionalFileSystem fs(mPopulatedDir, true);
   ASSERT_FALSE(fs.fileExists("x/y/z"));
@@ -161,6 +179,22 @@ TEST_F(TransactionalFileSystemTest, testWriteIsDelayedUntilSave) {
   EXPECT_EQ("content", FileUtils::readFile(fp));
 }
 
+TEST_F(TransactionalFileSystemTest, testSaveManyFiles) {
+  // files are written concurrently, even into the same new directories
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  for (int i = 0; i < 200; ++i) {
+    fs.write(QString("dir %1/sub/%2").arg(i % 10).arg(i),
+             QByteArray::number(i));
+  }
+  fs.save();
+  for (int i = 0; i < 200; ++i) {
+    FilePath fp = mPopulatedDir.getPathTo(
+        QString("dir %1/sub/%2").arg(i % 10).arg(i));
+    EXPECT_EQ(QByteArray::number(i), FileUtils::readFile(fp));
+  }
+  EXPECT_FALSE(mPopulatedDir.getPathTo(".backup").isExistingDir());
+}
+
 TEST_F(TransactionalFileSystemTest, testRemoveExistingFile) {
   FilePath                fp = mPopulatedDir.getPathTo("1/1a.txt");
   TransactionalFileSystem fs(mPopulatedDir, true);
@@ -440,6 +474,46 @@ TEST_F(TransactionalFileSystemTest, testAutosaveIsRemovedInDestructor) {
   EXPECT_FALSE(fp.isExistingDir());
 }
 
+TEST_F(TransactionalFileSystemTest, testAutosaveWritesOnlyModifiedFiles) {
+  FilePath      autosaveDir = mPopulatedDir.getPathTo(".autosave");
+  QDir::Filters filters     = QDir::Dirs | QDir::NoDotAndDotDot;
+  TransactionalFileSystem fs(mPopulatedDir, true);
+
+  // first autosave writes all modified files
+  fs.write("a.txt", "a");
+  fs.write("b.txt", "b");
+  fs.autosave();
+  QStringList dirs1 = QDir(autosaveDir.toStr()).entryList(filters);
+  ASSERT_EQ(1, dirs1.count());
+
+  // second autosave writes only b.txt and references a.txt of the first one
+  QThread::msleep(5);      // make sure the new directory gets another name
+  fs.write("a.txt", "a");  // same content as before
+  fs.write("b.txt", "new b");
+  fs.autosave();
+  QStringList dirs2 = QDir(autosaveDir.toStr()).entryList(filters);
+  ASSERT_EQ(2, dirs2.count());
+  EXPECT_TRUE(dirs2.contains(dirs1.first()));
+
+  // third autosave writes a.txt, so the first directory is not needed anymore
+  QThread::msleep(5);
+  fs.write("a.txt", "new a");
+  fs.autosave();
+  QStringList dirs3 = QDir(autosaveDir.toStr()).entryList(filters);
+  EXPECT_EQ(2, dirs3.count());
+  EXPECT_FALSE(dirs3.contains(dirs1.first()));
+
+  // remove lock because we can't get a stale lock without crashing the app
+  FileUtils::removeFile(mPopulatedDir.getPathTo(".lock"));
+
+  // the restored autosave must contain the latest content of all files
+  TransactionalFileSystem fs2(mPopulatedDir, true,
+                              &TransactionalFileSystem::RestoreMode::yes);
+  EXPECT_TRUE(fs2.isRestoredFromAutosave());
+  EXPECT_EQ("new a", fs2.read("a.txt"));
+  EXPECT_EQ("new b", fs2.read("b.txt"));
+}
+
 TEST_F(TransactionalFileSystemTest, testRestoreAutosave) {
   TransactionalFileSystem fs(mPopulatedDir, true);
 
@@ -551,6 +625,22 @@ TEST_F(TransactionalFileSystemTest, testRestoreAutosave) {
   EXPECT_EQ("new file", FileUtils::readFile(fs2.getAbsPath(".dot/file.txt")));
 }
 
+TEST_F(TransactionalFileSystemTest, testAutosaveIgnoredWithoutCallback) {
+  TransactionalFileSystem fs(mPopulatedDir, true);
+  fs.write("1.txt", "new 1");
+  fs.autosave();
+
+  // read-only file systems can be opened while the directory is locked
+  TransactionalFileSystem fs2(mPopulatedDir, false);
+  EXPECT_FALSE(fs2.isRestoredFromAutosave());
+  EXPECT_EQ("1", fs2.read("1.txt"));
+
+  TransactionalFileSystem fs3(mPopulatedDir, false,
+                              &TransactionalFileSystem::RestoreMode::yes);
+  EXPECT_TRUE(fs3.isRestoredFromAutosave());
+  EXPECT_EQ("new 1", fs3.read("1.txt"));
+}
+
 TEST_F(TransactionalFileSystemTest, testRestoredBackupAfterFailedSave) {
   FilePath backupDir = mPopulatedDir.getPathTo(".backup");
 
@@ -611,6 +701,26 @@ TEST_F(TransactionalFileSystemTest, testExportImportZipByFilePath) {
   }
 }
 
+TEST_F(TransactionalFileSystemTest, testLoadFromZipDecompressesOnSave) {
+  FilePath zipFp = mPopulatedDir.getPathTo("export.zip");
+  {
+    TransactionalFileSystem fs(mPopulatedDir, true);
+    fs.exportToZip(zipFp);
+  }
+  {
+    TransactionalFileSystem fs(mEmptyDir, true);
+    fs.loadFromZip(zipFp);
+    EXPECT_TRUE(fs.fileExists("foo dir/bar dir.txt"));
+    EXPECT_TRUE(fs.getDirs().contains("foo dir"));
+    EXPECT_TRUE(fs.getFiles("foo dir").contains("bar dir.txt"));
+    fs.removeFile("1.txt");
+    fs.save();
+  }
+  EXPECT_EQ("bar",
+            FileUtils::readFile(mEmptyDir.getPathTo("foo dir/bar dir.txt")));
+  EXPECT_FALSE(mEmptyDir.getPathTo("1.txt").isExistingFile());
+}
+
 TEST_F(TransactionalFileSystemTest, testExportImportZipByByteArray) {
   QByteArray content;
   {
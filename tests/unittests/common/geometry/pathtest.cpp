@@ -24,6 +24,10 @@
 #include <gtest/gtest.h>
 #include <librepcb/common/geometry/path.h>
 
+#include <QtConcurrent/QtConcurrent>
+
+#include <tuple>
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -77,6 +81,68 @@ TEST_F(PathTest, testCircle) {
   EXPECT_TRUE(path.isClosed());
 }
 
+TEST_F(PathTest, testFlatArcSegmentCount) {
+  QList<std::tuple<Point, Point, Angle>> arcs = {
+      std::make_tuple(Point(0, 0), Point(1000, 0), Angle::deg90()),
+      std::make_tuple(Point(0, 0), Point(5000000, 0), -Angle::deg180()),
+      std::make_tuple(Point(-3000000, 0), Point(0, 2000000), Angle::deg270()),
+      std::make_tuple(Point(0, 0), Point(100000000, 0), Angle(1234567)),
+  };
+  for (const auto& arc : arcs) {
+    for (const PositiveLength& tolerance :
+         {PositiveLength(1000), PositiveLength(10000), PositiveLength(5000)}) {
+      Path path = Path::flatArc(std::get<0>(arc), std::get<1>(arc),
+                                std::get<2>(arc), tolerance);
+      EXPECT_EQ(path.getVertices().count() - 1,
+                Path::flatArcSegmentCount(std::get<0>(arc), std::get<1>(arc),
+                                          std::get<2>(arc), tolerance));
+    }
+  }
+}
+
+TEST_F(PathTest, testToQPainterPathPxIsUpdatedOnModification) {
+  Path   path = Path::centeredRect(PositiveLength(2000000),
+                                   PositiveLength(1000000));
+  QRectF rect = path.toQPainterPathPx().boundingRect();
+  Path   copy(path);
+  EXPECT_EQ(rect, copy.toQPainterPathPx().boundingRect());
+  path.translate(Point(1000000, 0));
+  EXPECT_EQ(rect.translated(Length(1000000).toPx(), 0),
+            path.toQPainterPathPx().boundingRect());
+  EXPECT_EQ(rect, copy.toQPainterPathPx().boundingRect());  // unchanged
+  copy = path;
+  EXPECT_EQ(path.toQPainterPathPx(), copy.toQPainterPathPx());
+}
+
+TEST_F(PathTest, testToQPainterPathPxIsSharedBetweenCopies) {
+  Path                path = Path::circle(PositiveLength(2000000));
+  const QPainterPath& p    = path.toQPainterPathPx();
+  Path                copy(path);
+  Path                assigned;
+  assigned = path;
+  EXPECT_EQ(&p, &copy.toQPainterPathPx());
+  EXPECT_EQ(&p, &assigned.toQPainterPathPx());
+  copy.translate(Point(1000000, 0));  // must not affect the other paths
+  EXPECT_NE(&p, &copy.toQPainterPathPx());
+  EXPECT_EQ(&p, &path.toQPainterPathPx());
+  EXPECT_EQ(&p, &assigned.toQPainterPathPx());
+}
+
+TEST_F(PathTest, testToQPainterPathPxFromMultipleThreads) {
+  const Path path = Path::obround(PositiveLength(3000000),
+                                  PositiveLength(1000000));
+  QList<QFuture<QRectF>> futures;
+  for (int i = 0; i < 8; ++i) {
+    futures.append(QtConcurrent::run(
+        [&path]() { return path.toQPainterPathPx().boundingRect(); }));
+  }
+  const QPainterPath& painterPath = path.toQPainterPathPx();
+  foreach (QFuture<QRectF> future, futures) {
+    EXPECT_EQ(painterPath.boundingRect(), future.result());
+  }
+  EXPECT_EQ(&painterPath, &path.toQPainterPathPx());  // cached
+}
+
 /*******************************************************************************
  *  Parametrized obround(width, height) Tests
  ******************************************************************************/
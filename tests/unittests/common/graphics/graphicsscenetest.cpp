@@ -0,0 +1,196 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/graphics/origincrossgraphicsitem.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Helper Classes
+ ******************************************************************************/
+
+/**
+ * @brief Paint engine which records the pen width of every drawn line
+ */
+class LineRecordingPaintEngine final : public QPaintEngine {
+public:
+  LineRecordingPaintEngine() noexcept : QPaintEngine(AllFeatures) {}
+  bool begin(QPaintDevice* pdev) override {
+    Q_UNUSED(pdev);
+    return true;
+  }
+  bool end() override { return true; }
+  void updateState(const QPaintEngineState& state) override {
+    if (state.state() & DirtyPen) {
+      mPen = state.pen();
+    }
+  }
+  void drawLines(const QLineF* lines, int lineCount) override {
+    Q_UNUSED(lines);
+    for (int i = 0; i < lineCount; ++i) {
+      mPenWidths.append(mPen.widthF());
+    }
+  }
+  void drawLines(const QLine* lines, int lineCount) override {
+    Q_UNUSED(lines);
+    for (int i = 0; i < lineCount; ++i) {
+      mPenWidths.append(mPen.widthF());
+    }
+  }
+  void drawPixmap(const QRectF& r, const QPixmap& pm,
+                  const QRectF& sr) override {
+    Q_UNUSED(r);
+    Q_UNUSED(pm);
+    Q_UNUSED(sr);
+  }
+  Type               type() const override { return User; }
+  const QList<qreal>& getPenWidths() const noexcept { return mPenWidths; }
+
+private:
+  QPen         mPen;
+  QList<qreal> mPenWidths;
+};
+
+/**
+ * @brief Paint device using ::librepcb::tests::LineRecordingPaintEngine
+ */
+class LineRecordingPaintDevice final : public QPaintDevice {
+public:
+  QPaintEngine* paintEngine() const override { return &mEngine; }
+  const QList<qreal>& getPenWidths() const noexcept {
+    return mEngine.getPenWidths();
+  }
+
+protected:
+  int metric(PaintDeviceMetric metric) const override {
+    switch (metric) {
+      case PdmWidth:
+      case PdmHeight:
+        return 1000;
+      case PdmDpiX:
+      case PdmDpiY:
+      case PdmPhysicalDpiX:
+      case PdmPhysicalDpiY:
+        return 72;
+      case PdmDevicePixelRatio:
+        return 1;
+      default:
+        return QPaintDevice::metric(metric);
+    }
+  }
+
+private:
+  mutable LineRecordingPaintEngine mEngine;
+};
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GraphicsSceneTest : public ::testing::Test {
+protected:
+  /**
+   * @brief Render a scene into a QPicture and return the pen widths of all
+   *        lines drawn when replaying the picture
+   *
+   * This is the same way as schematic pages are printed, i.e. the scene is
+   * not painted on the printer directly.
+   */
+  static QList<qreal> renderIntoPicture(GraphicsScene& scene) {
+    QPicture picture;
+    {
+      QPainter painter(&picture);
+      scene.render(&painter, QRectF(0, 0, 100, 100),
+                   QRectF(-50, -50, 100, 100));
+    }
+    LineRecordingPaintDevice device;
+    {
+      QPainter painter(&device);
+      picture.play(&painter);
+    }
+    return device.getPenWidths();
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GraphicsSceneTest, testIsPrintingOnPicture) {
+  GraphicsScene        scene;
+  QGraphicsRectItem    item(0, 0, 10, 10);
+  QGraphicsEllipseItem itemWithoutScene(0, 0, 10, 10);
+  scene.addItem(item);
+  QPicture picture;
+  QPainter painter(&picture);
+  EXPECT_FALSE(GraphicsScene::isPrinting(painter, item));
+  scene.setPrintMode(true);
+  EXPECT_TRUE(GraphicsScene::isPrinting(painter, item));
+  EXPECT_FALSE(GraphicsScene::isPrinting(painter, itemWithoutScene));
+  scene.setPrintMode(false);
+  EXPECT_FALSE(GraphicsScene::isPrinting(painter, item));
+  scene.removeItem(item);
+}
+
+TEST_F(GraphicsSceneTest, testPrintModeAffectsRecordedPrimitives) {
+  GraphicsLayer           layer(GraphicsLayer::sSchematicReferences);
+  GraphicsScene           scene;
+  OriginCrossGraphicsItem hiddenCross;
+  OriginCrossGraphicsItem printedCross;
+  hiddenCross.setLayer(&layer);
+  hiddenCross.setSize(UnsignedLength(10000000));
+  printedCross.setLayer(&layer);
+  printedCross.setSize(UnsignedLength(10000000));
+  printedCross.setVisibleInPrintOutput(true);
+  scene.addItem(hiddenCross);
+  scene.addItem(printedCross);
+
+  // on screen, both crosses are drawn with cosmetic lines
+  QList<qreal> screenWidths = renderIntoPicture(scene);
+  EXPECT_EQ(QList<qreal>({0, 0, 0, 0}), screenWidths);
+
+  // in print mode, only the printed cross is drawn, with a minimum line width
+  scene.setPrintMode(true);
+  QList<qreal> printWidths = renderIntoPicture(scene);
+  qreal        minWidth    = Length(100000).toPx();
+  EXPECT_EQ(QList<qreal>({minWidth, minWidth}), printWidths);
+
+  scene.removeItem(hiddenCross);
+  scene.removeItem(printedCross);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,133 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicsscene.h>
+#include <librepcb/common/graphics/graphicsview.h>
+
+#include <QtCore>
+#include <QtWidgets>
+
+#include <iostream>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class GraphicsViewTest : public ::testing::Test {
+protected:
+  static void populateScene(GraphicsScene& scene, int columns, int rows) {
+    for (int x = 0; x < columns; ++x) {
+      for (int y = 0; y < rows; ++y) {
+        QGraphicsEllipseItem* item =
+            new QGraphicsEllipseItem(x * 10, y * 10, 6, 6);
+        item->setPen(Qt::NoPen);
+        item->setBrush(Qt::red);
+        scene.addItem(*item);  // ownership is transferred to the scene
+      }
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(GraphicsViewTest, testUseOpenGlFallsBackIfUnsupported) {
+  GraphicsView view;
+  view.setUseOpenGl(true);
+  // depending on the platform, OpenGL may or may not be available, but the
+  // view must always end up with a valid viewport
+  EXPECT_NE(nullptr, view.viewport());
+  if (!view.getUseOpenGl()) {
+    EXPECT_EQ(nullptr, dynamic_cast<QOpenGLWidget*>(view.viewport()));
+  }
+  view.setUseOpenGl(false);
+  EXPECT_FALSE(view.getUseOpenGl());
+}
+
+TEST_F(GraphicsViewTest, testFrameStatisticsRecordedWhileOverlayVisible) {
+  GraphicsScene scene;
+  populateScene(scene, 10, 10);
+  GraphicsView view;
+  view.resize(400, 300);
+  view.setScene(&scene);
+  view.setVisibleSceneRect(QRectF(0, 0, 100, 100));
+  view.show();
+  QApplication::processEvents();
+  view.measureFrameTime(2);  // not recorded since the overlay is hidden
+  EXPECT_EQ(1, view.getFrameStatisticsCsv().count("\n"));
+
+  view.setPerformanceOverlayVisible(true);
+  view.measureFrameTime(3);
+  QStringList rows = view.getFrameStatisticsCsv().split("\n");
+  ASSERT_GE(rows.count(), 5);  // header + 3 frames + empty last line
+  EXPECT_EQ(
+      "timestamp_ms,frame_time_ms,painted_items,scene_updates,index_rebuilds",
+      rows.first().toStdString());
+  EXPECT_EQ(5, rows.at(1).split(",").count());
+}
+
+/**
+ * @brief Measure frame times of the different viewport configurations
+ *
+ * Not a real test, but allows users to judge whether enabling OpenGL or the
+ * tile cache makes sense on their machine. Run it with the
+ * "--gtest_also_run_disabled_tests" argument.
+ */
+TEST_F(GraphicsViewTest, DISABLED_benchmarkFrameTimes) {
+  GraphicsScene scene;
+  populateScene(scene, 300, 300);
+
+  for (int mode = 0; mode < 3; ++mode) {
+    GraphicsView view;
+    view.resize(1280, 800);
+    view.setUseOpenGl(mode == 2);
+    view.setUseTileCache(mode == 1);
+    view.setScene(&scene);
+    view.show();
+    QApplication::processEvents();
+    const QStringList names = {"raster", "raster+tiles", "opengl"};
+    QString           name  = names[mode];
+    if ((mode == 2) && (!view.getUseOpenGl())) name += " (unsupported)";
+    foreach (qreal size, QList<qreal>({3000, 1000, 300, 100})) {
+      view.setVisibleSceneRect(QRectF(0, 0, size, size));
+      view.measureFrameTime(1);  // warm up (e.g. fill tile cache)
+      std::cout << qPrintable(name) << " @ " << size
+                << "px: " << view.measureFrameTime(20) << " ms/frame"
+                << std::endl;
+    }
+  }
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
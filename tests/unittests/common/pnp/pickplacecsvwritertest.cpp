@@ -134,6 +134,18 @@ TEST_F(PickPlaceCsvWriterTest, testBottomSide) {
   EXPECT_EQ(3, lines.count());
 }
 
+TEST_F(PickPlaceCsvWriterTest, testWriteCsvStreamsSameContent) {
+  std::shared_ptr<PickPlaceData> data = createData();
+  PickPlaceCsvWriter             writer(*data);
+  writer.setIncludeMetadataComment(false);  // contains the current time
+  writer.setBoardSide(PickPlaceCsvWriter::BoardSide::TOP);
+  QBuffer buffer;
+  buffer.open(QIODevice::WriteOnly);
+  writer.writeCsv(buffer);
+  EXPECT_EQ(writer.generateCsv()->toString().toStdString(),
+            QString::fromUtf8(buffer.data()).toStdString());
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
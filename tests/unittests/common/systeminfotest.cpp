@@ -159,6 +159,31 @@ TEST_F(SystemInfoTest, testGetProcessNameByPid) {
   }
 }
 
+TEST_F(SystemInfoTest, testGetProcessCpuTime) {
+  qint64 before = SystemInfo::getProcessCpuTime();
+  EXPECT_GE(before, 0);
+  QElapsedTimer timer;
+  timer.start();
+  volatile quint64 dummy = 0;
+  while (timer.elapsed() < 100) {
+    dummy = dummy + 1;  // busy loop to consume CPU time
+  }
+  EXPECT_GT(SystemInfo::getProcessCpuTime(), before);
+}
+
+TEST_F(SystemInfoTest, testGetPeakMemoryUsage) {
+  EXPECT_GT(SystemInfo::getPeakMemoryUsage(), 0);
+  QByteArray data(64 * 1024 * 1024, 'x');  // touches all pages
+  EXPECT_GE(SystemInfo::getPeakMemoryUsage(), data.size());
+}
+
+TEST_F(SystemInfoTest, testGetCurrentMemoryUsage) {
+  qint64 before = SystemInfo::getCurrentMemoryUsage();
+  EXPECT_GT(before, 0);
+  QByteArray data(64 * 1024 * 1024, 'x');  // touches all pages
+  EXPECT_GE(SystemInfo::getCurrentMemoryUsage(), before + data.size() / 2);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
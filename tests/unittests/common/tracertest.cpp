@@ -0,0 +1,99 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2016 The LibrePCB developers
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/tracer.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TracerTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(TracerTest, testDisabled) {
+  Tracer tracer(false);
+  tracer.addEvent("test", "event", 0, 10);
+  EXPECT_FALSE(tracer.isEnabled());
+  EXPECT_EQ(0, tracer.getEventCount());
+}
+
+TEST_F(TracerTest, testEventsOfMultipleThreads) {
+  Tracer tracer(true);
+  auto   record = [&tracer](int count) {
+    for (int i = 0; i < count; ++i) {
+      qint64 begin = tracer.getTimestampUs();
+      tracer.addEvent("test", "event", begin, tracer.getTimestampUs());
+    }
+  };
+  // More events than fit into a single chunk of the buffer.
+  QList<QFuture<void>> futures;
+  for (int i = 0; i < 4; ++i) {
+    futures.append(QtConcurrent::run([record]() { record(5000); }));
+  }
+  record(10);
+  for (QFuture<void>& future : futures) {
+    future.waitForFinished();
+  }
+  EXPECT_EQ(4 * 5000 + 10, tracer.getEventCount());
+}
+
+TEST_F(TracerTest, testToJson) {
+  Tracer tracer(true);
+  tracer.addEvent("cat", "foo \"bar\"", 10, 25);
+
+  QJsonParseError     error;
+  const QJsonDocument doc = QJsonDocument::fromJson(tracer.toJson(), &error);
+  ASSERT_EQ(QJsonParseError::NoError, error.error)
+      << qPrintable(error.errorString());
+  const QJsonArray events = doc.object().value("traceEvents").toArray();
+  ASSERT_EQ(2, events.count());  // thread name + event
+  EXPECT_EQ("M", events.at(0).toObject().value("ph").toString());
+  EXPECT_EQ("thread_name", events.at(0).toObject().value("name").toString());
+  const QJsonObject event = events.at(1).toObject();
+  EXPECT_EQ("X", event.value("ph").toString());
+  EXPECT_EQ("cat", event.value("cat").toString());
+  EXPECT_EQ("foo \"bar\"", event.value("name").toString());
+  EXPECT_EQ(10, event.value("ts").toInt());
+  EXPECT_EQ(15, event.value("dur").toInt());
+  EXPECT_EQ(QCoreApplication::applicationPid(), event.value("pid").toInt());
+  EXPECT_EQ(events.at(0).toObject().value("tid").toInt(),
+            event.value("tid").toInt());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
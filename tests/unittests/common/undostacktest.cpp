@@ -0,0 +1,252 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2016 The LibrePCB developers
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/undocommand.h>
+#include <librepcb/common/undostack.h>
+
+#include <QtTest>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Helper Classes
+ ******************************************************************************/
+
+/**
+ * @brief Command which sets an integer value, optionally mergeable
+ */
+class CmdSetValue final : public UndoCommand {
+public:
+  CmdSetValue(int& target, int value, bool mergeable) noexcept
+    : UndoCommand("Set value"),
+      mTarget(target),
+      mOldValue(target),
+      mNewValue(value),
+      mMergeable(mergeable) {}
+
+  bool mergeWith(const UndoCommand& other) noexcept override {
+    const CmdSetValue* cmd = dynamic_cast<const CmdSetValue*>(&other);
+    if ((!cmd) || (!mMergeable) || (!cmd->mMergeable) ||
+        (&cmd->mTarget != &mTarget)) {
+      return false;
+    }
+    mNewValue = cmd->mNewValue;
+    return true;
+  }
+
+private:
+  bool performExecute() override {
+    performRedo();
+    return true;
+  }
+  void performUndo() override { mTarget = mOldValue; }
+  void performRedo() override { mTarget = mNewValue; }
+
+  int& mTarget;
+  int  mOldValue;
+  int  mNewValue;
+  bool mMergeable;
+};
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class UndoStackTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(UndoStackTest, testUnlimitedByDefault) {
+  int       value = 0;
+  UndoStack stack;
+  EXPECT_EQ(0, stack.getCommandLimit());
+  for (int i = 1; i <= 100; ++i) {
+    stack.execCmd(new CmdSetValue(value, i, false));
+  }
+  EXPECT_EQ(100, stack.getCommandCount());
+}
+
+TEST_F(UndoStackTest, testCommandLimitDiscardsOldestCommands) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setCommandLimit(3);
+  for (int i = 1; i <= 5; ++i) {
+    stack.execCmd(new CmdSetValue(value, i, false));
+  }
+  EXPECT_EQ(3, stack.getCommandCount());
+  EXPECT_EQ(5, value);
+  while (stack.canUndo()) {
+    stack.undo();
+  }
+  EXPECT_EQ(2, value);  // the first two commands are gone
+}
+
+TEST_F(UndoStackTest, testCommandLimitKeepsRedoableCommands) {
+  int       value = 0;
+  UndoStack stack;
+  for (int i = 1; i <= 5; ++i) {
+    stack.execCmd(new CmdSetValue(value, i, false));
+  }
+  stack.undo();
+  stack.undo();
+  stack.undo();
+  stack.undo();
+  stack.setCommandLimit(2);
+  EXPECT_EQ(4, stack.getCommandCount());  // redoable commands are kept
+  EXPECT_EQ(1, value);
+  stack.redo();
+  stack.redo();
+  stack.redo();
+  stack.redo();
+  EXPECT_EQ(5, value);
+  EXPECT_EQ(4, stack.getCommandCount());
+}
+
+TEST_F(UndoStackTest, testCommandLimitKeepsCleanState) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setCommandLimit(2);
+  stack.execCmd(new CmdSetValue(value, 1, false));
+  stack.setClean();
+  stack.execCmd(new CmdSetValue(value, 2, false));
+  stack.execCmd(new CmdSetValue(value, 3, false));
+  stack.undo();
+  stack.undo();
+  EXPECT_EQ(1, value);
+  EXPECT_TRUE(stack.isClean());
+}
+
+TEST_F(UndoStackTest, testCommandLimitInvalidatesDiscardedCleanState) {
+  int       value = 0;
+  UndoStack stack;
+  stack.setCommandLimit(2);
+  EXPECT_TRUE(stack.isClean());
+  stack.execCmd(new CmdSetValue(value, 1, false));
+  stack.execCmd(new CmdSetValue(value, 2, false));
+  stack.execCmd(new CmdSetValue(value, 3, false));
+  stack.undo();
+  stack.undo();
+  EXPECT_EQ(1, value);
+  EXPECT_FALSE(stack.isClean());  // the clean state was discarded
+}
+
+TEST_F(UndoStackTest, testMergeCommands) {
+  int       value = 0;
+  UndoStack stack;
+  stack.execCmd(new CmdSetValue(value, 1, true));
+  stack.execCmd(new CmdSetValue(value, 2, true));
+  stack.execCmd(new CmdSetValue(value, 3, true));
+  EXPECT_EQ(1, stack.getCommandCount());
+  EXPECT_EQ(3, value);
+  stack.undo();
+  EXPECT_EQ(0, value);
+  stack.redo();
+  EXPECT_EQ(3, value);
+}
+
+TEST_F(UndoStackTest, testDoNotMergeNonMergeableCommands) {
+  int       value = 0;
+  UndoStack stack;
+  stack.execCmd(new CmdSetValue(value, 1, true));
+  stack.execCmd(new CmdSetValue(value, 2, false));
+  EXPECT_EQ(2, stack.getCommandCount());
+}
+
+TEST_F(UndoStackTest, testDoNotMergeAcrossCleanState) {
+  int       value = 0;
+  UndoStack stack;
+  stack.execCmd(new CmdSetValue(value, 1, true));
+  stack.setClean();
+  stack.execCmd(new CmdSetValue(value, 2, true));
+  EXPECT_EQ(2, stack.getCommandCount());
+  stack.undo();
+  EXPECT_TRUE(stack.isClean());
+  EXPECT_EQ(1, value);
+}
+
+TEST_F(UndoStackTest, testSignalsEmittedOncePerCommand) {
+  int        value = 0;
+  UndoStack  stack;
+  QSignalSpy spy(&stack, &UndoStack::stateModified);
+  stack.execCmd(new CmdSetValue(value, 1, false));
+  EXPECT_EQ(1, spy.count());
+  bool active = false;
+  QObject::connect(&stack, &UndoStack::cleanChanged,
+                   [&]() { active = stack.isBatchActive(); });
+  stack.undo();
+  EXPECT_EQ(2, spy.count());
+  EXPECT_FALSE(active);  // signals are emitted after the batch has ended
+}
+
+TEST_F(UndoStackTest, testBatchDefersSignals) {
+  int        value = 0;
+  UndoStack  stack;
+  QSignalSpy modifiedSpy(&stack, &UndoStack::stateModified);
+  QSignalSpy undoTextSpy(&stack, &UndoStack::undoTextChanged);
+  {
+    UndoStackBatch batch(stack);
+    EXPECT_TRUE(stack.isBatchActive());
+    for (int i = 1; i <= 10; ++i) {
+      stack.execCmd(new CmdSetValue(value, i, false));
+    }
+    stack.undo();
+    EXPECT_EQ(0, modifiedSpy.count());
+  }
+  EXPECT_FALSE(stack.isBatchActive());
+  EXPECT_EQ(1, modifiedSpy.count());
+  EXPECT_EQ(1, undoTextSpy.count());
+  EXPECT_EQ(stack.getUndoText(), undoTextSpy.last().first().toString());
+}
+
+TEST_F(UndoStackTest, testBatchWithoutModificationsEmitsNothing) {
+  UndoStack  stack;
+  QSignalSpy spy(&stack, &UndoStack::stateModified);
+  { UndoStackBatch batch(stack); }
+  EXPECT_EQ(0, spy.count());
+}
+
+TEST_F(UndoStackTest, testCommandGroupCanNotBeUndoneWhileActive) {
+  int        value = 0;
+  UndoStack  stack;
+  QSignalSpy spy(&stack, &UndoStack::canUndoChanged);
+  stack.beginCmdGroup("Group");
+  ASSERT_EQ(1, spy.count());
+  EXPECT_FALSE(spy.last().first().toBool());
+  stack.appendToCmdGroup(new CmdSetValue(value, 1, false));
+  EXPECT_FALSE(spy.last().first().toBool());
+  stack.commitCmdGroup();
+  EXPECT_TRUE(spy.last().first().toBool());
+  EXPECT_EQ(1, value);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -103,10 +103,18 @@ INSTANTIATE_TEST_SUITE_P(LengthTest, LengthTest, ::testing::Values(
     LengthTestData({true,  "0.00009",        Length(90),          "0.00009"     }),
     LengthTestData({true,  "0.000099",       Length(99),          "0.000099"    }),
     LengthTestData({true,  "0.000009",       Length(9),           "0.000009"    }),
+    LengthTestData({true,  "-0",             Length(0),           "0.0"         }),
+    LengthTestData({true,  "+1.5",           Length(1500000),     "1.5"         }),
+    LengthTestData({true,  "007.50",         Length(7500000),     "7.5"         }),
+    LengthTestData({true,  "-12.345678",     Length(-12345678),   "-12.345678"  }),
 
     // invalid cases
     LengthTestData({false, "",               Length(),            QString()     }),
     LengthTestData({false, ".",              Length(),            QString()     }),
+    LengthTestData({false, "-",              Length(),            QString()     }),
+    LengthTestData({false, "--1",            Length(),            QString()     }),
+    LengthTestData({false, "1.5x",           Length(),            QString()     }),
+    LengthTestData({false, "1.2.3",          Length(),            QString()     }),
     LengthTestData({false, "0e",             Length(),            QString()     }),
     LengthTestData({false, "0e+",            Length(),            QString()     }),
     LengthTestData({false, "0e-",            Length(),            QString()     }),
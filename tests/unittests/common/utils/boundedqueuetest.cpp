@@ -0,0 +1,109 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2016 The LibrePCB developers
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/boundedqueue.h>
+
+#include <QtConcurrent/QtConcurrent>
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class BoundedQueueTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(BoundedQueueTest, testCapacityIsRoundedUp) {
+  EXPECT_EQ(2U, BoundedQueue<int>(0).getCapacity());
+  EXPECT_EQ(4U, BoundedQueue<int>(4).getCapacity());
+  EXPECT_EQ(8U, BoundedQueue<int>(5).getCapacity());
+}
+
+TEST_F(BoundedQueueTest, testFifo) {
+  BoundedQueue<QString> queue(4);
+  int                   value = 0;
+  QString               str;
+  EXPECT_FALSE(queue.tryPop(str));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.tryPush(QString::number(i)));
+  }
+  EXPECT_FALSE(queue.tryPush("full"));
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_TRUE(queue.tryPop(str));
+    EXPECT_EQ(QString::number(value++), str);
+  }
+  EXPECT_FALSE(queue.tryPop(str));
+  EXPECT_TRUE(queue.tryPush("wrapped"));
+  EXPECT_TRUE(queue.tryPop(str));
+  EXPECT_EQ("wrapped", str);
+}
+
+TEST_F(BoundedQueueTest, testConcurrentProducers) {
+  BoundedQueue<int>    queue(64);
+  const int            producers = 4;
+  const int            count     = 10000;
+  QList<QFuture<void>> futures;
+  for (int p = 0; p < producers; ++p) {
+    futures.append(QtConcurrent::run([&queue, p, count]() {
+      for (int i = 0; i < count; ++i) {
+        while (!queue.tryPush(p * count + i)) {
+          QThread::yieldCurrentThread();  // full, wait for the consumer
+        }
+      }
+    }));
+  }
+  // Every value must arrive exactly once, and in order per producer.
+  QVector<int> lastOfProducer(producers, -1);
+  for (int received = 0; received < producers * count;) {
+    int value = 0;
+    if (queue.tryPop(value)) {
+      const int producer = value / count;
+      EXPECT_LT(lastOfProducer[producer], value % count);
+      lastOfProducer[producer] = value % count;
+      ++received;
+    } else {
+      QThread::yieldCurrentThread();  // empty, wait for the producers
+    }
+  }
+  for (QFuture<void>& future : futures) {
+    future.waitForFinished();
+  }
+  EXPECT_EQ(QVector<int>(producers, count - 1), lastOfProducer);
+  int value = 0;
+  EXPECT_FALSE(queue.tryPop(value));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,126 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/clipperareacache.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/transform.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ClipperAreaCacheTest : public ::testing::Test {
+protected:
+  virtual void SetUp() override { ClipperAreaCache::instance().clear(); }
+  virtual void TearDown() override { ClipperAreaCache::instance().clear(); }
+
+  static ClipperLib::Paths calcArea(const QVector<Path>&  paths,
+                                    const Length&         offset,
+                                    const PositiveLength& tolerance) {
+    ClipperLib::Paths area;
+    foreach (const Path& path, paths) {
+      ClipperHelpers::unite(area, ClipperHelpers::convert(path, tolerance));
+    }
+    ClipperHelpers::offset(area, offset, tolerance);
+    return area;
+  }
+
+  // The order of the vertices may differ after transforming, so only compare
+  // the size and location of the areas.
+  static void expectSameArea(const ClipperLib::Paths& expected,
+                             const ClipperLib::Paths& actual) {
+    ASSERT_EQ(expected.size(), actual.size());
+    ClipperLib::IntRect r1 = ClipperHelpers::getBoundingRect(expected);
+    ClipperLib::IntRect r2 = ClipperHelpers::getBoundingRect(actual);
+    EXPECT_NEAR(r1.left, r2.left, 1);
+    EXPECT_NEAR(r1.top, r2.top, 1);
+    EXPECT_NEAR(r1.right, r2.right, 1);
+    EXPECT_NEAR(r1.bottom, r2.bottom, 1);
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      EXPECT_NEAR(qAbs(ClipperLib::Area(expected[i])),
+                  qAbs(ClipperLib::Area(actual[i])),
+                  qAbs(ClipperLib::Area(expected[i])) * 1e-6);
+    }
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ClipperAreaCacheTest, testTranslation) {
+  ClipperAreaCache& cache = ClipperAreaCache::instance();
+  PositiveLength    size(2000000);
+  PositiveLength    tolerance(5000);
+  Length            offset(100000);
+  QVector<Path>     paths = {
+      Path::centeredRect(size, size),
+      Path::centeredRect(size, size).translated(Point(1000000, 0))};
+  Point     pos(5000000, -3000000);
+  Transform transform(pos, Angle::deg0(), false);
+  expectSameArea(calcArea(transform.map(paths), offset, tolerance),
+                 cache.get(paths, offset, tolerance, transform));
+}
+
+TEST_F(ClipperAreaCacheTest, testRotationAndMirror) {
+  ClipperAreaCache& cache = ClipperAreaCache::instance();
+  PositiveLength    tolerance(5000);
+  QVector<Path>     paths = {Path::rect(Point(0, 0), Point(3000000, 1000000))};
+  Transform         transform(Point(1000000, 2000000), Angle::deg90(), true);
+  expectSameArea(calcArea(transform.map(paths), Length(0), tolerance),
+                 cache.get(paths, Length(0), tolerance, transform));
+}
+
+TEST_F(ClipperAreaCacheTest, testSharedAreas) {
+  ClipperAreaCache& cache = ClipperAreaCache::instance();
+  PositiveLength    tolerance(5000);
+  QVector<Path>     paths = {Path::circle(PositiveLength(1000000))};
+  for (int i = 0; i < 10; ++i) {
+    Transform transform(Point(i * 1000, 0), Angle::deg0(), false);
+    cache.get(paths, Length(50000), tolerance, transform);
+  }
+  EXPECT_EQ(1, cache.getCount());
+  cache.get(paths, Length(0), tolerance, Transform());
+  cache.get(paths, Length(50000), PositiveLength(1000), Transform());
+  EXPECT_EQ(3, cache.getCount());
+}
+
+TEST_F(ClipperAreaCacheTest, testEmptyArea) {
+  ClipperAreaCache& cache = ClipperAreaCache::instance();
+  EXPECT_TRUE(
+      cache.get({}, Length(100000), PositiveLength(5000), Transform()).empty());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,92 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ClipperHelpersTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ClipperHelpersTest, testConvertPathWithArcsMatchesFlatArc) {
+  PositiveLength tolerance(5000);
+  Path           path;
+  path.addVertex(Point(0, 0), Angle::deg90());
+  path.addVertex(Point(10000000, 0));
+  path.addVertex(Point(10000000, 3000000), -Angle(33333333));
+  path.addVertex(Point(0, 3000000));
+  path.close();
+
+  // build the expected result from Path::flatArc()
+  ClipperLib::Path expected;
+  for (int i = 0; i < path.getVertices().count(); ++i) {
+    const Vertex& v  = path.getVertices().at(i);
+    const Vertex& v0 = path.getVertices().at(qMax(i - 1, 0));
+    if ((i == 0) || (v0.getAngle() == 0)) {
+      expected.push_back(ClipperHelpers::convert(v.getPos()));
+    } else {
+      Path arc = Path::flatArc(v0.getPos(), v.getPos(), v0.getAngle(),
+                               tolerance);
+      for (int k = 1; k < arc.getVertices().count(); ++k) {
+        expected.push_back(
+            ClipperHelpers::convert(arc.getVertices().at(k).getPos()));
+      }
+    }
+  }
+  if (!ClipperLib::Orientation(expected)) {
+    ClipperLib::ReversePath(expected);
+  }
+
+  ClipperLib::Path actual = ClipperHelpers::convert(path, tolerance);
+  EXPECT_GT(actual.size(),
+            static_cast<std::size_t>(path.getVertices().count()));
+  EXPECT_EQ(expected, actual);
+}
+
+TEST_F(ClipperHelpersTest, testConvertPathWithoutArcs) {
+  Path             path   = Path::centeredRect(PositiveLength(2000),
+                                               PositiveLength(1000));
+  ClipperLib::Path actual = ClipperHelpers::convert(path, PositiveLength(5000));
+  EXPECT_EQ(static_cast<std::size_t>(path.getVertices().count()),
+            actual.size());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,115 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/clipperoutlinecache.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ClipperOutlineCacheTest : public ::testing::Test {
+protected:
+  static Path outline(const Length& expansion) noexcept {
+    return Path::obround(Point(0, 0), Point(5000000, 2000000),
+                         PositiveLength(Length(500000) + expansion * 2));
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ClipperOutlineCacheTest, testConversion) {
+  ClipperOutlineCache cache;
+  PositiveLength      tolerance(5000);
+  Length              expansion(100000);
+  EXPECT_EQ(ClipperHelpers::convert(outline(expansion), tolerance),
+            cache.get(1, expansion, tolerance, &outline));
+}
+
+TEST_F(ClipperOutlineCacheTest, testCachedPerKey) {
+  ClipperOutlineCache cache;
+  PositiveLength      tolerance(5000);
+  int                 calls     = 0;
+  auto                generator = [&calls](const Length& e) {
+    ++calls;
+    return outline(e);
+  };
+  cache.get(1, Length(0), tolerance, generator);
+  cache.get(1, Length(0), tolerance, generator);
+  EXPECT_EQ(1, calls);
+  cache.get(1, Length(100000), tolerance, generator);
+  cache.get(1, Length(0), PositiveLength(1000), generator);
+  EXPECT_EQ(2, calls);  // outline is shared between different tolerances
+  EXPECT_EQ(3, cache.getCount());
+  cache.get(1, Length(100000), tolerance, generator);
+  EXPECT_EQ(2, calls);
+}
+
+TEST_F(ClipperOutlineCacheTest, testOutline) {
+  ClipperOutlineCache cache;
+  int                 calls     = 0;
+  auto                generator = [&calls](const Length& e) {
+    ++calls;
+    return outline(e);
+  };
+  EXPECT_EQ(outline(Length(0)), cache.getOutline(1, Length(0), generator));
+  EXPECT_EQ(outline(Length(0)), cache.getOutline(1, Length(0), generator));
+  EXPECT_EQ(1, calls);
+  cache.get(1, Length(0), PositiveLength(5000), generator);
+  EXPECT_EQ(1, calls);  // conversion uses the cached outline
+  cache.getOutline(2, Length(0), generator);
+  EXPECT_EQ(2, calls);
+}
+
+TEST_F(ClipperOutlineCacheTest, testInvalidatedByRevision) {
+  ClipperOutlineCache cache;
+  PositiveLength      tolerance(5000);
+  int                 calls     = 0;
+  auto                generator = [&calls](const Length& e) {
+    ++calls;
+    return outline(e);
+  };
+  cache.get(1, Length(0), tolerance, generator);
+  cache.get(1, Length(100000), tolerance, generator);
+  EXPECT_EQ(2, cache.getCount());
+  cache.get(2, Length(0), tolerance, generator);
+  EXPECT_EQ(3, calls);
+  EXPECT_EQ(1, cache.getCount());
+  cache.clear();
+  EXPECT_EQ(0, cache.getCount());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,91 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/clipperhelpers.h>
+#include <librepcb/common/utils/clippershapecache.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ClipperShapeCacheTest : public ::testing::Test {
+protected:
+  virtual void SetUp() override { ClipperShapeCache::instance().clear(); }
+  virtual void TearDown() override { ClipperShapeCache::instance().clear(); }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ClipperShapeCacheTest, testTranslation) {
+  ClipperShapeCache& cache = ClipperShapeCache::instance();
+  PositiveLength     size(2000000);
+  Path               shape = Path::centeredRect(size, size);
+  Point              pos(5000000, -3000000);
+  PositiveLength     tolerance(5000);
+  EXPECT_EQ(ClipperHelpers::convert(shape.translated(pos), tolerance),
+            cache.get(shape, pos, tolerance));
+}
+
+TEST_F(ClipperShapeCacheTest, testSharedShapes) {
+  ClipperShapeCache& cache = ClipperShapeCache::instance();
+  PositiveLength     size(800000);
+  PositiveLength     tolerance(5000);
+  Path               circle  = Path::circle(size);
+  Path               octagon = Path::octagon(size, size);
+  ClipperLib::Path   origin  = cache.get(circle, Point(0, 0), tolerance);
+  EXPECT_EQ(1, cache.getCount());
+  for (int i = 1; i < 10; ++i) {
+    ClipperLib::Path path = cache.get(circle, Point(i * 1000, 0), tolerance);
+    ASSERT_EQ(origin.size(), path.size());
+    for (std::size_t k = 0; k < path.size(); ++k) {
+      EXPECT_EQ(origin[k].X + i * 1000, path[k].X);
+      EXPECT_EQ(origin[k].Y, path[k].Y);
+    }
+  }
+  EXPECT_EQ(1, cache.getCount());
+  cache.get(circle, Point(0, 0), PositiveLength(1000));
+  cache.get(octagon, Point(0, 0), tolerance);
+  EXPECT_EQ(3, cache.getCount());
+}
+
+TEST_F(ClipperShapeCacheTest, testEmptyShape) {
+  ClipperShapeCache& cache = ClipperShapeCache::instance();
+  EXPECT_TRUE(
+      cache.get(Path(), Point(1000, 1000), PositiveLength(5000)).empty());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
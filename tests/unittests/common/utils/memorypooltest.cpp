@@ -0,0 +1,129 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/memorypool.h>
+
+#include <QtCore>
+
+#include <memory>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Types
+ ******************************************************************************/
+
+class PoolAllocatedMock final : public PoolAllocated<PoolAllocatedMock> {
+public:
+  explicit PoolAllocatedMock(int value) noexcept : mValue(value) {}
+  int    mValue;
+  double mPadding[3];
+};
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class MemoryPoolTest : public ::testing::Test {};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(MemoryPoolTest, testBlockSizeIsAligned) {
+  EXPECT_EQ(16U, MemoryPool(1).getBlockSize());
+  EXPECT_EQ(16U, MemoryPool(16).getBlockSize());
+  EXPECT_EQ(32U, MemoryPool(17).getBlockSize());
+}
+
+TEST_F(MemoryPoolTest, testAllocateAndDeallocate) {
+  MemoryPool   pool(24, 4);
+  QList<void*> blocks;
+  for (int i = 0; i < 10; ++i) {
+    void* block = pool.allocate();
+    EXPECT_EQ(0U, reinterpret_cast<quintptr>(block) % 16);
+    EXPECT_FALSE(blocks.contains(block));
+    blocks.append(block);
+  }
+  EXPECT_EQ(10, pool.getUsedBlocks());
+  EXPECT_EQ(3, pool.getChunkCount());
+  foreach (void* block, blocks) { pool.deallocate(block); }
+  EXPECT_EQ(0, pool.getUsedBlocks());
+
+  // freed blocks are reused
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_TRUE(blocks.contains(pool.allocate()));
+  }
+  EXPECT_EQ(3, pool.getChunkCount());
+  foreach (void* block, blocks) { pool.deallocate(block); }
+}
+
+TEST_F(MemoryPoolTest, testReleaseUnusedChunks) {
+  MemoryPool   pool(24, 4);
+  QList<void*> blocks;
+  for (int i = 0; i < 10; ++i) {
+    blocks.append(pool.allocate());
+  }
+  EXPECT_EQ(0, pool.releaseUnusedChunks());
+
+  // the first 8 blocks are the blocks of the first two chunks
+  for (int i = 0; i < 8; ++i) {
+    pool.deallocate(blocks.takeFirst());
+  }
+  EXPECT_EQ(2, MemoryPool::releaseUnusedChunksOfAllPools());
+  EXPECT_EQ(1, pool.getChunkCount());
+  EXPECT_EQ(2, pool.getUsedBlocks());
+
+  // the free blocks of the remaining chunk are still reused
+  blocks.append(pool.allocate());
+  blocks.append(pool.allocate());
+  EXPECT_EQ(1, pool.getChunkCount());
+  foreach (void* block, blocks) { pool.deallocate(block); }
+  EXPECT_EQ(1, pool.releaseUnusedChunks());
+  EXPECT_EQ(0, pool.getChunkCount());
+}
+
+TEST_F(MemoryPoolTest, testPoolAllocated) {
+  MemoryPool& pool      = PoolAllocatedMock::pool();
+  const int   usedCount = pool.getUsedBlocks();
+  {
+    std::unique_ptr<PoolAllocatedMock> obj1(new PoolAllocatedMock(42));
+    std::unique_ptr<PoolAllocatedMock> obj2(new PoolAllocatedMock(43));
+    EXPECT_EQ(42, obj1->mValue);
+    EXPECT_EQ(43, obj2->mValue);
+    EXPECT_EQ(usedCount + 2, pool.getUsedBlocks());
+  }
+  EXPECT_EQ(usedCount, pool.getUsedBlocks());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,164 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/common/exceptions.h>
+#include <librepcb/common/utils/taskscheduler.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TaskSchedulerTest : public ::testing::Test {
+protected:
+  TaskSchedulerTest() noexcept
+    : mMaxThreadCount(QThreadPool::globalInstance()->maxThreadCount()) {}
+  ~TaskSchedulerTest() noexcept {
+    QThreadPool::globalInstance()->setMaxThreadCount(mMaxThreadCount);
+  }
+
+  int mMaxThreadCount;
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(TaskSchedulerTest, testResult) {
+  QFuture<QString> future = TaskScheduler::run(
+      TaskScheduler::Priority::Normal, []() { return QString("foo"); });
+  EXPECT_EQ("foo", future.result());
+}
+
+TEST_F(TaskSchedulerTest, testVoid) {
+  QAtomicInt    executed(0);
+  QFuture<void> future = TaskScheduler::run(
+      TaskScheduler::Priority::Normal, [&executed]() { executed.store(1); });
+  future.waitForFinished();
+  EXPECT_EQ(1, executed.load());
+}
+
+TEST_F(TaskSchedulerTest, testExceptionIsRethrown) {
+  QFuture<int> future =
+      TaskScheduler::run(TaskScheduler::Priority::Normal, []() -> int {
+        throw RuntimeError(__FILE__, __LINE__, "error");
+      });
+  EXPECT_THROW(future.result(), RuntimeError);
+}
+
+TEST_F(TaskSchedulerTest, testProgress) {
+  QFuture<void> future = TaskScheduler::runWithContext(
+      TaskScheduler::Priority::Normal, [](TaskContext& context) {
+        context.setProgressRange(0, 10);
+        for (int i = 1; i <= 10; ++i) {
+          context.setProgressValue(i);
+        }
+      });
+  future.waitForFinished();
+  EXPECT_EQ(0, future.progressMinimum());
+  EXPECT_EQ(10, future.progressMaximum());
+  EXPECT_EQ(10, future.progressValue());
+}
+
+TEST_F(TaskSchedulerTest, testCancel) {
+  QSemaphore    started;
+  QFuture<void> future = TaskScheduler::runWithContext(
+      TaskScheduler::Priority::Normal, [&started](TaskContext& context) {
+        started.release();
+        while (!context.isCanceled()) {
+          QThread::msleep(1);
+        }
+      });
+  started.acquire();
+  future.cancel();
+  future.waitForFinished();  // must not block forever
+  EXPECT_TRUE(future.isCanceled());
+}
+
+TEST_F(TaskSchedulerTest, testCanceledTaskIsNotExecuted) {
+  QThreadPool::globalInstance()->setMaxThreadCount(1);
+  QSemaphore    blocker;
+  QFuture<void> blocking = TaskScheduler::run(
+      TaskScheduler::Priority::Normal, [&blocker]() { blocker.acquire(); });
+  QAtomicInt    executed(0);
+  QFuture<void> future = TaskScheduler::run(
+      TaskScheduler::Priority::Normal, [&executed]() { executed.store(1); });
+  future.cancel();
+  blocker.release();
+  blocking.waitForFinished();
+  future.waitForFinished();
+  QThreadPool::globalInstance()->waitForDone();
+  EXPECT_EQ(0, executed.load());
+}
+
+TEST_F(TaskSchedulerTest, testPriorities) {
+  // Block the only worker thread until all tasks are queued.
+  QThreadPool::globalInstance()->setMaxThreadCount(1);
+  QSemaphore    blocker;
+  QFuture<void> blocking = TaskScheduler::run(
+      TaskScheduler::Priority::Normal, [&blocker]() { blocker.acquire(); });
+
+  QMutex      mutex;
+  QStringList order;
+  auto start = [&mutex, &order](TaskScheduler::Priority priority,
+                                const QString&          name) {
+    TaskScheduler::run(priority, [&mutex, &order, name]() {
+      QMutexLocker lock(&mutex);
+      order.append(name);
+    });
+  };
+  start(TaskScheduler::Priority::Background, "bg");
+  start(TaskScheduler::Priority::Normal, "normal");
+  start(TaskScheduler::Priority::Interactive, "interactive");
+  blocker.release();
+  blocking.waitForFinished();
+  QThreadPool::globalInstance()->waitForDone();
+  EXPECT_EQ((QStringList{"interactive", "normal", "bg"}), order);
+}
+
+TEST_F(TaskSchedulerTest, testNestedTasksDoNotBlock) {
+  // With a single worker thread, the outer task can only finish if the
+  // inner task is executed in the waiting thread.
+  QThreadPool::globalInstance()->setMaxThreadCount(1);
+  QFuture<int> future =
+      TaskScheduler::run(TaskScheduler::Priority::Normal, []() {
+        QFuture<int> inner = TaskScheduler::run(
+            TaskScheduler::Priority::Normal, []() { return 21; });
+        return inner.result() * 2;
+      });
+  EXPECT_EQ(42, future.result());
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -0,0 +1,121 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <librepcb/common/utils/transform.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Data Type
+ ******************************************************************************/
+
+typedef struct {
+  Point position;
+  Angle rotation;
+  bool  mirrored;
+} TransformTestData;
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class TransformTest : public ::testing::TestWithParam<TransformTestData> {
+protected:
+  static Path createPath() noexcept {
+    return Path({Vertex(Point(1000, 2000), Angle::deg45()),
+                 Vertex(Point(-123456, 789012), Angle::deg0()),
+                 Vertex(Point(3333333, -7777777), -Angle::deg90()),
+                 Vertex(Point(1000, 2000))});
+  }
+
+  static Path transformManually(Path path, const TransformTestData& data) {
+    path.rotate(data.rotation);
+    if (data.mirrored) path.mirror(Qt::Horizontal);
+    path.translate(data.position);
+    return path;
+  }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_P(TransformTest, testMapPoint) {
+  const TransformTestData& data = GetParam();
+  Transform transform(data.position, data.rotation, data.mirrored);
+  foreach (const Vertex& vertex, createPath().getVertices()) {
+    Point expected = vertex.getPos().rotated(data.rotation);
+    if (data.mirrored) expected.mirror(Qt::Horizontal);
+    expected += data.position;
+    EXPECT_EQ(expected, transform.map(vertex.getPos()));
+  }
+}
+
+TEST_P(TransformTest, testMapPath) {
+  const TransformTestData& data = GetParam();
+  Transform transform(data.position, data.rotation, data.mirrored);
+  EXPECT_EQ(transformManually(createPath(), data), transform.map(createPath()));
+}
+
+TEST_P(TransformTest, testMapPaths) {
+  const TransformTestData& data = GetParam();
+  Transform     transform(data.position, data.rotation, data.mirrored);
+  QVector<Path> paths  = {createPath(), createPath().translated(Point(5, 5)),
+                         Path()};
+  QVector<Path> result = transform.map(paths);
+  ASSERT_EQ(paths.count(), result.count());
+  for (int i = 0; i < paths.count(); ++i) {
+    EXPECT_EQ(transformManually(paths.at(i), data), result.at(i));
+  }
+}
+
+/*******************************************************************************
+ *  Test Data
+ ******************************************************************************/
+
+// clang-format off
+INSTANTIATE_TEST_SUITE_P(TransformTest, TransformTest, ::testing::Values(
+    TransformTestData({Point(0, 0), Angle::deg0(), false}),
+    TransformTestData({Point(0, 0), Angle::deg0(), true}),
+    TransformTestData({Point(100, -200), Angle::deg90(), false}),
+    TransformTestData({Point(100, -200), Angle::deg90(), true}),
+    TransformTestData({Point(-5000, 0), Angle::deg180(), false}),
+    TransformTestData({Point(-5000, 0), -Angle::deg90(), true}),
+    TransformTestData({Point(1, 2), Angle::deg270(), true}),
+    TransformTestData({Point(1, 2), Angle::deg45(), false}),
+    TransformTestData({Point(12345, 67890), Angle::fromDeg(33.3), true}),
+    TransformTestData({Point(0, 0), -Angle::fromDeg(123.456), true})
+));
+// clang-format on
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace librepcb
@@ -92,6 +92,32 @@ TEST_F(LibraryBaseElementTest, testMoveToEmptyDirectory) {
   EXPECT_TRUE(dest.getPathTo("symbol.lp").isExistingFile());
 }
 
+TEST_F(LibraryBaseElementTest, testLoadModifiedFileAgain) {
+  FilePath dest = mTempDir.getPathTo(mNewElement->getUuid().toStr());
+  std::shared_ptr<TransactionalFileSystem> destFileSystem =
+      TransactionalFileSystem::openRW(dest);
+  TransactionalDirectory destDir(destFileSystem);
+  mNewElement->moveTo(destDir);
+  destFileSystem->save();
+
+  auto load = [&dest]() {
+    return std::make_shared<LibraryBaseElement>(
+        std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
+            TransactionalFileSystem::openRO(dest))),
+        true, "sym", "symbol");
+  };
+  EXPECT_EQ("test", load()->getAuthor());
+  EXPECT_EQ("test", load()->getAuthor());  // parsed file is cached now
+
+  // a modified file must be parsed again
+  FilePath   fp      = dest.getPathTo("symbol.lp");
+  QByteArray content = FileUtils::readFile(fp);
+  ASSERT_TRUE(content.contains("(author \"test\")"));
+  content.replace("(author \"test\")", "(author \"modified\")");
+  FileUtils::writeFile(fp, content);
+  EXPECT_EQ("modified", load()->getAuthor());
+}
+
 // Currently disabled because of the file system refactoring, and not sure if
 // this behavior is really what we want...
 //
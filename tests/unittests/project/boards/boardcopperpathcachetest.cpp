@@ -0,0 +1,94 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include "../projecttesthelper.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardcopperpathcache.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST(BoardCopperPathCacheTest, testUnmodifiedBoardKeepsRevisionStamp) {
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  const BI_Plane*       plane = board->getPlanes().first();
+  BoardCopperPathCache& cache = board->getCopperPathCache();
+  QString               layer = *plane->getLayerName();
+  const NetSignal*      net   = &plane->getNetSignal();
+
+  uint              stamp = 0;
+  ClipperLib::Paths paths =
+      cache.getPaths(layer, net, PositiveLength(5000), &stamp);
+  EXPECT_EQ(stamp, cache.getRevisionStamp(layer, net));
+  EXPECT_FALSE(paths.empty());
+
+  // rebuilding planes without modifying the board must not change anything
+  board->rebuildAllPlanes();
+  EXPECT_EQ(stamp, cache.getRevisionStamp(layer, net));
+  EXPECT_EQ(paths, cache.getPaths(layer, net, PositiveLength(5000)));
+}
+
+TEST(BoardCopperPathCacheTest, testModifiedBoardChangesRevisionStamp) {
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  BI_Plane*             plane = board->getPlanes().first();
+  BoardCopperPathCache& cache = board->getCopperPathCache();
+  QString               layer = *plane->getLayerName();
+  const NetSignal*      net   = &plane->getNetSignal();
+
+  uint              stamp = 0;
+  ClipperLib::Paths paths =
+      cache.getPaths(layer, net, PositiveLength(5000), &stamp);
+
+  // removing the plane fragments must invalidate the cached paths
+  plane->clear();
+  uint              newStamp = 0;
+  ClipperLib::Paths newPaths =
+      cache.getPaths(layer, net, PositiveLength(5000), &newStamp);
+  EXPECT_NE(stamp, newStamp);
+  EXPECT_NE(paths, newPaths);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -0,0 +1,156 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include "../projecttesthelper.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardcopperpathcache.h>
+#include <librepcb/project/boards/drc/boardclipperpathgenerator.h>
+#include <librepcb/project/boards/drc/boarddesignrulechecksnapshot.h>
+#include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST(BoardDesignRuleCheckSnapshotTest, testRevisionStampsMatchCache) {
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  BoardDesignRuleCheckSnapshot snapshot(*board, nullptr);
+  BoardCopperPathCache&        cache = board->getCopperPathCache();
+
+  ASSERT_GT(snapshot.getCopperLayers().count(), 0);
+  ASSERT_GT(snapshot.getNets().count(), 0);
+  for (int l = 0; l < snapshot.getCopperLayers().count(); ++l) {
+    for (int n = 0; n < snapshot.getNets().count(); ++n) {
+      const auto& layer  = snapshot.getCopperLayers()[l];
+      const auto& net    = snapshot.getNets()[n];
+      const auto& copper = snapshot.getCopper(l, n);
+      EXPECT_EQ(cache.getRevisionStamp(layer.name, net.netsignal),
+                copper.revisionStamp);
+      EXPECT_TRUE(copper.hasPrimitives);
+    }
+  }
+}
+
+TEST(BoardDesignRuleCheckSnapshotTest, testPrimitivesMatchGenerator) {
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  BoardDesignRuleCheckSnapshot snapshot(*board, nullptr);
+  BoardClipperPathGenerator    gen(*board, PositiveLength(5000));
+
+  // visiting all layers at once must give the same result as visiting them
+  // one by one
+  for (int l = 0; l < snapshot.getCopperLayers().count(); ++l) {
+    for (int n = 0; n < snapshot.getNets().count(); ++n) {
+      const auto& layer  = snapshot.getCopperLayers()[l];
+      const auto& net    = snapshot.getNets()[n];
+      const auto& copper = snapshot.getCopper(l, n);
+      EXPECT_EQ(gen.calcCopperPrimitives(layer.name, net.netsignal),
+                copper.primitives);
+    }
+  }
+}
+
+TEST(BoardDesignRuleCheckSnapshotTest, testTracesReferToCopperGroups) {
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+
+  // traces must be assignable to their copper group, to exclude them from
+  // the geometric copper width check
+  BoardDesignRuleCheckSnapshot snapshot(*board, nullptr);
+  QSet<const GraphicsLayer*>   layers;
+  QSet<const NetSignal*>       nets;
+  foreach (const auto& layer, snapshot.getCopperLayers()) {
+    layers.insert(layer.layer);
+  }
+  foreach (const auto& net, snapshot.getNets()) {
+    nets.insert(net.netsignal);
+  }
+  foreach (const auto& trace, snapshot.getTraces()) {
+    EXPECT_TRUE(layers.contains(trace.layer));
+    EXPECT_TRUE(nets.contains(trace.netsignal));
+    EXPECT_NE(nullptr, trace.netsignal);  // traces are always connected
+  }
+}
+
+TEST(BoardDesignRuleCheckSnapshotTest, testIndependentOfModifiedBoard) {
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  BI_Plane* plane = board->getPlanes().first();
+
+  // only collect the primitives of the plane's layer and net signal
+  BoardDesignRuleCheckSnapshot snapshot(
+      *board, [plane](const GraphicsLayer*, const NetSignal* netsignal, uint) {
+        return netsignal == &plane->getNetSignal();
+      });
+  int layerIndex = -1;
+  int netIndex   = -1;
+  for (int l = 0; l < snapshot.getCopperLayers().count(); ++l) {
+    if (snapshot.getCopperLayers()[l].name == *plane->getLayerName()) {
+      layerIndex = l;
+    }
+  }
+  for (int n = 0; n < snapshot.getNets().count(); ++n) {
+    if (snapshot.getNets()[n].netsignal == &plane->getNetSignal()) {
+      netIndex = n;
+    }
+  }
+  ASSERT_GE(layerIndex, 0);
+  ASSERT_GE(netIndex, 0);
+  for (int n = 0; n < snapshot.getNets().count(); ++n) {
+    EXPECT_EQ(n == netIndex, snapshot.getCopper(layerIndex, n).hasPrimitives);
+  }
+  const auto&   copper     = snapshot.getCopper(layerIndex, netIndex);
+  QVector<Path> primitives = copper.primitives;
+  EXPECT_FALSE(primitives.isEmpty());
+
+  // modifying the board must not affect the snapshot
+  plane->clear();
+  EXPECT_EQ(primitives, copper.primitives);
+  EXPECT_NE(board->getCopperPathCache().getRevisionStamp(
+                *plane->getLayerName(), &plane->getNetSignal()),
+            copper.revisionStamp);
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
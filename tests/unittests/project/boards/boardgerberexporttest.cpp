@@ -21,6 +21,7 @@
  *  Includes
  ******************************************************************************/
 #include <gtest/gtest.h>
+#include <librepcb/common/cam/camoutputfingerprint.h>
 #include <librepcb/common/fileio/fileutils.h>
 #include <librepcb/common/fileio/transactionalfilesystem.h>
 #include <librepcb/project/boards/board.h>
@@ -117,6 +118,162 @@ TEST(BoardGerberExportTest, test) {
   }
 }
 
+TEST(BoardGerberExportTest, testMergedCopperRegions) {
+  FilePath testDataDir(TEST_DATA_DIR
+                       "/unittests/librepcbproject/BoardGerberExportTest");
+
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  QScopedPointer<Project> project(
+      new Project(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename()));
+  Board* board = project->getBoards().first();
+  board->rebuildAllPlanes();
+
+  // export copper layers with merged regions
+  BoardFabricationOutputSettings config = board->getFabricationOutputSettings();
+  config.setOutputBasePath(testDataDir.getPathTo("actual-merged").toStr() %
+                           "/{{PROJECT}}");
+  config.setMergeCopperRegions(true);
+  BoardGerberExport grbExport(*board, config);
+  grbExport.exportAllLayers();
+
+  // pads and vias must not be flashed anymore, but drawn as regions
+  int copperFiles = 0;
+  foreach (const FilePath& fp, grbExport.getWrittenFiles()) {
+    if (fp.getFilename().endsWith(config.getSuffixCopperTop()) ||
+        fp.getFilename().endsWith(config.getSuffixCopperBot())) {
+      QString content = FileUtils::readFile(fp);
+      EXPECT_FALSE(content.contains("D03*")) << qPrintable(fp.toNative());
+      EXPECT_TRUE(content.contains("G36*")) << qPrintable(fp.toNative());
+      ++copperFiles;
+    }
+  }
+  EXPECT_EQ(2, copperFiles);
+}
+
+TEST(BoardGerberExportTest, testExportFromSnapshot) {
+  FilePath testDataDir(TEST_DATA_DIR
+                       "/unittests/librepcbproject/BoardGerberExportTest");
+
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  QScopedPointer<Project> project(
+      new Project(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename()));
+  Board* board = project->getBoards().first();
+  board->rebuildAllPlanes();
+
+  // export the board and a snapshot of it into different directories
+  BoardFabricationOutputSettings config = board->getFabricationOutputSettings();
+  config.setOutputBasePath(testDataDir.getPathTo("actual-board").toStr() %
+                           "/{{PROJECT}}");
+  BoardGerberExport boardExport(*board, config);
+  boardExport.exportAllLayers();
+  std::unique_ptr<Board> snapshot = board->createSnapshot();
+  config.setOutputBasePath(testDataDir.getPathTo("actual-snapshot").toStr() %
+                           "/{{PROJECT}}");
+  BoardGerberExport snapshotExport(*snapshot, config);
+  QAtomicInt        progressCount(0);  // signal is emitted from any thread
+  QObject::connect(&snapshotExport, &BoardGerberExport::exportProgress,
+                   [&progressCount](int finished, int total) {
+                     Q_UNUSED(finished);
+                     Q_UNUSED(total);
+                     progressCount.fetchAndAddOrdered(1);
+                   });
+  snapshotExport.exportAllLayers();
+
+  // both exports must be identical (except volatile data)
+  ASSERT_EQ(boardExport.getWrittenFiles().count(),
+            snapshotExport.getWrittenFiles().count());
+  for (int i = 0; i < boardExport.getWrittenFiles().count(); ++i) {
+    const FilePath& fp1 = boardExport.getWrittenFiles().at(i);
+    const FilePath& fp2 = snapshotExport.getWrittenFiles().at(i);
+    EXPECT_EQ(fp1.getFilename(), fp2.getFilename());
+    EXPECT_EQ(CamOutputFingerprint::fromFile(fp1),
+              CamOutputFingerprint::fromFile(fp2))
+        << qPrintable(fp2.toNative());
+  }
+  EXPECT_GE(progressCount.loadAcquire(),
+            boardExport.getWrittenFiles().count());
+}
+
+TEST(BoardGerberExportTest, testAbort) {
+  FilePath testDataDir(TEST_DATA_DIR
+                       "/unittests/librepcbproject/BoardGerberExportTest");
+
+  // open project from test data directory
+  FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  QScopedPointer<Project> project(
+      new Project(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename()));
+  Board* board = project->getBoards().first();
+
+  BoardFabricationOutputSettings config = board->getFabricationOutputSettings();
+  config.setOutputBasePath(testDataDir.getPathTo("actual-aborted").toStr() %
+                           "/{{PROJECT}}");
+  BoardGerberExport grbExport(*board, config);
+  grbExport.abort();
+  EXPECT_THROW(grbExport.exportAllLayers(), UserCanceled);
+  EXPECT_EQ(0, grbExport.getWrittenFiles().count());
+}
+
+TEST(BoardGerberExportTest, testExportHeadless) {
+  FilePath testDataDir(TEST_DATA_DIR
+                       "/unittests/librepcbproject/BoardGerberExportTest");
+
+  // open the project twice, once without graphics items
+  FilePath projectFp(TEST_DATA_DIR "/projects/Gerber Test/project.lpp");
+  std::shared_ptr<TransactionalFileSystem> projectFs =
+      TransactionalFileSystem::openRO(projectFp.getParentDir());
+  QScopedPointer<Project> project(
+      new Project(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename()));
+  QScopedPointer<Project> headlessProject(
+      new Project(std::unique_ptr<TransactionalDirectory>(
+                      new TransactionalDirectory(projectFs)),
+                  projectFp.getFilename(), true));
+  EXPECT_FALSE(project->isHeadless());
+  EXPECT_TRUE(headlessProject->isHeadless());
+  Board* board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  Board* headlessBoard = headlessProject->getBoards().first();
+  headlessBoard->rebuildAllPlanes();
+
+  // export both boards into different directories
+  BoardFabricationOutputSettings config = board->getFabricationOutputSettings();
+  config.setOutputBasePath(testDataDir.getPathTo("actual-board").toStr() %
+                           "/{{PROJECT}}");
+  BoardGerberExport boardExport(*board, config);
+  boardExport.exportAllLayers();
+  config.setOutputBasePath(testDataDir.getPathTo("actual-headless").toStr() %
+                           "/{{PROJECT}}");
+  BoardGerberExport headlessExport(*headlessBoard, config);
+  headlessExport.exportAllLayers();
+
+  // both exports must be identical (except volatile data)
+  ASSERT_EQ(boardExport.getWrittenFiles().count(),
+            headlessExport.getWrittenFiles().count());
+  for (int i = 0; i < boardExport.getWrittenFiles().count(); ++i) {
+    const FilePath& fp1 = boardExport.getWrittenFiles().at(i);
+    const FilePath& fp2 = headlessExport.getWrittenFiles().at(i);
+    EXPECT_EQ(fp1.getFilename(), fp2.getFilename());
+    EXPECT_EQ(CamOutputFingerprint::fromFile(fp1),
+              CamOutputFingerprint::fromFile(fp2))
+        << qPrintable(fp2.toNative());
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
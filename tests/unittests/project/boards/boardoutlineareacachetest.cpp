@@ -0,0 +1,89 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+
+#include "../projecttesthelper.h"
+
+#include <gtest/gtest.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardoutlineareacache.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
+#include <librepcb/project/project.h>
+
+#include <QtCore>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST(BoardOutlineAreaCacheTest, testOffsetAreas) {
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  BoardOutlineAreaCache&  cache = board->getOutlineAreaCache();
+  PositiveLength          tolerance(5000);
+
+  ClipperLib::Paths area   = cache.getArea(Length(0), tolerance);
+  ClipperLib::Paths shrunk = cache.getArea(Length(-300000), tolerance);
+  EXPECT_FALSE(area.empty());
+  EXPECT_NE(area, shrunk);
+  EXPECT_EQ(area, cache.getArea(Length(0), tolerance));
+  EXPECT_EQ(shrunk, cache.getArea(Length(-300000), tolerance));
+
+  // the snapshot overload must return the same areas
+  EXPECT_EQ(shrunk, cache.getArea(cache.getRevisionStamp(),
+                                  cache.getOutlines(), Length(-300000),
+                                  tolerance));
+}
+
+TEST(BoardOutlineAreaCacheTest, testModifiedOutlineChangesArea) {
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  BoardOutlineAreaCache&  cache = board->getOutlineAreaCache();
+  PositiveLength          tolerance(5000);
+
+  uint              stamp = cache.getRevisionStamp();
+  ClipperLib::Paths area  = cache.getArea(Length(0), tolerance);
+  foreach (BI_Polygon* polygon, board->getPolygons()) {
+    if (polygon->getPolygon().getLayerName() == GraphicsLayer::sBoardOutlines) {
+      polygon->getPolygon().setPath(
+          polygon->getPolygon().getPath().translated(Point(1000000, 0)));
+    }
+  }
+  EXPECT_NE(stamp, cache.getRevisionStamp());
+  EXPECT_NE(area, cache.getArea(Length(0), tolerance));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
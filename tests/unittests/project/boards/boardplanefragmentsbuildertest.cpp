@@ -20,11 +20,25 @@
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
+
+#include "../projecttesthelper.h"
+
 #include <gtest/gtest.h>
 #include <librepcb/common/fileio/fileutils.h>
-#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/utils/clipperhelpers.h>
 #include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/boardplanefragmentsbuilder.h>
+#include <librepcb/project/boards/boardplanesrebuilder.h>
+#include <librepcb/project/boards/items/bi_device.h>
+#include <librepcb/project/boards/items/bi_footprint.h>
+#include <librepcb/project/boards/items/bi_footprintpad.h>
+#include <librepcb/project/boards/items/bi_hole.h>
+#include <librepcb/project/boards/items/bi_netsegment.h>
 #include <librepcb/project/boards/items/bi_plane.h>
+#include <librepcb/project/boards/items/bi_via.h>
+#include <librepcb/project/circuit/circuit.h>
+#include <librepcb/project/circuit/netsignal.h>
 #include <librepcb/project/project.h>
 
 #include <QtCore>
@@ -60,13 +74,7 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
       "/unittests/librepcbproject/BoardPlaneFragmentsBuilderTest");
 
   // open project from test data directory
-  FilePath projectFp(TEST_DATA_DIR "/projects/Nested Planes/project.lpp");
-  std::shared_ptr<TransactionalFileSystem> projectFs =
-      TransactionalFileSystem::openRO(projectFp.getParentDir());
-  QScopedPointer<Project> project(
-      new Project(std::unique_ptr<TransactionalDirectory>(
-                      new TransactionalDirectory(projectFs)),
-                  projectFp.getFilename()));
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
 
   // force planes rebuild
   Board* board = project->getBoards().first();
@@ -109,6 +117,297 @@ TEST(BoardPlaneFragmentsBuilderTest, testFragments) {
   EXPECT_EQ(expectedPlaneFragments, actualPlaneFragments);
 }
 
+TEST(BoardPlaneFragmentsBuilderTest, testIncrementalRebuild) {
+  // open project from test data directory
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->finishLoading();  // modifications are tracked only afterwards
+  board->rebuildAllPlanes();
+
+  // move all vias and rebuild the planes incrementally
+  foreach (BI_NetSegment* netsegment, board->getNetSegments()) {
+    foreach (BI_Via* via, netsegment->getVias()) {
+      via->setPosition(via->getPosition() + Point(500000, 300000));
+    }
+  }
+  board->triggerPlanesRebuild();
+  QHash<Uuid, QVector<Path>> incrementalFragments;
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    incrementalFragments[plane->getUuid()] = plane->getFragments();
+  }
+
+  // the result must cover the same area as a full rebuild
+  board->rebuildAllPlanes();
+  PositiveLength tolerance = BoardPlaneFragmentsBuilder::maxArcTolerance();
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    ClipperLib::Paths   difference;
+    ClipperLib::Clipper c;
+    c.AddPaths(ClipperHelpers::convert(plane->getFragments(), tolerance),
+               ClipperLib::ptSubject, true);
+    c.AddPaths(ClipperHelpers::convert(incrementalFragments[plane->getUuid()],
+                                       tolerance),
+               ClipperLib::ptClip, true);
+    c.Execute(ClipperLib::ctXor, difference, ClipperLib::pftEvenOdd,
+              ClipperLib::pftEvenOdd);
+    qreal area = 0;
+    for (const ClipperLib::Path& path : difference) {
+      area += std::abs(ClipperLib::Area(path));
+    }
+    EXPECT_LT(area, 1e8) << qPrintable(plane->getUuid().toStr());
+  }
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testIncrementalRebuildAfterAddingHole) {
+  // open project from test data directory
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->finishLoading();  // modifications are tracked only afterwards
+  board->rebuildAllPlanes();
+
+  // find a location covered by a plane fragment
+  PositiveLength tolerance = BoardPlaneFragmentsBuilder::maxArcTolerance();
+
+  const BI_Plane*      plane = nullptr;
+  ClipperLib::IntPoint position;
+  foreach (const BI_Plane* candidate, board->getPlanes()) {
+    foreach (const Path& fragment, candidate->getFragments()) {
+      ClipperLib::Path    path = ClipperHelpers::convert(fragment, tolerance);
+      ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect(path);
+      for (int i = 1; (!plane) && (i < 10); ++i) {
+        ClipperLib::IntPoint p(rect.left + (rect.right - rect.left) * i / 10,
+                               (rect.top + rect.bottom) / 2);
+        if (ClipperLib::PointInPolygon(p, path) == 1) {
+          plane    = candidate;
+          position = p;
+        }
+      }
+    }
+  }
+  ASSERT_TRUE(plane);
+
+  // add a hole there and rebuild the planes incrementally
+  Hole hole(Uuid::createRandom(), ClipperHelpers::convert(position),
+            PositiveLength(1000000));
+  board->addHole(*new BI_Hole(*board, hole));
+  board->triggerPlanesRebuild();
+
+  // the hole must be cut out and the fingerprint must match the new fragments
+  foreach (const Path& fragment, plane->getFragments()) {
+    EXPECT_EQ(0, ClipperLib::PointInPolygon(
+                     position, ClipperHelpers::convert(fragment, tolerance)));
+  }
+  BoardPlaneFragmentsBuilder builder(*plane);
+  EXPECT_EQ(builder.calcFingerprint(), plane->getFragmentsFingerprint());
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testIncrementalRebuildKeepsFragments) {
+  // open project from test data directory
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+  BI_Via* via = nullptr;
+  foreach (BI_NetSegment* netsegment, board->getNetSegments()) {
+    if ((!via) && (!netsegment->getVias().isEmpty())) {
+      via = netsegment->getVias().first();
+    }
+  }
+  ASSERT_TRUE(via);
+
+  PositiveLength tolerance = BoardPlaneFragmentsBuilder::maxArcTolerance();
+  const Path     dirtyArea = via->getSceneOutline();
+  const Path     farAway   = Path::rect(Point(-1000000000, -1000000000),
+                                  Point(-999000000, -999000000));
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    // fragments far away from the dirty area must be kept as-is
+    const ClipperLib::cInt margin =
+        (*plane->getMinClearance() + *plane->getMinWidth() + *tolerance)
+            .toNm() *
+        2;
+    ClipperLib::IntRect affected = ClipperHelpers::getBoundingRect(
+        ClipperHelpers::convert(dirtyArea, tolerance));
+    affected = {affected.left - margin, affected.top - margin,
+                affected.right + margin, affected.bottom + margin};
+    BoardPlaneFragmentsBuilder builder(*plane);
+    QVector<Path> fragments = builder.buildFragments(QVector<Path>{dirtyArea});
+    foreach (const Path& fragment, plane->getFragments()) {
+      ClipperLib::IntRect rect = ClipperHelpers::getBoundingRect(
+          ClipperHelpers::convert(fragment, tolerance));
+      if (!ClipperHelpers::intersects(rect, affected)) {
+        EXPECT_TRUE(fragments.contains(fragment));
+      }
+    }
+
+    // nothing must be calculated at all for areas outside of the plane
+    BoardPlaneFragmentsBuilder farBuilder(*plane);
+    EXPECT_EQ(plane->getFragments(),
+              farBuilder.buildFragments(QVector<Path>{farAway}));
+    EXPECT_EQ(0, farBuilder.getStatistics().obstacleCount);
+  }
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testIncrementalRebuildOfLargePour) {
+  // open project from test data directory and add an empty board
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->createBoard(ElementName("Pour"));
+  project->addBoard(*board);
+
+  // add a plane larger than the board outline, which leads to a single pour
+  NetSignal* netsignal = project->getCircuit().getNetSignals().first();
+  Path       outline   = Path::rect(Point(-1000000000, -1000000000),
+                                Point(1000000000, 1000000000));
+  BI_Plane*  plane     = new BI_Plane(*board, Uuid::createRandom(),
+                                 GraphicsLayerName(GraphicsLayer::sTopCopper),
+                                 *netsignal, outline);
+  plane->setKeepOrphans(true);
+  board->addPlane(*plane);
+  board->rebuildAllPlanes();
+  ASSERT_EQ(1, plane->getFragments().count());
+
+  // a small modification requires rebuilding the whole pour, which must be
+  // done in a single pass instead of growing the window step by step
+  const Path area =
+      Path::centeredRect(PositiveLength(1000000), PositiveLength(1000000))
+          .translated(Point(50000000, 40000000));
+  BoardPlaneFragmentsBuilder builder(*plane);
+  EXPECT_EQ(plane->getFragments(), builder.buildFragments(QVector<Path>{area}));
+  EXPECT_EQ(1, builder.getStatistics().passCount);
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testRebuildAfterModification) {
+  // open project from test data directory
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->finishLoading();
+  board->rebuildAllPlanes();
+  BoardPlanesRebuilder& rebuilder = board->getPlanesRebuilder();
+  EXPECT_FALSE(rebuilder.isBusy());
+
+  // moving vias must start an incremental rebuild in the background
+  foreach (BI_NetSegment* netsegment, board->getNetSegments()) {
+    foreach (BI_Via* via, netsegment->getVias()) {
+      via->setPosition(via->getPosition() + Point(500000, 300000));
+    }
+  }
+  EXPECT_TRUE(rebuilder.isBusy());
+  qint64 start       = QDateTime::currentDateTime().toMSecsSinceEpoch();
+  auto   currentTime = []() {
+    return QDateTime::currentDateTime().toMSecsSinceEpoch();
+  };
+  while (rebuilder.isBusy() && (currentTime() - start < 30000)) {
+    QThread::msleep(10);
+    qApp->processEvents();
+  }
+  EXPECT_FALSE(rebuilder.isBusy()) << "Rebuild timed out!";
+  EXPECT_EQ(1, rebuilder.getRebuildCount());
+
+  // the planes must be up to date now
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    BoardPlaneFragmentsBuilder builder(*plane);
+    EXPECT_EQ(builder.calcFingerprint(), plane->getFragmentsFingerprint());
+  }
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testFootprintMoveSchedulesPadAreas) {
+  // open project from test data directory
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->finishLoading();
+  board->rebuildAllPlanes();
+  EXPECT_TRUE(
+      board->takeScheduledAreaForPlanesRebuild().getVertices().isEmpty());
+  BI_Device* device = nullptr;
+  foreach (BI_Device* dev, board->getDeviceInstances()) {
+    if ((!device) && (!dev->getFootprint().getPads().isEmpty())) {
+      device = dev;
+    }
+  }
+  ASSERT_TRUE(device);
+
+  // move the device and collect the old and new outlines of all pads
+  PositiveLength    tolerance = BoardPlaneFragmentsBuilder::maxArcTolerance();
+  ClipperLib::Paths outlines;
+  foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+    outlines.push_back(
+        ClipperHelpers::convert(pad->getSceneOutline(), tolerance));
+  }
+  device->setPosition(device->getPosition() + Point(1000000, 2000000));
+  foreach (const BI_FootprintPad* pad, device->getFootprint().getPads()) {
+    outlines.push_back(
+        ClipperHelpers::convert(pad->getSceneOutline(), tolerance));
+  }
+
+  // a single area covering all these outlines must be rebuilt
+  EXPECT_TRUE(board->getPlanesRebuilder().isBusy());
+  Path area = board->takeScheduledAreaForPlanesRebuild();
+  ClipperLib::IntRect areaRect =
+      ClipperHelpers::getBoundingRect(ClipperHelpers::convert(area, tolerance));
+  ClipperLib::IntRect padsRect = ClipperHelpers::getBoundingRect(outlines);
+  EXPECT_LE(areaRect.left, padsRect.left);
+  EXPECT_LE(areaRect.top, padsRect.top);
+  EXPECT_GE(areaRect.right, padsRect.right);
+  EXPECT_GE(areaRect.bottom, padsRect.bottom);
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testSerializedFragments) {
+  // open project from test data directory
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  board->rebuildAllPlanes();
+
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    // the fingerprint must match as long as nothing was modified
+    BoardPlaneFragmentsBuilder builder(*plane);
+    EXPECT_FALSE(plane->getFragmentsFingerprint().isEmpty());
+    EXPECT_EQ(plane->getFragmentsFingerprint(), builder.calcFingerprint());
+
+    // fragments and fingerprint must be restored when loading the plane
+    SExpression node = plane->serializeToDomElement("plane");
+    BI_Plane    loaded(*board, node);
+    EXPECT_EQ(plane->getFragments(), loaded.getFragments());
+    EXPECT_EQ(plane->getFragmentsFingerprint(),
+              loaded.getFragmentsFingerprint());
+  }
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testFinishLoading) {
+  // open project from test data directory
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+
+  // outdated planes are rebuilt only when the board gets fully loaded
+  EXPECT_FALSE(board->isFullyLoaded());
+  board->finishLoading();
+  EXPECT_TRUE(board->isFullyLoaded());
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    BoardPlaneFragmentsBuilder builder(*plane);
+    EXPECT_EQ(builder.calcFingerprint(), plane->getFragmentsFingerprint());
+  }
+}
+
+TEST(BoardPlaneFragmentsBuilderTest, testRebuildStatistics) {
+  // open project from test data directory
+  QScopedPointer<Project> project(ProjectTestHelper::openProject());
+  Board*                  board = project->getBoards().first();
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    EXPECT_EQ(-1, plane->getRebuildStatistics().durationMs);
+  }
+
+  // the statistics must describe the calculated fragments
+  board->rebuildAllPlanes();
+  foreach (const BI_Plane* plane, board->getPlanes()) {
+    int vertexCount = 0;
+    foreach (const Path& fragment, plane->getFragments()) {
+      vertexCount += fragment.getVertices().count();
+    }
+    const BI_Plane::RebuildStatistics& stats = plane->getRebuildStatistics();
+    EXPECT_GE(stats.durationMs, 0);
+    EXPECT_GE(stats.obstacleCount, 0);
+    EXPECT_EQ(vertexCount, stats.vertexCount);
+    EXPECT_GE(stats.removedVertexCount, 0);
+    EXPECT_EQ(1, stats.passCount);
+  }
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
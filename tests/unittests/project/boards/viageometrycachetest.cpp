@@ -0,0 +1,88 @@
+/*
+ * LibrePCB - Professional EDA for everyone!
+ * Copyright (C) 2013 LibrePCB Developers, see AUTHORS.md for contributors.
+ * https://librepcb.org/
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*******************************************************************************
+ *  Includes
+ ******************************************************************************/
+#include <gtest/gtest.h>
+#include <librepcb/project/boards/viageometrycache.h>
+
+/*******************************************************************************
+ *  Namespace
+ ******************************************************************************/
+namespace librepcb {
+namespace project {
+namespace tests {
+
+/*******************************************************************************
+ *  Test Class
+ ******************************************************************************/
+
+class ViaGeometryCacheTest : public ::testing::Test {
+protected:
+  virtual void SetUp() override { ViaGeometryCache::instance().clear(); }
+  virtual void TearDown() override { ViaGeometryCache::instance().clear(); }
+};
+
+/*******************************************************************************
+ *  Test Methods
+ ******************************************************************************/
+
+TEST_F(ViaGeometryCacheTest, testOutline) {
+  ViaGeometryCache& cache = ViaGeometryCache::instance();
+  PositiveLength    size(700000);
+  EXPECT_EQ(Path::circle(size), cache.getOutline(BI_Via::Shape::Round, size));
+  EXPECT_EQ(Path::centeredRect(size, size),
+            cache.getOutline(BI_Via::Shape::Square, size));
+  EXPECT_EQ(Path::octagon(size, size),
+            cache.getOutline(BI_Via::Shape::Octagon, size));
+  EXPECT_EQ(3, cache.getCount());
+}
+
+TEST_F(ViaGeometryCacheTest, testSharedGeometry) {
+  ViaGeometryCache& cache = ViaGeometryCache::instance();
+  PositiveLength    size(700000);
+  PositiveLength    drill(300000);
+  QPainterPath copper = cache.getCopperPx(BI_Via::Shape::Round, size, drill);
+  EXPECT_EQ(2, cache.getCount());  // outline and copper area
+  for (int i = 0; i < 10; ++i) {
+    cache.getOutline(BI_Via::Shape::Round, size);
+    EXPECT_EQ(copper, cache.getCopperPx(BI_Via::Shape::Round, size, drill));
+  }
+  EXPECT_EQ(2, cache.getCount());
+  cache.getCopperPx(BI_Via::Shape::Round, size, PositiveLength(400000));
+  EXPECT_EQ(3, cache.getCount());
+}
+
+TEST_F(ViaGeometryCacheTest, testCopperContainsHole) {
+  ViaGeometryCache& cache  = ViaGeometryCache::instance();
+  QPainterPath      copper = cache.getCopperPx(
+      BI_Via::Shape::Square, PositiveLength(1000000), PositiveLength(500000));
+  EXPECT_FALSE(copper.contains(QPointF(0, 0)));
+  EXPECT_TRUE(copper.contains(Point(400000, 0).toPxQPointF()));
+  EXPECT_FALSE(copper.contains(Point(600000, 0).toPxQPointF()));
+}
+
+/*******************************************************************************
+ *  End of File
+ ******************************************************************************/
+
+}  // namespace tests
+}  // namespace project
+}  // namespace librepcb
@@ -122,6 +122,17 @@ TEST_F(ProjectLibraryTest, testLoadSymbol) {
             mExistingSymbolFile.size());  // not upgraded
 }
 
+TEST_F(ProjectLibraryTest, testSymbolIsLoadedOnFirstAccess) {
+  // break the existing symbol, which must not be noticed until it is accessed
+  FilePath fp(mExistingSymbolFile.absoluteFilePath());
+  Uuid     uuid = Uuid::fromString(fp.getParentDir().getFilename());
+  FileUtils::writeFile(fp, "invalid");
+  ProjectLibrary lib(std::unique_ptr<TransactionalDirectory>(
+      new TransactionalDirectory(mLibFs)));
+  EXPECT_EQ(nullptr, lib.getSymbol(uuid));
+  EXPECT_EQ(0, lib.getSymbols().count());
+}
+
 TEST_F(ProjectLibraryTest, testAddSymbol) {
   {
     ProjectLibrary lib(std::unique_ptr<TransactionalDirectory>(
@@ -22,11 +22,20 @@
  ******************************************************************************/
 #include <gtest/gtest.h>
 #include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/common/geometry/polygon.h>
+#include <librepcb/common/graphics/graphicslayer.h>
+#include <librepcb/common/systeminfo.h>
+#include <librepcb/project/boards/board.h>
+#include <librepcb/project/boards/items/bi_polygon.h>
 #include <librepcb/project/metadata/projectmetadata.h>
 #include <librepcb/project/project.h>
 
 #include <QtCore>
 
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
 /*******************************************************************************
  *  Namespace
  ******************************************************************************/
@@ -58,6 +67,14 @@ protected:
     return std::unique_ptr<TransactionalDirectory>(new TransactionalDirectory(
         TransactionalFileSystem::open(mProjectDir, writable)));
   }
+
+  static void releaseFreeHeapMemory() noexcept {
+    // Freed heap memory is not necessarily returned to the OS, thus the
+    // resident memory would also contain memory which is no longer used.
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+  }
 };
 
 /*******************************************************************************
@@ -191,6 +208,51 @@ TEST_F(ProjectTest, testSettersGetters) {
   EXPECT_EQ(version, project->getMetadata().getVersion());
 }
 
+TEST_F(ProjectTest, testMemoryAfterOpenIsBounded) {
+  // create new project with a large board, i.e. a few megabytes of S-Expression
+  QScopedPointer<Project> project(
+      Project::create(createDir(), mProjectFile.getFilename()));
+  Board* board = project->createBoard(ElementName("Board"));
+  project->addBoard(*board);
+  for (int i = 0; i < 2000; ++i) {
+    Path path;
+    for (int k = 0; k < 50; ++k) {
+      path.addVertex(Point(i * 100000, k * 100000), Angle(k * 1000));
+    }
+    board->addPolygon(*new BI_Polygon(
+        *board, Polygon(Uuid::createRandom(),
+                        GraphicsLayerName(GraphicsLayer::sBoardDocumentation),
+                        UnsignedLength(200000), false, false, path)));
+  }
+  project->save();
+  project->getDirectory().getFileSystem()->save();
+  project.reset();
+
+  qint64       fileSize = 0;
+  QDirIterator it(mProjectDir.getPathTo("boards").toStr(), QDir::Files,
+                  QDirIterator::Subdirectories);
+  while (it.hasNext()) {
+    fileSize += QFileInfo(it.next()).size();
+  }
+  ASSERT_GT(fileSize, 4 * 1024 * 1024);
+
+  // re-open the project and check the loaded state
+  releaseFreeHeapMemory();
+  qint64 before = SystemInfo::getCurrentMemoryUsage();
+  project.reset(new Project(createDir(), mProjectFile.getFilename()));
+  releaseFreeHeapMemory();
+  qint64 after = SystemInfo::getCurrentMemoryUsage();
+  ASSERT_EQ(1, project->getBoards().count());
+  EXPECT_EQ(2000, project->getBoards().first()->getPolygons().count());
+
+  // The DOM of the board alone needs more than 10 times the file size, so if
+  // it was still retained after loading (or leaked), the resident memory would
+  // exceed this bound. The loaded objects themselves need much less memory.
+  ASSERT_GT(before, 0);
+  ASSERT_GT(after, 0);
+  EXPECT_LT(after - before, 8 * fileSize);
+}
+
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
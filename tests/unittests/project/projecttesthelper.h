@@ -17,77 +17,57 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#ifndef LIBREPCB_PROJECT_BGI_AIRWIRE_H
-#define LIBREPCB_PROJECT_BGI_AIRWIRE_H
+#ifndef PROJECTTESTHELPER_H
+#define PROJECTTESTHELPER_H
 
 /*******************************************************************************
  *  Includes
  ******************************************************************************/
-#include "bgi_base.h"
+#include <librepcb/common/fileio/transactionalfilesystem.h>
+#include <librepcb/project/project.h>
 
 #include <QtCore>
-#include <QtWidgets>
 
 /*******************************************************************************
  *  Namespace / Forward Declarations
  ******************************************************************************/
 namespace librepcb {
-
-class GraphicsLayer;
-
 namespace project {
-
-class BI_AirWire;
+namespace tests {
 
 /*******************************************************************************
- *  Class BGI_AirWire
+ *  Class ProjectTestHelper
  ******************************************************************************/
 
-/**
- * @brief The BGI_AirWire class
- */
-class BGI_AirWire final : public BGI_Base {
+class ProjectTestHelper final {
 public:
-  // Constructors / Destructor
-  explicit BGI_AirWire(BI_AirWire& airwire) noexcept;
-  ~BGI_AirWire() noexcept;
-
-  // Getters
-  bool isSelectable() const noexcept;
-
-  // General Methods
-  void updateCacheAndRepaint() noexcept;
-
-  // Inherited from QGraphicsItem
-  QRectF       boundingRect() const { return mBoundingRect; }
-  QPainterPath shape() const { return mShape; }
-  void         paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
-                     QWidget* widget);
-
-private:
-  // make some methods inaccessible...
-  BGI_AirWire()                         = delete;
-  BGI_AirWire(const BGI_AirWire& other) = delete;
-  BGI_AirWire& operator=(const BGI_AirWire& rhs) = delete;
-
-  // Private Methods
-  GraphicsLayer* getLayer(const QString& name) const noexcept;
-
-  // Attributes
-  BI_AirWire&    mAirWire;
-  GraphicsLayer* mLayer;
-
-  // Cached Attributes
-  QVector<QLineF> mLines;
-  QRectF          mBoundingRect;
-  QPainterPath    mShape;
+  ProjectTestHelper() = delete;
+
+  /**
+   * @brief Open a project (read-only) from the test data directory
+   *
+   * @param name    Name of the project directory in "data/projects".
+   *
+   * @return The opened project (the caller takes the ownership).
+   */
+  static Project* openProject(const QString& name = "Nested Planes") {
+    FilePath projectFp = FilePath(TEST_DATA_DIR "/projects")
+                             .getPathTo(name)
+                             .getPathTo("project.lpp");
+    std::shared_ptr<TransactionalFileSystem> projectFs =
+        TransactionalFileSystem::openRO(projectFp.getParentDir());
+    return new Project(std::unique_ptr<TransactionalDirectory>(
+                           new TransactionalDirectory(projectFs)),
+                       projectFp.getFilename());
+  }
 };
 
 /*******************************************************************************
  *  End of File
  ******************************************************************************/
 
+}  // namespace tests
 }  // namespace project
 }  // namespace librepcb
 
-#endif  // LIBREPCB_PROJECT_BGI_AIRWIRE_H
+#endif  // PROJECTTESTHELPER_H
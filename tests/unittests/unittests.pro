@@ -68,20 +68,26 @@ isEmpty(UNBUNDLE) {
 
 SOURCES += \
     common/algorithm/airwiresbuildertest.cpp \
+    common/algorithm/unionfindtest.cpp \
     common/alignmenttest.cpp \
     common/applicationtest.cpp \
     common/attributes/attributekeytest.cpp \
     common/attributes/attributesubstitutortest.cpp \
+    common/bom/bomtest.cpp \
     common/circuitidentifiertest.cpp \
     common/fileio/csvfiletest.cpp \
+    common/fileio/csvstreamwritertest.cpp \
     common/fileio/directorylocktest.cpp \
     common/fileio/filepathtest.cpp \
     common/fileio/serializableobjectlisttest.cpp \
+    common/fileio/sexpressiontest.cpp \
     common/fileio/transactionaldirectorytest.cpp \
     common/fileio/transactionalfilesystemtest.cpp \
     common/geometry/pathmodeltest.cpp \
     common/geometry/pathtest.cpp \
     common/graphics/graphicslayernametest.cpp \
+    common/graphics/graphicsscenetest.cpp \
+    common/graphics/graphicsviewtest.cpp \
     common/network/filedownloadtest.cpp \
     common/network/networkrequesttest.cpp \
     common/pnp/pickplacecsvwritertest.cpp \
@@ -90,12 +96,22 @@ SOURCES += \
     common/sqlitedatabasetest.cpp \
     common/systeminfotest.cpp \
     common/toolboxtest.cpp \
+    common/tracertest.cpp \
+    common/undostacktest.cpp \
     common/units/angletest.cpp \
     common/units/lengthsnaptest.cpp \
     common/units/lengthtest.cpp \
     common/units/pointtest.cpp \
     common/units/ratiotest.cpp \
+    common/utils/boundedqueuetest.cpp \
+    common/utils/clipperareacachetest.cpp \
+    common/utils/clipperhelperstest.cpp \
+    common/utils/clipperoutlinecachetest.cpp \
+    common/utils/clippershapecachetest.cpp \
     common/utils/mathparsertest.cpp \
+    common/utils/memorypooltest.cpp \
+    common/utils/taskschedulertest.cpp \
+    common/utils/transformtest.cpp \
     common/uuidtest.cpp \
     common/versiontest.cpp \
     common/widgets/editabletablewidgettest.cpp \
@@ -111,9 +127,13 @@ SOURCES += \
     library/cmp/componentsymbolvariantitemtest.cpp \
     library/librarybaseelementtest.cpp \
     main.cpp \
+    project/boards/boardcopperpathcachetest.cpp \
+    project/boards/boarddesignrulechecksnapshottest.cpp \
     project/boards/boardgerberexporttest.cpp \
+    project/boards/boardoutlineareacachetest.cpp \
     project/boards/boardpickplacegeneratortest.cpp \
     project/boards/boardplanefragmentsbuildertest.cpp \
+    project/boards/viageometrycachetest.cpp \
     project/library/projectlibrarytest.cpp \
     project/projecttest.cpp \
     workspace/workspacetest.cpp \
@@ -123,6 +143,7 @@ HEADERS += \
     common/fileio/serializableobjectmock.h \
     common/network/networkrequestbasesignalreceiver.h \
     common/widgets/editabletablewidgetreceiver.h \
+    project/projecttesthelper.h \
 
 FORMS += \
 